@@ -24,6 +24,10 @@ typedef struct SBN_PeerInterface_s SBN_PeerInterface_t;
     (SBN_PACKED_HDR_SZ + sizeof(SBN_SubCnt_t) + (sizeof(CFE_SB_MsgId_t) + sizeof(CFE_SB_Qos_t)) * SBN_MAX_SUBS_PER_PEER)
 #define SBN_MAX_PACKED_MSG_SZ (SBN_PACKED_HDR_SZ + CFE_MISSION_SB_MAX_SB_MSG_SIZE)
 
+#if SBN_MAX_PEER_CNT > 32
+#error "SBN_PeerMask_t has a bit for each peer of a net, at most 32"
+#endif
+
 /**
  * Filters modify messages in place, doing such things as byte swapping, packing/unpacking, etc.
  *
@@ -139,6 +143,45 @@ struct SBN_PeerInterface_s
     OS_time_t   LastSend, LastRecv;
     SBN_HKTlm_t SendCnt, RecvCnt, SendErrCnt, RecvErrCnt, SubCnt;
 
+    /**
+     * @brief The 64-bit counters (SBN_HK_CNTS_CC), and their values and the
+     * time at the last report, for its rates.
+     */
+    SBN_Cnts_t Cnts, HKCnts;
+    int64      HKUs;
+
+    /**
+     * @brief Messages taken from the peer's pipe in the last wakeup, and the
+     * most in one since the last SBN_HK_ALLPEERS_CC; at SBN_MAX_MSG_PER_WAKEUP
+     * the pipe was left with more. Not counted when a send task reads it.
+     */
+    SBN_HKTlm_t PipeCnt, PipeMax;
+
+    /** @brief Traffic by message ID of the app messages sent to and received from the peer. */
+    SBN_MidStats_t SendMids, RecvMids;
+
+    /** @brief The Seq of the next SBN_SEQ_APP_MSG to the peer. */
+    uint16 SendSeq;
+
+    /**
+     * @brief What has been received from the peer as SBN_SEQ_APP_MSG: its
+     * Epoch, the Seq after the highest seen and a bit for each of the
+     * SBN_SEQ_WINDOW before it that has arrived (bit 0 for the highest.)
+     */
+    bool   RecvSeqValid;
+    uint16 RecvSeqEpoch, RecvSeqNext;
+    uint32 RecvSeqMask;
+
+    /**
+     * @brief Seq skipped (less those arriving late), duplicates dropped, and
+     * Seq arriving after a later one.
+     */
+    SBN_HKTlm_t RecvGapCnt, RecvDupCnt, RecvReorderCnt;
+
+    /** @brief One-way latency of stamped app messages from the peer, and the estimate of its clock. */
+    SBN_LatHist_t LatHist;
+    SBN_LatSync_t LatSync;
+
     bool Connected;
 
     /** @brief generic blob of bytes for the module-specific data. */
@@ -157,6 +200,8 @@ struct SBN_NetInterface_s
 
     SBN_Task_Flag_t TaskFlags;
 
+    SBN_Net_Flag_t NetFlags;
+
     /* For some network topologies, this application only needs one connection
      * to communicate to peers. These tasks are used for those networks. ID's
      * are 0 if there is no task.
@@ -166,6 +211,14 @@ struct SBN_NetInterface_s
 
     OS_TaskID_t RecvTaskID;
 
+    /**
+     * @brief The number of receive shards, set by the module when it loads the
+     * net if it implements RecvFromShard; with SBN_TASK_RECV, each shard has a
+     * receive task (and RecvTaskID is unused) when there is more than one.
+     */
+    uint8       RecvShardCnt;
+    OS_TaskID_t ShardRecvTaskIDs[SBN_MAX_RECV_SHARDS];
+
     SBN_IfOps_t *IfOps; /* convenience */
 
     SBN_PeerIdx_t PeerCnt;
@@ -179,6 +232,26 @@ struct SBN_NetInterface_s
     SBN_FilterInterface_t *Filters[SBN_MAX_FILTERS];
     SBN_ModuleIdx_t        FilterCnt;
 
+    /**
+     * @brief With SBN_NET_SHARED_PIPE, the pipe used to read messages destined
+     * for any of the peers (whose Pipe is then unused.)
+     */
+    CFE_SB_PipeId_t Pipe;
+
+    /**
+     * @brief With SBN_NET_SHARED_PIPE, the message IDs Pipe is subscribed to,
+     * sorted by value, each with the peers that have requested it.
+     */
+    SBN_NetSub_t Subs[SBN_MAX_SUBS_PER_NET];
+    SBN_SubCnt_t SubCnt;
+
+    /** @brief With SBN_NET_SHARED_PIPE, as each peer's PipeCnt and PipeMax, for Pipe. */
+    SBN_HKTlm_t PipeCnt, PipeMax;
+
+    /** @brief The sums of the peers' counters, as for each peer. */
+    SBN_Cnts_t Cnts, HKCnts;
+    int64      HKUs;
+
     /** @brief generic blob of bytes, module-specific */
     union {
       uint8 _buf[128];
@@ -267,8 +340,40 @@ typedef struct
      * @return A pointer to the peer interface structure.
      */
     SBN_PeerInterface_t *(*GetPeer)(SBN_NetInterface_t *Net, CFE_ProcessorID_t ProcessorID, CFE_SpacecraftID_t SpacecraftID);
+
+    /**
+     * @brief Is a local app subscribed to this message ID? For modules whose
+     * nets receive messages sent for other nodes, e.g. to a multicast group.
+     * Safe to call from receive tasks.
+     *
+     * @param MsgID[in] The CCSDS message ID.
+     *
+     * @return true if subscribed.
+     */
+    bool (*IsLocalSub)(CFE_SB_MsgId_t MsgID);
+
+    /**
+     * @brief Whether per-message debug events are sent, as SBN_MSG_EVENTS_CC
+     * sets it; NULL is off. Read through SBN_MSG_EVENTS_ON.
+     */
+    const bool *MsgEvents;
+
+    /**
+     * @brief Takes a call site of a rate-limited event that has begun to
+     * suppress it, to send the count from the wakeup once its window is over.
+     * Called through SBN_EVS_LIMIT_PEND. Safe to call from any task.
+     *
+     * @param Limit[in] The call site's state, which the module keeps loaded.
+     */
+    void (*PendEVSLimit)(SBN_EVSLimit_t *Limit);
 } SBN_ProtocolOutlet_t;
 
+/* a module's per-message debug events and suppressed counts go through its copy of the outlet, SBN */
+#undef SBN_MSG_EVENTS_ON
+#define SBN_MSG_EVENTS_ON (SBN.MsgEvents && *SBN.MsgEvents)
+#undef SBN_EVS_LIMIT_PEND
+#define SBN_EVS_LIMIT_PEND(Limit) (SBN.PendEVSLimit ? SBN.PendEVSLimit(Limit) : (void)0)
+
 /**
  * This structure contains function pointers to interface-specific versions
  * of the key SBN functions.  Every interface module must have an equivalent
@@ -416,6 +521,60 @@ struct SBN_IfOps_s
      * @sa LoadNet, LoadPeer, UnloadNet
      */
     SBN_Status_t (*UnloadPeer)(SBN_PeerInterface_t *Peer);
+
+    /**
+     * Reports module-specific status for a peer (link counters, queue depths,
+     * etc.) in response to the module status HK command. Optional, modules
+     * that leave this NULL do not report status.
+     *
+     * @param Peer[in] The peer to report on.
+     * @param StatusBuf[out] The buffer to fill, packed big-endian like other HK.
+     * @param StatusBufSz[in] The size of the buffer (SBN_MOD_STATUS_MSG_SZ).
+     *
+     * @return SBN_SUCCESS when the buffer is filled, otherwise SBN_ERROR.
+     *
+     * @sa SBN_HK_MODSTATUS_CC
+     */
+    SBN_Status_t (*ReportModuleStatus)(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz);
+
+    /**
+     * Sends a message SBN has already packed to a peer. On a net with a shared
+     * pipe SBN packs each app message once and calls this for every peer
+     * subscribed to it. Optional, for modules that leave this NULL SBN calls
+     * Send for each peer instead.
+     *
+     * @param Peer[in] Interface data describing the intended peer recipient.
+     * @param MsgType[in] The SBN message type.
+     * @param MsgSz[in] The size of the SBN message payload.
+     * @param Payload[in] The SBN message payload, the same for every peer.
+     * @param PackedMsg[in] The packed message, SBN_PACKED_HDR_SZ + MsgSz bytes.
+     *
+     * @return SBN_SUCCESS when message successfully sent, otherwise SBN_ERROR.
+     *
+     * @sa Send
+     */
+    SBN_Status_t (*SendPacked)(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload,
+                               void *PackedMsg);
+
+    /**
+     * Receives an individual message from one receive shard of the network,
+     * see RecvShardCnt. Optional, called by the shard's receive task (each
+     * shard's from its own task), otherwise as RecvFromNet.
+     *
+     * @param Net[in] Interface data for the network.
+     * @param Shard[in] The shard to receive from, less than Net->RecvShardCnt.
+     * @param MsgTypePtr[out] SBN message type received.
+     * @param MsgSzPtr[out] Payload size received.
+     * @param ProcessorIDPtr[out] ProcessorID of the sender.
+     * @param SpacecraftIDPtr[out] SpacecraftID of the sender.
+     * @param PayloadBuffer[out] Payload buffer
+     *                      (pass in a buffer of CFE_MISSION_SB_MAX_SB_MSG_SIZE)
+     *
+     * @return SBN_SUCCESS on success, SBN_ERROR on failure
+     */
+    SBN_Status_t (*RecvFromShard)(SBN_NetInterface_t *Net, uint8 Shard, SBN_MsgType_t *MsgTypePtr,
+                                  SBN_MsgSz_t *MsgSzPtr, CFE_ProcessorID_t *ProcessorIDPtr,
+                                  CFE_SpacecraftID_t *SpacecraftIDPtr, void *PayloadBuffer);
 };
 
 #endif /* _sbn_interfaces_h_ */
@@ -0,0 +1,102 @@
+/******************************************************************************
+** File: sbn_module_util.h
+**
+** Purpose:
+**      This header file contains the helpers the protocol modules share for
+**      parsing their configuration addresses and packing their HK.
+**
+******************************************************************************/
+
+#ifndef _sbn_module_util_h_
+#define _sbn_module_util_h_
+
+#include <stdlib.h>
+#include <string.h>
+#include "sbn_types.h"
+
+/**
+ * Whether the option name Opt, of Len characters (up to its '='), is Name,
+ * a string literal.
+ */
+#define SBN_OPT_IS(Opt, Len, Name) ((Len) == sizeof(Name) - 1 && strncmp((Opt), (Name), (Len)) == 0)
+
+/**
+ * Puts a value big-endian.
+ *
+ * @param Ptr[out] Where to put the value.
+ * @param Val[in] The value.
+ * @return Ptr, past the value.
+ */
+static inline uint8 *SBN_PutUInt32(uint8 *Ptr, uint32 Val)
+{
+    *Ptr++ = (Val >> 24) & 0xFF;
+    *Ptr++ = (Val >> 16) & 0xFF;
+    *Ptr++ = (Val >> 8) & 0xFF;
+    *Ptr++ = Val & 0xFF;
+    return Ptr;
+} /* end SBN_PutUInt32() */
+
+/**
+ * Parses a number with an optional binary K, M or G suffix, e.g. "8M".
+ *
+ * @param Str[in] The string.
+ * @param EndPtr[out] Set past the number and suffix, as strtoul().
+ * @return The number.
+ */
+static inline unsigned long SBN_StrToSz(const char *Str, char **EndPtr)
+{
+    unsigned long Num = strtoul(Str, EndPtr, 0);
+
+    switch (**EndPtr)
+    {
+        case 'K':
+        case 'k':
+            Num <<= 10;
+            break;
+        case 'M':
+        case 'm':
+            Num <<= 20;
+            break;
+        case 'G':
+        case 'g':
+            Num <<= 30;
+            break;
+        default:
+            return Num;
+    } /* end switch */
+
+    (*EndPtr)++;
+
+    return Num;
+} /* end SBN_StrToSz() */
+
+/*
+ * Only for the modules that build against the OSAL implementation headers
+ * and include os-impl-io.h before this.
+ */
+#ifdef SBN_MODULE_NATIVE_FD
+
+/**
+ * OSAL does not (yet) provide socket options so these go to the native
+ * descriptor.
+ *
+ * @param Socket[in] The OSAL ID of the socket.
+ * @param EID[in] The module's event ID to report a socket not found with.
+ * @return The native descriptor, or -1 if the socket is not found.
+ */
+static inline int SBN_NativeFd(OS_SocketID_t Socket, CFE_EVS_EventID_t EID)
+{
+    uint32 Idx = 0;
+
+    if (OS_ConvertToArrayIndex(Socket, &Idx) != OS_SUCCESS)
+    {
+        EVSSendErr(EID, "unable to find socket (Socket=%d)", (int)Socket);
+        return -1;
+    } /* end if */
+
+    return OS_impl_filehandle_table[Idx].fd;
+} /* end SBN_NativeFd() */
+
+#endif /* SBN_MODULE_NATIVE_FD */
+
+#endif /* _sbn_module_util_h_ */
@@ -19,6 +19,21 @@
 /** @brief ProcessorID, FromMID */
 #define SBN_CMD_REMAPDEL_LEN sizeof(CFE_MSG_CommandHeader_t) + sizeof(CFE_ProcessorID_t) + sizeof(CFE_SB_MsgId_t)
 
+/** @brief uint8 Slot, CFE_SB_MsgId_t MsgID */
+#define SBN_CMD_LATMID_LEN sizeof(CFE_MSG_CommandHeader_t) + sizeof(uint8) + sizeof(CFE_SB_MsgId_t)
+
+/** @brief uint8 Enabled */
+#define SBN_CMD_MSGEVENTS_LEN sizeof(CFE_MSG_CommandHeader_t) + sizeof(uint8)
+
+/** @brief uint8 Mode (SBN_TRACE_OFF, SBN_TRACE_ON or SBN_TRACE_DUMP) */
+#define SBN_CMD_TRACE_LEN sizeof(CFE_MSG_CommandHeader_t) + sizeof(uint8)
+
+/** @brief CFE_SB_MsgId_t MsgID, uint8 Counted (1 to count the ID exactly, 0 to stop) */
+#define SBN_CMD_MIDSTATMID_LEN sizeof(CFE_MSG_CommandHeader_t) + sizeof(CFE_SB_MsgId_t) + sizeof(uint8)
+
+/** @brief uint8 NetIdx, uint8 PeerIdx, uint8 Cnt */
+#define SBN_CMD_PROBE_LEN sizeof(CFE_MSG_CommandHeader_t) + sizeof(uint8) * 3
+
 /** @brief CC, CmdCnt, CmdErrCnt, SubCnt, NetCnt */
 #define SBN_HK_LEN (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) + (sizeof(SBN_HKTlm_t) * 4))
 
@@ -31,14 +46,76 @@
     (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) + sizeof(SBN_NetIdx_t) + sizeof(SBN_PeerIdx_t) + sizeof(SBN_SubCnt_t) + \
      SBN_MAX_SUBS_PER_PEER * sizeof(CFE_SB_MsgId_t))
 
-/** @brief CC, SubCnt, ProcessorID, LastSend, LastRecv, SendCnt, RecvCnt, SendErrCnt, RecvErrCnt */
+/**
+ * @brief CC, SubCnt, ProcessorID, LastSend, LastRecv, SendCnt, RecvCnt, SendErrCnt, RecvErrCnt, RecvGapCnt,
+ * RecvDupCnt, RecvReorderCnt
+ */
 #define SBN_HKPEER_LEN                                                                                                \
     (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) + sizeof(SBN_SubCnt_t) + sizeof(CFE_ProcessorID_t) + sizeof(OS_time_t) * 2 + \
-     sizeof(SBN_HKTlm_t) * 4)
+     sizeof(SBN_HKTlm_t) * 7)
+
+/**
+ * @brief IntervalMs since the last report, SendCnt, SendBytes, SendErrCnt, RecvCnt, RecvBytes, RecvErrCnt (uint64),
+ * and per second over the interval: SendCnt, SendBytes, RecvCnt, RecvBytes
+ */
+#define SBN_HKCNTS_BLOCK_LEN (sizeof(uint32) + sizeof(uint64) * 6 + sizeof(uint32) * 4)
+
+/** @brief CC, NetIdx, PeerIdx, the net's counters, the peer's counters */
+#define SBN_HKCNTS_LEN (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) * 3 + SBN_HKCNTS_BLOCK_LEN * 2)
+
+/** @brief MsgID, MsgCnt, Bytes, Exact of each of SBN_MIDSTAT_TOP_CNT message IDs */
+#define SBN_HKMIDS_TOP_LEN (SBN_MIDSTAT_TOP_CNT * (sizeof(CFE_SB_MsgId_t) + sizeof(uint32) + sizeof(uint64) + sizeof(uint8)))
+
+/** @brief CC, NetIdx, PeerIdx, and the top message IDs sent by bytes and by messages, then received */
+#define SBN_HKMIDS_LEN (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) * 3 + SBN_HKMIDS_TOP_LEN * 4)
+
+/** @brief NetIdx, PeerCnt, PipeCnt, PipeMax of a net in SBN_HK_ALLPEERS_CC */
+#define SBN_HKALL_NET_LEN (sizeof(SBN_NetIdx_t) + sizeof(uint8) + sizeof(SBN_HKTlm_t) * 2)
+
+/**
+ * @brief ProcessorID, Flags (SBN_HKALL_*), SubCnt, SendCnt, RecvCnt, SendErrCnt, RecvErrCnt, RecvGapCnt, PipeCnt,
+ * PipeMax, LastRecvAgeMs of a peer in SBN_HK_ALLPEERS_CC
+ */
+#define SBN_HKALL_PEER_LEN \
+    (sizeof(CFE_ProcessorID_t) + sizeof(uint8) + sizeof(SBN_HKTlm_t) * 6 + sizeof(uint64) * 2 + sizeof(uint32))
+
+/** @brief CC, NetCnt, then each net followed by its peers; sent sized to those loaded, at most this */
+#define SBN_HKALL_MAX_LEN                                                                  \
+    (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) * 2 + SBN_MAX_NETS * SBN_HKALL_NET_LEN + \
+     SBN_MAX_NETS * SBN_MAX_PEER_CNT * SBN_HKALL_PEER_LEN)
+
+/** @brief The Flags of a peer in SBN_HK_ALLPEERS_CC. */
+#define SBN_HKALL_CONNECTED 0x01
+#define SBN_HKALL_SEND_TASK 0x02
+#define SBN_HKALL_RECV_TASK 0x04
+#define SBN_HKALL_SYNCED    0x08
+
+/** @brief Cnt, P50Us, P99Us, MaxUs of a latency histogram */
+#define SBN_HKLAT_HIST_LEN (sizeof(uint32) * 4)
+
+/**
+ * @brief CC, ProcessorID, Synced, OffsetUs, DelayUs, the peer's histogram, and for each of SBN_LAT_MAX_MIDS: MsgID
+ * and its histogram
+ */
+#define SBN_HKLAT_LEN                                                                                               \
+    (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) + sizeof(CFE_ProcessorID_t) + sizeof(uint8) +            \
+     sizeof(int32) + sizeof(uint32) + SBN_HKLAT_HIST_LEN + SBN_LAT_MAX_MIDS * (sizeof(CFE_SB_MsgId_t) + SBN_HKLAT_HIST_LEN))
+
+/** @brief CC, NetIdx, PeerIdx, SentCnt, RecvCnt, MinUs, AvgUs, P99Us, MaxUs */
+#define SBN_HKPROBE_LEN (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) * 5 + sizeof(uint32) * 4)
+
+/** @brief CC, SlotUs, Wakeup{Cnt, AvgUs, MaxUs}, OverrunCnt, Stages{Cnt, AvgUs, MaxUs}[SBN_STAGE_CNT] */
+#define SBN_HKPERF_LEN \
+    (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) + sizeof(uint32) * 5 + SBN_STAGE_CNT * sizeof(uint32) * 3)
 
 /** @brief CC, ProtocolID, PeerCnt */
 #define SBN_HKNET_LEN (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) + sizeof(SBN_ModuleIdx_t) + sizeof(SBN_PeerIdx_t))
 
+/** @brief CC, NetIdx, PeerIdx, ProtocolIdx, ModuleStatus[SBN_MOD_STATUS_MSG_SZ] */
+#define SBN_HKMODSTATUS_LEN                                                                                       \
+    (sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) + sizeof(SBN_NetIdx_t) + sizeof(SBN_PeerIdx_t) + \
+     sizeof(SBN_ModuleIdx_t) + SBN_MOD_STATUS_MSG_SZ)
+
 /**
  * @brief Module status response packet structure
  */
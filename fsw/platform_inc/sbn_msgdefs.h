@@ -10,6 +10,17 @@
 #define SBN_HK_MYSUBS_CC     14
 #define SBN_HK_RESET_CC      15
 #define SBN_HK_RESET_PEER_CC 16
+#define SBN_HK_MODSTATUS_CC  17
+#define SBN_HK_LAT_CC        18
+#define SBN_LAT_MID_CC       19
+#define SBN_PROBE_CC         20
+#define SBN_HK_PERF_CC       21
+#define SBN_MSG_EVENTS_CC    22
+#define SBN_TRACE_CC         23
+#define SBN_HK_CNTS_CC       24
+#define SBN_HK_MIDS_CC       25
+#define SBN_MIDSTAT_MID_CC   26
+#define SBN_HK_ALLPEERS_CC   27
 
 #define SBN_SCH_WAKEUP_CC 100
 #define SBN_TBL_CC        110
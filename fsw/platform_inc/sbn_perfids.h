@@ -4,6 +4,16 @@
 #define SBN_PERF_MIN_ID  1
 #define SBN_PERF_SEND_ID SBN_PERF_MIN_ID
 #define SBN_PERF_RECV_ID SBN_PERF_MIN_ID + 1
+
+/* the stages of a wakeup and of the tasks, in the order of SBN_Stage_t */
+#define SBN_PERF_NET_RECV_ID   SBN_PERF_MIN_ID + 2
+#define SBN_PERF_SUB_PIPE_ID   SBN_PERF_MIN_ID + 3
+#define SBN_PERF_PEER_PIPES_ID SBN_PERF_MIN_ID + 4
+#define SBN_PERF_FILTER_ID     SBN_PERF_MIN_ID + 5
+#define SBN_PERF_MOD_SEND_ID   SBN_PERF_MIN_ID + 6
+#define SBN_PERF_POLL_PEER_ID  SBN_PERF_MIN_ID + 7
+#define SBN_PERF_SEND_TASK_ID  SBN_PERF_MIN_ID + 8
+#define SBN_PERF_RECV_TASK_ID  SBN_PERF_MIN_ID + 9
 #define SBN_PERF_MAX_ID  SBN_PERF_MIN_ID + 100
 
 #endif /* _sbn_perfids_h_ */
@@ -49,6 +49,39 @@
  */
 #define SBN_MAIN_LOOP_DELAY 200
 
+/**
+ * @brief The time (in microseconds) SBN has in its SCH slot; a wakeup that
+ * takes longer is counted as an overrun (SBN_HK_PERF_CC.)
+ */
+#define SBN_WAKEUP_SLOT_US 10000
+
+/**
+ * @brief Per-message debug events (EVSSendMsgDbg) are compiled in only if
+ * this is 1, and then sent only while turned on with SBN_MSG_EVENTS_CC.
+ */
+#define SBN_MSG_EVENTS 1
+
+/**
+ * @brief Each call site of a rate-limited event (EVSSendErrLimited) sends it
+ * at most SBN_EVS_LIMIT_CNT times in SBN_EVS_LIMIT_SECS, counting the rest.
+ */
+#define SBN_EVS_LIMIT_CNT  4
+#define SBN_EVS_LIMIT_SECS 10
+
+/**
+ * @brief How many call sites with events suppressed the core holds, to send
+ * their counts from the wakeup once their window is over; the count of a
+ * site beyond that waits for its next event.
+ */
+#define SBN_EVS_LIMIT_SITES 32
+
+/**
+ * @brief The trace ring (SBN_TRACE_CC) keeps the last SBN_TRACE_DEPTH points
+ * traced, SBN_TRACE_REC_SZ bytes each when dumped to SBN_TRACE_FILENAME.
+ */
+#define SBN_TRACE_DEPTH    1024
+#define SBN_TRACE_FILENAME "/cf/sbn_trace.dat"
+
 /**
  * @brief For each peer, a pipe is created to receive messages that the peer has
  * subscribed to. The pipe should be deep enough to handle all messages that
@@ -56,6 +89,19 @@
  */
 #define SBN_PEER_PIPE_DEPTH 32
 
+/**
+ * @brief A net configured with SBN_NET_SHARED_PIPE has one pipe, for all of
+ * its peers, instead; it should be deep enough to handle all messages for
+ * all of the net's peers that will queue between wakeups.
+ */
+#define SBN_NET_PIPE_DEPTH 64
+
+/**
+ * @brief The maximum number of distinct message IDs the peers of a net
+ * configured with SBN_NET_SHARED_PIPE may subscribe to between them.
+ */
+#define SBN_MAX_SUBS_PER_NET 512
+
 /**
  * @brief The maximum number of messages that will be queued for a particular
  * message ID for a particular peer.
@@ -93,18 +139,55 @@
 /** @brief Maximum number of peers. */
 #define SBN_MAX_PEER_CNT 16
 
+/**
+ * @brief Maximum number of receive shards for a net. A module may split a
+ * net's receive path into shards (e.g. one socket each), and with
+ * SBN_TASK_RECV SBN then creates a receive task for each shard.
+ */
+#define SBN_MAX_RECV_SHARDS 8
+
+/** @brief How often clocks are exchanged with a peer whose messages are stamped (SBN_NET_STAMP), in seconds. */
+#define SBN_LAT_SYNC_SECS 5
+
+/** @brief Message IDs whose latency is kept apart, over all peers (SBN_LAT_MID_CC.) */
+#define SBN_LAT_MAX_MIDS 8
+
+/**
+ * @brief The most probes in a run of SBN_PROBE_CC. Each is sent when the
+ * last is echoed or, at the next wakeup, has waited SBN_PROBE_TIMEOUT_MS
+ * (and is counted lost.)
+ */
+#define SBN_PROBE_MAX_CNT    64
+#define SBN_PROBE_TIMEOUT_MS 1000
+
+/**
+ * @brief Traffic by message ID (SBN_HK_MIDS_CC) is kept for each peer, sent
+ * and received: exactly for up to 2^SBN_MIDSTAT_MID_BITS message IDs set with
+ * SBN_MIDSTAT_MID_CC, and for the rest in a count-min sketch of
+ * SBN_MIDSTAT_SKETCH_ROWS rows of 2^SBN_MIDSTAT_SKETCH_BITS counters, from
+ * which the SBN_MIDSTAT_TOP_CNT heaviest by bytes and by messages are kept
+ * (and reported.) A wider sketch overestimates less; each peer takes about
+ * 2 * 12 * (2^MID_BITS + ROWS * 2^SKETCH_BITS) bytes for the counters.
+ */
+#define SBN_MIDSTAT_MID_BITS     4
+#define SBN_MIDSTAT_SKETCH_ROWS  4
+#define SBN_MIDSTAT_SKETCH_BITS  5
+#define SBN_MIDSTAT_TOP_CNT      8
+
 /**
  * @brief SBN modules can provide status messages for housekeeping requests,
  * this is the maximum length those messages can be.
  */
-#define SBN_MOD_STATUS_MSG_SZ 128
+#define SBN_MOD_STATUS_MSG_SZ 256
 
 /**
  * @brief The number of characters for a "peer address", this can be
  * an IP address, a device inode path, a DTN EIN, etc. The meaning
- * of the address field is network module-dependent.
+ * of the address field is network module-dependent. Socket-based modules
+ * accept per-net options after the address ("host:port?key=val&key=val"),
+ * so leave room for those.
  */
-#define SBN_ADDR_SZ 48
+#define SBN_ADDR_SZ 128
 
 /**
  * @brief If defined, remapping is enabled at boot time.
@@ -52,6 +52,9 @@ typedef struct
      *         TaskFlags setting.
      */
     SBN_Task_Flag_t TaskFlags;
+
+    /** @brief For the entry of this CPU, how the net reads messages to send its peers (see SBN_Net_Flag_t.) */
+    SBN_Net_Flag_t NetFlags;
 } SBN_Peer_Entry_t;
 
 typedef struct
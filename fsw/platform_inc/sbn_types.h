@@ -19,6 +19,7 @@
 **            C. Knight/ARC Code TI
 ******************************************************************************/
 #include "cfe.h"
+#include "sbn_platform_cfg.h"
 
 #ifndef _sbn_types_h_
 #define _sbn_types_h_
@@ -46,6 +47,14 @@ typedef enum
     SBN_TASKS     = SBN_TASK_SEND | SBN_TASK_RECV, /**< @brief create two tasks per net/peer, tasks block on reads */
 } SBN_Task_Flag_t;
 
+typedef enum
+{
+    SBN_NET_PEER_PIPES  = 0x00, /**< @brief each peer has a pipe subscribed to the peer's MIDs */
+    SBN_NET_SHARED_PIPE = 0x01, /**< @brief the net has one pipe, subscribed to the union of its peers' MIDs */
+    SBN_NET_SEQ         = 0x02, /**< @brief app messages to each peer are numbered, as SBN_SEQ_APP_MSG */
+    SBN_NET_STAMP       = 0x04, /**< @brief app messages carry their send time, and peers' clocks are estimated */
+} SBN_Net_Flag_t;
+
 typedef enum
 {
     SBN_UDP            = 1,
@@ -64,13 +73,95 @@ typedef enum
  */
 typedef enum
 {
-    SBN_NO_MSG    = 0x00, /**< @brief no payload */
-    SBN_SUB_MSG   = 0x01, /**< @brief payload is subs */
-    SBN_UNSUB_MSG = 0x02, /**< @brief payload is unsubs */
-    SBN_APP_MSG   = 0x03, /**< @brief payload is SB msg */
-    SBN_PROTO_MSG = 0x04, /**< @brief payload is SBN proto */
+    SBN_NO_MSG            = 0x00, /**< @brief no payload */
+    SBN_SUB_MSG           = 0x01, /**< @brief payload is subs */
+    SBN_UNSUB_MSG         = 0x02, /**< @brief payload is unsubs */
+    SBN_APP_MSG           = 0x03, /**< @brief payload is SB msg */
+    SBN_PROTO_MSG         = 0x04, /**< @brief payload is SBN proto */
+    SBN_SEQ_APP_MSG       = 0x05, /**< @brief payload is a sequence header and SB msg */
+    SBN_STAMP_APP_MSG     = 0x06, /**< @brief payload is a send time and SB msg */
+    SBN_SEQ_STAMP_APP_MSG = 0x07, /**< @brief payload is a sequence header, a send time and SB msg */
+    SBN_TIME_MSG          = 0x08, /**< @brief payload is a clock exchange */
+    SBN_PROBE_MSG         = 0x09, /**< @brief payload is a probe, to be echoed */
+    SBN_PROBE_ECHO_MSG    = 0x0A, /**< @brief payload is an echoed probe */
 } SBN_MsgTypeEnum_t;
 
+/**
+ * The sequence header of an SBN_SEQ_APP_MSG: the sender's Epoch (identifying
+ * its run, never 0) and the Seq of the message among those to this peer, both
+ * uint16 big-endian. The receiver tracks the SBN_SEQ_WINDOW Seq before the
+ * highest it has seen, to tell a duplicate (dropped) from a late arrival.
+ */
+#define SBN_SEQ_HDR_SZ 4
+#define SBN_SEQ_WINDOW 32
+
+/**
+ * Times on the wire are uint32 seconds and uint32 microseconds, big-endian,
+ * of the sender's OS clock. An SBN_STAMP_APP_MSG has the time it was sent
+ * (after the sequence header, if any); an SBN_TIME_MSG has three, as in NTP:
+ * the Xmit of the last SBN_TIME_MSG received from the peer (0 if none), when
+ * that arrived, and the time this one is sent.
+ */
+#define SBN_STAMP_HDR_SZ 8
+#define SBN_TIME_MSG_SZ  (SBN_STAMP_HDR_SZ * 3)
+
+/**
+ * The size of the headers before the SB message in a payload of the type, or
+ * -1 if the type is not an app message. A module looking into app messages
+ * (for the MsgID, say) must take all four types as app messages and look this
+ * far into the payload, as nets with SBN_NET_SEQ or SBN_NET_STAMP send them.
+ */
+#define SBN_APP_HDR_SZ(MsgType)                                               \
+    ((MsgType) == SBN_APP_MSG             ? 0                                 \
+     : (MsgType) == SBN_SEQ_APP_MSG       ? SBN_SEQ_HDR_SZ                    \
+     : (MsgType) == SBN_STAMP_APP_MSG     ? SBN_STAMP_HDR_SZ                  \
+     : (MsgType) == SBN_SEQ_STAMP_APP_MSG ? SBN_SEQ_HDR_SZ + SBN_STAMP_HDR_SZ \
+                                          : -1)
+
+/** @brief Is a message of the type an app message, with or without headers? */
+#define SBN_IS_APP_MSG(MsgType) (SBN_APP_HDR_SZ(MsgType) >= 0)
+
+/**
+ * A probe (SBN_PROBE_CC) is the uint16 Id of its run, its uint16 Seq in the
+ * run and the time it was sent; the peer sends it back unchanged as an
+ * SBN_PROBE_ECHO_MSG.
+ */
+#define SBN_PROBE_MSG_SZ (4 + SBN_STAMP_HDR_SZ)
+
+/**
+ * A trace dump (SBN_TRACE_CC) is a header of the uint32 SBN_TRACE_MAGIC, the
+ * uint16 SBN_TRACE_VER, the uint16 SBN_TRACE_REC_SZ, my ProcessorID, the
+ * uint32 count of records that follow and the uint32 count overwritten before
+ * the dump; then the records, oldest first, each a time, the ProcessorID of
+ * the peer (0 if not known at that point), the MsgID and the uint8 point. All
+ * big-endian, times as on the wire.
+ */
+#define SBN_TRACE_MAGIC  0x53424E54 /* "SBNT" */
+#define SBN_TRACE_VER    1
+#define SBN_TRACE_HDR_SZ (4 + 2 + 2 + 4 + 4 + 4)
+#define SBN_TRACE_REC_SZ (SBN_STAMP_HDR_SZ + 4 + 4 + 1)
+
+/** @brief The modes of SBN_TRACE_CC: stop, clear the ring and start, stop and dump. */
+#define SBN_TRACE_OFF  0
+#define SBN_TRACE_ON   1
+#define SBN_TRACE_DUMP 2
+
+/**
+ * Latency histograms count microseconds: values under 2^SBN_LAT_SUB_BITS
+ * have a bucket each, and each power of two above that is split into
+ * 2^SBN_LAT_SUB_BITS buckets, so a bucket is at most a quarter as wide as its
+ * lower bound.
+ */
+#define SBN_LAT_SUB_BITS 2
+#define SBN_LAT_BUCKETS  ((32 - SBN_LAT_SUB_BITS + 1) << SBN_LAT_SUB_BITS)
+
+/** @brief The slots for message IDs counted exactly, and the counters in a row of the sketch, see SBN_MIDSTAT_MID_BITS. */
+#define SBN_MIDSTAT_MIDS         (1 << SBN_MIDSTAT_MID_BITS)
+#define SBN_MIDSTAT_SKETCH_WIDTH (1 << SBN_MIDSTAT_SKETCH_BITS)
+
+/** @brief Clock exchanges kept per peer; the offset is that of the one with the least round trip. */
+#define SBN_LAT_SYNC_SAMPLES 8
+
 /**
  * Mask to identift module-specific message types
  */
@@ -95,6 +186,131 @@ typedef struct
     CFE_SB_Qos_t   QoS;
 } SBN_Subs_t;
 
+/* a bit for each peer of a net, by index into the net's Peers */
+typedef uint32 SBN_PeerMask_t;
+
+/* used in the subscription table of a net with a shared pipe */
+typedef struct
+{
+    CFE_SB_MsgId_t MsgID;
+    SBN_PeerMask_t Peers;
+} SBN_NetSub_t;
+
+typedef struct
+{
+    uint32 Buckets[SBN_LAT_BUCKETS];
+
+    /** @brief Values counted, and the largest. */
+    uint32 Cnt, MaxUs;
+} SBN_LatHist_t;
+
+typedef struct
+{
+    /** @brief The Xmit of the last SBN_TIME_MSG from the peer and when it arrived, 0 if none. */
+    int64 PeerXmitUs, PeerXmitRecvUs;
+
+    /** @brief When the last SBN_TIME_MSG was sent to the peer, and the last Orig used. */
+    int64 LastSentUs, LastOrigUs;
+
+    /** @brief The last exchanges' round trips and offsets. */
+    int64 SampleDelayUs[SBN_LAT_SYNC_SAMPLES], SampleOffsetUs[SBN_LAT_SYNC_SAMPLES];
+    uint8 SampleCnt, SampleNext;
+
+    /** @brief The peer's clock less mine, and the round trip of the exchange it is from. */
+    bool  Valid;
+    int64 OffsetUs, DelayUs;
+} SBN_LatSync_t;
+
+/**
+ * @brief The stages timed, each with its perf ID (sbn_perfids.h.) A stage's
+ * time includes that of any stage it calls: the peer pipes include the
+ * filters, module sends and polls done draining them.
+ */
+typedef enum
+{
+    SBN_STAGE_NET_RECV = 0, /**< @brief receiving from the nets, in the wakeup */
+    SBN_STAGE_SUB_PIPE,     /**< @brief the subscription pipe */
+    SBN_STAGE_PEER_PIPES,   /**< @brief draining the peer and net pipes */
+    SBN_STAGE_FILTER,       /**< @brief a peer's send or receive filter chain */
+    SBN_STAGE_MOD_SEND,     /**< @brief a module's Send or SendPacked */
+    SBN_STAGE_POLL_PEER,    /**< @brief a module's PollPeer */
+    SBN_STAGE_SEND_TASK,    /**< @brief a send task sending a message */
+    SBN_STAGE_RECV_TASK,    /**< @brief a receive task processing a message */
+    SBN_STAGE_CNT
+} SBN_Stage_t;
+
+typedef struct
+{
+    /** @brief Times timed, and the largest. */
+    uint32 Cnt, MaxUs;
+    uint64 TotalUs;
+} SBN_StageStats_t;
+
+/**
+ * Message and byte counters are bumped from the main loop and the send and
+ * receive tasks, so they are 64 bits (never wrapping) and added to and read
+ * with the compiler's atomics, which neither lose a count to a race nor read
+ * one half-written. A platform without 64-bit atomics can define its own
+ * SBN_CNT_ADD and SBN_CNT_GET (say, under a lock) before this.
+ */
+#ifndef SBN_CNT_ADD
+#define SBN_CNT_ADD(Cnt, N) ((void)__atomic_fetch_add(&(Cnt), (N), __ATOMIC_RELAXED))
+#define SBN_CNT_GET(Cnt)    __atomic_load_n(&(Cnt), __ATOMIC_RELAXED)
+#endif /* SBN_CNT_ADD */
+
+/** @brief Messages and bytes (of payload) sent to and received from a peer or net. */
+typedef struct
+{
+    uint64 SendCnt, SendBytes, SendErrCnt;
+    uint64 RecvCnt, RecvBytes, RecvErrCnt;
+} SBN_Cnts_t;
+
+/** @brief The traffic of a message ID, counted or (not Exact) estimated from the sketch. */
+typedef struct
+{
+    CFE_SB_MsgId_t MsgID;
+    uint32         MsgCnt;
+    uint64         Bytes;
+    bool           Exact;
+} SBN_MidCnt_t;
+
+/**
+ * @brief Traffic by message ID one way to or from a peer (SBN_HK_MIDS_CC.)
+ * Messages with an ID in SBN.MidStatMids are counted in its slot, the rest in
+ * the sketch, where an ID's count is the least of its counters (one per row),
+ * never too low but too high by whatever shares them.
+ */
+typedef struct
+{
+    uint32 MidMsgCnts[SBN_MIDSTAT_MIDS];
+    uint64 MidBytes[SBN_MIDSTAT_MIDS];
+
+    uint32 SketchMsgCnts[SBN_MIDSTAT_SKETCH_ROWS][SBN_MIDSTAT_SKETCH_WIDTH];
+    uint64 SketchBytes[SBN_MIDSTAT_SKETCH_ROWS][SBN_MIDSTAT_SKETCH_WIDTH];
+
+    /** @brief The heaviest in the sketch by bytes and by messages, unordered; MsgCnt 0 if unused. */
+    SBN_MidCnt_t TopBytes[SBN_MIDSTAT_TOP_CNT], TopMsgs[SBN_MIDSTAT_TOP_CNT];
+} SBN_MidStats_t;
+
+/**
+ * @brief The points in the life of an app message that are traced
+ * (SBN_TRACE_CC.) Sending, a message is taken from a pipe, filtered, packed
+ * and handed to a module; receiving, it is received, unpacked, filtered and
+ * put on the local bus.
+ */
+typedef enum
+{
+    SBN_TRACE_PIPE_DEQ = 0, /**< @brief taken from a peer's or net's pipe */
+    SBN_TRACE_FILTER_IN,    /**< @brief into a peer's send or receive filter chain */
+    SBN_TRACE_FILTER_OUT,   /**< @brief out of the filter chain, passed or not */
+    SBN_TRACE_PACK,         /**< @brief packed with the SBN header */
+    SBN_TRACE_MOD_SEND,     /**< @brief handed to the module to send */
+    SBN_TRACE_RECV,         /**< @brief received by a module, as it is unpacked */
+    SBN_TRACE_UNPACK,       /**< @brief unpacked */
+    SBN_TRACE_SB_XMIT,      /**< @brief put on the local bus */
+    SBN_TRACE_POINT_CNT
+} SBN_TracePoint_t;
+
 /* most/all scalars should be typedef'd for readability and type checking */
 typedef int16             SBN_MsgSz_t; /* needs to support < 0 for errs */
 typedef uint8             SBN_MsgType_t;
@@ -124,5 +340,91 @@ typedef uint16            SBN_HKTlm_t;
 #define EVSSendErr(E, ...)  CFE_EVS_SendEvent((E), CFE_EVS_EventType_ERROR, __VA_ARGS__)
 #define EVSSendCrit(E, ...) CFE_EVS_SendEvent((E), CFE_EVS_EventType_CRITICAL, __VA_ARGS__)
 
+/**
+ * Whether per-message debug events are sent at run time, as set by
+ * SBN_MSG_EVENTS_CC: the core reads its own flag (sbn_app.h) and modules
+ * theirs through the outlet (sbn_interfaces.h.)
+ */
+#ifndef SBN_MSG_EVENTS_ON
+#define SBN_MSG_EVENTS_ON 1
+#endif /* SBN_MSG_EVENTS_ON */
+
+/**
+ * A debug event for every message or every peer every wakeup: compiled out
+ * unless SBN_MSG_EVENTS (sbn_platform_cfg.h), and not even formatted unless
+ * SBN_MSG_EVENTS_ON.
+ */
+#define EVSSendMsgDbg(E, ...)                           \
+    do                                                  \
+    {                                                   \
+        if (SBN_MSG_EVENTS && SBN_MSG_EVENTS_ON)        \
+        {                                               \
+            EVSSendDbg((E), __VA_ARGS__);               \
+        } /* end if */                                  \
+    } while (0)
+
+/** @brief The state of one rate-limited event (of its call site.) */
+typedef struct
+{
+    uint32 WindowSecs, Suppressed;
+    uint16 Cnt;
+
+    /** @brief The event's ID and type, for the count of those suppressed. */
+    CFE_EVS_EventID_t EID;
+    uint16            Type;
+} SBN_EVSLimit_t;
+
+/**
+ * Hands a call site that has begun to suppress its event to the core, which
+ * sends the count from its wakeup once the window is over. The core calls
+ * its own (sbn_app.h) and modules theirs through the outlet (sbn_interfaces.h.)
+ */
+#ifndef SBN_EVS_LIMIT_PEND
+#define SBN_EVS_LIMIT_PEND(Limit) ((void)0)
+#endif /* SBN_EVS_LIMIT_PEND */
+
+/**
+ * An event that a flood of bad messages would repeat: each call site sends
+ * at most SBN_EVS_LIMIT_CNT per SBN_EVS_LIMIT_SECS, and the count of those
+ * suppressed follows when the window is over, from the core's wakeup, or
+ * before the next sent if that comes first. The state is unlocked, so a
+ * count may be off when tasks share a call site.
+ */
+#define EVSSendLimited(T, E, ...)                                                                                   \
+    do                                                                                                              \
+    {                                                                                                               \
+        static SBN_EVSLimit_t EVSLimit_;                                                                            \
+        OS_time_t             EVSNow_ = {0};                                                                        \
+        uint32                EVSSecs_;                                                                             \
+                                                                                                                    \
+        OS_GetLocalTime(&EVSNow_);                                                                                  \
+        EVSSecs_ = (uint32)OS_TimeGetTotalSeconds(EVSNow_);                                                         \
+        if (EVSSecs_ - EVSLimit_.WindowSecs >= SBN_EVS_LIMIT_SECS)                                                  \
+        {                                                                                                           \
+            if (EVSLimit_.Suppressed)                                                                               \
+            {                                                                                                       \
+                CFE_EVS_SendEvent((E), (T), "suppressed %lu like the next", (unsigned long)EVSLimit_.Suppressed); \
+            } /* end if */                                                                                          \
+            EVSLimit_.WindowSecs = EVSSecs_;                                                                        \
+            EVSLimit_.Cnt        = 0;                                                                               \
+            EVSLimit_.Suppressed = 0;                                                                               \
+        } /* end if */                                                                                              \
+                                                                                                                    \
+        if (EVSLimit_.Cnt < SBN_EVS_LIMIT_CNT)                                                                      \
+        {                                                                                                           \
+            EVSLimit_.Cnt++;                                                                                        \
+            CFE_EVS_SendEvent((E), (T), __VA_ARGS__);                                                               \
+        }                                                                                                           \
+        else if (EVSLimit_.Suppressed++ == 0)                                                                       \
+        {                                                                                                           \
+            EVSLimit_.EID  = (E);                                                                                   \
+            EVSLimit_.Type = (T);                                                                                   \
+            SBN_EVS_LIMIT_PEND(&EVSLimit_);                                                                         \
+        } /* end if */                                                                                              \
+    } while (0)
+
+#define EVSSendInfoLimited(E, ...) EVSSendLimited(CFE_EVS_EventType_INFORMATION, (E), __VA_ARGS__)
+#define EVSSendErrLimited(E, ...)  EVSSendLimited(CFE_EVS_EventType_ERROR, (E), __VA_ARGS__)
+
 /*****************************************************************************/
 #endif /* _sbn_types_h_ */
@@ -26,6 +26,10 @@
 
 #include "sbn_pack.h"
 #include "sbn_app.h"
+#include "sbn_lat.h"
+#include "sbn_perf.h"
+#include "sbn_trace.h"
+#include "sbn_midstat.h"
 #include "cfe_sb_events.h" /* For event message IDs */
 #include "cfe_es.h"        /* PerfLog */
 #include "cfe_platform_cfg.h"
@@ -44,6 +48,9 @@ static SBN_Status_t UnloadModules(void)
 {
     SBN_ModuleIdx_t i = 0;
 
+    /* the modules' rate-limited events go with them */
+    SBN_FlushEVSLimits(true);
+
     for (i = 0; i < SBN_MAX_MOD_CNT; i++)
     {
         if (SBN.ProtocolModules[i] == 0)
@@ -104,6 +111,12 @@ void SBN_PackMsg(void *SBNBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_Pro
     } /* end if */
 
     Pack_Data(&Pack, Msg, MsgSz);
+
+    if (SBN.Trace.On)
+    {
+        /* the peer isn't known here, a net's message is packed once for all */
+        SBN_TraceNetMsg(SBN_TRACE_PACK, SBN_LatNowUs(), 0, MsgType, MsgSz, Msg);
+    } /* end if */
 } /* end SBN_PackMsg */
 
 /**
@@ -124,7 +137,8 @@ bool SBN_UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePt
                    CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr,
                    void *Msg)
 {
-    uint8  t = 0;
+    uint8  t      = 0;
+    int64  RecvUs = SBN.Trace.On ? SBN_LatNowUs() : 0;
     Pack_t Pack;
     Pack_Init(&Pack, SBNBuf, SBN_MAX_PACKED_MSG_SZ, false);
     Unpack_Int16(&Pack, MsgSzPtr);
@@ -145,6 +159,12 @@ bool SBN_UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePt
 
     Unpack_Data(&Pack, Msg, *MsgSzPtr);
 
+    if (SBN.Trace.On)
+    {
+        SBN_TraceNetMsg(SBN_TRACE_RECV, RecvUs, *ProcessorIDPtr, *MsgTypePtr, *MsgSzPtr, Msg);
+        SBN_TraceNetMsg(SBN_TRACE_UNPACK, SBN_LatNowUs(), *ProcessorIDPtr, *MsgTypePtr, *MsgSzPtr, Msg);
+    } /* end if */
+
     return true;
 } /* end SBN_UnpackMsg */
 
@@ -166,27 +186,31 @@ SBN_Status_t SBN_Connected(SBN_PeerInterface_t *Peer)
         return SBN_ERROR;
     } /* end if */
 
-    char PipeName[OS_MAX_API_NAME];
+    /* peers of a net with a shared pipe are sent messages from the net's pipe */
+    if (!(Peer->Net->NetFlags & SBN_NET_SHARED_PIPE))
+    {
+        char PipeName[OS_MAX_API_NAME];
 
-    /* create a pipe name string similar to SBN_0_Pipe */
-    snprintf(PipeName, OS_MAX_API_NAME, "SBN_%d_%d_Pipe", (int)(Peer->ProcessorID), (int)(Peer->SpacecraftID));
-    CFE_Status = CFE_SB_CreatePipe(&(Peer->Pipe), SBN_PEER_PIPE_DEPTH, PipeName);
+        /* create a pipe name string similar to SBN_0_Pipe */
+        snprintf(PipeName, OS_MAX_API_NAME, "SBN_%d_%d_Pipe", (int)(Peer->ProcessorID), (int)(Peer->SpacecraftID));
+        CFE_Status = CFE_SB_CreatePipe(&(Peer->Pipe), SBN_PEER_PIPE_DEPTH, PipeName);
 
-    if (CFE_Status != CFE_SUCCESS)
-    {
-        EVSSendErr(SBN_PEER_EID, "%s: could not create peer pipe '%s'", FAIL_PREFIX, PipeName);
+        if (CFE_Status != CFE_SUCCESS)
+        {
+            EVSSendErr(SBN_PEER_EID, "%s: could not create peer pipe '%s'", FAIL_PREFIX, PipeName);
 
-        return SBN_ERROR;
-    } /* end if */
+            return SBN_ERROR;
+        } /* end if */
 
-    EVSSendInfo(SBN_PEER_EID, "Created peer pipe '%s'", PipeName);
+        EVSSendInfo(SBN_PEER_EID, "Created peer pipe '%s'", PipeName);
 
-    CFE_Status = CFE_SB_SetPipeOpts(Peer->Pipe, CFE_SB_PIPEOPTS_IGNOREMINE);
-    if (CFE_Status != CFE_SUCCESS)
-    {
-        EVSSendErr(SBN_PEER_EID, "%s: could not set pipe options '%s'", FAIL_PREFIX, PipeName);
+        CFE_Status = CFE_SB_SetPipeOpts(Peer->Pipe, CFE_SB_PIPEOPTS_IGNOREMINE);
+        if (CFE_Status != CFE_SUCCESS)
+        {
+            EVSSendErr(SBN_PEER_EID, "%s: could not set pipe options '%s'", FAIL_PREFIX, PipeName);
 
-        return SBN_ERROR;
+            return SBN_ERROR;
+        } /* end if */
     } /* end if */
 
     EVSSendInfo(SBN_PEER_EID, "Peer %d:%d connected.", Peer->SpacecraftID, (int)(Peer->ProcessorID));
@@ -203,6 +227,10 @@ SBN_Status_t SBN_Connected(SBN_PeerInterface_t *Peer)
 
     SBN_Status = SBN_SendLocalSubsToPeer(Peer);
 
+    /* the peer may have restarted with the same Epoch, if only by chance */
+    Peer->RecvSeqValid = false;
+    memset(&Peer->LatSync, 0, sizeof(Peer->LatSync));
+
     Peer->Connected = 1;
 
     return SBN_Status;
@@ -227,7 +255,12 @@ SBN_Status_t SBN_Disconnected(SBN_PeerInterface_t *Peer)
 
     Peer->Connected = 0; /**< mark as disconnected before deleting pipe */
 
-    if((Status = CFE_SB_DeletePipe(Peer->Pipe)) != CFE_SUCCESS) {
+    if (Peer->Net->NetFlags & SBN_NET_SHARED_PIPE)
+    {
+        /* the net's pipe stays, but no longer reads messages for this peer */
+        SBN_RemoveAllSubsFromPeer(Peer);
+    }
+    else if((Status = CFE_SB_DeletePipe(Peer->Pipe)) != CFE_SUCCESS) {
       EVSSendErr(SBN_PEER_EID, "%s could not delete pipe when disconnecting peer %d:%d: 0x%08x", 
           FAIL_PREFIX,
           Peer->SpacecraftID,
@@ -241,6 +274,11 @@ SBN_Status_t SBN_Disconnected(SBN_PeerInterface_t *Peer)
     Peer->SendErrCnt = 0;
     Peer->RecvErrCnt = 0;
 
+    Peer->RecvGapCnt     = 0;
+    Peer->RecvDupCnt     = 0;
+    Peer->RecvReorderCnt = 0;
+    memset(&Peer->LatHist, 0, sizeof(Peer->LatHist));
+
     Peer->SubCnt = 0; /* reset sub count, in case this is a reconnection */
 
     EVSSendInfo(SBN_PEER_EID, "Disconnected from peer %d:%d.", Peer->SpacecraftID, (int)(Peer->ProcessorID));
@@ -264,6 +302,7 @@ typedef struct
     CFE_SpacecraftID_t   SpacecraftID;
     SBN_MsgType_t        MsgType;
     SBN_MsgSz_t          MsgSz;
+    int64                EntryUs;
     uint8                Msg[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
 } RecvPeerTaskData_t;
 
@@ -320,7 +359,9 @@ void SBN_RecvPeerTask(void)
         {
             OS_GetLocalTime(&D.Peer->LastRecv);
 
-            D.Status = SBN_ProcessNetMsg(D.Net, D.MsgType, D.ProcessorID, D.SpacecraftID, D.MsgSz, &D.Msg);
+            D.EntryUs = SBN_PerfEntry(SBN_STAGE_RECV_TASK);
+            D.Status  = SBN_ProcessNetMsg(D.Net, D.MsgType, D.ProcessorID, D.SpacecraftID, D.MsgSz, &D.Msg);
+            SBN_PerfExit(SBN_STAGE_RECV_TASK, D.EntryUs);
 
             if (D.Status != SBN_SUCCESS)
             {
@@ -332,6 +373,8 @@ void SBN_RecvPeerTask(void)
         {
             EVSSendErr(SBN_PEER_EID, "recv error (%d)", D.Status);
             D.Peer->RecvErrCnt++;
+            SBN_CNT_ADD(D.Peer->Cnts.RecvErrCnt, 1);
+            SBN_CNT_ADD(D.Net->Cnts.RecvErrCnt, 1);
             D.Peer->RecvTaskID = 0;
             return;
         } /* end if */
@@ -341,6 +384,8 @@ void SBN_RecvPeerTask(void)
 typedef struct RecvNetTaskData_s
 {
     SBN_NetIdx_t         NetIdx;
+    uint8                Shard;
+    bool                 Sharded;
     SBN_NetInterface_t * Net;
     SBN_PeerInterface_t *Peer;
     SBN_Status_t         Status;
@@ -349,9 +394,64 @@ typedef struct RecvNetTaskData_s
     CFE_SpacecraftID_t   SpacecraftID;
     SBN_MsgType_t        MsgType;
     SBN_MsgSz_t          MsgSz;
+    int64                EntryUs;
     uint8                Msg[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
 } RecvNetTaskData_t;
 
+/**
+ * \brief Receives from a net (or a receive shard of it) until there is an
+ * error, sending the messages on to the local bus.
+ */
+static void RecvNetLoop(RecvNetTaskData_t *D)
+{
+    static const char FAIL_PREFIX_RUNNING[] = "ERROR: during SBN Receive Net Task:";
+
+    while (1)
+    {
+        EVSSendMsgDbg(SBN_PEERTASK_EID, "Try to receive from net...");
+        if (D->Sharded)
+        {
+            D->Status = D->Net->IfOps->RecvFromShard(D->Net, D->Shard, &D->MsgType, &D->MsgSz, &D->ProcessorID,
+                                                     &D->SpacecraftID, &D->Msg);
+        }
+        else
+        {
+            D->Status = D->Net->IfOps->RecvFromNet(D->Net, &D->MsgType, &D->MsgSz, &D->ProcessorID, &D->SpacecraftID,
+                                                   &D->Msg);
+        } /* end if */
+
+        if (D->Status == SBN_IF_EMPTY)
+        {
+            continue; /* no (more) messages */
+        }             /* end if */
+
+        if (D->Status != SBN_SUCCESS)
+        {
+            EVSSendErr(SBN_PEERTASK_EID, "%s RecvFromNet failed for net %d: status=0x%08X", FAIL_PREFIX_RUNNING, D->NetIdx, D->Status);
+            break;
+        } /* end if */
+
+        D->Peer = SBN_GetPeer(D->Net, D->ProcessorID, D->SpacecraftID);
+        if (!D->Peer)
+        {
+            EVSSendErrLimited(SBN_PEERTASK_EID, "unknown peer (ProcessorID=%d)", (int)D->ProcessorID);
+            break;
+        } /* end if */
+
+        OS_GetLocalTime(&D->Peer->LastRecv);
+
+        D->EntryUs = SBN_PerfEntry(SBN_STAGE_RECV_TASK);
+        D->Status  = SBN_ProcessNetMsg(D->Net, D->MsgType, D->ProcessorID, D->SpacecraftID, D->MsgSz, &D->Msg);
+        SBN_PerfExit(SBN_STAGE_RECV_TASK, D->EntryUs);
+
+        if (D->Status != SBN_SUCCESS)
+        {
+            EVSSendErr(SBN_PEERTASK_EID, "SBN_ProcessNetMsg failed: 0x%08X", D->Status);
+            break;
+        } /* end if */
+    }     /* end while */
+} /* end RecvNetLoop() */
+
 /**
  * \brief Receive task created for each net-based connection.
  * Spanwed from PeerPoll()
@@ -359,7 +459,6 @@ typedef struct RecvNetTaskData_s
 void SBN_RecvNetTask(void)
 {
     static const char FAIL_PREFIX_STARTUP[] = "ERROR: could not start SBN Receive Net Task:";
-    static const char FAIL_PREFIX_RUNNING[] = "ERROR: during SBN Receive Net Task:";
     RecvNetTaskData_t D;
     memset(&D, 0, sizeof(D));
 
@@ -380,43 +479,53 @@ void SBN_RecvNetTask(void)
         return;
     } /* end if */
 
-    while (1)
-    {
-        EVSSendDbg(SBN_PEERTASK_EID,"Try to receive from net...");
-        D.Status = D.Net->IfOps->RecvFromNet(D.Net, &D.MsgType, &D.MsgSz, &D.ProcessorID, &D.SpacecraftID, &D.Msg);
+    RecvNetLoop(&D);
 
-        if (D.Status == SBN_IF_EMPTY)
-        {
-            continue; /* no (more) messages */
-        }             /* end if */
+    /* Unset the task id so that it can be created if necessary */
+    D.Net->RecvTaskID = 0;
+} /* end SBN_RecvNetTask() */
 
-        if (D.Status != SBN_SUCCESS)
-        {
-            EVSSendErr(SBN_PEERTASK_EID, "%s RecvFromNet failed for net %d: status=0x%08X", FAIL_PREFIX_RUNNING, D.NetIdx, D.Status);
-            break;
-        } /* end if */
+/**
+ * \brief Receive task created for each receive shard of a net.
+ * Spanwed from PeerPoll()
+ */
+void SBN_RecvShardTask(void)
+{
+    static const char FAIL_PREFIX_STARTUP[] = "ERROR: could not start SBN Receive Shard Task:";
+    RecvNetTaskData_t D;
+    memset(&D, 0, sizeof(D));
+
+    D.RecvTaskID = OS_TaskGetId();
+    D.Sharded    = true;
 
-        D.Peer = SBN_GetPeer(D.Net, D.ProcessorID, D.SpacecraftID);
-        if (!D.Peer)
+    for (D.NetIdx = 0; D.NetIdx < SBN.NetCnt; D.NetIdx++)
+    {
+        D.Net = &SBN.Nets[D.NetIdx];
+        for (D.Shard = 0; D.Shard < D.Net->RecvShardCnt; D.Shard++)
         {
-            EVSSendErr(SBN_PEERTASK_EID, "unknown peer (ProcessorID=%d)", (int)D.ProcessorID);
-            break;
-        } /* end if */
+            if (D.Net->ShardRecvTaskIDs[D.Shard] == D.RecvTaskID)
+            {
+                break;
+            } /* end if */
+        }     /* end for */
 
-        OS_GetLocalTime(&D.Peer->LastRecv);
+        if (D.Shard < D.Net->RecvShardCnt)
+        {
+            break; /* found a ringer */
+        }          /* end if */
+    }              /* end for */
 
-        D.Status = SBN_ProcessNetMsg(D.Net, D.MsgType, D.ProcessorID, D.SpacecraftID, D.MsgSz, &D.Msg);
+    if (D.NetIdx == SBN.NetCnt)
+    {
+        EVSSendErr(SBN_PEERTASK_EID, "%s unable to connect task to net struct", FAIL_PREFIX_STARTUP);
+        return;
+    } /* end if */
 
-        if (D.Status != SBN_SUCCESS)
-        {
-            EVSSendErr(SBN_PEERTASK_EID, "SBN_ProcessNetMsg failed: 0x%08X", D.Status);
-            break;
-        } /* end if */
-    }     /* end while */
+    RecvNetLoop(&D);
 
     /* Unset the task id so that it can be created if necessary */
-    D.Net->RecvTaskID = 0;
-} /* end SBN_RecvNetTask() */
+    D.Net->ShardRecvTaskIDs[D.Shard] = 0;
+} /* end SBN_RecvShardTask() */
 
 /**
  * Checks all interfaces for messages from peers.
@@ -463,7 +572,7 @@ SBN_Status_t SBN_RecvNetMsgs(void)
 
                 if (!Peer)
                 {
-                    EVSSendInfo(SBN_PEERTASK_EID, "unknown peer (ProcessorID=%d)", (int)ProcessorID);
+                    EVSSendInfoLimited(SBN_PEERTASK_EID, "unknown peer (ProcessorID=%d)", (int)ProcessorID);
                     /* may be a misconfiguration on my part...? continue processing msgs... */
                     continue;
                 } /* end if */
@@ -520,21 +629,66 @@ SBN_Status_t SBN_RecvNetMsgs(void)
 } /* end SBN_RecvNetMsgs */
 
 /**
- * Sends a message to a peer using the module's send API.
+ * Sends an app message to a peer with the headers its net's flags ask for:
+ * a sequence header with the peer's next Seq (SBN_NET_SEQ) and the send time
+ * (SBN_NET_STAMP.) Called with the send mutex held, which guards the buffer
+ * the headers and message are packed into.
+ *
+ * @param Peer The peer to send the message to.
+ * @param MsgSz Size of the message, leaving room for the headers in a
+ *        CFE_MISSION_SB_MAX_SB_MSG_SIZE payload.
+ * @param Msg Message to send
+ * @return The module's send status.
+ */
+static SBN_Status_t SendTagged(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_NetInterface_t *Net     = Peer->Net;
+    SBN_MsgType_t       MsgType = SBN_STAMP_APP_MSG;
+    static uint8        Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    Pack_t              Pack;
+
+    Pack_Init(&Pack, Buf, sizeof(Buf), false);
+
+    if (Net->NetFlags & SBN_NET_SEQ)
+    {
+        MsgType = Net->NetFlags & SBN_NET_STAMP ? SBN_SEQ_STAMP_APP_MSG : SBN_SEQ_APP_MSG;
+        Pack_UInt16(&Pack, SBN.SeqEpoch);
+        Pack_UInt16(&Pack, Peer->SendSeq++);
+    } /* end if */
+
+    if (Net->NetFlags & SBN_NET_STAMP)
+    {
+        SBN_LatPackUs(&Pack, SBN_LatNowUs());
+    } /* end if */
+
+    Pack_Data(&Pack, Msg, MsgSz);
+
+    return Net->IfOps->Send(Peer, MsgType, Pack.BufUsed, Buf);
+} /* end SendTagged */
+
+/**
+ * Sends a message to a peer using the module's send API, or if the message
+ * has already been packed and the module can send it so, the packed message.
  *
  * @param MsgType SBN type of the message
  * @param MsgSz Size of the message
  * @param Msg Message to send
+ * @param PackedMsg The packed message, or NULL.
  * @param Peer The peer to send the message to.
- * @return Number of characters sent on success, -1 on error.
- *
+ * @return SBN_SUCCESS on success, SBN_ERROR on error.
  */
-SBN_Status_t SBN_SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+static SBN_Status_t SendToPeer(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, void *PackedMsg,
+                               SBN_PeerInterface_t *Peer)
 {
     SBN_NetInterface_t *Net        = Peer->Net;
     SBN_Status_t        SBN_Status = SBN_SUCCESS;
+    SBN_MsgSz_t         TagSz      = (Net->NetFlags & SBN_NET_SEQ ? SBN_SEQ_HDR_SZ : 0) +
+                            (Net->NetFlags & SBN_NET_STAMP ? SBN_STAMP_HDR_SZ : 0);
+    int64               EntryUs    = 0;
+    bool                Tagged     = MsgType == SBN_APP_MSG && TagSz && MsgSz + TagSz <= CFE_MISSION_SB_MAX_SB_MSG_SIZE;
+    bool                Locked     = Peer->SendTaskID || Net->SendTaskID || Tagged;
 
-    if (Peer->SendTaskID)
+    if (Locked)
     {
         if (OS_MutSemTake(SBN.SendMutex) != OS_SUCCESS)
         {
@@ -543,19 +697,51 @@ SBN_Status_t SBN_SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg,
         } /* end if */
     }     /* end if */
 
-    SBN_Status = Net->IfOps->Send(Peer, MsgType, MsgSz, Msg);
+    EntryUs = SBN_PerfEntry(SBN_STAGE_MOD_SEND);
+
+    if (MsgType == SBN_APP_MSG)
+    {
+        SBN_TRACE(SBN_TRACE_MOD_SEND, Peer->ProcessorID, Msg);
+    } /* end if */
+
+    if (Tagged)
+    {
+        /* numbered and stamped per peer, so never the message packed once for the net */
+        SBN_Status = SendTagged(Peer, MsgSz, Msg);
+    }
+    else if (PackedMsg && Net->IfOps->SendPacked)
+    {
+        SBN_Status = Net->IfOps->SendPacked(Peer, MsgType, MsgSz, Msg, PackedMsg);
+    }
+    else
+    {
+        SBN_Status = Net->IfOps->Send(Peer, MsgType, MsgSz, Msg);
+    } /* end if */
+
+    SBN_PerfExit(SBN_STAGE_MOD_SEND, EntryUs);
 
     if (SBN_Status != SBN_SUCCESS)
     {
         Peer->SendErrCnt++;
+        SBN_CNT_ADD(Peer->Cnts.SendErrCnt, 1);
+        SBN_CNT_ADD(Net->Cnts.SendErrCnt, 1);
     } else {
         Peer->SendCnt++;
+        SBN_CNT_ADD(Peer->Cnts.SendCnt, 1);
+        SBN_CNT_ADD(Peer->Cnts.SendBytes, MsgSz);
+        SBN_CNT_ADD(Net->Cnts.SendCnt, 1);
+        SBN_CNT_ADD(Net->Cnts.SendBytes, MsgSz);
+
+        if (MsgType == SBN_APP_MSG)
+        {
+            SBN_MidStatMsg(&Peer->SendMids, Msg, MsgSz);
+        } /* end if */
     } /* end if */
 
     /* for clients that need a poll or heartbeat, update time even when failing */
     OS_GetLocalTime(&Peer->LastSend);
 
-    if (Peer->SendTaskID)
+    if (Locked)
     {
         if (OS_MutSemGive(SBN.SendMutex) != OS_SUCCESS)
         {
@@ -565,8 +751,153 @@ SBN_Status_t SBN_SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg,
     }     /* end if */
 
     return SBN_Status;
+} /* end SendToPeer */
+
+/**
+ * Sends a message to a peer using the module's send API.
+ *
+ * @param MsgType SBN type of the message
+ * @param MsgSz Size of the message
+ * @param Msg Message to send
+ * @param Peer The peer to send the message to.
+ * @return Number of characters sent on success, -1 on error.
+ *
+ */
+SBN_Status_t SBN_SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+{
+    return SendToPeer(MsgType, MsgSz, Msg, NULL, Peer);
 } /* end SBN_SendNetMsg */
 
+/**
+ * Applies a peer's send filters to a message, in place.
+ *
+ * @param Peer The peer the message is for.
+ * @param Msg The message.
+ * @return SBN_SUCCESS if the message should be sent, SBN_IF_EMPTY if a filter
+ *         rejected it, SBN_ERROR if a filter failed.
+ */
+static SBN_Status_t FilterSendToPeer(SBN_PeerInterface_t *Peer, void *Msg)
+{
+    SBN_ModuleIdx_t  FilterIdx  = 0;
+    SBN_Status_t     SBN_Status = SBN_SUCCESS;
+    SBN_Filter_Ctx_t Filter_Context;
+    int64            EntryUs    = SBN_PerfEntry(SBN_STAGE_FILTER);
+
+    Filter_Context.MyProcessorID    = CFE_PSP_GetProcessorId();
+    Filter_Context.MySpacecraftID   = CFE_PSP_GetSpacecraftId();
+    Filter_Context.PeerProcessorID  = Peer->ProcessorID;
+    Filter_Context.PeerSpacecraftID = Peer->SpacecraftID;
+
+    SBN_TRACE(SBN_TRACE_FILTER_IN, Peer->ProcessorID, Msg);
+
+    for (FilterIdx = 0; FilterIdx < Peer->FilterCnt; FilterIdx++)
+    {
+        if (Peer->Filters[FilterIdx]->FilterSend == NULL)
+        {
+            continue;
+        } /* end if */
+
+        SBN_Status = (Peer->Filters[FilterIdx]->FilterSend)(Msg, &Filter_Context);
+        if (SBN_Status != SBN_SUCCESS)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    SBN_PerfExit(SBN_STAGE_FILTER, EntryUs);
+    SBN_TRACE(SBN_TRACE_FILTER_OUT, Peer->ProcessorID, Msg);
+
+    return SBN_Status;
+} /* end FilterSendToPeer */
+
+/**
+ * Does a peer have any send filters (that may alter the message)?
+ */
+static bool HasSendFilter(SBN_PeerInterface_t *Peer)
+{
+    SBN_ModuleIdx_t FilterIdx = 0;
+
+    for (FilterIdx = 0; FilterIdx < Peer->FilterCnt; FilterIdx++)
+    {
+        if (Peer->Filters[FilterIdx]->FilterSend != NULL)
+        {
+            return true;
+        } /* end if */
+    }     /* end for */
+
+    return false;
+} /* end HasSendFilter */
+
+/**
+ * Sends a message read from a net's shared pipe to each connected peer of the
+ * net that is subscribed to it. The message is packed once, and the packed
+ * message sent to every peer; except that, as filters alter the message in
+ * place, peers with send filters are each sent a filtered copy afterward.
+ *
+ * @param Net The net whose pipe the message was read from.
+ * @param MsgPtr The message.
+ * @param Buf A buffer of at least SBN_MAX_PACKED_MSG_SZ bytes.
+ */
+static void SendToNetPeers(SBN_NetInterface_t *Net, CFE_MSG_Message_t *MsgPtr, uint8 *Buf)
+{
+    CFE_MSG_Size_t       MsgSz    = 0;
+    CFE_SB_MsgId_t       MsgID    = CFE_SB_INVALID_MSG_ID;
+    SBN_PeerMask_t       Peers    = 0, Filtered = 0;
+    SBN_PeerIdx_t        PeerIdx  = 0;
+    SBN_PeerInterface_t *Peer     = NULL;
+    bool                 Packed   = false;
+
+    if (CFE_MSG_GetSize(MsgPtr, &MsgSz) != CFE_SUCCESS || CFE_MSG_GetMsgId(MsgPtr, &MsgID) != CFE_SUCCESS)
+    {
+        return;
+    } /* end if */
+
+    Peers = SBN_GetNetSubPeers(Net, MsgID);
+
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        Peer = &Net->Peers[PeerIdx];
+
+        if (!(Peers & ((SBN_PeerMask_t)1 << PeerIdx)) || !Peer->Connected)
+        {
+            continue;
+        } /* end if */
+
+        if (HasSendFilter(Peer))
+        {
+            Filtered |= (SBN_PeerMask_t)1 << PeerIdx;
+            continue;
+        } /* end if */
+
+        if (!Packed)
+        {
+            SBN_PackMsg(Buf, MsgSz, SBN_APP_MSG, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), MsgPtr);
+            Packed = true;
+        } /* end if */
+
+        SendToPeer(SBN_APP_MSG, MsgSz, MsgPtr, Buf, Peer);
+    } /* end for */
+
+    for (PeerIdx = 0; Filtered && PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        Peer = &Net->Peers[PeerIdx];
+
+        if (!(Filtered & ((SBN_PeerMask_t)1 << PeerIdx)))
+        {
+            continue;
+        } /* end if */
+
+        memcpy(Buf, MsgPtr, MsgSz);
+        if (FilterSendToPeer(Peer, Buf) != SBN_SUCCESS)
+        {
+            /* one of the filters suggested rejecting this message */
+            continue;
+        } /* end if */
+
+        SendToPeer(SBN_APP_MSG, MsgSz, Buf, NULL, Peer);
+    } /* end for */
+} /* end SendToNetPeers */
+
 typedef struct
 {
     SBN_Status_t         Status;
@@ -587,7 +918,8 @@ void SBN_SendTask(void)
 {
     SendTaskData_t   D;
     SBN_Filter_Ctx_t Filter_Context;
-    CFE_MSG_Size_t   MsgSz = 0;
+    CFE_MSG_Size_t   MsgSz   = 0;
+    int64            EntryUs = 0, FilterUs = 0;
 
     Filter_Context.MyProcessorID  = CFE_PSP_GetProcessorId();
     Filter_Context.MySpacecraftID = CFE_PSP_GetSpacecraftId();
@@ -635,9 +967,15 @@ void SBN_SendTask(void)
             break;
         } /* end if */
 
+        EntryUs = SBN_PerfEntry(SBN_STAGE_SEND_TASK);
+        SBN_TRACE(SBN_TRACE_PIPE_DEQ, D.Peer->ProcessorID, D.MsgPtr);
+
         Filter_Context.PeerProcessorID  = D.Peer->ProcessorID;
         Filter_Context.PeerSpacecraftID = D.Peer->SpacecraftID;
 
+        FilterUs = SBN_PerfEntry(SBN_STAGE_FILTER);
+        SBN_TRACE(SBN_TRACE_FILTER_IN, D.Peer->ProcessorID, D.MsgPtr);
+
         for (FilterIdx = 0; FilterIdx < D.Peer->FilterCnt; FilterIdx++)
         {
             if (D.Peer->Filters[FilterIdx]->FilterSend == NULL)
@@ -657,19 +995,20 @@ void SBN_SendTask(void)
             } /* end if */
         }     /* end for */
 
-        if (FilterIdx < D.Peer->FilterCnt)
-        {
-            /* one of the above filters suggested rejecting this message */
-            continue;
-        } /* end if */
+        SBN_PerfExit(SBN_STAGE_FILTER, FilterUs);
+        SBN_TRACE(SBN_TRACE_FILTER_OUT, D.Peer->ProcessorID, D.MsgPtr);
 
-        if(CFE_MSG_GetSize(D.MsgPtr, &MsgSz) != CFE_SUCCESS)
+        /* one of the above filters suggested rejecting this message */
+        if (FilterIdx < D.Peer->FilterCnt || CFE_MSG_GetSize(D.MsgPtr, &MsgSz) != CFE_SUCCESS)
         {
+            SBN_PerfExit(SBN_STAGE_SEND_TASK, EntryUs);
             continue;
         } /* end if */
 
         D.Status = SBN_SendNetMsg(SBN_APP_MSG, MsgSz, D.MsgPtr, D.Peer);
 
+        SBN_PerfExit(SBN_STAGE_SEND_TASK, EntryUs);
+
         if (D.Status == SBN_ERROR)
         {
             break;
@@ -680,6 +1019,128 @@ void SBN_SendTask(void)
     D.Peer->SendTaskID = 0;
 } /* end SBN_SendTask() */
 
+typedef struct
+{
+    SBN_NetIdx_t        NetIdx;
+    OS_TaskID_t         SendTaskID;
+    CFE_MSG_Message_t  *MsgPtr;
+    SBN_NetInterface_t *Net;
+    int64               EntryUs;
+    uint8               Buf[SBN_MAX_PACKED_MSG_SZ];
+} NetSendTaskData_t;
+
+/**
+ * \brief For a net with a shared pipe and SBN_TASK_SEND, a task is created
+ * to listen to the net's pipe for messages to send to the net's peers.
+ */
+void SBN_NetSendTask(void)
+{
+    NetSendTaskData_t D;
+
+    memset(&D, 0, sizeof(D));
+
+    D.SendTaskID = OS_TaskGetId();
+
+    for (D.NetIdx = 0; D.NetIdx < SBN.NetCnt; D.NetIdx++)
+    {
+        D.Net = &SBN.Nets[D.NetIdx];
+        if (D.Net->SendTaskID == D.SendTaskID)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    if (D.NetIdx == SBN.NetCnt)
+    {
+        EVSSendErr(SBN_PEER_EID, "error connecting net send task");
+        return;
+    } /* end if */
+
+    while (CFE_SB_ReceiveBuffer((CFE_SB_Buffer_t **)&D.MsgPtr, D.Net->Pipe, CFE_SB_PEND_FOREVER) == CFE_SUCCESS)
+    {
+        D.EntryUs = SBN_PerfEntry(SBN_STAGE_SEND_TASK);
+        SBN_TRACE(SBN_TRACE_PIPE_DEQ, 0, D.MsgPtr);
+        SendToNetPeers(D.Net, D.MsgPtr, D.Buf);
+        SBN_PerfExit(SBN_STAGE_SEND_TASK, D.EntryUs);
+    } /* end while */
+
+    /* mark net as not having a task so that sending will create a new one */
+    D.Net->SendTaskID = 0;
+} /* end SBN_NetSendTask() */
+
+/**
+ * Polls a peer with its module's PollPeer, timed.
+ */
+static SBN_Status_t PollPeer(SBN_NetInterface_t *Net, SBN_PeerInterface_t *Peer)
+{
+    int64        EntryUs    = SBN_PerfEntry(SBN_STAGE_POLL_PEER);
+    SBN_Status_t SBN_Status = Net->IfOps->PollPeer(Peer);
+
+    SBN_PerfExit(SBN_STAGE_POLL_PEER, EntryUs);
+
+    return SBN_Status;
+} /* end PollPeer */
+
+/**
+ * Poll the peers of a net with a shared pipe and send them a message from
+ * the pipe, if there is one (or create the net's send task.)
+ *
+ * @param NetIdx The net.
+ * @return true if a message was read from the pipe.
+ */
+static bool CheckNetPipe(SBN_NetIdx_t NetIdx)
+{
+    static uint8        Buf[SBN_MAX_PACKED_MSG_SZ];
+    SBN_NetInterface_t *Net     = &SBN.Nets[NetIdx];
+    CFE_MSG_Message_t  *MsgPtr  = NULL;
+    SBN_PeerIdx_t       PeerIdx = 0;
+
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+        // Poll peer here to detect disconnections and to reconnect
+        if (PollPeer(Net, Peer) != SBN_SUCCESS)
+        {
+            EVSSendErrLimited(SBN_PEERTASK_EID, "failed to poll peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+        } /* end if */
+    }     /* end for */
+
+    if (Net->TaskFlags & SBN_TASK_SEND)
+    {
+        if (!Net->SendTaskID)
+        {
+            char SendTaskName[32];
+
+            snprintf(SendTaskName, 32, "sendT_%d", (int)NetIdx);
+            if (CFE_ES_CreateChildTask(&(Net->SendTaskID), SendTaskName, (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_NetSendTask,
+                                       NULL, CFE_PLATFORM_ES_DEFAULT_STACK_SIZE + 2 * sizeof(NetSendTaskData_t), 0,
+                                       0) != CFE_SUCCESS)
+            {
+                EVSSendErr(SBN_PEER_EID, "error creating send task for net %d", (int)NetIdx);
+            } /* end if */
+        }     /* end if */
+
+        return false;
+    } /* end if */
+
+    if (CFE_SB_ReceiveBuffer((CFE_SB_Buffer_t **)&MsgPtr, Net->Pipe, CFE_SB_POLL) != CFE_SUCCESS)
+    {
+        return false;
+    } /* end if */
+
+    if (++Net->PipeCnt > Net->PipeMax)
+    {
+        Net->PipeMax = Net->PipeCnt;
+    } /* end if */
+
+    SBN_TRACE(SBN_TRACE_PIPE_DEQ, 0, MsgPtr);
+
+    SendToNetPeers(Net, MsgPtr, Buf);
+
+    return true;
+} /* end CheckNetPipe */
+
 /**
  * Iterate through all peers, examining the pipe to see if there are messages
  * I need to send to that peer.
@@ -691,10 +1152,25 @@ static SBN_Status_t CheckPeerPipes(void)
     CFE_MSG_Message_t *MsgPtr = NULL;
     CFE_MSG_Size_t     MsgSz = 0;
     SBN_Filter_Ctx_t   Filter_Context;
+    SBN_Status_t       SBN_Status = SBN_SUCCESS;
+    int64              FilterUs   = 0;
 
     Filter_Context.MyProcessorID  = CFE_PSP_GetProcessorId();
     Filter_Context.MySpacecraftID = CFE_PSP_GetSpacecraftId();
 
+    SBN_NetIdx_t NetIdx = 0;
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_PeerIdx_t PeerIdx = 0;
+
+        SBN.Nets[NetIdx].PipeCnt = 0;
+
+        for (PeerIdx = 0; PeerIdx < SBN.Nets[NetIdx].PeerCnt; PeerIdx++)
+        {
+            SBN.Nets[NetIdx].Peers[PeerIdx].PipeCnt = 0;
+        } /* end for */
+    }     /* end for */
+
     /**
      * \note This processes one message per peer, then start again until no
      * peers have pending messages. At max only process SBN_MAX_MSG_PER_WAKEUP
@@ -704,11 +1180,20 @@ static SBN_Status_t CheckPeerPipes(void)
     {
         ReceivedFlag = 0;
 
-        SBN_NetIdx_t NetIdx = 0;
         for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
         {
             SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
 
+            if (Net->NetFlags & SBN_NET_SHARED_PIPE)
+            {
+                if (CheckNetPipe(NetIdx))
+                {
+                    ReceivedFlag = 1;
+                } /* end if */
+
+                continue;
+            } /* end if */
+
             SBN_PeerIdx_t PeerIdx = 0;
             for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
             {
@@ -716,17 +1201,17 @@ static SBN_Status_t CheckPeerPipes(void)
                 SBN_PeerInterface_t *Peer      = &Net->Peers[PeerIdx];
 
                 // Poll peer here to detect disconnections and to reconnect
-                if(Net->IfOps->PollPeer(Peer) != SBN_SUCCESS) {
-                  EVSSendErr(SBN_PEERTASK_EID, "failed to poll peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+                if(PollPeer(Net, Peer) != SBN_SUCCESS) {
+                  EVSSendErrLimited(SBN_PEERTASK_EID, "failed to poll peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
                 }
 
                 if (Peer->Connected == 0)
                 {
-                    EVSSendDbg(SBN_PEERTASK_EID, "not connected to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+                    EVSSendMsgDbg(SBN_PEERTASK_EID, "not connected to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
                     continue;
                 } /* end if */
 
-                EVSSendDbg(SBN_PEERTASK_EID, "SBN connected to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+                EVSSendMsgDbg(SBN_PEERTASK_EID, "SBN connected to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
 
                 if (Peer->TaskFlags & SBN_TASK_SEND)
                 {
@@ -757,14 +1242,22 @@ static SBN_Status_t CheckPeerPipes(void)
                 } /* end if */
 
                 ReceivedFlag = 1;
+                if (++Peer->PipeCnt > Peer->PipeMax)
+                {
+                    Peer->PipeMax = Peer->PipeCnt;
+                } /* end if */
+
+                SBN_TRACE(SBN_TRACE_PIPE_DEQ, Peer->ProcessorID, MsgPtr);
 
                 Filter_Context.PeerProcessorID  = Peer->ProcessorID;
                 Filter_Context.PeerSpacecraftID = Peer->SpacecraftID;
 
+                SBN_Status = SBN_SUCCESS;
+                FilterUs   = SBN_PerfEntry(SBN_STAGE_FILTER);
+                SBN_TRACE(SBN_TRACE_FILTER_IN, Peer->ProcessorID, MsgPtr);
+
                 for (FilterIdx = 0; FilterIdx < Peer->FilterCnt; FilterIdx++)
                 {
-                    SBN_Status_t SBN_Status;
-
                     if (Peer->Filters[FilterIdx]->FilterSend == NULL)
                     {
                         continue;
@@ -772,18 +1265,22 @@ static SBN_Status_t CheckPeerPipes(void)
 
                     SBN_Status = (Peer->Filters[FilterIdx]->FilterSend)(MsgPtr, &Filter_Context);
 
-                    if (SBN_Status == SBN_IF_EMPTY) /* filter requests not sending this msg, see below for loop */
-                    {
-                        break;
-                    } /* end if */
-
+                    /* includes SBN_IF_EMPTY, filter requests not sending this msg, see below for loop */
                     if (SBN_Status != SBN_SUCCESS)
                     {
-                        /* something fatal happened, exit */
-                        return SBN_Status;
+                        break;
                     } /* end if */
                 }     /* end for */
 
+                SBN_PerfExit(SBN_STAGE_FILTER, FilterUs);
+                SBN_TRACE(SBN_TRACE_FILTER_OUT, Peer->ProcessorID, MsgPtr);
+
+                if (SBN_Status != SBN_SUCCESS && SBN_Status != SBN_IF_EMPTY)
+                {
+                    /* something fatal happened, exit */
+                    return SBN_Status;
+                } /* end if */
+
                 if (FilterIdx < Peer->FilterCnt)
                 {
                     /* one of the above filters suggested rejecting this message */
@@ -818,7 +1315,30 @@ static SBN_Status_t PeerPoll(void)
     {
         SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
 
-        if (Net->IfOps->RecvFromNet && Net->TaskFlags & SBN_TASK_RECV)
+        if (Net->IfOps->RecvFromShard && Net->RecvShardCnt > 1 && Net->TaskFlags & SBN_TASK_RECV)
+        {
+            uint8 Shard = 0;
+            for (Shard = 0; Shard < Net->RecvShardCnt && Shard < SBN_MAX_RECV_SHARDS; Shard++)
+            {
+                if (!Net->ShardRecvTaskIDs[Shard])
+                {
+                    EVSSendInfo(SBN_PEER_EID, "Creating recv task for net %d shard %d", (int)NetIdx, (int)Shard);
+
+                    char RecvTaskName[32];
+                    snprintf(RecvTaskName, OS_MAX_API_NAME, "sbn_rs_%d_%d", (int)NetIdx, (int)Shard);
+                    CFE_Status = CFE_ES_CreateChildTask(
+                        &(Net->ShardRecvTaskIDs[Shard]), RecvTaskName, (CFE_ES_ChildTaskMainFuncPtr_t)&SBN_RecvShardTask,
+                        NULL, CFE_PLATFORM_ES_DEFAULT_STACK_SIZE + 2 * sizeof(RecvNetTaskData_t), 0, 0);
+
+                    if (CFE_Status != CFE_SUCCESS)
+                    {
+                        EVSSendErr(SBN_PEER_EID, "error creating task for net %d shard %d", (int)NetIdx, (int)Shard);
+                        return SBN_ERROR;
+                    } /* end if */
+                }     /* end if */
+            }         /* end for */
+        }
+        else if (Net->IfOps->RecvFromNet && Net->TaskFlags & SBN_TASK_RECV)
         {
             if (!Net->RecvTaskID)
             {
@@ -866,7 +1386,7 @@ static SBN_Status_t PeerPoll(void)
                 }
                 else
                 {
-                    Net->IfOps->PollPeer(Peer);
+                    PollPeer(Net, Peer);
                 } /* end if */
             }     /* end for */
         }         /* end if */
@@ -905,6 +1425,24 @@ static SBN_Status_t InitInterfaces(void)
 
         Net->IfOps->InitNet(Net);
 
+        if (Net->NetFlags & SBN_NET_SHARED_PIPE)
+        {
+            char PipeName[OS_MAX_API_NAME];
+
+            snprintf(PipeName, OS_MAX_API_NAME, "SBN_Net_%d_Pipe", (int)NetIdx);
+            if (CFE_SB_CreatePipe(&(Net->Pipe), SBN_NET_PIPE_DEPTH, PipeName) != CFE_SUCCESS
+                || CFE_SB_SetPipeOpts(Net->Pipe, CFE_SB_PIPEOPTS_IGNOREMINE) != CFE_SUCCESS)
+            {
+                EVSSendErr(SBN_PEER_EID, "could not create net pipe '%s'", PipeName);
+
+                return SBN_ERROR;
+            } /* end if */
+
+            Net->SubCnt = 0;
+
+            EVSSendInfo(SBN_PEER_EID, "Created net pipe '%s'", PipeName);
+        } /* end if */
+
         SBN_PeerIdx_t PeerIdx = 0;
         EVSSendInfo(SBN_PEER_EID, "Net %d has %d peers", NetIdx, Net->PeerCnt);
         for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
@@ -939,6 +1477,7 @@ static SBN_Status_t WaitForWakeup(int32 iTimeOut)
     CFE_Status_t       CFE_Status = CFE_SUCCESS;
     SBN_Status_t       SBN_Status = SBN_SUCCESS;
     CFE_MSG_Message_t *MsgPtr    = 0;
+    int64              WakeupUs  = 0, EntryUs = 0;
 
     /* Wait for WakeUp messages from scheduler */
     CFE_Status = CFE_SB_ReceiveBuffer((CFE_SB_Buffer_t **)&MsgPtr, SBN.CmdPipe, iTimeOut);
@@ -960,10 +1499,15 @@ static SBN_Status_t WaitForWakeup(int32 iTimeOut)
     ** cyclic processing at timeout rate
     */
     CFE_ES_PerfLogEntry(SBN_PERF_RECV_ID);
+    WakeupUs = SBN_LatNowUs();
 
+    EntryUs = SBN_PerfEntry(SBN_STAGE_NET_RECV);
     SBN_RecvNetMsgs();
+    SBN_PerfExit(SBN_STAGE_NET_RECV, EntryUs);
 
+    EntryUs    = SBN_PerfEntry(SBN_STAGE_SUB_PIPE);
     SBN_Status = SBN_CheckSubscriptionPipe();
+    SBN_PerfExit(SBN_STAGE_SUB_PIPE, EntryUs);
     switch(SBN_Status) {
       case SBN_IF_EMPTY:
         break;
@@ -975,10 +1519,19 @@ static SBN_Status_t WaitForWakeup(int32 iTimeOut)
         break;
     };
 
+    EntryUs = SBN_PerfEntry(SBN_STAGE_PEER_PIPES);
     CheckPeerPipes();
+    SBN_PerfExit(SBN_STAGE_PEER_PIPES, EntryUs);
 
     PeerPoll();
 
+    SBN_LatSyncPeers();
+
+    SBN_LatProbePoll();
+
+    SBN_FlushEVSLimits(false);
+
+    SBN_PerfWakeup(WakeupUs);
     CFE_ES_PerfLogExit(SBN_PERF_RECV_ID);
 
     return SBN_SUCCESS;
@@ -1072,7 +1625,7 @@ static SBN_Status_t LoadConf(void)
     SBN_ModuleIdx_t        ModuleIdx = 0;
     SBN_PeerIdx_t          PeerIdx   = 0;
     SBN_FilterInterface_t *Filters[SBN_MAX_MOD_CNT];
-    SBN_ProtocolOutlet_t   Outlet = {.PackMsg = SBN_PackMsg, .UnpackMsg = SBN_UnpackMsg, .Connected = SBN_Connected, .Disconnected = SBN_Disconnected, .SendNetMsg = SBN_SendNetMsg, .GetPeer = SBN_GetPeer};
+    SBN_ProtocolOutlet_t   Outlet = {.PackMsg = SBN_PackMsg, .UnpackMsg = SBN_UnpackMsg, .Connected = SBN_Connected, .Disconnected = SBN_Disconnected, .SendNetMsg = SBN_SendNetMsg, .GetPeer = SBN_GetPeer, .IsLocalSub = SBN_IsLocalSub, .MsgEvents = &SBN.MsgEvents, .PendEVSLimit = SBN_PendEVSLimit};
 
     memset(Filters, 0, sizeof(Filters));
 
@@ -1184,6 +1737,7 @@ static SBN_Status_t LoadConf(void)
                 LoadConf_Filters(TblPtr->FilterModules, TblPtr->FilterCnt, Filters, e->Filters, Net->Filters);
 
             Net->TaskFlags = e->TaskFlags;
+            Net->NetFlags  = e->NetFlags;
         }
         else
         {
@@ -1289,6 +1843,26 @@ static SBN_Status_t UnloadNets(void)
           Net->RecvTaskID = 0;
         }
 
+        uint8 Shard = 0;
+        for (Shard = 0; Shard < SBN_MAX_RECV_SHARDS; Shard++) {
+          if(Net->ShardRecvTaskIDs[Shard] != 0) {
+            if(CFE_ES_DeleteChildTask(Net->ShardRecvTaskIDs[Shard]) != CFE_SUCCESS) {
+              EVSSendCrit(SBN_TBL_EID, "unable to delete receive task %d shard %d", NetIdx, Shard);
+            }
+
+            Net->ShardRecvTaskIDs[Shard] = 0;
+          }
+        }
+        Net->RecvShardCnt = 0;
+
+        if(Net->SendTaskID != 0) {
+          if(CFE_ES_DeleteChildTask(Net->SendTaskID) != CFE_SUCCESS) {
+            EVSSendCrit(SBN_TBL_EID, "unable to delete send task %d", NetIdx);
+          }
+
+          Net->SendTaskID = 0;
+        }
+
         // UnloadNet assumes Peers are still valid
         if ((Status = Net->IfOps->UnloadNet(Net)) != SBN_SUCCESS)
         {
@@ -1310,6 +1884,16 @@ static SBN_Status_t UnloadNets(void)
 
         // Peers were cleared, reset the count
         Net->PeerCnt = 0;
+
+        if (Net->NetFlags & SBN_NET_SHARED_PIPE)
+        {
+          if(CFE_SB_DeletePipe(Net->Pipe) != CFE_SUCCESS) {
+            EVSSendCrit(SBN_TBL_EID, "unable to delete pipe for net %d", NetIdx);
+          }
+
+          Net->Pipe = 0;
+          Net->SubCnt = 0;
+        }
     }/* end for */
 
     SBN.NetCnt = 0;
@@ -1508,6 +2092,15 @@ void SBN_AppMain(void)
     strncpy(SBN.App_FullName, (const char *)TaskInfo.TaskName, OS_MAX_API_NAME - 1);
     SBN.App_FullName[OS_MAX_API_NAME - 1] = '\0';
 
+    /* peers tell a restart of mine by the epoch, so it differs from run to run */
+    OS_time_t Now;
+    OS_GetLocalTime(&Now);
+    SBN.SeqEpoch = (uint16)(OS_TimeGetTotalMilliseconds(Now) ^ CFE_PSP_GetProcessorId());
+    if (SBN.SeqEpoch == 0)
+    {
+        SBN.SeqEpoch = 1;
+    } /* end if */
+
     /** Create mutex for send tasks */
     Status = OS_MutSemCreate(&(SBN.SendMutex), "sbn_send_mutex", 0);
 
@@ -1525,6 +2118,22 @@ void SBN_AppMain(void)
         return;
     }
 
+    /** Create mutex for the nets' indexes of subscriptions **/
+    Status = OS_MutSemCreate(&(SBN.SubsMutex), "sbn_subs_mutex", 0);
+    if (Status != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "%s error creating mutex for subscriptions", FAIL_PREFIX);
+        return;
+    }
+
+    /** Create mutex for the call sites of rate-limited events with a count to send **/
+    Status = OS_MutSemCreate(&(SBN.EVSLimitMutex), "sbn_evs_mutex", 0);
+    if (Status != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_INIT_EID, "%s error creating mutex for rate-limited events", FAIL_PREFIX);
+        return;
+    }
+
     /* Create pipe for HK requests and gnd commands */
     /* TODO: make configurable depth */
     Status = CFE_SB_CreatePipe(&SBN.CmdPipe, 20, "SBNCmdPipe");
@@ -1583,6 +2192,81 @@ void SBN_AppMain(void)
     CFE_ES_ExitApp(RunStatus);
 } /* end SBN_AppMain */
 
+/**
+ * Checks the sequence header of an SBN_SEQ_APP_MSG from a peer against what
+ * has been received from it, and counts gaps, duplicates and late arrivals.
+ *
+ * @param Peer[in/out] The peer the message is from.
+ * @param MsgSize[in] The size of the payload.
+ * @param Msg[in] The payload.
+ *
+ * @return SBN_SUCCESS if the app message (after SBN_SEQ_HDR_SZ) should be
+ *         delivered, SBN_IF_EMPTY if it is a duplicate, SBN_ERROR if the
+ *         payload is too short.
+ */
+static SBN_Status_t CheckSeq(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSize, void *Msg)
+{
+    uint16 Epoch = 0, Seq = 0;
+    int32  Ahead = 0;
+    uint32 Bit   = 0;
+    Pack_t Pack;
+
+    if (MsgSize < SBN_SEQ_HDR_SZ)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    Pack_Init(&Pack, Msg, MsgSize, false);
+    Unpack_UInt16(&Pack, &Epoch);
+    Unpack_UInt16(&Pack, &Seq);
+
+    Ahead = (int16)(uint16)(Seq - Peer->RecvSeqNext);
+
+    /* a new sender run; start over from this one */
+    if (!Peer->RecvSeqValid || Epoch != Peer->RecvSeqEpoch)
+    {
+        Peer->RecvSeqValid = true;
+        Peer->RecvSeqEpoch = Epoch;
+        Peer->RecvSeqNext  = Seq + 1;
+        Peer->RecvSeqMask  = 1;
+        return SBN_SUCCESS;
+    } /* end if */
+
+    if (Ahead >= 0)
+    {
+        /* saturates rather than wrapping back to a small count */
+        Peer->RecvGapCnt = (uint32)Peer->RecvGapCnt + Ahead > 0xFFFF ? 0xFFFF : Peer->RecvGapCnt + Ahead;
+        Peer->RecvSeqMask = Ahead + 1 < SBN_SEQ_WINDOW ? (Peer->RecvSeqMask << (Ahead + 1)) | 1 : 1;
+        Peer->RecvSeqNext = Seq + 1;
+        return SBN_SUCCESS;
+    } /* end if */
+
+    /* too old to tell whether it is a duplicate, so it is delivered */
+    if (Ahead < -SBN_SEQ_WINDOW)
+    {
+        Peer->RecvReorderCnt++;
+        return SBN_SUCCESS;
+    } /* end if */
+
+    Bit = (uint32)1 << (-Ahead - 1);
+
+    if (Peer->RecvSeqMask & Bit)
+    {
+        Peer->RecvDupCnt++;
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    /* counted as a gap when a later one arrived */
+    Peer->RecvSeqMask |= Bit;
+    Peer->RecvReorderCnt++;
+    if (Peer->RecvGapCnt > 0)
+    {
+        Peer->RecvGapCnt--;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end CheckSeq */
+
 /**
  * Sends a message to a peer.
  * @param[in] MsgType The type of the message (application data, SBN protocol)
@@ -1603,13 +2287,20 @@ SBN_Status_t SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, C
 
     if (!Peer)
     {
-        EVSSendErr(SBN_PEERTASK_EID, "%s unknown peer (ProcessorID=%d)", FAIL_PREFIX, (int)ProcessorID);
+        EVSSendErrLimited(SBN_PEERTASK_EID, "%s unknown peer (ProcessorID=%d)", FAIL_PREFIX, (int)ProcessorID);
+        SBN_CNT_ADD(Net->Cnts.RecvErrCnt, 1);
         return SBN_ERROR;
     } /* end if */
 
+    Peer->RecvCnt++;
+    SBN_CNT_ADD(Peer->Cnts.RecvCnt, 1);
+    SBN_CNT_ADD(Peer->Cnts.RecvBytes, MsgSize);
+    SBN_CNT_ADD(Net->Cnts.RecvCnt, 1);
+    SBN_CNT_ADD(Net->Cnts.RecvBytes, MsgSize);
+
     /* Check if message is protocol-specific (unkown to SBN core) */
     if(MsgType & SBN_MODULE_SPECIFIC_MESSAGE_ID_MASK) {
-      EVSSendDbg(SBN_PEERTASK_EID, "SBN received module-specific message type: 0x%08x", MsgType);
+      EVSSendMsgDbg(SBN_PEERTASK_EID, "SBN received module-specific message type: 0x%08x", MsgType);
       return SBN_SUCCESS;
     }
 
@@ -1633,16 +2324,56 @@ SBN_Status_t SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, C
             } /* end if */
             break;
         } /* end case */
+        case SBN_SEQ_APP_MSG:
+        case SBN_SEQ_STAMP_APP_MSG:
+        case SBN_STAMP_APP_MSG:
+        {
+            if (MsgType != SBN_STAMP_APP_MSG)
+            {
+                SBN_Status = CheckSeq(Peer, MsgSize, Msg);
+
+                if (SBN_Status == SBN_IF_EMPTY)
+                {
+                    EVSSendMsgDbg(SBN_SB_EID, "duplicate message from peer %d:%d, dropped", (int)Peer->SpacecraftID,
+                                  (int)Peer->ProcessorID);
+                    return SBN_SUCCESS;
+                } /* end if */
+
+                if (SBN_Status != SBN_SUCCESS)
+                {
+                    EVSSendErrLimited(SBN_SB_EID, "%s short sequenced message (MsgSize=%d)", FAIL_PREFIX, (int)MsgSize);
+                    return SBN_ERROR;
+                } /* end if */
+
+                Msg = (uint8 *)Msg + SBN_SEQ_HDR_SZ;
+                MsgSize -= SBN_SEQ_HDR_SZ;
+            } /* end if */
+
+            if (MsgType != SBN_SEQ_APP_MSG && SBN_LatRecvStamp(Peer, &MsgSize, &Msg) != SBN_SUCCESS)
+            {
+                EVSSendErrLimited(SBN_SB_EID, "%s short stamped message (MsgSize=%d)", FAIL_PREFIX, (int)MsgSize);
+                return SBN_ERROR;
+            } /* end if */
+        } /* end case */
+        /* fall through */
         case SBN_APP_MSG:
         {
             SBN_ModuleIdx_t  FilterIdx = 0;
             SBN_Filter_Ctx_t Filter_Context;
+            int64            FilterUs  = 0;
 
             Filter_Context.MyProcessorID    = CFE_PSP_GetProcessorId();
             Filter_Context.MySpacecraftID   = CFE_PSP_GetSpacecraftId();
             Filter_Context.PeerProcessorID  = Peer->ProcessorID;
             Filter_Context.PeerSpacecraftID = Peer->SpacecraftID;
 
+            /* counted as received, before filters that may drop or remap it */
+            SBN_MidStatMsg(&Peer->RecvMids, Msg, MsgSize);
+
+            SBN_Status = SBN_SUCCESS;
+            FilterUs   = SBN_PerfEntry(SBN_STAGE_FILTER);
+            SBN_TRACE(SBN_TRACE_FILTER_IN, Peer->ProcessorID, Msg);
+
             for (FilterIdx = 0; FilterIdx < Peer->FilterCnt; FilterIdx++)
             {
                 if (Peer->Filters[FilterIdx]->FilterRecv == NULL)
@@ -1652,22 +2383,67 @@ SBN_Status_t SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, C
 
                 SBN_Status = (Peer->Filters[FilterIdx]->FilterRecv)(Msg, &Filter_Context);
 
-                /* includes SBN_IF_EMPTY, for when filter recommends removing */
                 if (SBN_Status != SBN_SUCCESS)
                 {
-                    return SBN_Status;
+                    break;
                 } /* end if */
             }     /* end for */
 
+            SBN_PerfExit(SBN_STAGE_FILTER, FilterUs);
+            SBN_TRACE(SBN_TRACE_FILTER_OUT, Peer->ProcessorID, Msg);
+
+            /* includes SBN_IF_EMPTY, for when filter recommends removing */
+            if (SBN_Status != SBN_SUCCESS)
+            {
+                return SBN_Status;
+            } /* end if */
+
+            SBN_TRACE(SBN_TRACE_SB_XMIT, Peer->ProcessorID, Msg);
+
             CFE_Status = CFE_SB_TransmitMsg(Msg, false);
 
             if (CFE_Status != CFE_SUCCESS)
             {
-                EVSSendErr(SBN_SB_EID, "%s CFE_SB_PassMsg error (Status=%d MsgType=0x%x)", FAIL_PREFIX, (int)CFE_Status, MsgType);
+                EVSSendErrLimited(SBN_SB_EID, "%s CFE_SB_PassMsg error (Status=%d MsgType=0x%x)", FAIL_PREFIX, (int)CFE_Status, MsgType);
                 return SBN_ERROR;
             } /* end if */
             break;
         } /* end case */
+        case SBN_TIME_MSG:
+            if (SBN_LatRecvSync(Peer, MsgSize, Msg) != SBN_SUCCESS)
+            {
+                EVSSendErrLimited(SBN_SB_EID, "%s short time message (MsgSize=%d)", FAIL_PREFIX, (int)MsgSize);
+                return SBN_ERROR;
+            } /* end if */
+            break;
+
+        case SBN_PROBE_MSG:
+            /* echoed unchanged and at once, locked as this may be a receive
+             * task; a lost echo is the prober's to count
+             */
+            if (OS_MutSemTake(SBN.SendMutex) != OS_SUCCESS)
+            {
+                EVSSendErr(SBN_PEER_EID, "unable to take send mutex");
+                return SBN_ERROR;
+            } /* end if */
+
+            SBN_SendNetMsg(SBN_PROBE_ECHO_MSG, MsgSize, Msg, Peer);
+
+            if (OS_MutSemGive(SBN.SendMutex) != OS_SUCCESS)
+            {
+                EVSSendErr(SBN_PEER_EID, "unable to give send mutex");
+                return SBN_ERROR;
+            } /* end if */
+            break;
+
+        case SBN_PROBE_ECHO_MSG:
+            if (SBN_LatRecvProbeEcho(Peer, MsgSize, Msg) != SBN_SUCCESS)
+            {
+                EVSSendErrLimited(SBN_SB_EID, "%s short probe echo (MsgSize=%d)", FAIL_PREFIX, (int)MsgSize);
+                return SBN_ERROR;
+            } /* end if */
+            break;
+
         case SBN_SUB_MSG:
             return SBN_ProcessSubsFromPeer(Peer, Msg);
 
@@ -1678,7 +2454,7 @@ SBN_Status_t SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t MsgType, C
             return SBN_SUCCESS;
         default:
             /* Should I generate an event? Probably... */
-            EVSSendErr(SBN_PEERTASK_EID, "%s unknown message type 0x%08x", FAIL_PREFIX, MsgType);
+            EVSSendErrLimited(SBN_PEERTASK_EID, "%s unknown message type 0x%08x", FAIL_PREFIX, MsgType);
             return SBN_ERROR;
     } /* end switch */
 
@@ -1707,6 +2483,80 @@ SBN_PeerInterface_t *SBN_GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t Proc
     return NULL;
 } /* end SBN_GetPeer */
 
+/**
+ * Takes a call site of a rate-limited event (EVSSendLimited) that has begun
+ * to suppress it, for SBN_FlushEVSLimits() to send the count. A site already
+ * held is not taken twice; past SBN_EVS_LIMIT_SITES, the site's count waits
+ * for its next event.
+ *
+ * @param Limit[in] The call site's state.
+ */
+void SBN_PendEVSLimit(SBN_EVSLimit_t *Limit)
+{
+    uint8 i = 0;
+
+    OS_MutSemTake(SBN.EVSLimitMutex);
+
+    for (i = 0; i < SBN.EVSLimitCnt; i++)
+    {
+        if (SBN.EVSLimits[i] == Limit)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    if (i == SBN.EVSLimitCnt && SBN.EVSLimitCnt < SBN_EVS_LIMIT_SITES)
+    {
+        SBN.EVSLimits[SBN.EVSLimitCnt++] = Limit;
+    } /* end if */
+
+    OS_MutSemGive(SBN.EVSLimitMutex);
+} /* end SBN_PendEVSLimit() */
+
+/**
+ * Sends the count of each held call site whose window is over, as the site's
+ * next event would have, and lets the site go; a site whose count its next
+ * event has sent already is let go too.
+ *
+ * @param All[in] Send the counts whether or not the windows are over, and let
+ *            all sites go (before the modules they are in are unloaded.)
+ */
+void SBN_FlushEVSLimits(bool All)
+{
+    OS_time_t Now  = {0};
+    uint32    Secs = 0;
+    uint8     i    = 0;
+
+    OS_GetLocalTime(&Now);
+    Secs = (uint32)OS_TimeGetTotalSeconds(Now);
+
+    OS_MutSemTake(SBN.EVSLimitMutex);
+
+    while (i < SBN.EVSLimitCnt)
+    {
+        SBN_EVSLimit_t *Limit = SBN.EVSLimits[i];
+
+        if (Limit->Suppressed && !All && Secs - Limit->WindowSecs < SBN_EVS_LIMIT_SECS)
+        {
+            i++;
+            continue;
+        } /* end if */
+
+        if (Limit->Suppressed)
+        {
+            CFE_EVS_SendEvent(Limit->EID, Limit->Type, "suppressed %lu like the last",
+                              (unsigned long)Limit->Suppressed);
+            Limit->WindowSecs = Secs;
+            Limit->Cnt        = 0;
+            Limit->Suppressed = 0;
+        } /* end if */
+
+        SBN.EVSLimits[i] = SBN.EVSLimits[--SBN.EVSLimitCnt];
+    } /* end while */
+
+    OS_MutSemGive(SBN.EVSLimitMutex);
+} /* end SBN_FlushEVSLimits() */
+
 
 /** \brief Reload configuration and re-initialize
  * This is only called after receiving a message from TBL service.
@@ -34,6 +34,12 @@
 #include "sbn_platform_cfg.h"
 #include "sbn_tbl.h"
 #include "cfe_sb_msg.h"
+
+/* the core's per-message debug events follow SBN_MSG_EVENTS_CC */
+#undef SBN_MSG_EVENTS_ON
+#define SBN_MSG_EVENTS_ON (SBN.MsgEvents)
+#undef SBN_EVS_LIMIT_PEND
+#define SBN_EVS_LIMIT_PEND(Limit) SBN_PendEVSLimit(Limit)
 #include "cfe_sb.h"
 #include "sbn_msgids.h"
 #include "sbn_cmds.h"
@@ -62,6 +68,70 @@ SBN_Status_t SBN_RecvNetMsgs(void);
 
 void SBN_CheckPeerPipes(void);
 
+/** @brief A message ID whose latency is kept, see SBN_LAT_MID_CC. */
+typedef struct
+{
+    bool           InUse;
+    CFE_SB_MsgId_t MsgID;
+    SBN_LatHist_t  Hist;
+} SBN_LatMid_t;
+
+/** @brief The states of a slot of SBN.MidStatMids: never used, in use, and no longer (probed past.) */
+typedef enum
+{
+    SBN_MIDSTAT_FREE = 0,
+    SBN_MIDSTAT_USED,
+    SBN_MIDSTAT_REMOVED
+} SBN_MidStatState_t;
+
+/** @brief A message ID counted exactly, see SBN_MIDSTAT_MID_CC. */
+typedef struct
+{
+    uint8          State;
+    CFE_SB_MsgId_t MsgID;
+} SBN_MidStatMid_t;
+
+/** @brief A run of probes to a peer, see SBN_PROBE_CC. */
+typedef struct
+{
+    bool Active;
+
+    SBN_PeerInterface_t *Peer;
+    SBN_NetIdx_t         NetIdx;
+    SBN_PeerIdx_t        PeerIdx;
+
+    /** @brief Tells this run's echoes from an earlier run's. */
+    uint16 Id;
+
+    /** @brief Probes to send, sent, and echoed (each with its round trip.) */
+    uint8  Cnt, SentCnt, RecvCnt;
+    uint32 RttUs[SBN_PROBE_MAX_CNT];
+
+    /** @brief Whether the last probe sent awaits its echo, and when it was sent. */
+    bool  Waiting;
+    int64 SentUs;
+} SBN_LatProbe_t;
+
+/** @brief A point traced: when a message reached it, from or to which peer. */
+typedef struct
+{
+    int64             TimeUs;
+    CFE_ProcessorID_t ProcessorID;
+    CFE_SB_MsgId_t    MsgID;
+    uint8             Point;
+} SBN_TraceEntry_t;
+
+/** @brief The trace ring, see SBN_TRACE_CC. */
+typedef struct
+{
+    bool On;
+
+    /** @brief Points traced since the ring was cleared; the next goes at Next % SBN_TRACE_DEPTH. */
+    uint32 Next;
+
+    SBN_TraceEntry_t Entries[SBN_TRACE_DEPTH];
+} SBN_Trace_t;
+
 /**
  * \brief SBN global data structure definition
  */
@@ -125,8 +195,40 @@ typedef struct
     /** Global mutex for reconfiguring. */
     CFE_ES_MutexID_t ConfMutex;
 
+    /** Global mutex for the local subscriptions and the nets' indexes of subscriptions (shared pipes.) */
+    CFE_ES_MutexID_t SubsMutex;
+
     SBN_HKTlm_t CmdCnt, CmdErrCnt;
 
+    /** @brief This run's Epoch for SBN_SEQ_APP_MSG, never 0. */
+    uint16 SeqEpoch;
+
+    /** @brief Latency of stamped app messages with these IDs, from any peer. */
+    SBN_LatMid_t LatMids[SBN_LAT_MAX_MIDS];
+
+    SBN_LatProbe_t Probe;
+
+    /** @brief Time spent in each stage, and in each wakeup (see SBN_HK_PERF_CC.) */
+    SBN_StageStats_t Stages[SBN_STAGE_CNT];
+    SBN_StageStats_t Wakeups;
+    uint32           WakeupOverrunCnt;
+
+    /** @brief Whether per-message debug events are sent (SBN_MSG_EVENTS_CC.) */
+    bool MsgEvents;
+
+    /** @brief Call sites of rate-limited events with a count to send, see SBN_PendEVSLimit(). */
+    SBN_EVSLimit_t * EVSLimits[SBN_EVS_LIMIT_SITES];
+    uint8            EVSLimitCnt;
+    CFE_ES_MutexID_t EVSLimitMutex;
+
+    SBN_Trace_t Trace;
+
+    /**
+     * @brief The message IDs counted exactly in each peer's SendMids and
+     * RecvMids, in the slot they hash to or the next free after it.
+     */
+    SBN_MidStatMid_t MidStatMids[SBN_MIDSTAT_MIDS];
+
     CFE_TBL_Handle_t ConfTblHandle;
 
     /* Buffer for receiving messages, allocated here to avoid stack smashing */
@@ -146,9 +248,13 @@ SBN_Status_t         SBN_ProcessNetMsg(SBN_NetInterface_t *Net, SBN_MsgType_t Ms
                                        SBN_MsgSz_t MsgSz, void *Msg);
 SBN_PeerInterface_t *SBN_GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t ProcessorID, CFE_SpacecraftID_t SpacecraftID);
 SBN_Status_t         SBN_ReloadConfTbl(void);
+void                 SBN_PendEVSLimit(SBN_EVSLimit_t *Limit);
+void                 SBN_FlushEVSLimits(bool All);
 void                 SBN_RecvNetTask(void);
 void                 SBN_RecvPeerTask(void);
 void                 SBN_SendTask(void);
+void                 SBN_NetSendTask(void);
+void                 SBN_RecvShardTask(void);
 SBN_Status_t         SBN_Connected(SBN_PeerInterface_t *Peer);
 SBN_Status_t         SBN_Disconnected(SBN_PeerInterface_t *Peer);
 void                 SBN_PackMsg(void *SBNBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_ProcessorID_t ProcessorID, CFE_SpacecraftID_t SpacecraftID, void *Msg);
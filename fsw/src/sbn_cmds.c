@@ -4,6 +4,9 @@
 
 #include "sbn_app.h"
 #include "sbn_pack.h"
+#include "sbn_lat.h"
+#include "sbn_trace.h"
+#include "sbn_midstat.h"
 
 /**
  * @brief Initializes the housekeeping counters for a peer.
@@ -18,6 +21,21 @@ static void InitializePeerCounters(SBN_PeerInterface_t *Peer)
     Peer->RecvCnt    = 0;
     Peer->SendErrCnt = 0;
     Peer->RecvErrCnt = 0;
+
+    Peer->RecvGapCnt     = 0;
+    Peer->RecvDupCnt     = 0;
+    Peer->RecvReorderCnt = 0;
+
+    memset(&Peer->LatHist, 0, sizeof(Peer->LatHist));
+
+    memset(&Peer->Cnts, 0, sizeof(Peer->Cnts));
+    memset(&Peer->HKCnts, 0, sizeof(Peer->HKCnts));
+    Peer->HKUs = 0;
+
+    Peer->PipeMax = 0;
+
+    memset(&Peer->SendMids, 0, sizeof(Peer->SendMids));
+    memset(&Peer->RecvMids, 0, sizeof(Peer->RecvMids));
 } /* end InitializePeerCounters() */
 
 /**
@@ -29,11 +47,27 @@ void SBN_InitializeCounters(void)
     SBN.CmdCnt    = 0;
     SBN.CmdErrCnt = 0;
 
+    int i = 0;
+    for (i = 0; i < SBN_LAT_MAX_MIDS; i++)
+    {
+        memset(&SBN.LatMids[i].Hist, 0, sizeof(SBN.LatMids[i].Hist));
+    } /* end for */
+
+    memset(SBN.Stages, 0, sizeof(SBN.Stages));
+    memset(&SBN.Wakeups, 0, sizeof(SBN.Wakeups));
+    SBN.WakeupOverrunCnt = 0;
+
     int NetIdx = 0;
     for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
     {
         SBN_NetInterface_t *Net     = &SBN.Nets[NetIdx];
         int                 PeerIdx = 0;
+
+        memset(&Net->Cnts, 0, sizeof(Net->Cnts));
+        memset(&Net->HKCnts, 0, sizeof(Net->HKCnts));
+        Net->HKUs    = 0;
+        Net->PipeMax = 0;
+
         for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
         {
             SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
@@ -292,7 +326,7 @@ static void HKNetCmd(CFE_MSG_Message_t *MsgPtr)
     uint8 *Ptr    = (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t);
     uint8  NetIdx = *Ptr;
 
-    if (NetIdx > SBN.NetCnt)
+    if (NetIdx >= SBN.NetCnt)
     {
         EVSSendErr(SBN_CMD_EID, "Invalid NetIdx (%d, max is %d)", NetIdx, SBN.NetCnt - 1);
         return;
@@ -341,13 +375,13 @@ static void HKPeerCmd(CFE_MSG_Message_t *MsgPtr)
     uint8  NetIdx  = *Ptr++;
     uint8  PeerIdx = *Ptr;
 
-    if (NetIdx > SBN.NetCnt)
+    if (NetIdx >= SBN.NetCnt)
     {
         EVSSendErr(SBN_CMD_EID, "Invalid NetIdx (%d, max is %d)", NetIdx, SBN.NetCnt - 1);
         return;
     } /* end if */
 
-    if (PeerIdx > SBN.Nets[NetIdx].PeerCnt)
+    if (PeerIdx >= SBN.Nets[NetIdx].PeerCnt)
     {
         EVSSendErr(SBN_CMD_EID, "Invalid PeerIdx (NetIdx=%d PeerIdx=%d, max is %d)", NetIdx, PeerIdx,
                    SBN.Nets[NetIdx].PeerCnt - 1);
@@ -375,6 +409,9 @@ static void HKPeerCmd(CFE_MSG_Message_t *MsgPtr)
     Pack_UInt16(&Pack, Peer->SendErrCnt);
     Pack_UInt16(&Pack, Peer->RecvErrCnt);
     Pack_UInt16(&Pack, Peer->SubCnt);
+    Pack_UInt16(&Pack, Peer->RecvGapCnt);
+    Pack_UInt16(&Pack, Peer->RecvDupCnt);
+    Pack_UInt16(&Pack, Peer->RecvReorderCnt);
 
     /*
     ** Timestamp and send packet
@@ -383,6 +420,828 @@ static void HKPeerCmd(CFE_MSG_Message_t *MsgPtr)
     CFE_SB_TransmitMsg(HKMsg, true);
 } /* end HKPeerCmd */
 
+/** @brief What SBN_HK_ALLPEERS_CC reports of a peer, copied from it. */
+typedef struct
+{
+    CFE_ProcessorID_t ProcessorID;
+    uint8             Flags;
+    SBN_HKTlm_t       SubCnt, SendErrCnt, RecvErrCnt, RecvGapCnt, PipeCnt, PipeMax;
+    uint64            SendCnt, RecvCnt;
+    uint32            LastRecvAgeMs;
+} PeerSnap_t;
+
+/** \brief Request for housekeeping for all peers of all networks.
+ *
+ *  \par Description
+ *       Reports, in one packet, each net's shared pipe and each of its
+ *       peers' connection state, counters, pipe use and the time since a
+ *       message was last received from it, rather than a #SBN_HK_PEER_CC
+ *       for each peer.
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       This message does not affect the command execution counter. The
+ *       peers are copied first without taking the send mutex, so the tasks
+ *       are not held up; each counter is read whole, but one may be a
+ *       message ahead of another. The packet is sized to the nets and peers
+ *       loaded.
+ *       The largest number of messages taken from a pipe in one wakeup is
+ *       since the last such report.
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_HK_ALLPEERS_CC
+ */
+static void HKAllPeersCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, sizeof(CFE_MSG_CommandHeader_t), "hk all peers"))
+    {
+        return;
+    } /* end if */
+
+    EVSSendInfo(SBN_CMD_EID, "hk all peers command");
+
+    /* static, as they are large and only the command pipe uses them */
+    static PeerSnap_t Snaps[SBN_MAX_NETS][SBN_MAX_PEER_CNT];
+    static uint8      HKBuf[SBN_HKALL_MAX_LEN];
+
+    SBN_HKTlm_t        NetPipeCnts[SBN_MAX_NETS], NetPipeMaxes[SBN_MAX_NETS];
+    CFE_MSG_Message_t *HKMsg   = (CFE_MSG_Message_t *)HKBuf;
+    Pack_t             Pack;
+    int64              NowUs   = SBN_LatNowUs(), RecvUs = 0;
+    CFE_MSG_Size_t     HKLen   = sizeof(CFE_MSG_TelemetryHeader_t) + sizeof(uint8) * 2;
+    SBN_NetIdx_t       NetIdx  = 0;
+    SBN_PeerIdx_t      PeerIdx = 0;
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        NetPipeCnts[NetIdx]  = Net->PipeCnt;
+        NetPipeMaxes[NetIdx] = Net->PipeMax;
+        Net->PipeMax         = 0;
+
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+        {
+            SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+            PeerSnap_t          *Snap = &Snaps[NetIdx][PeerIdx];
+
+            Snap->ProcessorID = Peer->ProcessorID;
+            Snap->Flags       = (Peer->Connected ? SBN_HKALL_CONNECTED : 0) |
+                                (Peer->SendTaskID || Net->SendTaskID ? SBN_HKALL_SEND_TASK : 0) |
+                                (Peer->RecvTaskID || Net->RecvTaskID ? SBN_HKALL_RECV_TASK : 0) |
+                                (Peer->LatSync.Valid ? SBN_HKALL_SYNCED : 0);
+            Snap->SubCnt      = Peer->SubCnt;
+            Snap->SendCnt     = SBN_CNT_GET(Peer->Cnts.SendCnt);
+            Snap->RecvCnt     = SBN_CNT_GET(Peer->Cnts.RecvCnt);
+            Snap->SendErrCnt  = Peer->SendErrCnt;
+            Snap->RecvErrCnt  = Peer->RecvErrCnt;
+            Snap->RecvGapCnt  = Peer->RecvGapCnt;
+            Snap->PipeCnt     = Peer->PipeCnt;
+            Snap->PipeMax     = Peer->PipeMax;
+            Peer->PipeMax     = 0;
+
+            /* never received from, or longer ago than a uint32 of milliseconds holds */
+            RecvUs              = OS_TimeGetTotalMicroseconds(Peer->LastRecv);
+            Snap->LastRecvAgeMs = 0xFFFFFFFF;
+            if (RecvUs && NowUs >= RecvUs && (NowUs - RecvUs) / 1000 < 0xFFFFFFFF)
+            {
+                Snap->LastRecvAgeMs = (uint32)((NowUs - RecvUs) / 1000);
+            } /* end if */
+        } /* end for */
+
+        HKLen += SBN_HKALL_NET_LEN + Net->PeerCnt * SBN_HKALL_PEER_LEN;
+    } /* end for */
+
+    CFE_MSG_Init(HKMsg, CFE_SB_ValueToMsgId(SBN_TLM_MID), HKLen);
+
+    Pack_Init(&Pack, HKBuf + sizeof(CFE_MSG_TelemetryHeader_t), HKLen - sizeof(CFE_MSG_TelemetryHeader_t), 1);
+
+    Pack_UInt8(&Pack, SBN_HK_ALLPEERS_CC);
+    Pack_UInt8(&Pack, SBN.NetCnt);
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        Pack_UInt8(&Pack, NetIdx);
+        Pack_UInt8(&Pack, SBN.Nets[NetIdx].PeerCnt);
+        Pack_UInt16(&Pack, NetPipeCnts[NetIdx]);
+        Pack_UInt16(&Pack, NetPipeMaxes[NetIdx]);
+
+        for (PeerIdx = 0; PeerIdx < SBN.Nets[NetIdx].PeerCnt; PeerIdx++)
+        {
+            PeerSnap_t *Snap = &Snaps[NetIdx][PeerIdx];
+
+            Pack_UInt32(&Pack, Snap->ProcessorID);
+            Pack_UInt8(&Pack, Snap->Flags);
+            Pack_UInt16(&Pack, Snap->SubCnt);
+            Pack_UInt64(&Pack, Snap->SendCnt);
+            Pack_UInt64(&Pack, Snap->RecvCnt);
+            Pack_UInt16(&Pack, Snap->SendErrCnt);
+            Pack_UInt16(&Pack, Snap->RecvErrCnt);
+            Pack_UInt16(&Pack, Snap->RecvGapCnt);
+            Pack_UInt16(&Pack, Snap->PipeCnt);
+            Pack_UInt16(&Pack, Snap->PipeMax);
+            Pack_UInt32(&Pack, Snap->LastRecvAgeMs);
+        } /* end for */
+    }     /* end for */
+
+    /*
+    ** Timestamp and send packet
+    */
+    CFE_SB_TimeStampMsg(HKMsg);
+    CFE_SB_TransmitMsg(HKMsg, true);
+} /* end HKAllPeersCmd */
+
+/** @brief A count per second over an interval, 0 if there is none. */
+static uint32 Rate(uint64 Cnt, int64 IntervalUs)
+{
+    uint64 PerSec = 0;
+
+    if (IntervalUs <= 0)
+    {
+        return 0;
+    } /* end if */
+
+    /* in two parts, so a large count times 1000000 doesn't overflow */
+    PerSec = Cnt / IntervalUs * 1000000 + Cnt % IntervalUs * 1000000 / IntervalUs;
+
+    return PerSec > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32)PerSec;
+} /* end Rate() */
+
+/**
+ * Packs a peer's or net's counters, the time since they were last reported
+ * and their rates over it, and keeps them for the next report.
+ */
+static void PackCnts(Pack_t *Pack, SBN_Cnts_t *Cnts, SBN_Cnts_t *HKCnts, int64 *HKUs, int64 NowUs)
+{
+    SBN_Cnts_t C;
+    int64      IntervalUs = *HKUs ? NowUs - *HKUs : 0;
+
+    C.SendCnt    = SBN_CNT_GET(Cnts->SendCnt);
+    C.SendBytes  = SBN_CNT_GET(Cnts->SendBytes);
+    C.SendErrCnt = SBN_CNT_GET(Cnts->SendErrCnt);
+    C.RecvCnt    = SBN_CNT_GET(Cnts->RecvCnt);
+    C.RecvBytes  = SBN_CNT_GET(Cnts->RecvBytes);
+    C.RecvErrCnt = SBN_CNT_GET(Cnts->RecvErrCnt);
+
+    Pack_UInt32(Pack, IntervalUs / 1000 > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32)(IntervalUs / 1000));
+    Pack_UInt64(Pack, C.SendCnt);
+    Pack_UInt64(Pack, C.SendBytes);
+    Pack_UInt64(Pack, C.SendErrCnt);
+    Pack_UInt64(Pack, C.RecvCnt);
+    Pack_UInt64(Pack, C.RecvBytes);
+    Pack_UInt64(Pack, C.RecvErrCnt);
+    Pack_UInt32(Pack, Rate(C.SendCnt - HKCnts->SendCnt, IntervalUs));
+    Pack_UInt32(Pack, Rate(C.SendBytes - HKCnts->SendBytes, IntervalUs));
+    Pack_UInt32(Pack, Rate(C.RecvCnt - HKCnts->RecvCnt, IntervalUs));
+    Pack_UInt32(Pack, Rate(C.RecvBytes - HKCnts->RecvBytes, IntervalUs));
+
+    *HKCnts = C;
+    *HKUs   = NowUs;
+} /* end PackCnts() */
+
+/** \brief Request for the 64-bit counters of a peer and its net.
+ *
+ *  \par Description
+ *       Reports the messages and bytes sent to and received from the peer,
+ *       and from all peers of its net, as 64-bit counts that don't wrap,
+ *       with the rates per second since the last such report of each.
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       This message does not affect the command execution counter. The
+ *       first report (after startup or a reset) has no interval, and rates
+ *       of 0. Unlike those of #SBN_HK_PEER_CC, these counters are kept
+ *       across reconnections.
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_HK_CNTS_CC
+ */
+static void HKCntsCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_PEER_LEN, "hk counters"))
+    {
+        return;
+    } /* end if */
+
+    uint8 *Ptr     = (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t);
+    uint8  NetIdx  = *Ptr++;
+    uint8  PeerIdx = *Ptr;
+
+    if (NetIdx >= SBN.NetCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid NetIdx (%d, max is %d)", NetIdx, SBN.NetCnt - 1);
+        return;
+    } /* end if */
+
+    if (PeerIdx >= SBN.Nets[NetIdx].PeerCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid PeerIdx (NetIdx=%d PeerIdx=%d, max is %d)", NetIdx, PeerIdx,
+                   SBN.Nets[NetIdx].PeerCnt - 1);
+        return;
+    } /* end if */
+
+    SBN_NetInterface_t  *Net  = &SBN.Nets[NetIdx];
+    SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+    EVSSendInfo(SBN_CMD_EID, "hk counters command, net=%d, peer=%d", NetIdx, PeerIdx);
+
+    uint8              HKBuf[SBN_HKCNTS_LEN];
+    CFE_MSG_Message_t *HKMsg = (CFE_MSG_Message_t *)HKBuf;
+    Pack_t             Pack;
+    int64              NowUs = SBN_LatNowUs();
+
+    CFE_MSG_Init(HKMsg, CFE_SB_ValueToMsgId(SBN_TLM_MID), SBN_HKCNTS_LEN);
+
+    Pack_Init(&Pack, HKBuf + sizeof(CFE_MSG_TelemetryHeader_t), SBN_HKCNTS_LEN - sizeof(CFE_MSG_TelemetryHeader_t), 1);
+
+    Pack_UInt8(&Pack, SBN_HK_CNTS_CC);
+    Pack_UInt8(&Pack, NetIdx);
+    Pack_UInt8(&Pack, PeerIdx);
+    PackCnts(&Pack, &Net->Cnts, &Net->HKCnts, &Net->HKUs, NowUs);
+    PackCnts(&Pack, &Peer->Cnts, &Peer->HKCnts, &Peer->HKUs, NowUs);
+
+    /*
+    ** Timestamp and send packet
+    */
+    CFE_SB_TimeStampMsg(HKMsg);
+    CFE_SB_TransmitMsg(HKMsg, true);
+} /* end HKCntsCmd */
+
+/** @brief Packs the heaviest message IDs one way, SBN_MIDSTAT_TOP_CNT of them (unused ones all zeros.) */
+static void PackMidTop(Pack_t *Pack, const SBN_MidStats_t *Stats, bool ByBytes)
+{
+    SBN_MidCnt_t Top[SBN_MIDSTAT_TOP_CNT];
+    uint8        Cnt = SBN_MidStatTop(Stats, ByBytes, Top, SBN_MIDSTAT_TOP_CNT), i = 0;
+
+    memset(&Top[Cnt], 0, sizeof(Top[0]) * (SBN_MIDSTAT_TOP_CNT - Cnt));
+
+    for (i = 0; i < SBN_MIDSTAT_TOP_CNT; i++)
+    {
+        Pack_MsgID(Pack, Top[i].MsgID);
+        Pack_UInt32(Pack, Top[i].MsgCnt);
+        Pack_UInt64(Pack, Top[i].Bytes);
+        Pack_UInt8(Pack, Top[i].Exact);
+    } /* end for */
+} /* end PackMidTop() */
+
+/** \brief Request for the heaviest message IDs sent to and received from a peer.
+ *
+ *  \par Description
+ *       Reports, each way, the #SBN_MIDSTAT_TOP_CNT message IDs with the
+ *       most bytes and those with the most messages, since startup or a
+ *       reset. IDs set with #SBN_MIDSTAT_MID_CC are counted exactly, the
+ *       rest estimated from a count-min sketch (never low, but high by the
+ *       IDs that share its counters.)
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       This message does not affect the command execution counter
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_HK_MIDS_CC
+ */
+static void HKMidsCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_PEER_LEN, "hk mids"))
+    {
+        return;
+    } /* end if */
+
+    uint8 *Ptr     = (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t);
+    uint8  NetIdx  = *Ptr++;
+    uint8  PeerIdx = *Ptr;
+
+    if (NetIdx >= SBN.NetCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid NetIdx (%d, max is %d)", NetIdx, SBN.NetCnt - 1);
+        return;
+    } /* end if */
+
+    if (PeerIdx >= SBN.Nets[NetIdx].PeerCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid PeerIdx (NetIdx=%d PeerIdx=%d, max is %d)", NetIdx, PeerIdx,
+                   SBN.Nets[NetIdx].PeerCnt - 1);
+        return;
+    } /* end if */
+
+    SBN_PeerInterface_t *Peer = &SBN.Nets[NetIdx].Peers[PeerIdx];
+
+    EVSSendInfo(SBN_CMD_EID, "hk mids command, net=%d, peer=%d", NetIdx, PeerIdx);
+
+    uint8              HKBuf[SBN_HKMIDS_LEN];
+    CFE_MSG_Message_t *HKMsg = (CFE_MSG_Message_t *)HKBuf;
+    Pack_t             Pack;
+
+    CFE_MSG_Init(HKMsg, CFE_SB_ValueToMsgId(SBN_TLM_MID), SBN_HKMIDS_LEN);
+
+    Pack_Init(&Pack, HKBuf + sizeof(CFE_MSG_TelemetryHeader_t), SBN_HKMIDS_LEN - sizeof(CFE_MSG_TelemetryHeader_t), 1);
+
+    Pack_UInt8(&Pack, SBN_HK_MIDS_CC);
+    Pack_UInt8(&Pack, NetIdx);
+    Pack_UInt8(&Pack, PeerIdx);
+    PackMidTop(&Pack, &Peer->SendMids, true);
+    PackMidTop(&Pack, &Peer->SendMids, false);
+    PackMidTop(&Pack, &Peer->RecvMids, true);
+    PackMidTop(&Pack, &Peer->RecvMids, false);
+
+    /*
+    ** Timestamp and send packet
+    */
+    CFE_SB_TimeStampMsg(HKMsg);
+    CFE_SB_TransmitMsg(HKMsg, true);
+} /* end HKMidsCmd */
+
+/** \brief Count a message ID exactly, or stop.
+ *
+ *  \par Description
+ *       Counts the traffic of a message ID to and from each peer in a slot of
+ *       its own, rather than in the sketch, emptying the slot; or stops.
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       At most #SBN_MIDSTAT_MIDS message IDs are counted exactly.
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_MIDSTAT_MID_CC
+ */
+static void MidStatMidCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_MIDSTATMID_LEN, "mid stats mid"))
+    {
+        return;
+    } /* end if */
+
+    CFE_SB_MsgId_t MsgID   = CFE_SB_INVALID_MSG_ID;
+    uint8          Counted = 0;
+    Pack_t         Pack;
+
+    Pack_Init(&Pack, (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t),
+              SBN_CMD_MIDSTATMID_LEN - sizeof(CFE_MSG_CommandHeader_t), false);
+    Unpack_MsgID(&Pack, &MsgID);
+    Unpack_UInt8(&Pack, &Counted);
+
+    if (SBN_MidStatSetMid(MsgID, Counted) != SBN_SUCCESS)
+    {
+        SBN.CmdErrCnt++;
+        EVSSendErr(SBN_CMD_EID, "unable to %s mid stats MsgID 0x%04X", Counted ? "add" : "remove",
+                   CFE_SB_MsgIdToValue(MsgID));
+        return;
+    } /* end if */
+
+    EVSSendInfo(SBN_CMD_EID, "mid stats mid command (MsgID=0x%04X, Counted=%d)", CFE_SB_MsgIdToValue(MsgID), Counted);
+    SBN.CmdCnt++;
+} /* end MidStatMidCmd */
+
+/**
+ * Packs the count, median, 99th percentile and largest value of a latency
+ * histogram.
+ */
+static void PackLatHist(Pack_t *Pack, const SBN_LatHist_t *Hist)
+{
+    Pack_UInt32(Pack, Hist->Cnt);
+    Pack_UInt32(Pack, SBN_LatHistPercentile(Hist, 50));
+    Pack_UInt32(Pack, SBN_LatHistPercentile(Hist, 99));
+    Pack_UInt32(Pack, Hist->MaxUs);
+} /* end PackLatHist() */
+
+/** \brief Request for latency telemetry for one peer.
+ *
+ *  \par Description
+ *       Reports the estimate of the peer's clock and the one-way latency,
+ *       in microseconds, of stamped app messages from the peer and of each
+ *       message ID set with #SBN_LAT_MID_CC (from any peer.)
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       This message does not affect the command execution counter
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_HK_LAT_CC
+ */
+static void HKLatCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_PEER_LEN, "hk latency"))
+    {
+        return;
+    } /* end if */
+
+    uint8 *Ptr     = (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t);
+    uint8  NetIdx  = *Ptr++;
+    uint8  PeerIdx = *Ptr;
+
+    if (NetIdx >= SBN.NetCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid NetIdx (%d, max is %d)", NetIdx, SBN.NetCnt - 1);
+        return;
+    } /* end if */
+
+    if (PeerIdx >= SBN.Nets[NetIdx].PeerCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid PeerIdx (NetIdx=%d PeerIdx=%d, max is %d)", NetIdx, PeerIdx,
+                   SBN.Nets[NetIdx].PeerCnt - 1);
+        return;
+    } /* end if */
+
+    SBN_PeerInterface_t *Peer = &SBN.Nets[NetIdx].Peers[PeerIdx];
+
+    EVSSendInfo(SBN_CMD_EID, "hk latency command, net=%d, peer=%d", NetIdx, PeerIdx);
+
+    static const SBN_LatHist_t NoHist;
+
+    uint8              HKBuf[SBN_HKLAT_LEN];
+    CFE_MSG_Message_t *HKMsg = (CFE_MSG_Message_t *)HKBuf;
+    Pack_t             Pack;
+    int64              OffsetUs = Peer->LatSync.OffsetUs;
+    int                i        = 0;
+
+    /* an offset beyond the int32 range (over half an hour) is reported at the limit */
+    if (OffsetUs > 0x7FFFFFFF)
+    {
+        OffsetUs = 0x7FFFFFFF;
+    }
+    else if (OffsetUs < -0x7FFFFFFF)
+    {
+        OffsetUs = -0x7FFFFFFF;
+    } /* end if */
+
+    CFE_MSG_Init(HKMsg, CFE_SB_ValueToMsgId(SBN_TLM_MID), SBN_HKLAT_LEN);
+
+    Pack_Init(&Pack, HKBuf + sizeof(CFE_MSG_TelemetryHeader_t), SBN_HKLAT_LEN - sizeof(CFE_MSG_TelemetryHeader_t), 1);
+
+    Pack_UInt8(&Pack, SBN_HK_LAT_CC);
+    Pack_UInt32(&Pack, Peer->ProcessorID);
+    Pack_UInt8(&Pack, Peer->LatSync.Valid);
+    Pack_UInt32(&Pack, (uint32)(int32)OffsetUs);
+    Pack_UInt32(&Pack, Peer->LatSync.DelayUs > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32)Peer->LatSync.DelayUs);
+    PackLatHist(&Pack, &Peer->LatHist);
+
+    for (i = 0; i < SBN_LAT_MAX_MIDS; i++)
+    {
+        /* unused slots are all zeros */
+        if (SBN.LatMids[i].InUse)
+        {
+            Pack_MsgID(&Pack, SBN.LatMids[i].MsgID);
+            PackLatHist(&Pack, &SBN.LatMids[i].Hist);
+        }
+        else
+        {
+            Pack_UInt32(&Pack, 0);
+            PackLatHist(&Pack, &NoHist);
+        } /* end if */
+    }     /* end for */
+
+    /*
+    ** Timestamp and send packet
+    */
+    CFE_SB_TimeStampMsg(HKMsg);
+    CFE_SB_TransmitMsg(HKMsg, true);
+} /* end HKLatCmd */
+
+/** \brief Set a message ID whose latency is kept.
+ *
+ *  \par Description
+ *       Sets one of the #SBN_LAT_MAX_MIDS slots to a message ID, or clears
+ *       it for an invalid message ID, and empties its histogram.
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       None
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_LAT_MID_CC
+ */
+static void LatMidCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_LATMID_LEN, "latency mid"))
+    {
+        return;
+    } /* end if */
+
+    uint8          Slot  = 0;
+    CFE_SB_MsgId_t MsgID = CFE_SB_INVALID_MSG_ID;
+    Pack_t         Pack;
+
+    Pack_Init(&Pack, (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t),
+              SBN_CMD_LATMID_LEN - sizeof(CFE_MSG_CommandHeader_t), false);
+    Unpack_UInt8(&Pack, &Slot);
+    Unpack_MsgID(&Pack, &MsgID);
+
+    if (Slot >= SBN_LAT_MAX_MIDS)
+    {
+        SBN.CmdErrCnt++;
+        EVSSendErr(SBN_CMD_EID, "invalid latency slot %d (max=%d)", Slot, SBN_LAT_MAX_MIDS - 1);
+        return;
+    } /* end if */
+
+    EVSSendInfo(SBN_CMD_EID, "latency mid command (Slot=%d, MsgID=0x%04X)", Slot, CFE_SB_MsgIdToValue(MsgID));
+    SBN.CmdCnt++;
+
+    SBN.LatMids[Slot].InUse = CFE_SB_IsValidMsgId(MsgID);
+    SBN.LatMids[Slot].MsgID = MsgID;
+    memset(&SBN.LatMids[Slot].Hist, 0, sizeof(SBN.LatMids[Slot].Hist));
+} /* end LatMidCmd */
+
+/** \brief Measure the round trip time to one peer.
+ *
+ *  \par Description
+ *       Sends the peer Cnt probes, each after the echo of the last or
+ *       #SBN_PROBE_TIMEOUT_MS, then reports the round trip times, in
+ *       microseconds, and how many were echoed.
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       One run at a time. Probes travel as any other message to the peer,
+ *       so they measure the queueing on the way as well as the link.
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_PROBE_CC
+ */
+static void ProbeCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_PROBE_LEN, "probe"))
+    {
+        return;
+    } /* end if */
+
+    uint8 *Ptr     = (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t);
+    uint8  NetIdx  = *Ptr++;
+    uint8  PeerIdx = *Ptr++;
+    uint8  Cnt     = *Ptr;
+
+    if (NetIdx >= SBN.NetCnt)
+    {
+        SBN.CmdErrCnt++;
+        EVSSendErr(SBN_CMD_EID, "Invalid NetIdx (%d, max is %d)", NetIdx, SBN.NetCnt - 1);
+        return;
+    } /* end if */
+
+    if (PeerIdx >= SBN.Nets[NetIdx].PeerCnt)
+    {
+        SBN.CmdErrCnt++;
+        EVSSendErr(SBN_CMD_EID, "Invalid PeerIdx (NetIdx=%d PeerIdx=%d, max is %d)", NetIdx, PeerIdx,
+                   SBN.Nets[NetIdx].PeerCnt - 1);
+        return;
+    } /* end if */
+
+    if (Cnt == 0 || Cnt > SBN_PROBE_MAX_CNT)
+    {
+        SBN.CmdErrCnt++;
+        EVSSendErr(SBN_CMD_EID, "invalid probe count %d (max=%d)", Cnt, SBN_PROBE_MAX_CNT);
+        return;
+    } /* end if */
+
+    if (!SBN.Nets[NetIdx].Peers[PeerIdx].Connected)
+    {
+        SBN.CmdErrCnt++;
+        EVSSendErr(SBN_CMD_EID, "cannot probe unconnected peer (NetIdx=%d PeerIdx=%d)", NetIdx, PeerIdx);
+        return;
+    } /* end if */
+
+    if (SBN_LatProbeStart(NetIdx, PeerIdx, Cnt) != SBN_SUCCESS)
+    {
+        SBN.CmdErrCnt++;
+        EVSSendErr(SBN_CMD_EID, "probe already in progress (NetIdx=%d PeerIdx=%d)", SBN.Probe.NetIdx,
+                   SBN.Probe.PeerIdx);
+        return;
+    } /* end if */
+
+    EVSSendInfo(SBN_CMD_EID, "probe command, net=%d, peer=%d, cnt=%d", NetIdx, PeerIdx, Cnt);
+    SBN.CmdCnt++;
+} /* end ProbeCmd */
+
+/**
+ * Packs a stage's count, mean and largest time.
+ */
+static void PackStageStats(Pack_t *Pack, const SBN_StageStats_t *Stats)
+{
+    Pack_UInt32(Pack, Stats->Cnt);
+    Pack_UInt32(Pack, Stats->Cnt ? (uint32)(Stats->TotalUs / Stats->Cnt) : 0);
+    Pack_UInt32(Pack, Stats->MaxUs);
+} /* end PackStageStats() */
+
+/** \brief Request for stage timing telemetry.
+ *
+ *  \par Description
+ *       Reports the time, in microseconds, spent in each wakeup and in each
+ *       stage of the work (see #SBN_Stage_t), and how many wakeups overran
+ *       #SBN_WAKEUP_SLOT_US, since the counters were last reset.
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       This message does not affect the command execution counter
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_HK_PERF_CC
+ */
+static void HKPerfCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, sizeof(CFE_MSG_CommandHeader_t), "hk perf"))
+    {
+        return;
+    } /* end if */
+
+    EVSSendInfo(SBN_CMD_EID, "hk perf command");
+
+    uint8              HKBuf[SBN_HKPERF_LEN];
+    CFE_MSG_Message_t *HKMsg = (CFE_MSG_Message_t *)HKBuf;
+    Pack_t             Pack;
+    int                i = 0;
+
+    CFE_MSG_Init(HKMsg, CFE_SB_ValueToMsgId(SBN_TLM_MID), SBN_HKPERF_LEN);
+
+    Pack_Init(&Pack, HKBuf + sizeof(CFE_MSG_TelemetryHeader_t), SBN_HKPERF_LEN - sizeof(CFE_MSG_TelemetryHeader_t), 1);
+
+    Pack_UInt8(&Pack, SBN_HK_PERF_CC);
+    Pack_UInt32(&Pack, SBN_WAKEUP_SLOT_US);
+    PackStageStats(&Pack, &SBN.Wakeups);
+    Pack_UInt32(&Pack, SBN.WakeupOverrunCnt);
+
+    for (i = 0; i < SBN_STAGE_CNT; i++)
+    {
+        PackStageStats(&Pack, &SBN.Stages[i]);
+    } /* end for */
+
+    /*
+    ** Timestamp and send packet
+    */
+    CFE_SB_TimeStampMsg(HKMsg);
+    CFE_SB_TransmitMsg(HKMsg, true);
+} /* end HKPerfCmd */
+
+/** \brief Turn per-message debug events on or off.
+ *
+ *  \par Description
+ *       Debug events sent for every message, or for every peer every
+ *       wakeup, are not even formatted unless turned on with this command.
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       Such events are compiled in only if #SBN_MSG_EVENTS. They are off
+ *       at startup.
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_MSG_EVENTS_CC
+ */
+static void MsgEventsCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_MSGEVENTS_LEN, "msg events"))
+    {
+        return;
+    } /* end if */
+
+    uint8 *Ptr = (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t);
+
+    SBN.MsgEvents = *Ptr != 0;
+
+    EVSSendInfo(SBN_CMD_EID, "per-message events %s%s", SBN.MsgEvents ? "on" : "off",
+                SBN_MSG_EVENTS ? "" : " (compiled out)");
+    SBN.CmdCnt++;
+} /* end MsgEventsCmd */
+
+/** \brief Start, stop or dump the message trace.
+ *
+ *  \par Description
+ *       With #SBN_TRACE_ON, clears the trace ring and starts recording the
+ *       points app messages pass through; #SBN_TRACE_OFF stops it; and
+ *       #SBN_TRACE_DUMP stops it and writes the ring to #SBN_TRACE_FILENAME,
+ *       for test/sbnhk/sbn_trace2json to turn into a Chrome trace.
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       Tracing is off at startup. The ring is not cleared by a dump, so it
+ *       can be dumped again.
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_TRACE_CC
+ */
+static void TraceCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    uint32 Cnt = 0;
+
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_TRACE_LEN, "trace"))
+    {
+        return;
+    } /* end if */
+
+    uint8 *Ptr  = (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t);
+    uint8  Mode = *Ptr;
+
+    switch (Mode)
+    {
+        case SBN_TRACE_OFF:
+            SBN.Trace.On = false;
+            EVSSendInfo(SBN_CMD_EID, "trace off (%lu points)", (unsigned long)SBN.Trace.Next);
+            break;
+        case SBN_TRACE_ON:
+            SBN_TraceStart();
+            EVSSendInfo(SBN_CMD_EID, "trace on");
+            break;
+        case SBN_TRACE_DUMP:
+            SBN.Trace.On = false;
+            if (SBN_TraceDump(SBN_TRACE_FILENAME, &Cnt) != SBN_SUCCESS)
+            {
+                EVSSendErr(SBN_CMD_EID, "unable to write trace to %s", SBN_TRACE_FILENAME);
+                SBN.CmdErrCnt++;
+                return;
+            } /* end if */
+            EVSSendInfo(SBN_CMD_EID, "trace dumped to %s (%lu points)", SBN_TRACE_FILENAME, (unsigned long)Cnt);
+            break;
+        default:
+            EVSSendErr(SBN_CMD_EID, "invalid trace mode (%d)", Mode);
+            SBN.CmdErrCnt++;
+            return;
+    } /* end switch */
+
+    SBN.CmdCnt++;
+} /* end TraceCmd */
+
+/** \brief Request for module-specific status for one peer.
+ *
+ *  \par Description
+ *       Asks the peer's protocol module to report its own status (link
+ *       counters, queue depths, etc.), which is sent as-is in the
+ *       ModuleStatus field of the response.
+ *
+ *  \par Assumptions, External Events, and Notes:
+ *       This message does not affect the command execution counter
+ *
+ *  \param [in]   MsgPtr A #CFE_MSG_Message_t pointer that
+ *                       references the software bus message
+ *
+ *  \sa #SBN_HK_MODSTATUS_CC
+ */
+static void HKModStatusCmd(CFE_MSG_Message_t *MsgPtr)
+{
+    if (!VerifyMsgLen(MsgPtr, SBN_CMD_PEER_LEN, "hk module status"))
+    {
+        return;
+    } /* end if */
+
+    uint8 *Ptr     = (uint8 *)MsgPtr + sizeof(CFE_MSG_CommandHeader_t);
+    uint8  NetIdx  = *Ptr++;
+    uint8  PeerIdx = *Ptr;
+
+    if (NetIdx >= SBN.NetCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid NetIdx (%d, max is %d)", NetIdx, SBN.NetCnt - 1);
+        return;
+    } /* end if */
+
+    if (PeerIdx >= SBN.Nets[NetIdx].PeerCnt)
+    {
+        EVSSendErr(SBN_CMD_EID, "Invalid PeerIdx (NetIdx=%d PeerIdx=%d, max is %d)", NetIdx, PeerIdx,
+                   SBN.Nets[NetIdx].PeerCnt - 1);
+        return;
+    } /* end if */
+
+    SBN_NetInterface_t  *Net  = &SBN.Nets[NetIdx];
+    SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+    if (Net->IfOps == NULL || Net->IfOps->ReportModuleStatus == NULL)
+    {
+        EVSSendErr(SBN_CMD_EID, "module status not supported (NetIdx=%d ProtocolIdx=%d)", NetIdx, Net->ProtocolIdx);
+        return;
+    } /* end if */
+
+    EVSSendInfo(SBN_CMD_EID, "hk module status command, net=%d, peer=%d", NetIdx, PeerIdx);
+
+    uint8  HKBuf[SBN_HKMODSTATUS_LEN];
+    CFE_MSG_Message_t *HKMsg = (CFE_MSG_Message_t *)HKBuf;
+    Pack_t Pack;
+
+    CFE_MSG_Init(HKMsg, CFE_SB_ValueToMsgId(SBN_TLM_MID), SBN_HKMODSTATUS_LEN);
+
+    Pack_Init(&Pack, HKBuf + sizeof(CFE_MSG_TelemetryHeader_t), SBN_HKMODSTATUS_LEN - sizeof(CFE_MSG_TelemetryHeader_t), 1);
+
+    Pack_UInt8(&Pack, SBN_HK_MODSTATUS_CC);
+    Pack_UInt8(&Pack, NetIdx);
+    Pack_UInt16(&Pack, PeerIdx);
+    Pack_UInt8(&Pack, Net->ProtocolIdx);
+
+    /* the module packs its own status into the remainder, zeroed by Pack_Init */
+    if (Net->IfOps->ReportModuleStatus(Peer, (uint8 *)Pack.Buf + Pack.BufUsed, SBN_MOD_STATUS_MSG_SZ) != SBN_SUCCESS)
+    {
+        EVSSendErr(SBN_CMD_EID, "module status failed (NetIdx=%d PeerIdx=%d)", NetIdx, PeerIdx);
+        return;
+    } /* end if */
+
+    /*
+    ** Timestamp and send packet
+    */
+    CFE_SB_TimeStampMsg(HKMsg);
+    CFE_SB_TransmitMsg(HKMsg, true);
+} /* end HKModStatusCmd */
+
 /** \brief Send My Subscriptions
  *
  *  \par Assumptions, External Events, and Notes:
@@ -568,6 +1427,42 @@ void SBN_HandleCommand(CFE_MSG_Message_t *MsgPtr)
         case SBN_HK_RESET_PEER_CC:
             HKResetPeerCmd(MsgPtr);
             break;
+        case SBN_HK_MODSTATUS_CC:
+            HKModStatusCmd(MsgPtr);
+            break;
+        case SBN_HK_LAT_CC:
+            HKLatCmd(MsgPtr);
+            break;
+        case SBN_LAT_MID_CC:
+            LatMidCmd(MsgPtr);
+            break;
+        case SBN_PROBE_CC:
+            ProbeCmd(MsgPtr);
+            break;
+        case SBN_HK_PERF_CC:
+            HKPerfCmd(MsgPtr);
+            break;
+        case SBN_MSG_EVENTS_CC:
+            MsgEventsCmd(MsgPtr);
+            break;
+        case SBN_TRACE_CC:
+            TraceCmd(MsgPtr);
+            break;
+        case SBN_HK_CNTS_CC:
+            HKCntsCmd(MsgPtr);
+            break;
+
+        case SBN_HK_MIDS_CC:
+            HKMidsCmd(MsgPtr);
+            break;
+
+        case SBN_MIDSTAT_MID_CC:
+            MidStatMidCmd(MsgPtr);
+            break;
+
+        case SBN_HK_ALLPEERS_CC:
+            HKAllPeersCmd(MsgPtr);
+            break;
 
         case SBN_SCH_WAKEUP_CC:
             EVSSendDbg(SBN_CMD_EID, "wakeup");
@@ -0,0 +1,475 @@
+/******************************************************************************
+ ** \file sbn_lat.c
+ **
+ ** Purpose:
+ **      This file contains source code for the Software Bus Network
+ **      Application's latency measurement: send stamps, peer clock estimates
+ **      and one-way latency histograms.
+ */
+
+#include "sbn_lat.h"
+
+int64 SBN_LatNowUs(void)
+{
+    OS_time_t Now = {0};
+
+    OS_GetLocalTime(&Now);
+
+    return OS_TimeGetTotalMicroseconds(Now);
+} /* end SBN_LatNowUs() */
+
+bool SBN_LatPackUs(Pack_t *Pack, int64 Us)
+{
+    return Pack_UInt32(Pack, (uint32)(Us / 1000000)) && Pack_UInt32(Pack, (uint32)(Us % 1000000));
+} /* end SBN_LatPackUs() */
+
+bool SBN_LatUnpackUs(Pack_t *Pack, int64 *UsPtr)
+{
+    uint32 Sec = 0, Usec = 0;
+
+    if (!Unpack_UInt32(Pack, &Sec) || !Unpack_UInt32(Pack, &Usec))
+    {
+        return false;
+    } /* end if */
+
+    *UsPtr = (int64)Sec * 1000000 + Usec;
+
+    return true;
+} /* end SBN_LatUnpackUs() */
+
+/**
+ * The bucket of a value: its highest bit picks the group and the
+ * SBN_LAT_SUB_BITS bits below that the bucket in the group.
+ */
+static uint16 BucketOf(uint32 Us)
+{
+    uint8 Exp = SBN_LAT_SUB_BITS;
+
+    if (Us < (1 << SBN_LAT_SUB_BITS))
+    {
+        return Us;
+    } /* end if */
+
+    while (Exp < 31 && (Us >> (Exp + 1)))
+    {
+        Exp++;
+    } /* end while */
+
+    return ((Exp - SBN_LAT_SUB_BITS + 1) << SBN_LAT_SUB_BITS) +
+           ((Us >> (Exp - SBN_LAT_SUB_BITS)) & ((1 << SBN_LAT_SUB_BITS) - 1));
+} /* end BucketOf() */
+
+/** The least value in a bucket. */
+static uint32 BucketLow(uint16 Idx)
+{
+    uint16 Group = Idx >> SBN_LAT_SUB_BITS;
+    uint32 Sub   = Idx & ((1 << SBN_LAT_SUB_BITS) - 1);
+
+    if (Group == 0)
+    {
+        return Sub;
+    } /* end if */
+
+    return ((1 << SBN_LAT_SUB_BITS) + Sub) << (Group - 1);
+} /* end BucketLow() */
+
+void SBN_LatHistAdd(SBN_LatHist_t *Hist, uint32 Us)
+{
+    Hist->Buckets[BucketOf(Us)]++;
+    Hist->Cnt++;
+
+    if (Us > Hist->MaxUs)
+    {
+        Hist->MaxUs = Us;
+    } /* end if */
+} /* end SBN_LatHistAdd() */
+
+uint32 SBN_LatHistPercentile(const SBN_LatHist_t *Hist, uint8 Pct)
+{
+    uint32 Rank = 0, Seen = 0, High = 0;
+    uint16 Idx  = 0;
+
+    if (Hist->Cnt == 0)
+    {
+        return 0;
+    } /* end if */
+
+    /* the rank of the percentile, rounded up, at least the first */
+    Rank = (uint32)(((uint64)Hist->Cnt * Pct + 99) / 100);
+    if (Rank == 0)
+    {
+        Rank = 1;
+    } /* end if */
+
+    for (Idx = 0; Idx < SBN_LAT_BUCKETS; Idx++)
+    {
+        Seen += Hist->Buckets[Idx];
+        if (Seen >= Rank)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    if (Idx >= SBN_LAT_BUCKETS - 1)
+    {
+        return Hist->MaxUs;
+    } /* end if */
+
+    High = BucketLow(Idx + 1) - 1;
+
+    return High < Hist->MaxUs ? High : Hist->MaxUs;
+} /* end SBN_LatHistPercentile() */
+
+void SBN_LatSyncSample(SBN_LatSync_t *Sync, int64 T1, int64 T2, int64 T3, int64 T4)
+{
+    int64 DelayUs = (T4 - T1) - (T3 - T2);
+    uint8 i = 0, Best = 0;
+
+    /* the clocks' resolution can make a short round trip look negative */
+    if (DelayUs < 0)
+    {
+        DelayUs = 0;
+    } /* end if */
+
+    Sync->SampleDelayUs[Sync->SampleNext]  = DelayUs;
+    Sync->SampleOffsetUs[Sync->SampleNext] = ((T2 - T1) + (T3 - T4)) / 2;
+    Sync->SampleNext                       = (Sync->SampleNext + 1) % SBN_LAT_SYNC_SAMPLES;
+    if (Sync->SampleCnt < SBN_LAT_SYNC_SAMPLES)
+    {
+        Sync->SampleCnt++;
+    } /* end if */
+
+    /* the exchange with the least round trip had the least room for asymmetry */
+    for (i = 1; i < Sync->SampleCnt; i++)
+    {
+        if (Sync->SampleDelayUs[i] < Sync->SampleDelayUs[Best])
+        {
+            Best = i;
+        } /* end if */
+    }     /* end for */
+
+    Sync->OffsetUs = Sync->SampleOffsetUs[Best];
+    Sync->DelayUs  = Sync->SampleDelayUs[Best];
+    Sync->Valid    = true;
+} /* end SBN_LatSyncSample() */
+
+/**
+ * Sends an SBN_TIME_MSG to a peer, echoing the last one from it.
+ */
+static SBN_Status_t SendSync(SBN_PeerInterface_t *Peer, int64 NowUs)
+{
+    uint8  Buf[SBN_TIME_MSG_SZ];
+    Pack_t Pack;
+
+    Pack_Init(&Pack, Buf, sizeof(Buf), false);
+    SBN_LatPackUs(&Pack, Peer->LatSync.PeerXmitUs);
+    SBN_LatPackUs(&Pack, Peer->LatSync.PeerXmitRecvUs);
+    SBN_LatPackUs(&Pack, NowUs);
+
+    Peer->LatSync.LastSentUs = NowUs;
+
+    return SBN_SendNetMsg(SBN_TIME_MSG, Pack.BufUsed, Buf, Peer);
+} /* end SendSync() */
+
+void SBN_LatSyncPeers(void)
+{
+    SBN_NetIdx_t  NetIdx  = 0;
+    SBN_PeerIdx_t PeerIdx = 0;
+    int64         NowUs   = SBN_LatNowUs();
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        SBN_NetInterface_t *Net = &SBN.Nets[NetIdx];
+
+        for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+        {
+            SBN_PeerInterface_t *Peer = &Net->Peers[PeerIdx];
+
+            if (!Peer->Connected)
+            {
+                continue;
+            } /* end if */
+
+            /* a peer that stamps its messages is answered, so it can estimate my clock */
+            if (!(Net->NetFlags & SBN_NET_STAMP) && !Peer->LatSync.PeerXmitUs)
+            {
+                continue;
+            } /* end if */
+
+            if (Peer->LatSync.LastSentUs && NowUs - Peer->LatSync.LastSentUs < (int64)SBN_LAT_SYNC_SECS * 1000000)
+            {
+                continue;
+            } /* end if */
+
+            SendSync(Peer, NowUs);
+        } /* end for */
+    }     /* end for */
+} /* end SBN_LatSyncPeers() */
+
+SBN_Status_t SBN_LatRecvSync(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_LatSync_t *Sync = &Peer->LatSync;
+    int64          Orig = 0, Recv = 0, Xmit = 0, NowUs = SBN_LatNowUs();
+    Pack_t         Pack;
+
+    Pack_Init(&Pack, Msg, MsgSz, false);
+    if (!SBN_LatUnpackUs(&Pack, &Orig) || !SBN_LatUnpackUs(&Pack, &Recv) || !SBN_LatUnpackUs(&Pack, &Xmit))
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    /* each of mine is used once, and only if I sent it (not from before a restart) */
+    if (Orig != 0 && Orig > Sync->LastOrigUs && Orig <= Sync->LastSentUs)
+    {
+        SBN_LatSyncSample(Sync, Orig, Recv, Xmit, NowUs);
+        Sync->LastOrigUs = Orig;
+    } /* end if */
+
+    Sync->PeerXmitUs     = Xmit;
+    Sync->PeerXmitRecvUs = NowUs;
+
+    return SBN_SUCCESS;
+} /* end SBN_LatRecvSync() */
+
+/**
+ * \brief Takes SBN.SendMutex for SBN.Probe, which receive tasks update as
+ * echoes arrive; the probes sent under it take it again, as OSAL mutexes
+ * allow.
+ */
+static bool LockProbe(void)
+{
+    if (OS_MutSemTake(SBN.SendMutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_CMD_EID, "unable to take send mutex");
+        return false;
+    } /* end if */
+
+    return true;
+} /* end LockProbe */
+
+/** \brief Gives SBN.SendMutex, see LockProbe. */
+static void UnlockProbe(void)
+{
+    if (OS_MutSemGive(SBN.SendMutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_CMD_EID, "unable to give send mutex");
+    } /* end if */
+} /* end UnlockProbe */
+
+/**
+ * Sends the next probe of the run, with the probe locked.
+ */
+static void SendProbe(void)
+{
+    SBN_LatProbe_t *Probe = &SBN.Probe;
+    uint8           Buf[SBN_PROBE_MSG_SZ];
+    Pack_t          Pack;
+
+    Probe->SentUs  = SBN_LatNowUs();
+    Probe->Waiting = true;
+
+    Pack_Init(&Pack, Buf, sizeof(Buf), false);
+    Pack_UInt16(&Pack, Probe->Id);
+    Pack_UInt16(&Pack, Probe->SentCnt++);
+    SBN_LatPackUs(&Pack, Probe->SentUs);
+
+    /* a probe that is not sent is counted lost */
+    SBN_SendNetMsg(SBN_PROBE_MSG, Pack.BufUsed, Buf, Probe->Peer);
+} /* end SendProbe() */
+
+SBN_Status_t SBN_LatProbeStart(SBN_NetIdx_t NetIdx, SBN_PeerIdx_t PeerIdx, uint8 Cnt)
+{
+    SBN_LatProbe_t *Probe = &SBN.Probe;
+
+    if (!LockProbe())
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Probe->Active)
+    {
+        UnlockProbe();
+        return SBN_ERROR;
+    } /* end if */
+
+    Probe->Peer    = &SBN.Nets[NetIdx].Peers[PeerIdx];
+    Probe->NetIdx  = NetIdx;
+    Probe->PeerIdx = PeerIdx;
+    Probe->Id++;
+    Probe->Cnt     = Cnt;
+    Probe->SentCnt = 0;
+    Probe->RecvCnt = 0;
+    Probe->Active  = true;
+
+    SendProbe();
+
+    UnlockProbe();
+
+    return SBN_SUCCESS;
+} /* end SBN_LatProbeStart() */
+
+/**
+ * Sends the telemetry of a finished run, with the probe locked.
+ */
+static void ReportProbe(void)
+{
+    SBN_LatProbe_t *   Probe = &SBN.Probe;
+    uint8              HKBuf[SBN_HKPROBE_LEN];
+    CFE_MSG_Message_t *HKMsg = (CFE_MSG_Message_t *)HKBuf;
+    Pack_t             Pack;
+    uint64             SumUs = 0;
+    uint32             RttUs = 0;
+    uint8              i = 0, j = 0;
+
+    /* few enough to sort, for an exact 99th percentile */
+    for (i = 1; i < Probe->RecvCnt; i++)
+    {
+        RttUs = Probe->RttUs[i];
+        for (j = i; j > 0 && Probe->RttUs[j - 1] > RttUs; j--)
+        {
+            Probe->RttUs[j] = Probe->RttUs[j - 1];
+        } /* end for */
+        Probe->RttUs[j] = RttUs;
+    } /* end for */
+
+    for (i = 0; i < Probe->RecvCnt; i++)
+    {
+        SumUs += Probe->RttUs[i];
+    } /* end for */
+
+    CFE_MSG_Init(HKMsg, CFE_SB_ValueToMsgId(SBN_TLM_MID), SBN_HKPROBE_LEN);
+
+    Pack_Init(&Pack, HKBuf + sizeof(CFE_MSG_TelemetryHeader_t), SBN_HKPROBE_LEN - sizeof(CFE_MSG_TelemetryHeader_t),
+              true);
+
+    Pack_UInt8(&Pack, SBN_PROBE_CC);
+    Pack_UInt8(&Pack, Probe->NetIdx);
+    Pack_UInt8(&Pack, Probe->PeerIdx);
+    Pack_UInt8(&Pack, Probe->SentCnt);
+    Pack_UInt8(&Pack, Probe->RecvCnt);
+
+    if (Probe->RecvCnt)
+    {
+        Pack_UInt32(&Pack, Probe->RttUs[0]);
+        Pack_UInt32(&Pack, (uint32)(SumUs / Probe->RecvCnt));
+        Pack_UInt32(&Pack, Probe->RttUs[(Probe->RecvCnt * 99 + 99) / 100 - 1]);
+        Pack_UInt32(&Pack, Probe->RttUs[Probe->RecvCnt - 1]);
+    } /* end if */
+
+    EVSSendInfo(SBN_CMD_EID, "probe of net %d peer %d done, %d of %d echoed", (int)Probe->NetIdx,
+                (int)Probe->PeerIdx, (int)Probe->RecvCnt, (int)Probe->SentCnt);
+
+    CFE_SB_TimeStampMsg(HKMsg);
+    CFE_SB_TransmitMsg(HKMsg, true);
+} /* end ReportProbe() */
+
+void SBN_LatProbePoll(void)
+{
+    SBN_LatProbe_t *Probe = &SBN.Probe;
+
+    if (!Probe->Active || !LockProbe())
+    {
+        return;
+    } /* end if */
+
+    if (Probe->Waiting && SBN_LatNowUs() - Probe->SentUs >= (int64)SBN_PROBE_TIMEOUT_MS * 1000)
+    {
+        Probe->Waiting = false;
+        if (Probe->SentCnt < Probe->Cnt)
+        {
+            SendProbe();
+        } /* end if */
+    }     /* end if */
+
+    if (!Probe->Waiting && Probe->SentCnt >= Probe->Cnt)
+    {
+        ReportProbe();
+        Probe->Active = false;
+    } /* end if */
+
+    UnlockProbe();
+} /* end SBN_LatProbePoll() */
+
+SBN_Status_t SBN_LatRecvProbeEcho(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_LatProbe_t *Probe = &SBN.Probe;
+    uint16          Id = 0, Seq = 0;
+    int64           SentUs = 0;
+    Pack_t          Pack;
+
+    Pack_Init(&Pack, Msg, MsgSz, false);
+    if (!Unpack_UInt16(&Pack, &Id) || !Unpack_UInt16(&Pack, &Seq) || !SBN_LatUnpackUs(&Pack, &SentUs))
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    /* an echo that cannot be taken in is lost */
+    if (!LockProbe())
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    /* only the echo of the probe awaited counts; one that has been given up on is lost */
+    if (!Probe->Active || Peer != Probe->Peer || Id != Probe->Id || !Probe->Waiting || Seq + 1 != Probe->SentCnt)
+    {
+        UnlockProbe();
+        return SBN_SUCCESS;
+    } /* end if */
+
+    Probe->RttUs[Probe->RecvCnt++] = (uint32)(SBN_LatNowUs() - SentUs);
+    Probe->Waiting                 = false;
+
+    /* back to back, so that one probe does not queue behind another */
+    if (Probe->SentCnt < Probe->Cnt)
+    {
+        SendProbe();
+    } /* end if */
+
+    UnlockProbe();
+
+    return SBN_SUCCESS;
+} /* end SBN_LatRecvProbeEcho() */
+
+SBN_Status_t SBN_LatRecvStamp(SBN_PeerInterface_t *Peer, SBN_MsgSz_t *MsgSzPtr, void **MsgPtr)
+{
+    int64          SentUs = 0, LatUs = 0;
+    uint32         Us     = 0;
+    uint8          i      = 0;
+    CFE_SB_MsgId_t MsgID  = CFE_SB_INVALID_MSG_ID;
+    Pack_t         Pack;
+
+    Pack_Init(&Pack, *MsgPtr, *MsgSzPtr, false);
+    if (!SBN_LatUnpackUs(&Pack, &SentUs))
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    *MsgPtr = (uint8 *)*MsgPtr + SBN_STAMP_HDR_SZ;
+    *MsgSzPtr -= SBN_STAMP_HDR_SZ;
+
+    if (!Peer->LatSync.Valid)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    /* the send time on my clock is the peer's less the offset */
+    LatUs = SBN_LatNowUs() - (SentUs - Peer->LatSync.OffsetUs);
+    Us    = LatUs < 0 ? 0 : LatUs > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32)LatUs;
+
+    SBN_LatHistAdd(&Peer->LatHist, Us);
+
+    if (CFE_MSG_GetMsgId(*MsgPtr, &MsgID) != CFE_SUCCESS)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    for (i = 0; i < SBN_LAT_MAX_MIDS; i++)
+    {
+        if (SBN.LatMids[i].InUse && CFE_SB_MsgId_Equal(SBN.LatMids[i].MsgID, MsgID))
+        {
+            SBN_LatHistAdd(&SBN.LatMids[i].Hist, Us);
+        } /* end if */
+    }     /* end for */
+
+    return SBN_SUCCESS;
+} /* end SBN_LatRecvStamp() */
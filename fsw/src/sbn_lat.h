@@ -0,0 +1,99 @@
+/******************************************************************************
+** File: sbn_lat.h
+**
+** Purpose:
+**      This header file contains prototypes for the functions that stamp app
+**      messages with their send time, estimate peers' clocks from
+**      SBN_TIME_MSG exchanges, and keep one-way latency histograms.
+**
+******************************************************************************/
+
+#ifndef _sbn_lat_h_
+#define _sbn_lat_h_
+
+#include "sbn_app.h"
+#include "sbn_pack.h"
+
+/** @brief The local OS clock, in microseconds. */
+int64 SBN_LatNowUs(void);
+
+/** @brief Packs a time as it goes on the wire, SBN_STAMP_HDR_SZ bytes. */
+bool SBN_LatPackUs(Pack_t *Pack, int64 Us);
+
+/** @brief Unpacks a time packed by SBN_LatPackUs. */
+bool SBN_LatUnpackUs(Pack_t *Pack, int64 *UsPtr);
+
+/** @brief Counts a value, in microseconds. */
+void SBN_LatHistAdd(SBN_LatHist_t *Hist, uint32 Us);
+
+/**
+ * Finds a percentile of the values counted.
+ *
+ * @param Hist[in] The histogram.
+ * @param Pct[in] The percentile, 1 to 100.
+ *
+ * @return The upper bound of the bucket holding the percentile (no more than
+ *         the largest value), 0 if none are counted.
+ */
+uint32 SBN_LatHistPercentile(const SBN_LatHist_t *Hist, uint8 Pct);
+
+/**
+ * Takes in a clock exchange and updates the estimate of the peer's clock.
+ *
+ * @param Sync[in/out] The peer's clock state.
+ * @param T1[in] When I sent the message the peer echoed (my clock.)
+ * @param T2[in] When the peer received it (its clock.)
+ * @param T3[in] When the peer sent its reply (its clock.)
+ * @param T4[in] When I received the reply (my clock.)
+ */
+void SBN_LatSyncSample(SBN_LatSync_t *Sync, int64 T1, int64 T2, int64 T3, int64 T4);
+
+/** @brief Sends an SBN_TIME_MSG to each connected peer that is due one. */
+void SBN_LatSyncPeers(void);
+
+/**
+ * Takes in an SBN_TIME_MSG from a peer.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if the message is too short.
+ */
+SBN_Status_t SBN_LatRecvSync(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg);
+
+/**
+ * Takes the send time off a stamped app message from a peer and counts its
+ * latency, once the peer's clock is known, for the peer and its MsgID.
+ *
+ * @param Peer[in/out] The peer the message is from.
+ * @param MsgSzPtr[in/out] The size of the payload, then of the app message.
+ * @param MsgPtr[in/out] The payload, then the app message.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if the payload is too short.
+ */
+SBN_Status_t SBN_LatRecvStamp(SBN_PeerInterface_t *Peer, SBN_MsgSz_t *MsgSzPtr, void **MsgPtr);
+
+/**
+ * Starts a run of probes to a peer by sending the first.
+ *
+ * @param NetIdx[in] The peer's net.
+ * @param PeerIdx[in] The peer's index in the net.
+ * @param Cnt[in] The probes to send, 1 to SBN_PROBE_MAX_CNT.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if a run is in progress or the send
+ *         mutex, which guards the run, cannot be taken.
+ */
+SBN_Status_t SBN_LatProbeStart(SBN_NetIdx_t NetIdx, SBN_PeerIdx_t PeerIdx, uint8 Cnt);
+
+/**
+ * Gives up on a probe that has waited SBN_PROBE_TIMEOUT_MS for its echo,
+ * sending the next, and once the run is over sends its telemetry.
+ */
+void SBN_LatProbePoll(void);
+
+/**
+ * Takes in an SBN_PROBE_ECHO_MSG from a peer, and sends the next probe.
+ * Called by receive tasks, so it takes the send mutex.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if the message is too short.
+ */
+SBN_Status_t SBN_LatRecvProbeEcho(SBN_PeerInterface_t *Peer, SBN_MsgSz_t MsgSz, void *Msg);
+
+#endif /* _sbn_lat_h_ */
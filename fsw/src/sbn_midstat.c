@@ -0,0 +1,274 @@
+/******************************************************************************
+ ** \file sbn_midstat.c
+ **
+ ** Purpose:
+ **      This file contains source code for the Software Bus Network
+ **      Application's traffic by message ID: for each peer, sent and
+ **      received, exact counts of the message IDs set by command and a
+ **      count-min sketch, with its heaviest, of the rest.
+ */
+
+#include "sbn_midstat.h"
+
+/**
+ * Hashes a message ID to one of 2^Bits slots, by multiplying with an odd
+ * constant (a different one for each row of the sketch) and taking the top
+ * bits.
+ */
+static uint32 Hash(CFE_SB_MsgId_t MsgID, uint32 Row, uint8 Bits)
+{
+    return ((uint32)CFE_SB_MsgIdToValue(MsgID) * (0x9E3779B1u * (2 * Row + 1))) >> (32 - Bits);
+} /* end Hash() */
+
+/** @brief The slot in SBN.MidStatMids of a message ID, -1 if it is not counted exactly. */
+static int FindMid(CFE_SB_MsgId_t MsgID)
+{
+    uint32 Slot = Hash(MsgID, 0, SBN_MIDSTAT_MID_BITS), i = 0;
+
+    for (i = 0; i < SBN_MIDSTAT_MIDS; i++, Slot = (Slot + 1) % SBN_MIDSTAT_MIDS)
+    {
+        if (SBN.MidStatMids[Slot].State == SBN_MIDSTAT_FREE)
+        {
+            break;
+        } /* end if */
+
+        if (SBN.MidStatMids[Slot].State == SBN_MIDSTAT_USED && CFE_SB_MsgId_Equal(SBN.MidStatMids[Slot].MsgID, MsgID))
+        {
+            return Slot;
+        } /* end if */
+    }     /* end for */
+
+    return -1;
+} /* end FindMid() */
+
+static uint64 Key(const SBN_MidCnt_t *Cnt, bool ByBytes)
+{
+    return ByBytes ? Cnt->Bytes : Cnt->MsgCnt;
+} /* end Key() */
+
+/**
+ * Updates the estimate of a message ID in a list of the heaviest, or puts it
+ * in place of the lightest if it is heavier (or the list has room.)
+ */
+static void TopAdd(SBN_MidCnt_t *Top, bool ByBytes, const SBN_MidCnt_t *Est)
+{
+    int i = 0, Min = 0;
+
+    for (i = 0; i < SBN_MIDSTAT_TOP_CNT; i++)
+    {
+        if (Top[i].MsgCnt && CFE_SB_MsgId_Equal(Top[i].MsgID, Est->MsgID))
+        {
+            Top[i] = *Est;
+            return;
+        } /* end if */
+
+        if (Key(&Top[i], ByBytes) < Key(&Top[Min], ByBytes))
+        {
+            Min = i;
+        } /* end if */
+    }     /* end for */
+
+    if (!Top[Min].MsgCnt || Key(Est, ByBytes) > Key(&Top[Min], ByBytes))
+    {
+        Top[Min] = *Est;
+    } /* end if */
+} /* end TopAdd() */
+
+/**
+ * Called by the send and receive tasks too, unlocked; each peer's SendMids
+ * is only counted by whatever sends to it and RecvMids by whatever receives
+ * from it, and a report read as they are counted is off by a message.
+ */
+void SBN_MidStatCount(SBN_MidStats_t *Stats, CFE_SB_MsgId_t MsgID, uint32 Bytes)
+{
+    SBN_MidCnt_t Est;
+    int          Slot = FindMid(MsgID);
+    uint32       Row  = 0, Col = 0;
+
+    if (Slot >= 0)
+    {
+        Stats->MidMsgCnts[Slot]++;
+        Stats->MidBytes[Slot] += Bytes;
+        return;
+    } /* end if */
+
+    memset(&Est, 0, sizeof(Est));
+    Est.MsgID = MsgID;
+
+    for (Row = 0; Row < SBN_MIDSTAT_SKETCH_ROWS; Row++)
+    {
+        Col = Hash(MsgID, Row, SBN_MIDSTAT_SKETCH_BITS);
+
+        Stats->SketchMsgCnts[Row][Col]++;
+        Stats->SketchBytes[Row][Col] += Bytes;
+
+        if (Row == 0 || Stats->SketchMsgCnts[Row][Col] < Est.MsgCnt)
+        {
+            Est.MsgCnt = Stats->SketchMsgCnts[Row][Col];
+        } /* end if */
+
+        if (Row == 0 || Stats->SketchBytes[Row][Col] < Est.Bytes)
+        {
+            Est.Bytes = Stats->SketchBytes[Row][Col];
+        } /* end if */
+    }     /* end for */
+
+    TopAdd(Stats->TopBytes, true, &Est);
+    TopAdd(Stats->TopMsgs, false, &Est);
+} /* end SBN_MidStatCount() */
+
+void SBN_MidStatMsg(SBN_MidStats_t *Stats, void *Msg, SBN_MsgSz_t MsgSz)
+{
+    CFE_SB_MsgId_t MsgID = CFE_SB_INVALID_MSG_ID;
+
+    CFE_MSG_GetMsgId(Msg, &MsgID);
+
+    SBN_MidStatCount(Stats, MsgID, MsgSz);
+} /* end SBN_MidStatMsg() */
+
+/** @brief Empties a slot, and takes its message ID out of the sketches' heaviest, for each peer. */
+static void ClearMid(int Slot, CFE_SB_MsgId_t MsgID)
+{
+    SBN_NetIdx_t  NetIdx  = 0;
+    SBN_PeerIdx_t PeerIdx = 0;
+    int           i       = 0;
+
+    for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
+    {
+        for (PeerIdx = 0; PeerIdx < SBN.Nets[NetIdx].PeerCnt; PeerIdx++)
+        {
+            SBN_MidStats_t *Dirs[2] = {&SBN.Nets[NetIdx].Peers[PeerIdx].SendMids,
+                                       &SBN.Nets[NetIdx].Peers[PeerIdx].RecvMids};
+            SBN_MidStats_t *Stats   = NULL;
+            int             Dir     = 0;
+
+            for (Dir = 0; Dir < 2; Dir++)
+            {
+                Stats = Dirs[Dir];
+
+                Stats->MidMsgCnts[Slot] = 0;
+                Stats->MidBytes[Slot]   = 0;
+
+                for (i = 0; i < SBN_MIDSTAT_TOP_CNT; i++)
+                {
+                    if (Stats->TopBytes[i].MsgCnt && CFE_SB_MsgId_Equal(Stats->TopBytes[i].MsgID, MsgID))
+                    {
+                        memset(&Stats->TopBytes[i], 0, sizeof(Stats->TopBytes[i]));
+                    } /* end if */
+
+                    if (Stats->TopMsgs[i].MsgCnt && CFE_SB_MsgId_Equal(Stats->TopMsgs[i].MsgID, MsgID))
+                    {
+                        memset(&Stats->TopMsgs[i], 0, sizeof(Stats->TopMsgs[i]));
+                    } /* end if */
+                }     /* end for */
+            }         /* end for */
+        }             /* end for */
+    }                 /* end for */
+} /* end ClearMid() */
+
+SBN_Status_t SBN_MidStatSetMid(CFE_SB_MsgId_t MsgID, bool Counted)
+{
+    int    Slot = FindMid(MsgID);
+    uint32 i    = 0;
+
+    if (!Counted)
+    {
+        if (Slot < 0)
+        {
+            return SBN_ERROR;
+        } /* end if */
+
+        SBN.MidStatMids[Slot].State = SBN_MIDSTAT_REMOVED;
+
+        /* a removed slot before a free one ends no probe, so it is free too */
+        while (SBN.MidStatMids[Slot].State == SBN_MIDSTAT_REMOVED &&
+               SBN.MidStatMids[(Slot + 1) % SBN_MIDSTAT_MIDS].State == SBN_MIDSTAT_FREE)
+        {
+            SBN.MidStatMids[Slot].State = SBN_MIDSTAT_FREE;
+            Slot                        = (Slot + SBN_MIDSTAT_MIDS - 1) % SBN_MIDSTAT_MIDS;
+        } /* end while */
+
+        return SBN_SUCCESS;
+    } /* end if */
+
+    if (Slot >= 0)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    Slot = Hash(MsgID, 0, SBN_MIDSTAT_MID_BITS);
+
+    for (i = 0; i < SBN_MIDSTAT_MIDS; i++, Slot = (Slot + 1) % SBN_MIDSTAT_MIDS)
+    {
+        if (SBN.MidStatMids[Slot].State != SBN_MIDSTAT_USED)
+        {
+            SBN.MidStatMids[Slot].State = SBN_MIDSTAT_USED;
+            SBN.MidStatMids[Slot].MsgID = MsgID;
+
+            ClearMid(Slot, MsgID);
+
+            return SBN_SUCCESS;
+        } /* end if */
+    }     /* end for */
+
+    return SBN_ERROR;
+} /* end SBN_MidStatSetMid() */
+
+uint8 SBN_MidStatTop(const SBN_MidStats_t *Stats, bool ByBytes, SBN_MidCnt_t *Top, uint8 TopCnt)
+{
+    SBN_MidCnt_t        Cands[SBN_MIDSTAT_MIDS + SBN_MIDSTAT_TOP_CNT * 2], Swap;
+    const SBN_MidCnt_t *Lists[2] = {Stats->TopBytes, Stats->TopMsgs};
+    int                 CandCnt = 0, Cnt = 0, Slot = 0, List = 0, i = 0, j = 0, Max = 0;
+
+    for (Slot = 0; Slot < SBN_MIDSTAT_MIDS; Slot++)
+    {
+        if (SBN.MidStatMids[Slot].State == SBN_MIDSTAT_USED && Stats->MidMsgCnts[Slot])
+        {
+            Cands[CandCnt].MsgID  = SBN.MidStatMids[Slot].MsgID;
+            Cands[CandCnt].MsgCnt = Stats->MidMsgCnts[Slot];
+            Cands[CandCnt].Bytes  = Stats->MidBytes[Slot];
+            Cands[CandCnt].Exact  = true;
+            CandCnt++;
+        } /* end if */
+    }     /* end for */
+
+    /* an ID heavy both ways is in both lists, with the same estimate */
+    for (List = 0; List < 2; List++)
+    {
+        for (i = 0; i < SBN_MIDSTAT_TOP_CNT; i++)
+        {
+            if (!Lists[List][i].MsgCnt)
+            {
+                continue;
+            } /* end if */
+
+            for (j = 0; j < CandCnt && !CFE_SB_MsgId_Equal(Cands[j].MsgID, Lists[List][i].MsgID); j++)
+                ;
+
+            if (j == CandCnt)
+            {
+                Cands[CandCnt]       = Lists[List][i];
+                Cands[CandCnt].Exact = false;
+                CandCnt++;
+            } /* end if */
+        }     /* end for */
+    }         /* end for */
+
+    for (Cnt = 0; Cnt < TopCnt && Cnt < CandCnt; Cnt++)
+    {
+        for (Max = Cnt, i = Cnt + 1; i < CandCnt; i++)
+        {
+            if (Key(&Cands[i], ByBytes) > Key(&Cands[Max], ByBytes))
+            {
+                Max = i;
+            } /* end if */
+        }     /* end for */
+
+        Swap       = Cands[Cnt];
+        Cands[Cnt] = Cands[Max];
+        Cands[Max] = Swap;
+        Top[Cnt]   = Cands[Cnt];
+    } /* end for */
+
+    return Cnt;
+} /* end SBN_MidStatTop() */
@@ -0,0 +1,53 @@
+/******************************************************************************
+** File: sbn_midstat.h
+**
+** Purpose:
+**      This header file contains prototypes for the functions that count the
+**      traffic to and from each peer by message ID and find the heaviest.
+**
+******************************************************************************/
+
+#ifndef _sbn_midstat_h_
+#define _sbn_midstat_h_
+
+#include "sbn_app.h"
+
+/**
+ * Counts an app message, in the slot of its message ID if that is counted
+ * exactly, otherwise in the sketch.
+ *
+ * @param Stats[in/out] The peer's SendMids or RecvMids.
+ * @param MsgID[in] The message's ID.
+ * @param Bytes[in] The message's size.
+ */
+void SBN_MidStatCount(SBN_MidStats_t *Stats, CFE_SB_MsgId_t MsgID, uint32 Bytes);
+
+/** @brief Counts a (CCSDS) message, see SBN_MidStatCount. */
+void SBN_MidStatMsg(SBN_MidStats_t *Stats, void *Msg, SBN_MsgSz_t MsgSz);
+
+/**
+ * Starts or stops counting a message ID exactly, emptying its slot for all
+ * peers.
+ *
+ * @param MsgID[in] The message ID.
+ * @param Counted[in] True to start counting it, false to stop.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if there is no free slot to start or the
+ *         ID is not counted to stop.
+ */
+SBN_Status_t SBN_MidStatSetMid(CFE_SB_MsgId_t MsgID, bool Counted);
+
+/**
+ * Finds the heaviest message IDs, of those counted exactly and those kept
+ * from the sketch.
+ *
+ * @param Stats[in] The peer's SendMids or RecvMids.
+ * @param ByBytes[in] True for the most bytes, false for the most messages.
+ * @param Top[out] The message IDs, heaviest first.
+ * @param TopCnt[in] The most to find.
+ *
+ * @return The number found, up to TopCnt.
+ */
+uint8 SBN_MidStatTop(const SBN_MidStats_t *Stats, bool ByBytes, SBN_MidCnt_t *Top, uint8 TopCnt);
+
+#endif /* _sbn_midstat_h_ */
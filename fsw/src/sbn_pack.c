@@ -50,6 +50,13 @@ bool Pack_UInt32(Pack_t *PackPtr, uint32 Data)
     return Pack_Data(PackPtr, &D, sizeof(D));
 } /* end Pack_UInt32() */
 
+bool Pack_UInt64(Pack_t *PackPtr, uint64 Data)
+{
+    /* there's no CFE_MAKE_BIG64, so the high word, then the low */
+    uint32 D[2] = {CFE_MAKE_BIG32((uint32)(Data >> 32)), CFE_MAKE_BIG32((uint32)Data)};
+    return Pack_Data(PackPtr, D, sizeof(D));
+} /* end Pack_UInt64() */
+
 bool Pack_Time(Pack_t *PackPtr, OS_time_t Data)
 {
     OS_time_t D;
@@ -118,6 +125,17 @@ bool Unpack_UInt32(Pack_t *Pack, uint32 *DataBuf)
     return true;
 } /* end Unpack_UInt32() */
 
+bool Unpack_UInt64(Pack_t *Pack, uint64 *DataBuf)
+{
+    uint32 D[2];
+    if (!Unpack_Data(Pack, D, sizeof(D)))
+    {
+        return false;
+    }
+    *DataBuf = ((uint64)CFE_MAKE_BIG32(D[0]) << 32) | CFE_MAKE_BIG32(D[1]);
+    return true;
+} /* end Unpack_UInt64() */
+
 bool Unpack_MsgID(Pack_t *Pack, CFE_SB_MsgId_t *DataBuf)
 {
     uint32 D;
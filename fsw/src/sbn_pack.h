@@ -119,6 +119,19 @@ bool Pack_Int16(Pack_t *PackPtr, int16 Data);
  */
 bool Pack_UInt32(Pack_t *PackPtr, uint32 Data);
 
+/**
+ * Pack an unsigned 64-bit integer into the buffer.
+ *
+ * @param PackPtr[in/out] The pointer to the management structure.
+ * @param Data[in] The value to pack.
+ *
+ * @return true if the data was successfully packed into the buffer, false if
+ *         it failed (likely due to running out of available space in the buffer.)
+ *
+ * @sa #Pack_Data
+ */
+bool Pack_UInt64(Pack_t *PackPtr, uint64 Data);
+
 /**
  * Pack a time datum into the buffer.
  *
@@ -212,6 +225,19 @@ bool Unpack_Int16(Pack_t *PackPtr, int16 *DataBuf);
  */
 bool Unpack_UInt32(Pack_t *PackPtr, uint32 *DataBuf);
 
+/**
+ * Unpack an unsigned 64-bit integer from the pack buffer.
+ *
+ * @param PackPtr[in/out] The pointer to the management structure.
+ * @param DataBuf[out] The pointer to where the data should be stored.
+ *
+ * @return true if the data was successfully read from the buffer, false if
+ *         it failed (likely due to no more data in the buffer.)
+ *
+ * @sa #Unpack_Data
+ */
+bool Unpack_UInt64(Pack_t *PackPtr, uint64 *DataBuf);
+
 /**
  * Unpack a CFE software bus message identifier from the pack buffer.
  *
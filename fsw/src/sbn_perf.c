@@ -0,0 +1,56 @@
+/******************************************************************************
+ ** \file sbn_perf.c
+ **
+ ** Purpose:
+ **      This file contains source code for the Software Bus Network
+ **      Application's stage timing: perf log markers and the time spent in
+ **      each stage and each wakeup.
+ */
+
+#include "sbn_perf.h"
+#include "sbn_lat.h"
+
+static const uint32 StagePerfIDs[SBN_STAGE_CNT] = {
+    SBN_PERF_NET_RECV_ID, SBN_PERF_SUB_PIPE_ID, SBN_PERF_PEER_PIPES_ID, SBN_PERF_FILTER_ID,
+    SBN_PERF_MOD_SEND_ID, SBN_PERF_POLL_PEER_ID, SBN_PERF_SEND_TASK_ID, SBN_PERF_RECV_TASK_ID};
+
+/**
+ * Counts a time spent. Stages run in the tasks too, unlocked, so a count may
+ * now and then be lost to a race; they are statistics, not accounts.
+ */
+static uint32 CountTime(SBN_StageStats_t *Stats, int64 EntryUs)
+{
+    int64  Us     = SBN_LatNowUs() - EntryUs;
+    uint32 TimeUs = Us < 0 ? 0 : Us > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32)Us;
+
+    Stats->Cnt++;
+    Stats->TotalUs += TimeUs;
+    if (TimeUs > Stats->MaxUs)
+    {
+        Stats->MaxUs = TimeUs;
+    } /* end if */
+
+    return TimeUs;
+} /* end CountTime() */
+
+int64 SBN_PerfEntry(SBN_Stage_t Stage)
+{
+    CFE_ES_PerfLogEntry(StagePerfIDs[Stage]);
+
+    return SBN_LatNowUs();
+} /* end SBN_PerfEntry() */
+
+void SBN_PerfExit(SBN_Stage_t Stage, int64 EntryUs)
+{
+    CountTime(&SBN.Stages[Stage], EntryUs);
+
+    CFE_ES_PerfLogExit(StagePerfIDs[Stage]);
+} /* end SBN_PerfExit() */
+
+void SBN_PerfWakeup(int64 EntryUs)
+{
+    if (CountTime(&SBN.Wakeups, EntryUs) > SBN_WAKEUP_SLOT_US)
+    {
+        SBN.WakeupOverrunCnt++;
+    } /* end if */
+} /* end SBN_PerfWakeup() */
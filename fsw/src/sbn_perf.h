@@ -0,0 +1,40 @@
+/******************************************************************************
+** File: sbn_perf.h
+**
+** Purpose:
+**      This header file contains prototypes for the functions that mark the
+**      stages of SBN's work in the perf log and keep the time spent in each.
+**
+******************************************************************************/
+
+#ifndef _sbn_perf_h_
+#define _sbn_perf_h_
+
+#include "sbn_app.h"
+
+/**
+ * Marks the entry to a stage in the perf log.
+ *
+ * @param Stage[in] The stage.
+ *
+ * @return The time of entry, to pass to SBN_PerfExit.
+ */
+int64 SBN_PerfEntry(SBN_Stage_t Stage);
+
+/**
+ * Marks the exit from a stage in the perf log and counts the time spent in it.
+ *
+ * @param Stage[in] The stage.
+ * @param EntryUs[in] The time of entry, from SBN_PerfEntry.
+ */
+void SBN_PerfExit(SBN_Stage_t Stage, int64 EntryUs);
+
+/**
+ * Counts the time spent in a wakeup, and an overrun if that is more than
+ * SBN_WAKEUP_SLOT_US.
+ *
+ * @param EntryUs[in] When the wakeup's work started.
+ */
+void SBN_PerfWakeup(int64 EntryUs);
+
+#endif /* _sbn_perf_h_ */
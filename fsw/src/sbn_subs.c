@@ -81,6 +81,33 @@ static SBN_Status_t SendLocalSubToPeer(int SubType, CFE_SB_MsgId_t MsgID, CFE_SB
     return SBN_SendNetMsg(SubType, Pack.BufUsed, Buf, Peer);
 } /* end SendLocalSubToPeer */
 
+/**
+ * \brief Takes SBN.SubsMutex, which guards the local subscriptions and the
+ * nets' indexes of subscriptions, as receive and send tasks read them while
+ * the main task (or a receive task) changes them.
+ *
+ * @return true if taken.
+ */
+static bool LockSubs(void)
+{
+    if (OS_MutSemTake(SBN.SubsMutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_SUB_EID, "unable to take subs mutex");
+        return false;
+    } /* end if */
+
+    return true;
+} /* end LockSubs */
+
+/** \brief Gives SBN.SubsMutex, see LockSubs. */
+static void UnlockSubs(void)
+{
+    if (OS_MutSemGive(SBN.SubsMutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_SUB_EID, "unable to give subs mutex");
+    } /* end if */
+} /* end UnlockSubs */
+
 /**
  * \brief Sends all local subscriptions over the wire to a peer.
  *
@@ -92,6 +119,13 @@ SBN_Status_t SBN_SendLocalSubsToPeer(SBN_PeerInterface_t *Peer)
     Pack_t Pack;
     Pack_Init(&Pack, &Buf, SBN_PACKED_SUB_SZ, 0);
     Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+
+    /* a peer connects from its receive task, as local subscriptions change */
+    if (!LockSubs())
+    {
+        return SBN_ERROR;
+    } /* end if */
+
     Pack_UInt16(&Pack, SBN.SubCnt);
 
     int i = 0;
@@ -102,6 +136,8 @@ SBN_Status_t SBN_SendLocalSubsToPeer(SBN_PeerInterface_t *Peer)
         Pack_Data(&Pack, &SBN.Subs[i].QoS, sizeof(SBN.Subs[i].QoS));
     } /* end for */
 
+    UnlockSubs();
+
     EVSSendDbg(SBN_PEER_EID, "send local subs to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
     return SBN_SendNetMsg(SBN_SUB_MSG, Pack.BufUsed, Buf, Peer);
 } /* end SBN_SendLocalSubsToPeer */
@@ -134,6 +170,31 @@ static int IsMsgIDSub(int *IdxPtr, CFE_SB_MsgId_t MsgID)
     return false;
 } /* end IsMsgIDSub */
 
+/**
+ * \brief Is a local app subscribed to this message ID (and so are peers told
+ * of it)? A message a peer sends to a multicast group reaches every node in
+ * the group, whether or not it subscribed, so modules with group nets ask
+ * (through the outlet) from their receive tasks.
+ *
+ * @param[in] MsgID The CCSDS message ID.
+ * @return true if subscribed.
+ */
+bool SBN_IsLocalSub(CFE_SB_MsgId_t MsgID)
+{
+    bool Found = false;
+
+    if (!LockSubs())
+    {
+        return true; /* deliver, rather than drop, what cannot be checked */
+    } /* end if */
+
+    Found = IsMsgIDSub(NULL, MsgID);
+
+    UnlockSubs();
+
+    return Found;
+} /* end SBN_IsLocalSub */
+
 /**
  * \brief Is this peer subscribed to this message ID? If so, what is the index
  *        of the subscription?
@@ -161,6 +222,192 @@ static int IsPeerSubMsgID(int *SubIdxPtr, CFE_SB_MsgId_t MsgID, SBN_PeerInterfac
 
 } /* end IsPeerSubMsgID */
 
+/**
+ * \brief Where is, or would be, this message ID in the (sorted) subscription
+ *        table of a net with a shared pipe?
+ *
+ * @param[in] Net The net interface.
+ * @param[in] MsgID The CCSDS message ID of the subscription being sought.
+ * @param[out] FoundPtr Set true if the message ID is in the table.
+ *
+ * @return The index of the subscription, or of where to insert it.
+ */
+static int FindNetSub(SBN_NetInterface_t *Net, CFE_SB_MsgId_t MsgID, bool *FoundPtr)
+{
+    CFE_SB_MsgId_Atom_t Val = CFE_SB_MsgIdToValue(MsgID);
+    int                 Lo = 0, Hi = Net->SubCnt;
+
+    while (Lo < Hi)
+    {
+        int Mid = (Lo + Hi) / 2;
+
+        if (CFE_SB_MsgIdToValue(Net->Subs[Mid].MsgID) < Val)
+        {
+            Lo = Mid + 1;
+        }
+        else
+        {
+            Hi = Mid;
+        } /* end if */
+    }     /* end while */
+
+    *FoundPtr = Lo < Net->SubCnt && CFE_SB_MsgId_Equal(Net->Subs[Lo].MsgID, MsgID);
+
+    return Lo;
+} /* end FindNetSub */
+
+/**
+ * \brief Which peers of a net with a shared pipe are subscribed to this
+ *        message ID?
+ *
+ * @param[in] Net The net interface.
+ * @param[in] MsgID The CCSDS message ID.
+ *
+ * @return A bit for each subscribed peer, by index into Net->Peers.
+ */
+SBN_PeerMask_t SBN_GetNetSubPeers(SBN_NetInterface_t *Net, CFE_SB_MsgId_t MsgID)
+{
+    SBN_PeerMask_t Peers = 0;
+    bool           Found = false;
+    int            idx   = 0;
+
+    if (!LockSubs())
+    {
+        return 0;
+    } /* end if */
+
+    idx = FindNetSub(Net, MsgID, &Found);
+    if (Found)
+    {
+        Peers = Net->Subs[idx].Peers;
+    } /* end if */
+
+    UnlockSubs();
+
+    return Peers;
+} /* end SBN_GetNetSubPeers */
+
+/**
+ * \brief Subscribe a pipe to a message ID, without a subscription report.
+ *
+ * @param[in] MsgID The CCSDS message ID.
+ * @param[in] Pipe The pipe.
+ *
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR
+ */
+static SBN_Status_t SubscribePipe(CFE_SB_MsgId_t MsgID, CFE_SB_PipeId_t Pipe)
+{
+    /* SubscribeLocal suppresses the subscription report */
+    if (CFE_SB_SubscribeLocal(MsgID, Pipe, SBN_DEFAULT_MSG_LIM) != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_SUB_EID, "unable to subscribe to MID 0x%04X",
+            CFE_SB_MsgIdToValue(MsgID));
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end SubscribePipe */
+
+/**
+ * \brief Subscribe the pipe that reads messages for this peer to a message
+ *        ID. For a net with a shared pipe, only the first peer to subscribe
+ *        to the ID subscribes the pipe, the others are added to the ID's peers.
+ *
+ * The net's index of subscriptions is changed under SBN.SubsMutex, as the
+ * receive tasks subscribe peers while the net's send task looks them up.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The CCSDS message ID.
+ *
+ * @return SBN_SUCCESS on success, otherwise SBN_ERROR
+ */
+static SBN_Status_t SubscribePeerPipe(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID)
+{
+    SBN_NetInterface_t *Net        = Peer->Net;
+    SBN_Status_t        SBN_Status = SBN_SUCCESS;
+    bool                Found      = false;
+    int                 idx        = 0;
+
+    if (!(Net->NetFlags & SBN_NET_SHARED_PIPE))
+    {
+        return SubscribePipe(MsgID, Peer->Pipe);
+    } /* end if */
+
+    if (!LockSubs())
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    idx = FindNetSub(Net, MsgID, &Found);
+    if (Found)
+    {
+        Net->Subs[idx].Peers |= (SBN_PeerMask_t)1 << (Peer - Net->Peers);
+    }
+    else if (Net->SubCnt >= SBN_MAX_SUBS_PER_NET)
+    {
+        EVSSendErr(SBN_SUB_EID, "cannot process subscription from ProcessorID %d, max (%d) for the net met",
+            Peer->ProcessorID, SBN_MAX_SUBS_PER_NET);
+        SBN_Status = SBN_ERROR;
+    }
+    else if ((SBN_Status = SubscribePipe(MsgID, Net->Pipe)) == SBN_SUCCESS)
+    {
+        memmove(&Net->Subs[idx + 1], &Net->Subs[idx], (Net->SubCnt - idx) * sizeof(SBN_NetSub_t));
+        Net->Subs[idx].MsgID = MsgID;
+        Net->Subs[idx].Peers = (SBN_PeerMask_t)1 << (Peer - Net->Peers);
+        Net->SubCnt++;
+    } /* end if */
+
+    UnlockSubs();
+
+    return SBN_Status;
+} /* end SubscribePeerPipe */
+
+/**
+ * \brief Unsubscribe the pipe that reads messages for this peer from a
+ *        message ID. For a net with a shared pipe, the pipe is unsubscribed
+ *        when the last of the net's peers subscribed to the ID is removed.
+ *
+ * @param[in] Peer The peer interface.
+ * @param[in] MsgID The CCSDS message ID.
+ *
+ * @return The status of CFE_SB_UnsubscribeLocal, CFE_SUCCESS if it was not needed.
+ */
+static CFE_Status_t UnsubscribePeerPipe(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID)
+{
+    SBN_NetInterface_t *Net        = Peer->Net;
+    CFE_Status_t        CFE_Status = CFE_SUCCESS;
+    bool                Found      = false;
+    int                 idx        = 0;
+
+    if (!(Net->NetFlags & SBN_NET_SHARED_PIPE))
+    {
+        return CFE_SB_UnsubscribeLocal(MsgID, Peer->Pipe);
+    } /* end if */
+
+    if (!LockSubs())
+    {
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    } /* end if */
+
+    idx = FindNetSub(Net, MsgID, &Found);
+    if (Found)
+    {
+        Net->Subs[idx].Peers &= ~((SBN_PeerMask_t)1 << (Peer - Net->Peers));
+    } /* end if */
+
+    if (Found && !Net->Subs[idx].Peers)
+    {
+        Net->SubCnt--;
+        memmove(&Net->Subs[idx], &Net->Subs[idx + 1], (Net->SubCnt - idx) * sizeof(SBN_NetSub_t));
+
+        CFE_Status = CFE_SB_UnsubscribeLocal(MsgID, Net->Pipe);
+    } /* end if */
+
+    UnlockSubs();
+
+    return CFE_Status;
+} /* end UnsubscribePeerPipe */
+
 /**
  * \brief I have seen a local subscription, send it on to peers if this is the
  * first instance of a subscription for this message ID.
@@ -198,12 +445,19 @@ static SBN_Status_t ProcessLocalSub(CFE_SB_MsgId_t MsgID, CFE_SB_Qos_t QoS)
         return SBN_ERROR;
     } /* end if */
 
+    if (!LockSubs())
+    {
+        return SBN_ERROR;
+    } /* end if */
+
     /* log new entry into Subs array */
     SBN.Subs[SBN.SubCnt].InUseCtr = 1;
     SBN.Subs[SBN.SubCnt].MsgID    = MsgID;
     SBN.Subs[SBN.SubCnt].QoS      = QoS;
     SBN.SubCnt++;
 
+    UnlockSubs();
+
     int NetIdx = 0, PeerIdx = 0;
     for (NetIdx = 0; NetIdx < SBN.NetCnt; NetIdx++)
     {
@@ -259,6 +513,11 @@ static SBN_Status_t ProcessLocalUnsub(CFE_SB_MsgId_t MsgID)
     ** note that the Subs[] array has one extra element to allow for an
     ** unsub from a full table.
     */
+    if (!LockSubs())
+    {
+        return SBN_ERROR;
+    } /* end if */
+
     for (; SubIdx < SBN.SubCnt; SubIdx++)
     {
         memcpy(&SBN.Subs[SubIdx], &SBN.Subs[SubIdx + 1], sizeof(SBN_Subs_t));
@@ -266,6 +525,8 @@ static SBN_Status_t ProcessLocalUnsub(CFE_SB_MsgId_t MsgID)
 
     SBN.SubCnt--;
 
+    UnlockSubs();
+
     /* send unsubscription to all peers if peer state is heartbeating and */
     /* only if no more local subs (InUseCtr = 0)  */
     int NetIdx = 0, PeerIdx = 0;
@@ -363,8 +624,7 @@ SBN_Status_t SBN_CheckSubscriptionPipe(void)
  */
 static SBN_Status_t AddSub(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_SB_Qos_t QoS)
 {
-    int          idx        = 0;
-    CFE_Status_t CFE_Status = SBN_SUCCESS;
+    int idx = 0;
 
     /* if msg id already in the list, ignore */
     if (IsPeerSubMsgID(&idx, MsgID, Peer))
@@ -379,12 +639,8 @@ static SBN_Status_t AddSub(SBN_PeerInterface_t *Peer, CFE_SB_MsgId_t MsgID, CFE_
         return SBN_ERROR;
     } /* end if */
 
-    /* SubscribeLocal suppresses the subscription report */
-    CFE_Status = CFE_SB_SubscribeLocal(MsgID, Peer->Pipe, SBN_DEFAULT_MSG_LIM);
-    if (CFE_Status != CFE_SUCCESS)
+    if (SubscribePeerPipe(Peer, MsgID) != SBN_SUCCESS)
     {
-        EVSSendErr(SBN_SUB_EID, "unable to subscribe to MID 0x%04X",
-            CFE_SB_MsgIdToValue(MsgID));
         return SBN_ERROR;
     } /* end if */
 
@@ -540,7 +796,7 @@ static SBN_Status_t ProcessUnsubFromPeer(SBN_PeerInterface_t *Peer, CFE_SB_MsgId
     Peer->SubCnt--;
 
     /* unsubscribe to the msg id on the peer pipe */
-    if ((CFE_Status = CFE_SB_UnsubscribeLocal(MsgID, Peer->Pipe)) != CFE_SUCCESS)
+    if ((CFE_Status = UnsubscribePeerPipe(Peer, MsgID)) != CFE_SUCCESS)
     {
         EVSSendErr(SBN_SUB_EID, "unable to unsubscribe from MID 0x%04X: %d",
             CFE_SB_MsgIdToValue(MsgID), CFE_Status);
@@ -641,7 +897,7 @@ SBN_Status_t SBN_RemoveAllSubsFromPeer(SBN_PeerInterface_t *Peer)
     for (i = 0; i < Peer->SubCnt; i++)
     {
         /** Ignore CFE_SB_BAD_ARGUMENT errors -- currently not checking if the pipe is valid before unsubscribing **/
-        CFE_Status = CFE_SB_UnsubscribeLocal(Peer->Subs[i].MsgID, Peer->Pipe);
+        CFE_Status = UnsubscribePeerPipe(Peer, Peer->Subs[i].MsgID);
         if (CFE_Status != CFE_SUCCESS && CFE_Status != CFE_SB_BAD_ARGUMENT)
         {
             EVSSendErr(SBN_SUB_EID, "unable to unsubscribe from message id 0x%04X: 0x%08X",
@@ -33,5 +33,7 @@ SBN_Status_t SBN_ProcessUnsubsFromPeer(SBN_PeerInterface_t *Peer, void *submsg);
 SBN_Status_t SBN_ProcessAllSubscriptions(CFE_SB_AllSubscriptionsTlm_t *Ptr);
 SBN_Status_t SBN_RemoveAllSubsFromPeer(SBN_PeerInterface_t *Peer);
 SBN_Status_t SBN_SendSubsRequests(void);
+bool         SBN_IsLocalSub(CFE_SB_MsgId_t MsgID);
+SBN_PeerMask_t SBN_GetNetSubPeers(SBN_NetInterface_t *Net, CFE_SB_MsgId_t MsgID);
 
 #endif /* _sbn_subs_h_ */
@@ -0,0 +1,121 @@
+/******************************************************************************
+ ** \file sbn_trace.c
+ **
+ ** Purpose:
+ **      This file contains source code for the Software Bus Network
+ **      Application's message trace: a ring of the points app messages pass
+ **      through, sending and receiving, and its dump to a file.
+ */
+
+#include "sbn_trace.h"
+#include "sbn_lat.h"
+#include "sbn_pack.h"
+
+/**
+ * Points are recorded by the tasks too, unlocked, so now and then two may
+ * take the same slot; the trace is for finding where the time goes, not an
+ * account of every message.
+ */
+void SBN_TraceRecord(SBN_TracePoint_t Point, int64 TimeUs, CFE_ProcessorID_t ProcessorID, CFE_SB_MsgId_t MsgID)
+{
+    SBN_TraceEntry_t *Entry = &SBN.Trace.Entries[SBN.Trace.Next++ % SBN_TRACE_DEPTH];
+
+    Entry->TimeUs      = TimeUs;
+    Entry->ProcessorID = ProcessorID;
+    Entry->MsgID       = MsgID;
+    Entry->Point       = Point;
+} /* end SBN_TraceRecord() */
+
+void SBN_TraceMsg(SBN_TracePoint_t Point, CFE_ProcessorID_t ProcessorID, void *Msg)
+{
+    CFE_SB_MsgId_t MsgID = CFE_SB_INVALID_MSG_ID;
+
+    CFE_MSG_GetMsgId(Msg, &MsgID);
+
+    SBN_TraceRecord(Point, SBN_LatNowUs(), ProcessorID, MsgID);
+} /* end SBN_TraceMsg() */
+
+void SBN_TraceNetMsg(SBN_TracePoint_t Point, int64 TimeUs, CFE_ProcessorID_t ProcessorID, SBN_MsgType_t MsgType,
+                     SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_MsgSz_t    TagSz = SBN_APP_HDR_SZ(MsgType);
+    CFE_SB_MsgId_t MsgID = CFE_SB_INVALID_MSG_ID;
+
+    if (!SBN_IS_APP_MSG(MsgType) || MsgSz < TagSz + (SBN_MsgSz_t)sizeof(CFE_MSG_Message_t))
+    {
+        return;
+    } /* end if */
+
+    CFE_MSG_GetMsgId((CFE_MSG_Message_t *)((uint8 *)Msg + TagSz), &MsgID);
+
+    SBN_TraceRecord(Point, TimeUs, ProcessorID, MsgID);
+} /* end SBN_TraceNetMsg() */
+
+void SBN_TraceStart(void)
+{
+    SBN.Trace.On   = false;
+    SBN.Trace.Next = 0;
+    memset(SBN.Trace.Entries, 0, sizeof(SBN.Trace.Entries));
+    SBN.Trace.On = true;
+} /* end SBN_TraceStart() */
+
+SBN_Status_t SBN_TraceDump(const char *FileName, uint32 *CntPtr)
+{
+    uint8             Buf[SBN_TRACE_REC_SZ * 32];
+    Pack_t            Pack;
+    osal_id_t         Fd     = OS_OBJECT_ID_UNDEFINED;
+    uint32            Cnt    = SBN.Trace.Next < SBN_TRACE_DEPTH ? SBN.Trace.Next : SBN_TRACE_DEPTH;
+    uint32            First  = SBN.Trace.Next - Cnt, i = 0;
+    SBN_Status_t      Status = SBN_SUCCESS;
+    SBN_TraceEntry_t *Entry  = NULL;
+
+    *CntPtr = 0;
+
+    if (OS_OpenCreate(&Fd, FileName, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY) != OS_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    Pack_UInt32(&Pack, SBN_TRACE_MAGIC);
+    Pack_UInt16(&Pack, SBN_TRACE_VER);
+    Pack_UInt16(&Pack, SBN_TRACE_REC_SZ);
+    Pack_UInt32(&Pack, CFE_PSP_GetProcessorId());
+    Pack_UInt32(&Pack, Cnt);
+    Pack_UInt32(&Pack, First);
+
+    for (i = 0; i < Cnt && Status == SBN_SUCCESS; i++)
+    {
+        Entry = &SBN.Trace.Entries[(First + i) % SBN_TRACE_DEPTH];
+
+        SBN_LatPackUs(&Pack, Entry->TimeUs);
+        Pack_UInt32(&Pack, Entry->ProcessorID);
+        Pack_MsgID(&Pack, Entry->MsgID);
+        Pack_UInt8(&Pack, Entry->Point);
+
+        /* write out whenever the buffer can't take another record */
+        if (Pack.BufUsed + SBN_TRACE_REC_SZ > sizeof(Buf))
+        {
+            if (OS_write(Fd, Buf, Pack.BufUsed) != (int32)Pack.BufUsed)
+            {
+                Status = SBN_ERROR;
+            } /* end if */
+
+            Pack_Init(&Pack, Buf, sizeof(Buf), true);
+        } /* end if */
+    } /* end for */
+
+    if (Status == SBN_SUCCESS && Pack.BufUsed && OS_write(Fd, Buf, Pack.BufUsed) != (int32)Pack.BufUsed)
+    {
+        Status = SBN_ERROR;
+    } /* end if */
+
+    OS_close(Fd);
+
+    if (Status == SBN_SUCCESS)
+    {
+        *CntPtr = Cnt;
+    } /* end if */
+
+    return Status;
+} /* end SBN_TraceDump() */
@@ -0,0 +1,73 @@
+/******************************************************************************
+** File: sbn_trace.h
+**
+** Purpose:
+**      This header file contains prototypes for the functions that record the
+**      points in the life of app messages in the trace ring and dump it.
+**
+******************************************************************************/
+
+#ifndef _sbn_trace_h_
+#define _sbn_trace_h_
+
+#include "sbn_app.h"
+
+/**
+ * Records a point in the life of an app message, if tracing is on; when it
+ * is off, this costs a test of SBN.Trace.On.
+ *
+ * @param Point[in] The SBN_TracePoint_t.
+ * @param ProcessorID[in] The peer's ProcessorID, 0 if not known here.
+ * @param Msg[in] The (CCSDS) message.
+ */
+#define SBN_TRACE(Point, ProcessorID, Msg)                  \
+    do                                                      \
+    {                                                       \
+        if (SBN.Trace.On)                                   \
+        {                                                   \
+            SBN_TraceMsg((Point), (ProcessorID), (Msg));    \
+        } /* end if */                                      \
+    } while (0)
+
+/**
+ * Records a point in the ring, overwriting the oldest when it is full.
+ *
+ * @param Point[in] The point.
+ * @param TimeUs[in] When the message reached it.
+ * @param ProcessorID[in] The peer's ProcessorID, 0 if not known here.
+ * @param MsgID[in] The message's ID.
+ */
+void SBN_TraceRecord(SBN_TracePoint_t Point, int64 TimeUs, CFE_ProcessorID_t ProcessorID, CFE_SB_MsgId_t MsgID);
+
+/** @brief Records a point reached now by a (CCSDS) message, see SBN_TRACE. */
+void SBN_TraceMsg(SBN_TracePoint_t Point, CFE_ProcessorID_t ProcessorID, void *Msg);
+
+/**
+ * Records a point reached by an SBN message, if it is an app message (of any
+ * type, the MsgID found past its sequence header and stamp.)
+ *
+ * @param Point[in] The point.
+ * @param TimeUs[in] When the message reached it.
+ * @param ProcessorID[in] The peer's ProcessorID, 0 if not known here.
+ * @param MsgType[in] The SBN message type.
+ * @param MsgSz[in] The size of the payload.
+ * @param Msg[in] The payload.
+ */
+void SBN_TraceNetMsg(SBN_TracePoint_t Point, int64 TimeUs, CFE_ProcessorID_t ProcessorID, SBN_MsgType_t MsgType,
+                     SBN_MsgSz_t MsgSz, void *Msg);
+
+/** @brief Clears the ring and starts tracing. */
+void SBN_TraceStart(void);
+
+/**
+ * Writes the ring to a file, oldest first (see SBN_TRACE_HDR_SZ.) Tracing
+ * should be stopped first so the ring holds still.
+ *
+ * @param FileName[in] The file, created or truncated.
+ * @param CntPtr[out] The points written.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if the file could not be written.
+ */
+SBN_Status_t SBN_TraceDump(const char *FileName, uint32 *CntPtr);
+
+#endif /* _sbn_trace_h_ */
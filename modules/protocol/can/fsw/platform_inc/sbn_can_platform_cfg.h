@@ -0,0 +1,27 @@
+/**
+ * @file
+ *
+ * This file contains several user-configurable parameters
+ */
+#ifndef _can_platform_cfg_h_
+#define _can_platform_cfg_h_
+
+#define SBN_CAN_MAX_NETS  2  /**< How many CAN interfaces this module can drive */
+#define SBN_CAN_MAX_PEERS 16 /**< How many peers, over all nets, can be reassembled for */
+
+/**
+ * Default for the "base" net address option: SBN frames use 29-bit IDs of
+ * base | destination node << 8 | source node, so the low 16 bits are zero.
+ */
+#define SBN_CAN_DEFAULT_ID_BASE 0x18AB0000
+
+/** How many frames are read, or written, with one system call. */
+#define SBN_CAN_BATCH 32
+
+/**
+ * How long (ms) a send waits for room in the interface's TX queue before
+ * the rest of the message is dropped.
+ */
+#define SBN_CAN_TX_WAIT_MS 10
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef _sbn_can_events_h
+#define _sbn_can_events_h
+
+#include "sbn_types.h"
+
+extern CFE_EVS_EventID_t SBN_CAN_FIRST_EID; /* defined at module init time */
+
+#define SBN_CAN_SOCK_EID   SBN_CAN_FIRST_EID + 1 /* skip 0th */
+#define SBN_CAN_CONFIG_EID SBN_CAN_FIRST_EID + 2
+#define SBN_CAN_DEBUG_EID  SBN_CAN_FIRST_EID + 3
+
+#endif /* _sbn_can_events_h */
@@ -0,0 +1,721 @@
+#define _GNU_SOURCE /* sendmmsg(), recvmmsg() */
+
+#include "sbn_can_if.h"
+#include "sbn_module_util.h"
+
+#include <linux/can/raw.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+CFE_EVS_EventID_t SBN_CAN_FIRST_EID;
+
+#define EXP_VERSION 6
+
+static SBN_ProtocolOutlet_t SBN;
+
+/* per-net receive state, frames read in one call and not yet processed */
+typedef struct
+{
+    struct canfd_frame Frames[SBN_CAN_BATCH];
+    struct iovec       Iovs[SBN_CAN_BATCH];
+    struct mmsghdr     Hdrs[SBN_CAN_BATCH];
+    int                FrameCnt, FrameIdx;
+
+    uint32 RxBatchCnt, RxUnknownCnt;
+} SBN_CAN_Rx_t;
+
+static SBN_CAN_Rx_t Rxs[SBN_CAN_MAX_NETS];
+static uint8        NetCnt       = 0;
+static uint8        LoadedNetCnt = 0;
+
+/* per-peer reassembly state */
+typedef struct
+{
+    /** @brief The message so far, Used bytes after any compact header headroom. */
+    uint8  Buf[SBN_CAN_HEADROOM + SBN_MAX_PACKED_MSG_SZ];
+    size_t Used;
+
+    /** @brief A first frame has been received, NextSeq is the expected consecutive frame. */
+    bool  Active;
+    uint8 NextSeq;
+
+    uint32 TxMsgCnt, TxFrameCnt, TxErrCnt, RxMsgCnt, RxFrameCnt, RxSeqErrCnt;
+} SBN_CAN_Reasm_t;
+
+static SBN_CAN_Reasm_t Reasms[SBN_CAN_MAX_PEERS];
+static uint8           PeerCnt = 0;
+
+/* the valid CAN FD data lengths, shorter frames are padded up to one */
+static const uint8 FDLens[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+
+static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID, SBN_ProtocolOutlet_t *Outlet)
+{
+    SBN_CAN_FIRST_EID = BaseEID;
+
+    if (Version != EXP_VERSION)
+    {
+        OS_printf("SBN_CAN version mismatch: expected %d, got %d\n", EXP_VERSION, Version);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Outlet == NULL)
+    {
+        OS_printf("SBN_CAN outlet is NULL\n");
+        return SBN_ERROR;
+    } /* end if */
+
+    /* copy outlet pointers to a local buffer for later use */
+    memcpy(&SBN, Outlet, sizeof(SBN));
+
+    OS_printf("SBN_CAN Lib Initialized.\n");
+    return SBN_SUCCESS;
+} /* end Init() */
+
+static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
+{
+    SBN_CAN_Net_t *NetData = (SBN_CAN_Net_t *)Net->ModulePvt;
+    const char *   Opt     = strchr(Address, '?');
+    size_t         NameLen = strcspn(Address, "?");
+
+    EVSSendInfo(SBN_CAN_CONFIG_EID, "configuring net (Address=%s)", Address);
+
+    if (NetCnt >= SBN_CAN_MAX_NETS)
+    {
+        EVSSendErr(SBN_CAN_CONFIG_EID, "too many CAN nets (max=%d)", SBN_CAN_MAX_NETS);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (NameLen == 0 || NameLen >= IFNAMSIZ)
+    {
+        EVSSendErr(SBN_CAN_CONFIG_EID, "invalid interface name (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(NetData->IfName, 0, sizeof(NetData->IfName));
+    strncpy(NetData->IfName, Address, NameLen);
+
+    NetData->IDBase      = SBN_CAN_DEFAULT_ID_BASE;
+    NetData->NodeID      = CFE_PSP_GetProcessorId() & 0xFF;
+    NetData->FrameDataSz = CANFD_MAX_DLEN;
+    NetData->Compact     = false;
+
+    while (Opt != NULL)
+    {
+        Opt++; /* skip the '?' or '&' */
+
+        const char *Eq          = strchr(Opt, '=');
+        char *      ValidatePtr = NULL;
+        size_t      Len         = Eq ? (size_t)(Eq - Opt) : 0;
+
+        unsigned long Val = Eq ? strtoul(Eq + 1, &ValidatePtr, 0) : 0;
+
+        if (!Eq || ValidatePtr == Eq + 1 || (*ValidatePtr != '\0' && *ValidatePtr != '&'))
+        {
+            EVSSendErr(SBN_CAN_CONFIG_EID, "invalid option (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        if (SBN_OPT_IS(Opt, Len, "node") && Val <= 0xFF)
+        {
+            NetData->NodeID = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "base") && Val <= CAN_EFF_MASK && (Val & 0xFFFF) == 0)
+        {
+            NetData->IDBase = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "fd") && Val <= 1)
+        {
+            NetData->FrameDataSz = Val ? CANFD_MAX_DLEN : CAN_MAX_DLEN;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "compact") && Val <= 1)
+        {
+            NetData->Compact = Val;
+        }
+        else
+        {
+            EVSSendErr(SBN_CAN_CONFIG_EID, "unknown option or value out of range (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        Opt = strchr(Opt, '&');
+    } /* end while */
+
+    NetData->FD     = -1;
+    NetData->BufNum = NetCnt++;
+    LoadedNetCnt++;
+
+    return SBN_SUCCESS;
+} /* end LoadNet() */
+
+static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
+{
+    SBN_CAN_Peer_t *PeerData    = (SBN_CAN_Peer_t *)Peer->ModulePvt;
+    char *          ValidatePtr = NULL;
+    unsigned long   NodeID      = strtoul(Address, &ValidatePtr, 0);
+
+    EVSSendInfo(SBN_CAN_CONFIG_EID, "configuring peer (SC=%d, CPU=%d, Address=%s)", Peer->SpacecraftID,
+                Peer->ProcessorID, Address);
+
+    if (PeerCnt >= SBN_CAN_MAX_PEERS)
+    {
+        EVSSendErr(SBN_CAN_CONFIG_EID, "too many CAN peers (max=%d)", SBN_CAN_MAX_PEERS);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (ValidatePtr == Address || *ValidatePtr != '\0' || NodeID > 0xFF)
+    {
+        EVSSendErr(SBN_CAN_CONFIG_EID, "invalid node number (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    PeerData->NodeID = NodeID;
+    PeerData->BufNum = PeerCnt++;
+
+    return SBN_SUCCESS;
+} /* end LoadPeer() */
+
+/**
+ * Binds the socket to the interface, only receiving SBN frames addressed to
+ * this node; the caller closes the socket on failure.
+ */
+static SBN_Status_t BindSocket(SBN_CAN_Net_t *NetData)
+{
+    struct ifreq       Req;
+    struct sockaddr_can Addr;
+    struct can_filter  Filter;
+    int                On = 1;
+
+    memset(&Req, 0, sizeof(Req));
+    strncpy(Req.ifr_name, NetData->IfName, sizeof(Req.ifr_name) - 1);
+
+    if (ioctl(NetData->FD, SIOCGIFINDEX, &Req) < 0)
+    {
+        EVSSendErr(SBN_CAN_SOCK_EID, "no interface %s (errno=%d)", NetData->IfName, errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (NetData->FrameDataSz == CANFD_MAX_DLEN
+        && setsockopt(NetData->FD, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &On, sizeof(On)) < 0)
+    {
+        EVSSendErr(SBN_CAN_SOCK_EID, "no CAN FD support (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    /* extended frames to this node from any node */
+    Filter.can_id   = CAN_EFF_FLAG | SBN_CAN_ID(NetData->IDBase, NetData->NodeID, 0);
+    Filter.can_mask = CAN_EFF_FLAG | CAN_RTR_FLAG | (CAN_EFF_MASK & ~0xFF);
+
+    if (setsockopt(NetData->FD, SOL_CAN_RAW, CAN_RAW_FILTER, &Filter, sizeof(Filter)) < 0)
+    {
+        EVSSendErr(SBN_CAN_SOCK_EID, "unable to set filter (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(&Addr, 0, sizeof(Addr));
+    Addr.can_family  = AF_CAN;
+    Addr.can_ifindex = Req.ifr_ifindex;
+
+    if (bind(NetData->FD, (struct sockaddr *)&Addr, sizeof(Addr)) < 0)
+    {
+        EVSSendErr(SBN_CAN_SOCK_EID, "bind to %s failed (errno=%d)", NetData->IfName, errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end BindSocket() */
+
+/**
+ * Opens a CAN_RAW socket on the interface.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS on success, error code otherwise
+ */
+static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
+{
+    SBN_CAN_Net_t *NetData = (SBN_CAN_Net_t *)Net->ModulePvt;
+    SBN_CAN_Rx_t * Rx      = &Rxs[NetData->BufNum];
+
+    memset(Rx, 0, sizeof(*Rx));
+
+    NetData->FD = socket(PF_CAN, SOCK_RAW | SOCK_CLOEXEC, CAN_RAW);
+    if (NetData->FD < 0)
+    {
+        EVSSendErr(SBN_CAN_SOCK_EID, "socket call failed (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (BindSocket(NetData) != SBN_SUCCESS)
+    {
+        close(NetData->FD);
+        NetData->FD = -1;
+        return SBN_ERROR;
+    } /* end if */
+
+    EVSSendInfo(SBN_CAN_SOCK_EID, "%s up (node=%d, %s, %s headers)", NetData->IfName, NetData->NodeID,
+                NetData->FrameDataSz == CANFD_MAX_DLEN ? "CAN FD" : "classic CAN",
+                NetData->Compact ? "compact" : "full");
+
+    return SBN_SUCCESS;
+} /* end InitNet() */
+
+/**
+ * CAN is connectionless, peers are connected when heard from.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS
+ */
+static SBN_Status_t InitPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_CAN_Peer_t *PeerData = (SBN_CAN_Peer_t *)Peer->ModulePvt;
+
+    memset(&Reasms[PeerData->BufNum], 0, sizeof(Reasms[PeerData->BufNum]));
+
+    return SBN_SUCCESS;
+} /* end InitPeer() */
+
+static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
+{
+    OS_time_t CurrentTime;
+    OS_GetLocalTime(&CurrentTime);
+
+    if (Peer->Connected)
+    {
+        if (OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastRecv)) > SBN_CAN_PEER_TIMEOUT)
+        {
+            EVSSendInfo(SBN_CAN_DEBUG_EID, "disconnected peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+
+            SBN.Disconnected(Peer);
+            return SBN_SUCCESS;
+        } /* end if */
+
+        if (OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_CAN_PEER_HEARTBEAT)
+        {
+            OS_GetLocalTime(&Peer->LastSend);
+            EVSSendDbg(SBN_CAN_DEBUG_EID, "sending heartbeat to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+            return SBN.SendNetMsg(SBN_CAN_HEARTBEAT_MSG, 0, NULL, Peer);
+        } /* end if */
+    }
+    else
+    {
+        if (OS_TimeGetTotalSeconds(Peer->LastSend) == 0
+            || OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_CAN_ANNOUNCE_TIMEOUT)
+        {
+            OS_GetLocalTime(&Peer->LastSend);
+            EVSSendInfo(SBN_CAN_DEBUG_EID, "announce to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+            return SBN.SendNetMsg(SBN_CAN_ANNOUNCE_MSG, 0, NULL, Peer);
+        } /* end if */
+    }     /* end if */
+
+    return SBN_SUCCESS;
+} /* end PollPeer() */
+
+/** writes frames with as few calls as the TX queue allows */
+static SBN_Status_t SendFrames(SBN_CAN_Net_t *NetData, struct canfd_frame *Frames, int FrameCnt)
+{
+    struct iovec   Iovs[SBN_CAN_BATCH];
+    struct mmsghdr Hdrs[SBN_CAN_BATCH];
+    int            Sent = 0, i = 0;
+
+    memset(Hdrs, 0, sizeof(Hdrs));
+
+    for (i = 0; i < FrameCnt; i++)
+    {
+        /* classic frames are the leading CAN_MTU bytes of the FD layout */
+        Iovs[i].iov_base           = &Frames[i];
+        Iovs[i].iov_len            = NetData->FrameDataSz == CANFD_MAX_DLEN ? CANFD_MTU : CAN_MTU;
+        Hdrs[i].msg_hdr.msg_iov    = &Iovs[i];
+        Hdrs[i].msg_hdr.msg_iovlen = 1;
+    } /* end for */
+
+    while (Sent < FrameCnt)
+    {
+        int Cnt = sendmmsg(NetData->FD, &Hdrs[Sent], FrameCnt - Sent, MSG_DONTWAIT);
+
+        if (Cnt < 0)
+        {
+            struct pollfd PollFD = {NetData->FD, POLLOUT, 0};
+
+            /* the TX queue is full, give the bus a moment to drain it */
+            if ((errno != ENOBUFS && errno != EAGAIN) || poll(&PollFD, 1, SBN_CAN_TX_WAIT_MS) <= 0)
+            {
+                return SBN_ERROR;
+            } /* end if */
+
+            if ((Cnt = sendmmsg(NetData->FD, &Hdrs[Sent], FrameCnt - Sent, MSG_DONTWAIT)) < 0)
+            {
+                return SBN_ERROR;
+            } /* end if */
+        } /* end if */
+
+        Sent += Cnt;
+    } /* end while */
+
+    return SBN_SUCCESS;
+} /* end SendFrames() */
+
+static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_CAN_Peer_t *   PeerData = (SBN_CAN_Peer_t *)Peer->ModulePvt;
+    SBN_CAN_Net_t *    NetData  = (SBN_CAN_Net_t *)Peer->Net->ModulePvt;
+    SBN_CAN_Reasm_t *  Stats    = &Reasms[PeerData->BufNum];
+    size_t             SegSz    = NetData->FrameDataSz - 1;
+    uint8              Buf[MsgSz + SBN_PACKED_HDR_SZ];
+    uint8 *            Data     = Buf;
+    size_t             DataSz   = sizeof(Buf);
+    struct canfd_frame Frames[SBN_CAN_BATCH];
+    int                FrameCnt = 0;
+    size_t             Seq      = 0;
+
+    if (NetData->FD < 0)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN.PackMsg(Buf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Payload);
+
+    if (NetData->Compact)
+    {
+        /* keep the size and type, the peer knows who we are from the CAN ID */
+        memmove(Buf + SBN_CAN_HEADROOM, Buf, SBN_CAN_COMPACT_HDR_SZ);
+        Data += SBN_CAN_HEADROOM;
+        DataSz -= SBN_CAN_HEADROOM;
+    } /* end if */
+
+    while (DataSz > 0)
+    {
+        struct canfd_frame *Frame = &Frames[FrameCnt++];
+        size_t              Len   = DataSz < SegSz ? DataSz : SegSz;
+        size_t              i     = 0;
+
+        memset(Frame, 0, sizeof(*Frame));
+        Frame->can_id = CAN_EFF_FLAG | SBN_CAN_ID(NetData->IDBase, PeerData->NodeID, NetData->NodeID);
+
+        if (Seq == 0)
+        {
+            Frame->data[0] = Len == DataSz ? SBN_CAN_PCI_SINGLE : SBN_CAN_PCI_FIRST;
+        }
+        else
+        {
+            Frame->data[0] = SBN_CAN_PCI_CONSEC | SBN_CAN_PCI_SEQ(Seq);
+        } /* end if */
+
+        memcpy(Frame->data + 1, Data, Len);
+
+        /* pad to a length the frame can carry, the header gives the real length */
+        for (i = 0; FDLens[i] < Len + 1; i++)
+            ;
+        Frame->len = FDLens[i];
+
+        if (NetData->FrameDataSz == CANFD_MAX_DLEN)
+        {
+            Frame->flags = CANFD_BRS;
+        } /* end if */
+
+        Data += Len;
+        DataSz -= Len;
+        Seq++;
+
+        if (FrameCnt == SBN_CAN_BATCH || DataSz == 0)
+        {
+            if (SendFrames(NetData, Frames, FrameCnt) != SBN_SUCCESS)
+            {
+                Stats->TxErrCnt++;
+                EVSSendErrLimited(SBN_CAN_SOCK_EID, "send to node %d failed (errno=%d)", PeerData->NodeID, errno);
+                return SBN_ERROR;
+            } /* end if */
+
+            Stats->TxFrameCnt += FrameCnt;
+            FrameCnt = 0;
+        } /* end if */
+    }     /* end while */
+
+    Stats->TxMsgCnt++;
+
+    return SBN_SUCCESS;
+} /* end Send() */
+
+/** finds the peer on the net with the node number */
+static SBN_PeerInterface_t *NodePeer(SBN_NetInterface_t *Net, uint8 NodeID)
+{
+    SBN_PeerIdx_t PeerIdx = 0;
+
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        if (((SBN_CAN_Peer_t *)Net->Peers[PeerIdx].ModulePvt)->NodeID == NodeID)
+        {
+            return &Net->Peers[PeerIdx];
+        } /* end if */
+    }     /* end for */
+
+    return NULL;
+} /* end NodePeer() */
+
+/** adds a frame to the sender's reassembly, returning SBN_SUCCESS once a message is complete */
+static SBN_Status_t RecvFrame(SBN_NetInterface_t *Net, struct canfd_frame *Frame, SBN_MsgType_t *MsgTypePtr,
+                              SBN_MsgSz_t *MsgSzPtr, CFE_ProcessorID_t *ProcessorIDPtr,
+                              CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_CAN_Net_t *      NetData = (SBN_CAN_Net_t *)Net->ModulePvt;
+    SBN_PeerInterface_t *Peer    = NULL;
+    SBN_CAN_Reasm_t *    Rx      = NULL;
+    size_t               HdrSz   = NetData->Compact ? SBN_CAN_COMPACT_HDR_SZ : SBN_PACKED_HDR_SZ;
+    size_t               Start   = NetData->Compact ? SBN_CAN_HEADROOM : 0;
+    size_t               Len = 0, Total = 0;
+    uint8                PCI = 0;
+
+    if (!(Frame->can_id & CAN_EFF_FLAG) || (Frame->can_id & CAN_RTR_FLAG)
+        || (Frame->can_id & CAN_EFF_MASK & ~0xFF) != SBN_CAN_ID(NetData->IDBase, NetData->NodeID, 0)
+        || Frame->len < 1 || Frame->len > CANFD_MAX_DLEN)
+    {
+        /* not an SBN frame for us */
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    Peer = NodePeer(Net, Frame->can_id & 0xFF);
+    if (Peer == NULL)
+    {
+        Rxs[NetData->BufNum].RxUnknownCnt++;
+        EVSSendMsgDbg(SBN_CAN_DEBUG_EID, "frame from unknown node %d", (int)(Frame->can_id & 0xFF));
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    Rx  = &Reasms[((SBN_CAN_Peer_t *)Peer->ModulePvt)->BufNum];
+    PCI = Frame->data[0];
+    Len = Frame->len - 1;
+
+    Rx->RxFrameCnt++;
+
+    switch (SBN_CAN_PCI_TYPE(PCI))
+    {
+        case SBN_CAN_PCI_SINGLE:
+        case SBN_CAN_PCI_FIRST:
+            if (Rx->Active)
+            {
+                /* the rest of the last message never came */
+                Rx->RxSeqErrCnt++;
+            } /* end if */
+
+            Rx->Active  = true;
+            Rx->Used    = 0;
+            Rx->NextSeq = 1;
+            break;
+
+        case SBN_CAN_PCI_CONSEC:
+            if (!Rx->Active || SBN_CAN_PCI_SEQ(PCI) != Rx->NextSeq)
+            {
+                if (Rx->Active)
+                {
+                    Rx->RxSeqErrCnt++;
+                    EVSSendErrLimited(SBN_CAN_SOCK_EID, "frame lost from node %d", (int)(Frame->can_id & 0xFF));
+                } /* end if */
+
+                Rx->Active = false;
+                return SBN_ERROR;
+            } /* end if */
+
+            Rx->NextSeq = SBN_CAN_PCI_SEQ(Rx->NextSeq + 1);
+            break;
+
+        default:
+            Rx->RxSeqErrCnt++;
+            return SBN_ERROR;
+    } /* end switch */
+
+    if (Len > sizeof(Rx->Buf) - Start - Rx->Used)
+    {
+        Len = sizeof(Rx->Buf) - Start - Rx->Used;
+    } /* end if */
+
+    memcpy(Rx->Buf + Start + Rx->Used, Frame->data + 1, Len);
+    Rx->Used += Len;
+
+    if (Rx->Used < HdrSz)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    Total = HdrSz + (size_t)((Rx->Buf[Start] << 8) | Rx->Buf[Start + 1]);
+
+    if (Total > SBN_MAX_PACKED_MSG_SZ || (Rx->Used < Total && SBN_CAN_PCI_TYPE(PCI) == SBN_CAN_PCI_SINGLE))
+    {
+        Rx->RxSeqErrCnt++;
+        Rx->Active = false;
+        EVSSendErrLimited(SBN_CAN_SOCK_EID, "invalid message from node %d", (int)(Frame->can_id & 0xFF));
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Rx->Used < Total)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    Rx->Active = false;
+
+    if (NetData->Compact)
+    {
+        /* rebuild the full packed header from the peer's IDs */
+        memmove(Rx->Buf, Rx->Buf + SBN_CAN_HEADROOM, SBN_CAN_COMPACT_HDR_SZ);
+        Rx->Buf[3]  = (Peer->ProcessorID >> 24) & 0xFF;
+        Rx->Buf[4]  = (Peer->ProcessorID >> 16) & 0xFF;
+        Rx->Buf[5]  = (Peer->ProcessorID >> 8) & 0xFF;
+        Rx->Buf[6]  = Peer->ProcessorID & 0xFF;
+        Rx->Buf[7]  = (Peer->SpacecraftID >> 24) & 0xFF;
+        Rx->Buf[8]  = (Peer->SpacecraftID >> 16) & 0xFF;
+        Rx->Buf[9]  = (Peer->SpacecraftID >> 8) & 0xFF;
+        Rx->Buf[10] = Peer->SpacecraftID & 0xFF;
+    } /* end if */
+
+    if (!SBN.UnpackMsg(Rx->Buf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload)
+        || *ProcessorIDPtr != Peer->ProcessorID || *SpacecraftIDPtr != Peer->SpacecraftID)
+    {
+        EVSSendErrLimited(SBN_CAN_SOCK_EID, "invalid message from node %d", (int)(Frame->can_id & 0xFF));
+        return SBN_ERROR;
+    } /* end if */
+
+    Rx->RxMsgCnt++;
+
+    if (!Peer->Connected)
+    {
+        EVSSendInfo(SBN_CAN_DEBUG_EID, "connecting to peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+        SBN.Connected(Peer);
+    } /* end if */
+
+    if (*MsgTypePtr == SBN_CAN_DISCONN_MSG)
+    {
+        SBN.Disconnected(Peer);
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end RecvFrame() */
+
+/* Note that this Recv function is indescriminate, frames are received from
+ * all nodes and reassembled per sender. Frames are read SBN_CAN_BATCH at a
+ * time and processed one per call until a message is complete.
+ */
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                         CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_CAN_Net_t *NetData = (SBN_CAN_Net_t *)Net->ModulePvt;
+    SBN_CAN_Rx_t * Rx      = &Rxs[NetData->BufNum];
+    int            i       = 0;
+
+    if (NetData->FD < 0)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    while (1)
+    {
+        if (Rx->FrameIdx >= Rx->FrameCnt)
+        {
+            for (i = 0; i < SBN_CAN_BATCH; i++)
+            {
+                Rx->Iovs[i].iov_base           = &Rx->Frames[i];
+                Rx->Iovs[i].iov_len            = sizeof(Rx->Frames[i]);
+                Rx->Hdrs[i].msg_hdr.msg_iov    = &Rx->Iovs[i];
+                Rx->Hdrs[i].msg_hdr.msg_iovlen = 1;
+            } /* end for */
+
+            /* polling returns at once, otherwise block for the recv task until there is at least one */
+            Rx->FrameIdx = 0;
+            Rx->FrameCnt = recvmmsg(NetData->FD, Rx->Hdrs, SBN_CAN_BATCH,
+                                    (Net->TaskFlags & SBN_TASK_RECV) ? MSG_WAITFORONE : MSG_DONTWAIT, NULL);
+
+            if (Rx->FrameCnt <= 0)
+            {
+                Rx->FrameCnt = 0;
+                return SBN_IF_EMPTY;
+            } /* end if */
+
+            Rx->RxBatchCnt++;
+        } /* end if */
+
+        i = Rx->FrameIdx++;
+
+        if ((Rx->Hdrs[i].msg_len == CAN_MTU || Rx->Hdrs[i].msg_len == CANFD_MTU)
+            && RecvFrame(Net, &Rx->Frames[i], MsgTypePtr, MsgSzPtr, ProcessorIDPtr, SpacecraftIDPtr, Payload)
+                   == SBN_SUCCESS)
+        {
+            return SBN_SUCCESS;
+        } /* end if */
+    }     /* end while */
+} /* end Recv() */
+
+static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
+{
+    if (Peer->Connected)
+    {
+        EVSSendInfo(SBN_CAN_DEBUG_EID, "peer %d:%d - sending disconnect", Peer->SpacecraftID, Peer->ProcessorID);
+        SBN.SendNetMsg(SBN_CAN_DISCONN_MSG, 0, NULL, Peer);
+        SBN.Disconnected(Peer);
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end UnloadPeer() */
+
+static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
+{
+    SBN_CAN_Net_t *NetData = (SBN_CAN_Net_t *)Net->ModulePvt;
+
+    SBN_PeerIdx_t PeerIdx = 0;
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        UnloadPeer(&Net->Peers[PeerIdx]);
+    } /* end for */
+
+    if (NetData->FD >= 0)
+    {
+        close(NetData->FD);
+        NetData->FD = -1;
+    } /* end if */
+
+    /* the other nets' tables, and their peers', follow this one's, so they are only reused once all are unloaded */
+    if (LoadedNetCnt && --LoadedNetCnt == 0)
+    {
+        NetCnt  = 0;
+        PeerCnt = 0;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end UnloadNet() */
+
+/**
+ * Reports, big-endian: uint8 Flags (1=open, 2=CAN FD, 4=compact headers),
+ * uint8 peer node, then uint32 TX messages, TX frames, TX errors, RX
+ * messages, RX frames, RX sequence errors, and for the net RX read calls and
+ * frames from unknown nodes.
+ */
+static SBN_Status_t ReportModuleStatus(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz)
+{
+    SBN_CAN_Peer_t * PeerData = (SBN_CAN_Peer_t *)Peer->ModulePvt;
+    SBN_CAN_Net_t *  NetData  = (SBN_CAN_Net_t *)Peer->Net->ModulePvt;
+    SBN_CAN_Reasm_t *Stats    = &Reasms[PeerData->BufNum];
+    SBN_CAN_Rx_t *   Rx       = &Rxs[NetData->BufNum];
+    uint8 *          Ptr      = StatusBuf;
+
+    if (StatusBufSz < 2 + 8 * 4)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    *Ptr++ = (NetData->FD >= 0 ? 1 : 0) | (NetData->FrameDataSz == CANFD_MAX_DLEN ? 2 : 0)
+             | (NetData->Compact ? 4 : 0);
+    *Ptr++ = PeerData->NodeID;
+    Ptr    = SBN_PutUInt32(Ptr, Stats->TxMsgCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Stats->TxFrameCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Stats->TxErrCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Stats->RxMsgCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Stats->RxFrameCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Stats->RxSeqErrCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Rx->RxBatchCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Rx->RxUnknownCnt);
+
+    return SBN_SUCCESS;
+} /* end ReportModuleStatus() */
+
+SBN_IfOps_t SBN_CAN_Ops = {Init, InitNet, InitPeer, LoadNet,   LoadPeer,   PollPeer,
+                           Send, NULL,    Recv,     UnloadNet, UnloadPeer, ReportModuleStatus};
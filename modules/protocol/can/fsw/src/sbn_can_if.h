@@ -0,0 +1,98 @@
+#ifndef _SBN_CAN_IF_H_
+#define _SBN_CAN_IF_H_
+
+#include "sbn_can_events.h"
+#include "sbn_platform_cfg.h"
+#include "sbn_can_platform_cfg.h"
+#include <string.h>
+#include <errno.h>
+#include <net/if.h>
+#include <linux/can.h>
+
+#include "sbn_interfaces.h"
+#include "cfe.h"
+
+/**
+ * CAN-specific message types.
+ */
+#define SBN_CAN_HEARTBEAT_MSG 0xA0
+#define SBN_CAN_ANNOUNCE_MSG  0xA1
+#define SBN_CAN_DISCONN_MSG   0xA2
+
+/**
+ * \brief Number of seconds since last I've sent the peer a message when
+ * I send an empty heartbeat message.
+ */
+#define SBN_CAN_PEER_HEARTBEAT 5
+
+/**
+ * \brief Number of seconds since I've last heard from the peer when I consider
+ * the peer connection to be dropped.
+ */
+#define SBN_CAN_PEER_TIMEOUT 10
+
+/**
+ * \brief If we're not connected, send peer occasional messages to wake
+ * them up and tell them "I'm here".
+ */
+#define SBN_CAN_ANNOUNCE_TIMEOUT 10
+
+/**
+ * A packed message is segmented over as many frames as it takes, in the
+ * manner of ISO-TP but without flow control frames: the first data byte of
+ * each frame is a protocol control byte, a single frame carries the whole
+ * message, a first frame its start and consecutive frames the rest, numbered
+ * 1, 2, ... modulo 64. The packed header in the first frame gives the length,
+ * so frames may be padded to a valid CAN FD length.
+ */
+#define SBN_CAN_PCI_SINGLE   0x00
+#define SBN_CAN_PCI_FIRST    0x40
+#define SBN_CAN_PCI_CONSEC   0x80
+#define SBN_CAN_PCI_TYPE(b)  ((b)&0xC0)
+#define SBN_CAN_PCI_SEQ(b)   ((b)&0x3F)
+
+/**
+ * In compact mode (the "compact" net option) the packed header is cut to the
+ * message size and type, 3 bytes rather than SBN_PACKED_HDR_SZ; the sender's
+ * processor and spacecraft IDs are those of the peer with the frame's source
+ * node.
+ */
+#define SBN_CAN_COMPACT_HDR_SZ 3
+#define SBN_CAN_HEADROOM       (SBN_PACKED_HDR_SZ - SBN_CAN_COMPACT_HDR_SZ)
+
+#define SBN_CAN_ID(Base, Dst, Src) ((Base) | ((canid_t)(Dst) << 8) | (Src))
+
+typedef struct
+{
+    /** @brief The peer's node number on the bus (the peer address.) */
+    uint8 NodeID;
+
+    /** @brief Index into the module's reassembly buffers. */
+    uint8 BufNum;
+} SBN_CAN_Peer_t;
+
+typedef struct SBN_CAN_Net_s
+{
+    /** @brief The CAN interface name, from the net address. */
+    char IfName[IFNAMSIZ];
+
+    /** @brief The CAN_RAW socket, -1 until initialized. */
+    int FD;
+
+    /** @brief See SBN_CAN_DEFAULT_ID_BASE (the "base" option.) */
+    canid_t IDBase;
+
+    /** @brief This node's number on the bus (the "node" option, by default the low byte of the processor ID.) */
+    uint8 NodeID;
+
+    /** @brief Data bytes per frame, 64 for CAN FD and 8 for classic CAN (the "fd" option.) */
+    uint8 FrameDataSz;
+
+    /** @brief See SBN_CAN_COMPACT_HDR_SZ. */
+    bool Compact;
+
+    /** @brief Index into the module's receive batches. */
+    uint8 BufNum;
+} SBN_CAN_Net_t;
+
+#endif /* _SBN_CAN_IF_H_ */
@@ -0,0 +1,439 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_can_if.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN SocketCAN protocol module
+**
+** Notes:
+** A SOCK_SEQPACKET socket pair stands in for the bus, carrying one CAN
+** frame per packet as a CAN_RAW socket does. The vcan test needs
+** CAP_NET_ADMIN and the vcan driver; run the test runner as
+** "unshare -rn <runner>" to have the former, without either it is skipped.
+*/
+
+#define _GNU_SOURCE /* unshare() */
+
+#include "sbn_can_coveragetest_common.h"
+#include "sbn_can_if.h"
+
+#include <sched.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define SBN_PROTOCOL_VERSION 6
+
+#define IF_VCAN "sbn_vcan0"
+
+extern SBN_IfOps_t SBN_CAN_Ops;
+
+static SBN_NetInterface_t   NetA, NetB;
+static SBN_PeerInterface_t *PeerA = &NetB.Peers[0], *PeerB = &NetA.Peers[0];
+static int                  Bus[2] = {-1, -1};
+
+static int ConnectedCnt = 0, DisconnectedCnt = 0;
+
+/* a test-local outlet packing the same header layout as SBN */
+static void PackMsg(void *SBNBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_ProcessorID_t ProcessorID,
+                    CFE_SpacecraftID_t SpacecraftID, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    memset(Buf, 0, SBN_PACKED_HDR_SZ);
+    Buf[0] = MsgSz >> 8;
+    Buf[1] = MsgSz & 0xFF;
+    Buf[2] = MsgType;
+    Buf[3] = (ProcessorID >> 24) & 0xFF;
+    Buf[4] = (ProcessorID >> 16) & 0xFF;
+    Buf[5] = (ProcessorID >> 8) & 0xFF;
+    Buf[6] = ProcessorID & 0xFF;
+    Buf[7] = (SpacecraftID >> 24) & 0xFF;
+    Buf[8] = (SpacecraftID >> 16) & 0xFF;
+    Buf[9] = (SpacecraftID >> 8) & 0xFF;
+    Buf[10] = SpacecraftID & 0xFF;
+
+    if (MsgSz)
+    {
+        memcpy(Buf + SBN_PACKED_HDR_SZ, Msg, MsgSz);
+    } /* end if */
+} /* end PackMsg() */
+
+static bool UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePtr,
+                      CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    *MsgSzPtr        = (Buf[0] << 8) | Buf[1];
+    *MsgTypePtr      = Buf[2];
+    *ProcessorIDPtr  = ((uint32)Buf[3] << 24) | (Buf[4] << 16) | (Buf[5] << 8) | Buf[6];
+    *SpacecraftIDPtr = ((uint32)Buf[7] << 24) | (Buf[8] << 16) | (Buf[9] << 8) | Buf[10];
+
+    if (*MsgSzPtr > CFE_MISSION_SB_MAX_SB_MSG_SIZE)
+    {
+        return false;
+    } /* end if */
+
+    memcpy(Msg, Buf + SBN_PACKED_HDR_SZ, *MsgSzPtr);
+
+    return true;
+} /* end UnpackMsg() */
+
+static SBN_Status_t Connected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = true;
+    ConnectedCnt++;
+    return SBN_SUCCESS;
+} /* end Connected() */
+
+static SBN_Status_t Disconnected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = false;
+    DisconnectedCnt++;
+    return SBN_SUCCESS;
+} /* end Disconnected() */
+
+static SBN_Status_t SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+{
+    return SBN_CAN_Ops.Send(Peer, MsgType, MsgSz, Msg);
+} /* end SendNetMsg() */
+
+/* each net has only the one peer */
+static SBN_PeerInterface_t *GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t ProcessorID,
+                                    CFE_SpacecraftID_t SpacecraftID)
+{
+    if (Net->Peers[0].ProcessorID == ProcessorID && Net->Peers[0].SpacecraftID == SpacecraftID)
+    {
+        return &Net->Peers[0];
+    } /* end if */
+
+    return NULL;
+} /* end GetPeer() */
+
+static SBN_ProtocolOutlet_t Outlet = {PackMsg, UnpackMsg, Connected, Disconnected, SendNetMsg, GetPeer};
+
+static uint8  Payload[CFE_MISSION_SB_MAX_SB_MSG_SIZE], RecvPayload[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+static uint32 Status[8];
+
+/* reads the module status of a peer, returning the flags */
+static uint8 GetStatus(SBN_PeerInterface_t *Peer)
+{
+    uint8 Buf[64], *Ptr = Buf + 2;
+    int   i             = 0;
+
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.ReportModuleStatus(Peer, Buf, sizeof(Buf)), SBN_SUCCESS);
+
+    for (i = 0; i < 8; i++, Ptr += 4)
+    {
+        Status[i] = ((uint32)Ptr[0] << 24) | (Ptr[1] << 16) | (Ptr[2] << 8) | Ptr[3];
+    } /* end for */
+
+    return Buf[0];
+} /* end GetStatus() */
+
+static SBN_Status_t RecvB(SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr, CFE_ProcessorID_t *ProcessorIDPtr)
+{
+    CFE_ProcessorID_t  ProcessorID  = 0;
+    CFE_SpacecraftID_t SpacecraftID = 0;
+
+    return SBN_CAN_Ops.RecvFromNet(&NetB, MsgTypePtr, MsgSzPtr, ProcessorIDPtr ? ProcessorIDPtr : &ProcessorID,
+                                   &SpacecraftID, RecvPayload);
+} /* end RecvB() */
+
+static void LoadNet(SBN_NetInterface_t *Net, const char *NetAddr, const char *PeerAddr)
+{
+    memset(Net, 0, sizeof(*Net));
+
+    Net->PeerCnt = 1;
+    Net->IfOps   = &SBN_CAN_Ops;
+
+    /* both ends are this processor */
+    Net->Peers[0].Net          = Net;
+    Net->Peers[0].ProcessorID  = CFE_PSP_GetProcessorId();
+    Net->Peers[0].SpacecraftID = CFE_PSP_GetSpacecraftId();
+
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadNet(Net, NetAddr), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadPeer(&Net->Peers[0], PeerAddr), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.InitPeer(&Net->Peers[0]), SBN_SUCCESS);
+} /* end LoadNet() */
+
+/* loads node 1 (net A) and node 2 (net B), joined by a socket pair */
+static void START(const char *Opts)
+{
+    char   Addr[64];
+    size_t i = 0;
+
+    UT_ResetState(0);
+
+    ConnectedCnt    = 0;
+    DisconnectedCnt = 0;
+
+    for (i = 0; i < sizeof(Payload); i++)
+    {
+        Payload[i] = i & 0xFF;
+    } /* end for */
+
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+
+    snprintf(Addr, sizeof(Addr), "can0?node=1%s", Opts);
+    LoadNet(&NetA, Addr, "2");
+    snprintf(Addr, sizeof(Addr), "can0?node=2%s", Opts);
+    LoadNet(&NetB, Addr, "1");
+
+    UtAssert_True(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, Bus) == 0, "bus open");
+    ((SBN_CAN_Net_t *)NetA.ModulePvt)->FD = Bus[0];
+    ((SBN_CAN_Net_t *)NetB.ModulePvt)->FD = Bus[1];
+} /* end START() */
+
+static void STOP(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.UnloadNet(&NetB), SBN_SUCCESS);
+} /* end STOP() */
+
+/* puts a frame on the bus as node Src */
+static void PutFrame(uint8 Dst, uint8 Src, uint8 PCI, const uint8 *Data, uint8 Len)
+{
+    struct canfd_frame Frame;
+
+    memset(&Frame, 0, sizeof(Frame));
+    Frame.can_id  = CAN_EFF_FLAG | SBN_CAN_ID(SBN_CAN_DEFAULT_ID_BASE, Dst, Src);
+    Frame.len     = Len + 1;
+    Frame.data[0] = PCI;
+    memcpy(Frame.data + 1, Data, Len);
+
+    UtAssert_True(write(Bus[0], &Frame, CANFD_MTU) == CANFD_MTU, "frame written");
+} /* end PutFrame() */
+
+void Test_SBN_CAN_Init(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.InitModule(-1, 0, &Outlet), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, NULL), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+} /* end Test_SBN_CAN_Init() */
+
+void Test_SBN_CAN_Load(void)
+{
+    SBN_CAN_Net_t * NetData  = (SBN_CAN_Net_t *)NetA.ModulePvt;
+    SBN_CAN_Peer_t *PeerData = (SBN_CAN_Peer_t *)PeerB->ModulePvt;
+
+    memset(&NetA, 0, sizeof(NetA));
+
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadNet(&NetA, ""), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadNet(&NetA, "can0?node"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadNet(&NetA, "can0?node=256"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadNet(&NetA, "can0?base=0x18AB0001"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadNet(&NetA, "can0?base=0x20000000"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadNet(&NetA, "can0?fd=2"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadNet(&NetA, "can0?foo=1"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadNet(&NetA, "sbn_nocan?node=9&base=0x10000&fd=0&compact=1"), SBN_SUCCESS);
+
+    UtAssert_True(strcmp(NetData->IfName, "sbn_nocan") == 0, "interface name");
+    UtAssert_True(NetData->NodeID == 9 && NetData->IDBase == 0x10000, "node and base");
+    UtAssert_True(NetData->FrameDataSz == CAN_MAX_DLEN && NetData->Compact, "classic, compact");
+
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadPeer(PeerB, ""), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadPeer(PeerB, "256"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadPeer(PeerB, "0x1g"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.LoadPeer(PeerB, "0x12"), SBN_SUCCESS);
+    UtAssert_True(PeerData->NodeID == 0x12, "peer node");
+
+    /* no such interface */
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.InitNet(&NetA), SBN_ERROR);
+
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+} /* end Test_SBN_CAN_Load() */
+
+void Test_SBN_CAN_Segments(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+
+    START("");
+
+    UtAssert_True(GetStatus(PeerB) == 3, "open, CAN FD, full headers");
+
+    /* 21, 111 and 4011 packed bytes: 1, 2 and 64 frames, the last wrapping the sequence */
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.Send(PeerB, SBN_APP_MSG, 10, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.Send(PeerB, SBN_APP_MSG, 100, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.Send(PeerB, SBN_APP_MSG, 4000, Payload), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, NULL), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_APP_MSG && MsgSz == 10 && memcmp(RecvPayload, Payload, 10) == 0, "single frame");
+    UtAssert_True(ConnectedCnt == 1 && PeerA->Connected, "connected on first message");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, NULL), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 100 && memcmp(RecvPayload, Payload, 100) == 0, "two frames");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, NULL), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 4000 && memcmp(RecvPayload, Payload, 4000) == 0, "64 frames");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, NULL), SBN_IF_EMPTY);
+
+    GetStatus(PeerB);
+    UtAssert_True(Status[0] == 3 && Status[1] == 67 && Status[2] == 0, "A TxMsgCnt=%d TxFrameCnt=%d",
+                  (int)Status[0], (int)Status[1]);
+    GetStatus(PeerA);
+    UtAssert_True(Status[3] == 3 && Status[4] == 67 && Status[5] == 0, "B RxMsgCnt=%d RxFrameCnt=%d",
+                  (int)Status[3], (int)Status[4]);
+    UtAssert_True(Status[6] <= 4, "B read %d frames with %d calls", (int)Status[4], (int)Status[6]);
+
+    STOP();
+    UtAssert_True(DisconnectedCnt == 1, "disconnected on unload");
+} /* end Test_SBN_CAN_Segments() */
+
+void Test_SBN_CAN_Compact(void)
+{
+    SBN_MsgType_t     MsgType     = 0;
+    SBN_MsgSz_t       MsgSz       = 0;
+    CFE_ProcessorID_t ProcessorID = 0;
+
+    START("&compact=1");
+
+    /* 63 packed bytes with the compact header, a single frame */
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.Send(PeerB, SBN_APP_MSG, 60, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.Send(PeerB, SBN_APP_MSG, 4000, Payload), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, &ProcessorID), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 60 && memcmp(RecvPayload, Payload, 60) == 0, "compact single frame");
+    UtAssert_True(ProcessorID == CFE_PSP_GetProcessorId(), "sender from the node, ProcessorID=%d", (int)ProcessorID);
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, NULL), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 4000 && memcmp(RecvPayload, Payload, 4000) == 0, "compact 64 frames");
+
+    GetStatus(PeerB);
+    UtAssert_True(GetStatus(PeerB) == 7 && Status[1] == 65, "A TxFrameCnt=%d", (int)Status[1]);
+
+    STOP();
+} /* end Test_SBN_CAN_Compact() */
+
+void Test_SBN_CAN_Classic(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+
+    START("&fd=0&compact=1");
+
+    /* 103 packed bytes, 7 per frame */
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.Send(PeerB, SBN_APP_MSG, 100, Payload), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, NULL), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 100 && memcmp(RecvPayload, Payload, 100) == 0, "classic frames");
+
+    UtAssert_True(GetStatus(PeerB) == 5, "open, classic, compact");
+    UtAssert_True(Status[1] == 15, "A TxFrameCnt=%d", (int)Status[1]);
+
+    STOP();
+} /* end Test_SBN_CAN_Classic() */
+
+void Test_SBN_CAN_Lost(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+    uint8         Hdr[SBN_CAN_COMPACT_HDR_SZ + 60];
+
+    START("&compact=1");
+
+    /* a 100 byte message whose second frame is lost */
+    Hdr[0] = 0;
+    Hdr[1] = 100;
+    Hdr[2] = SBN_APP_MSG;
+    memcpy(Hdr + SBN_CAN_COMPACT_HDR_SZ, Payload, 60);
+    PutFrame(2, 1, SBN_CAN_PCI_FIRST, Hdr, 63);
+    PutFrame(2, 1, SBN_CAN_PCI_CONSEC | 2, Payload, 40);
+
+    /* a frame from an unknown node, and one for another node */
+    PutFrame(2, 7, SBN_CAN_PCI_SINGLE, Hdr, 10);
+    PutFrame(3, 1, SBN_CAN_PCI_SINGLE, Hdr, 10);
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, NULL), SBN_IF_EMPTY);
+
+    /* then a whole one gets through */
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.Send(PeerB, SBN_APP_MSG, 100, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, NULL), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 100 && memcmp(RecvPayload, Payload, 100) == 0, "payload intact after loss");
+
+    GetStatus(PeerA);
+    UtAssert_True(Status[3] == 1 && Status[5] == 1, "B RxMsgCnt=%d RxSeqErrCnt=%d", (int)Status[3], (int)Status[5]);
+    UtAssert_True(Status[7] == 1, "B RxUnknownCnt=%d", (int)Status[7]);
+
+    STOP();
+} /* end Test_SBN_CAN_Lost() */
+
+void Test_SBN_CAN_Vcan(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+
+    /* keep the test interface out of the host's namespace if we can */
+    unshare(CLONE_NEWNET);
+
+    if (system("ip link add " IF_VCAN " type vcan 2>/dev/null && ip link set " IF_VCAN " mtu 72 up") != 0)
+    {
+        UtPrintf("unable to create a vcan interface, skipped (run under \"unshare -rn\" with vcan loaded)");
+        return;
+    } /* end if */
+
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+
+    LoadNet(&NetA, IF_VCAN "?node=1&compact=1", "2");
+    LoadNet(&NetB, IF_VCAN "?node=2&compact=1", "1");
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.InitNet(&NetA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.InitNet(&NetB), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(SBN_CAN_Ops.Send(PeerB, SBN_APP_MSG, 1000, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz, NULL), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 1000 && memcmp(RecvPayload, Payload, 1000) == 0, "payload intact over vcan");
+
+    /* A does not hear its own frames */
+    UT_TEST_FUNCTION_RC(
+        SBN_CAN_Ops.RecvFromNet(&NetA, &MsgType, &MsgSz, &PeerA->ProcessorID, &PeerA->SpacecraftID, RecvPayload),
+        SBN_IF_EMPTY);
+
+    STOP();
+
+    system("ip link del " IF_VCAN " 2>/dev/null");
+} /* end Test_SBN_CAN_Vcan() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_CAN_Init);
+    ADD_TEST(SBN_CAN_Load);
+    ADD_TEST(SBN_CAN_Segments);
+    ADD_TEST(SBN_CAN_Compact);
+    ADD_TEST(SBN_CAN_Classic);
+    ADD_TEST(SBN_CAN_Lost);
+    ADD_TEST(SBN_CAN_Vcan);
+}
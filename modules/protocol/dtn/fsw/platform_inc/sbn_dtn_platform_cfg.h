@@ -0,0 +1,25 @@
+/**
+ * @file
+ *
+ * This file contains several user-configurable parameters
+ */
+#ifndef _dtn_platform_cfg_h_
+#define _dtn_platform_cfg_h_
+
+#define SBN_DTN_MAX_EID_NAME 32 /**< How long an endpoint ID can be in a net or peer address */
+
+#define SBN_DTN_MAX_NETS  2  /**< How many DTN nets (local endpoints) this module can drive */
+#define SBN_DTN_MAX_PEERS 16 /**< How many DTN peers this module can drive, across all nets */
+
+/**
+ * Upper bound for the "agg" net address option, the largest bundle that
+ * aggregated messages are packed into. Also sizes the per-peer aggregation
+ * buffers and, with SBN_MAX_PACKED_MSG_SZ, the receive buffers.
+ */
+#define SBN_DTN_MAX_AGG_SZ 8192
+
+#define SBN_DTN_DEFAULT_FLUSH_MS 100 /**< Longest a message waits in an aggregate without a "flush" option */
+
+#define SBN_DTN_DEFAULT_TTL 300 /**< Bundle lifetime in seconds without a "ttl" option */
+
+#endif
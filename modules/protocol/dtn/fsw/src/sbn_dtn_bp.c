@@ -0,0 +1,181 @@
+/**
+ * The ION binding for the BP operations in sbn_dtn_bp.h.
+ */
+
+#include "sbn_dtn_bp.h"
+#include "sbn_dtn_platform_cfg.h"
+#include <bp.h>
+
+struct SBN_DTN_Endpoint_s
+{
+    bool         InUse;
+    BpSAP        SAP;
+    Sdr          SDR;
+    ReqAttendant Attendant;
+};
+
+static SBN_DTN_Endpoint_t Endpoints[SBN_DTN_MAX_NETS];
+static int                OpenCnt = 0;
+
+SBN_Status_t SBN_DTN_BpOpen(const char *EID, SBN_DTN_Endpoint_t **EndpointPtr)
+{
+    SBN_DTN_Endpoint_t *Endpoint = NULL;
+    int                 i        = 0;
+
+    for (i = 0; i < SBN_DTN_MAX_NETS; i++)
+    {
+        if (!Endpoints[i].InUse)
+        {
+            Endpoint = &Endpoints[i];
+            break;
+        } /* end if */
+    }     /* end for */
+
+    if (!Endpoint)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (OpenCnt == 0 && bp_attach() < 0)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (ionStartAttendant(&Endpoint->Attendant))
+    {
+        if (OpenCnt == 0)
+        {
+            bp_detach();
+        } /* end if */
+
+        return SBN_ERROR;
+    } /* end if */
+
+    if (bp_open((char *)EID, &Endpoint->SAP) < 0)
+    {
+        ionStopAttendant(&Endpoint->Attendant);
+
+        if (OpenCnt == 0)
+        {
+            bp_detach();
+        } /* end if */
+
+        return SBN_ERROR;
+    } /* end if */
+
+    Endpoint->SDR   = bp_get_sdr();
+    Endpoint->InUse = true;
+    OpenCnt++;
+
+    *EndpointPtr = Endpoint;
+
+    return SBN_SUCCESS;
+} /* end SBN_DTN_BpOpen() */
+
+SBN_Status_t SBN_DTN_BpSend(SBN_DTN_Endpoint_t *Endpoint, const char *DestEID, uint32 TTL, const uint8 *Buf,
+                            size_t BufSz)
+{
+    Object Extent = 0, BundleZCO = 0, NewBundle = 0;
+
+    if (!sdr_begin_xn(Endpoint->SDR))
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    /* the extent holds exactly the payload, not a maximum-size buffer */
+    Extent = sdr_malloc(Endpoint->SDR, BufSz);
+    if (!Extent)
+    {
+        sdr_cancel_xn(Endpoint->SDR);
+        return SBN_ERROR;
+    } /* end if */
+
+    sdr_write(Endpoint->SDR, Extent, (char *)Buf, BufSz);
+
+    if (sdr_end_xn(Endpoint->SDR) < 0)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    BundleZCO = ionCreateZco(ZcoSdrSource, Extent, 0, BufSz, BP_STD_PRIORITY, 0, ZcoOutbound, &Endpoint->Attendant);
+    if (BundleZCO == 0 || BundleZCO == (Object)ERROR)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (bp_send(Endpoint->SAP, (char *)DestEID, NULL, TTL, BP_STD_PRIORITY, NoCustodyRequested, 0, 0, NULL, BundleZCO,
+                &NewBundle)
+        < 1)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end SBN_DTN_BpSend() */
+
+SBN_Status_t SBN_DTN_BpRecv(SBN_DTN_Endpoint_t *Endpoint, uint8 *Buf, size_t BufSz, size_t *RecvSzPtr, bool Block)
+{
+    BpDelivery   Delivery;
+    ZcoReader    Reader;
+    vast         ContentLength = 0, Len = 0;
+    SBN_Status_t Status        = SBN_SUCCESS;
+
+    if (bp_receive(Endpoint->SAP, &Delivery, Block ? BP_BLOCKING : BP_POLL) < 0)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Delivery.result != BpPayloadPresent)
+    {
+        bp_release_delivery(&Delivery, 1);
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    if (!sdr_begin_xn(Endpoint->SDR))
+    {
+        bp_release_delivery(&Delivery, 1);
+        return SBN_ERROR;
+    } /* end if */
+
+    ContentLength = zco_source_data_length(Endpoint->SDR, Delivery.adu);
+
+    if (ContentLength > BufSz)
+    {
+        sdr_exit_xn(Endpoint->SDR);
+        Status = SBN_ERROR;
+    }
+    else
+    {
+        zco_start_receiving(Delivery.adu, &Reader);
+        Len = zco_receive_source(Endpoint->SDR, &Reader, ContentLength, (char *)Buf);
+
+        if (sdr_end_xn(Endpoint->SDR) < 0 || Len != ContentLength)
+        {
+            Status = SBN_ERROR;
+        } /* end if */
+
+        *RecvSzPtr = Len;
+    } /* end if */
+
+    bp_release_delivery(&Delivery, 1);
+
+    return Status;
+} /* end SBN_DTN_BpRecv() */
+
+void SBN_DTN_BpClose(SBN_DTN_Endpoint_t *Endpoint)
+{
+    if (!Endpoint->InUse)
+    {
+        return;
+    } /* end if */
+
+    bp_close(Endpoint->SAP);
+    ionStopAttendant(&Endpoint->Attendant);
+
+    Endpoint->InUse = false;
+
+    if (--OpenCnt == 0)
+    {
+        bp_detach();
+    } /* end if */
+} /* end SBN_DTN_BpClose() */
@@ -0,0 +1,59 @@
+#ifndef _sbn_dtn_bp_h_
+#define _sbn_dtn_bp_h_
+
+/**
+ * The few Bundle Protocol operations the DTN module needs, so that only
+ * sbn_dtn_bp.c depends on the ION headers and libraries; the unit tests
+ * link the module against a local stand-in instead.
+ */
+
+#include "sbn_interfaces.h"
+#include "cfe.h"
+
+/** @brief A local endpoint, defined by the BP binding. */
+typedef struct SBN_DTN_Endpoint_s SBN_DTN_Endpoint_t;
+
+/**
+ * Opens a local endpoint, attaching to the BP agent as needed.
+ *
+ * @param EID[in] The local endpoint ID, e.g. "ipn:1.1".
+ * @param EndpointPtr[out] The endpoint, to pass to the other calls.
+ * @return SBN_SUCCESS or SBN_ERROR.
+ */
+SBN_Status_t SBN_DTN_BpOpen(const char *EID, SBN_DTN_Endpoint_t **EndpointPtr);
+
+/**
+ * Sends one bundle carrying exactly BufSz bytes.
+ *
+ * @param Endpoint[in] The local endpoint.
+ * @param DestEID[in] The destination endpoint ID.
+ * @param TTL[in] The bundle lifetime, in seconds.
+ * @param Buf[in] The bundle payload.
+ * @param BufSz[in] The size of the payload.
+ * @return SBN_SUCCESS or SBN_ERROR.
+ */
+SBN_Status_t SBN_DTN_BpSend(SBN_DTN_Endpoint_t *Endpoint, const char *DestEID, uint32 TTL, const uint8 *Buf,
+                            size_t BufSz);
+
+/**
+ * Receives the payload of one bundle.
+ *
+ * @param Endpoint[in] The local endpoint.
+ * @param Buf[out] The buffer to receive the payload.
+ * @param BufSz[in] The size of the buffer.
+ * @param RecvSzPtr[out] The size of the payload received.
+ * @param Block[in] Wait for a bundle rather than returning immediately.
+ * @return SBN_SUCCESS, SBN_IF_EMPTY if there is no bundle (or the wait was
+ *         interrupted), SBN_ERROR if the bundle could not be read or does
+ *         not fit.
+ */
+SBN_Status_t SBN_DTN_BpRecv(SBN_DTN_Endpoint_t *Endpoint, uint8 *Buf, size_t BufSz, size_t *RecvSzPtr, bool Block);
+
+/**
+ * Closes a local endpoint, detaching from the BP agent with the last one.
+ *
+ * @param Endpoint[in] The local endpoint.
+ */
+void SBN_DTN_BpClose(SBN_DTN_Endpoint_t *Endpoint);
+
+#endif /* _sbn_dtn_bp_h_ */
@@ -1,7 +1,9 @@
 #ifndef _sbn_dtn_events_h
 #define _sbn_dtn_events_h
 
-#include "sbn_events.h"
+#include "sbn_types.h"
+
+extern CFE_EVS_EventID_t SBN_DTN_FIRST_EID; /* defined at module init time */
 
 #define SBN_DTN_SOCK_EID   SBN_DTN_FIRST_EID + 1 /* skip 0th */
 #define SBN_DTN_CONFIG_EID SBN_DTN_FIRST_EID + 2
@@ -1,238 +1,539 @@
-#include "sbn_dtn_if_struct.h"
 #include "sbn_dtn_if.h"
-#include "sbn_dtn_events.h"
-#include "cfe.h"
-#include <string.h>
-#include <errno.h>
-#include <sys/select.h>
+#include "sbn_module_util.h"
 
-int SBN_DTN_Init(int Version)
+#include <stdio.h>
+#include <stdlib.h>
+
+CFE_EVS_EventID_t SBN_DTN_FIRST_EID;
+
+#define EXP_VERSION 6
+
+static SBN_ProtocolOutlet_t SBN;
+
+/* per-peer send state, too big for the peer's ModulePvt */
+typedef struct
 {
-    if (Version != 1)
-    {
-        CFE_EVS_SendEvent(SBN_DTN_CONFIG_EID, CFE_EVS_ERROR, "mismatching version %d (SBN app reports %d)", Version, 1);
-        return SBN_ERROR;
-    } /* end if */
+    /** @brief Packed messages not yet sent, Used bytes in MsgCnt messages. */
+    uint8  Buf[SBN_DTN_MAX_BUNDLE_SZ];
+    size_t Used;
+    uint32 MsgCnt;
 
-    return SBN_SUCCESS;
-} /* end SBN_DTN_Init() */
+    /** @brief When the first message of the aggregate was queued. */
+    OS_time_t FirstQueued;
+
+    /** @brief Send and PollPeer may be called from different tasks. */
+    OS_MutexID_t Mutex;
 
-int SBN_DTN_LoadNet(SBN_NetInterface_t *Net, const char *Address)
+    uint32 TxBundleCnt, TxMsgCnt, TxByteCnt, TxErrCnt;
+} SBN_DTN_Agg_t;
+
+/* per-net receive state */
+typedef struct
 {
-    SBN_DTN_Net_t *NetData = (SBN_DTN_Net_t *)Net->ModulePvt;
+    /** @brief The last bundle received, Used bytes of which the first Consumed are processed. */
+    uint8  Buf[SBN_DTN_MAX_BUNDLE_SZ];
+    size_t Used, Consumed;
 
-    strncpy(NetData->EIN, Address, sizeof(NetData->EIN));
+    uint32 RxBundleCnt, RxMsgCnt, RxErrCnt;
+} SBN_DTN_Rx_t;
 
-    return SBN_SUCCESS;
-} /* end SBN_DTN_LoadNet */
+static SBN_DTN_Agg_t Aggs[SBN_DTN_MAX_PEERS];
+static uint8         AggCnt = 0;
+
+static SBN_DTN_Rx_t Rxs[SBN_DTN_MAX_NETS];
+static uint8        RxCnt        = 0;
+static uint8        LoadedNetCnt = 0;
 
-int SBN_DTN_LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
+static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID, SBN_ProtocolOutlet_t *Outlet)
 {
-    SBN_DTN_Peer_t *PeerData = (SBN_DTN_Peer_t *)Peer->ModulePvt;
+    SBN_DTN_FIRST_EID = BaseEID;
+
+    if (Version != EXP_VERSION)
+    {
+        OS_printf("SBN_DTN version mismatch: expected %d, got %d\n", EXP_VERSION, Version);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Outlet == NULL)
+    {
+        OS_printf("SBN_DTN outlet is NULL\n");
+        return SBN_ERROR;
+    } /* end if */
 
-    strncpy(PeerData->EIN, Address, sizeof(PeerData->EIN));
+    /* copy outlet pointers to a local buffer for later use */
+    memcpy(&SBN, Outlet, sizeof(SBN));
 
+    OS_printf("SBN_DTN Lib Initialized.\n");
     return SBN_SUCCESS;
-} /* end SBN_DTN_LoadHost */
+} /* end Init() */
 
 /**
- * Initializes a DTN host.
+ * Parses the "?key=val&key=val" options following the local EID.
  *
- * @param  Interface data structure containing the file entry
- * @return SBN_SUCCESS on success, error code otherwise
+ * @param NetData[out] The net whose options to set.
+ * @param Address[in] The address string from the configuration table.
+ * @return SBN_SUCCESS on success, SBN_ERROR on an unknown key or bad value.
  */
-int SBN_DTN_InitNet(SBN_NetInterface_t *Net)
+static SBN_Status_t ConfOpts(SBN_DTN_Net_t *NetData, const char *Address)
+{
+    const char *Opt = strchr(Address, '?');
+
+    NetData->AggSz   = 0;
+    NetData->FlushMs = SBN_DTN_DEFAULT_FLUSH_MS;
+    NetData->TTL     = SBN_DTN_DEFAULT_TTL;
+
+    while (Opt != NULL)
+    {
+        Opt++; /* skip the '?' or '&' */
+
+        const char *Eq          = strchr(Opt, '=');
+        char *      ValidatePtr = NULL;
+
+        if (!Eq)
+        {
+            EVSSendErr(SBN_DTN_CONFIG_EID, "invalid option (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        unsigned long Val = strtoul(Eq + 1, &ValidatePtr, 0);
+        size_t        Len = Eq - Opt;
+
+        if (ValidatePtr == Eq + 1 || (*ValidatePtr != '\0' && *ValidatePtr != '&'))
+        {
+            EVSSendErr(SBN_DTN_CONFIG_EID, "invalid option value (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        if (SBN_OPT_IS(Opt, Len, "agg") && (Val == 0 || (Val > SBN_PACKED_HDR_SZ && Val <= SBN_DTN_MAX_AGG_SZ)))
+        {
+            NetData->AggSz = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "flush"))
+        {
+            NetData->FlushMs = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "ttl") && Val > 0)
+        {
+            NetData->TTL = Val;
+        }
+        else
+        {
+            EVSSendErr(SBN_DTN_CONFIG_EID, "unknown option or value out of range (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        Opt = strchr(Opt, '&');
+    } /* end while */
+
+    return SBN_SUCCESS;
+} /* end ConfOpts() */
+
+static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
 {
     SBN_DTN_Net_t *NetData = (SBN_DTN_Net_t *)Net->ModulePvt;
+    size_t         EIDLen  = strcspn(Address, "?");
+
+    EVSSendInfo(SBN_DTN_CONFIG_EID, "configuring net %s", Address);
 
-    if (bp_attach() < 0)
+    if (RxCnt >= SBN_DTN_MAX_NETS)
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "unable to attach to DTN BP");
+        EVSSendErr(SBN_DTN_CONFIG_EID, "too many DTN nets (max=%d)", SBN_DTN_MAX_NETS);
         return SBN_ERROR;
     } /* end if */
 
-    if (ionStartAttendant(&NetData->Attendant))
+    if (EIDLen == 0 || EIDLen >= sizeof(NetData->EID))
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "unable to start attendant");
+        EVSSendErr(SBN_DTN_CONFIG_EID, "invalid EID (Address=%s)", Address);
         return SBN_ERROR;
     } /* end if */
 
-    if (bp_open(NetData->EIN, &NetData->SAP) < 0)
+    memset(NetData->EID, 0, sizeof(NetData->EID));
+    strncpy(NetData->EID, Address, EIDLen);
+
+    if (ConfOpts(NetData, Address) != SBN_SUCCESS)
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "unable to open EIN %s", NetData->EIN);
         return SBN_ERROR;
     } /* end if */
 
-    NetData->SendSDR = bp_get_sdr();
-    NetData->RecvSDR = bp_get_sdr();
+    NetData->Endpoint = NULL;
+    NetData->BufNum   = RxCnt++;
+    LoadedNetCnt++;
 
     return SBN_SUCCESS;
-} /* end SBN_DTN_InitNet */
+} /* end LoadNet() */
+
+static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
+{
+    SBN_DTN_Peer_t *PeerData = (SBN_DTN_Peer_t *)Peer->ModulePvt;
+
+    EVSSendInfo(SBN_DTN_CONFIG_EID, "configuring peer (SC=%d, CPU=%d, EID=%s)", Peer->SpacecraftID,
+                Peer->ProcessorID, Address);
+
+    if (AggCnt >= SBN_DTN_MAX_PEERS)
+    {
+        EVSSendErr(SBN_DTN_CONFIG_EID, "too many DTN peers (max=%d)", SBN_DTN_MAX_PEERS);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Address[0] == '\0' || strlen(Address) >= sizeof(PeerData->EID))
+    {
+        EVSSendErr(SBN_DTN_CONFIG_EID, "invalid EID (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(PeerData->EID, 0, sizeof(PeerData->EID));
+    strncpy(PeerData->EID, Address, sizeof(PeerData->EID) - 1);
+
+    PeerData->BufNum = AggCnt++;
+
+    return SBN_SUCCESS;
+} /* end LoadPeer() */
 
 /**
- * Initializes DTN peer data struct depending on the
- * CPU name.
+ * Opens the net's local endpoint.
  *
  * @param  Interface data structure containing the file entry
  * @return SBN_SUCCESS on success, error code otherwise
  */
-int SBN_DTN_InitPeer(SBN_PeerInterface_t *Peer)
+static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
 {
-    SBN_Connected(Peer);
+    SBN_DTN_Net_t *NetData = (SBN_DTN_Net_t *)Net->ModulePvt;
+    SBN_DTN_Rx_t * Rx      = &Rxs[NetData->BufNum];
+
+    memset(Rx, 0, sizeof(*Rx));
+
+    if (SBN_DTN_BpOpen(NetData->EID, &NetData->Endpoint) != SBN_SUCCESS)
+    {
+        EVSSendErr(SBN_DTN_SOCK_EID, "unable to open EID %s", NetData->EID);
+        NetData->Endpoint = NULL;
+        return SBN_ERROR;
+    } /* end if */
+
+    EVSSendInfo(SBN_DTN_SOCK_EID, "opened EID %s (agg=%d, flush=%dms, ttl=%ds)", NetData->EID, (int)NetData->AggSz,
+                (int)NetData->FlushMs, (int)NetData->TTL);
 
     return SBN_SUCCESS;
-} /* end SBN_DTN_InitPeer */
+} /* end InitNet() */
 
 /**
+ * Initializes a DTN peer's aggregation buffer.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS on success, error code otherwise
  */
-int SBN_DTN_PollPeer(SBN_PeerInterface_t *Peer)
+static SBN_Status_t InitPeer(SBN_PeerInterface_t *Peer)
 {
+    SBN_DTN_Peer_t *PeerData = (SBN_DTN_Peer_t *)Peer->ModulePvt;
+    SBN_DTN_Agg_t * Agg      = &Aggs[PeerData->BufNum];
+    char            Name[OS_MAX_API_NAME];
+
+    memset(Agg, 0, sizeof(*Agg));
+
+    snprintf(Name, sizeof(Name), "sbn_dtn_mtx_%d", PeerData->BufNum);
+    if (OS_MutSemCreate(&Agg->Mutex, Name, 0) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_DTN_CONFIG_EID, "unable to create mutex for %s", PeerData->EID);
+        return SBN_ERROR;
+    } /* end if */
+
     return SBN_SUCCESS;
-} /* end SBN_DTN_PollPeer */
+} /* end InitPeer() */
 
-int SBN_DTN_Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+/** sends the aggregate as one bundle, the caller holds the mutex */
+static SBN_Status_t Flush(SBN_PeerInterface_t *Peer)
 {
-    uint8 SendBuf[SBN_MAX_PACKED_MSG_SZ];
-
     SBN_DTN_Peer_t *PeerData = (SBN_DTN_Peer_t *)Peer->ModulePvt;
     SBN_DTN_Net_t * NetData  = (SBN_DTN_Net_t *)Peer->Net->ModulePvt;
+    SBN_DTN_Agg_t * Agg      = &Aggs[PeerData->BufNum];
+    SBN_Status_t    Status   = SBN_SUCCESS;
 
-    SBN_PackMsg(&SendBuf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), Payload);
-
-    CHKZERO(sdr_begin_xn(NetData->SendSDR));
+    if (Agg->Used == 0)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
 
-    Object Extent = sdr_malloc(NetData->SendSDR, sizeof(SendBuf));
-    if (!Extent)
+    if (NetData->Endpoint == NULL
+        || SBN_DTN_BpSend(NetData->Endpoint, PeerData->EID, NetData->TTL, Agg->Buf, Agg->Used) != SBN_SUCCESS)
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "unable to allocate extent");
-        return SBN_ERROR;
+        EVSSendErr(SBN_DTN_SOCK_EID, "unable to send bundle to %s (%d messages)", PeerData->EID, (int)Agg->MsgCnt);
+        Agg->TxErrCnt++;
+        Status = SBN_ERROR;
+    }
+    else
+    {
+        Agg->TxBundleCnt++;
+        Agg->TxMsgCnt += Agg->MsgCnt;
+        Agg->TxByteCnt += Agg->Used;
     } /* end if */
 
-    sdr_write(NetData->SendSDR, Extent, (char *)&SendBuf, sizeof(SendBuf));
+    Agg->Used   = 0;
+    Agg->MsgCnt = 0;
+
+    return Status;
+} /* end Flush() */
+
+/** true if the oldest message in the aggregate has waited long enough */
+static bool FlushDue(SBN_DTN_Net_t *NetData, SBN_DTN_Agg_t *Agg)
+{
+    OS_time_t CurrentTime;
+
+    OS_GetLocalTime(&CurrentTime);
+
+    return OS_TimeGetTotalMilliseconds(OS_TimeSubtract(CurrentTime, Agg->FirstQueued)) >= NetData->FlushMs;
+} /* end FlushDue() */
+
+/**
+ * DTN peers are always connected, and aggregates are flushed here once the
+ * oldest message has waited the net's "flush" time.
+ */
+static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_DTN_Peer_t *PeerData = (SBN_DTN_Peer_t *)Peer->ModulePvt;
+    SBN_DTN_Net_t * NetData  = (SBN_DTN_Net_t *)Peer->Net->ModulePvt;
+    SBN_DTN_Agg_t * Agg      = &Aggs[PeerData->BufNum];
+    SBN_Status_t    Status   = SBN_SUCCESS;
+
+    if (NetData->Endpoint == NULL)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
 
-    if (sdr_end_xn(NetData->SendSDR) < 0)
+    if (!Peer->Connected)
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "no space for ZCO extent");
-        return SBN_ERROR;
+        return SBN.Connected(Peer);
     } /* end if */
 
-    Object BundleZCO =
-        ionCreateZco(ZcoSdrSource, Extent, 0, sizeof(SendBuf), BP_STD_PRIORITY, 0, ZcoOutbound, &NetData->Attendant);
-    if (BundleZCO == 0 || BundleZCO == (Object)ERROR)
+    if (NetData->AggSz == 0 || Agg->Used == 0)
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "can't create ZCO extent");
-        return SBN_ERROR;
+        return SBN_SUCCESS;
     } /* end if */
 
-    Object NewBundle;
-    if (bp_send(NULL, PeerData->EIN, NULL, 300, BP_STD_PRIORITY, NoCustodyRequested, 0, 0, NULL, BundleZCO,
-                &NewBundle) < 1)
+    if (OS_MutSemTake(Agg->Mutex) != OS_SUCCESS)
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "bpsource can't send ADU");
         return SBN_ERROR;
     } /* end if */
 
-    return SBN_SUCCESS;
-} /* end SBN_DTN_Send */
+    if (Agg->Used && FlushDue(NetData, Agg))
+    {
+        Status = Flush(Peer);
+    } /* end if */
 
-/* Note that this Recv function is indescriminate, packets will be received
- * from all peers but that's ok, I just inject them into the SB and all is
- * good!
- */
-int SBN_DTN_Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr, SBN_CpuID_t *CpuIDPtr,
-                 void *Payload)
-{
-    uint8      RecvBuf[SBN_MAX_PACKED_MSG_SZ];
-    BpDelivery Delivery;
-    int        TimeoutSecs = 0;
+    OS_MutSemGive(Agg->Mutex);
 
-#ifdef SBN_RECV_TASK
-    /* task-based peer connections block on reads, otherwise use select */
-    TimeoutSecs = BP_BLOCKING;
-#endif /* SBN_RECV_TASK */
+    return Status;
+} /* end PollPeer() */
 
-    SBN_DTN_Net_t *NetData = (SBN_DTN_Net_t *)Net->ModulePvt;
+static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_DTN_Peer_t *PeerData = (SBN_DTN_Peer_t *)Peer->ModulePvt;
+    SBN_DTN_Net_t * NetData  = (SBN_DTN_Net_t *)Peer->Net->ModulePvt;
+    SBN_DTN_Agg_t * Agg      = &Aggs[PeerData->BufNum];
+    size_t          PackedSz = MsgSz + SBN_PACKED_HDR_SZ;
+    SBN_Status_t    Status   = SBN_SUCCESS;
 
-    if (bp_receive(NetData->SAP, &Delivery, TimeoutSecs) < 0)
+    if (OS_MutSemTake(Agg->Mutex) != OS_SUCCESS)
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "BP receive returned an error");
         return SBN_ERROR;
     } /* end if */
 
-    switch (Delivery.result)
+    if (PackedSz > NetData->AggSz)
     {
-        case BpReceptionTimedOut:
-            /* fall through */
-
-        case BpReceptionInterrupted:
-            /* fall through */
+        /* not aggregating, or too big to: send what is pending, then this on its own */
+        Status = Flush(Peer);
 
-        case BpEndpointStopped:
-            /* should return something to indicate the connection lost */
-            return SBN_IF_EMPTY;
+        SBN.PackMsg(Agg->Buf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Payload);
+        Agg->Used   = PackedSz;
+        Agg->MsgCnt = 1;
 
-        case BpPayloadPresent:
-            /* got a payload, break and continue processing */
-            break;
-
-        default:
-            return SBN_SUCCESS; /* ? */
+        if (Flush(Peer) != SBN_SUCCESS)
+        {
+            Status = SBN_ERROR;
+        } /* end if */
     }
+    else
+    {
+        if (Agg->Used + PackedSz > NetData->AggSz)
+        {
+            Status = Flush(Peer);
+        } /* end if */
+
+        if (Agg->Used == 0)
+        {
+            OS_GetLocalTime(&Agg->FirstQueued);
+        } /* end if */
+
+        SBN.PackMsg(Agg->Buf + Agg->Used, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(),
+                    Payload);
+        Agg->Used += PackedSz;
+        Agg->MsgCnt++;
+
+        /* full (no room for even an empty message) or overdue */
+        if (Agg->Used + SBN_PACKED_HDR_SZ > NetData->AggSz || FlushDue(NetData, Agg))
+        {
+            if (Flush(Peer) != SBN_SUCCESS)
+            {
+                Status = SBN_ERROR;
+            } /* end if */
+        }     /* end if */
+    }         /* end if */
+
+    OS_MutSemGive(Agg->Mutex);
+
+    return Status;
+} /* end Send() */
+
+/* Note that this Recv function is indescriminate, bundles are received
+ * from all peers, SBN finds the peer from the packed header.
+ */
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                         CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_DTN_Net_t *NetData = (SBN_DTN_Net_t *)Net->ModulePvt;
+    SBN_DTN_Rx_t * Rx      = &Rxs[NetData->BufNum];
+    bool           Block   = (Net->TaskFlags & SBN_TASK_RECV) != 0;
 
-    /* got a payload, process */
-
-    CHKZERO(sdr_begin_xn(NetData->RecvSDR));
-    int ContentLength = zco_source_data_length(NetData->RecvSDR, Delivery.adu);
-    sdr_exit_xn(NetData->RecvSDR);
-    if (ContentLength > sizeof(RecvBuf))
+    if (NetData->Endpoint == NULL)
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "Received message too large for buffer. (Bufsize=%d Msg=%d)",
-                          sizeof(RecvBuf), ContentLength);
-        return SBN_ERROR;
+        return SBN_IF_EMPTY;
     } /* end if */
 
-    ZcoReader Reader;
-    zco_start_receiving(Delivery.adu, &Reader);
-    CHKZERO(sdr_begin_xn(NetData->RecvSDR));
-    int Len = zco_receive_source(NetData->RecvSDR, &Reader, ContentLength, (char *)&RecvBuf);
-    if (sdr_end_xn(NetData->RecvSDR) < 0 || Len < 0)
+    while (1)
     {
-        CFE_EVS_SendEvent(SBN_DTN_SOCK_EID, CFE_EVS_ERROR, "Can't handle delivery.");
-        return SBN_ERROR;
-    } /* end if */
+        if (Rx->Consumed < Rx->Used)
+        {
+            uint8 *Msg    = Rx->Buf + Rx->Consumed;
+            size_t Remain = Rx->Used - Rx->Consumed;
+            int16  MsgSz  = 0;
+
+            if (Remain >= SBN_PACKED_HDR_SZ)
+            {
+                MsgSz = (int16)((Msg[0] << 8) | Msg[1]);
+            } /* end if */
+
+            if (Remain < SBN_PACKED_HDR_SZ || MsgSz < 0 || SBN_PACKED_HDR_SZ + (size_t)MsgSz > Remain)
+            {
+                EVSSendErr(SBN_DTN_SOCK_EID, "truncated message in bundle, dropping %d bytes", (int)Remain);
+                Rx->RxErrCnt++;
+                Rx->Consumed = Rx->Used;
+                continue;
+            } /* end if */
+
+            Rx->Consumed += SBN_PACKED_HDR_SZ + MsgSz;
+
+            if (!SBN.UnpackMsg(Msg, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload))
+            {
+                Rx->RxErrCnt++;
+                continue;
+            } /* end if */
+
+            Rx->RxMsgCnt++;
+
+            return SBN_SUCCESS;
+        } /* end if */
+
+        Rx->Used     = 0;
+        Rx->Consumed = 0;
+
+        switch (SBN_DTN_BpRecv(NetData->Endpoint, Rx->Buf, sizeof(Rx->Buf), &Rx->Used, Block))
+        {
+            case SBN_SUCCESS:
+                Rx->RxBundleCnt++;
+                break;
+
+            case SBN_IF_EMPTY:
+                return SBN_IF_EMPTY;
+
+            default:
+                EVSSendErr(SBN_DTN_SOCK_EID, "unable to receive bundle on %s", NetData->EID);
+                Rx->RxErrCnt++;
+                Rx->Used = 0;
+
+                if (Block)
+                {
+                    OS_TaskDelay(1000); /* don't spin the recv task on a failing agent */
+                } /* end if */
+
+                return SBN_IF_EMPTY;
+        } /* end switch */
+    }     /* end while */
+} /* end Recv() */
+
+static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_DTN_Peer_t *PeerData = (SBN_DTN_Peer_t *)Peer->ModulePvt;
+    SBN_DTN_Agg_t * Agg      = &Aggs[PeerData->BufNum];
 
-    SBN_UnpackMsg(&RecvBuf, MsgSzPtr, MsgTypePtr, CpuIDPtr, Payload);
+    OS_MutSemTake(Agg->Mutex);
+    Flush(Peer);
+    OS_MutSemGive(Agg->Mutex);
 
-    return SBN_SUCCESS;
-} /* end SBN_DTN_Recv */
+    OS_MutSemDelete(Agg->Mutex);
 
-int SBN_DTN_ReportModuleStatus(SBN_ModuleStatusPacket_t *Packet)
-{
-    return SBN_NOT_IMPLEMENTED;
-} /* end SBN_DTN_ReportModuleStatus */
+    if (Peer->Connected)
+    {
+        SBN.Disconnected(Peer);
+    } /* end if */
 
-int SBN_DTN_ResetPeer(SBN_PeerInterface_t *Peer)
-{
-    return SBN_NOT_IMPLEMENTED;
-} /* end SBN_DTN_ResetPeer */
+    return SBN_SUCCESS;
+} /* end UnloadPeer() */
 
-int SBN_DTN_UnloadNet(SBN_NetInterface_t *Net)
+static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
 {
     SBN_DTN_Net_t *NetData = (SBN_DTN_Net_t *)Net->ModulePvt;
 
-    ionStopAttendant(&NetData->Attendant);
-    bp_detach();
-
-    int PeerIdx = 0;
+    SBN_PeerIdx_t PeerIdx = 0;
     for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
     {
-        SBN_DTN_UnloadPeer(&Net->Peers[PeerIdx]);
+        UnloadPeer(&Net->Peers[PeerIdx]);
     } /* end for */
 
+    if (NetData->Endpoint != NULL)
+    {
+        SBN_DTN_BpClose(NetData->Endpoint);
+        NetData->Endpoint = NULL;
+    } /* end if */
+
+    /* the other nets' tables follow this one's, so they are only reused once all are unloaded */
+    if (LoadedNetCnt && --LoadedNetCnt == 0)
+    {
+        AggCnt = 0;
+        RxCnt  = 0;
+    } /* end if */
+
     return SBN_SUCCESS;
-} /* end SBN_DTN_ResetPeer */
+} /* end UnloadNet() */
 
-int SBN_DTN_UnloadPeer(SBN_PeerInterface_t *Peer)
+/**
+ * Reports, big-endian: uint32 AggSz, FlushMs, then uint32 TX bundles, TX
+ * messages, TX bytes, TX errors, bytes pending in the aggregate, then for the
+ * peer's net, uint32 RX bundles, RX messages and RX errors.
+ */
+static SBN_Status_t ReportModuleStatus(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz)
 {
+    SBN_DTN_Peer_t *PeerData = (SBN_DTN_Peer_t *)Peer->ModulePvt;
+    SBN_DTN_Net_t * NetData  = (SBN_DTN_Net_t *)Peer->Net->ModulePvt;
+    SBN_DTN_Agg_t * Agg      = &Aggs[PeerData->BufNum];
+    SBN_DTN_Rx_t *  Rx       = &Rxs[NetData->BufNum];
+    uint8 *         Ptr      = StatusBuf;
+
+    if (StatusBufSz < 10 * 4)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    Ptr = SBN_PutUInt32(Ptr, NetData->AggSz);
+    Ptr = SBN_PutUInt32(Ptr, NetData->FlushMs);
+    Ptr = SBN_PutUInt32(Ptr, Agg->TxBundleCnt);
+    Ptr = SBN_PutUInt32(Ptr, Agg->TxMsgCnt);
+    Ptr = SBN_PutUInt32(Ptr, Agg->TxByteCnt);
+    Ptr = SBN_PutUInt32(Ptr, Agg->TxErrCnt);
+    Ptr = SBN_PutUInt32(Ptr, Agg->Used);
+    Ptr = SBN_PutUInt32(Ptr, Rx->RxBundleCnt);
+    Ptr = SBN_PutUInt32(Ptr, Rx->RxMsgCnt);
+    Ptr = SBN_PutUInt32(Ptr, Rx->RxErrCnt);
+
     return SBN_SUCCESS;
-} /* end SBN_DTN_ResetPeer */
+} /* end ReportModuleStatus() */
+
+SBN_IfOps_t SBN_DTN_Ops = {Init, InitNet, InitPeer, LoadNet,   LoadPeer,   PollPeer,
+                           Send, NULL,    Recv,     UnloadNet, UnloadPeer, ReportModuleStatus};
@@ -1,50 +1,55 @@
 #ifndef _sbn_dtn_if_h_
 #define _sbn_dtn_if_h_
 
-#include "sbn_constants.h"
+#include "sbn_dtn_events.h"
+#include "sbn_dtn_platform_cfg.h"
+#include "sbn_dtn_bp.h"
+#include "sbn_platform_cfg.h"
+#include <string.h>
+
 #include "sbn_interfaces.h"
 #include "cfe.h"
 
-/* The version #'s this module works with. If this doesn't match the core
- * SBN application version #'s, this module should report and return an error.
- * Note: these DEFINITELY should be hardcoded here, do not map them to
- * the SBN version numbers.
+/**
+ * A bundle carries one or more packed SBN messages back to back; each packed
+ * header starts with the size of its payload, so the receiver walks the
+ * bundle message by message. Without aggregation every bundle carries one
+ * message and is exactly the size of that packed message.
  */
-#define SBN_DTN_MAJOR    1
-#define SBN_DTN_MINOR    11
-#define SBN_DTN_REVISION 0
-
-int SBN_DTN_Init(int Major, int Minor, int Revision);
-
-int SBN_DTN_LoadNet(SBN_NetInterface_t *Net, const char *Address);
-
-int SBN_DTN_LoadPeer(SBN_PeerInterface_t *Peer, const char *Address);
-
-int SBN_DTN_InitNet(SBN_NetInterface_t *NetInterface);
-
-int SBN_DTN_InitPeer(SBN_PeerInterface_t *PeerInterface);
+#define SBN_DTN_MAX_BUNDLE_SZ \
+    (SBN_DTN_MAX_AGG_SZ > SBN_MAX_PACKED_MSG_SZ ? SBN_DTN_MAX_AGG_SZ : SBN_MAX_PACKED_MSG_SZ)
 
-int SBN_DTN_PollPeer(SBN_PeerInterface_t *PeerInterface);
+typedef struct
+{
+    /** @brief The local endpoint ID, e.g. "ipn:1.1". */
+    char EID[SBN_DTN_MAX_EID_NAME];
 
-int SBN_DTN_Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload);
+    /** @brief The open endpoint, NULL until the net is initialized. */
+    SBN_DTN_Endpoint_t *Endpoint;
 
-int SBN_DTN_Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr, SBN_CpuID_t *CpuIDPtr,
-                 void *PayloadBuffer);
+    /**
+     * @brief Largest aggregate bundle, from the "agg" net address option; 0
+     * (the default) sends one bundle per message.
+     */
+    uint32 AggSz;
 
-int SBN_DTN_ReportModuleStatus(SBN_ModuleStatusPacket_t *Packet);
+    /** @brief Longest a message waits in an aggregate, from the "flush" option (ms.) */
+    uint32 FlushMs;
 
-int SBN_DTN_ResetPeer(SBN_PeerInterface_t *PeerInterface);
+    /** @brief Bundle lifetime, from the "ttl" option (s.) */
+    uint32 TTL;
 
-int SBN_DTN_UnloadNet(SBN_NetInterface_t *NetInterface);
+    /** @brief Index into the module's receive buffers. */
+    uint8 BufNum;
+} SBN_DTN_Net_t;
 
-int SBN_DTN_UnloadPeer(SBN_PeerInterface_t *PeerInterface);
+typedef struct
+{
+    /** @brief The peer's endpoint ID. */
+    char EID[SBN_DTN_MAX_EID_NAME];
 
-SBN_IfOps_t SBN_DTN_Ops = {SBN_DTN_Init,      SBN_DTN_LoadNet,
-                           SBN_DTN_LoadPeer,  SBN_DTN_InitNet,
-                           SBN_DTN_InitPeer,  SBN_DTN_PollPeer,
-                           SBN_DTN_Send,      NULL,
-                           SBN_DTN_Recv,      SBN_DTN_ReportModuleStatus,
-                           SBN_DTN_ResetPeer, SBN_DTN_UnloadNet,
-                           SBN_DTN_UnloadPeer};
+    /** @brief Index into the module's aggregation buffers. */
+    uint8 BufNum;
+} SBN_DTN_Peer_t;
 
 #endif /* _sbn_dtn_if_h_ */
@@ -0,0 +1,445 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_dtn_if.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN DTN protocol module
+**
+** Notes:
+** The module is linked against a local stand-in for the BP operations in
+** sbn_dtn_bp.h, which queues bundles in memory by destination EID.
+*/
+
+#include "sbn_dtn_coveragetest_common.h"
+#include "sbn_dtn_if.h"
+
+#define SBN_PROTOCOL_VERSION 6
+
+#define EID_A "ipn:1.1"
+#define EID_B "ipn:2.1"
+
+extern SBN_IfOps_t SBN_DTN_Ops;
+
+/*
+ * BP stand-in
+ */
+struct SBN_DTN_Endpoint_s
+{
+    char EID[SBN_DTN_MAX_EID_NAME];
+};
+
+#define BUNDLE_QUEUE_DEPTH 32
+
+typedef struct
+{
+    char   DestEID[SBN_DTN_MAX_EID_NAME];
+    uint8  Data[SBN_DTN_MAX_BUNDLE_SZ];
+    size_t Sz;
+} Bundle_t;
+
+static SBN_DTN_Endpoint_t Endpoints[SBN_DTN_MAX_NETS];
+static int                EndpointCnt = 0;
+static Bundle_t           Bundles[BUNDLE_QUEUE_DEPTH];
+static int                BundleCnt = 0, BundlesSent = 0;
+static bool               SendFails = false;
+
+SBN_Status_t SBN_DTN_BpOpen(const char *EID, SBN_DTN_Endpoint_t **EndpointPtr)
+{
+    if (EndpointCnt >= SBN_DTN_MAX_NETS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    strncpy(Endpoints[EndpointCnt].EID, EID, sizeof(Endpoints[0].EID) - 1);
+    *EndpointPtr = &Endpoints[EndpointCnt++];
+
+    return SBN_SUCCESS;
+} /* end SBN_DTN_BpOpen() */
+
+static void QueueBundle(const char *DestEID, const uint8 *Buf, size_t BufSz)
+{
+    UtAssert_True(BundleCnt < BUNDLE_QUEUE_DEPTH, "bundle queue not full");
+
+    strncpy(Bundles[BundleCnt].DestEID, DestEID, sizeof(Bundles[0].DestEID) - 1);
+    memcpy(Bundles[BundleCnt].Data, Buf, BufSz);
+    Bundles[BundleCnt++].Sz = BufSz;
+} /* end QueueBundle() */
+
+SBN_Status_t SBN_DTN_BpSend(SBN_DTN_Endpoint_t *Endpoint, const char *DestEID, uint32 TTL, const uint8 *Buf,
+                            size_t BufSz)
+{
+    if (SendFails)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    QueueBundle(DestEID, Buf, BufSz);
+    BundlesSent++;
+
+    return SBN_SUCCESS;
+} /* end SBN_DTN_BpSend() */
+
+SBN_Status_t SBN_DTN_BpRecv(SBN_DTN_Endpoint_t *Endpoint, uint8 *Buf, size_t BufSz, size_t *RecvSzPtr, bool Block)
+{
+    int i = 0;
+
+    for (i = 0; i < BundleCnt; i++)
+    {
+        if (strcmp(Bundles[i].DestEID, Endpoint->EID) == 0)
+        {
+            if (Bundles[i].Sz > BufSz)
+            {
+                return SBN_ERROR;
+            } /* end if */
+
+            memcpy(Buf, Bundles[i].Data, Bundles[i].Sz);
+            *RecvSzPtr = Bundles[i].Sz;
+
+            memmove(&Bundles[i], &Bundles[i + 1], (BundleCnt - i - 1) * sizeof(Bundles[0]));
+            BundleCnt--;
+
+            return SBN_SUCCESS;
+        } /* end if */
+    }     /* end for */
+
+    return SBN_IF_EMPTY;
+} /* end SBN_DTN_BpRecv() */
+
+void SBN_DTN_BpClose(SBN_DTN_Endpoint_t *Endpoint) {}
+
+/*
+ * test-local outlet, packing the same header layout as SBN
+ */
+static int ConnectedCnt = 0;
+
+static void PackMsg(void *SBNBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_ProcessorID_t ProcessorID,
+                    CFE_SpacecraftID_t SpacecraftID, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    Buf[0]  = MsgSz >> 8;
+    Buf[1]  = MsgSz & 0xFF;
+    Buf[2]  = MsgType;
+    Buf[3]  = (ProcessorID >> 24) & 0xFF;
+    Buf[4]  = (ProcessorID >> 16) & 0xFF;
+    Buf[5]  = (ProcessorID >> 8) & 0xFF;
+    Buf[6]  = ProcessorID & 0xFF;
+    Buf[7]  = (SpacecraftID >> 24) & 0xFF;
+    Buf[8]  = (SpacecraftID >> 16) & 0xFF;
+    Buf[9]  = (SpacecraftID >> 8) & 0xFF;
+    Buf[10] = SpacecraftID & 0xFF;
+
+    if (MsgSz)
+    {
+        memcpy(Buf + SBN_PACKED_HDR_SZ, Msg, MsgSz);
+    } /* end if */
+} /* end PackMsg() */
+
+static bool UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePtr,
+                      CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    *MsgSzPtr        = (Buf[0] << 8) | Buf[1];
+    *MsgTypePtr      = Buf[2];
+    *ProcessorIDPtr  = ((uint32)Buf[3] << 24) | (Buf[4] << 16) | (Buf[5] << 8) | Buf[6];
+    *SpacecraftIDPtr = ((uint32)Buf[7] << 24) | (Buf[8] << 16) | (Buf[9] << 8) | Buf[10];
+
+    memcpy(Msg, Buf + SBN_PACKED_HDR_SZ, *MsgSzPtr);
+
+    return true;
+} /* end UnpackMsg() */
+
+static SBN_Status_t Connected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = true;
+    ConnectedCnt++;
+    return SBN_SUCCESS;
+} /* end Connected() */
+
+static SBN_Status_t Disconnected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = false;
+    return SBN_SUCCESS;
+} /* end Disconnected() */
+
+static SBN_ProtocolOutlet_t Outlet = {PackMsg, UnpackMsg, Connected, Disconnected, NULL, NULL};
+
+static SBN_NetInterface_t   NetA, NetB;
+static SBN_PeerInterface_t *PeerA = &NetA.Peers[0], *PeerB = &NetB.Peers[0];
+
+static uint8  Payload[1024], RecvPayload[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+static uint32 Status[10];
+
+/* reads the module status of a peer into Status[] */
+static void GetStatus(SBN_PeerInterface_t *Peer)
+{
+    uint8 Buf[64], *Ptr = Buf;
+    int   i             = 0;
+
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.ReportModuleStatus(Peer, Buf, sizeof(Buf)), SBN_SUCCESS);
+
+    for (i = 0; i < 10; i++, Ptr += 4)
+    {
+        Status[i] = ((uint32)Ptr[0] << 24) | (Ptr[1] << 16) | (Ptr[2] << 8) | Ptr[3];
+    } /* end for */
+} /* end GetStatus() */
+
+static SBN_Status_t RecvB(SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr)
+{
+    CFE_ProcessorID_t  ProcessorID  = 0;
+    CFE_SpacecraftID_t SpacecraftID = 0;
+
+    return SBN_DTN_Ops.RecvFromNet(&NetB, MsgTypePtr, MsgSzPtr, &ProcessorID, &SpacecraftID, RecvPayload);
+} /* end RecvB() */
+
+/* net A (sending, with the given address options) and net B, one peer each pointing at the other */
+static void START(const char *AddrA)
+{
+    size_t i = 0;
+
+    UT_ResetState(0);
+
+    memset(&NetA, 0, sizeof(NetA));
+    memset(&NetB, 0, sizeof(NetB));
+    memset(Endpoints, 0, sizeof(Endpoints));
+    EndpointCnt  = 0;
+    BundleCnt    = 0;
+    BundlesSent  = 0;
+    SendFails    = false;
+    ConnectedCnt = 0;
+
+    for (i = 0; i < sizeof(Payload); i++)
+    {
+        Payload[i] = i & 0xFF;
+    } /* end for */
+
+    NetA.PeerCnt = NetB.PeerCnt = 1;
+    PeerA->Net                  = &NetA;
+    PeerB->Net                  = &NetB;
+
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetA, AddrA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetB, EID_B), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadPeer(PeerA, EID_B), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadPeer(PeerB, EID_A), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.InitNet(&NetA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.InitNet(&NetB), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.InitPeer(PeerA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.InitPeer(PeerB), SBN_SUCCESS);
+} /* end START() */
+
+static void STOP(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.UnloadNet(&NetB), SBN_SUCCESS);
+} /* end STOP() */
+
+void Test_SBN_DTN_Init(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.InitModule(-1, 0, &Outlet), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, NULL), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+} /* end Test_SBN_DTN_Init() */
+
+void Test_SBN_DTN_LoadNet(void)
+{
+    SBN_DTN_Net_t *NetData = (SBN_DTN_Net_t *)NetA.ModulePvt;
+
+    memset(&NetA, 0, sizeof(NetA));
+
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetA, ""), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetA, "ipn:1.1?agg"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetA, "ipn:1.1?agg=x"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetA, "ipn:1.1?agg=5"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetA, "ipn:1.1?agg=999999"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetA, "ipn:1.1?ttl=0"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetA, "ipn:1.1?foo=1"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadNet(&NetA, "ipn:1.1?agg=4096&flush=250&ttl=60"), SBN_SUCCESS);
+
+    UtAssert_True(strcmp(NetData->EID, "ipn:1.1") == 0, "EID");
+    UtAssert_True(NetData->AggSz == 4096 && NetData->FlushMs == 250 && NetData->TTL == 60, "options");
+
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.LoadPeer(PeerA, ""), SBN_ERROR);
+
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+} /* end Test_SBN_DTN_LoadNet() */
+
+void Test_SBN_DTN_RightSized(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+
+    START(EID_A);
+
+    /* always connected */
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.PollPeer(PeerA), SBN_SUCCESS);
+    UtAssert_True(PeerA->Connected && ConnectedCnt == 1, "connected on poll");
+
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.Send(PeerA, SBN_APP_MSG, 16, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.Send(PeerA, SBN_APP_MSG, 0, NULL), SBN_SUCCESS);
+
+    UtAssert_True(BundlesSent == 2, "one bundle per message (%d)", BundlesSent);
+    UtAssert_True(Bundles[0].Sz == 16 + SBN_PACKED_HDR_SZ, "bundle sized to the packed message (%d)",
+                  (int)Bundles[0].Sz);
+    UtAssert_True(Bundles[1].Sz == SBN_PACKED_HDR_SZ, "empty message bundle (%d)", (int)Bundles[1].Sz);
+    UtAssert_True(strcmp(Bundles[0].DestEID, EID_B) == 0, "sent to the peer's EID");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_APP_MSG && MsgSz == 16 && memcmp(RecvPayload, Payload, 16) == 0, "message intact");
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 0, "empty message");
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+
+    GetStatus(PeerA);
+    UtAssert_True(Status[0] == 0 && Status[2] == 2 && Status[3] == 2, "TxBundleCnt=%d TxMsgCnt=%d", (int)Status[2],
+                  (int)Status[3]);
+    UtAssert_True(Status[4] == 16 + 2 * SBN_PACKED_HDR_SZ, "TxByteCnt=%d", (int)Status[4]);
+    GetStatus(PeerB);
+    UtAssert_True(Status[7] == 2 && Status[8] == 2 && Status[9] == 0, "RxBundleCnt=%d RxMsgCnt=%d", (int)Status[7],
+                  (int)Status[8]);
+
+    STOP();
+} /* end Test_SBN_DTN_RightSized() */
+
+void Test_SBN_DTN_Aggregate(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+    int           i       = 0;
+
+    /* room for exactly ten 40-byte messages */
+    START(EID_A "?agg=510&flush=100000");
+
+    for (i = 0; i < 10; i++)
+    {
+        UT_TEST_FUNCTION_RC(SBN_DTN_Ops.Send(PeerA, SBN_APP_MSG, 40, Payload + i), SBN_SUCCESS);
+        UtAssert_True(BundlesSent == (i == 9 ? 1 : 0), "bundles sent after %d messages (%d)", i + 1, BundlesSent);
+    } /* end for */
+
+    UtAssert_True(Bundles[0].Sz == 510, "aggregate size (%d)", (int)Bundles[0].Sz);
+
+    for (i = 0; i < 10; i++)
+    {
+        UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+        UtAssert_True(MsgSz == 40 && memcmp(RecvPayload, Payload + i, 40) == 0, "message %d intact", i);
+    } /* end for */
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+
+    /* one that would overflow flushes the aggregate first */
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.Send(PeerA, SBN_APP_MSG, 400, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.Send(PeerA, SBN_APP_MSG, 400, Payload), SBN_SUCCESS);
+    UtAssert_True(BundlesSent == 2 && Bundles[0].Sz == 411, "overflow flush (%d)", BundlesSent);
+
+    /* one too big to aggregate is sent alone, after what is pending */
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.Send(PeerA, SBN_APP_MSG, 600, Payload), SBN_SUCCESS);
+    UtAssert_True(BundlesSent == 4 && Bundles[1].Sz == 411 && Bundles[2].Sz == 611, "large message alone (%d)",
+                  BundlesSent);
+
+    GetStatus(PeerA);
+    UtAssert_True(Status[0] == 510 && Status[2] == 4 && Status[3] == 13 && Status[6] == 0,
+                  "TxBundleCnt=%d TxMsgCnt=%d pending=%d", (int)Status[2], (int)Status[3], (int)Status[6]);
+
+    STOP();
+} /* end Test_SBN_DTN_Aggregate() */
+
+void Test_SBN_DTN_FlushTime(void)
+{
+    int i = 0;
+
+    START(EID_A "?agg=4096&flush=50");
+
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.PollPeer(PeerA), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.Send(PeerA, SBN_APP_MSG, 40, Payload), SBN_SUCCESS);
+    UtAssert_True(BundlesSent == 0, "queued");
+
+    GetStatus(PeerA);
+    UtAssert_True(Status[6] == 40 + SBN_PACKED_HDR_SZ, "pending=%d", (int)Status[6]);
+
+    /* the stubbed clock advances on every read */
+    for (i = 0; i < 1000 && BundlesSent == 0; i++)
+    {
+        UT_TEST_FUNCTION_RC(SBN_DTN_Ops.PollPeer(PeerA), SBN_SUCCESS);
+    } /* end for */
+
+    UtAssert_True(BundlesSent == 1 && Bundles[0].Sz == 40 + SBN_PACKED_HDR_SZ, "flushed on poll");
+
+    /* pending messages are flushed on unload */
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.Send(PeerA, SBN_APP_MSG, 40, Payload), SBN_SUCCESS);
+    STOP();
+    UtAssert_True(BundlesSent == 2, "flushed on unload");
+} /* end Test_SBN_DTN_FlushTime() */
+
+void Test_SBN_DTN_Errors(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+    uint8         Bad[64];
+
+    START(EID_A);
+
+    SendFails = true;
+    UT_TEST_FUNCTION_RC(SBN_DTN_Ops.Send(PeerA, SBN_APP_MSG, 16, Payload), SBN_ERROR);
+    SendFails = false;
+
+    GetStatus(PeerA);
+    UtAssert_True(Status[2] == 0 && Status[5] == 1, "TxErrCnt=%d", (int)Status[5]);
+
+    /* a good message followed by one claiming more bytes than the bundle has */
+    PackMsg(Bad, 8, SBN_APP_MSG, 1, 2, Payload);
+    PackMsg(Bad + 8 + SBN_PACKED_HDR_SZ, 40, SBN_APP_MSG, 1, 2, Payload);
+    QueueBundle(EID_B, Bad, sizeof(Bad));
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 8, "first message");
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+
+    GetStatus(PeerB);
+    UtAssert_True(Status[7] == 1 && Status[8] == 1 && Status[9] == 1, "RxErrCnt=%d", (int)Status[9]);
+
+    STOP();
+} /* end Test_SBN_DTN_Errors() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_DTN_Init);
+    ADD_TEST(SBN_DTN_LoadNet);
+    ADD_TEST(SBN_DTN_RightSized);
+    ADD_TEST(SBN_DTN_Aggregate);
+    ADD_TEST(SBN_DTN_FlushTime);
+    ADD_TEST(SBN_DTN_Errors);
+}
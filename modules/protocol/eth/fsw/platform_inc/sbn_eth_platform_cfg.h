@@ -0,0 +1,45 @@
+/**
+ * @file
+ *
+ * This file contains several user-configurable parameters
+ */
+#ifndef _eth_platform_cfg_h_
+#define _eth_platform_cfg_h_
+
+#define SBN_ETH_MAX_NETS 2 /**< How many interfaces this module can drive */
+
+/**
+ * Default for the "ethertype" net address option, the IEEE 802 local
+ * experimental EtherType.
+ */
+#define SBN_ETH_DEFAULT_ETHERTYPE 0x88B5
+
+/**
+ * Size of each block of the RX and TX rings, a multiple of the page size;
+ * the RX ring hands the module a block of frames at a time.
+ */
+#define SBN_ETH_BLOCK_SZ (1 << 16)
+
+#define SBN_ETH_RX_BLOCK_CNT 16 /**< RX ring blocks per net */
+#define SBN_ETH_TX_BLOCK_CNT 4  /**< TX ring blocks per net */
+
+/**
+ * Size of each TX ring slot, holding the ring's frame header and one
+ * Ethernet frame; messages larger than the interface MTU are not sent.
+ */
+#define SBN_ETH_TX_FRAME_SZ 16384
+
+/**
+ * Default for the "rxtmo" net address option, how many ms the kernel may
+ * hold a partly filled RX block before handing it over.
+ */
+#define SBN_ETH_DEFAULT_RX_TMO 2
+
+/**
+ * Default for the "txbatch" net address option, how many frames are queued
+ * in the TX ring before the kernel is told to send them; queued frames are
+ * also sent each time a peer is polled.
+ */
+#define SBN_ETH_DEFAULT_TX_BATCH 1
+
+#endif
@@ -0,0 +1,673 @@
+#include "sbn_eth_if.h"
+#include "sbn_module_util.h"
+
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+CFE_EVS_EventID_t SBN_ETH_FIRST_EID;
+
+#define EXP_VERSION 6
+
+/* where a TX slot's frame starts, after the slot's header */
+#define SBN_ETH_TX_DATA_OFF TPACKET_ALIGN(sizeof(struct tpacket3_hdr))
+
+#define SBN_ETH_RX_RING_SZ ((size_t)SBN_ETH_BLOCK_SZ * SBN_ETH_RX_BLOCK_CNT)
+#define SBN_ETH_TX_RING_SZ ((size_t)SBN_ETH_BLOCK_SZ * SBN_ETH_TX_BLOCK_CNT)
+
+#define SBN_ETH_TX_FRAME_CNT (SBN_ETH_TX_RING_SZ / SBN_ETH_TX_FRAME_SZ)
+
+static SBN_ProtocolOutlet_t SBN;
+
+/* per-net ring state, too big for the net's ModulePvt */
+typedef struct
+{
+    /** @brief The RX ring, followed by the TX ring, mapped from the socket. */
+    uint8 *Ring;
+
+    /** @brief The RX block being read, and the next of its RxPktsLeft frames. */
+    uint32 RxBlock, RxPktsLeft;
+    uint8 *RxPkt;
+
+    /** @brief The next free TX slot, and how many frames are queued but not yet sent. */
+    uint32 TxFrame, TxPending;
+
+    /** @brief Peer send tasks share the TX ring. */
+    OS_MutexID_t Mutex;
+
+    uint32 TxFrameCnt, TxKickCnt, TxRingFullCnt, TxTooBigCnt, RxFrameCnt, RxBlockCnt, RxErrCnt, RxDropCnt;
+} SBN_ETH_Ring_t;
+
+static SBN_ETH_Ring_t Rings[SBN_ETH_MAX_NETS];
+static uint8          NetCnt       = 0;
+static uint8          LoadedNetCnt = 0;
+
+static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID, SBN_ProtocolOutlet_t *Outlet)
+{
+    SBN_ETH_FIRST_EID = BaseEID;
+
+    if (Version != EXP_VERSION)
+    {
+        OS_printf("SBN_ETH version mismatch: expected %d, got %d\n", EXP_VERSION, Version);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Outlet == NULL)
+    {
+        OS_printf("SBN_ETH outlet is NULL\n");
+        return SBN_ERROR;
+    } /* end if */
+
+    /* copy outlet pointers to a local buffer for later use */
+    memcpy(&SBN, Outlet, sizeof(SBN));
+
+    OS_printf("SBN_ETH Lib Initialized.\n");
+    return SBN_SUCCESS;
+} /* end Init() */
+
+static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
+{
+    SBN_ETH_Net_t *NetData = (SBN_ETH_Net_t *)Net->ModulePvt;
+    const char *   Opt     = strchr(Address, '?');
+    size_t         NameLen = strcspn(Address, "?");
+
+    EVSSendInfo(SBN_ETH_CONFIG_EID, "configuring net (Address=%s)", Address);
+
+    if (NetCnt >= SBN_ETH_MAX_NETS)
+    {
+        EVSSendErr(SBN_ETH_CONFIG_EID, "too many Ethernet nets (max=%d)", SBN_ETH_MAX_NETS);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (NameLen == 0 || NameLen >= IFNAMSIZ)
+    {
+        EVSSendErr(SBN_ETH_CONFIG_EID, "invalid interface name (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(NetData->IfName, 0, sizeof(NetData->IfName));
+    strncpy(NetData->IfName, Address, NameLen);
+
+    NetData->EtherType = SBN_ETH_DEFAULT_ETHERTYPE;
+    NetData->RxTmo     = SBN_ETH_DEFAULT_RX_TMO;
+    NetData->TxBatch   = SBN_ETH_DEFAULT_TX_BATCH;
+
+    while (Opt != NULL)
+    {
+        Opt++; /* skip the '?' or '&' */
+
+        const char *Eq          = strchr(Opt, '=');
+        char *      ValidatePtr = NULL;
+        size_t      Len         = Eq ? (size_t)(Eq - Opt) : 0;
+
+        unsigned long Val = Eq ? strtoul(Eq + 1, &ValidatePtr, 0) : 0;
+
+        if (!Eq || ValidatePtr == Eq + 1 || (*ValidatePtr != '\0' && *ValidatePtr != '&'))
+        {
+            EVSSendErr(SBN_ETH_CONFIG_EID, "invalid option (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        /* EtherTypes start at 0x0600, lower values are 802.3 lengths */
+        if (SBN_OPT_IS(Opt, Len, "ethertype") && Val >= 0x0600 && Val <= 0xFFFF)
+        {
+            NetData->EtherType = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "rxtmo") && Val >= 1 && Val <= 1000)
+        {
+            NetData->RxTmo = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "txbatch") && Val >= 1 && Val <= SBN_ETH_TX_FRAME_CNT)
+        {
+            NetData->TxBatch = Val;
+        }
+        else
+        {
+            EVSSendErr(SBN_ETH_CONFIG_EID, "unknown option or value out of range (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        Opt = strchr(Opt, '&');
+    } /* end while */
+
+    NetData->FD     = -1;
+    NetData->BufNum = NetCnt++;
+    LoadedNetCnt++;
+
+    return SBN_SUCCESS;
+} /* end LoadNet() */
+
+static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
+{
+    SBN_ETH_Peer_t *PeerData = (SBN_ETH_Peer_t *)Peer->ModulePvt;
+    int             Len      = 0;
+
+    EVSSendInfo(SBN_ETH_CONFIG_EID, "configuring peer (SC=%d, CPU=%d, Address=%s)", Peer->SpacecraftID,
+                Peer->ProcessorID, Address);
+
+    if (sscanf(Address, "%2hhx:%2hhx:%2hhx:%2hhx:%2hhx:%2hhx%n", &PeerData->MAC[0], &PeerData->MAC[1],
+               &PeerData->MAC[2], &PeerData->MAC[3], &PeerData->MAC[4], &PeerData->MAC[5], &Len)
+            != ETH_ALEN
+        || Address[Len] != '\0')
+    {
+        EVSSendErr(SBN_ETH_CONFIG_EID, "invalid MAC address (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end LoadPeer() */
+
+/**
+ * Reads the interface, maps the RX and TX rings and binds the socket; the
+ * caller closes the socket on failure.
+ */
+static SBN_Status_t OpenRings(SBN_ETH_Net_t *NetData, SBN_ETH_Ring_t *Ring)
+{
+    struct ifreq        Req;
+    struct tpacket_req3 RingReq;
+    struct sockaddr_ll  Addr;
+    int                 Version = TPACKET_V3;
+
+    memset(&Req, 0, sizeof(Req));
+    strncpy(Req.ifr_name, NetData->IfName, sizeof(Req.ifr_name) - 1);
+
+    if (ioctl(NetData->FD, SIOCGIFINDEX, &Req) < 0)
+    {
+        EVSSendErr(SBN_ETH_SOCK_EID, "no interface %s (errno=%d)", NetData->IfName, errno);
+        return SBN_ERROR;
+    } /* end if */
+    NetData->IfIndex = Req.ifr_ifindex;
+
+    if (ioctl(NetData->FD, SIOCGIFHWADDR, &Req) < 0)
+    {
+        EVSSendErr(SBN_ETH_SOCK_EID, "unable to read MAC of %s (errno=%d)", NetData->IfName, errno);
+        return SBN_ERROR;
+    } /* end if */
+    memcpy(NetData->MAC, Req.ifr_hwaddr.sa_data, ETH_ALEN);
+
+    if (ioctl(NetData->FD, SIOCGIFMTU, &Req) < 0)
+    {
+        EVSSendErr(SBN_ETH_SOCK_EID, "unable to read MTU of %s (errno=%d)", NetData->IfName, errno);
+        return SBN_ERROR;
+    } /* end if */
+    NetData->MTU = Req.ifr_mtu;
+
+    /* a frame must fit in a TX slot */
+    if (NetData->MTU > SBN_ETH_TX_FRAME_SZ - SBN_ETH_TX_DATA_OFF - ETH_HLEN)
+    {
+        NetData->MTU = SBN_ETH_TX_FRAME_SZ - SBN_ETH_TX_DATA_OFF - ETH_HLEN;
+    } /* end if */
+
+    if (setsockopt(NetData->FD, SOL_PACKET, PACKET_VERSION, &Version, sizeof(Version)) < 0)
+    {
+        EVSSendErr(SBN_ETH_SOCK_EID, "TPACKET_V3 not supported (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(&RingReq, 0, sizeof(RingReq));
+    RingReq.tp_block_size       = SBN_ETH_BLOCK_SZ;
+    RingReq.tp_frame_size       = SBN_ETH_TX_FRAME_SZ;
+    RingReq.tp_block_nr         = SBN_ETH_RX_BLOCK_CNT;
+    RingReq.tp_frame_nr         = SBN_ETH_RX_RING_SZ / SBN_ETH_TX_FRAME_SZ;
+    RingReq.tp_retire_blk_tov   = NetData->RxTmo;
+    RingReq.tp_feature_req_word = 0;
+
+    if (setsockopt(NetData->FD, SOL_PACKET, PACKET_RX_RING, &RingReq, sizeof(RingReq)) < 0)
+    {
+        EVSSendErr(SBN_ETH_SOCK_EID, "unable to create RX ring (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    /* the TX ring takes fixed size slots and no block timeout */
+    RingReq.tp_block_nr       = SBN_ETH_TX_BLOCK_CNT;
+    RingReq.tp_frame_nr       = SBN_ETH_TX_FRAME_CNT;
+    RingReq.tp_retire_blk_tov = 0;
+
+    if (setsockopt(NetData->FD, SOL_PACKET, PACKET_TX_RING, &RingReq, sizeof(RingReq)) < 0)
+    {
+        EVSSendErr(SBN_ETH_SOCK_EID, "unable to create TX ring (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    Ring->Ring = mmap(NULL, SBN_ETH_RX_RING_SZ + SBN_ETH_TX_RING_SZ, PROT_READ | PROT_WRITE, MAP_SHARED, NetData->FD,
+                      0);
+    if (Ring->Ring == MAP_FAILED)
+    {
+        Ring->Ring = NULL;
+        EVSSendErr(SBN_ETH_SOCK_EID, "unable to map rings (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(&Addr, 0, sizeof(Addr));
+    Addr.sll_family   = AF_PACKET;
+    Addr.sll_protocol = htons(NetData->EtherType);
+    Addr.sll_ifindex  = NetData->IfIndex;
+
+    if (bind(NetData->FD, (struct sockaddr *)&Addr, sizeof(Addr)) < 0)
+    {
+        EVSSendErr(SBN_ETH_SOCK_EID, "bind to %s failed (errno=%d)", NetData->IfName, errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end OpenRings() */
+
+/**
+ * Opens the packet socket on the interface and maps its RX and TX rings.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS on success, error code otherwise
+ */
+static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
+{
+    SBN_ETH_Net_t * NetData = (SBN_ETH_Net_t *)Net->ModulePvt;
+    SBN_ETH_Ring_t *Ring    = &Rings[NetData->BufNum];
+    char            Name[OS_MAX_API_NAME];
+
+    memset(Ring, 0, sizeof(*Ring));
+
+    snprintf(Name, sizeof(Name), "sbn_eth_mtx_%d", NetData->BufNum);
+    if (OS_MutSemCreate(&Ring->Mutex, Name, 0) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_ETH_CONFIG_EID, "unable to create mutex for %s", NetData->IfName);
+        return SBN_ERROR;
+    } /* end if */
+
+    NetData->FD = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, htons(NetData->EtherType));
+    if (NetData->FD < 0)
+    {
+        EVSSendErr(SBN_ETH_SOCK_EID, "socket call failed (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (OpenRings(NetData, Ring) != SBN_SUCCESS)
+    {
+        if (Ring->Ring)
+        {
+            munmap(Ring->Ring, SBN_ETH_RX_RING_SZ + SBN_ETH_TX_RING_SZ);
+            Ring->Ring = NULL;
+        } /* end if */
+
+        close(NetData->FD);
+        NetData->FD = -1;
+
+        return SBN_ERROR;
+    } /* end if */
+
+    EVSSendInfo(SBN_ETH_SOCK_EID, "%s up (MAC=%02x:%02x:%02x:%02x:%02x:%02x, MTU=%d, EtherType=0x%04x)",
+                NetData->IfName, NetData->MAC[0], NetData->MAC[1], NetData->MAC[2], NetData->MAC[3],
+                NetData->MAC[4], NetData->MAC[5], (int)NetData->MTU, NetData->EtherType);
+
+    return SBN_SUCCESS;
+} /* end InitNet() */
+
+/**
+ * Ethernet is connectionless, peers are connected when heard from.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS
+ */
+static SBN_Status_t InitPeer(SBN_PeerInterface_t *Peer)
+{
+    return SBN_SUCCESS;
+} /* end InitPeer() */
+
+/** has the kernel send the frames queued in the TX ring, the caller holds the mutex */
+static void Kick(SBN_ETH_Net_t *NetData, SBN_ETH_Ring_t *Ring)
+{
+    if (!Ring->TxPending)
+    {
+        return;
+    } /* end if */
+
+    /* one call sends every frame marked for sending */
+    if (send(NetData->FD, NULL, 0, MSG_DONTWAIT) < 0 && errno != EAGAIN && errno != ENOBUFS)
+    {
+        EVSSendErr(SBN_ETH_SOCK_EID, "send on %s failed (errno=%d)", NetData->IfName, errno);
+    } /* end if */
+
+    Ring->TxPending = 0;
+    Ring->TxKickCnt++;
+} /* end Kick() */
+
+static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_ETH_Net_t * NetData = (SBN_ETH_Net_t *)Peer->Net->ModulePvt;
+    SBN_ETH_Ring_t *Ring    = &Rings[NetData->BufNum];
+    SBN_Status_t    Status  = SBN_SUCCESS;
+    OS_time_t       CurrentTime;
+
+    OS_GetLocalTime(&CurrentTime);
+
+    if (Peer->Connected)
+    {
+        if (OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastRecv)) > SBN_ETH_PEER_TIMEOUT)
+        {
+            EVSSendInfo(SBN_ETH_DEBUG_EID, "disconnected peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+
+            SBN.Disconnected(Peer);
+        }
+        else if (OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_ETH_PEER_HEARTBEAT)
+        {
+            OS_GetLocalTime(&Peer->LastSend);
+            EVSSendDbg(SBN_ETH_DEBUG_EID, "sending heartbeat to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+            Status = SBN.SendNetMsg(SBN_ETH_HEARTBEAT_MSG, 0, NULL, Peer);
+        } /* end if */
+    }
+    else
+    {
+        if (OS_TimeGetTotalSeconds(Peer->LastSend) == 0
+            || OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_ETH_ANNOUNCE_TIMEOUT)
+        {
+            OS_GetLocalTime(&Peer->LastSend);
+            EVSSendInfo(SBN_ETH_DEBUG_EID, "announce to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+            Status = SBN.SendNetMsg(SBN_ETH_ANNOUNCE_MSG, 0, NULL, Peer);
+        } /* end if */
+    }     /* end if */
+
+    /* frames queued for a batch go out at least once per wakeup */
+    if (Ring->TxPending && OS_MutSemTake(Ring->Mutex) == OS_SUCCESS)
+    {
+        Kick(NetData, Ring);
+        OS_MutSemGive(Ring->Mutex);
+    } /* end if */
+
+    return Status;
+} /* end PollPeer() */
+
+/**
+ * Packs the message straight into the next TX ring slot as an Ethernet frame
+ * to the peer's MAC; the kernel sends it when TxBatch frames are queued or the
+ * peer is next polled.
+ */
+static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_ETH_Peer_t *     PeerData = (SBN_ETH_Peer_t *)Peer->ModulePvt;
+    SBN_ETH_Net_t *      NetData  = (SBN_ETH_Net_t *)Peer->Net->ModulePvt;
+    SBN_ETH_Ring_t *     Ring     = &Rings[NetData->BufNum];
+    size_t               PackedSz = MsgSz + SBN_PACKED_HDR_SZ;
+    struct tpacket3_hdr *Hdr      = NULL;
+    struct ether_header *Eth      = NULL;
+
+    if (Ring->Ring == NULL)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (PackedSz > NetData->MTU)
+    {
+        Ring->TxTooBigCnt++;
+        EVSSendErrLimited(SBN_ETH_SOCK_EID, "message too big for %s (%d > MTU %d)", NetData->IfName, (int)PackedSz,
+                          (int)NetData->MTU);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (OS_MutSemTake(Ring->Mutex) != OS_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    Hdr = (struct tpacket3_hdr *)(Ring->Ring + SBN_ETH_RX_RING_SZ + (size_t)Ring->TxFrame * SBN_ETH_TX_FRAME_SZ);
+
+    if (Hdr->tp_status != TP_STATUS_AVAILABLE)
+    {
+        /* the slot may just be waiting to be sent */
+        Kick(NetData, Ring);
+
+        if (Hdr->tp_status != TP_STATUS_AVAILABLE)
+        {
+            Ring->TxRingFullCnt++;
+            OS_MutSemGive(Ring->Mutex);
+            EVSSendMsgDbg(SBN_ETH_SOCK_EID, "TX ring full on %s, message dropped", NetData->IfName);
+            return SBN_ERROR;
+        } /* end if */
+    }     /* end if */
+
+    Eth = (struct ether_header *)((uint8 *)Hdr + SBN_ETH_TX_DATA_OFF);
+    memcpy(Eth->ether_dhost, PeerData->MAC, ETH_ALEN);
+    memcpy(Eth->ether_shost, NetData->MAC, ETH_ALEN);
+    Eth->ether_type = htons(NetData->EtherType);
+
+    SBN.PackMsg((uint8 *)Eth + ETH_HLEN, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(),
+                Payload);
+
+    Hdr->tp_len         = ETH_HLEN + PackedSz;
+    Hdr->tp_next_offset = 0;
+    Hdr->tp_status      = TP_STATUS_SEND_REQUEST;
+
+    Ring->TxFrame = (Ring->TxFrame + 1) % SBN_ETH_TX_FRAME_CNT;
+    Ring->TxFrameCnt++;
+
+    if (++Ring->TxPending >= NetData->TxBatch)
+    {
+        Kick(NetData, Ring);
+    } /* end if */
+
+    OS_MutSemGive(Ring->Mutex);
+
+    return SBN_SUCCESS;
+} /* end Send() */
+
+/** unpacks one frame from the RX ring */
+static SBN_Status_t RecvFrame(SBN_NetInterface_t *Net, struct tpacket3_hdr *Pkt, SBN_MsgType_t *MsgTypePtr,
+                              SBN_MsgSz_t *MsgSzPtr, CFE_ProcessorID_t *ProcessorIDPtr,
+                              CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_ETH_Net_t *      NetData = (SBN_ETH_Net_t *)Net->ModulePvt;
+    SBN_ETH_Ring_t *     Ring    = &Rings[NetData->BufNum];
+    struct sockaddr_ll * From    = (struct sockaddr_ll *)((uint8 *)Pkt + TPACKET_ALIGN(sizeof(*Pkt)));
+    struct ether_header *Eth     = (struct ether_header *)((uint8 *)Pkt + Pkt->tp_mac);
+    uint8 *              Data    = (uint8 *)Eth + ETH_HLEN;
+    SBN_PeerInterface_t *Peer    = NULL;
+
+    /* frames this host sent, or sent to other hosts */
+    if (From->sll_pkttype == PACKET_OUTGOING || From->sll_pkttype == PACKET_OTHERHOST)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    Ring->RxFrameCnt++;
+
+    /* short frames are padded, the packed header says how much is the message */
+    if (Pkt->tp_snaplen < ETH_HLEN + SBN_PACKED_HDR_SZ
+        || ETH_HLEN + SBN_PACKED_HDR_SZ + (size_t)((Data[0] << 8) | Data[1]) > Pkt->tp_snaplen
+        || !SBN.UnpackMsg(Data, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload))
+    {
+        Ring->RxErrCnt++;
+        EVSSendErrLimited(SBN_ETH_SOCK_EID, "invalid frame on %s (%d bytes)", NetData->IfName, (int)Pkt->tp_snaplen);
+        return SBN_ERROR;
+    } /* end if */
+
+    Peer = SBN.GetPeer(Net, *ProcessorIDPtr, *SpacecraftIDPtr);
+    if (Peer == NULL)
+    {
+        Ring->RxErrCnt++;
+        EVSSendErrLimited(SBN_ETH_DEBUG_EID, "unknown peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (memcmp(Eth->ether_shost, ((SBN_ETH_Peer_t *)Peer->ModulePvt)->MAC, ETH_ALEN) != 0)
+    {
+        Ring->RxErrCnt++;
+        EVSSendErrLimited(SBN_ETH_DEBUG_EID, "peer %d:%d sent from an unexpected MAC", *SpacecraftIDPtr, *ProcessorIDPtr);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (!Peer->Connected)
+    {
+        EVSSendInfo(SBN_ETH_DEBUG_EID, "connecting to peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+        SBN.Connected(Peer);
+    } /* end if */
+
+    if (*MsgTypePtr == SBN_ETH_DISCONN_MSG)
+    {
+        SBN.Disconnected(Peer);
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end RecvFrame() */
+
+/* Note that this Recv function is indescriminate, frames are received
+ * from all peers, each carries its sender in the packed header. The RX ring
+ * hands over a block of frames at a time, which are unpacked one per call
+ * without further system calls.
+ */
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                         CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_ETH_Net_t *            NetData = (SBN_ETH_Net_t *)Net->ModulePvt;
+    SBN_ETH_Ring_t *           Ring    = &Rings[NetData->BufNum];
+    struct tpacket_block_desc *Block   = NULL;
+    struct tpacket3_hdr *      Pkt     = NULL;
+    SBN_Status_t               Status  = SBN_IF_EMPTY;
+
+    if (Ring->Ring == NULL)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    while (1)
+    {
+        Status = SBN_IF_EMPTY;
+        Block  = (struct tpacket_block_desc *)(Ring->Ring + (size_t)Ring->RxBlock * SBN_ETH_BLOCK_SZ);
+
+        if (!Ring->RxPktsLeft)
+        {
+            if (!(Block->hdr.bh1.block_status & TP_STATUS_USER))
+            {
+                struct pollfd PollFD = {NetData->FD, POLLIN | POLLERR, 0};
+
+                /* polling returns at once, otherwise block for the recv task */
+                if (!(Net->TaskFlags & SBN_TASK_RECV) || poll(&PollFD, 1, -1) < 0)
+                {
+                    return SBN_IF_EMPTY;
+                } /* end if */
+
+                continue;
+            } /* end if */
+
+            Ring->RxBlockCnt++;
+            Ring->RxPktsLeft = Block->hdr.bh1.num_pkts;
+            Ring->RxPkt      = (uint8 *)Block + Block->hdr.bh1.offset_to_first_pkt;
+        } /* end if */
+
+        if (Ring->RxPktsLeft)
+        {
+            Pkt = (struct tpacket3_hdr *)Ring->RxPkt;
+
+            Ring->RxPkt += Pkt->tp_next_offset;
+            Ring->RxPktsLeft--;
+
+            Status = RecvFrame(Net, Pkt, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, SpacecraftIDPtr, Payload);
+        } /* end if */
+
+        if (!Ring->RxPktsLeft)
+        {
+            /* all unpacked, the kernel can refill the block */
+            Block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+            Ring->RxBlock               = (Ring->RxBlock + 1) % SBN_ETH_RX_BLOCK_CNT;
+        } /* end if */
+
+        /* frames that are not for SBN are skipped, the next may be */
+        if (Status == SBN_SUCCESS)
+        {
+            return SBN_SUCCESS;
+        } /* end if */
+    }     /* end while */
+} /* end Recv() */
+
+static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
+{
+    if (Peer->Connected)
+    {
+        EVSSendInfo(SBN_ETH_DEBUG_EID, "peer %d:%d - sending disconnect", Peer->SpacecraftID, Peer->ProcessorID);
+        SBN.SendNetMsg(SBN_ETH_DISCONN_MSG, 0, NULL, Peer);
+        SBN.Disconnected(Peer);
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end UnloadPeer() */
+
+static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
+{
+    SBN_ETH_Net_t * NetData = (SBN_ETH_Net_t *)Net->ModulePvt;
+    SBN_ETH_Ring_t *Ring    = &Rings[NetData->BufNum];
+
+    SBN_PeerIdx_t PeerIdx = 0;
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        UnloadPeer(&Net->Peers[PeerIdx]);
+    } /* end for */
+
+    if (NetData->FD >= 0)
+    {
+        /* send the disconnects before the ring goes */
+        OS_MutSemTake(Ring->Mutex);
+        Kick(NetData, Ring);
+        OS_MutSemGive(Ring->Mutex);
+
+        OS_MutSemDelete(Ring->Mutex);
+
+        munmap(Ring->Ring, SBN_ETH_RX_RING_SZ + SBN_ETH_TX_RING_SZ);
+        Ring->Ring = NULL;
+
+        close(NetData->FD);
+        NetData->FD = -1;
+    } /* end if */
+
+    /* the other nets' tables follow this one's, so they are only reused once all are unloaded */
+    if (LoadedNetCnt && --LoadedNetCnt == 0)
+    {
+        NetCnt = 0;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end UnloadNet() */
+
+/**
+ * Reports, big-endian: uint8 Flags (1=rings up), uint32 MTU, then for the
+ * peer's net uint32 TX frames, TX kicks (send calls), TX ring full drops, TX
+ * too big drops, RX frames, RX blocks, RX errors and frames the kernel
+ * dropped for want of ring space.
+ */
+static SBN_Status_t ReportModuleStatus(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz)
+{
+    SBN_ETH_Net_t *        NetData = (SBN_ETH_Net_t *)Peer->Net->ModulePvt;
+    SBN_ETH_Ring_t *       Ring    = &Rings[NetData->BufNum];
+    struct tpacket_stats_v3 KStats;
+    socklen_t              KStatsSz = sizeof(KStats);
+    uint8 *                Ptr      = StatusBuf;
+
+    if (StatusBufSz < 1 + 9 * 4)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    /* the kernel's counts reset when read */
+    if (NetData->FD >= 0 && getsockopt(NetData->FD, SOL_PACKET, PACKET_STATISTICS, &KStats, &KStatsSz) == 0)
+    {
+        Ring->RxDropCnt += KStats.tp_drops;
+    } /* end if */
+
+    *Ptr++ = Ring->Ring ? 1 : 0;
+    Ptr    = SBN_PutUInt32(Ptr, NetData->MTU);
+    Ptr    = SBN_PutUInt32(Ptr, Ring->TxFrameCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Ring->TxKickCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Ring->TxRingFullCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Ring->TxTooBigCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Ring->RxFrameCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Ring->RxBlockCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Ring->RxErrCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Ring->RxDropCnt);
+
+    return SBN_SUCCESS;
+} /* end ReportModuleStatus() */
+
+SBN_IfOps_t SBN_ETH_Ops = {Init, InitNet, InitPeer, LoadNet,   LoadPeer,   PollPeer,
+                           Send, NULL,    Recv,     UnloadNet, UnloadPeer, ReportModuleStatus};
@@ -0,0 +1,73 @@
+#ifndef _SBN_ETH_IF_H_
+#define _SBN_ETH_IF_H_
+
+#include "sbn_eth_events.h"
+#include "sbn_platform_cfg.h"
+#include "sbn_eth_platform_cfg.h"
+#include <string.h>
+#include <errno.h>
+#include <net/if.h>
+#include <net/ethernet.h>
+
+#include "sbn_interfaces.h"
+#include "cfe.h"
+
+/**
+ * Ethernet-specific message types.
+ */
+#define SBN_ETH_HEARTBEAT_MSG 0xA0
+#define SBN_ETH_ANNOUNCE_MSG  0xA1
+#define SBN_ETH_DISCONN_MSG   0xA2
+
+/**
+ * \brief Number of seconds since last I've sent the peer a message when
+ * I send an empty heartbeat message.
+ */
+#define SBN_ETH_PEER_HEARTBEAT 5
+
+/**
+ * \brief Number of seconds since I've last heard from the peer when I consider
+ * the peer connection to be dropped.
+ */
+#define SBN_ETH_PEER_TIMEOUT 10
+
+/**
+ * \brief If we're not connected, send peer occasional messages to wake
+ * them up and tell them "I'm here".
+ */
+#define SBN_ETH_ANNOUNCE_TIMEOUT 10
+
+typedef struct
+{
+    /** @brief The peer's MAC address, from the peer address ("aa:bb:cc:dd:ee:ff".) */
+    uint8 MAC[ETH_ALEN];
+} SBN_ETH_Peer_t;
+
+typedef struct SBN_ETH_Net_s
+{
+    /** @brief The interface name, from the net address. */
+    char IfName[IFNAMSIZ];
+
+    /** @brief The interface's MAC address and MTU, read when initialized. */
+    uint8  MAC[ETH_ALEN];
+    uint32 MTU;
+
+    int IfIndex;
+
+    /** @brief The packet socket, -1 until initialized. */
+    int FD;
+
+    /** @brief The EtherType of SBN frames (the "ethertype" option.) */
+    uint16 EtherType;
+
+    /** @brief See SBN_ETH_DEFAULT_RX_TMO (the "rxtmo" option.) */
+    uint32 RxTmo;
+
+    /** @brief See SBN_ETH_DEFAULT_TX_BATCH (the "txbatch" option.) */
+    uint32 TxBatch;
+
+    /** @brief Index into the module's ring state. */
+    uint8 BufNum;
+} SBN_ETH_Net_t;
+
+#endif /* _SBN_ETH_IF_H_ */
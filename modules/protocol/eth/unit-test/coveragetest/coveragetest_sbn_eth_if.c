@@ -0,0 +1,424 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_eth_if.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN raw Ethernet protocol module
+**
+** Notes:
+** The ring tests run two nets over a veth pair, which needs CAP_NET_ADMIN and
+** CAP_NET_RAW; run the test runner as "unshare -rn <runner>" to have them in
+** a private network namespace. Without them those tests are skipped.
+*/
+
+#define _GNU_SOURCE /* unshare() */
+
+#include "sbn_eth_coveragetest_common.h"
+#include "sbn_eth_if.h"
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define SBN_PROTOCOL_VERSION 6
+
+#define IF_A "sbn_ut0"
+#define IF_B "sbn_ut1"
+
+extern SBN_IfOps_t SBN_ETH_Ops;
+
+static SBN_NetInterface_t   NetA, NetB;
+static SBN_PeerInterface_t *PeerA = &NetB.Peers[0], *PeerB = &NetA.Peers[0];
+
+static int ConnectedCnt = 0, DisconnectedCnt = 0;
+
+/* a test-local outlet packing the same header layout as SBN */
+static void PackMsg(void *SBNBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_ProcessorID_t ProcessorID,
+                    CFE_SpacecraftID_t SpacecraftID, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    memset(Buf, 0, SBN_PACKED_HDR_SZ);
+    Buf[0] = MsgSz >> 8;
+    Buf[1] = MsgSz & 0xFF;
+    Buf[2] = MsgType;
+    Buf[3] = (ProcessorID >> 24) & 0xFF;
+    Buf[4] = (ProcessorID >> 16) & 0xFF;
+    Buf[5] = (ProcessorID >> 8) & 0xFF;
+    Buf[6] = ProcessorID & 0xFF;
+    Buf[7] = (SpacecraftID >> 24) & 0xFF;
+    Buf[8] = (SpacecraftID >> 16) & 0xFF;
+    Buf[9] = (SpacecraftID >> 8) & 0xFF;
+    Buf[10] = SpacecraftID & 0xFF;
+
+    if (MsgSz)
+    {
+        memcpy(Buf + SBN_PACKED_HDR_SZ, Msg, MsgSz);
+    } /* end if */
+} /* end PackMsg() */
+
+static bool UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePtr,
+                      CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    *MsgSzPtr        = (Buf[0] << 8) | Buf[1];
+    *MsgTypePtr      = Buf[2];
+    *ProcessorIDPtr  = ((uint32)Buf[3] << 24) | (Buf[4] << 16) | (Buf[5] << 8) | Buf[6];
+    *SpacecraftIDPtr = ((uint32)Buf[7] << 24) | (Buf[8] << 16) | (Buf[9] << 8) | Buf[10];
+
+    if (*MsgSzPtr > CFE_MISSION_SB_MAX_SB_MSG_SIZE)
+    {
+        return false;
+    } /* end if */
+
+    memcpy(Msg, Buf + SBN_PACKED_HDR_SZ, *MsgSzPtr);
+
+    return true;
+} /* end UnpackMsg() */
+
+static SBN_Status_t Connected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = true;
+    ConnectedCnt++;
+    return SBN_SUCCESS;
+} /* end Connected() */
+
+static SBN_Status_t Disconnected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = false;
+    DisconnectedCnt++;
+    return SBN_SUCCESS;
+} /* end Disconnected() */
+
+static SBN_Status_t SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+{
+    return SBN_ETH_Ops.Send(Peer, MsgType, MsgSz, Msg);
+} /* end SendNetMsg() */
+
+/* each net has only the one peer */
+static SBN_PeerInterface_t *GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t ProcessorID,
+                                    CFE_SpacecraftID_t SpacecraftID)
+{
+    if (Net->Peers[0].ProcessorID == ProcessorID && Net->Peers[0].SpacecraftID == SpacecraftID)
+    {
+        return &Net->Peers[0];
+    } /* end if */
+
+    return NULL;
+} /* end GetPeer() */
+
+static SBN_ProtocolOutlet_t Outlet = {PackMsg, UnpackMsg, Connected, Disconnected, SendNetMsg, GetPeer};
+
+static uint8  Payload[CFE_MISSION_SB_MAX_SB_MSG_SIZE], RecvPayload[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+static uint32 Status[9];
+
+/* reads the module status of a peer, returning the flags */
+static uint8 GetStatus(SBN_PeerInterface_t *Peer)
+{
+    uint8 Buf[64], *Ptr = Buf + 1;
+    int   i             = 0;
+
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.ReportModuleStatus(Peer, Buf, sizeof(Buf)), SBN_SUCCESS);
+
+    for (i = 0; i < 9; i++, Ptr += 4)
+    {
+        Status[i] = ((uint32)Ptr[0] << 24) | (Ptr[1] << 16) | (Ptr[2] << 8) | Ptr[3];
+    } /* end for */
+
+    return Buf[0];
+} /* end GetStatus() */
+
+/* the kernel hands over RX blocks when full or after rxtmo ms, so wait a little */
+static SBN_Status_t RecvWait(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr)
+{
+    CFE_ProcessorID_t  ProcessorID  = 0;
+    CFE_SpacecraftID_t SpacecraftID = 0;
+    SBN_Status_t       Status       = SBN_IF_EMPTY;
+    int                Tries        = 0;
+
+    for (Tries = 0; Tries < 200 && Status == SBN_IF_EMPTY; Tries++)
+    {
+        Status = SBN_ETH_Ops.RecvFromNet(Net, MsgTypePtr, MsgSzPtr, &ProcessorID, &SpacecraftID, RecvPayload);
+        if (Status == SBN_IF_EMPTY)
+        {
+            usleep(1000);
+        } /* end if */
+    }     /* end for */
+
+    return Status;
+} /* end RecvWait() */
+
+static void FormatMAC(char *Buf, size_t BufSz, SBN_NetInterface_t *Net)
+{
+    uint8 *MAC = ((SBN_ETH_Net_t *)Net->ModulePvt)->MAC;
+
+    snprintf(Buf, BufSz, "%02x:%02x:%02x:%02x:%02x:%02x", MAC[0], MAC[1], MAC[2], MAC[3], MAC[4], MAC[5]);
+} /* end FormatMAC() */
+
+static void LoadNet(SBN_NetInterface_t *Net, const char *Address)
+{
+    memset(Net, 0, sizeof(*Net));
+
+    Net->PeerCnt = 1;
+    Net->IfOps   = &SBN_ETH_Ops;
+
+    /* both ends are this processor */
+    Net->Peers[0].Net          = Net;
+    Net->Peers[0].ProcessorID  = CFE_PSP_GetProcessorId();
+    Net->Peers[0].SpacecraftID = CFE_PSP_GetSpacecraftId();
+
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadNet(Net, Address), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.InitNet(Net), SBN_SUCCESS);
+} /* end LoadNet() */
+
+/* brings up a veth pair, returning false if not permitted */
+static bool START(const char *AddrA, const char *AddrB)
+{
+    char   MAC[32];
+    size_t i = 0;
+
+    UT_ResetState(0);
+
+    /* keep the test interfaces out of the host's namespace if we can */
+    unshare(CLONE_NEWNET);
+
+    if (system("ip link add " IF_A " type veth peer name " IF_B " 2>/dev/null"
+               " && ip link set " IF_A " up && ip link set " IF_B " up")
+        != 0)
+    {
+        UtPrintf("unable to create a veth pair, skipped (run under \"unshare -rn\")");
+        return false;
+    } /* end if */
+
+    ConnectedCnt    = 0;
+    DisconnectedCnt = 0;
+
+    for (i = 0; i < sizeof(Payload); i++)
+    {
+        Payload[i] = i & 0xFF;
+    } /* end for */
+
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+
+    LoadNet(&NetA, AddrA);
+    LoadNet(&NetB, AddrB);
+
+    /* each net's peer is the MAC at the other end */
+    FormatMAC(MAC, sizeof(MAC), &NetB);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadPeer(PeerB, MAC), SBN_SUCCESS);
+    FormatMAC(MAC, sizeof(MAC), &NetA);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadPeer(PeerA, MAC), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.InitPeer(PeerA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.InitPeer(PeerB), SBN_SUCCESS);
+
+    return true;
+} /* end START() */
+
+static void STOP(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.UnloadNet(&NetB), SBN_SUCCESS);
+
+    system("ip link del " IF_A " 2>/dev/null");
+} /* end STOP() */
+
+void Test_SBN_ETH_Init(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.InitModule(-1, 0, &Outlet), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, NULL), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+} /* end Test_SBN_ETH_Init() */
+
+void Test_SBN_ETH_Load(void)
+{
+    SBN_ETH_Net_t * NetData  = (SBN_ETH_Net_t *)NetA.ModulePvt;
+    SBN_ETH_Peer_t *PeerData = (SBN_ETH_Peer_t *)PeerB->ModulePvt;
+
+    memset(&NetA, 0, sizeof(NetA));
+
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadNet(&NetA, ""), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadNet(&NetA, "averyveryverylongifname"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadNet(&NetA, "eth0?ethertype"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadNet(&NetA, "eth0?ethertype=0x5DC"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadNet(&NetA, "eth0?ethertype=0x10000"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadNet(&NetA, "eth0?txbatch=0"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadNet(&NetA, "eth0?foo=1"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadNet(&NetA, "sbn_noif?ethertype=0x88B6&rxtmo=5&txbatch=8"), SBN_SUCCESS);
+
+    UtAssert_True(strcmp(NetData->IfName, "sbn_noif") == 0, "interface name");
+    UtAssert_True(NetData->EtherType == 0x88B6 && NetData->RxTmo == 5 && NetData->TxBatch == 8, "options");
+
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadPeer(PeerB, ""), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadPeer(PeerB, "02:00:00:00:00"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadPeer(PeerB, "02:00:00:00:00:01:02"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadPeer(PeerB, "02:00:00:00:00:zz"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.LoadPeer(PeerB, "02:00:5e:10:00:ff"), SBN_SUCCESS);
+    UtAssert_True(PeerData->MAC[0] == 0x02 && PeerData->MAC[2] == 0x5e && PeerData->MAC[5] == 0xff, "peer MAC");
+
+    /* no such interface */
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.InitNet(&NetA), SBN_ERROR);
+
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+} /* end Test_SBN_ETH_Load() */
+
+void Test_SBN_ETH_Veth(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+    uint32        MTU     = 0;
+
+    if (!START(IF_A, IF_B))
+    {
+        return;
+    } /* end if */
+
+    UtAssert_True(GetStatus(PeerB) == 1, "A rings up");
+    MTU = Status[0];
+    UtAssert_True(MTU == 1500, "MTU=%d", (int)MTU);
+
+    /* announcements connect each end to the other */
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.PollPeer(PeerB), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_ETH_ANNOUNCE_MSG && PeerA->Connected, "B heard A");
+
+    /* SBN answers a newly connected peer with its subscriptions */
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.Send(PeerA, SBN_SUB_MSG, 0, NULL), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(RecvWait(&NetA, &MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_SUB_MSG && PeerB->Connected, "A heard B");
+    UtAssert_True(ConnectedCnt == 2, "ConnectedCnt=%d", ConnectedCnt);
+
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.Send(PeerB, SBN_APP_MSG, 100, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.Send(PeerB, SBN_APP_MSG, MTU - SBN_PACKED_HDR_SZ, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.Send(PeerB, SBN_APP_MSG, MTU - SBN_PACKED_HDR_SZ + 1, Payload), SBN_ERROR);
+
+    UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_APP_MSG && MsgSz == 100, "MsgType=%d MsgSz=%d", MsgType, MsgSz);
+    UtAssert_True(memcmp(RecvPayload, Payload, 100) == 0, "payload intact");
+
+    UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgSz == MTU - SBN_PACKED_HDR_SZ && memcmp(RecvPayload, Payload, MsgSz) == 0,
+                  "full frame payload intact");
+
+    UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_IF_EMPTY);
+
+    GetStatus(PeerB);
+    UtAssert_True(Status[1] == 3 && Status[2] == 3, "A TxFrameCnt=%d TxKickCnt=%d", (int)Status[1], (int)Status[2]);
+    UtAssert_True(Status[4] == 1, "A TxTooBigCnt=%d", (int)Status[4]);
+    GetStatus(PeerA);
+    UtAssert_True(Status[5] == 3 && Status[7] == 0 && Status[8] == 0, "B RxFrameCnt=%d RxErrCnt=%d", (int)Status[5],
+                  (int)Status[7]);
+
+    /* a frame from a MAC other than the peer's is dropped */
+    ((SBN_ETH_Peer_t *)PeerA->ModulePvt)->MAC[5] ^= 0xFF;
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.Send(PeerB, SBN_APP_MSG, 10, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_IF_EMPTY);
+    GetStatus(PeerA);
+    UtAssert_True(Status[7] == 1, "B RxErrCnt=%d", (int)Status[7]);
+    ((SBN_ETH_Peer_t *)PeerA->ModulePvt)->MAC[5] ^= 0xFF;
+
+    /* A going away disconnects it at B */
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_ETH_DISCONN_MSG && !PeerA->Connected, "B saw A disconnect");
+    UtAssert_True(DisconnectedCnt == 2, "DisconnectedCnt=%d", DisconnectedCnt);
+
+    STOP();
+} /* end Test_SBN_ETH_Veth() */
+
+void Test_SBN_ETH_Batch(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+    int           i       = 0;
+
+    if (!START(IF_A "?txbatch=4", IF_B))
+    {
+        return;
+    } /* end if */
+
+    /* queued in the ring, not yet sent */
+    for (i = 0; i < 3; i++)
+    {
+        UT_TEST_FUNCTION_RC(SBN_ETH_Ops.Send(PeerB, SBN_APP_MSG, 10 + i, Payload), SBN_SUCCESS);
+    } /* end for */
+
+    UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_IF_EMPTY);
+    GetStatus(PeerB);
+    UtAssert_True(Status[1] == 3 && Status[2] == 0, "A TxFrameCnt=%d TxKickCnt=%d", (int)Status[1], (int)Status[2]);
+
+    /* polling queues an announcement and sends the lot with one call */
+    UT_TEST_FUNCTION_RC(SBN_ETH_Ops.PollPeer(PeerB), SBN_SUCCESS);
+    GetStatus(PeerB);
+    UtAssert_True(Status[1] == 4 && Status[2] == 1, "A TxFrameCnt=%d TxKickCnt=%d", (int)Status[1], (int)Status[2]);
+
+    for (i = 0; i < 3; i++)
+    {
+        UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_SUCCESS);
+        UtAssert_True(MsgType == SBN_APP_MSG && MsgSz == 10 + i, "MsgSz=%d", MsgSz);
+    } /* end for */
+
+    UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_ETH_ANNOUNCE_MSG, "announcement last");
+
+    /* a full batch goes at once, and more than a ring's worth recycles the slots */
+    for (i = 0; i < 64; i++)
+    {
+        UT_TEST_FUNCTION_RC(SBN_ETH_Ops.Send(PeerB, SBN_APP_MSG, 1000, Payload), SBN_SUCCESS);
+    } /* end for */
+
+    for (i = 0; i < 64; i++)
+    {
+        UT_TEST_FUNCTION_RC(RecvWait(&NetB, &MsgType, &MsgSz), SBN_SUCCESS);
+    } /* end for */
+
+    GetStatus(PeerB);
+    UtAssert_True(Status[1] == 68 && Status[2] == 17 && Status[3] == 0, "A TxFrameCnt=%d TxKickCnt=%d RingFull=%d",
+                  (int)Status[1], (int)Status[2], (int)Status[3]);
+    GetStatus(PeerA);
+    UtAssert_True(Status[5] == 68 && Status[6] >= 1, "B RxFrameCnt=%d RxBlockCnt=%d", (int)Status[5], (int)Status[6]);
+
+    STOP();
+} /* end Test_SBN_ETH_Batch() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_ETH_Init);
+    ADD_TEST(SBN_ETH_Load);
+    ADD_TEST(SBN_ETH_Veth);
+    ADD_TEST(SBN_ETH_Batch);
+}
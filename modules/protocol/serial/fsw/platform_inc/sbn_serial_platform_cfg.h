@@ -11,10 +11,31 @@
 
 #define SBN_SERIAL_MAX_CHAR_NAME 32 /**< How long the device name can be in the SbnPeerData file */
 
+#define SBN_SERIAL_MAX_DEVICES 4 /**< How many serial devices (peers) this module can drive */
+
 #define SBN_SERIAL_CHILD_STACK_SIZE 2048 /**< Stack size that each child task gets */
 
 #define SBN_SERIAL_CHILD_TASK_PRIORITY 70 /**< Priority of the child tasks */
 
+#define SBN_SERIAL_DEFAULT_BAUD 115200 /**< Line rate when the peer address has no "baud" option */
+
+/**
+ * Size of each device's transmit queue in bytes. Sends are queued and drained
+ * at the line rate by a writer task; a frame that does not fit is dropped and
+ * counted as an overrun. Should hold at least one maximum-size frame.
+ */
+#define SBN_SERIAL_TXQ_SZ 65536
+
+#define SBN_SERIAL_TX_CHUNK_SZ 256 /**< Most bytes the writer task hands to the driver at once */
+
+/**
+ * Bounds for the "frag" peer address option, the largest packed message sent
+ * whole. Larger messages are split into fragments of this size so that high
+ * priority frames are not stuck behind them.
+ */
+#define SBN_SERIAL_MIN_FRAG_SZ 32
+#define SBN_SERIAL_MAX_FRAG_SZ 1024
+
 #define SBN_SERIAL_PEER_HEARTBEAT 5
 #define SBN_SERIAL_PEER_TIMEOUT   10
 #endif
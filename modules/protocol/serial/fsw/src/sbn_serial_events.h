@@ -1,7 +1,9 @@
 #ifndef _sbn_serial_events_h
 #define _sbn_serial_events_h
 
-#include "sbn_events.h"
+#include "sbn_types.h"
+
+extern CFE_EVS_EventID_t SBN_SERIAL_FIRST_EID; /* defined at module init time */
 
 #define SBN_SERIAL_DEVICE_EID SBN_SERIAL_FIRST_EID + 1 /* skip 0th */
 #define SBN_SERIAL_CONFIG_EID SBN_SERIAL_FIRST_EID + 2
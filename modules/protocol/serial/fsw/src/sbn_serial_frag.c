@@ -0,0 +1,102 @@
+#include "sbn_serial_frag.h"
+#include <string.h>
+
+size_t SBN_SERIAL_FragHdr(uint8 *Buf, uint8 Lane, uint16 Seq, uint16 Offset, uint16 Total)
+{
+    Buf[0] = Lane;
+    Buf[1] = Seq >> 8;
+    Buf[2] = Seq & 0xFF;
+    Buf[3] = Offset >> 8;
+    Buf[4] = Offset & 0xFF;
+    Buf[5] = Total >> 8;
+    Buf[6] = Total & 0xFF;
+
+    return SBN_SERIAL_FRAG_HDR_SZ;
+} /* end SBN_SERIAL_FragHdr() */
+
+void SBN_SERIAL_ReasmInit(SBN_SERIAL_Reasm_t *Reasm)
+{
+    int i = 0;
+
+    for (i = 0; i < SBN_SERIAL_LANES; i++)
+    {
+        Reasm->Lanes[i].Active = false;
+    } /* end for */
+
+    Reasm->FragCnt = 0;
+    Reasm->MsgCnt  = 0;
+    Reasm->ErrCnt  = 0;
+} /* end SBN_SERIAL_ReasmInit() */
+
+SBN_Status_t SBN_SERIAL_Reasm(SBN_SERIAL_Reasm_t *Reasm, const uint8 *Frag, size_t FragSz, uint8 **MsgPtr,
+                              size_t *MsgSzPtr)
+{
+    SBN_SERIAL_ReasmLane_t *Lane = NULL;
+    uint16                  Seq = 0, Offset = 0, Total = 0;
+    size_t                  DataSz = 0;
+
+    Reasm->FragCnt++;
+
+    if (FragSz <= SBN_SERIAL_FRAG_HDR_SZ || Frag[0] >= SBN_SERIAL_LANES)
+    {
+        Reasm->ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    Lane   = &Reasm->Lanes[Frag[0]];
+    Seq    = (Frag[1] << 8) | Frag[2];
+    Offset = (Frag[3] << 8) | Frag[4];
+    Total  = (Frag[5] << 8) | Frag[6];
+    DataSz = FragSz - SBN_SERIAL_FRAG_HDR_SZ;
+
+    if (Offset == 0)
+    {
+        if (Lane->Active)
+        {
+            /* the rest of the previous message was lost */
+            Reasm->ErrCnt++;
+        } /* end if */
+
+        if (Total > sizeof(Lane->Buf))
+        {
+            Lane->Active = false;
+            Reasm->ErrCnt++;
+            return SBN_ERROR;
+        } /* end if */
+
+        Lane->Active = true;
+        Lane->Seq    = Seq;
+        Lane->Got    = 0;
+        Lane->Total  = Total;
+    }
+    else if (!Lane->Active || Seq != Lane->Seq || Offset != Lane->Got || Total != Lane->Total)
+    {
+        /* a fragment was lost, drop this one and anything in progress */
+        Lane->Active = false;
+        Reasm->ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    if (DataSz > Lane->Total - Lane->Got)
+    {
+        Lane->Active = false;
+        Reasm->ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    memcpy(Lane->Buf + Lane->Got, Frag + SBN_SERIAL_FRAG_HDR_SZ, DataSz);
+    Lane->Got += DataSz;
+
+    if (Lane->Got < Lane->Total)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    Lane->Active = false;
+    Reasm->MsgCnt++;
+
+    *MsgPtr   = Lane->Buf;
+    *MsgSzPtr = Lane->Total;
+
+    return SBN_SUCCESS;
+} /* end SBN_SERIAL_Reasm() */
@@ -0,0 +1,93 @@
+#ifndef _sbn_serial_frag_h_
+#define _sbn_serial_frag_h_
+
+/**
+ * On a slow line a large message occupies the wire for a long time, and
+ * anything queued behind it waits. When fragmentation is enabled for a peer,
+ * packed messages larger than the fragment size are split into fragments,
+ * each sent as its own frame (as an SBN_SERIAL_FRAG_MSG), so that frames of
+ * a higher priority lane can be sent between them:
+ *
+ * ```
+ * +---------+--------+-----------+----------+------------------------+
+ * | Lane:8  | Seq:16 | Offset:16 | Total:16 | fragment of packed msg |
+ * +---------+--------+-----------+----------+------------------------+
+ * ```
+ *
+ * All values are big-endian. Seq numbers the fragmented messages of a lane,
+ * Offset and Total locate the fragment within the packed message. Serial
+ * lines deliver in order, so the receiver reassembles one message per lane
+ * at a time and discards a partial message when a fragment is lost.
+ */
+
+#include "sbn_interfaces.h"
+#include "cfe.h"
+
+/** @brief Lane 0 is sent before lane 1. */
+#define SBN_SERIAL_LANES 2
+
+#define SBN_SERIAL_LANE_HIGH 0
+#define SBN_SERIAL_LANE_LOW  1
+
+/** @brief Lane, Seq, Offset, Total. */
+#define SBN_SERIAL_FRAG_HDR_SZ 7
+
+typedef struct
+{
+    /** @brief The packed message being reassembled. */
+    uint8 Buf[SBN_MAX_PACKED_MSG_SZ];
+
+    /** @brief Is a message in progress? */
+    bool Active;
+
+    uint16 Seq;
+
+    /** @brief Bytes received so far and the size of the packed message. */
+    size_t Got, Total;
+} SBN_SERIAL_ReasmLane_t;
+
+typedef struct
+{
+    SBN_SERIAL_ReasmLane_t Lanes[SBN_SERIAL_LANES];
+
+    /** @brief Fragments received, messages reassembled, fragments discarded. */
+    uint32 FragCnt, MsgCnt, ErrCnt;
+} SBN_SERIAL_Reasm_t;
+
+/**
+ * Writes a fragment header.
+ *
+ * @param Buf[out] The buffer, at least SBN_SERIAL_FRAG_HDR_SZ bytes.
+ * @param Lane[in] The lane the message is sent on.
+ * @param Seq[in] The sequence number of the message within its lane.
+ * @param Offset[in] The offset of this fragment within the packed message.
+ * @param Total[in] The size of the packed message.
+ *
+ * @return SBN_SERIAL_FRAG_HDR_SZ
+ */
+size_t SBN_SERIAL_FragHdr(uint8 *Buf, uint8 Lane, uint16 Seq, uint16 Offset, uint16 Total);
+
+/**
+ * Resets the reassembly state (and counters.)
+ *
+ * @param Reasm[out] The reassembly state.
+ */
+void SBN_SERIAL_ReasmInit(SBN_SERIAL_Reasm_t *Reasm);
+
+/**
+ * Adds a received fragment to its lane's message.
+ *
+ * @param Reasm[in/out] The reassembly state.
+ * @param Frag[in] The fragment, header and data.
+ * @param FragSz[in] The size of the fragment.
+ * @param MsgPtr[out] Set to the packed message when complete, valid until the
+ *        next fragment for the same lane.
+ * @param MsgSzPtr[out] Set to the size of the packed message when complete.
+ *
+ * @return SBN_SUCCESS when a message is complete, SBN_IF_EMPTY when more
+ *         fragments are needed, SBN_ERROR if the fragment was discarded.
+ */
+SBN_Status_t SBN_SERIAL_Reasm(SBN_SERIAL_Reasm_t *Reasm, const uint8 *Frag, size_t FragSz, uint8 **MsgPtr,
+                              size_t *MsgSzPtr);
+
+#endif /* _sbn_serial_frag_h_ */
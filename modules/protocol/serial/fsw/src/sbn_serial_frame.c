@@ -0,0 +1,123 @@
+#include "sbn_serial_frame.h"
+#include <string.h>
+
+uint16 SBN_SERIAL_CRC16(const uint8 *Data, size_t DataSz)
+{
+    uint16 CRC = 0xFFFF;
+    size_t i   = 0;
+    int    Bit = 0;
+
+    for (i = 0; i < DataSz; i++)
+    {
+        CRC ^= (uint16)Data[i] << 8;
+        for (Bit = 0; Bit < 8; Bit++)
+        {
+            CRC = (CRC & 0x8000) ? (CRC << 1) ^ 0x1021 : CRC << 1;
+        } /* end for */
+    }     /* end for */
+
+    return CRC;
+} /* end SBN_SERIAL_CRC16() */
+
+size_t SBN_SERIAL_Frame(uint8 *FrameBuf, size_t DataSz)
+{
+    uint16 CRC = 0;
+
+    FrameBuf[0] = SBN_SERIAL_SYNC0;
+    FrameBuf[1] = SBN_SERIAL_SYNC1;
+    FrameBuf[2] = (DataSz >> 8) & 0xFF;
+    FrameBuf[3] = DataSz & 0xFF;
+    FrameBuf[4] = ~FrameBuf[2];
+    FrameBuf[5] = ~FrameBuf[3];
+
+    CRC = SBN_SERIAL_CRC16(FrameBuf + 2, SBN_SERIAL_FRAME_HDR_SZ - 2 + DataSz);
+
+    FrameBuf[SBN_SERIAL_FRAME_HDR_SZ + DataSz]     = CRC >> 8;
+    FrameBuf[SBN_SERIAL_FRAME_HDR_SZ + DataSz + 1] = CRC & 0xFF;
+
+    return DataSz + SBN_SERIAL_FRAME_OVERHEAD;
+} /* end SBN_SERIAL_Frame() */
+
+void SBN_SERIAL_DeframerInit(SBN_SERIAL_Deframer_t *Deframer)
+{
+    Deframer->BufUsed   = 0;
+    Deframer->Consumed  = 0;
+    Deframer->FrameCnt  = 0;
+    Deframer->HdrErrCnt = 0;
+    Deframer->CRCErrCnt = 0;
+    Deframer->SkipCnt   = 0;
+} /* end SBN_SERIAL_DeframerInit() */
+
+/* drop the first Cnt bytes of the receive buffer */
+static void Drop(SBN_SERIAL_Deframer_t *Deframer, size_t Cnt)
+{
+    memmove(Deframer->Buf, Deframer->Buf + Cnt, Deframer->BufUsed - Cnt);
+    Deframer->BufUsed -= Cnt;
+} /* end Drop() */
+
+SBN_Status_t SBN_SERIAL_Deframe(SBN_SERIAL_Deframer_t *Deframer, uint8 **DataPtr, size_t *DataSzPtr)
+{
+    uint8 *Buf = Deframer->Buf;
+    size_t Len = 0, Skip = 0;
+    uint16 CRC = 0;
+
+    if (Deframer->Consumed)
+    {
+        Drop(Deframer, Deframer->Consumed);
+        Deframer->Consumed = 0;
+    } /* end if */
+
+    while (1)
+    {
+        /* hunt for the sync marker, keeping a trailing SYNC0 that may be the start of one */
+        for (Skip = 0; Skip < Deframer->BufUsed; Skip++)
+        {
+            if (Buf[Skip] == SBN_SERIAL_SYNC0 && (Skip + 1 == Deframer->BufUsed || Buf[Skip + 1] == SBN_SERIAL_SYNC1))
+            {
+                break;
+            } /* end if */
+        }     /* end for */
+
+        if (Skip)
+        {
+            Deframer->SkipCnt += Skip;
+            Drop(Deframer, Skip);
+        } /* end if */
+
+        if (Deframer->BufUsed < SBN_SERIAL_FRAME_HDR_SZ)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        Len = (Buf[2] << 8) | Buf[3];
+
+        if ((Buf[2] ^ Buf[4]) != 0xFF || (Buf[3] ^ Buf[5]) != 0xFF || Len > SBN_MAX_PACKED_MSG_SZ)
+        {
+            Deframer->HdrErrCnt++;
+            Drop(Deframer, 1); /* resync past this marker */
+            continue;
+        } /* end if */
+
+        if (Deframer->BufUsed < Len + SBN_SERIAL_FRAME_OVERHEAD)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        CRC = SBN_SERIAL_CRC16(Buf + 2, SBN_SERIAL_FRAME_HDR_SZ - 2 + Len);
+
+        if ((CRC >> 8) != Buf[SBN_SERIAL_FRAME_HDR_SZ + Len] || (CRC & 0xFF) != Buf[SBN_SERIAL_FRAME_HDR_SZ + Len + 1])
+        {
+            Deframer->CRCErrCnt++;
+            Drop(Deframer, 1); /* resync past this marker */
+            continue;
+        } /* end if */
+
+        Deframer->FrameCnt++;
+        Deframer->Consumed = Len + SBN_SERIAL_FRAME_OVERHEAD;
+
+        *DataPtr   = Buf + SBN_SERIAL_FRAME_HDR_SZ;
+        *DataSzPtr = Len;
+
+        return SBN_SUCCESS;
+    } /* end while */
+} /* end SBN_SERIAL_Deframe() */
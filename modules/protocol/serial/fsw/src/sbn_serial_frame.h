@@ -0,0 +1,96 @@
+#ifndef _sbn_serial_frame_h_
+#define _sbn_serial_frame_h_
+
+/**
+ * Serial lines are byte streams with no message boundaries, and bytes may be
+ * corrupted, dropped, or inserted. Each packed SBN message is wrapped in a
+ * frame so that the receiver can find message boundaries and reject damaged
+ * messages:
+ *
+ * ```
+ * +------+------+--------+---------+-------------------+--------+
+ * | 0xEB | 0x90 | Len:16 | ~Len:16 | Len bytes of data | CRC:16 |
+ * +------+------+--------+---------+-------------------+--------+
+ * ```
+ *
+ * All values are big-endian. The length is repeated inverted so that a
+ * corrupted length is rejected without waiting for Len bytes to arrive.
+ * The CRC (CRC-16/CCITT-FALSE) covers the length fields and the data.
+ *
+ * When a frame is rejected, the receiver drops a single byte and hunts for
+ * the next sync marker in the bytes already received, so a good frame that
+ * follows (or starts inside) a bad one is never lost.
+ */
+
+#include "sbn_interfaces.h"
+#include "cfe.h"
+
+#define SBN_SERIAL_SYNC0 0xEB
+#define SBN_SERIAL_SYNC1 0x90
+
+/** @brief Sync marker, length, inverted length. */
+#define SBN_SERIAL_FRAME_HDR_SZ 6
+
+#define SBN_SERIAL_FRAME_CRC_SZ 2
+
+#define SBN_SERIAL_FRAME_OVERHEAD (SBN_SERIAL_FRAME_HDR_SZ + SBN_SERIAL_FRAME_CRC_SZ)
+
+#define SBN_SERIAL_MAX_FRAME_SZ (SBN_SERIAL_FRAME_OVERHEAD + SBN_MAX_PACKED_MSG_SZ)
+
+typedef struct
+{
+    /** @brief Bytes received but not yet consumed. */
+    uint8 Buf[SBN_SERIAL_MAX_FRAME_SZ];
+
+    /** @brief Number of valid bytes in Buf. */
+    size_t BufUsed;
+
+    /** @brief Size of the frame returned by the last SBN_SERIAL_Deframe(), dropped on the next call. */
+    size_t Consumed;
+
+    /** @brief Good frames, frames with a bad header or CRC, bytes skipped hunting for sync. */
+    uint32 FrameCnt, HdrErrCnt, CRCErrCnt, SkipCnt;
+} SBN_SERIAL_Deframer_t;
+
+/**
+ * Computes the CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of a buffer.
+ *
+ * @param Data[in] The data.
+ * @param DataSz[in] The size of the data.
+ *
+ * @return The CRC.
+ */
+uint16 SBN_SERIAL_CRC16(const uint8 *Data, size_t DataSz);
+
+/**
+ * Wraps data in a frame, in place.
+ *
+ * @param FrameBuf[in/out] The frame buffer, with DataSz bytes of data already
+ *        at FrameBuf + SBN_SERIAL_FRAME_HDR_SZ and room for the CRC after it.
+ * @param DataSz[in] The size of the data, at most SBN_MAX_PACKED_MSG_SZ.
+ *
+ * @return The size of the complete frame.
+ */
+size_t SBN_SERIAL_Frame(uint8 *FrameBuf, size_t DataSz);
+
+/**
+ * Resets the receive state (and counters) of a deframer.
+ *
+ * @param Deframer[out] The deframer.
+ */
+void SBN_SERIAL_DeframerInit(SBN_SERIAL_Deframer_t *Deframer);
+
+/**
+ * Finds the next good frame in the bytes received so far. Callers append
+ * received bytes to Deframer->Buf (at most sizeof(Buf) - BufUsed, which is
+ * never zero after this returns SBN_IF_EMPTY) and bump BufUsed.
+ *
+ * @param Deframer[in/out] The deframer.
+ * @param DataPtr[out] Set to the frame data, valid until the next call.
+ * @param DataSzPtr[out] Set to the size of the frame data.
+ *
+ * @return SBN_SUCCESS if a frame was found, SBN_IF_EMPTY if more bytes are needed.
+ */
+SBN_Status_t SBN_SERIAL_Deframe(SBN_SERIAL_Deframer_t *Deframer, uint8 **DataPtr, size_t *DataSzPtr);
+
+#endif /* _sbn_serial_frame_h_ */
@@ -1,12 +1,16 @@
-#include "sbn_serial_if_struct.h"
 #include "sbn_serial_if.h"
-#include "sbn_serial_events.h"
-#include "cfe.h"
-#include <string.h>
-#include <errno.h>
+#include "sbn_serial_frame.h"
+#include "sbn_module_util.h"
 
+#include <fcntl.h>
+#include <stdlib.h>
 #include <termios.h>
 #include <unistd.h>
+#include <sys/ioctl.h>
+
+#ifdef __linux__
+#include <linux/serial.h> /* struct serial_icounter_struct */
+#endif
 
 /* at some point this will be replaced by the OSAL network interface */
 #ifdef _VXWORKS_OS_
@@ -15,327 +19,926 @@
 #include <sys/select.h>
 #endif
 
-int SBN_SERIAL_Init(int Version)
+CFE_EVS_EventID_t SBN_SERIAL_FIRST_EID;
+
+#define EXP_VERSION 6
+
+static SBN_ProtocolOutlet_t SBN;
+
+static uint8                 SendBufs[SBN_SERIAL_MAX_DEVICES][SBN_SERIAL_MAX_FRAME_SZ];
+static SBN_SERIAL_Deframer_t Deframers[SBN_SERIAL_MAX_DEVICES];
+static SBN_SERIAL_TxQ_t      TxQs[SBN_SERIAL_MAX_DEVICES];
+static uint8                 Chunks[SBN_SERIAL_MAX_DEVICES][SBN_SERIAL_TX_CHUNK_SZ];
+static SBN_SERIAL_Reasm_t    Reasms[SBN_SERIAL_MAX_DEVICES];
+
+/* fragment (header and data) being packed, and its frame */
+static uint8 FragBufs[SBN_SERIAL_MAX_DEVICES][SBN_SERIAL_FRAG_HDR_SZ + SBN_SERIAL_MAX_FRAG_SZ];
+static uint8 FragFrames[SBN_SERIAL_MAX_DEVICES]
+                       [SBN_SERIAL_FRAME_OVERHEAD + SBN_PACKED_HDR_SZ + SBN_SERIAL_FRAG_HDR_SZ + SBN_SERIAL_MAX_FRAG_SZ];
+static uint8                 BufCnt       = 0;
+static uint8                 LoadedNetCnt = 0;
+
+static const struct
+{
+    uint32  Baud;
+    speed_t Speed;
+} BaudTbl[] = {
+    {9600, B9600},       {19200, B19200},     {38400, B38400},     {57600, B57600},     {115200, B115200},
+#ifdef B230400
+    {230400, B230400},
+#endif
+#ifdef B460800
+    {460800, B460800},
+#endif
+#ifdef B921600
+    {921600, B921600},
+#endif
+#ifdef B1000000
+    {1000000, B1000000},
+#endif
+#ifdef B2000000
+    {2000000, B2000000},
+#endif
+#ifdef B4000000
+    {4000000, B4000000},
+#endif
+};
+
+/** returns true and sets Speed if Baud is a rate this platform supports */
+static bool BaudToSpeed(uint32 Baud, speed_t *Speed)
 {
-    if (Version != 1)
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(BaudTbl) / sizeof(BaudTbl[0]); i++)
     {
-        CFE_EVS_SendEvent(SBN_SERIAL_CONFIG_EID, CFE_EVS_ERROR, "mismatching version %d (SBN app reports %d)", Version,
-                          1);
+        if (BaudTbl[i].Baud == Baud)
+        {
+            *Speed = BaudTbl[i].Speed;
+            return true;
+        } /* end if */
+    }     /* end for */
+
+    return false;
+} /* end BaudToSpeed() */
+
+static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID, SBN_ProtocolOutlet_t *Outlet)
+{
+    SBN_SERIAL_FIRST_EID = BaseEID;
+
+    if (Version != EXP_VERSION)
+    {
+        OS_printf("SBN_SERIAL version mismatch: expected %d, got %d\n", EXP_VERSION, Version);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Outlet == NULL)
+    {
+        OS_printf("SBN_SERIAL outlet is NULL\n");
         return SBN_ERROR;
     } /* end if */
 
+    /* copy outlet pointers to a local buffer for later use */
+    memcpy(&SBN, Outlet, sizeof(SBN));
+
+    OS_printf("SBN_SERIAL Lib Initialized.\n");
     return SBN_SUCCESS;
-} /* end SBN_SERIAL_Init() */
+} /* end Init() */
 
-int SBN_SERIAL_LoadNet(SBN_NetInterface_t *Net, const char *Address)
+/**
+ * Serial lines are point-to-point, all configuration is in the peer.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS
+ */
+static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
 {
-    /* this space intentionally left blank */
     return SBN_SUCCESS;
-} /* end SBN_SERIAL_LoadNet */
+} /* end InitNet() */
+
+static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
+{
+    /* devices are per peer, the count only tells UnloadNet when the last net goes */
+    LoadedNetCnt++;
 
-static uint8 SendBuf[SBN_MAX_PACKED_MSG_SZ], RecvBufs[SBN_MAX_NETS * SBN_MAX_PEERS_PER_NET];
-static int   BufCnt = 0;
+    return SBN_SUCCESS;
+} /* end LoadNet() */
 
-int SBN_SERIAL_LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
+/**
+ * Parses the "?key=val&key=val" options following the device path.
+ * Unset options keep their defaults.
+ *
+ * @param PeerData[out] The peer whose options to set.
+ * @param Address[in] The address string from the configuration table.
+ * @return SBN_SUCCESS on success, SBN_ERROR on an unknown key or bad value.
+ */
+static SBN_Status_t ConfOpts(SBN_SERIAL_Peer_t *PeerData, const char *Address)
+{
+    const char *Opt   = strchr(Address, '?');
+    speed_t     Speed = 0;
+
+    PeerData->Baud   = SBN_SERIAL_DEFAULT_BAUD;
+    PeerData->VMin   = 1;
+    PeerData->VTime  = 0;
+    PeerData->RTSCTS = false;
+    PeerData->FragSz = 0;
+
+    while (Opt != NULL)
+    {
+        Opt++; /* skip the '?' or '&' */
+
+        const char *Eq          = strchr(Opt, '=');
+        char *      ValidatePtr = NULL;
+
+        if (!Eq)
+        {
+            EVSSendErr(SBN_SERIAL_CONFIG_EID, "invalid option (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        unsigned long Val = strtoul(Eq + 1, &ValidatePtr, 0);
+        size_t        Len = Eq - Opt;
+
+        if (ValidatePtr == Eq + 1 || (*ValidatePtr != '\0' && *ValidatePtr != '&'))
+        {
+            EVSSendErr(SBN_SERIAL_CONFIG_EID, "invalid option value (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        if (SBN_OPT_IS(Opt, Len, "baud"))
+        {
+            PeerData->Baud = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "rtscts"))
+        {
+            PeerData->RTSCTS = (Val != 0);
+        }
+        else if (SBN_OPT_IS(Opt, Len, "vmin") && Val <= 255)
+        {
+            PeerData->VMin = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "vtime") && Val <= 255)
+        {
+            PeerData->VTime = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "frag")
+                 && (Val == 0 || (Val >= SBN_SERIAL_MIN_FRAG_SZ && Val <= SBN_SERIAL_MAX_FRAG_SZ)))
+        {
+            PeerData->FragSz = Val;
+        }
+        else
+        {
+            EVSSendErr(SBN_SERIAL_CONFIG_EID, "unknown option or value out of range (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        Opt = strchr(Opt, '&');
+    } /* end while */
+
+    if (!BaudToSpeed(PeerData->Baud, &Speed))
+    {
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "unsupported baud rate (%u)", (unsigned int)PeerData->Baud);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (PeerData->VMin == 0 && PeerData->VTime == 0)
+    {
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "vmin and vtime cannot both be 0");
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end ConfOpts() */
+
+static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
 {
     SBN_SERIAL_Peer_t *PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+    size_t             NameLen  = strcspn(Address, "?");
+
+    EVSSendInfo(SBN_SERIAL_CONFIG_EID, "configuring peer (SC=%d, CPU=%d, Address=%s)", Peer->SpacecraftID,
+                Peer->ProcessorID, Address);
+
+    if (BufCnt >= SBN_SERIAL_MAX_DEVICES)
+    {
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "too many serial devices (max=%d)", SBN_SERIAL_MAX_DEVICES);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (NameLen >= sizeof(PeerData->Filename))
+    {
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "device name too long (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
 
-    strncpy(PeerData->Filename, Address, sizeof(PeerData->Filename));
+    memset(PeerData->Filename, 0, sizeof(PeerData->Filename));
+    strncpy(PeerData->Filename, Address, NameLen);
+
+    if (ConfOpts(PeerData, Address) != SBN_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
 
     PeerData->BufNum = BufCnt++;
 
     return SBN_SUCCESS;
-} /* end SBN_SERIAL_LoadEntry */
+} /* end LoadPeer() */
 
 /**
- * Initializes an SERIAL host or peer data struct depending on the
- * CPU name.
+ * Drains a device's transmit queue at the line rate. One per device, spawned
+ * from InitPeer(); finds its queue by task ID.
+ */
+static void WriterTask(void)
+{
+    OS_TaskID_t       TaskID = OS_TaskGetId();
+    SBN_SERIAL_TxQ_t *TxQ    = NULL;
+    uint8 *           Chunk  = NULL;
+    uint64            OwedUs = 0;
+    uint8             BufNum = 0;
+
+    for (BufNum = 0; BufNum < BufCnt; BufNum++)
+    {
+        if (TxQs[BufNum].TaskID == TaskID)
+        {
+            break;
+        } /* end if */
+    }     /* end for */
+
+    if (BufNum == BufCnt)
+    {
+        EVSSendErr(SBN_SERIAL_DEVICE_EID, "unable to connect writer task to device");
+        return;
+    } /* end if */
+
+    TxQ   = &TxQs[BufNum];
+    Chunk = Chunks[BufNum];
+
+    while (1)
+    {
+        OS_BinSemTimedWait(TxQ->Sem, 1000);
+
+        while (1)
+        {
+            SBN_SERIAL_Peer_t *  PeerData = (SBN_SERIAL_Peer_t *)TxQ->Peer->ModulePvt;
+            SBN_SERIAL_TxLane_t *Lane     = NULL;
+            size_t               ChunkSz = 0, SentSz = 0, Part = 0;
+            int                  FD = -1;
+
+            if (OS_MutSemTake(TxQ->Mutex) != OS_SUCCESS)
+            {
+                break;
+            } /* end if */
+
+            FD = PeerData->DevOpen ? PeerData->FD : -1;
+
+            if (TxQ->CurLeft == 0)
+            {
+                /* between frames, take the highest priority lane with a frame queued */
+                for (TxQ->CurLane = 0; TxQ->CurLane < SBN_SERIAL_LANES - 1; TxQ->CurLane++)
+                {
+                    if (TxQ->Lanes[TxQ->CurLane].Used)
+                    {
+                        break;
+                    } /* end if */
+                }     /* end for */
+
+                Lane = &TxQ->Lanes[TxQ->CurLane];
+                if (Lane->Used)
+                {
+                    /* frames are queued whole, so the length is always there */
+                    TxQ->CurLeft = ((Lane->Buf[(Lane->Head + 2) % SBN_SERIAL_TXQ_SZ] << 8)
+                                    | Lane->Buf[(Lane->Head + 3) % SBN_SERIAL_TXQ_SZ])
+                                   + SBN_SERIAL_FRAME_OVERHEAD;
+                } /* end if */
+            }     /* end if */
+
+            Lane    = &TxQ->Lanes[TxQ->CurLane];
+            ChunkSz = TxQ->CurLeft < SBN_SERIAL_TX_CHUNK_SZ ? TxQ->CurLeft : SBN_SERIAL_TX_CHUNK_SZ;
+
+            Part = SBN_SERIAL_TXQ_SZ - Lane->Head;
+            if (Part > ChunkSz)
+            {
+                Part = ChunkSz;
+            } /* end if */
+
+            memcpy(Chunk, Lane->Buf + Lane->Head, Part);
+            memcpy(Chunk + Part, Lane->Buf, ChunkSz - Part);
+
+            Lane->Head = (Lane->Head + ChunkSz) % SBN_SERIAL_TXQ_SZ;
+            Lane->Used -= ChunkSz;
+            TxQ->CurLeft -= ChunkSz;
+
+            OS_MutSemGive(TxQ->Mutex);
+
+            if (ChunkSz == 0 || FD < 0)
+            {
+                break;
+            } /* end if */
+
+            while (SentSz < ChunkSz)
+            {
+                ssize_t Written = write(FD, Chunk + SentSz, ChunkSz - SentSz);
+
+                if (Written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    } /* end if */
+
+                    EVSSendErr(SBN_SERIAL_DEVICE_EID, "write error on %s (errno=%d)", PeerData->Filename, errno);
+                    TxQ->WriteErr = true;
+                    break;
+                } /* end if */
+
+                SentSz += Written;
+            } /* end while */
+
+            TxQ->ByteCnt += SentSz;
+            TxQ->IntervalBytes += SentSz;
+
+            if (TxQ->WriteErr)
+            {
+                break;
+            } /* end if */
+
+            /* 10 bits per byte on the wire (start, 8 data, stop), sleep off whole ms */
+            OwedUs += (uint64)SentSz * 10 * 1000000 / PeerData->Baud;
+            if (OwedUs >= 1000)
+            {
+                OS_TaskDelay(OwedUs / 1000);
+                OwedUs %= 1000;
+            } /* end if */
+        } /* end while */
+    }     /* end while */
+} /* end WriterTask() */
+
+/**
+ * Initializes a serial peer, the device is opened when first polled.
  *
  * @param  Interface data structure containing the file entry
  * @return SBN_SUCCESS on success, error code otherwise
  */
-int SBN_SERIAL_InitNet(SBN_NetInterface_t *Net)
+static SBN_Status_t InitPeer(SBN_PeerInterface_t *Peer)
 {
-    /* this space intentionally left blank */
+    SBN_SERIAL_Peer_t *PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+
+    SBN_SERIAL_TxQ_t * TxQ      = &TxQs[PeerData->BufNum];
+    char               Name[OS_MAX_API_NAME];
+
+    PeerData->DevOpen = false;
+    PeerData->FD      = -1;
+
+    SBN_SERIAL_DeframerInit(&Deframers[PeerData->BufNum]);
+    SBN_SERIAL_ReasmInit(&Reasms[PeerData->BufNum]);
+
+    memset(TxQ, 0, sizeof(*TxQ));
+    TxQ->Peer = Peer;
+    OS_GetLocalTime(&TxQ->IntervalStart);
+
+    snprintf(Name, sizeof(Name), "sbn_ser_mtx_%d", PeerData->BufNum);
+    if (OS_MutSemCreate(&TxQ->Mutex, Name, 0) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "unable to create tx mutex for %s", PeerData->Filename);
+        return SBN_ERROR;
+    } /* end if */
+
+    snprintf(Name, sizeof(Name), "sbn_ser_sem_%d", PeerData->BufNum);
+    if (OS_BinSemCreate(&TxQ->Sem, Name, OS_SEM_EMPTY, 0) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "unable to create tx semaphore for %s", PeerData->Filename);
+        return SBN_ERROR;
+    } /* end if */
+
+    snprintf(Name, sizeof(Name), "sbn_ser_tx_%d", PeerData->BufNum);
+    if (CFE_ES_CreateChildTask(&TxQ->TaskID, Name, (CFE_ES_ChildTaskMainFuncPtr_t)&WriterTask, NULL,
+                               SBN_SERIAL_CHILD_STACK_SIZE, SBN_SERIAL_CHILD_TASK_PRIORITY, 0) != CFE_SUCCESS)
+    {
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "unable to create writer task for %s", PeerData->Filename);
+        return SBN_ERROR;
+    } /* end if */
+
     return SBN_SUCCESS;
-} /* end SBN_SERIAL_Init */
+} /* end InitPeer() */
 
-/** returns 1 on successful connection */
-static int TrySerial(SBN_SERIAL_Peer_t *PeerData)
+/** returns true on successfully opening and configuring the device */
+static bool OpenDev(SBN_PeerInterface_t *Peer)
 {
+    SBN_SERIAL_Peer_t *PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+    struct termios     tty;
+    speed_t            Speed = B115200;
+
     OS_time_t CurrentTime;
     OS_GetLocalTime(&CurrentTime);
-    if (CurrentTime.seconds < PeerData->LastConnTry.seconds + SBN_SERIAL_CONNTRY_TIME)
+
+    if (OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, PeerData->LastConnTry)) < SBN_SERIAL_CONNTRY_TIME)
     {
-        return FALSE;
-    }
+        return false;
+    } /* end if */
 
-    int FD = open(PeerData->Filename, OS_READ_WRITE);
+    PeerData->LastConnTry = CurrentTime;
+
+    int FD = open(PeerData->Filename, O_RDWR | O_NOCTTY);
     if (FD < 0)
     {
-        CFE_EVS_SendEvent(SBN_SERIAL_DEVICE_EID, CFE_EVS_ERROR, "Unable to open device: %s\n", PeerData->Filename);
-        return FALSE;
-    }
-
-    struct termios tty;
+        EVSSendErr(SBN_SERIAL_DEVICE_EID, "unable to open device %s (errno=%d)", PeerData->Filename, errno);
+        return false;
+    } /* end if */
 
     if (tcgetattr(FD, &tty) != 0)
     {
-        CFE_EVS_SendEvent(SBN_SERIAL_CONFIG_EID, CFE_EVS_ERROR, "unable to get attrs on %s", PeerData->Filename);
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "unable to get attrs on %s", PeerData->Filename);
         close(FD);
-        return FALSE;
-    }
+        return false;
+    } /* end if */
 
-    cfsetspeed(&tty, B115200);
+    BaudToSpeed(PeerData->Baud, &Speed); /* validated in LoadPeer() */
+    cfsetspeed(&tty, Speed);
 
     cfmakeraw(&tty);
 
+    tty.c_cflag |= CLOCAL | CREAD;
+
+#ifdef CRTSCTS
+    if (PeerData->RTSCTS)
+    {
+        tty.c_cflag |= CRTSCTS;
+    }
+    else
+    {
+        tty.c_cflag &= ~CRTSCTS;
+    } /* end if */
+#else
+    if (PeerData->RTSCTS)
+    {
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "RTS/CTS flow control not supported, ignored for %s", PeerData->Filename);
+    } /* end if */
+#endif /* CRTSCTS */
+
+    /* by default reads block for at least one byte, the deframer handles the rest */
+    tty.c_cc[VMIN]  = PeerData->VMin;
+    tty.c_cc[VTIME] = PeerData->VTime;
+
     if (tcsetattr(FD, TCSANOW, &tty) != 0)
     {
-        CFE_EVS_SendEvent(SBN_SERIAL_CONFIG_EID, CFE_EVS_ERROR, "unable to set attrs on %s", PeerData->Filename);
+        EVSSendErr(SBN_SERIAL_CONFIG_EID, "unable to set attrs on %s", PeerData->Filename);
         close(FD);
-        return FALSE;
-    }
+        return false;
+    } /* end if */
 
-    /* all good! */
+    tcflush(FD, TCIOFLUSH);
 
-    CFE_EVS_SendEvent(SBN_SERIAL_DEBUG_EID, CFE_EVS_INFORMATION,
-                      "Serial device %s (task=%d, fd=%d) attached, flushing.", PeerData->Filename, OS_TaskGetId(), FD);
+    EVSSendInfo(SBN_SERIAL_DEVICE_EID, "serial device %s (fd=%d, baud=%u%s) attached", PeerData->Filename, FD,
+                (unsigned int)PeerData->Baud, PeerData->RTSCTS ? ", rtscts" : "");
 
-    PeerData->SerialConn = TRUE;
-    PeerData->FD         = FD;
+    SBN_SERIAL_DeframerInit(&Deframers[PeerData->BufNum]);
+    SBN_SERIAL_ReasmInit(&Reasms[PeerData->BufNum]);
 
-    return TRUE;
-}
+    PeerData->FD      = FD;
+    PeerData->DevOpen = true;
 
-/**
- * Initializes an SERIAL peer.
- *
- * @param  Interface data structure containing the file entry
- * @return SBN_SUCCESS on success, error code otherwise
- */
-int SBN_SERIAL_InitPeer(SBN_PeerInterface_t *Peer)
-{
-    return SBN_SUCCESS;
-} /* end SBN_SERIAL_Init */
+    return true;
+} /* end OpenDev() */
 
-int SBN_SERIAL_PollPeer(SBN_PeerInterface_t *Peer)
+static void CloseDev(SBN_PeerInterface_t *Peer)
 {
     SBN_SERIAL_Peer_t *PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+    SBN_SERIAL_TxQ_t * TxQ      = &TxQs[PeerData->BufNum];
+    int                i        = 0;
 
-    if (!PeerData->SerialConn)
-    {
-        if (!TrySerial(PeerData))
-        {
-            /* no luck */
-            return 0;
-        } /* end if */
-    }     /* end if */
+    /* the writer task reads FD under the mutex, queued frames are stale */
+    OS_MutSemTake(TxQ->Mutex);
 
-    OS_time_t CurrentTime;
-    OS_GetLocalTime(&CurrentTime);
-
-    if (SBN_SERIAL_PEER_HEARTBEAT > 0 && CurrentTime.seconds - Peer->LastSend.seconds > SBN_SERIAL_PEER_HEARTBEAT)
+    if (PeerData->DevOpen)
     {
-        SBN_SERIAL_Send(Peer, SBN_SERIAL_HEARTBEAT_MSG, 0, NULL);
+        close(PeerData->FD);
+        PeerData->DevOpen = false;
+        PeerData->FD      = -1;
     } /* end if */
 
-    if (SBN_SERIAL_PEER_TIMEOUT > 0 && CurrentTime.seconds - Peer->LastRecv.seconds > SBN_SERIAL_PEER_TIMEOUT)
+    for (i = 0; i < SBN_SERIAL_LANES; i++)
     {
-        CFE_EVS_SendEvent(SBN_SERIAL_DEBUG_EID, CFE_EVS_INFORMATION, "CPU %d disconnected", Peer->ProcessorID);
+        TxQ->Lanes[i].Head = 0;
+        TxQ->Lanes[i].Used = 0;
+    } /* end for */
 
-        close(PeerData->FD);
-        PeerData->Connected = FALSE;
+    TxQ->CurLeft  = 0;
+    TxQ->WriteErr = false;
 
-        SBN_Disconnected(Peer);
-    } /* end if */
+    OS_MutSemGive(TxQ->Mutex);
 
-    return 0;
-} /* end SBN_SERIAL_PollPeer */
+    if (Peer->Connected)
+    {
+        SBN.Disconnected(Peer);
+    } /* end if */
+} /* end CloseDev() */
 
-int SBN_SERIAL_Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg)
+static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
 {
     SBN_SERIAL_Peer_t *PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
 
-    if (!PeerData->SerialConn)
+    if (TxQs[PeerData->BufNum].WriteErr)
     {
-        return SBN_SUCCESS;
+        EVSSendErr(SBN_SERIAL_DEVICE_EID, "closing %s after write error", PeerData->Filename);
+        CloseDev(Peer);
     } /* end if */
 
-    SBN_PackMsg(&SendBuf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), Msg);
-    size_t sent_size = write(PeerData->FD, &SendBuf, MsgSz + SBN_PACKED_HDR_SZ);
-    if (sent_size < MsgSz + SBN_PACKED_HDR_SZ)
+    if (!PeerData->DevOpen && !OpenDev(Peer))
     {
-        CFE_EVS_SendEvent(SBN_SERIAL_DEBUG_EID, CFE_EVS_INFORMATION, "CPU %d disconnected", Peer->ProcessorID);
+        return SBN_SUCCESS; /* try again later */
+    } /* end if */
 
-        close(PeerData->FD);
-        PeerData->Connected = FALSE;
+    OS_time_t CurrentTime;
+    OS_GetLocalTime(&CurrentTime);
 
-        SBN_Disconnected(Peer);
+    if (Peer->Connected && SBN_SERIAL_PEER_TIMEOUT > 0
+        && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastRecv)) > SBN_SERIAL_PEER_TIMEOUT)
+    {
+        EVSSendInfo(SBN_SERIAL_DEBUG_EID, "disconnected peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+
+        /* the line stays open, the peer reconnects on its next good frame */
+        SBN.Disconnected(Peer);
+        return SBN_SUCCESS;
+    } /* end if */
+
+    /* heartbeats also announce me to a peer that is not yet connected */
+    if (SBN_SERIAL_PEER_HEARTBEAT > 0
+        && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_SERIAL_PEER_HEARTBEAT)
+    {
+        OS_GetLocalTime(&Peer->LastSend);
+        EVSSendDbg(SBN_SERIAL_DEBUG_EID, "sending heartbeat to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+        return SBN.SendNetMsg(SBN_SERIAL_HEARTBEAT_MSG, 0, NULL, Peer);
     } /* end if */
 
     return SBN_SUCCESS;
-} /* end SBN_SERIAL_Send */
+} /* end PollPeer() */
 
-int SBN_SERIAL_Recv(SBN_NetInterface_t *Net, SBN_PeerInterface_t *Peer, SBN_MsgType_t *MsgTypePtr,
-                    SBN_MsgSz_t *MsgSzPtr, SBN_CpuID_t *CpuIDPtr, void *MsgBuf)
+/**
+ * Protocol messages (subscriptions, heartbeats) and app messages the peer
+ * subscribed to with a non-zero QoS priority go in the high priority lane.
+ */
+static uint8 SelectLane(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, void *Payload)
 {
-    SBN_SERIAL_Peer_t *PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+    CFE_SB_MsgId_t MsgID;
+    int            i = 0;
 
-    if (!PeerData->SerialConn)
+    if (!SBN_IS_APP_MSG(MsgType))
     {
-        if (!TrySerial(PeerData))
+        return SBN_SERIAL_LANE_HIGH;
+    } /* end if */
+
+    /* sequenced and stamped app messages have their headers first */
+    if (CFE_MSG_GetMsgId((CFE_MSG_Message_t *)((uint8 *)Payload + SBN_APP_HDR_SZ(MsgType)), &MsgID) != CFE_SUCCESS)
+    {
+        return SBN_SERIAL_LANE_LOW;
+    } /* end if */
+
+    for (i = 0; i < Peer->SubCnt; i++)
+    {
+        if (CFE_SB_MsgId_Equal(Peer->Subs[i].MsgID, MsgID))
         {
-            return SBN_IF_EMPTY;
+            return Peer->Subs[i].QoS.Priority ? SBN_SERIAL_LANE_HIGH : SBN_SERIAL_LANE_LOW;
         } /* end if */
-    }     /* end if */
+    }     /* end for */
 
-#ifndef SBN_RECV_TASK
-    fd_set         ReadFDs;
-    struct timeval Timeout;
-    FD_ZERO(&ReadFDs);
-    FD_SET(PeerData->FD, &ReadFDs);
-    memset(&Timeout, 0, sizeof(Timeout));
-    Timeout.tv_usec = 100;
+    return SBN_SERIAL_LANE_LOW;
+} /* end SelectLane() */
 
-    int Result = 0;
-    if ((Result = select(FD_SETSIZE, &ReadFDs, NULL, NULL, &Timeout)) == 0)
+/** copies a frame to the end of a lane, the caller ensures it fits */
+static void Enqueue(SBN_SERIAL_TxLane_t *Lane, const uint8 *Frame, size_t FrameSz)
+{
+    size_t Tail = (Lane->Head + Lane->Used) % SBN_SERIAL_TXQ_SZ;
+    size_t Part = SBN_SERIAL_TXQ_SZ - Tail;
+
+    if (Part > FrameSz)
     {
-        return SBN_IF_EMPTY;
+        Part = FrameSz;
     } /* end if */
 
-    if (Result < 0)
+    memcpy(Lane->Buf + Tail, Frame, Part);
+    memcpy(Lane->Buf, Frame + Part, FrameSz - Part);
+
+    Lane->Used += FrameSz;
+} /* end Enqueue() */
+
+static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_SERIAL_Peer_t *  PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+    SBN_SERIAL_TxQ_t *   TxQ      = &TxQs[PeerData->BufNum];
+    SBN_SERIAL_TxLane_t *Lane     = NULL;
+    uint8 *              Buf      = SendBufs[PeerData->BufNum];
+    uint8 *              FragBuf  = FragBufs[PeerData->BufNum];
+    uint8 *              FragFrame = FragFrames[PeerData->BufNum];
+    size_t               PackedSz = MsgSz + SBN_PACKED_HDR_SZ, FrameSz = 0, FragCnt = 1, Offset = 0;
+    uint8                LaneIdx  = 0;
+
+    if (!PeerData->DevOpen)
     {
-        CFE_EVS_SendEvent(SBN_SERIAL_DEBUG_EID, CFE_EVS_INFORMATION,
-                          "Read error TaskID=%d, FD=%d, errno=%d, CPU=%d disconnected", OS_TaskGetId(), PeerData->FD,
-                          errno, Peer->ProcessorID);
+        /* fail silently as the device is not open (yet) */
+        return SBN_SUCCESS;
+    } /* end if */
 
-        close(PeerData->FD);
-        PeerData->Connected  = FALSE;
-        PeerData->SerialConn = FALSE;
+    LaneIdx = SelectLane(Peer, MsgType, Payload);
+    Lane    = &TxQ->Lanes[LaneIdx];
 
-        SBN_Disconnected(Peer);
+    SBN.PackMsg(Buf + SBN_SERIAL_FRAME_HDR_SZ, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(),
+                Payload);
 
-        return SBN_IF_EMPTY;
+    if (PeerData->FragSz && PackedSz > PeerData->FragSz)
+    {
+        FragCnt = (PackedSz + PeerData->FragSz - 1) / PeerData->FragSz;
+        FrameSz = PackedSz + FragCnt * (SBN_SERIAL_FRAME_OVERHEAD + SBN_PACKED_HDR_SZ + SBN_SERIAL_FRAG_HDR_SZ);
     }
-#endif /* !SBN_RECV_TASK */
+    else
+    {
+        FragCnt = 1;
+        FrameSz = SBN_SERIAL_Frame(Buf, PackedSz);
+    } /* end if */
 
-    ssize_t Received = 0;
+    if (OS_MutSemTake(TxQ->Mutex) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_SERIAL_DEVICE_EID, "unable to take tx mutex for %s", PeerData->Filename);
+        return SBN_ERROR;
+    } /* end if */
 
-    int ToRead = 0;
+    /* all fragments of a message are queued, or none */
+    if (FrameSz > SBN_SERIAL_TXQ_SZ - Lane->Used)
+    {
+        Lane->OverrunCnt++;
+        OS_MutSemGive(TxQ->Mutex);
+        return SBN_ERROR;
+    } /* end if */
 
-    if (!PeerData->ReceivingBody)
+    if (FragCnt == 1)
+    {
+        Enqueue(Lane, Buf, FrameSz);
+        TxQ->FrameCnt++;
+    }
+    else
     {
-        /* read the header first */
-        ToRead = SBN_PACKED_HDR_SZ - PeerData->RecvSz;
+        for (Offset = 0; Offset < PackedSz; Offset += PeerData->FragSz)
+        {
+            size_t DataSz = PackedSz - Offset < PeerData->FragSz ? PackedSz - Offset : PeerData->FragSz;
 
-        Received = read(PeerData->FD, (char *)&RecvBufs[PeerData->BufNum] + PeerData->RecvSz, ToRead);
+            SBN_SERIAL_FragHdr(FragBuf, LaneIdx, Lane->FragSeq, Offset, PackedSz);
+            memcpy(FragBuf + SBN_SERIAL_FRAG_HDR_SZ, Buf + SBN_SERIAL_FRAME_HDR_SZ + Offset, DataSz);
 
-        if (Received < 0)
-        {
-            CFE_EVS_SendEvent(SBN_SERIAL_DEBUG_EID, CFE_EVS_INFORMATION,
-                              "Read error FD=%d, errno=%d, CPU=%d disconnected", PeerData->FD, errno,
-                              Peer->ProcessorID);
+            SBN.PackMsg(FragFrame + SBN_SERIAL_FRAME_HDR_SZ, SBN_SERIAL_FRAG_HDR_SZ + DataSz, SBN_SERIAL_FRAG_MSG,
+                        CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), FragBuf);
 
-            close(PeerData->FD);
-            PeerData->Connected  = FALSE;
-            PeerData->SerialConn = FALSE;
+            Enqueue(Lane, FragFrame,
+                    SBN_SERIAL_Frame(FragFrame, SBN_PACKED_HDR_SZ + SBN_SERIAL_FRAG_HDR_SZ + DataSz));
+        } /* end for */
 
-            SBN_Disconnected(Peer);
+        Lane->FragSeq++;
+        TxQ->FrameCnt += FragCnt;
+        TxQ->FragCnt += FragCnt;
+    } /* end if */
 
-            return SBN_IF_EMPTY;
-        } /* end if */
+    if (Lane->Used > Lane->HighWater)
+    {
+        Lane->HighWater = Lane->Used;
+    } /* end if */
 
-        if (PeerData->Connected == FALSE)
-        {
-            CFE_EVS_SendEvent(SBN_SERIAL_DEBUG_EID, CFE_EVS_INFORMATION, "CPU=%d connected", Peer->ProcessorID);
-            PeerData->Connected = TRUE;
+    OS_MutSemGive(TxQ->Mutex);
 
-            SBN_Connected(Peer);
-        } /* end if */
+    OS_BinSemGive(TxQ->Sem);
 
-        PeerData->RecvSz += Received;
+    return SBN_SUCCESS;
+} /* end Send() */
 
-        if (Received >= ToRead)
-        {
-            PeerData->ReceivingBody = TRUE; /* and continue on to read body */
-        }
-        else
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_PeerInterface_t *Peer, SBN_MsgType_t *MsgTypePtr,
+                         SBN_MsgSz_t *MsgSzPtr, CFE_ProcessorID_t *ProcessorIDPtr,
+                         CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_SERIAL_Peer_t *    PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+    SBN_SERIAL_Deframer_t *Deframer = &Deframers[PeerData->BufNum];
+    uint8 *                Data     = NULL;
+    size_t                 DataSz   = 0;
+
+    if (!PeerData->DevOpen && !OpenDev(Peer))
+    {
+        if (Peer->TaskFlags & SBN_TASK_RECV)
         {
-            return SBN_IF_EMPTY; /* wait for the complete header */
-        }                        /* end if */
-    }                            /* end if */
+            OS_TaskDelay(1000); /* don't spin the recv task while the device is away */
+        } /* end if */
 
-    /* only get here if we're read'd the header and ready for the body */
+        return SBN_IF_EMPTY;
+    } /* end if */
 
-    ToRead = CFE_MAKE_BIG16(*((SBN_MsgSz_t *)&RecvBufs[PeerData->BufNum])) + SBN_PACKED_HDR_SZ - PeerData->RecvSz;
-    if (ToRead)
+    while (1)
     {
-        Received = read(PeerData->FD, (char *)&RecvBufs[PeerData->BufNum] + PeerData->RecvSz, ToRead);
-        if (Received < 0)
+        if (SBN_SERIAL_Deframe(Deframer, &Data, &DataSz) == SBN_SUCCESS)
         {
-            return SBN_ERROR;
+            if (DataSz < SBN_PACKED_HDR_SZ
+                || !SBN.UnpackMsg(Data, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload)
+                || *MsgSzPtr + SBN_PACKED_HDR_SZ != DataSz)
+            {
+                EVSSendDbg(SBN_SERIAL_DEBUG_EID, "unable to unpack frame from %s", PeerData->Filename);
+                continue;
+            } /* end if */
+
+            if (*ProcessorIDPtr != Peer->ProcessorID || *SpacecraftIDPtr != Peer->SpacecraftID)
+            {
+                EVSSendErr(SBN_SERIAL_DEBUG_EID, "unexpected peer %d:%d on %s", *SpacecraftIDPtr, *ProcessorIDPtr,
+                           PeerData->Filename);
+                continue;
+            } /* end if */
+
+            if (!Peer->Connected)
+            {
+                EVSSendInfo(SBN_SERIAL_DEBUG_EID, "connecting to peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+                SBN.Connected(Peer);
+            } /* end if */
+
+            if (*MsgTypePtr == SBN_SERIAL_FRAG_MSG)
+            {
+                if (SBN_SERIAL_Reasm(&Reasms[PeerData->BufNum], Payload, *MsgSzPtr, &Data, &DataSz) != SBN_SUCCESS)
+                {
+                    continue; /* need more fragments, or the fragment was dropped */
+                } /* end if */
+
+                if (DataSz < SBN_PACKED_HDR_SZ
+                    || !SBN.UnpackMsg(Data, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload)
+                    || *MsgSzPtr + SBN_PACKED_HDR_SZ != DataSz)
+                {
+                    EVSSendDbg(SBN_SERIAL_DEBUG_EID, "unable to unpack reassembled message from %s",
+                               PeerData->Filename);
+                    continue;
+                } /* end if */
+            }     /* end if */
+
+            return SBN_SUCCESS;
         } /* end if */
 
-        PeerData->RecvSz += Received;
+        /* need more bytes, polling uses select, otherwise block on read for task */
+        if (!(Peer->TaskFlags & SBN_TASK_RECV))
+        {
+            fd_set         ReadFDs;
+            struct timeval Timeout;
+
+            FD_ZERO(&ReadFDs);
+            FD_SET(PeerData->FD, &ReadFDs);
+            memset(&Timeout, 0, sizeof(Timeout));
 
-        if (Received < ToRead)
+            if (select(PeerData->FD + 1, &ReadFDs, NULL, NULL, &Timeout) <= 0)
+            {
+                return SBN_IF_EMPTY;
+            } /* end if */
+        }     /* end if */
+
+        ssize_t Received = read(PeerData->FD, Deframer->Buf + Deframer->BufUsed, sizeof(Deframer->Buf) - Deframer->BufUsed);
+
+        if (Received == 0 && PeerData->VMin == 0)
         {
-            return SBN_IF_EMPTY; /* wait for the complete body */
-        }                        /* end if */
-    }                            /* end if */
+            return SBN_IF_EMPTY; /* VTIME expired */
+        } /* end if */
 
-    /* we have the complete body, decode! */
-    if (SBN_UnpackMsg(&RecvBufs[PeerData->BufNum], MsgSzPtr, MsgTypePtr, CpuIDPtr, MsgBuf))
-    {
-        PeerData->Connected = TRUE;
-        SBN_Connected(Peer);
-    }
-    else
-    {
-        /* TODO: what to do if we can't unpack the message? */
-    } /* end if */
+        if (Received <= 0)
+        {
+            if (Received < 0 && errno == EINTR)
+            {
+                continue;
+            } /* end if */
 
-    PeerData->ReceivingBody = FALSE;
-    PeerData->RecvSz        = 0;
+            EVSSendErr(SBN_SERIAL_DEVICE_EID, "read error on %s (errno=%d), closing", PeerData->Filename, errno);
+            CloseDev(Peer);
+            return SBN_IF_EMPTY;
+        } /* end if */
 
-    return SBN_SUCCESS;
-} /* end SBN_SERIAL_Recv */
+        Deframer->BufUsed += Received;
+    } /* end while */
+} /* end Recv() */
 
-int SBN_SERIAL_ReportModuleStatus(SBN_ModuleStatusPacket_t *Packet)
+static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
 {
-    return SBN_NOT_IMPLEMENTED;
-} /* end SBN_SERIAL_ReportModuleStatus */
+    SBN_SERIAL_Peer_t *PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+    SBN_SERIAL_TxQ_t * TxQ      = &TxQs[PeerData->BufNum];
 
-int SBN_SERIAL_ResetPeer(SBN_PeerInterface_t *Peer)
-{
-    return SBN_NOT_IMPLEMENTED;
-} /* end SBN_SERIAL_ResetPeer */
+    CloseDev(Peer);
 
-int SBN_SERIAL_UnloadNet(SBN_NetInterface_t *Net)
-{
-    int PeerIdx = 0;
-    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    if (TxQ->TaskID)
     {
-        SBN_SERIAL_UnloadPeer(&Net->Peers[PeerIdx]);
+        CFE_ES_DeleteChildTask(TxQ->TaskID);
+        TxQ->TaskID = 0;
     } /* end if */
 
+    OS_BinSemDelete(TxQ->Sem);
+    OS_MutSemDelete(TxQ->Mutex);
+
     return SBN_SUCCESS;
-} /* end SBN_SERIAL_ResetPeer */
+} /* end UnloadPeer() */
 
-int SBN_SERIAL_UnloadPeer(SBN_PeerInterface_t *Peer)
+/**
+ * Reports the line settings and counters for a device, all big-endian:
+ *
+ * uint32 Baud, uint8 Flags (1=open, 2=rtscts), uint8 Utilization (% of the
+ * line rate since the last report), uint32 TxFrameCnt, TxByteCnt,
+ * TxOverrunCnt, TxQueued, TxHighWater, RxFrameCnt, RxHdrErrCnt, RxCRCErrCnt,
+ * RxSkipCnt, UARTOverrunCnt, UARTBufOverrunCnt, UARTFrameErrCnt,
+ * UARTParityErrCnt (the UART counters are 0 where the driver does not
+ * provide them), uint16 FragSz, uint32 TxFragCnt, RxFragCnt, RxReasmCnt,
+ * RxReasmErrCnt, then per lane (high first) uint32 Queued, HighWater,
+ * OverrunCnt. TxQueued, TxHighWater and TxOverrunCnt are lane totals.
+ */
+static SBN_Status_t ReportModuleStatus(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz)
 {
-    SBN_SERIAL_Peer_t *PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+    SBN_SERIAL_Peer_t *    PeerData = (SBN_SERIAL_Peer_t *)Peer->ModulePvt;
+    SBN_SERIAL_TxQ_t *     TxQ      = &TxQs[PeerData->BufNum];
+    SBN_SERIAL_Deframer_t *Deframer = &Deframers[PeerData->BufNum];
+    SBN_SERIAL_Reasm_t *   Reasm    = &Reasms[PeerData->BufNum];
+    uint8 *                Ptr      = StatusBuf;
+    uint32                 Queued = 0, HighWater = 0, OverrunCnt = 0;
+    int                    i      = 0;
+    uint32                 Overrun = 0, BufOverrun = 0, FrameErr = 0, ParityErr = 0;
+    uint64                 Util = 0;
+    int64                  ElapsedMs = 0;
+    OS_time_t              CurrentTime;
+
+    if (StatusBufSz < 2 + 15 * 4 + 2 + 4 * 4 + SBN_SERIAL_LANES * 3 * 4)
+    {
+        return SBN_ERROR;
+    } /* end if */
 
-    if (PeerData->FD)
+    OS_GetLocalTime(&CurrentTime);
+    ElapsedMs = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(CurrentTime, TxQ->IntervalStart));
+    if (ElapsedMs > 0)
     {
-        close(PeerData->FD);
+        /* bits sent / bits the line could have sent */
+        Util = (uint64)TxQ->IntervalBytes * 10 * 1000 * 100 / ((uint64)PeerData->Baud * ElapsedMs);
     } /* end if */
+    TxQ->IntervalBytes = 0;
+    TxQ->IntervalStart = CurrentTime;
+
+    for (i = 0; i < SBN_SERIAL_LANES; i++)
+    {
+        Queued += TxQ->Lanes[i].Used;
+        HighWater += TxQ->Lanes[i].HighWater;
+        OverrunCnt += TxQ->Lanes[i].OverrunCnt;
+    } /* end for */
 
-    if (PeerData->Connected)
+#ifdef TIOCGICOUNT
+    if (PeerData->DevOpen)
     {
-        SBN_Disconnected(Peer);
+        struct serial_icounter_struct ICount;
+
+        if (ioctl(PeerData->FD, TIOCGICOUNT, &ICount) == 0)
+        {
+            Overrun    = ICount.overrun;
+            BufOverrun = ICount.buf_overrun;
+            FrameErr   = ICount.frame;
+            ParityErr  = ICount.parity;
+        } /* end if */
+    }     /* end if */
+#endif /* TIOCGICOUNT */
+
+    Ptr    = SBN_PutUInt32(Ptr, PeerData->Baud);
+    *Ptr++ = (PeerData->DevOpen ? 1 : 0) | (PeerData->RTSCTS ? 2 : 0);
+    *Ptr++ = Util > 100 ? 100 : Util;
+    Ptr    = SBN_PutUInt32(Ptr, TxQ->FrameCnt);
+    Ptr    = SBN_PutUInt32(Ptr, TxQ->ByteCnt);
+    Ptr    = SBN_PutUInt32(Ptr, OverrunCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Queued);
+    Ptr    = SBN_PutUInt32(Ptr, HighWater);
+    Ptr    = SBN_PutUInt32(Ptr, Deframer->FrameCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Deframer->HdrErrCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Deframer->CRCErrCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Deframer->SkipCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Overrun);
+    Ptr    = SBN_PutUInt32(Ptr, BufOverrun);
+    Ptr    = SBN_PutUInt32(Ptr, FrameErr);
+    Ptr    = SBN_PutUInt32(Ptr, ParityErr);
+    *Ptr++ = PeerData->FragSz >> 8;
+    *Ptr++ = PeerData->FragSz & 0xFF;
+    Ptr    = SBN_PutUInt32(Ptr, TxQ->FragCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Reasm->FragCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Reasm->MsgCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Reasm->ErrCnt);
+
+    for (i = 0; i < SBN_SERIAL_LANES; i++)
+    {
+        Ptr = SBN_PutUInt32(Ptr, TxQ->Lanes[i].Used);
+        Ptr = SBN_PutUInt32(Ptr, TxQ->Lanes[i].HighWater);
+        Ptr = SBN_PutUInt32(Ptr, TxQ->Lanes[i].OverrunCnt);
+    } /* end for */
+
+    return SBN_SUCCESS;
+} /* end ReportModuleStatus() */
+
+static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
+{
+    SBN_PeerIdx_t PeerIdx = 0;
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        UnloadPeer(&Net->Peers[PeerIdx]);
+    } /* end for */
+
+    /* devices of other nets may still be open in the later slots, so they are only reused once all are unloaded */
+    if (LoadedNetCnt && --LoadedNetCnt == 0)
+    {
+        BufCnt = 0;
     } /* end if */
 
     return SBN_SUCCESS;
-} /* end SBN_SERIAL_ResetPeer */
+} /* end UnloadNet() */
+
+SBN_IfOps_t SBN_SERIAL_Ops = {Init, InitNet,   InitPeer,   LoadNet,           LoadPeer, PollPeer,
+                              Send, Recv,      NULL,       UnloadNet,         UnloadPeer, ReportModuleStatus};
@@ -1,67 +1,110 @@
 #ifndef _sbn_serial_if_h_
 #define _sbn_serial_if_h_
 
-#include "sbn_constants.h"
+#include "sbn_serial_events.h"
+#include "sbn_serial_platform_cfg.h"
+#include "sbn_platform_cfg.h"
+#include <string.h>
+#include <errno.h>
+
 #include "sbn_interfaces.h"
+#include "sbn_serial_frag.h"
 #include "cfe.h"
 
-/* The version #'s this module works with. If this doesn't match the core
- * SBN application version #'s, this module should report and return an error.
- * Note: these DEFINITELY should be hardcoded here, do not map them to
- * the SBN version numbers.
+/**
+ * Serial-specific message types.
  */
-#define SBN_SERIAL_MAJOR    1
-#define SBN_SERIAL_MINOR    11
-#define SBN_SERIAL_REVISION 0
+#define SBN_SERIAL_HEARTBEAT_MSG 0xA0
+#define SBN_SERIAL_FRAG_MSG      0xA1
 
-int SBN_SERIAL_Init(int Major, int Minor, int Revision);
+/**
+ * If unable to open the serial device, try again in
+ * SBN_SERIAL_CONNTRY_TIME seconds.
+ */
+#define SBN_SERIAL_CONNTRY_TIME 10
 
-int SBN_SERIAL_LoadNet(SBN_NetInterface_t *Net, const char *Address);
+typedef struct
+{
+    /** @brief The device path, e.g. "/dev/ttyS0". */
+    char Filename[SBN_SERIAL_MAX_CHAR_NAME];
 
-int SBN_SERIAL_LoadPeer(SBN_PeerInterface_t *Peer, const char *Address);
+    /** @brief The open device, only valid if DevOpen. */
+    int FD;
 
-int SBN_SERIAL_InitNet(SBN_NetInterface_t *Net);
+    /** @brief Is the serial device open? */
+    bool DevOpen;
 
-int SBN_SERIAL_InitPeer(SBN_PeerInterface_t *Peer);
+    /** @brief Index into the module's send/receive buffers. */
+    uint8 BufNum;
 
-int SBN_SERIAL_PollPeer(SBN_PeerInterface_t *Peer);
+    /** @brief See SBN_SERIAL_CONNTRY_TIME. */
+    OS_time_t LastConnTry;
 
-int SBN_SERIAL_Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload);
+    /** @brief Line rate in bits/s, from the "baud" address option. */
+    uint32 Baud;
 
-int SBN_SERIAL_Recv(SBN_NetInterface_t *Net, SBN_PeerInterface_t *Peer, SBN_MsgType_t *MsgTypePtr,
-                    SBN_MsgSz_t *MsgSzPtr, SBN_CpuID_t *CpuIDPtr, void *PayloadBuffer);
+    /** @brief termios VMIN/VTIME, from the "vmin"/"vtime" address options. */
+    uint8 VMin, VTime;
 
-int SBN_SERIAL_ReportModuleStatus(SBN_ModuleStatusPacket_t *Packet);
+    /** @brief Use RTS/CTS hardware flow control, from the "rtscts" address option. */
+    bool RTSCTS;
 
-int SBN_SERIAL_ResetPeer(SBN_PeerInterface_t *Peer);
+    /** @brief Largest packed message sent whole, 0 to never fragment; the "frag" address option. */
+    uint16 FragSz;
+} SBN_SERIAL_Peer_t;
 
-int SBN_SERIAL_UnloadNet(SBN_NetInterface_t *Net);
+/** @brief A ring of queued frames. */
+typedef struct
+{
+    /** @brief Queued frame bytes, Used bytes starting at Head (wrapping). */
+    uint8  Buf[SBN_SERIAL_TXQ_SZ];
+    size_t Head, Used;
 
-int SBN_SERIAL_UnloadPeer(SBN_PeerInterface_t *Peer);
+    /** @brief Most bytes ever queued at once. */
+    size_t HighWater;
 
-SBN_IfOps_t SBN_SERIAL_Ops = {SBN_SERIAL_Init,
-                              SBN_SERIAL_LoadNet,
-                              SBN_SERIAL_LoadPeer,
-                              SBN_SERIAL_InitNet,
-                              SBN_SERIAL_InitPeer,
-                              SBN_SERIAL_PollPeer,
-                              SBN_SERIAL_Send,
-                              SBN_SERIAL_Recv,
-                              NULL,
-                              SBN_SERIAL_ReportModuleStatus,
-                              SBN_SERIAL_ResetPeer,
-                              SBN_SERIAL_UnloadNet,
-                              SBN_SERIAL_UnloadPeer};
+    /** @brief Messages dropped because the ring was full. */
+    uint32 OverrunCnt;
 
-/**
- * SBN message type for heartbeat messages.
- */
-#define SBN_SERIAL_HEARTBEAT_MSG 0xA0
+    /** @brief Sequence number of the next fragmented message. */
+    uint16 FragSeq;
+} SBN_SERIAL_TxLane_t;
 
 /**
- * If unable to connect to the serial device, try again in
- * SBN_SERIAL_CONNTRY_TIME seconds.
+ * Sends are framed into per-device, per-priority rings and drained by a
+ * writer task that paces itself to the line rate, so a burst of sends never
+ * blocks the caller on the driver and excess traffic is dropped (and counted)
+ * here rather than silently backing up in the kernel. Between frames, the
+ * writer always takes the next frame from the highest priority lane.
  */
-#define SBN_SERIAL_CONNTRY_TIME 10
+typedef struct
+{
+    SBN_SERIAL_TxLane_t Lanes[SBN_SERIAL_LANES];
+
+    /** @brief The lane of the frame being written and how many of its bytes are left. */
+    uint8  CurLane;
+    size_t CurLeft;
+
+    /** @brief Protects the ring, taken by senders and the writer task. */
+    OS_MutexID_t Mutex;
+
+    /** @brief Given when frames are queued, wakes the writer task. */
+    uint32 Sem;
+
+    OS_TaskID_t TaskID;
+
+    /** @brief The peer this queue sends to. */
+    SBN_PeerInterface_t *Peer;
+
+    /** @brief Set by the writer task on a write error, the device is closed on the next poll. */
+    bool WriteErr;
+
+    /** @brief Frames queued (fragments count individually), fragments queued, bytes written. */
+    uint32 FrameCnt, FragCnt, ByteCnt;
+
+    /** @brief Bytes written since IntervalStart, for utilization. */
+    uint32    IntervalBytes;
+    OS_time_t IntervalStart;
+} SBN_SERIAL_TxQ_t;
 
 #endif /* _sbn_serial_if_h_ */
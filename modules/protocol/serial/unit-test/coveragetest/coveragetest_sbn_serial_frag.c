@@ -0,0 +1,178 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_serial_frag.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN serial fragment reassembly
+*/
+
+#include "sbn_serial_coveragetest_common.h"
+#include "sbn_serial_frag.h"
+
+static SBN_SERIAL_Reasm_t Reasm;
+
+static uint8 Msgs[SBN_SERIAL_LANES][2048];
+static uint8 Frag[SBN_SERIAL_FRAG_HDR_SZ + 256];
+
+/* feeds fragment Idx (of FragSz-byte fragments) of Msgs[Lane] to the reassembler */
+static SBN_Status_t Feed(uint8 Lane, uint16 Seq, size_t MsgSz, size_t FragSz, int Idx, uint8 **MsgPtr,
+                         size_t *MsgSzPtr)
+{
+    size_t Offset = Idx * FragSz;
+    size_t DataSz = MsgSz - Offset < FragSz ? MsgSz - Offset : FragSz;
+
+    SBN_SERIAL_FragHdr(Frag, Lane, Seq, Offset, MsgSz);
+    memcpy(Frag + SBN_SERIAL_FRAG_HDR_SZ, Msgs[Lane] + Offset, DataSz);
+
+    return SBN_SERIAL_Reasm(&Reasm, Frag, SBN_SERIAL_FRAG_HDR_SZ + DataSz, MsgPtr, MsgSzPtr);
+} /* end Feed() */
+
+static void FillMsgs(void)
+{
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(Msgs[0]); i++)
+    {
+        Msgs[SBN_SERIAL_LANE_HIGH][i] = i & 0xFF;
+        Msgs[SBN_SERIAL_LANE_LOW][i]  = ~i & 0xFF;
+    } /* end for */
+} /* end FillMsgs() */
+
+static void Reasm_Nominal(void)
+{
+    uint8 *Msg   = NULL;
+    size_t MsgSz = 0;
+
+    FillMsgs();
+    SBN_SERIAL_ReasmInit(&Reasm);
+
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 1, 600, 256, 0, &Msg, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 1, 600, 256, 1, &Msg, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 1, 600, 256, 2, &Msg, &MsgSz), SBN_SUCCESS);
+
+    UtAssert_True(MsgSz == 600, "message size %d == 600", (int)MsgSz);
+    UtAssert_True(Msg != NULL && memcmp(Msg, Msgs[SBN_SERIAL_LANE_LOW], 600) == 0, "message intact");
+    UtAssert_True(Reasm.FragCnt == 3 && Reasm.MsgCnt == 1 && Reasm.ErrCnt == 0, "counters");
+} /* end Reasm_Nominal() */
+
+static void Reasm_Interleaved(void)
+{
+    uint8 *Msg   = NULL;
+    size_t MsgSz = 0;
+
+    FillMsgs();
+    SBN_SERIAL_ReasmInit(&Reasm);
+
+    /* a high priority message, itself fragmented, arrives between low priority fragments */
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 7, 700, 256, 0, &Msg, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_HIGH, 3, 300, 256, 0, &Msg, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_HIGH, 3, 300, 256, 1, &Msg, &MsgSz), SBN_SUCCESS);
+
+    UtAssert_True(MsgSz == 300, "high message size %d == 300", (int)MsgSz);
+    UtAssert_True(memcmp(Msg, Msgs[SBN_SERIAL_LANE_HIGH], 300) == 0, "high message intact");
+
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 7, 700, 256, 1, &Msg, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 7, 700, 256, 2, &Msg, &MsgSz), SBN_SUCCESS);
+
+    UtAssert_True(MsgSz == 700, "low message size %d == 700", (int)MsgSz);
+    UtAssert_True(memcmp(Msg, Msgs[SBN_SERIAL_LANE_LOW], 700) == 0, "low message intact");
+    UtAssert_True(Reasm.MsgCnt == 2 && Reasm.ErrCnt == 0, "counters");
+} /* end Reasm_Interleaved() */
+
+static void Reasm_Lost(void)
+{
+    uint8 *Msg   = NULL;
+    size_t MsgSz = 0;
+
+    FillMsgs();
+    SBN_SERIAL_ReasmInit(&Reasm);
+
+    /* middle fragment lost, the rest of that message is dropped */
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 1, 600, 256, 0, &Msg, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 1, 600, 256, 2, &Msg, &MsgSz), SBN_ERROR);
+
+    /* last fragment lost, the next message starts over */
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 2, 600, 256, 0, &Msg, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 2, 600, 256, 1, &Msg, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 3, 400, 256, 0, &Msg, &MsgSz), SBN_IF_EMPTY);
+
+    /* a fragment from a different message with the right offset is still rejected */
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 4, 400, 256, 1, &Msg, &MsgSz), SBN_ERROR);
+
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 5, 400, 256, 0, &Msg, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(SBN_SERIAL_LANE_LOW, 5, 400, 256, 1, &Msg, &MsgSz), SBN_SUCCESS);
+
+    UtAssert_True(MsgSz == 400, "message size %d == 400", (int)MsgSz);
+    UtAssert_True(Reasm.MsgCnt == 1 && Reasm.ErrCnt == 3, "MsgCnt=%d ErrCnt=%d", (int)Reasm.MsgCnt,
+                  (int)Reasm.ErrCnt);
+} /* end Reasm_Lost() */
+
+static void Reasm_BadHdr(void)
+{
+    uint8 *Msg   = NULL;
+    size_t MsgSz = 0;
+
+    SBN_SERIAL_ReasmInit(&Reasm);
+
+    /* too short */
+    UT_TEST_FUNCTION_RC(SBN_SERIAL_Reasm(&Reasm, Frag, SBN_SERIAL_FRAG_HDR_SZ, &Msg, &MsgSz), SBN_ERROR);
+
+    /* bad lane */
+    SBN_SERIAL_FragHdr(Frag, SBN_SERIAL_LANES, 0, 0, 100);
+    UT_TEST_FUNCTION_RC(SBN_SERIAL_Reasm(&Reasm, Frag, sizeof(Frag), &Msg, &MsgSz), SBN_ERROR);
+
+    /* total larger than any packed message */
+    SBN_SERIAL_FragHdr(Frag, SBN_SERIAL_LANE_LOW, 0, 0, 0xFFFF);
+    UT_TEST_FUNCTION_RC(SBN_SERIAL_Reasm(&Reasm, Frag, sizeof(Frag), &Msg, &MsgSz), SBN_ERROR);
+
+    /* fragment overruns the total */
+    SBN_SERIAL_FragHdr(Frag, SBN_SERIAL_LANE_LOW, 0, 0, 100);
+    UT_TEST_FUNCTION_RC(SBN_SERIAL_Reasm(&Reasm, Frag, sizeof(Frag), &Msg, &MsgSz), SBN_ERROR);
+
+    UtAssert_True(Reasm.ErrCnt == 4 && Reasm.MsgCnt == 0, "ErrCnt=%d", (int)Reasm.ErrCnt);
+} /* end Reasm_BadHdr() */
+
+void Test_SBN_SERIAL_Frag(void)
+{
+    Reasm_Nominal();
+    Reasm_Interleaved();
+    Reasm_Lost();
+    Reasm_BadHdr();
+} /* end Test_SBN_SERIAL_Frag() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_SERIAL_Frag);
+}
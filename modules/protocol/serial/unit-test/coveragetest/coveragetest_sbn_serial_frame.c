@@ -0,0 +1,267 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_serial_frame.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN serial framing layer
+**
+** Notes:
+** The framing layer is pure data handling, so these tests feed it
+** byte streams (including corrupted ones) directly, and once over a
+** real pty pair to exercise it the way the serial module does.
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* posix_openpt(), cfmakeraw() */
+#endif
+
+#include "sbn_serial_coveragetest_common.h"
+#include "sbn_serial_frame.h"
+
+#include <stdlib.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+static SBN_SERIAL_Deframer_t Deframer;
+
+static uint8 Frames[4][SBN_SERIAL_MAX_FRAME_SZ];
+static uint8 Stream[4 * SBN_SERIAL_MAX_FRAME_SZ];
+
+/* builds a frame of DataSz bytes of Fill in Frames[Idx], returns the frame size */
+static size_t MakeFrame(int Idx, uint8 Fill, size_t DataSz)
+{
+    memset(Frames[Idx] + SBN_SERIAL_FRAME_HDR_SZ, Fill, DataSz);
+    return SBN_SERIAL_Frame(Frames[Idx], DataSz);
+} /* end MakeFrame() */
+
+static void Push(const uint8 *Data, size_t DataSz)
+{
+    memcpy(Deframer.Buf + Deframer.BufUsed, Data, DataSz);
+    Deframer.BufUsed += DataSz;
+} /* end Push() */
+
+static void CheckFrame(uint8 Fill, size_t DataSz)
+{
+    uint8 *Data = NULL;
+    size_t Sz   = 0;
+
+    UT_TEST_FUNCTION_RC(SBN_SERIAL_Deframe(&Deframer, &Data, &Sz), SBN_SUCCESS);
+    UtAssert_True(Sz == DataSz, "frame size %d == %d", (int)Sz, (int)DataSz);
+    UtAssert_True(Sz == 0 || (Data[0] == Fill && Data[Sz - 1] == Fill), "frame data intact");
+} /* end CheckFrame() */
+
+static void CRC16_Check(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_SERIAL_CRC16((const uint8 *)"123456789", 9), 0x29B1);
+} /* end CRC16_Check() */
+
+static void Deframe_Nominal(void)
+{
+    SBN_SERIAL_DeframerInit(&Deframer);
+
+    size_t Sz = MakeFrame(0, 0x42, 100);
+    UtAssert_True(Sz == 100 + SBN_SERIAL_FRAME_OVERHEAD, "frame size");
+
+    Push(Frames[0], Sz);
+    CheckFrame(0x42, 100);
+
+    UtAssert_True(Deframer.FrameCnt == 1, "FrameCnt == 1");
+} /* end Deframe_Nominal() */
+
+static void Deframe_Partial(void)
+{
+    uint8 *Data = NULL;
+    size_t Sz = MakeFrame(0, 0x42, 20), i = 0, DataSz = 0;
+
+    SBN_SERIAL_DeframerInit(&Deframer);
+
+    for (i = 0; i < Sz - 1; i++)
+    {
+        Push(Frames[0] + i, 1);
+        UT_TEST_FUNCTION_RC(SBN_SERIAL_Deframe(&Deframer, &Data, &DataSz), SBN_IF_EMPTY);
+    } /* end for */
+
+    Push(Frames[0] + i, 1);
+    CheckFrame(0x42, 20);
+} /* end Deframe_Partial() */
+
+static void Deframe_Garbage(void)
+{
+    uint8 Garbage[] = {0x00, 0xEB, 0x00, 0x90, 0xEB, 0xEB};
+    size_t Sz = MakeFrame(0, 0x42, 10);
+
+    SBN_SERIAL_DeframerInit(&Deframer);
+
+    Push(Garbage, sizeof(Garbage));
+    Push(Frames[0], Sz);
+    CheckFrame(0x42, 10);
+
+    UtAssert_True(Deframer.SkipCnt == sizeof(Garbage), "SkipCnt == %d", (int)Deframer.SkipCnt);
+} /* end Deframe_Garbage() */
+
+static void Deframe_CRCErr(void)
+{
+    size_t Sz0 = MakeFrame(0, 0x11, 50), Sz1 = MakeFrame(1, 0x22, 60);
+
+    SBN_SERIAL_DeframerInit(&Deframer);
+
+    Frames[0][SBN_SERIAL_FRAME_HDR_SZ + 25] ^= 0x04; /* single bit error */
+
+    Push(Frames[0], Sz0);
+    Push(Frames[1], Sz1);
+    CheckFrame(0x22, 60);
+
+    UtAssert_True(Deframer.CRCErrCnt == 1, "CRCErrCnt == 1");
+    UtAssert_True(Deframer.FrameCnt == 1, "FrameCnt == 1");
+} /* end Deframe_CRCErr() */
+
+static void Deframe_LenErr(void)
+{
+    uint8 *Data = NULL;
+    size_t Sz0 = MakeFrame(0, 0x11, 10), Sz1 = MakeFrame(1, 0x22, 10), DataSz = 0;
+
+    SBN_SERIAL_DeframerInit(&Deframer);
+
+    Frames[0][2] ^= 0x40; /* length now claims 16K */
+
+    Push(Frames[0], Sz0);
+
+    /* the bad length is rejected without waiting for 16K bytes */
+    UT_TEST_FUNCTION_RC(SBN_SERIAL_Deframe(&Deframer, &Data, &DataSz), SBN_IF_EMPTY);
+    UtAssert_True(Deframer.HdrErrCnt == 1, "HdrErrCnt == 1");
+
+    Push(Frames[1], Sz1);
+    CheckFrame(0x22, 10);
+} /* end Deframe_LenErr() */
+
+static void Deframe_Empty(void)
+{
+    size_t Sz0 = MakeFrame(0, 0, 0), Sz1 = MakeFrame(1, 0x33, 5);
+
+    SBN_SERIAL_DeframerInit(&Deframer);
+
+    Push(Frames[0], Sz0);
+    Push(Frames[1], Sz1);
+    CheckFrame(0, 0);
+    CheckFrame(0x33, 5);
+} /* end Deframe_Empty() */
+
+void Test_SBN_SERIAL_Frame(void)
+{
+    CRC16_Check();
+    Deframe_Nominal();
+    Deframe_Partial();
+    Deframe_Garbage();
+    Deframe_CRCErr();
+    Deframe_LenErr();
+    Deframe_Empty();
+} /* end Test_SBN_SERIAL_Frame() */
+
+static void Pty_BitErrors(void)
+{
+    struct termios tty;
+    size_t         StreamSz = 0, Sz = 0, Got = 0;
+    int            Master = posix_openpt(O_RDWR | O_NOCTTY), Slave = -1, i = 0;
+
+    UtAssert_True(Master >= 0, "posix_openpt");
+    UtAssert_True(grantpt(Master) == 0 && unlockpt(Master) == 0, "grantpt/unlockpt");
+
+    Slave = open(ptsname(Master), O_RDWR | O_NOCTTY);
+    UtAssert_True(Slave >= 0, "open slave");
+
+    tcgetattr(Slave, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(Slave, TCSANOW, &tty);
+
+    /* good, corrupted, garbage, good, good */
+    Sz = MakeFrame(0, 0x01, 200);
+    memcpy(Stream + StreamSz, Frames[0], Sz);
+    StreamSz += Sz;
+    Sz = MakeFrame(1, 0x02, 300);
+    Frames[1][SBN_SERIAL_FRAME_HDR_SZ + 100] ^= 0x80;
+    memcpy(Stream + StreamSz, Frames[1], Sz);
+    StreamSz += Sz;
+    Stream[StreamSz++] = 0xEB;
+    Stream[StreamSz++] = 0x55;
+    Sz = MakeFrame(2, 0x03, 400);
+    memcpy(Stream + StreamSz, Frames[2], Sz);
+    StreamSz += Sz;
+    Sz = MakeFrame(3, 0x04, 0);
+    memcpy(Stream + StreamSz, Frames[3], Sz);
+    StreamSz += Sz;
+
+    UtAssert_True(write(Master, Stream, StreamSz) == (ssize_t)StreamSz, "write to master");
+
+    SBN_SERIAL_DeframerInit(&Deframer);
+
+    while (Got < 3 && i++ < 100)
+    {
+        uint8 * Data   = NULL;
+        size_t  DataSz = 0;
+        ssize_t Received = read(Slave, Deframer.Buf + Deframer.BufUsed, sizeof(Deframer.Buf) - Deframer.BufUsed);
+
+        UtAssert_True(Received > 0, "read from slave");
+        if (Received <= 0)
+        {
+            break;
+        } /* end if */
+
+        Deframer.BufUsed += Received;
+
+        while (SBN_SERIAL_Deframe(&Deframer, &Data, &DataSz) == SBN_SUCCESS)
+        {
+            UtAssert_True(Data == NULL || DataSz == 0 || Data[0] != 0x02, "corrupted frame not delivered");
+            Got++;
+        } /* end while */
+    }     /* end while */
+
+    UtAssert_True(Got == 3, "3 good frames received (%d)", (int)Got);
+    UtAssert_True(Deframer.CRCErrCnt == 1, "CRCErrCnt == 1");
+
+    close(Slave);
+    close(Master);
+} /* end Pty_BitErrors() */
+
+void Test_SBN_SERIAL_Pty(void)
+{
+    Pty_BitErrors();
+} /* end Test_SBN_SERIAL_Pty() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_SERIAL_Frame);
+    ADD_TEST(SBN_SERIAL_Pty);
+}
@@ -0,0 +1,20 @@
+/**
+ * @file
+ *
+ * This file contains several user-configurable parameters
+ */
+#ifndef _spw_platform_cfg_h_
+#define _spw_platform_cfg_h_
+
+#define SBN_SPW_MAX_CHAR_NAME 32 /**< How long a device path can be in the peer address */
+
+#define SBN_SPW_MAX_CLASS_NAME 16 /**< How long the sysfs device class can be */
+
+#define SBN_SPW_MAX_DEVICES 4 /**< How many SpaceWire devices (peers) this module can drive */
+
+/** How often (in seconds) the link status is read from sysfs, for devices with a "class" option. */
+#define SBN_SPW_LINK_CHECK_TIME 1
+
+#define SBN_SPW_PEER_HEARTBEAT 5
+#define SBN_SPW_PEER_TIMEOUT   10
+#endif
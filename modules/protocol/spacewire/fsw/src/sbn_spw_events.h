@@ -0,0 +1,13 @@
+#ifndef _sbn_spw_events_h
+#define _sbn_spw_events_h
+
+#include "sbn_types.h"
+
+extern CFE_EVS_EventID_t SBN_SPW_FIRST_EID; /* defined at module init time */
+
+#define SBN_SPW_DEVICE_EID SBN_SPW_FIRST_EID + 1 /* skip 0th */
+#define SBN_SPW_CONFIG_EID SBN_SPW_FIRST_EID + 2
+#define SBN_SPW_DEBUG_EID  SBN_SPW_FIRST_EID + 3
+#define SBN_SPW_LINK_EID   SBN_SPW_FIRST_EID + 4
+
+#endif /* _sbn_spw_events_h */
@@ -0,0 +1,618 @@
+#include "sbn_spw_if.h"
+#include "sbn_module_util.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* at some point this will be replaced by the OSAL network interface */
+#ifdef _VXWORKS_OS_
+#include "selectLib.h"
+#else
+#include <sys/select.h>
+#endif
+
+CFE_EVS_EventID_t SBN_SPW_FIRST_EID;
+
+#define EXP_VERSION 6
+
+static SBN_ProtocolOutlet_t SBN;
+
+/* per-device buffers and counters, too big for the peer's ModulePvt */
+typedef struct
+{
+    uint8 SendBuf[SBN_SPW_MAX_PKT_SZ];
+
+    /** @brief Bytes received, RecvUsed valid, the first Consumed already returned. */
+    uint8  RecvBuf[SBN_SPW_MAX_PKT_SZ];
+    size_t RecvUsed, Consumed;
+
+    uint32 TxPktCnt, RxPktCnt, HdrErrCnt, SkipCnt, LinkDownCnt;
+} SBN_SPW_Dev_t;
+
+static SBN_SPW_Dev_t Devs[SBN_SPW_MAX_DEVICES];
+static uint8         BufCnt       = 0;
+static uint8         LoadedNetCnt = 0;
+
+static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID, SBN_ProtocolOutlet_t *Outlet)
+{
+    SBN_SPW_FIRST_EID = BaseEID;
+
+    if (Version != EXP_VERSION)
+    {
+        OS_printf("SBN_SPW version mismatch: expected %d, got %d\n", EXP_VERSION, Version);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Outlet == NULL)
+    {
+        OS_printf("SBN_SPW outlet is NULL\n");
+        return SBN_ERROR;
+    } /* end if */
+
+    /* copy outlet pointers to a local buffer for later use */
+    memcpy(&SBN, Outlet, sizeof(SBN));
+
+    OS_printf("SBN_SPW Lib Initialized.\n");
+    return SBN_SUCCESS;
+} /* end Init() */
+
+/**
+ * SpaceWire devices are point-to-point, all configuration is in the peer.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS
+ */
+static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
+{
+    return SBN_SUCCESS;
+} /* end InitNet() */
+
+static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
+{
+    /* devices are per peer, the count only tells UnloadNet when the last net goes */
+    LoadedNetCnt++;
+
+    return SBN_SUCCESS;
+} /* end LoadNet() */
+
+/**
+ * Parses the "?key=val&key=val" options following the device path.
+ *
+ * @param PeerData[out] The peer whose options to set.
+ * @param Address[in] The address string from the configuration table.
+ * @return SBN_SUCCESS on success, SBN_ERROR on an unknown key or bad value.
+ */
+static SBN_Status_t ConfOpts(SBN_SPW_Peer_t *PeerData, const char *Address)
+{
+    const char *Opt = strchr(Address, '?');
+
+    memset(PeerData->RxPath, 0, sizeof(PeerData->RxPath));
+    memset(PeerData->Class, 0, sizeof(PeerData->Class));
+
+    while (Opt != NULL)
+    {
+        Opt++; /* skip the '?' or '&' */
+
+        const char *Eq     = strchr(Opt, '=');
+        size_t      ValLen = 0, Len = 0;
+
+        if (!Eq)
+        {
+            EVSSendErr(SBN_SPW_CONFIG_EID, "invalid option (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        Len    = Eq - Opt;
+        ValLen = strcspn(Eq + 1, "&");
+
+        if (SBN_OPT_IS(Opt, Len, "rx") && ValLen > 0 && ValLen < sizeof(PeerData->RxPath))
+        {
+            strncpy(PeerData->RxPath, Eq + 1, ValLen);
+        }
+        else if (SBN_OPT_IS(Opt, Len, "class") && ValLen > 0 && ValLen < sizeof(PeerData->Class))
+        {
+            strncpy(PeerData->Class, Eq + 1, ValLen);
+        }
+        else
+        {
+            EVSSendErr(SBN_SPW_CONFIG_EID, "unknown option or bad value (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        Opt = strchr(Opt, '&');
+    } /* end while */
+
+    return SBN_SUCCESS;
+} /* end ConfOpts() */
+
+static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
+{
+    SBN_SPW_Peer_t *PeerData = (SBN_SPW_Peer_t *)Peer->ModulePvt;
+    size_t          PathLen  = strcspn(Address, "?");
+
+    EVSSendInfo(SBN_SPW_CONFIG_EID, "configuring peer (SC=%d, CPU=%d, Address=%s)", Peer->SpacecraftID,
+                Peer->ProcessorID, Address);
+
+    if (BufCnt >= SBN_SPW_MAX_DEVICES)
+    {
+        EVSSendErr(SBN_SPW_CONFIG_EID, "too many SpaceWire devices (max=%d)", SBN_SPW_MAX_DEVICES);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (PathLen == 0 || PathLen >= sizeof(PeerData->DevPath))
+    {
+        EVSSendErr(SBN_SPW_CONFIG_EID, "invalid device path (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(PeerData->DevPath, 0, sizeof(PeerData->DevPath));
+    strncpy(PeerData->DevPath, Address, PathLen);
+
+    if (ConfOpts(PeerData, Address) != SBN_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    PeerData->BufNum = BufCnt++;
+
+    return SBN_SUCCESS;
+} /* end LoadPeer() */
+
+/**
+ * Initializes a SpaceWire peer, the device is opened when first polled.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS
+ */
+static SBN_Status_t InitPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_SPW_Peer_t *PeerData = (SBN_SPW_Peer_t *)Peer->ModulePvt;
+
+    PeerData->DevOpen = false;
+    PeerData->FD      = -1;
+    PeerData->RxFD    = -1;
+    PeerData->LinkUp  = (PeerData->Class[0] == '\0');
+
+    memset(&PeerData->LastConnTry, 0, sizeof(PeerData->LastConnTry));
+    memset(&PeerData->LastLinkCheck, 0, sizeof(PeerData->LastLinkCheck));
+    memset(&Devs[PeerData->BufNum], 0, sizeof(Devs[PeerData->BufNum]));
+
+    return SBN_SUCCESS;
+} /* end InitPeer() */
+
+/** opens a device for reading and writing, putting pty stand-ins in raw mode */
+static int OpenPath(const char *Path)
+{
+    struct termios tty;
+    int            FD = open(Path, O_RDWR | O_NOCTTY);
+
+    if (FD < 0)
+    {
+        EVSSendErr(SBN_SPW_DEVICE_EID, "unable to open device %s (errno=%d)", Path, errno);
+        return -1;
+    } /* end if */
+
+    if (isatty(FD) && tcgetattr(FD, &tty) == 0)
+    {
+        cfmakeraw(&tty);
+        tcsetattr(FD, TCSANOW, &tty);
+    } /* end if */
+
+    return FD;
+} /* end OpenPath() */
+
+/** returns true on successfully opening the device(s) */
+static bool OpenDev(SBN_PeerInterface_t *Peer)
+{
+    SBN_SPW_Peer_t *PeerData = (SBN_SPW_Peer_t *)Peer->ModulePvt;
+    SBN_SPW_Dev_t * Dev      = &Devs[PeerData->BufNum];
+    OS_time_t       CurrentTime;
+
+    OS_GetLocalTime(&CurrentTime);
+
+    if (OS_TimeGetTotalSeconds(PeerData->LastConnTry) != 0
+        && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, PeerData->LastConnTry)) < SBN_SPW_CONNTRY_TIME)
+    {
+        return false;
+    } /* end if */
+
+    PeerData->LastConnTry = CurrentTime;
+
+    PeerData->FD = OpenPath(PeerData->DevPath);
+    if (PeerData->FD < 0)
+    {
+        return false;
+    } /* end if */
+
+    PeerData->RxFD = PeerData->FD;
+    if (PeerData->RxPath[0] != '\0')
+    {
+        PeerData->RxFD = OpenPath(PeerData->RxPath);
+        if (PeerData->RxFD < 0)
+        {
+            close(PeerData->FD);
+            PeerData->FD = -1;
+            return false;
+        } /* end if */
+    }     /* end if */
+
+    EVSSendInfo(SBN_SPW_DEVICE_EID, "SpaceWire device %s (fd=%d) attached", PeerData->DevPath, PeerData->FD);
+
+    Dev->RecvUsed = 0;
+    Dev->Consumed = 0;
+
+    PeerData->DevOpen = true;
+
+    return true;
+} /* end OpenDev() */
+
+static void CloseDev(SBN_PeerInterface_t *Peer)
+{
+    SBN_SPW_Peer_t *PeerData = (SBN_SPW_Peer_t *)Peer->ModulePvt;
+
+    if (PeerData->DevOpen)
+    {
+        if (PeerData->RxFD != PeerData->FD)
+        {
+            close(PeerData->RxFD);
+        } /* end if */
+
+        close(PeerData->FD);
+
+        PeerData->DevOpen = false;
+        PeerData->FD      = -1;
+        PeerData->RxFD    = -1;
+    } /* end if */
+
+    if (Peer->Connected)
+    {
+        SBN.Disconnected(Peer);
+    } /* end if */
+} /* end CloseDev() */
+
+/**
+ * Reads the link status from sysfs, at most every SBN_SPW_LINK_CHECK_TIME
+ * seconds; the per-message path never touches sysfs.
+ */
+static void CheckLink(SBN_PeerInterface_t *Peer, OS_time_t CurrentTime)
+{
+    SBN_SPW_Peer_t *PeerData = (SBN_SPW_Peer_t *)Peer->ModulePvt;
+    char            Path[sizeof(SBN_SPW_LINK_STATUS_PATH) + SBN_SPW_MAX_CLASS_NAME + SBN_SPW_MAX_CHAR_NAME];
+    char            Status[16];
+    const char *    DevName = strrchr(PeerData->DevPath, '/');
+    bool            LinkUp  = false;
+    ssize_t         Len     = 0;
+    int             FD      = -1;
+
+    if (PeerData->Class[0] == '\0'
+        || OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, PeerData->LastLinkCheck)) < SBN_SPW_LINK_CHECK_TIME)
+    {
+        return;
+    } /* end if */
+
+    PeerData->LastLinkCheck = CurrentTime;
+
+    snprintf(Path, sizeof(Path), SBN_SPW_LINK_STATUS_PATH, PeerData->Class,
+             DevName ? DevName + 1 : PeerData->DevPath);
+
+    FD = open(Path, O_RDONLY);
+    if (FD >= 0)
+    {
+        Len = read(FD, Status, sizeof(Status) - 1);
+        close(FD);
+
+        if (Len > 0)
+        {
+            Status[Len] = '\0';
+            LinkUp      = (strtol(Status, NULL, 0) != 0);
+        } /* end if */
+    }     /* end if */
+
+    if (LinkUp != PeerData->LinkUp)
+    {
+        EVSSendInfo(SBN_SPW_LINK_EID, "link %s on %s", LinkUp ? "up" : "down", PeerData->DevPath);
+
+        if (!LinkUp)
+        {
+            Devs[PeerData->BufNum].LinkDownCnt++;
+
+            if (Peer->Connected)
+            {
+                SBN.Disconnected(Peer);
+            } /* end if */
+        }     /* end if */
+
+        PeerData->LinkUp = LinkUp;
+    } /* end if */
+} /* end CheckLink() */
+
+static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_SPW_Peer_t *PeerData = (SBN_SPW_Peer_t *)Peer->ModulePvt;
+    OS_time_t       CurrentTime;
+
+    if (!PeerData->DevOpen && !OpenDev(Peer))
+    {
+        return SBN_SUCCESS; /* try again later */
+    } /* end if */
+
+    OS_GetLocalTime(&CurrentTime);
+
+    CheckLink(Peer, CurrentTime);
+
+    if (!PeerData->LinkUp)
+    {
+        return SBN_SUCCESS;
+    } /* end if */
+
+    if (Peer->Connected && SBN_SPW_PEER_TIMEOUT > 0
+        && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastRecv)) > SBN_SPW_PEER_TIMEOUT)
+    {
+        EVSSendInfo(SBN_SPW_DEBUG_EID, "disconnected peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+
+        /* the device stays open, the peer reconnects on its next packet */
+        SBN.Disconnected(Peer);
+        return SBN_SUCCESS;
+    } /* end if */
+
+    /* heartbeats also announce me to a peer that is not yet connected */
+    if (SBN_SPW_PEER_HEARTBEAT > 0
+        && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_SPW_PEER_HEARTBEAT)
+    {
+        OS_GetLocalTime(&Peer->LastSend);
+        EVSSendDbg(SBN_SPW_DEBUG_EID, "sending heartbeat to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+        return SBN.SendNetMsg(SBN_SPW_HEARTBEAT_MSG, 0, NULL, Peer);
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end PollPeer() */
+
+static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_SPW_Peer_t *PeerData = (SBN_SPW_Peer_t *)Peer->ModulePvt;
+    SBN_SPW_Dev_t * Dev      = &Devs[PeerData->BufNum];
+    uint8 *         Buf      = Dev->SendBuf;
+    size_t          DataSz = MsgSz + SBN_PACKED_HDR_SZ, PktSz = DataSz + SBN_SPW_PKT_HDR_SZ, SentSz = 0;
+
+    if (!PeerData->DevOpen || !PeerData->LinkUp)
+    {
+        /* fail silently as the device is not open (yet) */
+        return SBN_SUCCESS;
+    } /* end if */
+
+    Buf[0] = SBN_SPW_SYNC0;
+    Buf[1] = SBN_SPW_SYNC1;
+    Buf[2] = (DataSz >> 8) & 0xFF;
+    Buf[3] = DataSz & 0xFF;
+    Buf[4] = ~Buf[2];
+    Buf[5] = ~Buf[3];
+
+    SBN.PackMsg(Buf + SBN_SPW_PKT_HDR_SZ, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(),
+                Payload);
+
+    /* one write per packet, the driver sends it with a single EOP */
+    while (SentSz < PktSz)
+    {
+        ssize_t Written = write(PeerData->FD, Buf + SentSz, PktSz - SentSz);
+
+        if (Written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            } /* end if */
+
+            EVSSendErr(SBN_SPW_DEVICE_EID, "write error on %s (errno=%d), closing", PeerData->DevPath, errno);
+            CloseDev(Peer);
+            return SBN_ERROR;
+        } /* end if */
+
+        SentSz += Written;
+    } /* end while */
+
+    Dev->TxPktCnt++;
+
+    return SBN_SUCCESS;
+} /* end Send() */
+
+/**
+ * Finds the next complete packet in the bytes received so far.
+ *
+ * @return SBN_SUCCESS if a packet was found, SBN_IF_EMPTY if more bytes are needed.
+ */
+static SBN_Status_t NextPkt(SBN_SPW_Dev_t *Dev, uint8 **DataPtr, size_t *DataSzPtr)
+{
+    uint8 *Buf  = Dev->RecvBuf;
+    size_t Skip = 0, Len = 0;
+
+    if (Dev->Consumed)
+    {
+        memmove(Buf, Buf + Dev->Consumed, Dev->RecvUsed - Dev->Consumed);
+        Dev->RecvUsed -= Dev->Consumed;
+        Dev->Consumed = 0;
+    } /* end if */
+
+    while (1)
+    {
+        /* hunt for the sync marker, keeping a trailing SYNC0 that may be the start of one */
+        for (Skip = 0; Skip < Dev->RecvUsed; Skip++)
+        {
+            if (Buf[Skip] == SBN_SPW_SYNC0 && (Skip + 1 == Dev->RecvUsed || Buf[Skip + 1] == SBN_SPW_SYNC1))
+            {
+                break;
+            } /* end if */
+        }     /* end for */
+
+        if (Skip)
+        {
+            Dev->SkipCnt += Skip;
+            memmove(Buf, Buf + Skip, Dev->RecvUsed - Skip);
+            Dev->RecvUsed -= Skip;
+        } /* end if */
+
+        if (Dev->RecvUsed < SBN_SPW_PKT_HDR_SZ)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        Len = (Buf[2] << 8) | Buf[3];
+
+        if ((Buf[2] ^ Buf[4]) != 0xFF || (Buf[3] ^ Buf[5]) != 0xFF || Len > SBN_MAX_PACKED_MSG_SZ)
+        {
+            /* resync past this marker */
+            Dev->HdrErrCnt++;
+            memmove(Buf, Buf + 1, Dev->RecvUsed - 1);
+            Dev->RecvUsed--;
+            continue;
+        } /* end if */
+
+        if (Dev->RecvUsed < SBN_SPW_PKT_HDR_SZ + Len)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        Dev->Consumed = SBN_SPW_PKT_HDR_SZ + Len;
+
+        *DataPtr   = Buf + SBN_SPW_PKT_HDR_SZ;
+        *DataSzPtr = Len;
+
+        return SBN_SUCCESS;
+    } /* end while */
+} /* end NextPkt() */
+
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_PeerInterface_t *Peer, SBN_MsgType_t *MsgTypePtr,
+                         SBN_MsgSz_t *MsgSzPtr, CFE_ProcessorID_t *ProcessorIDPtr,
+                         CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_SPW_Peer_t *PeerData = (SBN_SPW_Peer_t *)Peer->ModulePvt;
+    SBN_SPW_Dev_t * Dev      = &Devs[PeerData->BufNum];
+    uint8 *         Data     = NULL;
+    size_t          DataSz   = 0;
+
+    if (!PeerData->DevOpen && !OpenDev(Peer))
+    {
+        if (Peer->TaskFlags & SBN_TASK_RECV)
+        {
+            OS_TaskDelay(1000); /* don't spin the recv task while the device is away */
+        } /* end if */
+
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    while (1)
+    {
+        if (NextPkt(Dev, &Data, &DataSz) == SBN_SUCCESS)
+        {
+            if (DataSz < SBN_PACKED_HDR_SZ
+                || !SBN.UnpackMsg(Data, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload)
+                || *MsgSzPtr + SBN_PACKED_HDR_SZ != DataSz)
+            {
+                EVSSendDbg(SBN_SPW_DEBUG_EID, "unable to unpack packet from %s", PeerData->DevPath);
+                continue;
+            } /* end if */
+
+            if (*ProcessorIDPtr != Peer->ProcessorID || *SpacecraftIDPtr != Peer->SpacecraftID)
+            {
+                EVSSendErr(SBN_SPW_DEBUG_EID, "unexpected peer %d:%d on %s", *SpacecraftIDPtr, *ProcessorIDPtr,
+                           PeerData->DevPath);
+                continue;
+            } /* end if */
+
+            Dev->RxPktCnt++;
+
+            if (!Peer->Connected)
+            {
+                EVSSendInfo(SBN_SPW_DEBUG_EID, "connecting to peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+                SBN.Connected(Peer);
+            } /* end if */
+
+            return SBN_SUCCESS;
+        } /* end if */
+
+        /* need more bytes, polling uses select, otherwise block on read for task */
+        if (!(Peer->TaskFlags & SBN_TASK_RECV))
+        {
+            fd_set         ReadFDs;
+            struct timeval Timeout;
+
+            FD_ZERO(&ReadFDs);
+            FD_SET(PeerData->RxFD, &ReadFDs);
+            memset(&Timeout, 0, sizeof(Timeout));
+
+            if (select(PeerData->RxFD + 1, &ReadFDs, NULL, NULL, &Timeout) <= 0)
+            {
+                return SBN_IF_EMPTY;
+            } /* end if */
+        }     /* end if */
+
+        ssize_t Received = read(PeerData->RxFD, Dev->RecvBuf + Dev->RecvUsed, sizeof(Dev->RecvBuf) - Dev->RecvUsed);
+
+        if (Received <= 0)
+        {
+            if (Received < 0 && errno == EINTR)
+            {
+                continue;
+            } /* end if */
+
+            EVSSendErr(SBN_SPW_DEVICE_EID, "read error on %s (errno=%d), closing", PeerData->DevPath, errno);
+            CloseDev(Peer);
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        Dev->RecvUsed += Received;
+    } /* end while */
+} /* end Recv() */
+
+static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
+{
+    CloseDev(Peer);
+
+    return SBN_SUCCESS;
+} /* end UnloadPeer() */
+
+static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
+{
+    SBN_PeerIdx_t PeerIdx = 0;
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        UnloadPeer(&Net->Peers[PeerIdx]);
+    } /* end for */
+
+    /* devices of other nets may still be open in the later slots, so they are only reused once all are unloaded */
+    if (LoadedNetCnt && --LoadedNetCnt == 0)
+    {
+        BufCnt = 0;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end UnloadNet() */
+
+/**
+ * Reports, big-endian: uint8 Flags (1=open, 2=link up), uint32 TxPktCnt,
+ * RxPktCnt, RxHdrErrCnt, RxSkipCnt, LinkDownCnt.
+ */
+static SBN_Status_t ReportModuleStatus(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz)
+{
+    SBN_SPW_Peer_t *PeerData = (SBN_SPW_Peer_t *)Peer->ModulePvt;
+    SBN_SPW_Dev_t * Dev      = &Devs[PeerData->BufNum];
+    uint8 *         Ptr      = StatusBuf;
+
+    if (StatusBufSz < 1 + 5 * 4)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    *Ptr++ = (PeerData->DevOpen ? 1 : 0) | (PeerData->LinkUp ? 2 : 0);
+    Ptr    = SBN_PutUInt32(Ptr, Dev->TxPktCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Dev->RxPktCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Dev->HdrErrCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Dev->SkipCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Dev->LinkDownCnt);
+
+    return SBN_SUCCESS;
+} /* end ReportModuleStatus() */
+
+SBN_IfOps_t SBN_SPW_Ops = {Init, InitNet,   InitPeer,   LoadNet,           LoadPeer, PollPeer,
+                           Send, Recv,      NULL,       UnloadNet,         UnloadPeer, ReportModuleStatus};
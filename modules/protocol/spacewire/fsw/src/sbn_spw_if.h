@@ -0,0 +1,77 @@
+#ifndef _sbn_spw_if_h_
+#define _sbn_spw_if_h_
+
+#include "sbn_spw_events.h"
+#include "sbn_spw_platform_cfg.h"
+#include "sbn_platform_cfg.h"
+#include <string.h>
+#include <errno.h>
+
+#include "sbn_interfaces.h"
+#include "cfe.h"
+
+/**
+ * SpaceWire-specific message types.
+ */
+#define SBN_SPW_HEARTBEAT_MSG 0xA0
+
+/**
+ * If unable to open the device, try again in SBN_SPW_CONNTRY_TIME seconds.
+ */
+#define SBN_SPW_CONNTRY_TIME 10
+
+/**
+ * SpaceWire character devices do not reliably preserve packet boundaries
+ * across reads (and the pty/FIFO stand-ins used for testing are plain byte
+ * streams), so each packed SBN message is sent as a packet:
+ *
+ * ```
+ * +------+------+--------+---------+-------------------+
+ * | 0x5B | 0xA4 | Len:16 | ~Len:16 | Len bytes of data |
+ * +------+------+--------+---------+-------------------+
+ * ```
+ *
+ * The link itself detects errors, so there is no checksum; the inverted
+ * length lets the receiver resynchronize should it ever start mid-packet.
+ */
+#define SBN_SPW_SYNC0 0x5B
+#define SBN_SPW_SYNC1 0xA4
+
+#define SBN_SPW_PKT_HDR_SZ 6
+
+#define SBN_SPW_MAX_PKT_SZ (SBN_SPW_PKT_HDR_SZ + SBN_MAX_PACKED_MSG_SZ)
+
+/** @brief sprintf format for the sysfs link status of a device, from the class and device name. */
+#define SBN_SPW_LINK_STATUS_PATH "/sys/class/%s/%s/device/link_status"
+
+typedef struct
+{
+    /** @brief The device path, e.g. "/dev/spw0", written to (and read from, unless RxPath is set.) */
+    char DevPath[SBN_SPW_MAX_CHAR_NAME];
+
+    /**
+     * @brief A separate device to read from, from the "rx" address option. Lets
+     * a pair of FIFOs stand in for a device.
+     */
+    char RxPath[SBN_SPW_MAX_CHAR_NAME];
+
+    /** @brief The sysfs device class for link status, from the "class" address option. */
+    char Class[SBN_SPW_MAX_CLASS_NAME];
+
+    /** @brief The open devices, only valid if DevOpen (the same unless RxPath is set.) */
+    int FD, RxFD;
+
+    /** @brief Is the device open? */
+    bool DevOpen;
+
+    /** @brief Link status as of the last check, always true without a "class" option. */
+    bool LinkUp;
+
+    /** @brief Index into the module's send/receive buffers. */
+    uint8 BufNum;
+
+    /** @brief See SBN_SPW_CONNTRY_TIME and SBN_SPW_LINK_CHECK_TIME. */
+    OS_time_t LastConnTry, LastLinkCheck;
+} SBN_SPW_Peer_t;
+
+#endif /* _sbn_spw_if_h_ */
@@ -0,0 +1,398 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_spw_if.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN SpaceWire protocol module
+**
+** Notes:
+** SpaceWire hardware is not available to the unit tests, so a pair of FIFOs
+** (each peer writing to one and reading the other) and a pty stand in for
+** the character device.
+*/
+
+#define _GNU_SOURCE /* posix_openpt() and friends */
+
+#include "sbn_spw_coveragetest_common.h"
+#include "sbn_spw_if.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SBN_PROTOCOL_VERSION 6
+
+#define FIFO_A "/tmp/sbn_spw_ut_a"
+#define FIFO_B "/tmp/sbn_spw_ut_b"
+
+extern SBN_IfOps_t SBN_SPW_Ops;
+
+static SBN_NetInterface_t   Net;
+static SBN_PeerInterface_t *PeerA = &Net.Peers[0], *PeerB = &Net.Peers[1];
+
+static int ConnectedCnt = 0, DisconnectedCnt = 0;
+
+/* a test-local outlet packing the same header layout as SBN */
+static void PackMsg(void *SBNBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_ProcessorID_t ProcessorID,
+                    CFE_SpacecraftID_t SpacecraftID, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    memset(Buf, 0, SBN_PACKED_HDR_SZ);
+    Buf[0] = MsgSz >> 8;
+    Buf[1] = MsgSz & 0xFF;
+    Buf[2] = MsgType;
+    Buf[3] = (ProcessorID >> 24) & 0xFF;
+    Buf[4] = (ProcessorID >> 16) & 0xFF;
+    Buf[5] = (ProcessorID >> 8) & 0xFF;
+    Buf[6] = ProcessorID & 0xFF;
+    Buf[7] = (SpacecraftID >> 24) & 0xFF;
+    Buf[8] = (SpacecraftID >> 16) & 0xFF;
+    Buf[9] = (SpacecraftID >> 8) & 0xFF;
+    Buf[10] = SpacecraftID & 0xFF;
+
+    if (MsgSz)
+    {
+        memcpy(Buf + SBN_PACKED_HDR_SZ, Msg, MsgSz);
+    } /* end if */
+} /* end PackMsg() */
+
+static bool UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePtr,
+                      CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    *MsgSzPtr        = (Buf[0] << 8) | Buf[1];
+    *MsgTypePtr      = Buf[2];
+    *ProcessorIDPtr  = ((uint32)Buf[3] << 24) | (Buf[4] << 16) | (Buf[5] << 8) | Buf[6];
+    *SpacecraftIDPtr = ((uint32)Buf[7] << 24) | (Buf[8] << 16) | (Buf[9] << 8) | Buf[10];
+
+    if (*MsgSzPtr > CFE_MISSION_SB_MAX_SB_MSG_SIZE)
+    {
+        return false;
+    } /* end if */
+
+    memcpy(Msg, Buf + SBN_PACKED_HDR_SZ, *MsgSzPtr);
+
+    return true;
+} /* end UnpackMsg() */
+
+static SBN_Status_t Connected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = true;
+    ConnectedCnt++;
+    return SBN_SUCCESS;
+} /* end Connected() */
+
+static SBN_Status_t Disconnected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = false;
+    DisconnectedCnt++;
+    return SBN_SUCCESS;
+} /* end Disconnected() */
+
+static SBN_Status_t SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+{
+    return SBN_SPW_Ops.Send(Peer, MsgType, MsgSz, Msg);
+} /* end SendNetMsg() */
+
+static SBN_ProtocolOutlet_t Outlet = {PackMsg, UnpackMsg, Connected, Disconnected, SendNetMsg, NULL};
+
+static uint8  Payload[CFE_MISSION_SB_MAX_SB_MSG_SIZE], RecvPayload[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+static uint8  Pkt[SBN_SPW_MAX_PKT_SZ];
+static uint32 Status[5];
+
+/* frames a packed message as the module does, returning the packet size */
+static size_t MakePkt(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz)
+{
+    size_t DataSz = MsgSz + SBN_PACKED_HDR_SZ;
+
+    Pkt[0] = SBN_SPW_SYNC0;
+    Pkt[1] = SBN_SPW_SYNC1;
+    Pkt[2] = DataSz >> 8;
+    Pkt[3] = DataSz & 0xFF;
+    Pkt[4] = ~Pkt[2];
+    Pkt[5] = ~Pkt[3];
+
+    PackMsg(Pkt + SBN_SPW_PKT_HDR_SZ, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Payload);
+
+    return SBN_SPW_PKT_HDR_SZ + DataSz;
+} /* end MakePkt() */
+
+/* reads the module status of a peer, returning the flags */
+static uint8 GetStatus(SBN_PeerInterface_t *Peer)
+{
+    uint8 Buf[64], *Ptr = Buf + 1;
+    int   i             = 0;
+
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.ReportModuleStatus(Peer, Buf, sizeof(Buf)), SBN_SUCCESS);
+
+    for (i = 0; i < 5; i++, Ptr += 4)
+    {
+        Status[i] = ((uint32)Ptr[0] << 24) | (Ptr[1] << 16) | (Ptr[2] << 8) | Ptr[3];
+    } /* end for */
+
+    return Buf[0];
+} /* end GetStatus() */
+
+static SBN_Status_t RecvB(SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr)
+{
+    CFE_ProcessorID_t  ProcessorID  = 0;
+    CFE_SpacecraftID_t SpacecraftID = 0;
+
+    return SBN_SPW_Ops.RecvFromPeer(&Net, PeerB, MsgTypePtr, MsgSzPtr, &ProcessorID, &SpacecraftID, RecvPayload);
+} /* end RecvB() */
+
+/* loads two peers, each writing the FIFO the other reads */
+static void START(const char *AddrA, const char *AddrB)
+{
+    size_t i = 0;
+
+    UT_ResetState(0);
+
+    memset(&Net, 0, sizeof(Net));
+    ConnectedCnt    = 0;
+    DisconnectedCnt = 0;
+
+    for (i = 0; i < sizeof(Payload); i++)
+    {
+        Payload[i] = i & 0xFF;
+    } /* end for */
+
+    unlink(FIFO_A);
+    unlink(FIFO_B);
+    mkfifo(FIFO_A, 0600);
+    mkfifo(FIFO_B, 0600);
+
+    Net.PeerCnt = 2;
+    Net.IfOps   = &SBN_SPW_Ops;
+
+    /* both ends are this processor */
+    PeerA->Net = PeerB->Net = &Net;
+    PeerA->ProcessorID = PeerB->ProcessorID = CFE_PSP_GetProcessorId();
+    PeerA->SpacecraftID = PeerB->SpacecraftID = CFE_PSP_GetSpacecraftId();
+
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.LoadPeer(PeerA, AddrA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.LoadPeer(PeerB, AddrB), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.InitPeer(PeerA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.InitPeer(PeerB), SBN_SUCCESS);
+} /* end START() */
+
+static void STOP(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.UnloadNet(&Net), SBN_SUCCESS);
+
+    unlink(FIFO_A);
+    unlink(FIFO_B);
+} /* end STOP() */
+
+void Test_SBN_SPW_Init(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.InitModule(-1, 0, &Outlet), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, NULL), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.InitNet(&Net), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.LoadNet(&Net, ""), SBN_SUCCESS);
+} /* end Test_SBN_SPW_Init() */
+
+void Test_SBN_SPW_LoadPeer(void)
+{
+    memset(&Net, 0, sizeof(Net));
+
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.LoadPeer(PeerA, ""), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.LoadPeer(PeerA, "/dev/a/path/that/is/much/too/long/for/a/peer"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.LoadPeer(PeerA, "/dev/spw0?rx"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.LoadPeer(PeerA, "/dev/spw0?rx="), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.LoadPeer(PeerA, "/dev/spw0?foo=bar"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.LoadPeer(PeerA, "/dev/spw0?rx=/dev/spw1&class=spw"), SBN_SUCCESS);
+
+    UtAssert_True(strcmp(((SBN_SPW_Peer_t *)PeerA->ModulePvt)->DevPath, "/dev/spw0") == 0, "device path");
+    UtAssert_True(strcmp(((SBN_SPW_Peer_t *)PeerA->ModulePvt)->RxPath, "/dev/spw1") == 0, "rx path");
+    UtAssert_True(strcmp(((SBN_SPW_Peer_t *)PeerA->ModulePvt)->Class, "spw") == 0, "class");
+
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.UnloadNet(&Net), SBN_SUCCESS);
+} /* end Test_SBN_SPW_LoadPeer() */
+
+void Test_SBN_SPW_Fifo(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+
+    START(FIFO_A "?rx=" FIFO_B, FIFO_B "?rx=" FIFO_A);
+
+    /* not open until polled, sends are dropped */
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.Send(PeerA, SBN_APP_MSG, 100, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.PollPeer(PeerA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.PollPeer(PeerB), SBN_SUCCESS);
+    UtAssert_True(GetStatus(PeerA) == 3, "A open, link up");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.Send(PeerA, SBN_APP_MSG, 100, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.Send(PeerA, SBN_APP_MSG, 4000, Payload), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_APP_MSG && MsgSz == 100, "MsgType=%d MsgSz=%d", MsgType, MsgSz);
+    UtAssert_True(memcmp(RecvPayload, Payload, 100) == 0, "payload intact");
+    UtAssert_True(ConnectedCnt == 1 && PeerB->Connected, "connected on first packet");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 4000, "MsgSz=%d", MsgSz);
+    UtAssert_True(memcmp(RecvPayload, Payload, 4000) == 0, "larger payload intact");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+
+    GetStatus(PeerA);
+    UtAssert_True(Status[0] == 2, "A TxPktCnt=%d", (int)Status[0]);
+    GetStatus(PeerB);
+    UtAssert_True(Status[1] == 2 && Status[2] == 0 && Status[3] == 0, "B RxPktCnt=%d", (int)Status[1]);
+
+    STOP();
+    UtAssert_True(DisconnectedCnt == 1, "disconnected on unload");
+} /* end Test_SBN_SPW_Fifo() */
+
+void Test_SBN_SPW_Resync(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+    uint8         Junk[]  = {0x00, SBN_SPW_SYNC0, 0x11, SBN_SPW_SYNC1};
+    size_t        PktSz   = 0;
+    int           FD      = -1;
+
+    START(FIFO_A "?rx=" FIFO_B, FIFO_B "?rx=" FIFO_A);
+
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.PollPeer(PeerB), SBN_SUCCESS);
+
+    FD = open(FIFO_A, O_WRONLY | O_NONBLOCK);
+    UtAssert_True(FD >= 0, "test writer open");
+
+    /* noise, then a header whose length check fails */
+    write(FD, Junk, sizeof(Junk));
+    PktSz = MakePkt(SBN_APP_MSG, 10);
+    Pkt[5] ^= 0xFF;
+    write(FD, Pkt, SBN_SPW_PKT_HDR_SZ);
+
+    /* then a good packet, split across reads */
+    PktSz = MakePkt(SBN_APP_MSG, 50);
+    write(FD, Pkt, 20);
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+
+    write(FD, Pkt + 20, PktSz - 20);
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 50 && memcmp(RecvPayload, Payload, 50) == 0, "payload intact after resync");
+
+    /* a packet from an unexpected peer is dropped */
+    PeerB->ProcessorID++;
+    PktSz = MakePkt(SBN_APP_MSG, 5);
+    write(FD, Pkt, PktSz);
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+    PeerB->ProcessorID--;
+
+    close(FD);
+
+    GetStatus(PeerB);
+    UtAssert_True(Status[1] == 1, "RxPktCnt=%d", (int)Status[1]);
+    UtAssert_True(Status[2] == 1, "HdrErrCnt=%d", (int)Status[2]);
+    UtAssert_True(Status[3] > 0, "SkipCnt=%d", (int)Status[3]);
+
+    STOP();
+} /* end Test_SBN_SPW_Resync() */
+
+void Test_SBN_SPW_LinkDown(void)
+{
+    START(FIFO_A "?rx=" FIFO_B "&class=sbn_spw_ut", FIFO_B "?rx=" FIFO_A);
+
+    /* no such sysfs class, the link reads as down and nothing is sent */
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.PollPeer(PeerA), SBN_SUCCESS);
+    UtAssert_True(GetStatus(PeerA) == 1, "A open, link down");
+
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.Send(PeerA, SBN_APP_MSG, 10, Payload), SBN_SUCCESS);
+    GetStatus(PeerA);
+    UtAssert_True(Status[0] == 0, "TxPktCnt=%d", (int)Status[0]);
+
+    STOP();
+} /* end Test_SBN_SPW_LinkDown() */
+
+void Test_SBN_SPW_Pty(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+    CFE_ProcessorID_t  ProcessorID  = 0;
+    CFE_SpacecraftID_t SpacecraftID = 0;
+    uint8         Buf[SBN_SPW_MAX_PKT_SZ];
+    size_t        PktSz = 0, Got = 0;
+    ssize_t       Len   = 0;
+    int           Master = posix_openpt(O_RDWR | O_NOCTTY);
+
+    UtAssert_True(Master >= 0 && grantpt(Master) == 0 && unlockpt(Master) == 0, "pty open");
+
+    START(ptsname(Master), FIFO_B);
+
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.PollPeer(PeerA), SBN_SUCCESS);
+
+    /* all byte values pass through the pty unchanged (raw mode) */
+    UT_TEST_FUNCTION_RC(SBN_SPW_Ops.Send(PeerA, SBN_APP_MSG, 256, Payload), SBN_SUCCESS);
+    PktSz = MakePkt(SBN_APP_MSG, 256);
+
+    while (Got < PktSz && (Len = read(Master, Buf + Got, sizeof(Buf) - Got)) > 0)
+    {
+        Got += Len;
+    } /* end while */
+
+    UtAssert_True(Got == PktSz && memcmp(Buf, Pkt, PktSz) == 0, "packet on the wire (%d bytes)", (int)Got);
+
+    /* and back */
+    write(Master, Pkt, PktSz);
+    UT_TEST_FUNCTION_RC(
+        SBN_SPW_Ops.RecvFromPeer(&Net, PeerA, &MsgType, &MsgSz, &ProcessorID, &SpacecraftID, RecvPayload),
+        SBN_SUCCESS);
+    UtAssert_True(MsgSz == 256 && memcmp(RecvPayload, Payload, 256) == 0, "payload intact");
+
+    STOP();
+
+    close(Master);
+} /* end Test_SBN_SPW_Pty() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_SPW_Init);
+    ADD_TEST(SBN_SPW_LoadPeer);
+    ADD_TEST(SBN_SPW_Fifo);
+    ADD_TEST(SBN_SPW_Resync);
+    ADD_TEST(SBN_SPW_LinkDown);
+    ADD_TEST(SBN_SPW_Pty);
+}
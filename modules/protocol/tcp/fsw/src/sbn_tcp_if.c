@@ -6,13 +6,25 @@
 
 #include <string.h>
 #include <errno.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/sock_diag.h>
+
+/* workaround until OSAL exposes socket options */
+#include "os-impl-io.h"
+
+#define SBN_MODULE_NATIVE_FD
+#include "sbn_module_util.h"
 
 #define SBN_TCP_HEARTBEAT_MSG 0xA0
 
 /**
  * If I haven't sent a message in SBN_TCP_PEER_HEARTBEAT seconds, send an empty
  * one just to maintain the connection. If this is set to 0, no heartbeat
- * messages will be generated.
+ * messages will be generated. This is the default for nets that do not
+ * specify the "heartbeat" option.
  */
 #define SBN_TCP_PEER_HEARTBEAT 5
 /* #define SBN_TCP_PEER_HEARTBEAT 0 */
@@ -20,11 +32,18 @@
 /**
  * If I haven't received a message from a peer in SBN_TCP_PEER_TIMEOUT seconds,
  * consider the peer lost and disconnect. If this is set to 0, no timeout is
- * checked.
+ * checked. This is the default for nets that do not specify the "timeout"
+ * option.
  */
 /* #define SBN_TCP_PEER_TIMEOUT 10 */
 #define SBN_TCP_PEER_TIMEOUT 0
 
+/** @brief The kernel's limits (MAX_TCP_KEEPIDLE, MAX_TCP_KEEPINTVL) on keepidle and keepintvl, in seconds. */
+#define SBN_TCP_MAX_KEEPIDLE 32767
+
+/** @brief The kernel's limit (MAX_TCP_KEEPCNT) on keepcnt. */
+#define SBN_TCP_MAX_KEEPCNT 127
+
 typedef struct
 {
     bool                 InUse, ReceivingBody;
@@ -34,6 +53,22 @@ typedef struct
     SBN_PeerInterface_t *PeerInterface; /* affiliated peer, if known */
 } SBN_TCP_Conn_t;
 
+/**
+ * Socket tuning from the "?key=val&key=val" options of a net or peer address,
+ * e.g. "127.0.0.1:2234?rcvbuf=8M&sndbuf=4M&busy_poll=50&tos=0xb8&prio=6".
+ * Sizes (rcvbuf and sndbuf) take a K, M or G suffix. The net's apply to its listening socket, and
+ * so to the connections accepted on it, and to those it makes; a peer's then
+ * apply over them to that peer's connection. Options left at 0 keep the
+ * kernel's defaults (0 for tos and prio.)
+ */
+typedef struct
+{
+    uint32 RcvBuf, SndBuf; /* SO_RCVBUF/SO_SNDBUF in bytes, the FORCE variants if permitted */
+    uint16 BusyPoll;       /* SO_BUSY_POLL in microseconds */
+    uint8  TOS;            /* IP_TOS */
+    uint8  Prio;           /* SO_PRIORITY */
+} SBN_TCP_SockOpts_t;
+
 typedef struct
 {
     OS_SockAddr_t   Addr;
@@ -41,14 +76,39 @@ typedef struct
     uint8           BufNum; /* incoming buffer */
     OS_time_t       LastConnectTry;
     SBN_TCP_Conn_t *Conn; /* when connected and affiliated */
+    SBN_TCP_SockOpts_t Sock; /* from the peer address, over the net's */
 } SBN_TCP_Peer_t;
 
+/**
+ * Per-net connection options, set from the net address string, e.g.:
+ * "127.0.0.1:2234?utimeout=500&keepidle=1&keepintvl=1&keepcnt=2&heartbeat=0"
+ *
+ * With "heartbeat=0", no SBN_TCP_HEARTBEAT_MSG frames are sent and the
+ * kernel (TCP_USER_TIMEOUT/SO_KEEPALIVE) is relied upon to detect dead
+ * connections, which then fail in Recv/Send and are disconnected.
+ *
+ * These are plain numbers, without the size suffixes of the socket options,
+ * and a value out of range (see SBN_TCP_MAX_KEEPIDLE) fails the net's load.
+ */
+typedef struct
+{
+    uint32 UserTimeout; /* TCP_USER_TIMEOUT in ms, 0 for the kernel default */
+    uint16 KeepIdle;    /* TCP_KEEPIDLE in seconds, 0 disables SO_KEEPALIVE */
+    uint16 KeepIntvl;   /* TCP_KEEPINTVL in seconds, 0 for the kernel default */
+    uint16 KeepCnt;     /* TCP_KEEPCNT, 0 for the kernel default */
+    uint16 Heartbeat;   /* seconds of send idle before a heartbeat, 0 for none */
+    uint16 Timeout;     /* seconds of recv idle before disconnecting, 0 for none */
+
+    SBN_TCP_SockOpts_t Sock;
+} SBN_TCP_Opts_t;
+
 typedef struct
 {
-    OS_SockAddr_t  Addr;
-    uint8          BufNum; /* outgoing buffer */
-    int            Socket; /* server socket */
-    SBN_TCP_Conn_t Conns[SBN_MAX_PEER_CNT];
+    OS_SockAddr_t   Addr;
+    uint8           BufNum; /* outgoing buffer, also indexes the connection table */
+    int             Socket; /* server socket */
+    SBN_TCP_Opts_t  Opts;
+    SBN_TCP_Conn_t *Conns; /* SBN_MAX_PEER_CNT entries, kept out of ModulePvt */
 } SBN_TCP_Net_t;
 
 CFE_EVS_EventID_t SBN_TCP_FIRST_EID = 0;
@@ -123,8 +183,227 @@ static SBN_Status_t ConfAddr(OS_SockAddr_t *Addr, const char *Address)
     return SBN_SUCCESS;
 } /* end ConfAddr() */
 
-static uint8 SendBufs[SBN_MAX_NETS][SBN_MAX_PACKED_MSG_SZ];
-static int   SendBufCnt = 0;
+/**
+ * Parses the "?key=val&key=val" options following the net or peer address.
+ * Unset options keep their defaults.
+ *
+ * @param Opts[out] The net options to set, NULL for a peer, which only takes
+ *                  socket options.
+ * @param Sock[out] The socket options to set.
+ * @param Address[in] The address string from the configuration table.
+ * @return SBN_SUCCESS on success, SBN_ERROR on an unknown key or bad value.
+ */
+static SBN_Status_t ConfOpts(SBN_TCP_Opts_t *Opts, SBN_TCP_SockOpts_t *Sock, const char *Address)
+{
+    const char *Opt = strchr(Address, '?');
+
+    if (Opts != NULL)
+    {
+        memset(Opts, 0, sizeof(*Opts));
+        Opts->Heartbeat = SBN_TCP_PEER_HEARTBEAT;
+        Opts->Timeout   = SBN_TCP_PEER_TIMEOUT;
+    } /* end if */
+
+    memset(Sock, 0, sizeof(*Sock));
+
+    while (Opt != NULL)
+    {
+        Opt++; /* skip the '?' or '&' */
+
+        const char *Eq          = strchr(Opt, '=');
+        char *      ValidatePtr = NULL;
+
+        if (!Eq)
+        {
+            EVSSendErr(SBN_TCP_CONFIG_EID, "invalid option (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        size_t        Len = Eq - Opt;
+        bool          Sz  = SBN_OPT_IS(Opt, Len, "rcvbuf") || SBN_OPT_IS(Opt, Len, "sndbuf");
+        unsigned long Val = Sz ? SBN_StrToSz(Eq + 1, &ValidatePtr) : strtoul(Eq + 1, &ValidatePtr, 0);
+
+        if (ValidatePtr == Eq + 1 || (*ValidatePtr != '\0' && *ValidatePtr != '&'))
+        {
+            EVSSendErr(SBN_TCP_CONFIG_EID, "invalid option value (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        if (Opts && SBN_OPT_IS(Opt, Len, "utimeout") && Val <= INT_MAX)
+        {
+            Opts->UserTimeout = Val;
+        }
+        else if (Opts && SBN_OPT_IS(Opt, Len, "keepidle") && Val <= SBN_TCP_MAX_KEEPIDLE)
+        {
+            Opts->KeepIdle = Val;
+        }
+        else if (Opts && SBN_OPT_IS(Opt, Len, "keepintvl") && Val <= SBN_TCP_MAX_KEEPIDLE)
+        {
+            Opts->KeepIntvl = Val;
+        }
+        else if (Opts && SBN_OPT_IS(Opt, Len, "keepcnt") && Val <= SBN_TCP_MAX_KEEPCNT)
+        {
+            Opts->KeepCnt = Val;
+        }
+        else if (Opts && SBN_OPT_IS(Opt, Len, "heartbeat") && Val <= 0xFFFF)
+        {
+            Opts->Heartbeat = Val;
+        }
+        else if (Opts && SBN_OPT_IS(Opt, Len, "timeout") && Val <= 0xFFFF)
+        {
+            Opts->Timeout = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "rcvbuf") && Val <= INT_MAX / 2)
+        {
+            Sock->RcvBuf = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "sndbuf") && Val <= INT_MAX / 2)
+        {
+            Sock->SndBuf = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "busy_poll") && Val <= 0xFFFF)
+        {
+            Sock->BusyPoll = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "tos") && Val <= 0xFF)
+        {
+            Sock->TOS = Val;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "prio") && Val <= 0xFF)
+        {
+            Sock->Prio = Val;
+        }
+        else
+        {
+            EVSSendErr(SBN_TCP_CONFIG_EID, "unknown option or value out of range (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        Opt = strchr(Opt, '&');
+    } /* end while */
+
+    return SBN_SUCCESS;
+} /* end ConfOpts() */
+
+/**
+ * Sets a socket buffer size, with the FORCE variant if SBN has CAP_NET_ADMIN
+ * and so is not held to the net.core *mem_max sysctls.
+ */
+static void SetSockBuf(int Fd, int Opt, int ForceOpt, int Sz, const char *Name)
+{
+    int       Actual = 0;
+    socklen_t Len    = sizeof(Actual);
+
+    if (setsockopt(Fd, SOL_SOCKET, ForceOpt, &Sz, sizeof(Sz)) < 0
+        && setsockopt(Fd, SOL_SOCKET, Opt, &Sz, sizeof(Sz)) < 0)
+    {
+        EVSSendErr(SBN_TCP_SOCK_EID, "unable to set %s (errno=%d)", Name, errno);
+    } /* end if */
+
+    /* the kernel doubles the size for its overhead */
+    if (getsockopt(Fd, SOL_SOCKET, Opt, &Actual, &Len) == 0 && Actual / 2 < Sz)
+    {
+        EVSSendInfo(SBN_TCP_SOCK_EID, "%s limited to %d of %d bytes by the kernel", Name, Actual / 2, Sz);
+    } /* end if */
+} /* end SetSockBuf() */
+
+/**
+ * Applies socket tuning to a socket. A failure is reported but not fatal,
+ * the socket works with the kernel's defaults.
+ *
+ * @param Sock[in] The options, see SBN_TCP_SockOpts_t.
+ * @param Socket[in] The OSAL ID of the socket.
+ */
+static void SetSockOpts(SBN_TCP_SockOpts_t *Sock, OS_SocketID_t Socket)
+{
+    int Fd = -1, Val = 0;
+
+    if (!Sock->RcvBuf && !Sock->SndBuf && !Sock->BusyPoll && !Sock->TOS && !Sock->Prio)
+    {
+        return;
+    } /* end if */
+
+    if ((Fd = SBN_NativeFd(Socket, SBN_TCP_SOCK_EID)) < 0)
+    {
+        return;
+    } /* end if */
+
+    if (Sock->RcvBuf)
+    {
+        SetSockBuf(Fd, SO_RCVBUF, SO_RCVBUFFORCE, Sock->RcvBuf, "rcvbuf");
+    } /* end if */
+
+    if (Sock->SndBuf)
+    {
+        SetSockBuf(Fd, SO_SNDBUF, SO_SNDBUFFORCE, Sock->SndBuf, "sndbuf");
+    } /* end if */
+
+#ifdef SO_BUSY_POLL
+    Val = Sock->BusyPoll;
+    if (Val && setsockopt(Fd, SOL_SOCKET, SO_BUSY_POLL, &Val, sizeof(Val)) < 0)
+    {
+        EVSSendErr(SBN_TCP_SOCK_EID, "unable to set busy_poll (errno=%d)", errno);
+    } /* end if */
+#endif /* SO_BUSY_POLL */
+
+    Val = Sock->TOS;
+    if (Val && setsockopt(Fd, IPPROTO_IP, IP_TOS, &Val, sizeof(Val)) < 0)
+    {
+        EVSSendErr(SBN_TCP_SOCK_EID, "unable to set tos (errno=%d)", errno);
+    } /* end if */
+
+    Val = Sock->Prio;
+    if (Val && setsockopt(Fd, SOL_SOCKET, SO_PRIORITY, &Val, sizeof(Val)) < 0)
+    {
+        EVSSendErr(SBN_TCP_SOCK_EID, "unable to set prio (errno=%d)", errno);
+    } /* end if */
+} /* end SetSockOpts() */
+
+/**
+ * Applies the net's liveness options to a connected socket.
+ *
+ * @param Opts[in] The net options.
+ * @param Socket[in] The OSAL ID of the connected socket.
+ */
+static void SetConnOpts(SBN_TCP_Opts_t *Opts, OS_SocketID_t Socket)
+{
+    int One = 1;
+    int Fd  = SBN_NativeFd(Socket, SBN_TCP_SOCK_EID);
+
+    if (Fd < 0)
+    {
+        return;
+    } /* end if */
+
+#ifdef TCP_USER_TIMEOUT
+    if (Opts->UserTimeout)
+    {
+        unsigned int UserTimeout = Opts->UserTimeout;
+        if (setsockopt(Fd, IPPROTO_TCP, TCP_USER_TIMEOUT, &UserTimeout, sizeof(UserTimeout)) < 0)
+        {
+            EVSSendErr(SBN_TCP_SOCK_EID, "unable to set TCP_USER_TIMEOUT (errno=%d)", errno);
+        } /* end if */
+    }     /* end if */
+#endif /* TCP_USER_TIMEOUT */
+
+    if (Opts->KeepIdle)
+    {
+        int Idle = Opts->KeepIdle, Intvl = Opts->KeepIntvl, Cnt = Opts->KeepCnt;
+
+        if (setsockopt(Fd, SOL_SOCKET, SO_KEEPALIVE, &One, sizeof(One)) < 0
+            || setsockopt(Fd, IPPROTO_TCP, TCP_KEEPIDLE, &Idle, sizeof(Idle)) < 0
+            || (Intvl && setsockopt(Fd, IPPROTO_TCP, TCP_KEEPINTVL, &Intvl, sizeof(Intvl)) < 0)
+            || (Cnt && setsockopt(Fd, IPPROTO_TCP, TCP_KEEPCNT, &Cnt, sizeof(Cnt)) < 0))
+        {
+            EVSSendErr(SBN_TCP_SOCK_EID, "unable to set keepalive (errno=%d)", errno);
+        } /* end if */
+    }     /* end if */
+} /* end SetConnOpts() */
+
+static uint8          SendBufs[SBN_MAX_NETS][SBN_MAX_PACKED_MSG_SZ];
+static SBN_TCP_Conn_t ConnTbl[SBN_MAX_NETS][SBN_MAX_PEER_CNT];
+static int            SendBufCnt   = 0;
+static uint8          LoadedNetCnt = 0;
 
 static SBN_TCP_Conn_t *NewConn(SBN_TCP_Net_t *NetData, int Socket)
 {
@@ -174,11 +453,26 @@ static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
 
     EVSSendInfo(SBN_TCP_CONFIG_EID, "configuring net 0x%lx -> %s", (unsigned long int)NetData, Address);
 
+    if (SendBufCnt >= SBN_MAX_NETS)
+    {
+        EVSSendErr(SBN_TCP_CONFIG_EID, "too many nets (%d)", SendBufCnt);
+        return SBN_ERROR;
+    } /* end if */
+
     SBN_Status_t Status = ConfAddr(&NetData->Addr, Address);
 
+    if (Status == SBN_SUCCESS)
+    {
+        Status = ConfOpts(&NetData->Opts, &NetData->Opts.Sock, Address);
+    } /* end if */
+
     if (Status == SBN_SUCCESS)
     {
         NetData->BufNum = SendBufCnt++;
+        NetData->Conns  = ConnTbl[NetData->BufNum];
+        LoadedNetCnt++;
+
+        memset(NetData->Conns, 0, sizeof(ConnTbl[0]));
 
         EVSSendInfo(SBN_TCP_CONFIG_EID, "net 0x%lx configured", (unsigned long int)NetData);
     } /* end if */
@@ -195,8 +489,19 @@ static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
 
     EVSSendInfo(SBN_TCP_CONFIG_EID, "configuring peer 0x%lx -> %s", (unsigned long int)PeerData, Address);
 
+    if (RecvBufCnt >= SBN_MAX_PEER_CNT)
+    {
+        EVSSendErr(SBN_TCP_CONFIG_EID, "too many peers (%d)", RecvBufCnt);
+        return SBN_ERROR;
+    } /* end if */
+
     SBN_Status_t Status = ConfAddr(&PeerData->Addr, Address);
 
+    if (Status == SBN_SUCCESS)
+    {
+        Status = ConfOpts(NULL, &PeerData->Sock, Address);
+    } /* end if */
+
     if (Status == SBN_SUCCESS)
     {
         PeerData->BufNum = RecvBufCnt++;
@@ -226,6 +531,9 @@ static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
         return SBN_ERROR;
     } /* end if */
 
+    /* before listening, so the window scale offered to accepted connections covers rcvbuf */
+    SetSockOpts(&NetData->Opts.Sock, Socket);
+
     if (OS_SocketBind(Socket, &NetData->Addr) != OS_SUCCESS)
     {
         EVSSendErr(SBN_TCP_SOCK_EID, "bind call failed (0x%lx Socket=%d)", (unsigned long int)NetData, NetData->Socket);
@@ -266,7 +574,14 @@ static void CheckNet(SBN_NetInterface_t *Net)
     /* NOTE: OSAL currently has a bug that causes OS_SocketAccept to fail, see ticket #349. */
     while ((Status = OS_SocketAccept(NetData->Socket, &ClientFd, &Addr, 0)) == OS_SUCCESS)
     {
-        NewConn(NetData, ClientFd);
+        if (NewConn(NetData, ClientFd) == NULL)
+        {
+            EVSSendErr(SBN_TCP_SOCK_EID, "too many connections, dropping");
+            OS_close(ClientFd);
+            continue;
+        } /* end if */
+
+        SetConnOpts(&NetData->Opts, ClientFd);
     } /* end while */
 
     if (Status != OS_ERROR_TIMEOUT)
@@ -301,6 +616,9 @@ static void CheckNet(SBN_NetInterface_t *Net)
                     return;
                 } /* end if */
 
+                SetSockOpts(&NetData->Opts.Sock, Socket);
+                SetSockOpts(&PeerData->Sock, Socket);
+
                 /* TODO: Make timeout configurable */
                 if (OS_SocketConnect(Socket, &PeerData->Addr, 100) != OS_SUCCESS)
                 {
@@ -314,6 +632,8 @@ static void CheckNet(SBN_NetInterface_t *Net)
 
                 EVSSendInfo(SBN_TCP_DEBUG_EID, "CPU %d connected", Peer->ProcessorID);
 
+                SetConnOpts(&NetData->Opts, Socket);
+
                 SBN_TCP_Conn_t *Conn = NewConn(NetData, Socket);
                 if (Conn)
                 {
@@ -327,11 +647,10 @@ static void CheckNet(SBN_NetInterface_t *Net)
     }             /* end for */
 } /* end CheckNet() */
 
-static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg)
+static SBN_Status_t SendPacked(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg,
+                               void *PackedMsg)
 {
-    SBN_TCP_Peer_t *    PeerData = (SBN_TCP_Peer_t *)Peer->ModulePvt;
-    SBN_NetInterface_t *Net      = Peer->Net;
-    SBN_TCP_Net_t *     NetData  = (SBN_TCP_Net_t *)Net->ModulePvt;
+    SBN_TCP_Peer_t *PeerData = (SBN_TCP_Peer_t *)Peer->ModulePvt;
 
     if (PeerData->Conn == NULL)
     {
@@ -339,8 +658,7 @@ static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_M
         return 0;
     } /* end if */
 
-    SBN.PackMsg(&SendBufs[NetData->BufNum], MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Msg);
-    SBN_MsgSz_t sent_size = OS_write(PeerData->Conn->Socket, &SendBufs[NetData->BufNum], MsgSz + SBN_PACKED_HDR_SZ);
+    SBN_MsgSz_t sent_size = OS_write(PeerData->Conn->Socket, PackedMsg, MsgSz + SBN_PACKED_HDR_SZ);
     if (sent_size < MsgSz + SBN_PACKED_HDR_SZ)
     {
         EVSSendInfo(SBN_TCP_DEBUG_EID, "CPU %d failed to write, disconnected", Peer->ProcessorID);
@@ -350,10 +668,29 @@ static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_M
     } /* end if */
 
     return SBN_SUCCESS;
+} /* end SendPacked() */
+
+static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg)
+{
+    SBN_TCP_Peer_t *    PeerData = (SBN_TCP_Peer_t *)Peer->ModulePvt;
+    SBN_NetInterface_t *Net      = Peer->Net;
+    SBN_TCP_Net_t *     NetData  = (SBN_TCP_Net_t *)Net->ModulePvt;
+
+    if (PeerData->Conn == NULL)
+    {
+        /* fail silently as the peer is not connected (yet) */
+        return 0;
+    } /* end if */
+
+    SBN.PackMsg(&SendBufs[NetData->BufNum], MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Msg);
+
+    return SendPacked(Peer, MsgType, MsgSz, Msg, &SendBufs[NetData->BufNum]);
 } /* end Send() */
 
 static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
 {
+    SBN_TCP_Net_t *NetData = (SBN_TCP_Net_t *)Peer->Net->ModulePvt;
+
     CheckNet(Peer->Net);
 
     if (!Peer->Connected)
@@ -364,12 +701,14 @@ static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
     OS_time_t CurrentTime;
     OS_GetLocalTime(&CurrentTime);
 
-    if (SBN_TCP_PEER_HEARTBEAT > 0 && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_TCP_PEER_HEARTBEAT)
+    if (NetData->Opts.Heartbeat > 0
+        && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > NetData->Opts.Heartbeat)
     {
         Send(Peer, SBN_TCP_HEARTBEAT_MSG, 0, NULL);
     } /* end if */
 
-    if (SBN_TCP_PEER_TIMEOUT > 0 && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastRecv)) > SBN_TCP_PEER_TIMEOUT)
+    if (NetData->Opts.Timeout > 0
+        && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastRecv)) > NetData->Opts.Timeout)
     {
         EVSSendInfo(SBN_TCP_DEBUG_EID, "CPU %d timeout, disconnected", Peer->ProcessorID);
 
@@ -434,9 +773,16 @@ static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN
                 {
                     EVSSendInfo(SBN_TCP_DEBUG_EID, "Connection %d head recv failed, disconnected", ConnID);
 
-                    OS_close(Conn->Socket);
-
-                    Disconnected(Conn->PeerInterface);
+                    /* this is also where the kernel reports dead connections (user timeout/keepalive) */
+                    if (Conn->PeerInterface != NULL)
+                    {
+                        Disconnected(Conn->PeerInterface);
+                    }
+                    else
+                    {
+                        OS_close(Conn->Socket);
+                        Conn->InUse = false;
+                    } /* end if */
 
                     return SBN_IF_EMPTY;
                 } /* end if */
@@ -502,6 +848,9 @@ static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN
 
                         PeerData->Conn = Conn;
 
+                        /* an accepted connection has the net's options from the listening socket */
+                        SetSockOpts(&PeerData->Sock, Conn->Socket);
+
                         Conn->PeerInterface = PeerInterface;
 
                         SBN.Connected(PeerInterface);
@@ -541,8 +890,55 @@ static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
         UnloadPeer(&Net->Peers[PeerIdx]);
     } /* end if */
 
+    /* the other nets' tables follow this one's, so they are only reused once all are unloaded */
+    if (LoadedNetCnt && --LoadedNetCnt == 0)
+    {
+        SendBufCnt = 0;
+        RecvBufCnt = 0;
+    } /* end if */
+
     return SBN_SUCCESS;
 } /* end UnloadNet() */
 
+/**
+ * Reports, big-endian, for the peer's connection: uint32 the receive and send
+ * buffer sizes the kernel settled on (see the rcvbuf and sndbuf options), and
+ * the segments it dropped for want of receive memory. That is the count
+ * SO_RXQ_OVFL would attach to received data, but OSAL reads without control
+ * messages so it is read with SO_MEMINFO. All 0 when not connected.
+ */
+static SBN_Status_t ReportModuleStatus(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz)
+{
+    SBN_TCP_Peer_t *PeerData   = (SBN_TCP_Peer_t *)Peer->ModulePvt;
+    uint32          MemInfo[3] = {0, 0, 0};
+    uint8 *         Ptr        = StatusBuf;
+
+    if (StatusBufSz < 3 * 4)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+#ifdef SO_MEMINFO
+    uint32    Mem[SK_MEMINFO_VARS];
+    socklen_t Len = sizeof(Mem);
+    int       Fd  = -1;
+
+    if (PeerData->Conn != NULL && (Fd = SBN_NativeFd(PeerData->Conn->Socket, SBN_TCP_SOCK_EID)) >= 0
+        && getsockopt(Fd, SOL_SOCKET, SO_MEMINFO, Mem, &Len) == 0)
+    {
+        MemInfo[0] = Mem[SK_MEMINFO_RCVBUF];
+        MemInfo[1] = Mem[SK_MEMINFO_SNDBUF];
+        MemInfo[2] = Mem[SK_MEMINFO_DROPS];
+    } /* end if */
+#endif /* SO_MEMINFO */
+
+    Ptr = SBN_PutUInt32(Ptr, MemInfo[0]);
+    Ptr = SBN_PutUInt32(Ptr, MemInfo[1]);
+    Ptr = SBN_PutUInt32(Ptr, MemInfo[2]);
+
+    return SBN_SUCCESS;
+} /* end ReportModuleStatus() */
+
 SBN_IfOps_t SBN_TCP_Ops = {Init, InitNet, InitPeer, LoadNet,   LoadPeer,  PollPeer,
-                           Send, NULL,    Recv,     UnloadNet, UnloadPeer};
+                           Send, NULL,    Recv,     UnloadNet, UnloadPeer, ReportModuleStatus,
+                           SendPacked};
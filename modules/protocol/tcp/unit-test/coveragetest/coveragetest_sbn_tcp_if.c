@@ -0,0 +1,383 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_tcp_if.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN TCP protocol module's address options
+** and the liveness options it sets on its connections.
+**
+** Notes:
+** The module's types and static functions are private to its source file,
+** which is included here.
+*/
+
+#include "sbn_stubs.h"
+#include "sbn_tcp_if_coveragetest_common.h"
+
+#include "sbn_tcp_if.c"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#define SBN_PROTOCOL_VERSION 6
+
+/* the module reaches native sockets through the OSAL impl table, see SBN_NativeFd() */
+OS_impl_file_internal_record_t OS_impl_filehandle_table[OS_MAX_NUM_OPEN_FILES];
+
+static SBN_NetInterface_t  Nets[SBN_MAX_NETS + 1];
+static SBN_NetInterface_t *NetPtr;
+static SBN_PeerInterface_t *PeerPtr;
+
+typedef struct
+{
+    uint16      ExpectedEvent;
+    int         MatchCount;
+    const char *ExpectedText;
+} UT_CheckEvent_t;
+static UT_CheckEvent_t EventTest;
+
+#define EVENT_CNT(C) UtAssert_True(EventTest.MatchCount == (C), "event generated (%d)", EventTest.MatchCount)
+
+#define START() START_fn(__func__, __LINE__)
+
+static void START_fn(const char *fn, int ln)
+{
+    SBN_ProtocolOutlet_t Outlet;
+
+    UT_ResetState(0);
+    printf("Start item %s (%d)\n", fn, ln);
+    memset(Nets, 0, sizeof(Nets));
+    memset(&Outlet, 0, sizeof(Outlet));
+    NetPtr                = &Nets[0];
+    PeerPtr               = &NetPtr->Peers[0];
+    PeerPtr->Net          = NetPtr;
+    PeerPtr->ProcessorID  = 1;
+    PeerPtr->SpacecraftID = 42;
+
+    SBN_TCP_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet);
+} /* end START_fn() */
+
+/* counts the events of the expected ID whose text starts with the expected text */
+static int32 UT_CheckEvent_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context,
+                                va_list va)
+{
+    UT_CheckEvent_t *State = UserObj;
+    char             TestText[CFE_MISSION_EVS_MAX_MESSAGE_LENGTH];
+    const char *     Spec;
+
+    if (Context->ArgCount > 0 && UT_Hook_GetArgValueByName(Context, "EventID", uint16) == State->ExpectedEvent)
+    {
+        Spec = UT_Hook_GetArgValueByName(Context, "Spec", const char *);
+        if (Spec != NULL)
+        {
+            vsnprintf(TestText, sizeof(TestText), Spec, va);
+            if (strncmp(TestText, State->ExpectedText, strlen(State->ExpectedText)) == 0)
+            {
+                ++State->MatchCount;
+            } /* end if */
+        }     /* end if */
+    }         /* end if */
+
+    return 0;
+} /* end UT_CheckEvent_Hook() */
+
+static void UT_CheckEvent_Setup(UT_CheckEvent_t *Evt, uint16 ExpectedEvent, const char *ExpectedText)
+{
+    memset(Evt, 0, sizeof(*Evt));
+    Evt->ExpectedEvent = ExpectedEvent;
+    Evt->ExpectedText  = ExpectedText;
+    UT_SetVaHookFunction(UT_KEY(CFE_EVS_SendEvent), UT_CheckEvent_Hook, Evt);
+} /* end UT_CheckEvent_Setup() */
+
+static void UnloadAll(int Cnt)
+{
+    int i = 0;
+
+    for (i = 0; i < Cnt; i++)
+    {
+        UT_TEST_FUNCTION_RC(SBN_TCP_Ops.UnloadNet(&Nets[i]), SBN_SUCCESS);
+    } /* end for */
+} /* end UnloadAll() */
+
+static void LoadNet_Liveness(void)
+{
+    START();
+
+    SBN_TCP_Net_t *NetData = (SBN_TCP_Net_t *)NetPtr->ModulePvt;
+
+    UT_TEST_FUNCTION_RC(
+        SBN_TCP_Ops.LoadNet(NetPtr,
+                            "127.0.0.1:2234?utimeout=500&keepidle=30&keepintvl=5&keepcnt=3&heartbeat=0&timeout=20"),
+        SBN_SUCCESS);
+
+    UtAssert_True(NetData->Opts.UserTimeout == 500, "utimeout (%d)", (int)NetData->Opts.UserTimeout);
+    UtAssert_True(NetData->Opts.KeepIdle == 30, "keepidle (%d)", (int)NetData->Opts.KeepIdle);
+    UtAssert_True(NetData->Opts.KeepIntvl == 5, "keepintvl (%d)", (int)NetData->Opts.KeepIntvl);
+    UtAssert_True(NetData->Opts.KeepCnt == 3, "keepcnt (%d)", (int)NetData->Opts.KeepCnt);
+    UtAssert_True(NetData->Opts.Heartbeat == 0, "heartbeat (%d)", (int)NetData->Opts.Heartbeat);
+    UtAssert_True(NetData->Opts.Timeout == 20, "timeout (%d)", (int)NetData->Opts.Timeout);
+
+    UnloadAll(1);
+} /* end LoadNet_Liveness() */
+
+static void LoadNet_Defaults(void)
+{
+    START();
+
+    SBN_TCP_Net_t *NetData = (SBN_TCP_Net_t *)NetPtr->ModulePvt;
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadNet(NetPtr, "127.0.0.1:2234"), SBN_SUCCESS);
+
+    UtAssert_True(NetData->Opts.Heartbeat == SBN_TCP_PEER_HEARTBEAT, "default heartbeat");
+    UtAssert_True(NetData->Opts.Timeout == SBN_TCP_PEER_TIMEOUT, "default timeout");
+    UtAssert_True(NetData->Opts.KeepIdle == 0, "keepalive off by default");
+
+    UnloadAll(1);
+} /* end LoadNet_Defaults() */
+
+static void LoadNet_RangeErr(void)
+{
+    const char *Addrs[] = {"127.0.0.1:2234?heartbeat=65536", "127.0.0.1:2234?timeout=65536",
+                           "127.0.0.1:2234?keepidle=70000",  "127.0.0.1:2234?keepintvl=32768",
+                           "127.0.0.1:2234?keepcnt=128",     "127.0.0.1:2234?utimeout=4294967296"};
+    int         i       = 0;
+
+    for (i = 0; i < (int)(sizeof(Addrs) / sizeof(Addrs[0])); i++)
+    {
+        START();
+
+        UT_CheckEvent_Setup(&EventTest, SBN_TCP_CONFIG_EID, "unknown option or value out of range");
+
+        UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadNet(NetPtr, Addrs[i]), SBN_ERROR);
+
+        EVENT_CNT(1);
+    } /* end for */
+} /* end LoadNet_RangeErr() */
+
+static void LoadNet_Limits(void)
+{
+    START();
+
+    SBN_TCP_Net_t *NetData = (SBN_TCP_Net_t *)NetPtr->ModulePvt;
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadNet(NetPtr, "127.0.0.1:2234?keepidle=32767&keepcnt=127&heartbeat=65535"),
+                        SBN_SUCCESS);
+
+    UtAssert_True(NetData->Opts.KeepIdle == SBN_TCP_MAX_KEEPIDLE, "keepidle at the kernel's limit");
+    UtAssert_True(NetData->Opts.KeepCnt == SBN_TCP_MAX_KEEPCNT, "keepcnt at the kernel's limit");
+    UtAssert_True(NetData->Opts.Heartbeat == 0xFFFF, "heartbeat at its field's limit");
+
+    UnloadAll(1);
+} /* end LoadNet_Limits() */
+
+static void LoadNet_SuffixErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_CONFIG_EID, "invalid option value (keepidle=1K)");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadNet(NetPtr, "127.0.0.1:2234?keepidle=1K"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_SuffixErr() */
+
+static void LoadNet_SockOpts(void)
+{
+    START();
+
+    SBN_TCP_Net_t *NetData = (SBN_TCP_Net_t *)NetPtr->ModulePvt;
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadNet(NetPtr, "127.0.0.1:2234?rcvbuf=8M&sndbuf=512k&busy_poll=50"),
+                        SBN_SUCCESS);
+
+    UtAssert_True(NetData->Opts.Sock.RcvBuf == 8 << 20, "rcvbuf takes a size suffix");
+    UtAssert_True(NetData->Opts.Sock.SndBuf == 512 << 10, "sndbuf takes a size suffix");
+    UtAssert_True(NetData->Opts.Sock.BusyPoll == 50, "busy_poll");
+
+    UnloadAll(1);
+} /* end LoadNet_SockOpts() */
+
+static void LoadNet_TooMany(void)
+{
+    int i = 0;
+
+    START();
+
+    for (i = 0; i < SBN_MAX_NETS; i++)
+    {
+        UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadNet(&Nets[i], "127.0.0.1:2234"), SBN_SUCCESS);
+    } /* end for */
+
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_CONFIG_EID, "too many nets");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadNet(&Nets[SBN_MAX_NETS], "127.0.0.1:2234"), SBN_ERROR);
+
+    EVENT_CNT(1);
+
+    /* the tables are reused once all the nets are unloaded, not before */
+    UnloadAll(SBN_MAX_NETS - 1);
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadNet(&Nets[SBN_MAX_NETS], "127.0.0.1:2234"), SBN_ERROR);
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.UnloadNet(&Nets[SBN_MAX_NETS - 1]), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadNet(&Nets[SBN_MAX_NETS], "127.0.0.1:2234"), SBN_SUCCESS);
+    UtAssert_True(((SBN_TCP_Net_t *)Nets[SBN_MAX_NETS].ModulePvt)->BufNum == 0, "tables reused");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.UnloadNet(&Nets[SBN_MAX_NETS]), SBN_SUCCESS);
+} /* end LoadNet_TooMany() */
+
+static void LoadPeer_NetOptErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_CONFIG_EID, "unknown option or value out of range (keepidle=1)");
+
+    UT_TEST_FUNCTION_RC(SBN_TCP_Ops.LoadPeer(PeerPtr, "127.0.0.1:2235?keepidle=1"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadPeer_NetOptErr() */
+
+void Test_SBN_TCP_ConfOpts(void)
+{
+    LoadNet_Liveness();
+    LoadNet_Defaults();
+    LoadNet_RangeErr();
+    LoadNet_Limits();
+    LoadNet_SuffixErr();
+    LoadNet_SockOpts();
+    LoadNet_TooMany();
+    LoadPeer_NetOptErr();
+} /* end Test_SBN_TCP_ConfOpts() */
+
+/* a real socket behind OSAL socket 0, to read the options back from */
+static int OpenSock(void)
+{
+    uint32 Idx = 0;
+    int    Fd  = socket(AF_INET, SOCK_STREAM, 0);
+
+    UtAssert_True(Fd >= 0, "socket opened");
+
+    OS_impl_filehandle_table[0].fd = Fd;
+    UT_SetDataBuffer(UT_KEY(OS_ConvertToArrayIndex), &Idx, sizeof(Idx), false);
+
+    return Fd;
+} /* end OpenSock() */
+
+static int GetOpt(int Fd, int Level, int Name)
+{
+    int       Val = -1;
+    socklen_t Len = sizeof(Val);
+
+    UtAssert_True(getsockopt(Fd, Level, Name, &Val, &Len) == 0, "getsockopt");
+
+    return Val;
+} /* end GetOpt() */
+
+static void SetConnOpts_Keepalive(void)
+{
+    SBN_TCP_Opts_t Opts;
+    int            Fd = -1;
+
+    START();
+
+    memset(&Opts, 0, sizeof(Opts));
+    Opts.UserTimeout = 500;
+    Opts.KeepIdle    = 30;
+    Opts.KeepIntvl   = 5;
+    Opts.KeepCnt     = 3;
+
+    Fd = OpenSock();
+
+    SetConnOpts(&Opts, 0);
+
+    UtAssert_True(GetOpt(Fd, SOL_SOCKET, SO_KEEPALIVE) != 0, "SO_KEEPALIVE set");
+    UtAssert_True(GetOpt(Fd, IPPROTO_TCP, TCP_KEEPIDLE) == 30, "TCP_KEEPIDLE set");
+    UtAssert_True(GetOpt(Fd, IPPROTO_TCP, TCP_KEEPINTVL) == 5, "TCP_KEEPINTVL set");
+    UtAssert_True(GetOpt(Fd, IPPROTO_TCP, TCP_KEEPCNT) == 3, "TCP_KEEPCNT set");
+#ifdef TCP_USER_TIMEOUT
+    UtAssert_True(GetOpt(Fd, IPPROTO_TCP, TCP_USER_TIMEOUT) == 500, "TCP_USER_TIMEOUT set");
+#endif /* TCP_USER_TIMEOUT */
+
+    close(Fd);
+} /* end SetConnOpts_Keepalive() */
+
+static void SetConnOpts_Off(void)
+{
+    SBN_TCP_Opts_t Opts;
+    int            Fd = -1;
+
+    START();
+
+    memset(&Opts, 0, sizeof(Opts));
+    Opts.KeepIntvl = 5; /* ignored without keepidle */
+
+    Fd = OpenSock();
+
+    SetConnOpts(&Opts, 0);
+
+    UtAssert_True(GetOpt(Fd, SOL_SOCKET, SO_KEEPALIVE) == 0, "SO_KEEPALIVE left off");
+
+    close(Fd);
+} /* end SetConnOpts_Off() */
+
+static void SetConnOpts_SockErr(void)
+{
+    SBN_TCP_Opts_t Opts;
+
+    START();
+
+    memset(&Opts, 0, sizeof(Opts));
+    Opts.KeepIdle = 30;
+
+    UT_SetDefaultReturnValue(UT_KEY(OS_ConvertToArrayIndex), OS_ERROR);
+    UT_CheckEvent_Setup(&EventTest, SBN_TCP_SOCK_EID, "unable to find socket");
+
+    SetConnOpts(&Opts, 0);
+
+    EVENT_CNT(1);
+} /* end SetConnOpts_SockErr() */
+
+void Test_SBN_TCP_SetConnOpts(void)
+{
+    SetConnOpts_Keepalive();
+    SetConnOpts_Off();
+    SetConnOpts_SockErr();
+} /* end Test_SBN_TCP_SetConnOpts() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_TCP_ConfOpts);
+    ADD_TEST(SBN_TCP_SetConnOpts);
+}
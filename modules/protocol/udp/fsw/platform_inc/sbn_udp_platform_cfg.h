@@ -0,0 +1,30 @@
+/**
+ * @file
+ *
+ * This file contains several user-configurable parameters
+ */
+#ifndef _udp_platform_cfg_h_
+#define _udp_platform_cfg_h_
+
+/**
+ * "Reliable" messages awaiting acknowledgement are kept in one pool for all
+ * of the module's nets and peers, SBN_UDP_REL_SLOTS slots each holding an app
+ * message of up to SBN_UDP_REL_MAX_MSG_SZ bytes; a larger message for a
+ * reliable subscription is sent unreliably, with an event.
+ */
+#define SBN_UDP_REL_SLOTS      32
+#define SBN_UDP_REL_MAX_MSG_SZ 1024
+
+/**
+ * The "fec" option XORs the datagrams of each group sent and received in a
+ * slot of one of two pools for all of the module's nets: one slot for each
+ * peer of a net and its group sending, two for each peer receiving (to this
+ * node and to the group.) Datagrams over SBN_UDP_FEC_MAX_DGRAM
+ * bytes, which only nets without the "mtu" option send, go out unprotected;
+ * it is at most CFE_MISSION_SB_MAX_SB_MSG_SIZE less 6, the FEC header.
+ */
+#define SBN_UDP_FEC_ENC_SLOTS (SBN_MAX_PEER_CNT + 1)
+#define SBN_UDP_FEC_DEC_SLOTS (SBN_MAX_PEER_CNT * 2)
+#define SBN_UDP_FEC_MAX_DGRAM 1500
+
+#endif
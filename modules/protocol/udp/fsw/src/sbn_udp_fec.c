@@ -0,0 +1,441 @@
+#include "sbn_udp_fec.h"
+#include <string.h>
+
+/**
+ * XORs Src into the first Sz bytes of Dst, a word at a time, which compilers
+ * widen to the target's vector registers where it has them.
+ */
+static void Xor(uint8 *Dst, const uint8 *Src, size_t Sz)
+{
+    size_t i = 0;
+    uint64 D = 0, S = 0;
+
+    for (i = 0; i + sizeof(D) <= Sz; i += sizeof(D))
+    {
+        memcpy(&D, Dst + i, sizeof(D));
+        memcpy(&S, Src + i, sizeof(S));
+        D ^= S;
+        memcpy(Dst + i, &D, sizeof(D));
+    } /* end for */
+
+    for (; i < Sz; i++)
+    {
+        Dst[i] ^= Src[i];
+    } /* end for */
+} /* end Xor() */
+
+/**
+ * XORs data into a group's accumulator; the accumulator is taken to be zeros
+ * past AccSz, so the data past it is copied in.
+ */
+static void Accumulate(uint8 *Acc, uint16 *AccSzPtr, const uint8 *Data, size_t DataSz)
+{
+    if (DataSz > *AccSzPtr)
+    {
+        Xor(Acc, Data, *AccSzPtr);
+        memcpy(Acc + *AccSzPtr, Data + *AccSzPtr, DataSz - *AccSzPtr);
+        *AccSzPtr = DataSz;
+    }
+    else
+    {
+        Xor(Acc, Data, DataSz);
+    } /* end if */
+} /* end Accumulate() */
+
+static void PutHdr(uint8 *Buf, uint16 Group, uint8 Index, uint8 Flags, uint16 Len)
+{
+    Buf[0] = Group >> 8;
+    Buf[1] = Group & 0xFF;
+    Buf[2] = Index;
+    Buf[3] = Flags;
+    Buf[4] = Len >> 8;
+    Buf[5] = Len & 0xFF;
+} /* end PutHdr() */
+
+void SBN_UDP_FecInit(SBN_UDP_FecEnc_t *Enc, SBN_UDP_FecDec_t *Dec)
+{
+    int i = 0;
+
+    if (Enc)
+    {
+        for (i = 0; i < SBN_UDP_FEC_ENC_SLOTS; i++)
+        {
+            Enc->Slots[i].Active = false;
+        } /* end for */
+
+        memset(Enc->NextGroup, 0, sizeof(Enc->NextGroup));
+    } /* end if */
+
+    if (Dec)
+    {
+        for (i = 0; i < SBN_UDP_FEC_DEC_SLOTS; i++)
+        {
+            Dec->Slots[i].Active = false;
+        } /* end for */
+    }     /* end if */
+} /* end SBN_UDP_FecInit() */
+
+static SBN_UDP_FecEncSlot_t *FindEncSlot(SBN_UDP_FecEnc_t *Enc, uint8 NetNum, uint8 Dest)
+{
+    int i = 0;
+
+    for (i = 0; i < SBN_UDP_FEC_ENC_SLOTS; i++)
+    {
+        if (Enc->Slots[i].Active && Enc->Slots[i].NetNum == NetNum && Enc->Slots[i].Dest == Dest)
+        {
+            return &Enc->Slots[i];
+        } /* end if */
+    }     /* end for */
+
+    return NULL;
+} /* end FindEncSlot() */
+
+SBN_UDP_FecEncSlot_t *SBN_UDP_FecEncode(SBN_UDP_FecEnc_t *Enc, SBN_UDP_FecCnt_t Cnts[], uint8 NetNum, uint8 Dest,
+                                        uint8 GroupSz, const uint8 *Dgram, size_t DgramSz, uint32 NowMs, uint8 *Hdr)
+{
+    SBN_UDP_FecEncSlot_t *Slot = FindEncSlot(Enc, NetNum, Dest);
+    int                   i    = 0;
+
+    if (!Slot)
+    {
+        for (i = 0; i < SBN_UDP_FEC_ENC_SLOTS; i++)
+        {
+            SBN_UDP_FecEncSlot_t *S = &Enc->Slots[i];
+
+            if (!S->Active)
+            {
+                Slot = S;
+                break;
+            } /* end if */
+
+            if (!Slot || NowMs - S->StartMs > NowMs - Slot->StartMs)
+            {
+                Slot = S;
+            } /* end if */
+        }     /* end for */
+
+        /* every slot is busy, the oldest group goes without its parity */
+        Slot->Active  = true;
+        Slot->NetNum  = NetNum;
+        Slot->Dest    = Dest;
+        Slot->Group   = Enc->NextGroup[NetNum][Dest]++;
+        Slot->Cnt     = 0;
+        Slot->AccSz   = 0;
+        Slot->LenX    = 0;
+        Slot->StartMs = NowMs;
+    } /* end if */
+
+    PutHdr(Hdr, Slot->Group, Slot->Cnt, Dest == SBN_UDP_FEC_GROUP_DEST ? SBN_UDP_FEC_TO_GROUP : 0, DgramSz);
+
+    Accumulate(Slot->Acc, &Slot->AccSz, Dgram, DgramSz);
+    Slot->LenX ^= DgramSz;
+    Slot->Cnt++;
+
+    Cnts[NetNum].DataTxCnt++;
+    Cnts[NetNum].OverheadBytes += SBN_PACKED_HDR_SZ + SBN_UDP_FEC_HDR_SZ;
+
+    return Slot->Cnt >= GroupSz ? Slot : NULL;
+} /* end SBN_UDP_FecEncode() */
+
+SBN_UDP_FecEncSlot_t *SBN_UDP_FecFlush(SBN_UDP_FecEnc_t *Enc, uint8 NetNum, uint8 Dest, uint32 NowMs)
+{
+    SBN_UDP_FecEncSlot_t *Slot = FindEncSlot(Enc, NetNum, Dest);
+
+    if (Slot && NowMs - Slot->StartMs >= SBN_UDP_FEC_FLUSH_MS)
+    {
+        return Slot;
+    } /* end if */
+
+    return NULL;
+} /* end SBN_UDP_FecFlush() */
+
+size_t SBN_UDP_FecParity(SBN_UDP_FecEncSlot_t *Slot, SBN_UDP_FecCnt_t Cnts[], uint8 *Buf)
+{
+    PutHdr(Buf, Slot->Group, Slot->Cnt,
+           SBN_UDP_FEC_PARITY | (Slot->Dest == SBN_UDP_FEC_GROUP_DEST ? SBN_UDP_FEC_TO_GROUP : 0), Slot->LenX);
+    memcpy(Buf + SBN_UDP_FEC_HDR_SZ, Slot->Acc, Slot->AccSz);
+
+    Slot->Active = false;
+
+    Cnts[Slot->NetNum].ParityTxCnt++;
+    Cnts[Slot->NetNum].OverheadBytes += SBN_PACKED_HDR_SZ + SBN_UDP_FEC_HDR_SZ + Slot->AccSz;
+
+    return SBN_UDP_FEC_HDR_SZ + Slot->AccSz;
+} /* end SBN_UDP_FecParity() */
+
+/**
+ * Counts the datagrams known lost from a group given up on: those short of the
+ * parity's count, or without it, the gaps below the highest Index received.
+ */
+static void GiveUp(SBN_UDP_FecDecSlot_t *Slot, SBN_UDP_FecCnt_t Cnts[])
+{
+    uint8 Index = 0, Top = 0;
+
+    Slot->Active = false;
+
+    if (Slot->Done)
+    {
+        return;
+    } /* end if */
+
+    if (Slot->HaveParity)
+    {
+        Cnts[Slot->NetNum].UnrecoveredCnt += Slot->Cnt - Slot->GotCnt;
+        return;
+    } /* end if */
+
+    for (Index = 0; Index < SBN_UDP_FEC_MAX_GROUP; Index++)
+    {
+        if (Slot->Have & (1 << Index))
+        {
+            Top = Index + 1;
+        } /* end if */
+    }     /* end for */
+
+    Cnts[Slot->NetNum].UnrecoveredCnt += Top - Slot->GotCnt;
+} /* end GiveUp() */
+
+/**
+ * Finds the slot of the message's group, or takes one for it, giving up on
+ * timed out groups on the way. A new group takes a free slot, else a
+ * finished one, else the oldest; never one whose recovered datagram has not
+ * been taken.
+ *
+ * @return The slot, or NULL if every slot holds a recovered datagram.
+ */
+static SBN_UDP_FecDecSlot_t *FindDecSlot(SBN_UDP_FecDec_t *Dec, SBN_UDP_FecCnt_t Cnts[], uint8 NetNum,
+                                         CFE_ProcessorID_t ProcessorID, CFE_SpacecraftID_t SpacecraftID, uint8 Flags,
+                                         uint16 Group, uint32 NowMs)
+{
+    SBN_UDP_FecDecSlot_t *Slot = NULL, *Free = NULL, *Done = NULL, *Oldest = NULL;
+    int                   i    = 0;
+
+    for (i = 0; i < SBN_UDP_FEC_DEC_SLOTS; i++)
+    {
+        Slot = &Dec->Slots[i];
+
+        if (Slot->Active && !Slot->Pending && NowMs - Slot->StartMs > SBN_UDP_FEC_TIMEOUT_MS)
+        {
+            GiveUp(Slot, Cnts);
+        } /* end if */
+
+        if (!Slot->Active)
+        {
+            Free = Free ? Free : Slot;
+            continue;
+        } /* end if */
+
+        if (Slot->NetNum == NetNum && Slot->ProcessorID == ProcessorID && Slot->SpacecraftID == SpacecraftID
+            && Slot->Flags == Flags && Slot->Group == Group)
+        {
+            return Slot;
+        } /* end if */
+
+        if (Slot->Done && !Slot->Pending && (!Done || NowMs - Slot->StartMs > NowMs - Done->StartMs))
+        {
+            Done = Slot;
+        } /* end if */
+
+        if (!Slot->Pending && (!Oldest || NowMs - Slot->StartMs > NowMs - Oldest->StartMs))
+        {
+            Oldest = Slot;
+        } /* end if */
+    }     /* end for */
+
+    if (!Free)
+    {
+        Free = Done ? Done : Oldest;
+        if (!Free)
+        {
+            return NULL;
+        } /* end if */
+
+        GiveUp(Free, Cnts);
+    } /* end if */
+
+    Free->Active       = true;
+    Free->Done         = false;
+    Free->Pending      = false;
+    Free->HaveParity   = false;
+    Free->NetNum       = NetNum;
+    Free->ProcessorID  = ProcessorID;
+    Free->SpacecraftID = SpacecraftID;
+    Free->Flags        = Flags;
+    Free->Group        = Group;
+    Free->Cnt          = 0;
+    Free->GotCnt       = 0;
+    Free->Have         = 0;
+    Free->AccSz        = 0;
+    Free->LenX         = 0;
+    Free->StartMs      = NowMs;
+
+    return Free;
+} /* end FindDecSlot() */
+
+/**
+ * Marks the group done if all its datagrams are in, or recovers the one
+ * missing into the accumulator.
+ *
+ * @return true if a datagram was recovered.
+ */
+static bool Complete(SBN_UDP_FecDecSlot_t *Slot, SBN_UDP_FecCnt_t Cnts[])
+{
+    uint8 Index = 0;
+
+    if (!Slot->HaveParity || Slot->GotCnt + 1 < Slot->Cnt)
+    {
+        return false;
+    } /* end if */
+
+    Slot->Done = true;
+
+    if (Slot->GotCnt >= Slot->Cnt)
+    {
+        return false;
+    } /* end if */
+
+    if (Slot->LenX == 0 || Slot->LenX > Slot->AccSz)
+    {
+        /* the XOR of the sizes does not fit, something arrived corrupted */
+        Cnts[Slot->NetNum].UnrecoveredCnt++;
+        return false;
+    } /* end if */
+
+    for (Index = 0; Index < Slot->Cnt; Index++)
+    {
+        if (!(Slot->Have & (1 << Index)))
+        {
+            Slot->Have |= 1 << Index;
+            break;
+        } /* end if */
+    }     /* end for */
+
+    Slot->GotCnt++;
+    Cnts[Slot->NetNum].RecoveredCnt++;
+
+    return true;
+} /* end Complete() */
+
+SBN_Status_t SBN_UDP_FecDecode(SBN_UDP_FecDec_t *Dec, SBN_UDP_FecCnt_t Cnts[], uint8 NetNum,
+                               CFE_ProcessorID_t ProcessorID, CFE_SpacecraftID_t SpacecraftID, const uint8 *Msg,
+                               size_t MsgSz, uint32 NowMs, uint8 *DgramBuf, size_t *DgramSzPtr)
+{
+    SBN_UDP_FecDecSlot_t *Slot  = NULL;
+    uint16                Group = 0, Len = 0;
+    uint8                 Index = 0, Flags = 0;
+    size_t                DataSz = MsgSz - SBN_UDP_FEC_HDR_SZ;
+
+    if (MsgSz < SBN_UDP_FEC_HDR_SZ)
+    {
+        Cnts[NetNum].ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    Group = (Msg[0] << 8) | Msg[1];
+    Index = Msg[2];
+    Flags = Msg[3];
+    Len   = (Msg[4] << 8) | Msg[5];
+
+    if (DataSz > SBN_UDP_FEC_MAX_DGRAM
+        || ((Flags & SBN_UDP_FEC_PARITY) ? (Index < 1 || Index > SBN_UDP_FEC_MAX_GROUP)
+                                         : (Index >= SBN_UDP_FEC_MAX_GROUP || Len != DataSz || DataSz == 0)))
+    {
+        Cnts[NetNum].ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    Slot = FindDecSlot(Dec, Cnts, NetNum, ProcessorID, SpacecraftID, Flags & SBN_UDP_FEC_TO_GROUP, Group, NowMs);
+
+    if (!Slot)
+    {
+        if (Flags & SBN_UDP_FEC_PARITY)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        memcpy(DgramBuf, Msg + SBN_UDP_FEC_HDR_SZ, DataSz);
+        *DgramSzPtr = DataSz;
+
+        return SBN_SUCCESS;
+    } /* end if */
+
+    if (Flags & SBN_UDP_FEC_PARITY)
+    {
+        if (Slot->HaveParity || Slot->Done)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        if (Slot->GotCnt > Index || (Slot->Have >> Index))
+        {
+            /* datagrams beyond the parity's count */
+            Cnts[NetNum].ErrCnt++;
+            return SBN_ERROR;
+        } /* end if */
+
+        Slot->HaveParity = true;
+        Slot->Cnt        = Index;
+        Accumulate(Slot->Acc, &Slot->AccSz, Msg + SBN_UDP_FEC_HDR_SZ, DataSz);
+        Slot->LenX ^= Len;
+
+        if (!Complete(Slot, Cnts))
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        memcpy(DgramBuf, Slot->Acc, Slot->LenX);
+        *DgramSzPtr = Slot->LenX;
+
+        return SBN_SUCCESS;
+    } /* end if */
+
+    if (Slot->Have & (1 << Index))
+    {
+        Cnts[NetNum].DupCnt++;
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    if (Slot->HaveParity && Index >= Slot->Cnt)
+    {
+        Cnts[NetNum].ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    Slot->Have |= 1 << Index;
+    Slot->GotCnt++;
+
+    if (!Slot->Done)
+    {
+        Accumulate(Slot->Acc, &Slot->AccSz, Msg + SBN_UDP_FEC_HDR_SZ, DataSz);
+        Slot->LenX ^= Len;
+
+        /* the recovered datagram waits in the slot to be taken */
+        Slot->Pending = Complete(Slot, Cnts);
+    } /* end if */
+
+    memcpy(DgramBuf, Msg + SBN_UDP_FEC_HDR_SZ, DataSz);
+    *DgramSzPtr = DataSz;
+
+    return SBN_SUCCESS;
+} /* end SBN_UDP_FecDecode() */
+
+SBN_Status_t SBN_UDP_FecTakeRecovered(SBN_UDP_FecDec_t *Dec, uint8 NetNum, uint8 *DgramBuf, size_t *DgramSzPtr)
+{
+    int i = 0;
+
+    for (i = 0; i < SBN_UDP_FEC_DEC_SLOTS; i++)
+    {
+        SBN_UDP_FecDecSlot_t *Slot = &Dec->Slots[i];
+
+        if (Slot->Active && Slot->Pending && Slot->NetNum == NetNum)
+        {
+            Slot->Pending = false;
+            memcpy(DgramBuf, Slot->Acc, Slot->LenX);
+            *DgramSzPtr = Slot->LenX;
+
+            return SBN_SUCCESS;
+        } /* end if */
+    }     /* end for */
+
+    return SBN_IF_EMPTY;
+} /* end SBN_UDP_FecTakeRecovered() */
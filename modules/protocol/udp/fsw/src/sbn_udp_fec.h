@@ -0,0 +1,206 @@
+#ifndef _sbn_udp_fec_h_
+#define _sbn_udp_fec_h_
+
+/**
+ * With the "fec" net address option, each datagram the net sends (a whole
+ * packed message or a fragment) is wrapped in a packed SBN_UDP_FEC_MSG, and
+ * after every N of them to the same peer (or to the group) a parity datagram,
+ * the XOR of the N, follows. A receiver that gets all but one datagram of a
+ * group, parity included, recovers the missing one, so one loss in N + 1
+ * costs no round trip. The payload is:
+ *
+ * ```
+ * +----------+---------+---------+--------+-------------------------+
+ * | Group:16 | Index:8 | Flags:8 | Len:16 | datagram, or the parity |
+ * +----------+---------+---------+--------+-------------------------+
+ * ```
+ *
+ * All values are big-endian. Group numbers the groups a node sends to one
+ * peer, or to the group (flag SBN_UDP_FEC_TO_GROUP), Index numbers a datagram
+ * within its group and Len is its size. The parity (flag SBN_UDP_FEC_PARITY)
+ * has the number of datagrams in the group as its Index, the XOR of their
+ * sizes as its Len, and the XOR of the datagrams, each padded with zeros to
+ * the longest, as its data. A group that is slow to fill has its parity sent
+ * early, with fewer datagrams. Datagrams are delivered as they arrive and the
+ * recovered one when it is found; groups are collected in slots of a fixed
+ * pool (sized in sbn_udp_platform_cfg.h), and one not complete within
+ * SBN_UDP_FEC_TIMEOUT_MS is given up on.
+ * Receivers decode whether or not their own net has the option.
+ */
+
+#include "sbn_interfaces.h"
+#include "sbn_udp_platform_cfg.h"
+#include "cfe.h"
+
+#define SBN_UDP_FEC_HDR_SZ 6
+
+#define SBN_UDP_FEC_PARITY   0x01
+#define SBN_UDP_FEC_TO_GROUP 0x02
+
+/** @brief The largest "fec" option, the datagrams a parity datagram covers. */
+#define SBN_UDP_FEC_MAX_GROUP 16
+
+/** @brief The Dest of the group, after the net's peers. */
+#define SBN_UDP_FEC_GROUP_DEST SBN_MAX_PEER_CNT
+
+/** @brief A group started this long ago has its parity sent when the peer is next polled. */
+#define SBN_UDP_FEC_FLUSH_MS 100
+
+/** @brief How long a group may take to arrive. */
+#define SBN_UDP_FEC_TIMEOUT_MS 1000
+
+typedef struct
+{
+    /** @brief The XOR of the group's datagrams so far, AccSz bytes. */
+    uint8  Acc[SBN_UDP_FEC_MAX_DGRAM];
+    uint16 AccSz, LenX;
+
+    bool Active;
+
+    /** @brief The destination: the net (BufNum) and the peer's index in it, or SBN_UDP_FEC_GROUP_DEST. */
+    uint8 NetNum, Dest;
+
+    uint16 Group;
+    uint8  Cnt;
+
+    /** @brief When the group's first datagram was sent. */
+    uint32 StartMs;
+} SBN_UDP_FecEncSlot_t;
+
+typedef struct
+{
+    SBN_UDP_FecEncSlot_t Slots[SBN_UDP_FEC_ENC_SLOTS];
+
+    /** @brief The Group of the next group to each destination. */
+    uint16 NextGroup[SBN_MAX_NETS][SBN_MAX_PEER_CNT + 1];
+} SBN_UDP_FecEnc_t;
+
+typedef struct
+{
+    /** @brief The XOR of the datagrams received, parity included, and the recovered datagram. */
+    uint8  Acc[SBN_UDP_FEC_MAX_DGRAM];
+    uint16 AccSz, LenX;
+
+    /** @brief Done once all datagrams are in or one was recovered; Pending until the recovered one is taken. */
+    bool Active, Done, Pending, HaveParity;
+
+    /** @brief The group's key: the net (BufNum), sender, stream and its Group. */
+    uint8              NetNum;
+    CFE_ProcessorID_t  ProcessorID;
+    CFE_SpacecraftID_t SpacecraftID;
+    uint8              Flags;
+    uint16             Group;
+
+    /** @brief Datagrams in the group (from the parity), received, and a bit per Index received. */
+    uint8  Cnt, GotCnt;
+    uint16 Have;
+
+    /** @brief When the first of the group arrived. */
+    uint32 StartMs;
+} SBN_UDP_FecDecSlot_t;
+
+typedef struct
+{
+    SBN_UDP_FecDecSlot_t Slots[SBN_UDP_FEC_DEC_SLOTS];
+} SBN_UDP_FecDec_t;
+
+typedef struct
+{
+    /** @brief Datagrams and parity datagrams sent, and the bytes FEC added (headers and parity.) */
+    uint32 DataTxCnt, ParityTxCnt, OverheadBytes;
+
+    /** @brief Datagrams recovered, datagrams known lost and not recovered, duplicates dropped, bad FEC messages. */
+    uint32 RecoveredCnt, UnrecoveredCnt, DupCnt, ErrCnt;
+} SBN_UDP_FecCnt_t;
+
+/**
+ * Empties the pools.
+ *
+ * @param Enc[out] The sending pool, or NULL.
+ * @param Dec[out] The receiving pool, or NULL.
+ */
+void SBN_UDP_FecInit(SBN_UDP_FecEnc_t *Enc, SBN_UDP_FecDec_t *Dec);
+
+/**
+ * Adds a datagram to the group being sent to the destination, starting one
+ * if need be, and writes its header.
+ *
+ * @param Enc[in/out] The pool.
+ * @param Cnts[in/out] The counters of each net, by NetNum.
+ * @param NetNum[in] The net's BufNum.
+ * @param Dest[in] The peer's index in the net, or SBN_UDP_FEC_GROUP_DEST.
+ * @param GroupSz[in] The datagrams per parity, the "fec" option.
+ * @param Dgram[in] The datagram, at most SBN_UDP_FEC_MAX_DGRAM bytes.
+ * @param DgramSz[in] Its size.
+ * @param NowMs[in] The time, in milliseconds.
+ * @param Hdr[out] The datagram's header, SBN_UDP_FEC_HDR_SZ bytes.
+ *
+ * @return The group's slot if it is now full, for SBN_UDP_FecParity, or NULL.
+ */
+SBN_UDP_FecEncSlot_t *SBN_UDP_FecEncode(SBN_UDP_FecEnc_t *Enc, SBN_UDP_FecCnt_t Cnts[], uint8 NetNum, uint8 Dest,
+                                        uint8 GroupSz, const uint8 *Dgram, size_t DgramSz, uint32 NowMs, uint8 *Hdr);
+
+/**
+ * Finds the group being sent to the destination if it was started
+ * SBN_UDP_FEC_FLUSH_MS or more ago.
+ *
+ * @param Enc[in/out] The pool.
+ * @param NetNum[in] The net's BufNum.
+ * @param Dest[in] The peer's index in the net, or SBN_UDP_FEC_GROUP_DEST.
+ * @param NowMs[in] The time, in milliseconds.
+ *
+ * @return The group's slot, for SBN_UDP_FecParity, or NULL.
+ */
+SBN_UDP_FecEncSlot_t *SBN_UDP_FecFlush(SBN_UDP_FecEnc_t *Enc, uint8 NetNum, uint8 Dest, uint32 NowMs);
+
+/**
+ * Writes the payload of a group's parity datagram and frees its slot.
+ *
+ * @param Slot[in/out] The group's slot.
+ * @param Cnts[in/out] The counters of each net, by NetNum.
+ * @param Buf[out] SBN_UDP_FEC_HDR_SZ + Slot->AccSz bytes.
+ *
+ * @return The size of the payload.
+ */
+size_t SBN_UDP_FecParity(SBN_UDP_FecEncSlot_t *Slot, SBN_UDP_FecCnt_t Cnts[], uint8 *Buf);
+
+/**
+ * Takes in the payload of an SBN_UDP_FEC_MSG, first giving up on groups that
+ * have timed out.
+ *
+ * @param Dec[in/out] The pool.
+ * @param Cnts[in/out] The counters of each net, by NetNum.
+ * @param NetNum[in] The net it arrived on.
+ * @param ProcessorID[in] The sender.
+ * @param SpacecraftID[in] The sender.
+ * @param Msg[in] The payload.
+ * @param MsgSz[in] Its size.
+ * @param NowMs[in] The time, in milliseconds.
+ * @param DgramBuf[out] The datagram, SBN_UDP_FEC_MAX_DGRAM bytes.
+ * @param DgramSzPtr[out] Its size.
+ *
+ * @return SBN_SUCCESS with a datagram: the one received or, for a parity, the
+ *         one it recovered (a datagram that completes a recovery leaves the
+ *         recovered one for SBN_UDP_FecTakeRecovered, and one that finds
+ *         every slot holding a recovered datagram is passed on unprotected);
+ *         SBN_IF_EMPTY for a
+ *         duplicate or a parity that recovers nothing; SBN_ERROR for a bad
+ *         message.
+ */
+SBN_Status_t SBN_UDP_FecDecode(SBN_UDP_FecDec_t *Dec, SBN_UDP_FecCnt_t Cnts[], uint8 NetNum,
+                               CFE_ProcessorID_t ProcessorID, CFE_SpacecraftID_t SpacecraftID, const uint8 *Msg,
+                               size_t MsgSz, uint32 NowMs, uint8 *DgramBuf, size_t *DgramSzPtr);
+
+/**
+ * Takes a recovered datagram not yet delivered.
+ *
+ * @param Dec[in/out] The pool.
+ * @param NetNum[in] The net.
+ * @param DgramBuf[out] The datagram, SBN_UDP_FEC_MAX_DGRAM bytes.
+ * @param DgramSzPtr[out] Its size.
+ *
+ * @return SBN_SUCCESS with a datagram, SBN_IF_EMPTY if there is none.
+ */
+SBN_Status_t SBN_UDP_FecTakeRecovered(SBN_UDP_FecDec_t *Dec, uint8 NetNum, uint8 *DgramBuf, size_t *DgramSzPtr);
+
+#endif /* _sbn_udp_fec_h_ */
@@ -0,0 +1,168 @@
+#include "sbn_udp_frag.h"
+#include <string.h>
+
+size_t SBN_UDP_FragHdr(uint8 *Buf, uint16 Seq, uint16 Total, uint16 Offset, uint8 Index, uint8 Count)
+{
+    Buf[0] = Seq >> 8;
+    Buf[1] = Seq & 0xFF;
+    Buf[2] = Total >> 8;
+    Buf[3] = Total & 0xFF;
+    Buf[4] = Offset >> 8;
+    Buf[5] = Offset & 0xFF;
+    Buf[6] = Index;
+    Buf[7] = Count;
+
+    return SBN_UDP_FRAG_HDR_SZ;
+} /* end SBN_UDP_FragHdr() */
+
+void SBN_UDP_ReasmInit(SBN_UDP_Reasm_t *Reasm)
+{
+    int i = 0;
+
+    for (i = 0; i < SBN_UDP_REASM_SLOTS; i++)
+    {
+        Reasm->Slots[i].Active = false;
+    } /* end for */
+} /* end SBN_UDP_ReasmInit() */
+
+/**
+ * Finds the slot of the fragment's message, or takes one for it, expiring
+ * timed out messages on the way.
+ */
+static SBN_UDP_ReasmSlot_t *FindSlot(SBN_UDP_Reasm_t *Reasm, SBN_UDP_FragCnt_t Cnts[], uint8 NetNum,
+                                     CFE_ProcessorID_t ProcessorID, CFE_SpacecraftID_t SpacecraftID, uint16 Seq,
+                                     uint32 NowMs)
+{
+    SBN_UDP_ReasmSlot_t *Slot = NULL, *Free = NULL, *Oldest = NULL;
+    int                  i    = 0;
+
+    for (i = 0; i < SBN_UDP_REASM_SLOTS; i++)
+    {
+        Slot = &Reasm->Slots[i];
+
+        if (Slot->Active && NowMs - Slot->StartMs > SBN_UDP_REASM_TIMEOUT_MS)
+        {
+            Slot->Active = false;
+            Cnts[Slot->NetNum].DropCnt++;
+        } /* end if */
+
+        if (!Slot->Active)
+        {
+            Free = Free ? Free : Slot;
+            continue;
+        } /* end if */
+
+        if (Slot->NetNum == NetNum && Slot->ProcessorID == ProcessorID && Slot->SpacecraftID == SpacecraftID
+            && Slot->Seq == Seq)
+        {
+            return Slot;
+        } /* end if */
+
+        if (!Oldest || NowMs - Slot->StartMs > NowMs - Oldest->StartMs)
+        {
+            Oldest = Slot;
+        } /* end if */
+    }     /* end for */
+
+    if (!Free)
+    {
+        /* every slot is busy, the oldest message gives way */
+        Free = Oldest;
+        Cnts[Free->NetNum].DropCnt++;
+    } /* end if */
+
+    memset(Free->Have, 0, sizeof(Free->Have));
+    Free->Active       = true;
+    Free->NetNum       = NetNum;
+    Free->ProcessorID  = ProcessorID;
+    Free->SpacecraftID = SpacecraftID;
+    Free->Seq          = Seq;
+    Free->Total        = 0;
+    Free->Got          = 0;
+    Free->Count        = 0;
+    Free->GotCnt       = 0;
+    Free->StartMs      = NowMs;
+
+    return Free;
+} /* end FindSlot() */
+
+SBN_Status_t SBN_UDP_Reasm(SBN_UDP_Reasm_t *Reasm, SBN_UDP_FragCnt_t Cnts[], uint8 NetNum, CFE_ProcessorID_t ProcessorID,
+                           CFE_SpacecraftID_t SpacecraftID, const uint8 *Frag, size_t FragSz, uint32 NowMs,
+                           uint8 *MsgBuf, size_t *MsgSzPtr)
+{
+    SBN_UDP_FragCnt_t *  Cnt  = &Cnts[NetNum];
+    SBN_UDP_ReasmSlot_t *Slot = NULL;
+    uint16               Seq = 0, Total = 0, Offset = 0;
+    uint8                Index = 0, Count = 0;
+    size_t               DataSz = 0;
+
+    Cnt->FragRxCnt++;
+
+    if (FragSz <= SBN_UDP_FRAG_HDR_SZ)
+    {
+        Cnt->ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    Seq    = (Frag[0] << 8) | Frag[1];
+    Total  = (Frag[2] << 8) | Frag[3];
+    Offset = (Frag[4] << 8) | Frag[5];
+    Index  = Frag[6];
+    Count  = Frag[7];
+    DataSz = FragSz - SBN_UDP_FRAG_HDR_SZ;
+
+    if (Count == 0 || Count > SBN_UDP_MAX_FRAGS || Index >= Count || Total > SBN_MAX_PACKED_MSG_SZ
+        || Offset + DataSz > Total)
+    {
+        Cnt->ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    Slot = FindSlot(Reasm, Cnts, NetNum, ProcessorID, SpacecraftID, Seq, NowMs);
+
+    if (Slot->Count == 0)
+    {
+        Slot->Total = Total;
+        Slot->Count = Count;
+    }
+    else if (Total != Slot->Total || Count != Slot->Count)
+    {
+        /* not the message the slot holds, the sender's Seq has wrapped */
+        Slot->Active = false;
+        Cnt->DropCnt++;
+        Cnt->ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Slot->Have[Index / 32] & (1u << (Index % 32)))
+    {
+        return SBN_IF_EMPTY; /* a duplicate */
+    } /* end if */
+
+    memcpy(Slot->Buf + Offset, Frag + SBN_UDP_FRAG_HDR_SZ, DataSz);
+    Slot->Have[Index / 32] |= 1u << (Index % 32);
+    Slot->Got += DataSz;
+    Slot->GotCnt++;
+
+    if (Slot->GotCnt < Slot->Count)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    Slot->Active = false;
+
+    if (Slot->Got != Slot->Total)
+    {
+        /* the fragments do not tile the message */
+        Cnt->DropCnt++;
+        Cnt->ErrCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    Cnt->MsgRxCnt++;
+
+    memcpy(MsgBuf, Slot->Buf, Slot->Total);
+    *MsgSzPtr = Slot->Total;
+
+    return SBN_SUCCESS;
+} /* end SBN_UDP_Reasm() */
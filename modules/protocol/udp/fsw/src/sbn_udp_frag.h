@@ -0,0 +1,124 @@
+#ifndef _sbn_udp_frag_h_
+#define _sbn_udp_frag_h_
+
+/**
+ * With the "mtu" net address option, a packed message that would not fit in
+ * one datagram of the path MTU is split into fragments rather than left to IP
+ * fragmentation, where one lost IP fragment loses the whole datagram. Each
+ * fragment is its own datagram, a packed SBN_UDP_FRAG_MSG whose payload is:
+ *
+ * ```
+ * +--------+----------+-----------+---------+----------+------------------------+
+ * | Seq:16 | Total:16 | Offset:16 | Index:8 | Count:8  | fragment of packed msg |
+ * +--------+----------+-----------+---------+----------+------------------------+
+ * ```
+ *
+ * All values are big-endian. Seq numbers the fragmented messages a node
+ * sends on the net (to peers and group alike), Offset and Total locate the
+ * fragment within the packed message and Index of Count numbers it. UDP may
+ * lose, duplicate and reorder datagrams, so fragments are collected in slots
+ * of a fixed pool, one per message in progress, and a message still
+ * incomplete SBN_UDP_REASM_TIMEOUT_MS after its first fragment is dropped.
+ */
+
+#include "sbn_interfaces.h"
+#include "cfe.h"
+
+/** @brief Seq, Total, Offset, Index, Count; a packed message's size fits in 16 bits as SBN_MsgSz_t does. */
+#define SBN_UDP_FRAG_HDR_SZ 8
+
+/**
+ * @brief The most fragments a message is split into, enough for the largest
+ * at an MTU of SBN_UDP_MIN_MTU, with FEC's wrapping (see sbn_udp_fec.h.)
+ */
+#define SBN_UDP_MAX_FRAGS 72
+
+/** @brief How many messages, over all nets and peers, may be in reassembly at once. */
+#define SBN_UDP_REASM_SLOTS 8
+
+/** @brief How long a message may take to arrive in full. */
+#define SBN_UDP_REASM_TIMEOUT_MS 1000
+
+typedef struct
+{
+    /** @brief The packed message being reassembled. */
+    uint8 Buf[SBN_MAX_PACKED_MSG_SZ];
+
+    bool Active;
+
+    /** @brief The message's key: the net (BufNum), sender, and its Seq. */
+    uint8              NetNum;
+    CFE_ProcessorID_t  ProcessorID;
+    CFE_SpacecraftID_t SpacecraftID;
+    uint16             Seq;
+
+    uint16 Total;
+    uint32 Got;
+    uint8  Count, GotCnt;
+
+    /** @brief A bit per fragment index received. */
+    uint32 Have[(SBN_UDP_MAX_FRAGS + 31) / 32];
+
+    /** @brief When the first fragment arrived. */
+    uint32 StartMs;
+} SBN_UDP_ReasmSlot_t;
+
+typedef struct
+{
+    SBN_UDP_ReasmSlot_t Slots[SBN_UDP_REASM_SLOTS];
+} SBN_UDP_Reasm_t;
+
+typedef struct
+{
+    /** @brief Fragments sent, and messages sent in fragments. */
+    uint32 FragTxCnt, MsgTxCnt;
+
+    /** @brief Fragments received, messages reassembled, messages dropped incomplete, bad fragments. */
+    uint32 FragRxCnt, MsgRxCnt, DropCnt, ErrCnt;
+} SBN_UDP_FragCnt_t;
+
+/**
+ * Writes a fragment header.
+ *
+ * @param Buf[out] The buffer, at least SBN_UDP_FRAG_HDR_SZ bytes.
+ * @param Seq[in] The sequence number of the message.
+ * @param Total[in] The size of the packed message.
+ * @param Offset[in] The offset of this fragment within the packed message.
+ * @param Index[in] The number of this fragment.
+ * @param Count[in] The number of fragments of the message.
+ *
+ * @return SBN_UDP_FRAG_HDR_SZ
+ */
+size_t SBN_UDP_FragHdr(uint8 *Buf, uint16 Seq, uint16 Total, uint16 Offset, uint8 Index, uint8 Count);
+
+/**
+ * Empties all slots of the pool.
+ *
+ * @param Reasm[out] The pool.
+ */
+void SBN_UDP_ReasmInit(SBN_UDP_Reasm_t *Reasm);
+
+/**
+ * Adds a received fragment to its message, first dropping any message that
+ * has timed out. A new message takes a free slot, or the oldest one.
+ *
+ * @param Reasm[in/out] The pool.
+ * @param Cnts[in/out] The counters of each net, by NetNum.
+ * @param NetNum[in] The net the fragment arrived on.
+ * @param ProcessorID[in] The sender.
+ * @param SpacecraftID[in] The sender.
+ * @param Frag[in] The fragment, header and data.
+ * @param FragSz[in] The size of the fragment.
+ * @param NowMs[in] The time, in milliseconds, for timeouts.
+ * @param MsgBuf[out] The packed message when complete, SBN_MAX_PACKED_MSG_SZ bytes.
+ * @param MsgSzPtr[out] Set to the size of the packed message when complete.
+ *
+ * @return SBN_SUCCESS when a message is complete, SBN_IF_EMPTY when more
+ *         fragments are needed (or this one was a duplicate), SBN_ERROR if
+ *         the fragment was discarded.
+ */
+SBN_Status_t SBN_UDP_Reasm(SBN_UDP_Reasm_t *Reasm, SBN_UDP_FragCnt_t Cnts[], uint8 NetNum, CFE_ProcessorID_t ProcessorID,
+                           CFE_SpacecraftID_t SpacecraftID, const uint8 *Frag, size_t FragSz, uint32 NowMs,
+                           uint8 *MsgBuf, size_t *MsgSzPtr);
+
+#endif /* _sbn_udp_frag_h_ */
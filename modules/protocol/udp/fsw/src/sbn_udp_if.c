@@ -3,16 +3,87 @@
 #include "sbn_platform_cfg.h"
 #include <string.h>
 #include <errno.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <linux/filter.h>
+#include <linux/sock_diag.h>
 
 #include "sbn_interfaces.h"
 #include "cfe.h"
 
+/* workaround until OSAL exposes socket options */
+#include "os-impl-io.h"
+
+#define SBN_MODULE_NATIVE_FD
+#include "sbn_module_util.h"
+
 CFE_EVS_EventID_t SBN_UDP_FIRST_EID;
 
 #define EXP_VERSION 6
 
+#if SBN_MAX_PEER_CNT > 32
+#error "SBN_UDP_Fanout_t Pending holds a bit per peer"
+#endif
+
 static SBN_ProtocolOutlet_t SBN;
 
+typedef struct
+{
+    SBN_UDP_Fanout_t Sent[SBN_UDP_FANOUT_DEPTH];
+    uint8            Next;
+
+    uint32 GroupTxCnt, CopyDropCnt, RxForeignCnt;
+
+    /** @brief See SBN_UDP_MIN_MTU. */
+    uint16 Mtu;
+} SBN_UDP_Group_t;
+
+/* send tasks of a net's peers fan out to its group in turn */
+static SBN_UDP_Group_t Groups[SBN_MAX_NETS];
+static uint32          GroupMutex   = 0;
+static uint8           NetCnt       = 0;
+static uint8           LoadedNetCnt = 0;
+
+typedef struct
+{
+    /** @brief Shard 0 is the net's Socket, which sends for all shards. */
+    uint32 Socket[SBN_MAX_RECV_SHARDS];
+
+    uint32 RxCnt[SBN_MAX_RECV_SHARDS];
+} SBN_UDP_Shards_t;
+
+static SBN_UDP_Shards_t Shards[SBN_MAX_NETS];
+
+static SBN_UDP_SockOpts_t SockOpts[SBN_MAX_NETS];
+
+/* messages from all nets are reassembled in the one pool, shard tasks take turns */
+static SBN_UDP_Reasm_t   Reasm;
+static uint32            ReasmMutex = 0;
+static SBN_UDP_FragCnt_t FragCnts[SBN_MAX_NETS];
+
+/* messages awaiting acks, for all nets; sends and receive tasks take turns */
+static SBN_UDP_RelPool_t RelPool;
+static uint32            RelMutex = 0;
+static SBN_UDP_RelPeer_t RelPeers[SBN_MAX_NETS][SBN_MAX_PEER_CNT];
+
+/* groups being sent and received, for all nets; sends, polls and receive tasks take turns */
+static SBN_UDP_FecEnc_t FecEnc;
+static SBN_UDP_FecDec_t FecDec;
+static uint32           FecMutex = 0;
+static SBN_UDP_FecCnt_t FecCnts[SBN_MAX_NETS];
+
+static uint32 NowMs(void)
+{
+    OS_time_t Now;
+
+    OS_GetLocalTime(&Now);
+
+    return OS_TimeGetTotalMilliseconds(Now);
+} /* end NowMs() */
+
 static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID, SBN_ProtocolOutlet_t *Outlet)
 {
     SBN_UDP_FIRST_EID = BaseEID;
@@ -32,10 +103,327 @@ static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID, SBN_ProtocolOut
     /* copy outlet pointers to a local buffer for later use */
     memcpy(&SBN, Outlet, sizeof(SBN));
 
+    if (OS_MutSemCreate(&GroupMutex, "sbn_udp_group", 0) != OS_SUCCESS)
+    {
+        OS_printf("SBN_UDP unable to create group mutex\n");
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN_UDP_ReasmInit(&Reasm);
+
+    if (OS_MutSemCreate(&ReasmMutex, "sbn_udp_reasm", 0) != OS_SUCCESS)
+    {
+        OS_printf("SBN_UDP unable to create reassembly mutex\n");
+        return SBN_ERROR;
+    } /* end if */
+
+    /* peers tell a restart of mine by the epoch, so it differs from run to run */
+    SBN_UDP_RelInit(&RelPool, NowMs() ^ CFE_PSP_GetProcessorId());
+
+    if (OS_MutSemCreate(&RelMutex, "sbn_udp_rel", 0) != OS_SUCCESS)
+    {
+        OS_printf("SBN_UDP unable to create reliable delivery mutex\n");
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN_UDP_FecInit(&FecEnc, &FecDec);
+
+    if (OS_MutSemCreate(&FecMutex, "sbn_udp_fec", 0) != OS_SUCCESS)
+    {
+        OS_printf("SBN_UDP unable to create FEC mutex\n");
+        return SBN_ERROR;
+    } /* end if */
+
     OS_printf("SBN_UDP Lib Initialized.\n");
     return SBN_SUCCESS;
 } /* end Init() */
 
+/**
+ * Parses an option value of SBN_StrToSz() form.
+ *
+ * @return true if Val is a number, with its suffix, of at most Max.
+ */
+static bool ConfNum(const char *Val, unsigned long Max, unsigned long *NumPtr)
+{
+    char *ValidatePtr = NULL;
+
+    *NumPtr = SBN_StrToSz(Val, &ValidatePtr);
+
+    return ValidatePtr != Val && *ValidatePtr == '\0' && *NumPtr <= Max;
+} /* end ConfNum() */
+
+/**
+ * Sets a socket buffer size, with the FORCE variant if SBN has CAP_NET_ADMIN
+ * and so is not held to the net.core *mem_max sysctls.
+ *
+ * @return The size the kernel settled on, which it doubles for its overhead.
+ */
+static int SetSockBuf(int Fd, int Opt, int ForceOpt, int Sz, const char *Name)
+{
+    int       Actual = 0;
+    socklen_t Len    = sizeof(Actual);
+
+    if (setsockopt(Fd, SOL_SOCKET, ForceOpt, &Sz, sizeof(Sz)) < 0
+        && setsockopt(Fd, SOL_SOCKET, Opt, &Sz, sizeof(Sz)) < 0)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to set %s (errno=%d)", Name, errno);
+    } /* end if */
+
+    getsockopt(Fd, SOL_SOCKET, Opt, &Actual, &Len);
+
+    if (Actual / 2 < Sz)
+    {
+        EVSSendInfo(SBN_UDP_SOCK_EID, "%s limited to %d of %d bytes by the kernel", Name, Actual / 2, Sz);
+    } /* end if */
+
+    return Actual;
+} /* end SetSockBuf() */
+
+/**
+ * Applies the net address's socket tuning to a socket of the net. A failure
+ * is reported but not fatal, the socket works with the kernel's defaults.
+ *
+ * @param Sock[in] The options, see SBN_UDP_SockOpts_t.
+ * @param Socket[in] The OSAL socket.
+ */
+static void SetSockOpts(SBN_UDP_SockOpts_t *Sock, uint32 Socket)
+{
+    int Fd = -1, Val = 0;
+
+    if (!Sock->RcvBuf && !Sock->SndBuf && !Sock->BusyPoll && !Sock->TOS && !Sock->Prio)
+    {
+        return;
+    } /* end if */
+
+    if ((Fd = SBN_NativeFd(Socket, SBN_UDP_SOCK_EID)) < 0)
+    {
+        return;
+    } /* end if */
+
+    if (Sock->RcvBuf)
+    {
+        SetSockBuf(Fd, SO_RCVBUF, SO_RCVBUFFORCE, Sock->RcvBuf, "rcvbuf");
+    } /* end if */
+
+    if (Sock->SndBuf)
+    {
+        SetSockBuf(Fd, SO_SNDBUF, SO_SNDBUFFORCE, Sock->SndBuf, "sndbuf");
+    } /* end if */
+
+#ifdef SO_BUSY_POLL
+    Val = Sock->BusyPoll;
+    if (Val && setsockopt(Fd, SOL_SOCKET, SO_BUSY_POLL, &Val, sizeof(Val)) < 0)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to set busy_poll (errno=%d)", errno);
+    } /* end if */
+#endif /* SO_BUSY_POLL */
+
+    Val = Sock->TOS;
+    if (Val && setsockopt(Fd, IPPROTO_IP, IP_TOS, &Val, sizeof(Val)) < 0)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to set tos (errno=%d)", errno);
+    } /* end if */
+
+    Val = Sock->Prio;
+    if (Val && setsockopt(Fd, SOL_SOCKET, SO_PRIORITY, &Val, sizeof(Val)) < 0)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to set prio (errno=%d)", errno);
+    } /* end if */
+} /* end SetSockOpts() */
+
+/**
+ * Reads back a socket's buffer sizes and the count of datagrams the kernel
+ * dropped for want of room in its receive queue. That is the count
+ * SO_RXQ_OVFL attaches to each datagram, but OSAL receives without the
+ * control messages, so it is read with SO_MEMINFO instead.
+ *
+ * @param Socket[in] The OSAL socket.
+ * @param MemInfo[out] Receive and send buffer sizes, and the drop count; all 0 if unknown.
+ */
+static void GetSockMemInfo(uint32 Socket, uint32 MemInfo[3])
+{
+    memset(MemInfo, 0, 3 * sizeof(uint32));
+
+#ifdef SO_MEMINFO
+    uint32    Mem[SK_MEMINFO_VARS];
+    socklen_t Len = sizeof(Mem);
+    int       Fd  = -1;
+
+    if ((Fd = SBN_NativeFd(Socket, SBN_UDP_SOCK_EID)) >= 0 && getsockopt(Fd, SOL_SOCKET, SO_MEMINFO, Mem, &Len) == 0)
+    {
+        MemInfo[0] = Mem[SK_MEMINFO_RCVBUF];
+        MemInfo[1] = Mem[SK_MEMINFO_SNDBUF];
+        MemInfo[2] = Mem[SK_MEMINFO_DROPS];
+    } /* end if */
+#endif /* SO_MEMINFO */
+} /* end GetSockMemInfo() */
+
+/**
+ * Asks the kernel for the path MTU to an address, from the route to it and
+ * what ICMP has since reported. Only a connected socket is told, so a
+ * throwaway one is connected to the address.
+ *
+ * @param Addr[in] The peer or group address.
+ * @return The path MTU, SBN_UDP_MIN_MTU if unknown.
+ */
+static uint16 ProbeMtu(OS_SockAddr_t *Addr)
+{
+    struct sockaddr_in SockAddr;
+    char               Host[INET_ADDRSTRLEN];
+    uint16             Port = 0;
+    int                Fd = -1, Mtu = 0;
+    socklen_t          Len = sizeof(Mtu);
+
+    memset(&SockAddr, 0, sizeof(SockAddr));
+    SockAddr.sin_family = AF_INET;
+
+    if (OS_SocketAddrToString(Host, sizeof(Host), Addr) != OS_SUCCESS
+        || OS_SocketAddrGetPort(&Port, Addr) != OS_SUCCESS || inet_pton(AF_INET, Host, &SockAddr.sin_addr) != 1)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to find path MTU, address unknown");
+        return SBN_UDP_MIN_MTU;
+    } /* end if */
+
+    SockAddr.sin_port = htons(Port);
+
+    if ((Fd = socket(AF_INET, SOCK_DGRAM, 0)) < 0 || connect(Fd, (struct sockaddr *)&SockAddr, sizeof(SockAddr)) < 0
+        || getsockopt(Fd, IPPROTO_IP, IP_MTU, &Mtu, &Len) < 0 || Mtu < SBN_UDP_MIN_MTU)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to find path MTU to %s (errno=%d)", Host, errno);
+        Mtu = SBN_UDP_MIN_MTU;
+    } /* end if */
+
+    if (Fd >= 0)
+    {
+        close(Fd);
+    } /* end if */
+
+    EVSSendInfo(SBN_UDP_SOCK_EID, "path MTU to %s is %d", Host, Mtu);
+
+    return Mtu > 0xFFFF ? 0xFFFF : Mtu;
+} /* end ProbeMtu() */
+
+/**
+ * Joins the net's group and sets the TTL (and interface) of what is sent to
+ * it.
+ *
+ * @param NetData[in] The net, with its socket bound.
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise
+ */
+static SBN_Status_t JoinGroup(SBN_UDP_Net_t *NetData)
+{
+    struct ip_mreq Mreq;
+    unsigned char  TTL = NetData->TTL;
+    int            Fd  = SBN_NativeFd(NetData->Socket, SBN_UDP_SOCK_EID);
+
+    if (Fd < 0)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(&Mreq, 0, sizeof(Mreq));
+    Mreq.imr_multiaddr.s_addr = NetData->GroupIP;
+    Mreq.imr_interface.s_addr = NetData->IfIP;
+
+    if (setsockopt(Fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &Mreq, sizeof(Mreq)) < 0)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to join group (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (setsockopt(Fd, IPPROTO_IP, IP_MULTICAST_TTL, &TTL, sizeof(TTL)) < 0
+        || (NetData->IfIP != htonl(INADDR_ANY)
+            && setsockopt(Fd, IPPROTO_IP, IP_MULTICAST_IF, &Mreq.imr_interface, sizeof(Mreq.imr_interface)) < 0))
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to set group options (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    EVSSendInfo(SBN_UDP_SOCK_EID, "joined group (NetData=0x%lx)", (long unsigned int)NetData);
+
+    return SBN_SUCCESS;
+} /* end JoinGroup() */
+
+/**
+ * Opens a socket for the net and binds it to the local address, a shard of
+ * the net's port if the net is sharded.
+ *
+ * @param NetData[in] The net.
+ * @param SocketPtr[out] The socket.
+ * @param LocalAddr[in] The address to bind to.
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise
+ */
+static SBN_Status_t OpenSocket(SBN_UDP_Net_t *NetData, uint32 *SocketPtr, OS_SockAddr_t *LocalAddr)
+{
+    int On = 1, Fd = -1;
+
+    EVSSendInfo(SBN_UDP_SOCK_EID, "creating socket (NetData=0x%lx)", (long unsigned int)NetData);
+
+    if (OS_SocketOpen(SocketPtr, OS_SocketDomain_INET, OS_SocketType_DATAGRAM) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "socket open call failed");
+        return SBN_ERROR;
+    } /* end if */
+
+    if (NetData->ShardCnt > 1
+        && ((Fd = SBN_NativeFd(*SocketPtr, SBN_UDP_SOCK_EID)) < 0
+            || setsockopt(Fd, SOL_SOCKET, SO_REUSEPORT, &On, sizeof(On)) < 0))
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "unable to share port between shards (errno=%d)", errno);
+        OS_close(*SocketPtr);
+        return SBN_ERROR;
+    } /* end if */
+
+    SetSockOpts(&SockOpts[NetData->BufNum], *SocketPtr);
+
+    if (NetData->PathMtu)
+    {
+        int PmtuDisc = IP_PMTUDISC_DO;
+
+        if ((Fd = SBN_NativeFd(*SocketPtr, SBN_UDP_SOCK_EID)) < 0
+            || setsockopt(Fd, IPPROTO_IP, IP_MTU_DISCOVER, &PmtuDisc, sizeof(PmtuDisc)) < 0)
+        {
+            EVSSendErr(SBN_UDP_SOCK_EID, "unable to set path MTU discovery (errno=%d)", errno);
+        } /* end if */
+    } /* end if */
+
+    if (OS_SocketBind(*SocketPtr, LocalAddr) != OS_SUCCESS)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "bind call failed (NetData=0x%lx, Socket=%d)", (long unsigned int)NetData,
+                   *SocketPtr);
+        return SBN_ERROR;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end OpenSocket() */
+
+/**
+ * Attaches the program that steers datagrams to the net's shards, see
+ * SBN_UDP_STEER_OFFSET; without it the kernel hashes the sender's address.
+ *
+ * @param NetData[in] The net, with all of its shards bound.
+ */
+static void SteerShards(SBN_UDP_Net_t *NetData)
+{
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+    struct sock_filter Code[] = {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, SBN_UDP_STEER_OFFSET),
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, NetData->ShardCnt),
+        BPF_STMT(BPF_RET | BPF_A, 0),
+    };
+    struct sock_fprog Prog = {sizeof(Code) / sizeof(Code[0]), Code};
+    int               Fd   = SBN_NativeFd(NetData->Socket, SBN_UDP_SOCK_EID);
+
+    if (Fd >= 0 && setsockopt(Fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &Prog, sizeof(Prog)) == 0)
+    {
+        EVSSendInfo(SBN_UDP_SOCK_EID, "%d shards steered by processor ID", NetData->ShardCnt);
+        return;
+    } /* end if */
+#endif
+
+    EVSSendInfo(SBN_UDP_SOCK_EID, "%d shards steered by sender address (errno=%d)", NetData->ShardCnt, errno);
+} /* end SteerShards() */
+
 /**
  * Initializes an UDP host.
  *
@@ -44,7 +432,9 @@ static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID, SBN_ProtocolOut
  */
 static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
 {
-    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+    SBN_UDP_Net_t *   NetData  = (SBN_UDP_Net_t *)Net->ModulePvt;
+    SBN_UDP_Shards_t *Shard    = &Shards[NetData->BufNum];
+    uint8             ShardIdx = 0;
 
     OS_SockAddr_t LOCAL_ADDR;
     uint16 Port;
@@ -53,21 +443,33 @@ static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
     OS_SocketAddrGetPort(&Port, &NetData->Addr);
     OS_SocketAddrSetPort(&LOCAL_ADDR, Port);
 
-    EVSSendInfo(SBN_UDP_SOCK_EID, "creating socket (NetData=0x%lx)", (long unsigned int)NetData);
+    /* shards join the port's SO_REUSEPORT group in order, so a steering index is a shard index */
+    do
+    {
+        if (OpenSocket(NetData, &Shard->Socket[ShardIdx], &LOCAL_ADDR) != SBN_SUCCESS)
+        {
+            return SBN_ERROR;
+        } /* end if */
+    } while (++ShardIdx < NetData->ShardCnt);
+
+    NetData->Socket = Shard->Socket[0];
 
-    if (OS_SocketOpen(&(NetData->Socket), OS_SocketDomain_INET, OS_SocketType_DATAGRAM) != OS_SUCCESS)
+    if (NetData->ShardCnt > 1)
     {
-        EVSSendErr(SBN_UDP_SOCK_EID, "socket open call failed");
-        return SBN_ERROR;
+        SteerShards(NetData);
     } /* end if */
 
-    if (OS_SocketBind(NetData->Socket, &LOCAL_ADDR) != OS_SUCCESS)
+    if (NetData->Multicast && JoinGroup(NetData) != SBN_SUCCESS)
     {
-        EVSSendErr(SBN_UDP_SOCK_EID, "bind call failed (NetData=0x%lx, Socket=%d)", (long unsigned int)NetData,
-                   NetData->Socket);
+        OS_close(NetData->Socket);
         return SBN_ERROR;
     } /* end if */
 
+    if (NetData->Multicast)
+    {
+        Groups[NetData->BufNum].Mtu = NetData->PathMtu ? ProbeMtu(&NetData->GroupAddr) : NetData->Mtu;
+    } /* end if */
+
     return SBN_SUCCESS;
 } /* end InitNet() */
 
@@ -80,6 +482,11 @@ static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
  */
 static SBN_Status_t InitPeer(SBN_PeerInterface_t *Peer)
 {
+    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+    SBN_UDP_Net_t * NetData  = (SBN_UDP_Net_t *)Peer->Net->ModulePvt;
+
+    PeerData->Mtu = NetData->PathMtu ? ProbeMtu(&PeerData->Addr) : NetData->Mtu;
+
     return SBN_SUCCESS;
 } /* end InitPeer() */
 
@@ -132,162 +539,935 @@ static SBN_Status_t ConfAddr(OS_SockAddr_t *Addr, const char *Address)
     return SBN_SUCCESS;
 } /* end ConfAddr() */
 
-static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
+/**
+ * Parses the net address options, e.g. "0.0.0.0:2234?group=239.1.1.1&ttl=2",
+ * into NetData and Sock; Addr must already be set.
+ *
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise
+ */
+static SBN_Status_t ConfOpts(SBN_UDP_Net_t *NetData, SBN_UDP_SockOpts_t *Sock, const char *Address)
 {
-    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+    const char *Opt = strchr(Address, '?');
 
-    EVSSendInfo(SBN_UDP_CONFIG_EID, "configuring net (NetData=0x%lx, Address=%s)", (long unsigned int)NetData, Address);
+    memset(Sock, 0, sizeof(*Sock));
 
-    SBN_Status_t Status = ConfAddr(&NetData->Addr, Address);
+    NetData->Multicast = false;
+    NetData->GroupIP   = 0;
+    NetData->IfIP      = htonl(INADDR_ANY);
+    NetData->TTL       = SBN_UDP_DEFAULT_MCAST_TTL;
+    NetData->ShardCnt  = 1;
+    NetData->Mtu       = 0;
+    NetData->PathMtu   = false;
+    NetData->RelWindow = 0;
+    NetData->FecGroup  = 0;
 
-    if (Status == SBN_SUCCESS)
+    while (Opt != NULL)
     {
-        EVSSendInfo(SBN_UDP_CONFIG_EID, "configured (NetData=0x%lx)", (long unsigned int)NetData);
-    } /* end if */
+        Opt++; /* skip the '?' or '&' */
 
-    return Status;
-} /* end LoadNet */
+        const char *   Eq  = strchr(Opt, '=');
+        const char *   End = strchr(Opt, '&');
+        char           Val[INET_ADDRSTRLEN];
+        struct in_addr In;
+        size_t         Len = 0, ValLen = 0;
+        unsigned long  Num = 0;
 
-static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
-{
-    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+        if (!Eq || (End && End < Eq))
+        {
+            EVSSendErr(SBN_UDP_CONFIG_EID, "invalid option (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
 
-    EVSSendInfo(SBN_UDP_CONFIG_EID, "configuring peer (SC=%d, CPU=%d, Address=%s)",
-        Peer->SpacecraftID,
-        Peer->ProcessorID,
-        Address);
+        Len    = Eq - Opt;
+        ValLen = End ? (size_t)(End - Eq - 1) : strlen(Eq + 1);
 
-    SBN_Status_t Status = ConfAddr(&PeerData->Addr, Address);
+        if (ValLen == 0 || ValLen >= sizeof(Val))
+        {
+            EVSSendErr(SBN_UDP_CONFIG_EID, "invalid option value (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
 
-    if (Status == SBN_SUCCESS)
-    {
-      EVSSendInfo(SBN_UDP_CONFIG_EID, "configured peer (SC=%d, CPU=%d, Address=%s)",
-          Peer->SpacecraftID,
-          Peer->ProcessorID,
-          Address);
-    } /* end if */
+        memcpy(Val, Eq + 1, ValLen);
+        Val[ValLen] = '\0';
 
-    return Status;
-} /* end LoadPeer() */
+        if (SBN_OPT_IS(Opt, Len, "group") && inet_pton(AF_INET, Val, &In) == 1 && IN_MULTICAST(ntohl(In.s_addr)))
+        {
+            uint16 Port = 0;
 
-static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
-{
-    OS_time_t CurrentTime;
-    OS_GetLocalTime(&CurrentTime);
+            OS_SocketAddrGetPort(&Port, &NetData->Addr);
 
-    EVSSendDbg(SBN_UDP_DEBUG_EID, "polling peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+            if (OS_SocketAddrInit(&NetData->GroupAddr, OS_SocketDomain_INET) != OS_SUCCESS
+                || OS_SocketAddrFromString(&NetData->GroupAddr, Val) != OS_SUCCESS
+                || OS_SocketAddrSetPort(&NetData->GroupAddr, Port) != OS_SUCCESS)
+            {
+                EVSSendErr(SBN_UDP_CONFIG_EID, "group addr set failed (%s)", Val);
+                return SBN_ERROR;
+            } /* end if */
 
-    if (Peer->Connected)
-    {
-        if (OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastRecv)) > SBN_UDP_PEER_TIMEOUT)
+            NetData->GroupIP   = In.s_addr;
+            NetData->Multicast = true;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "if") && inet_pton(AF_INET, Val, &In) == 1)
         {
-            EVSSendInfo(SBN_UDP_DEBUG_EID, "disconnected peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+            NetData->IfIP = In.s_addr;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "ttl"))
+        {
+            char *        ValidatePtr = NULL;
+            unsigned long TTL         = strtoul(Val, &ValidatePtr, 0);
 
-            SBN.Disconnected(Peer);
-            return SBN_SUCCESS;
-        } /* end if */
+            if (*ValidatePtr != '\0' || TTL < 1 || TTL > 255)
+            {
+                EVSSendErr(SBN_UDP_CONFIG_EID, "unknown option or value out of range (%s)", Opt);
+                return SBN_ERROR;
+            } /* end if */
 
-        if (OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_UDP_PEER_HEARTBEAT)
-        {
-            OS_GetLocalTime(&Peer->LastSend);
-            EVSSendDbg(SBN_UDP_DEBUG_EID, "sending heartbeat to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
-            return SBN.SendNetMsg(SBN_UDP_HEARTBEAT_MSG, 0, NULL, Peer);
-        } /* end if */
-    }
-    else
-    {
-        if (Peer->ProcessorID != CFE_PSP_GetProcessorId() &&
-            Peer->SpacecraftID != CFE_PSP_GetSpacecraftId() &&
-            OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_UDP_ANNOUNCE_TIMEOUT)
+            NetData->TTL = TTL;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "shards"))
         {
-            OS_GetLocalTime(&Peer->LastSend);
-            EVSSendInfo(SBN_UDP_DEBUG_EID, "announce to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
-            return SBN.SendNetMsg(SBN_UDP_ANNOUNCE_MSG, 0, NULL, Peer);
-        } /* end if */
-    }     /* end if */
+            char *        ValidatePtr = NULL;
+            unsigned long ShardCnt    = strtoul(Val, &ValidatePtr, 0);
 
-    return SBN_SUCCESS;
-} /* end PollPeer() */
+            if (*ValidatePtr != '\0' || ShardCnt < 1 || ShardCnt > SBN_MAX_RECV_SHARDS)
+            {
+                EVSSendErr(SBN_UDP_CONFIG_EID, "unknown option or value out of range (%s)", Opt);
+                return SBN_ERROR;
+            } /* end if */
 
-static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
-{
-    int32 BufSz = MsgSz + SBN_PACKED_HDR_SZ, SentSz = 0;
-    uint8 Buf[BufSz];
+            NetData->ShardCnt = ShardCnt;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "mtu") && strcmp(Val, "path") == 0)
+        {
+            NetData->PathMtu = true;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "mtu") && ConfNum(Val, 0xFFFF, &Num) && Num >= SBN_UDP_MIN_MTU)
+        {
+            NetData->Mtu = Num;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "reliable") && ConfNum(Val, SBN_UDP_REL_MAX_WINDOW, &Num) && Num >= 1)
+        {
+            NetData->RelWindow = Num;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "fec") && ConfNum(Val, SBN_UDP_FEC_MAX_GROUP, &Num) && Num >= 1)
+        {
+            NetData->FecGroup = Num;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "rcvbuf") && ConfNum(Val, INT_MAX / 2, &Num))
+        {
+            Sock->RcvBuf = Num;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "sndbuf") && ConfNum(Val, INT_MAX / 2, &Num))
+        {
+            Sock->SndBuf = Num;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "busy_poll") && ConfNum(Val, 0xFFFF, &Num))
+        {
+            Sock->BusyPoll = Num;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "tos") && ConfNum(Val, 0xFF, &Num))
+        {
+            Sock->TOS = Num;
+        }
+        else if (SBN_OPT_IS(Opt, Len, "prio") && ConfNum(Val, 0xFF, &Num))
+        {
+            Sock->Prio = Num;
+        }
+        else
+        {
+            EVSSendErr(SBN_UDP_CONFIG_EID, "unknown option or value out of range (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
 
-    SBN_UDP_Peer_t *    PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
-    SBN_NetInterface_t *Net      = Peer->Net;
-    SBN_UDP_Net_t *     NetData  = (SBN_UDP_Net_t *)Net->ModulePvt;
+        Opt = End;
+    } /* end while */
 
-    SBN.PackMsg(Buf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Payload);
+    if (NetData->Multicast && NetData->ShardCnt > 1)
+    {
+        EVSSendErr(SBN_UDP_CONFIG_EID, "a net with a group cannot be sharded (%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
 
-    OS_SockAddr_t Addr;
-    if (OS_SocketAddrInit(&Addr, OS_SocketDomain_INET) != OS_SUCCESS)
+    return SBN_SUCCESS;
+} /* end ConfOpts() */
+
+static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
+{
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+
+    EVSSendInfo(SBN_UDP_CONFIG_EID, "configuring net (NetData=0x%lx, Address=%s)", (long unsigned int)NetData, Address);
+
+    if (NetCnt >= SBN_MAX_NETS)
     {
-        EVSSendErr(SBN_UDP_SOCK_EID, "socket addr init failed");
+        EVSSendErr(SBN_UDP_CONFIG_EID, "too many nets (%d)", NetCnt);
         return SBN_ERROR;
     } /* end if */
 
-    SentSz = OS_SocketSendTo(NetData->Socket, Buf, BufSz, &PeerData->Addr);
+    SBN_Status_t Status = ConfAddr(&NetData->Addr, Address);
+
+    if (Status == SBN_SUCCESS)
+    {
+        /* the net's tables are the next free ones, claimed below */
+        Status = ConfOpts(NetData, &SockOpts[NetCnt], Address);
+    } /* end if */
+
+    if (Status == SBN_SUCCESS)
+    {
+        NetData->BufNum   = NetCnt++;
+        LoadedNetCnt++;
+        NetData->NextShard = 0;
+        memset(&Groups[NetData->BufNum], 0, sizeof(Groups[0]));
+        memset(&Shards[NetData->BufNum], 0, sizeof(Shards[0]));
+        memset(&FragCnts[NetData->BufNum], 0, sizeof(FragCnts[0]));
+        memset(RelPeers[NetData->BufNum], 0, sizeof(RelPeers[0]));
+        memset(&FecCnts[NetData->BufNum], 0, sizeof(FecCnts[0]));
+        NetData->FragSeq = 0;
+
+        Net->RecvShardCnt = NetData->ShardCnt;
+
+        EVSSendInfo(SBN_UDP_CONFIG_EID, "configured (NetData=0x%lx)", (long unsigned int)NetData);
+    } /* end if */
+
+    return Status;
+} /* end LoadNet */
+
+static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
+{
+    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+
+    EVSSendInfo(SBN_UDP_CONFIG_EID, "configuring peer (SC=%d, CPU=%d, Address=%s)",
+        Peer->SpacecraftID,
+        Peer->ProcessorID,
+        Address);
+
+    SBN_Status_t Status = ConfAddr(&PeerData->Addr, Address);
+
+    if (Status == SBN_SUCCESS)
+    {
+      EVSSendInfo(SBN_UDP_CONFIG_EID, "configured peer (SC=%d, CPU=%d, Address=%s)",
+          Peer->SpacecraftID,
+          Peer->ProcessorID,
+          Address);
+    } /* end if */
+
+    return Status;
+} /* end LoadPeer() */
+
+static SBN_UDP_RelPeer_t *GetRel(SBN_PeerInterface_t *Peer)
+{
+    return &RelPeers[((SBN_UDP_Net_t *)Peer->Net->ModulePvt)->BufNum][Peer - Peer->Net->Peers];
+} /* end GetRel() */
+
+/**
+ * Gives up on the reliable messages to a peer that has gone, freeing their
+ * slots for other peers.
+ */
+static void ResetRel(SBN_PeerInterface_t *Peer)
+{
+    OS_MutSemTake(RelMutex);
+    SBN_UDP_RelReset(&RelPool, GetRel(Peer), ((SBN_UDP_Net_t *)Peer->Net->ModulePvt)->BufNum,
+                     Peer - Peer->Net->Peers);
+    OS_MutSemGive(RelMutex);
+} /* end ResetRel() */
+
+/**
+ * Resends the reliable messages to the peer whose timeout has passed, then
+ * sends the peer the ack owed to it, if a resend did not carry it. Acks owed
+ * by a receive task are sent from here, as receive tasks do not send.
+ */
+static void PollRel(SBN_PeerInterface_t *Peer)
+{
+    SBN_UDP_Net_t *    NetData = (SBN_UDP_Net_t *)Peer->Net->ModulePvt;
+    SBN_UDP_RelPeer_t *Rel     = GetRel(Peer);
+    SBN_UDP_RelSlot_t *Slot    = NULL;
+    SBN_MsgType_t      MsgType = SBN_UDP_REL_MSG;
+    SBN_MsgSz_t        MsgSz   = 0;
+    uint8              Buf[sizeof(Slot->Buf)];
+
+    do
+    {
+        /* the slot may be freed by an ack once the mutex is given, so send a copy */
+        OS_MutSemTake(RelMutex);
+
+        Slot  = SBN_UDP_RelDue(&RelPool, Rel, NetData->BufNum, Peer - Peer->Net->Peers, NowMs());
+        MsgSz = 0;
+
+        if (Slot)
+        {
+            MsgType = SBN_UDP_REL_MSG;
+            MsgSz   = Slot->Sz;
+            memcpy(Buf, Slot->Buf, MsgSz);
+        }
+        else if (Rel->AckOwed)
+        {
+            MsgType = SBN_UDP_ACK_MSG;
+            MsgSz   = SBN_UDP_RelPutAck(Rel, Buf);
+        } /* end if */
+
+        OS_MutSemGive(RelMutex);
+
+        if (MsgSz)
+        {
+            SBN.SendNetMsg(MsgType, MsgSz, Buf, Peer);
+        } /* end if */
+    } while (Slot);
+} /* end PollRel() */
+
+/**
+ * Packs a group's parity datagram and frees its slot, see sbn_udp_fec.h.
+ * Called with the FEC mutex taken.
+ *
+ * @param Slot[in/out] The group's slot.
+ * @param Buf[out] SBN_PACKED_HDR_SZ + SBN_UDP_FEC_HDR_SZ + Slot->AccSz bytes.
+ * @return The size of the packed parity datagram.
+ */
+static int32 PackParity(SBN_UDP_FecEncSlot_t *Slot, uint8 *Buf)
+{
+    SBN.PackMsg(Buf, SBN_UDP_FEC_HDR_SZ + Slot->AccSz, SBN_UDP_FEC_MSG, CFE_PSP_GetProcessorId(),
+                CFE_PSP_GetSpacecraftId(), NULL);
+
+    return SBN_PACKED_HDR_SZ + SBN_UDP_FecParity(Slot, FecCnts, Buf + SBN_PACKED_HDR_SZ);
+} /* end PackParity() */
+
+/**
+ * Sends the parity of a group to the address that has waited
+ * SBN_UDP_FEC_FLUSH_MS to fill, so that its datagrams are not left
+ * unprotected while traffic is slow.
+ *
+ * @param NetData[in] The net.
+ * @param Addr[in] The peer's or the group's address.
+ * @param Dest[in] The peer's index in the net, or SBN_UDP_FEC_GROUP_DEST.
+ */
+static void FlushFec(SBN_UDP_Net_t *NetData, OS_SockAddr_t *Addr, uint8 Dest)
+{
+    SBN_UDP_FecEncSlot_t *Slot     = NULL;
+    int32                 ParitySz = 0;
+
+    OS_MutSemTake(FecMutex);
+
+    Slot = SBN_UDP_FecFlush(&FecEnc, NetData->BufNum, Dest, NowMs());
+
+    uint8 Parity[Slot ? SBN_PACKED_HDR_SZ + SBN_UDP_FEC_HDR_SZ + Slot->AccSz : 1];
+
+    if (Slot)
+    {
+        ParitySz = PackParity(Slot, Parity);
+    } /* end if */
+
+    OS_MutSemGive(FecMutex);
+
+    if (ParitySz && OS_SocketSendTo(NetData->Socket, Parity, ParitySz, Addr) < ParitySz)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "incomplete parity send, tried to send %d bytes", (int)ParitySz);
+    } /* end if */
+} /* end FlushFec() */
+
+static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
+{
+    OS_time_t CurrentTime;
+    OS_GetLocalTime(&CurrentTime);
+
+    EVSSendMsgDbg(SBN_UDP_DEBUG_EID, "polling peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+
+    if (Peer->Connected)
+    {
+        if (OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastRecv)) > SBN_UDP_PEER_TIMEOUT)
+        {
+            EVSSendInfo(SBN_UDP_DEBUG_EID, "disconnected peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+
+            SBN.Disconnected(Peer);
+            ResetRel(Peer);
+            return SBN_SUCCESS;
+        } /* end if */
+
+        PollRel(Peer);
+
+        if (((SBN_UDP_Net_t *)Peer->Net->ModulePvt)->FecGroup)
+        {
+            SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Peer->Net->ModulePvt;
+
+            FlushFec(NetData, &((SBN_UDP_Peer_t *)Peer->ModulePvt)->Addr, Peer - Peer->Net->Peers);
+
+            if (NetData->Multicast)
+            {
+                FlushFec(NetData, &NetData->GroupAddr, SBN_UDP_FEC_GROUP_DEST);
+            } /* end if */
+        }     /* end if */
+
+        if (OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_UDP_PEER_HEARTBEAT)
+        {
+            SBN_UDP_RelPeer_t *Rel   = GetRel(Peer);
+            SBN_MsgSz_t        AckSz = 0;
+            uint8              Ack[SBN_UDP_ACK_SZ];
+
+            /* a heartbeat carries the ack to a peer sending reliably, in case the last was lost */
+            OS_MutSemTake(RelMutex);
+            if (Rel->RxValid)
+            {
+                AckSz = SBN_UDP_RelPutAck(Rel, Ack);
+            } /* end if */
+            OS_MutSemGive(RelMutex);
+
+            OS_GetLocalTime(&Peer->LastSend);
+            EVSSendMsgDbg(SBN_UDP_DEBUG_EID, "sending heartbeat to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+            return SBN.SendNetMsg(SBN_UDP_HEARTBEAT_MSG, AckSz, AckSz ? Ack : NULL, Peer);
+        } /* end if */
+    }
+    else
+    {
+        if (Peer->ProcessorID != CFE_PSP_GetProcessorId() &&
+            Peer->SpacecraftID != CFE_PSP_GetSpacecraftId() &&
+            OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_UDP_ANNOUNCE_TIMEOUT)
+        {
+            OS_GetLocalTime(&Peer->LastSend);
+            EVSSendInfo(SBN_UDP_DEBUG_EID, "announce to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+            return SBN.SendNetMsg(SBN_UDP_ANNOUNCE_MSG, 0, NULL, Peer);
+        } /* end if */
+    }     /* end if */
+
+    return SBN_SUCCESS;
+} /* end PollPeer() */
+
+/**
+ * Decides where an app message for a peer on a multicast net goes, see
+ * SBN_UDP_FANOUT_DEPTH. The peers' send tasks take turns with the group.
+ *
+ * @param Peer[in] The peer whose pipe the message was read from.
+ * @param Payload[in] The SB message, past any send time.
+ * @param MsgSz[in] The size of the message.
+ * @param ToGroupPtr[out] Set if other connected peers subscribe to the message.
+ *
+ * @return SBN_IF_EMPTY if the message has already been sent to the group for
+ *         this peer, SBN_SUCCESS otherwise.
+ */
+static SBN_Status_t Fanout(SBN_PeerInterface_t *Peer, void *Payload, SBN_MsgSz_t MsgSz, bool *ToGroupPtr)
+{
+    SBN_NetInterface_t *    Net     = Peer->Net;
+    SBN_UDP_Group_t *       Group   = &Groups[((SBN_UDP_Net_t *)Net->ModulePvt)->BufNum];
+    uint32                  PeerBit = 1UL << (Peer - Net->Peers), Subscribers = 0;
+    CFE_SB_MsgId_t          MsgID   = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_SequenceCount_t Seq     = 0;
+    SBN_PeerIdx_t           PeerIdx = 0;
+    int                     SentIdx = 0, SubIdx = 0;
+
+    *ToGroupPtr = false;
+
+    if (CFE_MSG_GetMsgId(Payload, &MsgID) != CFE_SUCCESS || CFE_MSG_GetSequenceCount(Payload, &Seq) != CFE_SUCCESS)
+    {
+        return SBN_SUCCESS; /* sent to the peer alone */
+    } /* end if */
+
+    OS_MutSemTake(GroupMutex);
+
+    for (SentIdx = 0; SentIdx < SBN_UDP_FANOUT_DEPTH; SentIdx++)
+    {
+        SBN_UDP_Fanout_t *Sent = &Group->Sent[SentIdx];
+
+        if ((Sent->Pending & PeerBit) && Sent->Payload == Payload && CFE_SB_MsgId_Equal(Sent->MsgID, MsgID)
+            && Sent->Seq == Seq && Sent->MsgSz == MsgSz)
+        {
+            Sent->Pending &= ~PeerBit;
+            Group->CopyDropCnt++;
+            OS_MutSemGive(GroupMutex);
+            return SBN_IF_EMPTY;
+        } /* end if */
+    }     /* end for */
+
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        SBN_PeerInterface_t *Other = &Net->Peers[PeerIdx];
+
+        if (Other == Peer || !Other->Connected)
+        {
+            continue;
+        } /* end if */
+
+        for (SubIdx = 0; SubIdx < Other->SubCnt; SubIdx++)
+        {
+            if (CFE_SB_MsgId_Equal(Other->Subs[SubIdx].MsgID, MsgID))
+            {
+                /* a peer that wants the message reliably is sent its own copy */
+                if (!(((SBN_UDP_Net_t *)Net->ModulePvt)->RelWindow && Other->Subs[SubIdx].QoS.Reliability))
+                {
+                    Subscribers |= 1UL << PeerIdx;
+                } /* end if */
+                break;
+            } /* end if */
+        }     /* end for */
+    }         /* end for */
+
+    if (Subscribers)
+    {
+        SBN_UDP_Fanout_t *Sent = &Group->Sent[Group->Next];
+
+        Sent->Payload = Payload;
+        Sent->MsgID   = MsgID;
+        Sent->Seq     = Seq;
+        Sent->MsgSz   = MsgSz;
+        Sent->Pending = Subscribers;
+
+        Group->Next = (Group->Next + 1) % SBN_UDP_FANOUT_DEPTH;
+
+        *ToGroupPtr = true;
+    } /* end if */
+
+    OS_MutSemGive(GroupMutex);
+
+    return SBN_SUCCESS;
+} /* end Fanout() */
+
+/**
+ * The bytes the net adds to each datagram sent: the IP and UDP headers, and
+ * with the "fec" option, the SBN_UDP_FEC_MSG around it.
+ */
+static int32 DgramOverhead(SBN_UDP_Net_t *NetData)
+{
+    return SBN_UDP_IP_HDR_SZ + (NetData->FecGroup ? SBN_PACKED_HDR_SZ + SBN_UDP_FEC_HDR_SZ : 0);
+} /* end DgramOverhead() */
+
+/**
+ * Sends a datagram, with the "fec" option wrapped in an SBN_UDP_FEC_MSG and
+ * followed by its group's parity datagram if that fills the group (see
+ * sbn_udp_fec.h.)
+ *
+ * @param NetData[in] The net.
+ * @param Addr[in] The peer's or the group's address.
+ * @param Dest[in] The peer's index in the net, or SBN_UDP_FEC_GROUP_DEST.
+ * @param Dgram[in] The datagram, a packed message or fragment.
+ * @param DgramSz[in] Its size.
+ * @return The size of the datagram sent, as OS_SocketSendTo.
+ */
+static int32 SendDgram(SBN_UDP_Net_t *NetData, OS_SockAddr_t *Addr, uint8 Dest, const uint8 *Dgram, int32 DgramSz)
+{
+    SBN_UDP_FecEncSlot_t *Slot     = NULL;
+    int32                 SentSz   = 0;
+    int32                 ParitySz = 0;
+
+    if (!NetData->FecGroup || DgramSz > SBN_UDP_FEC_MAX_DGRAM)
+    {
+        return OS_SocketSendTo(NetData->Socket, Dgram, DgramSz, Addr);
+    } /* end if */
+
+    uint8 Buf[SBN_PACKED_HDR_SZ + SBN_UDP_FEC_HDR_SZ + DgramSz];
+
+    SBN.PackMsg(Buf, SBN_UDP_FEC_HDR_SZ + DgramSz, SBN_UDP_FEC_MSG, CFE_PSP_GetProcessorId(),
+                CFE_PSP_GetSpacecraftId(), NULL);
+    memcpy(Buf + SBN_PACKED_HDR_SZ + SBN_UDP_FEC_HDR_SZ, Dgram, DgramSz);
+
+    OS_MutSemTake(FecMutex);
+
+    Slot = SBN_UDP_FecEncode(&FecEnc, FecCnts, NetData->BufNum, Dest, NetData->FecGroup, Dgram, DgramSz, NowMs(),
+                             Buf + SBN_PACKED_HDR_SZ);
+
+    uint8 Parity[Slot ? SBN_PACKED_HDR_SZ + SBN_UDP_FEC_HDR_SZ + Slot->AccSz : 1];
+
+    if (Slot)
+    {
+        ParitySz = PackParity(Slot, Parity);
+    } /* end if */
+
+    OS_MutSemGive(FecMutex);
+
+    SentSz = OS_SocketSendTo(NetData->Socket, Buf, sizeof(Buf), Addr);
+
+    if (ParitySz && OS_SocketSendTo(NetData->Socket, Parity, ParitySz, Addr) < ParitySz)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "incomplete parity send, tried to send %d bytes", (int)ParitySz);
+    } /* end if */
+
+    /* the caller knows the datagram, not its wrapping */
+    return SentSz < 0 ? SentSz : SentSz - (int32)(SBN_PACKED_HDR_SZ + SBN_UDP_FEC_HDR_SZ);
+} /* end SendDgram() */
+
+/**
+ * Sends a packed message in fragments that each fit the MTU, see
+ * sbn_udp_frag.h. Send tasks of the net's peers call this at once, so the
+ * message's number and the counts are taken and added atomically.
+ *
+ * @param NetData[in] The net.
+ * @param Addr[in] The peer's or the group's address.
+ * @param Dest[in] The peer's index in the net, or SBN_UDP_FEC_GROUP_DEST.
+ * @param PackedMsg[in] The packed message.
+ * @param BufSz[in] The size of the packed message.
+ * @param Mtu[in] The MTU to the address.
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise
+ */
+static SBN_Status_t SendFrags(SBN_UDP_Net_t *NetData, OS_SockAddr_t *Addr, uint8 Dest, uint8 *PackedMsg, int32 BufSz,
+                             uint16 Mtu)
+{
+    SBN_UDP_FragCnt_t *Cnt        = &FragCnts[NetData->BufNum];
+    int32              FragDataSz = Mtu - DgramOverhead(NetData) - SBN_PACKED_HDR_SZ - SBN_UDP_FRAG_HDR_SZ;
+    int32              Count      = (BufSz + FragDataSz - 1) / FragDataSz;
+    int32              Offset = 0, DataSz = 0, SentSz = 0;
+    uint16             Seq = __atomic_fetch_add(&NetData->FragSeq, 1, __ATOMIC_RELAXED);
+    uint8              Index = 0;
+
+    uint8 Buf[SBN_PACKED_HDR_SZ + SBN_UDP_FRAG_HDR_SZ + FragDataSz];
+
+    if (Count > SBN_UDP_MAX_FRAGS)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "message too large to fragment (%d bytes, MTU %d)", (int)BufSz, Mtu);
+        return SBN_ERROR;
+    } /* end if */
+
+    for (Offset = 0; Offset < BufSz; Offset += DataSz, Index++)
+    {
+        DataSz = BufSz - Offset < FragDataSz ? BufSz - Offset : FragDataSz;
+
+        SBN.PackMsg(Buf, SBN_UDP_FRAG_HDR_SZ + DataSz, SBN_UDP_FRAG_MSG, CFE_PSP_GetProcessorId(),
+                    CFE_PSP_GetSpacecraftId(), NULL);
+        SBN_UDP_FragHdr(Buf + SBN_PACKED_HDR_SZ, Seq, BufSz, Offset, Index, Count);
+        memcpy(Buf + SBN_PACKED_HDR_SZ + SBN_UDP_FRAG_HDR_SZ, PackedMsg + Offset, DataSz);
+
+        SentSz = SendDgram(NetData, Addr, Dest, Buf, SBN_PACKED_HDR_SZ + SBN_UDP_FRAG_HDR_SZ + DataSz);
+
+        if (SentSz < (int32)(SBN_PACKED_HDR_SZ + SBN_UDP_FRAG_HDR_SZ + DataSz))
+        {
+            EVSSendErr(SBN_UDP_SOCK_EID, "incomplete fragment send, tried to send %d bytes, returned %d",
+                       (int)(SBN_PACKED_HDR_SZ + SBN_UDP_FRAG_HDR_SZ + DataSz), (int)SentSz);
+            return SBN_ERROR;
+        } /* end if */
+
+        SBN_CNT_ADD(Cnt->FragTxCnt, 1);
+    } /* end for */
+
+    SBN_CNT_ADD(Cnt->MsgTxCnt, 1);
+
+    return SBN_SUCCESS;
+} /* end SendFrags() */
+
+/**
+ * Sends a packed message to the peer, or to the group, in fragments if it
+ * does not fit the MTU.
+ *
+ * @param Peer[in] The peer.
+ * @param ToGroup[in] Send to the peer's net's group rather than the peer.
+ * @param PackedMsg[in] The packed message.
+ * @param BufSz[in] The size of the packed message.
+ * @return SBN_SUCCESS on success, SBN_ERROR otherwise
+ */
+static SBN_Status_t SendTo(SBN_PeerInterface_t *Peer, bool ToGroup, void *PackedMsg, int32 BufSz)
+{
+    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)Peer->ModulePvt;
+    SBN_UDP_Net_t * NetData  = (SBN_UDP_Net_t *)Peer->Net->ModulePvt;
+    int32           SentSz   = 0;
+
+    OS_SockAddr_t *To   = ToGroup ? &NetData->GroupAddr : &PeerData->Addr;
+    uint16         Mtu  = ToGroup ? Groups[NetData->BufNum].Mtu : PeerData->Mtu;
+    uint8          Dest = ToGroup ? SBN_UDP_FEC_GROUP_DEST : Peer - Peer->Net->Peers;
+
+    if (Mtu && BufSz > Mtu - DgramOverhead(NetData))
+    {
+        SentSz = SendFrags(NetData, To, Dest, PackedMsg, BufSz, Mtu) == SBN_SUCCESS ? BufSz : -1;
+    }
+    else
+    {
+        SentSz = SendDgram(NetData, To, Dest, PackedMsg, BufSz);
+    } /* end if */
+
+    if (SentSz < BufSz && NetData->PathMtu && !ToGroup)
+    {
+        /* the kernel may know of a smaller path by now, try again in fragments if so */
+        PeerData->Mtu = ProbeMtu(&PeerData->Addr);
+
+        if (BufSz > PeerData->Mtu - DgramOverhead(NetData))
+        {
+            SentSz = SendFrags(NetData, To, Dest, PackedMsg, BufSz, PeerData->Mtu) == SBN_SUCCESS ? BufSz : -1;
+        } /* end if */
+    } /* end if */
 
     if (SentSz < BufSz)
     {
         EVSSendErr(SBN_UDP_SOCK_EID, "incomplete socket send, tried to send %d bytes, returned %d", (int)BufSz,
                    (int)SentSz);
         return SBN_ERROR;
-    }
-    else
+    } /* end if */
+
+    if (ToGroup)
+    {
+        Groups[NetData->BufNum].GroupTxCnt++;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end SendTo() */
+
+/**
+ * Does the peer want the app message delivered reliably? Only on a net with
+ * the "reliable" option, and if the peer asked for it when it subscribed.
+ */
+static bool IsReliable(SBN_PeerInterface_t *Peer, void *Payload)
+{
+    CFE_SB_MsgId_t MsgID  = CFE_SB_INVALID_MSG_ID;
+    int            SubIdx = 0;
+
+    if (!((SBN_UDP_Net_t *)Peer->Net->ModulePvt)->RelWindow || CFE_MSG_GetMsgId(Payload, &MsgID) != CFE_SUCCESS)
+    {
+        return false;
+    } /* end if */
+
+    for (SubIdx = 0; SubIdx < Peer->SubCnt; SubIdx++)
+    {
+        if (CFE_SB_MsgId_Equal(Peer->Subs[SubIdx].MsgID, MsgID))
+        {
+            return Peer->Subs[SubIdx].QoS.Reliability != 0;
+        } /* end if */
+    }     /* end for */
+
+    return false;
+} /* end IsReliable() */
+
+/**
+ * Sends an app message to the peer as an SBN_UDP_REL_MSG, keeping it to send
+ * again until the peer acknowledges it (see sbn_udp_rel.h.)
+ *
+ * @return SBN_SUCCESS on success, SBN_ERROR if the peer's window is full or
+ *         the send failed (the message is still resent.)
+ */
+static SBN_Status_t SendRel(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_UDP_Net_t *    NetData = (SBN_UDP_Net_t *)Peer->Net->ModulePvt;
+    SBN_UDP_RelSlot_t *Slot    = NULL;
+    SBN_Status_t       Status  = SBN_SUCCESS;
+    int32              BufSz   = SBN_PACKED_HDR_SZ + SBN_UDP_REL_HDR_SZ + MsgSz;
+
+    uint8 Buf[BufSz];
+
+    OS_MutSemTake(RelMutex);
+
+    Status = SBN_UDP_RelQueue(&RelPool, GetRel(Peer), NetData->BufNum, Peer - Peer->Net->Peers, NetData->RelWindow,
+                              MsgType, Payload, MsgSz, NowMs(), &Slot);
+
+    if (Status == SBN_SUCCESS)
+    {
+        SBN.PackMsg(Buf, Slot->Sz, SBN_UDP_REL_MSG, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Slot->Buf);
+    } /* end if */
+
+    OS_MutSemGive(RelMutex);
+
+    if (Status != SBN_SUCCESS)
+    {
+        EVSSendErr(SBN_UDP_SOCK_EID, "reliable window to peer %d:%d full, message dropped", Peer->SpacecraftID,
+                   Peer->ProcessorID);
+        return SBN_ERROR;
+    } /* end if */
+
+    return SendTo(Peer, false, Buf, BufSz);
+} /* end SendRel() */
+
+static SBN_Status_t SendPacked(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload,
+                               void *PackedMsg)
+{
+    bool ToGroup = false;
+
+    SBN_NetInterface_t *Net     = Peer->Net;
+    SBN_UDP_Net_t *     NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+
+    /* the SB message, past any sequence header and send time */
+    void *AppMsg = (uint8 *)Payload + SBN_APP_HDR_SZ(MsgType);
+
+    if (SBN_IS_APP_MSG(MsgType) && IsReliable(Peer, AppMsg))
+    {
+        if (MsgSz <= SBN_UDP_REL_MAX_MSG_SZ)
+        {
+            return SendRel(Peer, MsgType, MsgSz, Payload);
+        } /* end if */
+
+        /* too large for a slot, so it goes out as any other message would */
+        OS_MutSemTake(RelMutex);
+        GetRel(Peer)->OversizeCnt++;
+        OS_MutSemGive(RelMutex);
+
+        EVSSendErrLimited(SBN_UDP_SOCK_EID,
+                          "message of %d bytes to peer %d:%d too large to send reliably (max %d), sent unreliably",
+                          (int)MsgSz, Peer->SpacecraftID, Peer->ProcessorID, SBN_UDP_REL_MAX_MSG_SZ);
+    } /* end if */
+
+    /* one datagram to the group cannot carry each peer's sequence header */
+    if (NetData->Multicast && (MsgType == SBN_APP_MSG || MsgType == SBN_STAMP_APP_MSG)
+        && Fanout(Peer, AppMsg, MsgSz, &ToGroup) == SBN_IF_EMPTY)
+    {
+        return SBN_SUCCESS; /* the group has it */
+    } /* end if */
+
+    OS_SockAddr_t Addr;
+    if (OS_SocketAddrInit(&Addr, OS_SocketDomain_INET) != OS_SUCCESS)
     {
-        return SBN_SUCCESS;
+        EVSSendErr(SBN_UDP_SOCK_EID, "socket addr init failed");
+        return SBN_ERROR;
     } /* end if */
+
+    return SendTo(Peer, ToGroup, PackedMsg, MsgSz + SBN_PACKED_HDR_SZ);
+} /* end SendPacked() */
+
+static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    uint8 Buf[MsgSz + SBN_PACKED_HDR_SZ];
+
+    SBN.PackMsg(Buf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Payload);
+
+    return SendPacked(Peer, MsgType, MsgSz, Payload, Buf);
 } /* end Send() */
 
-/* Note that this Recv function is indescriminate, packets will be received
- * from all peers but that's ok, I just inject them into the SB and all is
- * good!
+/** @brief Is the peer's net received from by a receive task (or several) rather than polled? */
+static bool OnRecvTask(SBN_PeerInterface_t *Peer)
+{
+    SBN_NetInterface_t *Net   = Peer->Net;
+    uint8               Shard = 0;
+
+    for (Shard = 0; Shard < Net->RecvShardCnt; Shard++)
+    {
+        if (Net->ShardRecvTaskIDs[Shard])
+        {
+            return true;
+        } /* end if */
+    }     /* end for */
+
+    return Peer->RecvTaskID || Net->RecvTaskID;
+} /* end OnRecvTask() */
+
+/**
+ * Takes in a reliable message, an ack, or a heartbeat with an ack, from the
+ * peer (see sbn_udp_rel.h), and acks at once if that is called for; but on a
+ * receive task, which does not send, the ack is left owed for the next poll.
+ *
+ * @return SBN_SUCCESS with a reliable message's app message in Payload (and
+ *         its type in MsgType) or a heartbeat; SBN_IF_EMPTY for an ack or a
+ *         duplicate; SBN_ERROR for a bad message.
  */
-static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
-                         CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+static SBN_Status_t RecvRel(SBN_PeerInterface_t *Peer, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                            uint8 *Payload)
 {
-    uint8 RecvBuf[SBN_MAX_PACKED_MSG_SZ];
+    SBN_UDP_Net_t *    NetData = (SBN_UDP_Net_t *)Peer->Net->ModulePvt;
+    SBN_UDP_RelPeer_t *Rel     = GetRel(Peer);
+    uint8              PeerIdx = Peer - Peer->Net->Peers;
+    SBN_Status_t       Status  = SBN_SUCCESS;
+    bool               AckNow  = false;
+    bool               OnTask  = OnRecvTask(Peer);
+    uint8              Ack[SBN_UDP_ACK_SZ];
 
-    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+    OS_MutSemTake(RelMutex);
 
-    /* task-based peer connections block on reads, otherwise use select */
+    if (*MsgTypePtr == SBN_UDP_REL_MSG)
+    {
+        Status = SBN_UDP_RelRecv(&RelPool, Rel, NetData->BufNum, PeerIdx, Payload, *MsgSzPtr, NowMs(), &AckNow);
+    }
+    else
+    {
+        SBN_UDP_RelAck(&RelPool, Rel, NetData->BufNum, PeerIdx, Payload, NowMs());
+    } /* end if */
+
+    if (AckNow && OnTask)
+    {
+        /* a duplicate owes an ack too, though it is not counted */
+        Rel->AckOwed = Rel->AckOwed ? Rel->AckOwed : 1;
+        AckNow       = false;
+    }
+    else if (AckNow)
+    {
+        SBN_UDP_RelPutAck(Rel, Ack);
+    } /* end if */
 
-    uint32 StateFlags = OS_STREAM_STATE_READABLE;
+    OS_MutSemGive(RelMutex);
 
-    /* polling uses select, otherwise drop through to block on read for task */
-    if(!(Net->TaskFlags & SBN_TASK_RECV)
-        && (OS_SelectSingle(NetData->Socket, &StateFlags, 0) != OS_SUCCESS
-        || !(StateFlags & OS_STREAM_STATE_READABLE)))
+    if (AckNow)
+    {
+        SBN.SendNetMsg(SBN_UDP_ACK_MSG, SBN_UDP_ACK_SZ, Ack, Peer);
+    } /* end if */
+
+    if (*MsgTypePtr == SBN_UDP_ACK_MSG)
     {
-        /* nothing to receive */
         return SBN_IF_EMPTY;
-    }/* end if */
+    } /* end if */
+
+    if (*MsgTypePtr == SBN_UDP_REL_MSG && Status == SBN_SUCCESS)
+    {
+        *MsgSzPtr -= SBN_UDP_REL_HDR_SZ;
+        *MsgTypePtr = Payload[SBN_UDP_REL_TYPE_OFS];
+        memmove(Payload, Payload + SBN_UDP_REL_HDR_SZ, *MsgSzPtr);
+
+        if (!SBN_IS_APP_MSG(*MsgTypePtr))
+        {
+            Status = SBN_ERROR;
+        } /* end if */
+    } /* end if */
+
+    if (Status == SBN_ERROR)
+    {
+        EVSSendErrLimited(SBN_UDP_DEBUG_EID, "ERROR: bad reliable message from peer %d:%d", Peer->SpacecraftID,
+                          Peer->ProcessorID);
+    } /* end if */
 
-    int Received = OS_SocketRecvFrom(NetData->Socket, (char *)&RecvBuf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, NULL, OS_PEND);
+    return Status;
+} /* end RecvRel() */
 
-    if (Received < 0)
+/**
+ * Is a local app subscribed to an app message received on a group net? The
+ * group brings the messages for the other members' subscriptions too. One too
+ * short to look into is left to the core to refuse.
+ */
+static bool IsLocalSub(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, uint8 *Payload)
+{
+    CFE_SB_MsgId_t MsgID = CFE_SB_INVALID_MSG_ID;
+
+    if (MsgSz < SBN_APP_HDR_SZ(MsgType) + (SBN_MsgSz_t)sizeof(CFE_MSG_Message_t))
     {
-        EVSSendErr(SBN_UDP_DEBUG_EID, "ERROR: could not receive from socket: status=%d", Received);
-        return SBN_ERROR;
+        return true;
     } /* end if */
 
+    if (CFE_MSG_GetMsgId((CFE_MSG_Message_t *)(Payload + SBN_APP_HDR_SZ(MsgType)), &MsgID) != CFE_SUCCESS
+        || SBN.IsLocalSub(MsgID))
+    {
+        return true;
+    } /* end if */
+
+    EVSSendMsgDbg(SBN_UDP_DEBUG_EID, "no local subscription for MsgID 0x%04X, dropped", CFE_SB_MsgIdToValue(MsgID));
+
+    return false;
+} /* end IsLocalSub() */
+
+/**
+ * Handles a datagram received from one of the net's shards, or recovered by
+ * FEC: a whole packed message, a fragment or a wrapped datagram.
+ *
+ * @param RecvBuf[in] The datagram, SBN_MAX_PACKED_MSG_SZ bytes of buffer
+ *                    that is reused for what it carries.
+ *
+ * @return SBN_SUCCESS with a message to deliver, SBN_IF_EMPTY if there is
+ *         none (yet), or SBN_ERROR.
+ */
+static SBN_Status_t RecvDgram(SBN_NetInterface_t *Net, uint8 Shard, uint8 *RecvBuf, SBN_MsgType_t *MsgTypePtr,
+                              SBN_MsgSz_t *MsgSzPtr, CFE_ProcessorID_t *ProcessorIDPtr,
+                              CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+    size_t         DgramSz = 0;
+
     /* each UDP packet is a full SBN message */
 
-    if (SBN.UnpackMsg(&RecvBuf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload) == false)
+    if (SBN.UnpackMsg(RecvBuf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload) == false)
     {
-        EVSSendErr(SBN_UDP_DEBUG_EID, "ERROR: could not unpack message");
+        EVSSendErrLimited(SBN_UDP_DEBUG_EID, "ERROR: could not unpack message");
         return SBN_ERROR;
     } /* end if */
 
+    Shards[NetData->BufNum].RxCnt[Shard]++;
+
     SBN_PeerInterface_t *Peer = SBN.GetPeer(Net, *ProcessorIDPtr, *SpacecraftIDPtr);
+    if (Peer == NULL && NetData->Multicast)
+    {
+        /* my own group sends looped back, or members of the group I don't peer with */
+        Groups[NetData->BufNum].RxForeignCnt++;
+        return SBN_IF_EMPTY;
+    } /* end if */
+
     if (Peer == NULL)
     {
-        EVSSendErr(SBN_UDP_DEBUG_EID, "ERROR: unknown peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+        EVSSendErrLimited(SBN_UDP_DEBUG_EID, "ERROR: unknown peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
         return SBN_ERROR;
     } /* end if */
 
+    ((SBN_UDP_Peer_t *)Peer->ModulePvt)->Shard = Shard;
+
     if (!Peer->Connected)
     {
         EVSSendInfo(SBN_UDP_DEBUG_EID, "connecting to peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
@@ -295,15 +1475,174 @@ static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN
     }
     else
     {
-        EVSSendDbg(SBN_UDP_DEBUG_EID, "already connected to peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+        EVSSendMsgDbg(SBN_UDP_DEBUG_EID, "already connected to peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+    } /* end if */
+
+    if (*MsgTypePtr == SBN_UDP_FEC_MSG)
+    {
+        /* the FEC message is in Payload, RecvBuf is free for the datagram it carries or recovers */
+        OS_MutSemTake(FecMutex);
+        SBN_Status_t Status = SBN_UDP_FecDecode(&FecDec, FecCnts, NetData->BufNum, *ProcessorIDPtr,
+                                                *SpacecraftIDPtr, Payload, *MsgSzPtr, NowMs(), RecvBuf, &DgramSz);
+        OS_MutSemGive(FecMutex);
+
+        if (Status != SBN_SUCCESS)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        if (SBN.UnpackMsg(RecvBuf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload) == false
+            || *MsgTypePtr == SBN_UDP_FEC_MSG || *MsgSzPtr + SBN_PACKED_HDR_SZ > DgramSz)
+        {
+            EVSSendErr(SBN_UDP_DEBUG_EID, "ERROR: could not unpack FEC datagram");
+            return SBN_ERROR;
+        } /* end if */
+    } /* end if */
+
+    if (*MsgTypePtr == SBN_UDP_FRAG_MSG)
+    {
+        /* the fragment is in Payload, RecvBuf is free for the whole message */
+        size_t PackedSz = 0;
+
+        OS_MutSemTake(ReasmMutex);
+        SBN_Status_t Status = SBN_UDP_Reasm(&Reasm, FragCnts, NetData->BufNum, *ProcessorIDPtr, *SpacecraftIDPtr,
+                                            Payload, *MsgSzPtr, NowMs(), RecvBuf, &PackedSz);
+        OS_MutSemGive(ReasmMutex);
+
+        if (Status != SBN_SUCCESS)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        if (SBN.UnpackMsg(RecvBuf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload) == false
+            || *MsgTypePtr == SBN_UDP_FRAG_MSG)
+        {
+            EVSSendErr(SBN_UDP_DEBUG_EID, "ERROR: could not unpack reassembled message");
+            return SBN_ERROR;
+        } /* end if */
+    } /* end if */
+
+    if (NetData->Multicast && SBN_IS_APP_MSG(*MsgTypePtr) && !IsLocalSub(*MsgTypePtr, *MsgSzPtr, Payload))
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    if (*MsgTypePtr == SBN_UDP_REL_MSG || *MsgTypePtr == SBN_UDP_ACK_MSG
+        || (*MsgTypePtr == SBN_UDP_HEARTBEAT_MSG && *MsgSzPtr >= SBN_UDP_ACK_SZ))
+    {
+        if (*MsgTypePtr == SBN_UDP_ACK_MSG && *MsgSzPtr < SBN_UDP_ACK_SZ)
+        {
+            EVSSendErr(SBN_UDP_DEBUG_EID, "ERROR: short ack from peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+            return SBN_ERROR;
+        } /* end if */
+
+        return RecvRel(Peer, MsgTypePtr, MsgSzPtr, Payload);
     } /* end if */
 
     if (*MsgTypePtr == SBN_UDP_DISCONN_MSG)
     {
         SBN.Disconnected(Peer);
+        ResetRel(Peer);
     }
 
     return SBN_SUCCESS;
+} /* end RecvDgram() */
+
+/**
+ * Takes a datagram FEC recovered on the net and not yet delivered.
+ *
+ * @return SBN_SUCCESS with the datagram in RecvBuf, SBN_IF_EMPTY if there is none.
+ */
+static SBN_Status_t TakeRecovered(SBN_UDP_Net_t *NetData, uint8 *RecvBuf)
+{
+    SBN_Status_t Status  = SBN_IF_EMPTY;
+    size_t       DgramSz = 0;
+
+    OS_MutSemTake(FecMutex);
+    Status = SBN_UDP_FecTakeRecovered(&FecDec, NetData->BufNum, RecvBuf, &DgramSz);
+    OS_MutSemGive(FecMutex);
+
+    return Status;
+} /* end TakeRecovered() */
+
+/**
+ * Receives a message from one of the net's shards, blocking for it if the
+ * net has receive tasks. A datagram FEC recovered alongside the one read is
+ * delivered in the same call if that one is not, otherwise by the next call,
+ * before anything is read.
+ *
+ * Note that this is indescriminate, packets will be received from all peers
+ * but that's ok, I just inject them into the SB and all is good!
+ */
+static SBN_Status_t RecvShard(SBN_NetInterface_t *Net, uint8 Shard, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                              CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    uint8 RecvBuf[SBN_MAX_PACKED_MSG_SZ];
+
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+    uint32         Socket  = Shards[NetData->BufNum].Socket[Shard];
+    SBN_Status_t   Status  = SBN_IF_EMPTY;
+
+    if (TakeRecovered(NetData, RecvBuf) != SBN_SUCCESS)
+    {
+        /* task-based peer connections block on reads, otherwise use select */
+
+        uint32 StateFlags = OS_STREAM_STATE_READABLE;
+
+        /* polling uses select, otherwise drop through to block on read for task */
+        if(!(Net->TaskFlags & SBN_TASK_RECV)
+            && (OS_SelectSingle(Socket, &StateFlags, 0) != OS_SUCCESS
+            || !(StateFlags & OS_STREAM_STATE_READABLE)))
+        {
+            /* nothing to receive */
+            return SBN_IF_EMPTY;
+        }/* end if */
+
+        int Received = OS_SocketRecvFrom(Socket, (char *)&RecvBuf, sizeof(RecvBuf), NULL, OS_PEND);
+
+        if (Received < 0)
+        {
+            EVSSendErr(SBN_UDP_DEBUG_EID, "ERROR: could not receive from socket: status=%d", Received);
+            return SBN_ERROR;
+        } /* end if */
+
+        Status = RecvDgram(Net, Shard, RecvBuf, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, SpacecraftIDPtr, Payload);
+
+        if (Status != SBN_IF_EMPTY || TakeRecovered(NetData, RecvBuf) != SBN_SUCCESS)
+        {
+            return Status;
+        } /* end if */
+    } /* end if */
+
+    return RecvDgram(Net, Shard, RecvBuf, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, SpacecraftIDPtr, Payload);
+} /* end RecvShard() */
+
+/**
+ * Receives a message from the net. A sharded net whose shards are not each
+ * read by a task has them read in turn.
+ */
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                         CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+    SBN_Status_t   Status  = SBN_IF_EMPTY;
+    uint8          Tries   = 0;
+
+    if (NetData->ShardCnt <= 1)
+    {
+        return RecvShard(Net, 0, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, SpacecraftIDPtr, Payload);
+    } /* end if */
+
+    for (Tries = 0; Tries < NetData->ShardCnt && Status == SBN_IF_EMPTY; Tries++)
+    {
+        uint8 Shard = NetData->NextShard;
+
+        NetData->NextShard = (Shard + 1) % NetData->ShardCnt;
+
+        Status = RecvShard(Net, Shard, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, SpacecraftIDPtr, Payload);
+    } /* end for */
+
+    return Status;
 } /* end Recv() */
 
 static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
@@ -315,6 +1654,8 @@ static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
         SBN.Disconnected(Peer);
     } /* end if */
 
+    ResetRel(Peer);
+
     return SBN_SUCCESS;
 } /* end UnloadPeer() */
 
@@ -333,8 +1674,130 @@ static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
         }
     } /* end if */
 
+    /* shard 0 is the net's socket */
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)Net->ModulePvt;
+    uint8          Shard   = 0;
+    for (Shard = 1; Shard < NetData->ShardCnt; Shard++)
+    {
+        OS_close(Shards[NetData->BufNum].Socket[Shard]);
+    } /* end for */
+
+    /* the other nets' tables follow this one's, so they are only reused once all are unloaded */
+    if (LoadedNetCnt && --LoadedNetCnt == 0)
+    {
+        NetCnt = 0;
+    } /* end if */
+
     return Status;
 } /* end UnloadNet() */
 
-SBN_IfOps_t SBN_UDP_Ops = {Init, InitNet, InitPeer, LoadNet,   LoadPeer,  PollPeer,
-                           Send, NULL,    Recv,     UnloadNet, UnloadPeer};
+/**
+ * Reports, big-endian: uint8 Flags (1=multicast), then for the peer's net
+ * uint32 messages sent to the group, peer copies dropped as the group had
+ * them, and group messages received from myself or from non-peers; then
+ * uint8 the number of receive shards and the shard the peer's messages
+ * arrive on, and uint32 messages received on each shard; then uint32 the
+ * receive and send buffer sizes the kernel settled on (for shard 0, as set by
+ * the rcvbuf and sndbuf options), and the datagrams the kernel dropped on
+ * each shard for a full receive queue (see GetSockMemInfo().) Then uint16
+ * the peer's MTU (0 if not fragmenting), and for the net uint32 fragments
+ * and fragmented messages sent, fragments received, messages reassembled,
+ * messages dropped incomplete and fragments discarded. Then for reliable
+ * delivery to and from the peer (see sbn_udp_rel.h), uint8 messages awaiting
+ * an ack, uint32 the smoothed round trip and the retransmission timeout in
+ * milliseconds, messages sent, resent, acknowledged, given up on and refused
+ * for a full window, messages received and duplicates dropped. Then uint8
+ * the net's "fec" option (0 if none) and for the net, uint32 datagrams and
+ * parity datagrams sent, bytes FEC added to them, datagrams recovered,
+ * datagrams lost that could not be, duplicates dropped and FEC messages
+ * discarded (see sbn_udp_fec.h.)
+ */
+static SBN_Status_t ReportModuleStatus(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz)
+{
+    SBN_UDP_Net_t *  NetData = (SBN_UDP_Net_t *)Peer->Net->ModulePvt;
+    SBN_UDP_Group_t *Group   = &Groups[NetData->BufNum];
+    uint8 *          Ptr     = StatusBuf;
+
+    SBN_UDP_Shards_t *Shard    = &Shards[NetData->BufNum];
+    uint8             ShardIdx = 0;
+
+    uint32 MemInfo[3];
+
+    SBN_UDP_FragCnt_t *Frag = &FragCnts[NetData->BufNum];
+
+    SBN_UDP_RelPeer_t Rel;
+
+    SBN_UDP_FecCnt_t *Fec = &FecCnts[NetData->BufNum];
+
+    if (StatusBufSz
+        < (size_t)(1 + 3 * 4 + 2 + NetData->ShardCnt * 4 + 2 * 4 + NetData->ShardCnt * 4 + 2 + 6 * 4 + 1 + 10 * 4 + 1
+                   + 7 * 4))
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    *Ptr++ = NetData->Multicast ? 1 : 0;
+    Ptr    = SBN_PutUInt32(Ptr, Group->GroupTxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Group->CopyDropCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Group->RxForeignCnt);
+    *Ptr++ = NetData->ShardCnt;
+    *Ptr++ = ((SBN_UDP_Peer_t *)Peer->ModulePvt)->Shard;
+
+    for (ShardIdx = 0; ShardIdx < NetData->ShardCnt; ShardIdx++)
+    {
+        Ptr = SBN_PutUInt32(Ptr, Shard->RxCnt[ShardIdx]);
+    } /* end for */
+
+    for (ShardIdx = 0; ShardIdx < NetData->ShardCnt; ShardIdx++)
+    {
+        GetSockMemInfo(Shard->Socket[ShardIdx], MemInfo);
+
+        if (ShardIdx == 0)
+        {
+            Ptr = SBN_PutUInt32(Ptr, MemInfo[0]);
+            Ptr = SBN_PutUInt32(Ptr, MemInfo[1]);
+        } /* end if */
+
+        Ptr = SBN_PutUInt32(Ptr, MemInfo[2]);
+    } /* end for */
+
+    *Ptr++ = ((SBN_UDP_Peer_t *)Peer->ModulePvt)->Mtu >> 8;
+    *Ptr++ = ((SBN_UDP_Peer_t *)Peer->ModulePvt)->Mtu & 0xFF;
+    Ptr    = SBN_PutUInt32(Ptr, Frag->FragTxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Frag->MsgTxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Frag->FragRxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Frag->MsgRxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Frag->DropCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Frag->ErrCnt);
+
+    OS_MutSemTake(RelMutex);
+    memcpy(&Rel, GetRel(Peer), sizeof(Rel));
+    OS_MutSemGive(RelMutex);
+
+    *Ptr++ = Rel.InFlight;
+    Ptr    = SBN_PutUInt32(Ptr, Rel.SrttMs);
+    Ptr    = SBN_PutUInt32(Ptr, Rel.RtoMs);
+    Ptr    = SBN_PutUInt32(Ptr, Rel.TxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Rel.RetxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Rel.AckedCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Rel.GiveUpCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Rel.FullCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Rel.RxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Rel.DupCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Rel.OversizeCnt);
+
+    *Ptr++ = NetData->FecGroup;
+    Ptr    = SBN_PutUInt32(Ptr, Fec->DataTxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Fec->ParityTxCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Fec->OverheadBytes);
+    Ptr    = SBN_PutUInt32(Ptr, Fec->RecoveredCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Fec->UnrecoveredCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Fec->DupCnt);
+    Ptr    = SBN_PutUInt32(Ptr, Fec->ErrCnt);
+
+    return SBN_SUCCESS;
+} /* end ReportModuleStatus() */
+
+SBN_IfOps_t SBN_UDP_Ops = {Init, InitNet, InitPeer, LoadNet,   LoadPeer,   PollPeer,
+                           Send, NULL,    Recv,     UnloadNet, UnloadPeer, ReportModuleStatus,
+                           SendPacked, RecvShard};
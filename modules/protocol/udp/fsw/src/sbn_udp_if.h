@@ -2,7 +2,11 @@
 #define _SBN_UDP_IF_H_
 
 #include "sbn_udp_events.h"
+#include "sbn_udp_frag.h"
+#include "sbn_udp_rel.h"
+#include "sbn_udp_fec.h"
 #include "sbn_platform_cfg.h"
+#include "sbn_udp_platform_cfg.h"
 #include <string.h>
 #include <errno.h>
 
@@ -15,6 +19,10 @@
 #define SBN_UDP_HEARTBEAT_MSG 0xA0
 #define SBN_UDP_ANNOUNCE_MSG  0xA1
 #define SBN_UDP_DISCONN_MSG   0xA2
+#define SBN_UDP_FRAG_MSG      0xA3
+#define SBN_UDP_REL_MSG       0xA4
+#define SBN_UDP_ACK_MSG       0xA5
+#define SBN_UDP_FEC_MSG       0xA6
 
 /**
  * \brief Number of seconds since last I've sent the peer a message when
@@ -34,15 +42,124 @@
  */
 #define SBN_UDP_ANNOUNCE_TIMEOUT 10
 
+/**
+ * \brief In multicast mode (the "group" net address option) an app message
+ * that more than one connected peer of the net subscribes to is sent once, to
+ * the group, rather than to each peer in turn. SBN still reads a copy from
+ * each subscriber's pipe, all of them the same SB buffer, so the module keeps
+ * the last SBN_UDP_FANOUT_DEPTH group sends with the peers yet to hand theirs
+ * over, and drops those copies. A copy that arrives after its entry has been
+ * reused is sent again (and delivered twice.) The copies of a stamped message
+ * (SBN_NET_STAMP) are tagged in one core buffer, so are told apart by MsgID,
+ * sequence count and size alone; sequenced messages (SBN_NET_SEQ) go to each
+ * peer, as one datagram cannot carry each peer's sequence header.
+ */
+#define SBN_UDP_FANOUT_DEPTH 16
+
+/** \brief Default for the "ttl" net address option (stay on the local subnet.) */
+#define SBN_UDP_DEFAULT_MCAST_TTL 1
+
+/**
+ * \brief With the "shards" net address option a net has that many sockets
+ * bound to its port with SO_REUSEPORT, and with SBN_TASK_RECV a receive task
+ * for each. A classic BPF program steers each datagram by the sender's
+ * processor ID, at this offset in the packed header, so that a peer's messages all land on
+ * the same shard, in order; if the kernel refuses the program, its hash of the
+ * sender's address and port does the same. Not with the "group" option, as
+ * each socket would get a copy of each group message.
+ */
+#define SBN_UDP_STEER_OFFSET (sizeof(SBN_MsgSz_t) + sizeof(SBN_MsgType_t))
+
+/**
+ * \brief With the "mtu" net address option, messages that do not fit in a
+ * datagram of that size, less SBN_UDP_IP_HDR_SZ, are sent in fragments (see
+ * sbn_udp_frag.h.) "mtu=path" takes the size from the kernel's path MTU to
+ * each peer (and the group), found when the peer is initialized and again
+ * when a send fails, and sets IP_PMTUDISC_DO so that the kernel reports a
+ * smaller path rather than fragment. Without the option, messages are sent
+ * whole as before, and peers that do not fragment still understand each
+ * other. Configured sizes are from SBN_UDP_MIN_MTU, which is also the size
+ * used when the path MTU cannot be found.
+ */
+#define SBN_UDP_MIN_MTU    576
+#define SBN_UDP_IP_HDR_SZ  28 /* IPv4 and UDP headers without options */
+
+/**
+ * \brief Socket tuning from the net address options, applied to each of the
+ * net's sockets at InitNet, e.g. "0.0.0.0:2234?rcvbuf=8M&sndbuf=4M&busy_poll=50&tos=0xb8&prio=6".
+ * Sizes take a K, M or G suffix. Options left at 0 keep the kernel's
+ * defaults (0 for tos and prio.) The options are per net, as all of a net's
+ * peers share its sockets.
+ */
+typedef struct
+{
+    uint32 RcvBuf, SndBuf; /* SO_RCVBUF/SO_SNDBUF in bytes, the FORCE variants if permitted */
+    uint16 BusyPoll;       /* SO_BUSY_POLL in microseconds */
+    uint8  TOS;            /* IP_TOS */
+    uint8  Prio;           /* SO_PRIORITY */
+} SBN_UDP_SockOpts_t;
+
+typedef struct
+{
+    /** @brief The SB buffer sent to the group, as identified to the peers' copies. */
+    const void *            Payload;
+    CFE_SB_MsgId_t          MsgID;
+    CFE_MSG_SequenceCount_t Seq;
+    SBN_MsgSz_t             MsgSz;
+
+    /** @brief Peers (by index in the net) whose copy has not yet been dropped. */
+    uint32 Pending;
+} SBN_UDP_Fanout_t;
+
 typedef struct
 {
     OS_SockAddr_t Addr;
+
+    /** @brief The receive shard the peer's messages arrive on. */
+    uint8 Shard;
+
+    /** @brief See SBN_UDP_MIN_MTU, 0 to send whole messages. */
+    uint16 Mtu;
 } SBN_UDP_Peer_t;
 
 typedef struct SBN_UDP_Net_s
 {
     OS_SockAddr_t Addr;
     uint32        Socket;
+
+    /** @brief The group that app messages for several peers are sent to (port as Addr.) */
+    OS_SockAddr_t GroupAddr;
+
+    /** @brief The group, and the local interface to join it on ("if" option, default any), network order. */
+    uint32 GroupIP, IfIP;
+
+    /** @brief True when the net has a group (see SBN_UDP_FANOUT_DEPTH.) */
+    bool Multicast;
+
+    /** @brief See SBN_UDP_DEFAULT_MCAST_TTL. */
+    uint8 TTL;
+
+    /** @brief See SBN_UDP_STEER_OFFSET, 1 if the net is not sharded. */
+    uint8 ShardCnt;
+
+    /** @brief The shard a polled net (without SBN_TASK_RECV) reads first next. */
+    uint8 NextShard;
+
+    /** @brief The "mtu" option (see SBN_UDP_MIN_MTU), 0 if not given or "path". */
+    uint16 Mtu;
+    bool   PathMtu;
+
+    /** @brief The Seq of the net's next fragmented message. */
+    uint16 FragSeq;
+
+    /** @brief The "reliable" option, each peer's window (see sbn_udp_rel.h), 0 if not given. */
+    uint8 RelWindow;
+
+    /** @brief The "fec" option, the datagrams per parity datagram (see sbn_udp_fec.h), 0 if not given. */
+    uint8 FecGroup;
+
+    /** @brief Index into the module's fanout, shard, socket option, reliable delivery and FEC tables. */
+    uint8 BufNum;
 } SBN_UDP_Net_t;
 
 #endif /* _SBN_UDP_IF_H_ */
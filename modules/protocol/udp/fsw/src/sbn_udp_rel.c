@@ -0,0 +1,364 @@
+#include "sbn_udp_rel.h"
+#include <string.h>
+
+static uint16 GetUInt16(const uint8 *Buf)
+{
+    return (Buf[0] << 8) | Buf[1];
+} /* end GetUInt16() */
+
+static uint8 *PutUInt16(uint8 *Buf, uint16 Val)
+{
+    *Buf++ = Val >> 8;
+    *Buf++ = Val & 0xFF;
+    return Buf;
+} /* end PutUInt16() */
+
+void SBN_UDP_RelInit(SBN_UDP_RelPool_t *Pool, uint16 Epoch)
+{
+    int i = 0;
+
+    for (i = 0; i < SBN_UDP_REL_SLOTS; i++)
+    {
+        Pool->Slots[i].Active = false;
+    } /* end for */
+
+    Pool->Epoch = Epoch ? Epoch : 1;
+} /* end SBN_UDP_RelInit() */
+
+static bool IsPeers(SBN_UDP_RelSlot_t *Slot, uint8 NetNum, uint8 PeerIdx)
+{
+    return Slot->Active && Slot->NetNum == NetNum && Slot->PeerIdx == PeerIdx;
+} /* end IsPeers() */
+
+static void FreeSlot(SBN_UDP_RelPeer_t *Rel, SBN_UDP_RelSlot_t *Slot)
+{
+    Slot->Active = false;
+    Rel->InFlight--;
+} /* end FreeSlot() */
+
+void SBN_UDP_RelReset(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx)
+{
+    int i = 0;
+
+    for (i = 0; i < SBN_UDP_REL_SLOTS; i++)
+    {
+        if (IsPeers(&Pool->Slots[i], NetNum, PeerIdx))
+        {
+            FreeSlot(Rel, &Pool->Slots[i]);
+            Rel->GiveUpCnt++;
+        } /* end if */
+    }     /* end for */
+
+    Rel->HaveRtt = false;
+    Rel->RtoMs   = SBN_UDP_REL_INIT_RTO_MS;
+    Rel->RxValid = false;
+    Rel->AckOwed = 0;
+} /* end SBN_UDP_RelReset() */
+
+size_t SBN_UDP_RelPutAck(SBN_UDP_RelPeer_t *Rel, uint8 *Buf)
+{
+    Buf = PutUInt16(Buf, Rel->RxValid ? Rel->PeerEpoch : 0);
+    Buf = PutUInt16(Buf, Rel->RecvNext);
+    Buf = PutUInt16(Buf, Rel->RecvMask >> 16);
+    PutUInt16(Buf, Rel->RecvMask & 0xFFFF);
+
+    Rel->AckOwed = 0;
+
+    return SBN_UDP_ACK_SZ;
+} /* end SBN_UDP_RelPutAck() */
+
+/**
+ * The oldest Seq still awaiting the peer's ack, or the next to be sent.
+ */
+static uint16 Base(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx)
+{
+    uint16 Oldest = Rel->NextSeq;
+    int    i      = 0;
+
+    for (i = 0; i < SBN_UDP_REL_SLOTS; i++)
+    {
+        if (IsPeers(&Pool->Slots[i], NetNum, PeerIdx) && (int16)(Pool->Slots[i].Seq - Oldest) < 0)
+        {
+            Oldest = Pool->Slots[i].Seq;
+        } /* end if */
+    }     /* end for */
+
+    return Oldest;
+} /* end Base() */
+
+/**
+ * Writes the header of the slot's message, with the current Base and ack.
+ */
+static void PutHdr(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, SBN_UDP_RelSlot_t *Slot)
+{
+    uint8 *Buf = Slot->Buf;
+
+    Buf = PutUInt16(Buf, Pool->Epoch);
+    Buf = PutUInt16(Buf, Slot->Seq);
+    Buf = PutUInt16(Buf, Base(Pool, Rel, Slot->NetNum, Slot->PeerIdx));
+    SBN_UDP_RelPutAck(Rel, Buf + 1); /* past the type, set when queued */
+} /* end PutHdr() */
+
+SBN_Status_t SBN_UDP_RelQueue(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx,
+                              uint8 Window, SBN_MsgType_t MsgType, const void *Msg, SBN_MsgSz_t MsgSz, uint32 NowMs,
+                              SBN_UDP_RelSlot_t **SlotPtr)
+{
+    SBN_UDP_RelSlot_t *Slot = NULL;
+    int                i    = 0;
+
+    if (MsgSz < 0 || MsgSz > SBN_UDP_REL_MAX_MSG_SZ)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    for (i = 0; i < SBN_UDP_REL_SLOTS && Rel->InFlight < Window; i++)
+    {
+        if (!Pool->Slots[i].Active)
+        {
+            Slot = &Pool->Slots[i];
+            break;
+        } /* end if */
+    }     /* end for */
+
+    if (!Slot)
+    {
+        Rel->FullCnt++;
+        return SBN_ERROR;
+    } /* end if */
+
+    if (!Rel->RtoMs)
+    {
+        Rel->RtoMs = SBN_UDP_REL_INIT_RTO_MS;
+    } /* end if */
+
+    Slot->Active  = true;
+    Slot->NetNum  = NetNum;
+    Slot->PeerIdx = PeerIdx;
+    Slot->Seq     = Rel->NextSeq++;
+    Slot->RetxCnt = 0;
+    Slot->SentMs  = NowMs;
+    Slot->Sz      = SBN_UDP_REL_HDR_SZ + MsgSz;
+
+    Rel->InFlight++;
+    Rel->TxCnt++;
+
+    Slot->Buf[SBN_UDP_REL_TYPE_OFS] = MsgType;
+    PutHdr(Pool, Rel, Slot);
+    memcpy(Slot->Buf + SBN_UDP_REL_HDR_SZ, Msg, MsgSz);
+
+    *SlotPtr = Slot;
+
+    return SBN_SUCCESS;
+} /* end SBN_UDP_RelQueue() */
+
+/**
+ * Takes a round trip sample into the timeout, as RFC 6298 with a clock
+ * granularity of SBN_UDP_REL_MIN_RTO_MS.
+ */
+static void Sample(SBN_UDP_RelPeer_t *Rel, uint32 RttMs)
+{
+    uint32 Dev = 0;
+
+    if (!Rel->HaveRtt)
+    {
+        Rel->SrttMs   = RttMs;
+        Rel->RttVarMs = RttMs / 2;
+        Rel->HaveRtt  = true;
+    }
+    else
+    {
+        Dev           = Rel->SrttMs > RttMs ? Rel->SrttMs - RttMs : RttMs - Rel->SrttMs;
+        Rel->RttVarMs = (3 * Rel->RttVarMs + Dev) / 4;
+        Rel->SrttMs   = (7 * Rel->SrttMs + RttMs) / 8;
+    } /* end if */
+
+    Rel->RtoMs = Rel->SrttMs + 4 * Rel->RttVarMs;
+
+    if (Rel->RtoMs < SBN_UDP_REL_MIN_RTO_MS)
+    {
+        Rel->RtoMs = SBN_UDP_REL_MIN_RTO_MS;
+    } /* end if */
+
+    if (Rel->RtoMs > SBN_UDP_REL_MAX_RTO_MS)
+    {
+        Rel->RtoMs = SBN_UDP_REL_MAX_RTO_MS;
+    } /* end if */
+} /* end Sample() */
+
+void SBN_UDP_RelAck(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx, const uint8 *Ack,
+                    uint32 NowMs)
+{
+    uint16 Next = GetUInt16(Ack + 2);
+    uint32 Mask = ((uint32)GetUInt16(Ack + 4) << 16) | GetUInt16(Ack + 6);
+    int16  Diff = 0;
+    int    i    = 0;
+
+    if (GetUInt16(Ack) != Pool->Epoch)
+    {
+        return; /* nothing received yet, or from an earlier run of mine */
+    } /* end if */
+
+    for (i = 0; i < SBN_UDP_REL_SLOTS; i++)
+    {
+        SBN_UDP_RelSlot_t *Slot = &Pool->Slots[i];
+
+        if (!IsPeers(Slot, NetNum, PeerIdx))
+        {
+            continue;
+        } /* end if */
+
+        Diff = Slot->Seq - Next;
+
+        if (Diff < 0 || (Diff >= 1 && Diff <= 32 && (Mask & (1UL << (Diff - 1)))))
+        {
+            if (Slot->RetxCnt == 0)
+            {
+                Sample(Rel, NowMs - Slot->SentMs);
+            } /* end if */
+
+            FreeSlot(Rel, Slot);
+            Rel->AckedCnt++;
+        } /* end if */
+    }     /* end for */
+} /* end SBN_UDP_RelAck() */
+
+SBN_UDP_RelSlot_t *SBN_UDP_RelDue(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx,
+                                  uint32 NowMs)
+{
+    uint32 RtoMs = 0;
+    int    i     = 0;
+
+    for (i = 0; i < SBN_UDP_REL_SLOTS; i++)
+    {
+        SBN_UDP_RelSlot_t *Slot = &Pool->Slots[i];
+
+        if (!IsPeers(Slot, NetNum, PeerIdx))
+        {
+            continue;
+        } /* end if */
+
+        /* each resend of a message doubles its timeout */
+        RtoMs = Rel->RtoMs << Slot->RetxCnt;
+        if (RtoMs > SBN_UDP_REL_MAX_RTO_MS)
+        {
+            RtoMs = SBN_UDP_REL_MAX_RTO_MS;
+        } /* end if */
+
+        if (NowMs - Slot->SentMs < RtoMs)
+        {
+            continue;
+        } /* end if */
+
+        if (Slot->RetxCnt >= SBN_UDP_REL_MAX_RETX)
+        {
+            FreeSlot(Rel, Slot);
+            Rel->GiveUpCnt++;
+            continue;
+        } /* end if */
+
+        Slot->RetxCnt++;
+        Slot->SentMs = NowMs;
+        Rel->RetxCnt++;
+
+        PutHdr(Pool, Rel, Slot);
+
+        return Slot;
+    } /* end for */
+
+    return NULL;
+} /* end SBN_UDP_RelDue() */
+
+/**
+ * Moves RecvNext past itself, taken as received or given up on, and past the
+ * run received after it.
+ */
+static void Advance(SBN_UDP_RelPeer_t *Rel)
+{
+    bool Got = true;
+
+    while (Got)
+    {
+        Got = Rel->RecvMask & 1;
+        Rel->RecvMask >>= 1;
+        Rel->RecvNext++;
+    } /* end while */
+} /* end Advance() */
+
+SBN_Status_t SBN_UDP_RelRecv(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx,
+                             const uint8 *Msg, SBN_MsgSz_t MsgSz, uint32 NowMs, bool *AckNowPtr)
+{
+    uint16 Epoch = 0, Seq = 0, BaseSeq = 0;
+    int16  Diff  = 0;
+
+    *AckNowPtr = false;
+
+    if (MsgSz < SBN_UDP_REL_HDR_SZ)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    Epoch   = GetUInt16(Msg);
+    Seq     = GetUInt16(Msg + 2);
+    BaseSeq = GetUInt16(Msg + 4);
+
+    SBN_UDP_RelAck(Pool, Rel, NetNum, PeerIdx, Msg + SBN_UDP_REL_TYPE_OFS + 1, NowMs);
+
+    if (!Rel->RxValid || Epoch != Rel->PeerEpoch)
+    {
+        /* the peer's first message, or the peer has restarted */
+        Rel->RxValid   = true;
+        Rel->PeerEpoch = Epoch;
+        Rel->RecvNext  = BaseSeq;
+        Rel->RecvMask  = 0;
+    } /* end if */
+
+    /* the peer has given up on what is before its Base */
+    while ((Diff = BaseSeq - Rel->RecvNext) > 0)
+    {
+        if (Diff > 32)
+        {
+            Rel->RecvNext = BaseSeq;
+            Rel->RecvMask = 0;
+            break;
+        } /* end if */
+
+        Advance(Rel);
+    } /* end while */
+
+    Diff = Seq - Rel->RecvNext;
+
+    if (Diff > 32)
+    {
+        /* beyond any window, start again from it */
+        Rel->RecvNext = Seq;
+        Rel->RecvMask = 0;
+        Diff          = 0;
+    } /* end if */
+
+    if (Diff < 0 || (Diff > 0 && (Rel->RecvMask & (1UL << (Diff - 1)))))
+    {
+        /* the peer has not had my ack, resend it now */
+        Rel->DupCnt++;
+        *AckNowPtr = true;
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    if (Diff == 0)
+    {
+        Advance(Rel);
+    }
+    else
+    {
+        Rel->RecvMask |= 1UL << (Diff - 1);
+        *AckNowPtr = true; /* a gap, tell the peer soon */
+    } /* end if */
+
+    Rel->RxCnt++;
+
+    if (++Rel->AckOwed >= SBN_UDP_REL_ACK_EVERY)
+    {
+        *AckNowPtr = true;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end SBN_UDP_RelRecv() */
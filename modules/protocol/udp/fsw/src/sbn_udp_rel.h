@@ -0,0 +1,217 @@
+#ifndef _sbn_udp_rel_h_
+#define _sbn_udp_rel_h_
+
+/**
+ * With the "reliable" net address option, app messages for a subscription
+ * whose QoS asks for reliability (CFE_SB_Qos_t Reliability, as the peer sent
+ * it in its SUB message) are sent as SBN_UDP_REL_MSG, kept until the peer
+ * acknowledges them, and sent again if it does not in time. Other messages
+ * bypass it and are sent as before. The payload is:
+ *
+ * ```
+ * +----------+--------+---------+---------+-------------+-----------------+
+ * | Epoch:16 | Seq:16 | Base:16 | Type:8  | ack (below) | the app message |
+ * +----------+--------+---------+---------+-------------+-----------------+
+ * ```
+ *
+ * Epoch identifies this run of the sender, so that a restarted peer's Seq
+ * numbers are not taken for old ones, Seq numbers the sender's reliable
+ * messages to the peer and Base is the oldest it has not given up on. Type is
+ * the SBN type of the app message, as the net's flags tag it. An ack
+ * is the receiver's view of the other direction:
+ *
+ * ```
+ * +----------+---------+---------+
+ * | Epoch:16 | Next:16 | Mask:32 |
+ * +----------+---------+---------+
+ * ```
+ *
+ * Next is the first Seq not received, bit i of Mask is set if Seq Next+1+i
+ * has been (selective acknowledgement), and Epoch is the one acknowledged, 0
+ * if none. Acks ride on each reliable message and on heartbeats, or are sent
+ * alone as SBN_UDP_ACK_MSG when one is owed. All values are big-endian.
+ * Messages are delivered as they arrive, duplicates dropped; a lost message
+ * does not hold up those after it.
+ */
+
+#include "sbn_interfaces.h"
+#include "sbn_platform_cfg.h"
+#include "sbn_udp_platform_cfg.h"
+#include "cfe.h"
+
+#define SBN_UDP_ACK_SZ     8
+#define SBN_UDP_REL_HDR_SZ (7 + SBN_UDP_ACK_SZ)
+
+/** @brief Where the app message's type is in the header. */
+#define SBN_UDP_REL_TYPE_OFS 6
+
+/** @brief The most a "reliable" window may be, the messages one ack can account for past Next. */
+#define SBN_UDP_REL_MAX_WINDOW 32
+
+/**
+ * @brief Retransmission timeout bounds, in milliseconds. The timeout follows
+ * the measured round trip (RFC 6298, only from messages sent once), doubles
+ * with each resend of a message, and is checked each time the peer is polled.
+ */
+#define SBN_UDP_REL_INIT_RTO_MS 1000
+#define SBN_UDP_REL_MIN_RTO_MS  100
+#define SBN_UDP_REL_MAX_RTO_MS  8000
+
+/** @brief How many times a message is resent before it is given up on. */
+#define SBN_UDP_REL_MAX_RETX 8
+
+/** @brief An ack is sent at once after this many reliable messages, otherwise at the next poll. */
+#define SBN_UDP_REL_ACK_EVERY 2
+
+typedef struct
+{
+    /** @brief The payload of the SBN_UDP_REL_MSG, header and app message. */
+    uint8       Buf[SBN_UDP_REL_HDR_SZ + SBN_UDP_REL_MAX_MSG_SZ];
+    SBN_MsgSz_t Sz;
+
+    bool Active;
+
+    /** @brief The peer (its net's BufNum and index in the net) and its Seq. */
+    uint8  NetNum, PeerIdx;
+    uint16 Seq;
+
+    uint8  RetxCnt;
+    uint32 SentMs;
+} SBN_UDP_RelSlot_t;
+
+typedef struct
+{
+    SBN_UDP_RelSlot_t Slots[SBN_UDP_REL_SLOTS];
+
+    /** @brief This run's Epoch, never 0. */
+    uint16 Epoch;
+} SBN_UDP_RelPool_t;
+
+typedef struct
+{
+    /** @brief The Seq of the next message to the peer, and how many await an ack. */
+    uint16 NextSeq;
+    uint8  InFlight;
+
+    /** @brief Smoothed round trip, its variation and the timeout, in milliseconds. */
+    bool   HaveRtt;
+    uint32 SrttMs, RttVarMs, RtoMs;
+
+    /** @brief What has been received from the peer, as it goes in an ack. */
+    bool   RxValid;
+    uint16 PeerEpoch, RecvNext;
+    uint32 RecvMask;
+
+    /** @brief Reliable messages received since the last ack sent. */
+    uint8 AckOwed;
+
+    /** @brief Messages sent, resent, acknowledged, given up on and refused for a full window. */
+    uint32 TxCnt, RetxCnt, AckedCnt, GiveUpCnt, FullCnt;
+
+    /** @brief Messages received, and duplicates dropped. */
+    uint32 RxCnt, DupCnt;
+
+    /** @brief Messages too large for a slot, sent unreliably instead. */
+    uint32 OversizeCnt;
+} SBN_UDP_RelPeer_t;
+
+/**
+ * Empties the pool and starts a run.
+ *
+ * @param Pool[out] The pool.
+ * @param Epoch[in] This run's Epoch, e.g. from the clock; 0 is taken as 1.
+ */
+void SBN_UDP_RelInit(SBN_UDP_RelPool_t *Pool, uint16 Epoch);
+
+/**
+ * Gives up on the messages awaiting a peer's ack and forgets what was
+ * received from it, as when the peer disconnects.
+ *
+ * @param Pool[in/out] The pool.
+ * @param Rel[in/out] The peer's state.
+ * @param NetNum[in] The net's BufNum.
+ * @param PeerIdx[in] The peer's index in the net.
+ */
+void SBN_UDP_RelReset(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx);
+
+/**
+ * Writes the ack for the peer, and clears the ack owed.
+ *
+ * @param Rel[in/out] The peer's state.
+ * @param Buf[out] At least SBN_UDP_ACK_SZ bytes.
+ *
+ * @return SBN_UDP_ACK_SZ
+ */
+size_t SBN_UDP_RelPutAck(SBN_UDP_RelPeer_t *Rel, uint8 *Buf);
+
+/**
+ * Takes a slot for an app message to the peer and writes the payload of its
+ * SBN_UDP_REL_MSG there.
+ *
+ * @param Pool[in/out] The pool.
+ * @param Rel[in/out] The peer's state.
+ * @param NetNum[in] The net's BufNum.
+ * @param PeerIdx[in] The peer's index in the net.
+ * @param Window[in] The most messages that may await the peer's ack.
+ * @param MsgType[in] The app message's type, one of SBN_IS_APP_MSG.
+ * @param Msg[in] The app message.
+ * @param MsgSz[in] Its size.
+ * @param NowMs[in] The time, in milliseconds.
+ * @param SlotPtr[out] The slot, to send from.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if the window or the pool is full or the
+ *         message larger than SBN_UDP_REL_MAX_MSG_SZ.
+ */
+SBN_Status_t SBN_UDP_RelQueue(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx,
+                              uint8 Window, SBN_MsgType_t MsgType, const void *Msg, SBN_MsgSz_t MsgSz, uint32 NowMs,
+                              SBN_UDP_RelSlot_t **SlotPtr);
+
+/**
+ * Frees the slots of the messages an ack from the peer accounts for.
+ *
+ * @param Pool[in/out] The pool.
+ * @param Rel[in/out] The peer's state.
+ * @param NetNum[in] The net's BufNum.
+ * @param PeerIdx[in] The peer's index in the net.
+ * @param Ack[in] The ack, SBN_UDP_ACK_SZ bytes.
+ * @param NowMs[in] The time, in milliseconds, for the round trip.
+ */
+void SBN_UDP_RelAck(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx, const uint8 *Ack,
+                    uint32 NowMs);
+
+/**
+ * Finds a message to the peer whose timeout has passed, and readies it to be
+ * sent again with a fresh ack; a message sent SBN_UDP_REL_MAX_RETX times is
+ * given up on instead. Call until it returns NULL.
+ *
+ * @param Pool[in/out] The pool.
+ * @param Rel[in/out] The peer's state.
+ * @param NetNum[in] The net's BufNum.
+ * @param PeerIdx[in] The peer's index in the net.
+ * @param NowMs[in] The time, in milliseconds.
+ *
+ * @return The slot to send from, or NULL.
+ */
+SBN_UDP_RelSlot_t *SBN_UDP_RelDue(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx,
+                                  uint32 NowMs);
+
+/**
+ * Takes in the payload of an SBN_UDP_REL_MSG from the peer, its ack included.
+ *
+ * @param Pool[in/out] The pool.
+ * @param Rel[in/out] The peer's state.
+ * @param NetNum[in] The net's BufNum.
+ * @param PeerIdx[in] The peer's index in the net.
+ * @param Msg[in] The payload.
+ * @param MsgSz[in] Its size.
+ * @param NowMs[in] The time, in milliseconds.
+ * @param AckNowPtr[out] Set if an ack should be sent without waiting.
+ *
+ * @return SBN_SUCCESS if the app message (after SBN_UDP_REL_HDR_SZ) is new,
+ *         SBN_IF_EMPTY if it is a duplicate, SBN_ERROR if the payload is too
+ *         short.
+ */
+SBN_Status_t SBN_UDP_RelRecv(SBN_UDP_RelPool_t *Pool, SBN_UDP_RelPeer_t *Rel, uint8 NetNum, uint8 PeerIdx,
+                             const uint8 *Msg, SBN_MsgSz_t MsgSz, uint32 NowMs, bool *AckNowPtr);
+
+#endif /* _sbn_udp_rel_h_ */
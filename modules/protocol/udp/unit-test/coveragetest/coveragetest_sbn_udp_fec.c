@@ -0,0 +1,269 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_udp_fec.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN UDP forward error correction
+*/
+
+#include "sbn_udp_if_coveragetest_common.h"
+#include "sbn_udp_fec.h"
+
+static SBN_UDP_FecEnc_t Enc;
+static SBN_UDP_FecDec_t Dec;
+static SBN_UDP_FecCnt_t Cnts[SBN_MAX_NETS];
+
+/* a group of four datagrams of different sizes, as sent, header and all */
+static uint8  Sent[5][SBN_UDP_FEC_HDR_SZ + 64];
+static size_t SentSz[5];
+
+static uint8  Dgram[SBN_UDP_FEC_MAX_DGRAM];
+static size_t DgramSz;
+
+static void Reset(void)
+{
+    memset(Cnts, 0, sizeof(Cnts));
+    SBN_UDP_FecInit(&Enc, &Dec);
+} /* end Reset() */
+
+/* encodes a group of four to peer 0 of net 0, the parity last */
+static void EncodeGroup(void)
+{
+    SBN_UDP_FecEncSlot_t *Slot = NULL;
+    uint8                 Data[64];
+    int                   i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        memset(Data, 0x10 + i, sizeof(Data));
+        SentSz[i] = SBN_UDP_FEC_HDR_SZ + 20 + 10 * i;
+        memcpy(Sent[i] + SBN_UDP_FEC_HDR_SZ, Data, SentSz[i] - SBN_UDP_FEC_HDR_SZ);
+
+        Slot = SBN_UDP_FecEncode(&Enc, Cnts, 0, 0, 4, Data, SentSz[i] - SBN_UDP_FEC_HDR_SZ, 0, Sent[i]);
+        UtAssert_True((Slot != NULL) == (i == 3), "group full after four (%d)", i);
+    } /* end for */
+
+    SentSz[4] = SBN_UDP_FecParity(Slot, Cnts, Sent[4]);
+    UtAssert_True(SentSz[4] == SBN_UDP_FEC_HDR_SZ + 50, "parity as long as the longest (%d)", (int)SentSz[4]);
+} /* end EncodeGroup() */
+
+static SBN_Status_t Decode(int i, uint32 NowMs)
+{
+    return SBN_UDP_FecDecode(&Dec, Cnts, 0, 1, 2, Sent[i], SentSz[i], NowMs, Dgram, &DgramSz);
+} /* end Decode() */
+
+static bool IsSent(int i)
+{
+    return DgramSz == SentSz[i] - SBN_UDP_FEC_HDR_SZ && memcmp(Dgram, Sent[i] + SBN_UDP_FEC_HDR_SZ, DgramSz) == 0;
+} /* end IsSent() */
+
+static void Fec_Nominal(void)
+{
+    Reset();
+    EncodeGroup();
+
+    UtAssert_True(Cnts[0].DataTxCnt == 4 && Cnts[0].ParityTxCnt == 1, "counted sent");
+
+    UT_TEST_FUNCTION_RC(Decode(0, 0), SBN_SUCCESS);
+    UtAssert_True(IsSent(0), "datagram 0");
+    UT_TEST_FUNCTION_RC(Decode(0, 0), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Decode(1, 0), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(Decode(3, 0), SBN_SUCCESS);
+
+    /* datagram 2 lost, the parity recovers it */
+    UT_TEST_FUNCTION_RC(Decode(4, 0), SBN_SUCCESS);
+    UtAssert_True(IsSent(2), "datagram 2 recovered");
+
+    UT_TEST_FUNCTION_RC(Decode(2, 0), SBN_IF_EMPTY);
+    UtAssert_True(Cnts[0].RecoveredCnt == 1 && Cnts[0].DupCnt == 2, "RecoveredCnt=%d DupCnt=%d",
+                  (int)Cnts[0].RecoveredCnt, (int)Cnts[0].DupCnt);
+} /* end Fec_Nominal() */
+
+static void Fec_Reordered(void)
+{
+    Reset();
+    EncodeGroup();
+
+    /* the parity overtakes the datagrams, the last of which completes the recovery */
+    UT_TEST_FUNCTION_RC(Decode(4, 0), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecTakeRecovered(&Dec, 0, Dgram, &DgramSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Decode(3, 0), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(Decode(1, 0), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(Decode(2, 0), SBN_SUCCESS);
+    UtAssert_True(IsSent(2), "datagram 2");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecTakeRecovered(&Dec, 1, Dgram, &DgramSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecTakeRecovered(&Dec, 0, Dgram, &DgramSz), SBN_SUCCESS);
+    UtAssert_True(IsSent(0), "datagram 0 recovered");
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecTakeRecovered(&Dec, 0, Dgram, &DgramSz), SBN_IF_EMPTY);
+} /* end Fec_Reordered() */
+
+static void Fec_Lost(void)
+{
+    Reset();
+    EncodeGroup();
+
+    UT_TEST_FUNCTION_RC(Decode(0, 0), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(Decode(3, 0), SBN_SUCCESS);
+
+    /* two lost and the parity, as far as the datagrams tell */
+    Decode(0, SBN_UDP_FEC_TIMEOUT_MS + 1);
+    UtAssert_True(Cnts[0].UnrecoveredCnt == 2, "UnrecoveredCnt=%d", (int)Cnts[0].UnrecoveredCnt);
+
+    Reset();
+    EncodeGroup();
+
+    UT_TEST_FUNCTION_RC(Decode(4, 0), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Decode(0, 0), SBN_SUCCESS);
+    Decode(0, SBN_UDP_FEC_TIMEOUT_MS + 1);
+    UtAssert_True(Cnts[0].UnrecoveredCnt == 3, "UnrecoveredCnt=%d", (int)Cnts[0].UnrecoveredCnt);
+} /* end Fec_Lost() */
+
+static void Fec_Flush(void)
+{
+    SBN_UDP_FecEncSlot_t *Slot = NULL;
+    uint8                 Data[8];
+    uint8                 Hdr[SBN_UDP_FEC_HDR_SZ];
+    int                   i = 0;
+
+    Reset();
+    memset(Data, 0x42, sizeof(Data));
+
+    UtAssert_True(SBN_UDP_FecEncode(&Enc, Cnts, 1, SBN_UDP_FEC_GROUP_DEST, 4, Data, sizeof(Data), 0, Hdr) == NULL,
+                  "group open");
+    UtAssert_True(Hdr[2] == 0 && Hdr[3] == SBN_UDP_FEC_TO_GROUP && Hdr[5] == sizeof(Data), "header to the group");
+
+    UtAssert_True(SBN_UDP_FecFlush(&Enc, 1, 0, SBN_UDP_FEC_FLUSH_MS) == NULL, "no group to the peer");
+    UtAssert_True(SBN_UDP_FecFlush(&Enc, 1, SBN_UDP_FEC_GROUP_DEST, SBN_UDP_FEC_FLUSH_MS - 1) == NULL, "not yet");
+
+    Slot = SBN_UDP_FecFlush(&Enc, 1, SBN_UDP_FEC_GROUP_DEST, SBN_UDP_FEC_FLUSH_MS);
+    UtAssert_True(Slot != NULL, "flushed");
+    UtAssert_True(SBN_UDP_FecParity(Slot, Cnts, Sent[0]) == SBN_UDP_FEC_HDR_SZ + sizeof(Data), "parity of one");
+    UtAssert_True(Sent[0][2] == 1 && Sent[0][3] == (SBN_UDP_FEC_PARITY | SBN_UDP_FEC_TO_GROUP), "parity header");
+
+    /* more groups than slots: the oldest gives way */
+    for (i = 0; i <= SBN_UDP_FEC_ENC_SLOTS; i++)
+    {
+        SBN_UDP_FecEncode(&Enc, Cnts, i / SBN_MAX_PEER_CNT, i % SBN_MAX_PEER_CNT, 4, Data, sizeof(Data), i, Hdr);
+    } /* end for */
+
+    UtAssert_True(SBN_UDP_FecFlush(&Enc, 0, 0, 1000) == NULL, "oldest gone");
+    UtAssert_True(SBN_UDP_FecFlush(&Enc, SBN_UDP_FEC_ENC_SLOTS / SBN_MAX_PEER_CNT,
+                                   SBN_UDP_FEC_ENC_SLOTS % SBN_MAX_PEER_CNT, 1000) != NULL,
+                  "newest kept");
+} /* end Fec_Flush() */
+
+static void Fec_PendingKept(void)
+{
+    int i = 0;
+
+    Reset();
+    EncodeGroup();
+
+    /* a recovered datagram waits in its slot */
+    UT_TEST_FUNCTION_RC(Decode(4, 0), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Decode(3, 0), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(Decode(1, 0), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(Decode(2, 0), SBN_SUCCESS);
+
+    /* groups from more senders than there are other slots do not evict it */
+    for (i = 0; i < SBN_UDP_FEC_DEC_SLOTS; i++)
+    {
+        UT_TEST_FUNCTION_RC(SBN_UDP_FecDecode(&Dec, Cnts, 0, 10 + i, 2, Sent[0], SentSz[0], 1, Dgram, &DgramSz),
+                            SBN_SUCCESS);
+    } /* end for */
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecTakeRecovered(&Dec, 0, Dgram, &DgramSz), SBN_SUCCESS);
+    UtAssert_True(IsSent(0), "datagram 0 recovered");
+
+    /* with every slot holding a recovered datagram, datagrams pass unprotected and parities are dropped */
+    memset(&Dec, 0, sizeof(Dec));
+    for (i = 0; i < SBN_UDP_FEC_DEC_SLOTS; i++)
+    {
+        Dec.Slots[i].Active  = true;
+        Dec.Slots[i].Pending = true;
+        Dec.Slots[i].NetNum  = 1;
+    } /* end for */
+
+    UT_TEST_FUNCTION_RC(Decode(1, 0), SBN_SUCCESS);
+    UtAssert_True(IsSent(1), "datagram 1 passed");
+    UT_TEST_FUNCTION_RC(Decode(4, 0), SBN_IF_EMPTY);
+} /* end Fec_PendingKept() */
+
+static void Fec_BadHdr(void)
+{
+    uint8 Bad[SBN_UDP_FEC_HDR_SZ + 4];
+
+    Reset();
+    memset(Bad, 0, sizeof(Bad));
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecDecode(&Dec, Cnts, 0, 1, 2, Bad, SBN_UDP_FEC_HDR_SZ - 1, 0, Dgram, &DgramSz),
+                        SBN_ERROR);
+
+    /* a datagram's Len must be its size */
+    Bad[5] = 3;
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecDecode(&Dec, Cnts, 0, 1, 2, Bad, sizeof(Bad), 0, Dgram, &DgramSz), SBN_ERROR);
+
+    Bad[5] = 4;
+    Bad[2] = SBN_UDP_FEC_MAX_GROUP;
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecDecode(&Dec, Cnts, 0, 1, 2, Bad, sizeof(Bad), 0, Dgram, &DgramSz), SBN_ERROR);
+
+    /* a parity for fewer datagrams than have arrived */
+    Bad[2] = 2;
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecDecode(&Dec, Cnts, 0, 1, 2, Bad, sizeof(Bad), 0, Dgram, &DgramSz), SBN_SUCCESS);
+    Bad[2] = 2;
+    Bad[3] = SBN_UDP_FEC_PARITY;
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecDecode(&Dec, Cnts, 0, 1, 2, Bad, sizeof(Bad), 0, Dgram, &DgramSz), SBN_ERROR);
+
+    Bad[2] = 0;
+    UT_TEST_FUNCTION_RC(SBN_UDP_FecDecode(&Dec, Cnts, 0, 1, 2, Bad, sizeof(Bad), 0, Dgram, &DgramSz), SBN_ERROR);
+
+    UtAssert_True(Cnts[0].ErrCnt == 5, "ErrCnt=%d", (int)Cnts[0].ErrCnt);
+} /* end Fec_BadHdr() */
+
+void Test_SBN_UDP_Fec(void)
+{
+    Fec_Nominal();
+    Fec_Reordered();
+    Fec_Lost();
+    Fec_Flush();
+    Fec_PendingKept();
+    Fec_BadHdr();
+} /* end Test_SBN_UDP_Fec() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_UDP_Fec);
+}
@@ -0,0 +1,190 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_udp_frag.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN UDP fragment reassembly
+*/
+
+#include "sbn_udp_if_coveragetest_common.h"
+#include "sbn_udp_frag.h"
+
+static SBN_UDP_Reasm_t   Reasm;
+static SBN_UDP_FragCnt_t Cnts[SBN_MAX_NETS];
+
+static uint8 Msg[2048];
+static uint8 Frag[SBN_UDP_FRAG_HDR_SZ + 512];
+static uint8 Out[SBN_MAX_PACKED_MSG_SZ];
+
+/* feeds fragment Idx (of FragSz-byte fragments) of message Seq from processor 1 to the reassembler */
+static SBN_Status_t Feed(uint16 Seq, size_t MsgSz, size_t FragSz, int Idx, uint32 NowMs, size_t *MsgSzPtr)
+{
+    size_t Offset = Idx * FragSz;
+    size_t DataSz = MsgSz - Offset < FragSz ? MsgSz - Offset : FragSz;
+
+    SBN_UDP_FragHdr(Frag, Seq, MsgSz, Offset, Idx, (MsgSz + FragSz - 1) / FragSz);
+    memcpy(Frag + SBN_UDP_FRAG_HDR_SZ, Msg + Offset, DataSz);
+
+    return SBN_UDP_Reasm(&Reasm, Cnts, 0, 1, 42, Frag, SBN_UDP_FRAG_HDR_SZ + DataSz, NowMs, Out, MsgSzPtr);
+} /* end Feed() */
+
+static void Reset(void)
+{
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(Msg); i++)
+    {
+        Msg[i] = i & 0xFF;
+    } /* end for */
+
+    memset(Cnts, 0, sizeof(Cnts));
+    SBN_UDP_ReasmInit(&Reasm);
+} /* end Reset() */
+
+static void Reasm_Nominal(void)
+{
+    size_t MsgSz = 0;
+
+    Reset();
+
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 0, 0, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 1, 0, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 2, 0, &MsgSz), SBN_SUCCESS);
+
+    UtAssert_True(MsgSz == 1200, "message size %d == 1200", (int)MsgSz);
+    UtAssert_True(memcmp(Out, Msg, 1200) == 0, "message intact");
+    UtAssert_True(Cnts[0].FragRxCnt == 3 && Cnts[0].MsgRxCnt == 1 && Cnts[0].ErrCnt == 0, "counters");
+} /* end Reasm_Nominal() */
+
+static void Reasm_Reordered(void)
+{
+    size_t MsgSz = 0;
+
+    Reset();
+
+    /* two messages, fragments out of order and one duplicated */
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 2, 0, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(2, 600, 512, 1, 0, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 0, 0, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 0, 0, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(2, 600, 512, 0, 0, &MsgSz), SBN_SUCCESS);
+
+    UtAssert_True(MsgSz == 600 && memcmp(Out, Msg, 600) == 0, "second message intact");
+
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 1, 0, &MsgSz), SBN_SUCCESS);
+
+    UtAssert_True(MsgSz == 1200 && memcmp(Out, Msg, 1200) == 0, "first message intact");
+    UtAssert_True(Cnts[0].MsgRxCnt == 2 && Cnts[0].DropCnt == 0, "counters");
+} /* end Reasm_Reordered() */
+
+static void Reasm_Timeout(void)
+{
+    size_t MsgSz = 0;
+
+    Reset();
+
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 0, 0, &MsgSz), SBN_IF_EMPTY);
+
+    /* the rest arrives too late, as the start of a new message */
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 1, SBN_UDP_REASM_TIMEOUT_MS + 1, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 2, SBN_UDP_REASM_TIMEOUT_MS + 1, &MsgSz), SBN_IF_EMPTY);
+
+    UtAssert_True(Cnts[0].DropCnt == 1 && Cnts[0].MsgRxCnt == 0, "DropCnt=%d", (int)Cnts[0].DropCnt);
+} /* end Reasm_Timeout() */
+
+static void Reasm_Evict(void)
+{
+    size_t MsgSz = 0;
+    int    i     = 0;
+
+    Reset();
+
+    for (i = 0; i <= SBN_UDP_REASM_SLOTS; i++)
+    {
+        UT_TEST_FUNCTION_RC(Feed(i, 1200, 512, 0, i, &MsgSz), SBN_IF_EMPTY);
+    } /* end for */
+
+    UtAssert_True(Cnts[0].DropCnt == 1, "DropCnt=%d", (int)Cnts[0].DropCnt);
+
+    /* message 0 was the oldest and gave way, the newest completes */
+    UT_TEST_FUNCTION_RC(Feed(0, 1200, 512, 1, i, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(i - 1, 1200, 512, 1, i, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(i - 1, 1200, 512, 2, i, &MsgSz), SBN_SUCCESS);
+} /* end Reasm_Evict() */
+
+static void Reasm_BadHdr(void)
+{
+    size_t MsgSz = 0;
+
+    Reset();
+
+    /* no data */
+    UT_TEST_FUNCTION_RC(SBN_UDP_Reasm(&Reasm, Cnts, 0, 1, 42, Frag, SBN_UDP_FRAG_HDR_SZ, 0, Out, &MsgSz), SBN_ERROR);
+
+    /* index out of range */
+    SBN_UDP_FragHdr(Frag, 1, 1200, 0, 3, 3);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Reasm(&Reasm, Cnts, 0, 1, 42, Frag, sizeof(Frag), 0, Out, &MsgSz), SBN_ERROR);
+
+    /* past the end of the message */
+    SBN_UDP_FragHdr(Frag, 1, 1200, 1000, 2, 3);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Reasm(&Reasm, Cnts, 0, 1, 42, Frag, sizeof(Frag), 0, Out, &MsgSz), SBN_ERROR);
+
+    /* a fragment of another message of the same Seq */
+    UT_TEST_FUNCTION_RC(Feed(1, 1200, 512, 0, 0, &MsgSz), SBN_IF_EMPTY);
+    UT_TEST_FUNCTION_RC(Feed(1, 600, 512, 1, 0, &MsgSz), SBN_ERROR);
+
+    /* fragments that do not tile the message */
+    SBN_UDP_FragHdr(Frag, 2, 1200, 0, 0, 2);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Reasm(&Reasm, Cnts, 0, 1, 42, Frag, 100, 0, Out, &MsgSz), SBN_IF_EMPTY);
+    SBN_UDP_FragHdr(Frag, 2, 1200, 100, 1, 2);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Reasm(&Reasm, Cnts, 0, 1, 42, Frag, 100, 0, Out, &MsgSz), SBN_ERROR);
+
+    UtAssert_True(Cnts[0].ErrCnt == 5 && Cnts[0].DropCnt == 2 && Cnts[0].MsgRxCnt == 0, "ErrCnt=%d DropCnt=%d",
+                  (int)Cnts[0].ErrCnt, (int)Cnts[0].DropCnt);
+} /* end Reasm_BadHdr() */
+
+void Test_SBN_UDP_Frag(void)
+{
+    Reasm_Nominal();
+    Reasm_Reordered();
+    Reasm_Timeout();
+    Reasm_Evict();
+    Reasm_BadHdr();
+} /* end Test_SBN_UDP_Frag() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_UDP_Frag);
+}
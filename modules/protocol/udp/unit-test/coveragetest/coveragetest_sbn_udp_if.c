@@ -38,11 +38,15 @@
 #include "sbn_udp_if_coveragetest_common.h"
 #include "sbn_udp_if.h"
 #include "sbn_app.h"
+#include "os-impl-io.h"
 
 #define SBN_PROTOCOL_VERSION 6
 
 SBN_App_t SBN;
 
+/* the module reaches native sockets through the OSAL impl table, see JoinGroup() */
+OS_impl_file_internal_record_t OS_impl_filehandle_table[OS_MAX_NUM_OPEN_FILES];
+
 SBN_NetInterface_t * NetPtr;
 SBN_PeerInterface_t *PeerPtr;
 typedef struct
@@ -290,6 +294,180 @@ static void LoadNet_Nominal(void)
     EVENT_CNT(1);
 } /* end LoadNet_Nominal() */
 
+static void LoadNet_GroupErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "unknown option or value out of range (group=10.0.0.1)");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?group=10.0.0.1"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_GroupErr() */
+
+static void LoadNet_TTLErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "unknown option or value out of range (ttl=0)");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?group=239.1.1.1&ttl=0"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_TTLErr() */
+
+static void LoadNet_Group(void)
+{
+    START();
+
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)&(NetPtr->ModulePvt);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?group=239.1.1.1&ttl=4"), SBN_SUCCESS);
+
+    UtAssert_True(NetData->Multicast && NetData->TTL == 4, "multicast net (%s)", __func__);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+} /* end LoadNet_Group() */
+
+static void LoadNet_ShardsErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "unknown option or value out of range (shards=0)");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?shards=0"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_ShardsErr() */
+
+static void LoadNet_ShardsGroupErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID,
+                        "a net with a group cannot be sharded (localhost:1234?group=239.1.1.1&shards=2)");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?group=239.1.1.1&shards=2"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_ShardsGroupErr() */
+
+static void LoadNet_Shards(void)
+{
+    START();
+
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)&(NetPtr->ModulePvt);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?shards=2"), SBN_SUCCESS);
+
+    UtAssert_True(NetData->ShardCnt == 2 && NetPtr->RecvShardCnt == 2, "sharded net (%s)", __func__);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+} /* end LoadNet_Shards() */
+
+static void LoadNet_SockOptsErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "unknown option or value out of range (tos=256)");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?rcvbuf=8M&tos=256"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_SockOptsErr() */
+
+static void LoadNet_SockOpts(void)
+{
+    START();
+
+    UT_TEST_FUNCTION_RC(
+        SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?rcvbuf=8M&sndbuf=512k&busy_poll=50&tos=0xb8&prio=6"),
+        SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+} /* end LoadNet_SockOpts() */
+
+static void LoadNet_MtuErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "unknown option or value out of range (mtu=100)");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?mtu=100"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_MtuErr() */
+
+static void LoadNet_Mtu(void)
+{
+    START();
+
+    SBN_UDP_Net_t * NetData  = (SBN_UDP_Net_t *)&(NetPtr->ModulePvt);
+    SBN_UDP_Peer_t *PeerData = (SBN_UDP_Peer_t *)&(PeerPtr->ModulePvt);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?mtu=1500"), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.InitPeer(PeerPtr), SBN_SUCCESS);
+
+    UtAssert_True(NetData->Mtu == 1500 && !NetData->PathMtu && PeerData->Mtu == 1500, "net and peer MTU (%s)",
+                  __func__);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?mtu=path"), SBN_SUCCESS);
+
+    UtAssert_True(NetData->PathMtu, "path MTU (%s)", __func__);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+} /* end LoadNet_Mtu() */
+
+static void LoadNet_RelErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "unknown option or value out of range (reliable=33)");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?reliable=33"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_RelErr() */
+
+static void LoadNet_Rel(void)
+{
+    START();
+
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)&(NetPtr->ModulePvt);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?reliable=8"), SBN_SUCCESS);
+
+    UtAssert_True(NetData->RelWindow == 8, "reliable window (%s)", __func__);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+} /* end LoadNet_Rel() */
+
+static void LoadNet_FecErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_CONFIG_EID, "unknown option or value out of range (fec=17)");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?fec=17"), SBN_ERROR);
+
+    EVENT_CNT(1);
+} /* end LoadNet_FecErr() */
+
+static void LoadNet_Fec(void)
+{
+    START();
+
+    SBN_UDP_Net_t *NetData = (SBN_UDP_Net_t *)&(NetPtr->ModulePvt);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?fec=4"), SBN_SUCCESS);
+
+    UtAssert_True(NetData->FecGroup == 4, "FEC group (%s)", __func__);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+} /* end LoadNet_Fec() */
+
 void Test_SBN_UDP_LoadNet(void)
 {
     LoadNet_AddrErr();
@@ -298,6 +476,20 @@ void Test_SBN_UDP_LoadNet(void)
     LoadNet_HostErr();
     LoadNet_PortErr();
     LoadNet_Nominal();
+    LoadNet_GroupErr();
+    LoadNet_TTLErr();
+    LoadNet_Group();
+    LoadNet_ShardsErr();
+    LoadNet_ShardsGroupErr();
+    LoadNet_Shards();
+    LoadNet_SockOptsErr();
+    LoadNet_SockOpts();
+    LoadNet_MtuErr();
+    LoadNet_Mtu();
+    LoadNet_RelErr();
+    LoadNet_Rel();
+    LoadNet_FecErr();
+    LoadNet_Fec();
 } /* end Test_SBN_UDP_LoadNet() */
 
 static void LoadPeer_Nominal(void)
@@ -458,11 +650,122 @@ static void Send_Nominal(void)
     UT_TEST_FUNCTION_RC(SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, sizeof(TlmPkt), SBMsgPtr), SBN_SUCCESS);
 } /* end Send_Nominal() */
 
+static void PackMsg(void *SBNMsgBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_ProcessorID_t ProcessorID,
+                    CFE_SpacecraftID_t SpacecraftID, void *Msg)
+{
+} /* end PackMsg() */
+
+static void Send_Group(void)
+{
+    START();
+
+    SBN_ProtocolOutlet_t      Outlet;
+    SBN_PeerInterface_t *     Peer2Ptr = &NetPtr->Peers[1];
+    CFE_MSG_Message_t *       SBMsgPtr;
+    CFE_MSG_TelemetryHeader_t TlmPkt;
+    CFE_SB_MsgId_t            MsgID = 0x1234;
+
+    memset(&Outlet, 0, sizeof(Outlet));
+    Outlet.PackMsg = PackMsg;
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?group=239.1.1.1"), SBN_SUCCESS);
+
+    /* both peers subscribe to the message */
+    NetPtr->PeerCnt        = 2;
+    Peer2Ptr->Net          = NetPtr;
+    Peer2Ptr->ProcessorID  = 2;
+    Peer2Ptr->SpacecraftID = 42;
+    PeerPtr->Connected     = true;
+    Peer2Ptr->Connected    = true;
+    PeerPtr->Subs[0].MsgID = Peer2Ptr->Subs[0].MsgID = MsgID;
+    PeerPtr->SubCnt = Peer2Ptr->SubCnt = 1;
+
+    SBMsgPtr = (CFE_MSG_Message_t *)&TlmPkt;
+    CFE_MSG_Init(SBMsgPtr, MsgID, sizeof(TlmPkt));
+
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+    UT_SetDefaultReturnValue(UT_KEY(OS_SocketSendTo), sizeof(TlmPkt) + SBN_PACKED_HDR_SZ);
+
+    /* the first peer's copy goes to the group, the second's is dropped */
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, sizeof(TlmPkt), SBMsgPtr), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.Send(Peer2Ptr, SBN_APP_MSG, sizeof(TlmPkt), SBMsgPtr), SBN_SUCCESS);
+
+    UtAssert_STUB_COUNT(OS_SocketSendTo, 1);
+
+    PeerPtr->Connected  = false;
+    Peer2Ptr->Connected = false;
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+} /* end Send_Group() */
+
+static void Send_Frags(void)
+{
+    START();
+
+    SBN_ProtocolOutlet_t Outlet;
+    SBN_UDP_Peer_t *     PeerData = (SBN_UDP_Peer_t *)&(PeerPtr->ModulePvt);
+    uint8                Msg[1000];
+
+    memset(&Outlet, 0, sizeof(Outlet));
+    Outlet.PackMsg = PackMsg;
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?mtu=576"), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.InitPeer(PeerPtr), SBN_SUCCESS);
+
+    memset(Msg, 0, sizeof(Msg));
+    UT_SetDefaultReturnValue(UT_KEY(OS_SocketSendTo), SBN_UDP_MIN_MTU);
+
+    /* 1011 packed bytes, 529 data bytes to a fragment */
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, sizeof(Msg), Msg), SBN_SUCCESS);
+
+    UtAssert_True(PeerData->Mtu == SBN_UDP_MIN_MTU, "peer MTU (%s)", __func__);
+    UtAssert_STUB_COUNT(OS_SocketSendTo, 2);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+} /* end Send_Frags() */
+
+static void Send_RelTooLarge(void)
+{
+    START();
+
+    SBN_ProtocolOutlet_t Outlet;
+    CFE_SB_MsgId_t       MsgID = 0x1234;
+    uint8                Msg[SBN_UDP_REL_MAX_MSG_SZ + 1];
+
+    memset(&Outlet, 0, sizeof(Outlet));
+    Outlet.PackMsg = PackMsg;
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234?reliable=4"), SBN_SUCCESS);
+
+    PeerPtr->Subs[0].MsgID           = MsgID;
+    PeerPtr->Subs[0].QoS.Reliability = 1;
+    PeerPtr->SubCnt                  = 1;
+
+    memset(Msg, 0, sizeof(Msg));
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+
+    UT_SetDefaultReturnValue(UT_KEY(OS_SocketSendTo), sizeof(Msg) + SBN_PACKED_HDR_SZ);
+
+    UT_CheckEvent_Setup(&EventTest, SBN_UDP_SOCK_EID, "message of");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.Send(PeerPtr, SBN_APP_MSG, sizeof(Msg), Msg), SBN_SUCCESS);
+
+    UtAssert_STUB_COUNT(OS_SocketSendTo, 1);
+    EVENT_CNT(1);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+} /* end Send_RelTooLarge() */
+
 void Test_SBN_UDP_Send(void)
 {
     Send_AddrInitErr();
     Send_SendErr();
     Send_Nominal();
+    Send_Group();
+    Send_Frags();
+    Send_RelTooLarge();
 } /* end Test_SBN_UDP_LoadNet() */
 
 static int32 NoDataHook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
@@ -679,9 +982,31 @@ static void UnloadNet_Nominal(void)
     UtAssert_True(PeerPtr->Connected == false, "Peer still connected (%s)", __func__);
 } /* end UnloadNet_Nominal() */
 
+static void UnloadNet_Shared(void)
+{
+    START();
+
+    SBN_NetInterface_t *OtherNet  = &SBN.Nets[1];
+    SBN_UDP_Net_t *     NetData   = (SBN_UDP_Net_t *)&(NetPtr->ModulePvt);
+    SBN_UDP_Net_t *     OtherData = (SBN_UDP_Net_t *)&(OtherNet->ModulePvt);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234"), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(OtherNet, "localhost:1235"), SBN_SUCCESS);
+
+    /* a net loaded while another is still loaded does not take its tables */
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.LoadNet(NetPtr, "localhost:1234"), SBN_SUCCESS);
+    UtAssert_True(NetData->BufNum != OtherData->BufNum, "BufNum %d, other net's %d", NetData->BufNum,
+                  OtherData->BufNum);
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(NetPtr), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDP_Ops.UnloadNet(OtherNet), SBN_SUCCESS);
+} /* end UnloadNet_Shared() */
+
 void Test_SBN_UDP_UnloadNet(void)
 {
     UnloadNet_Nominal();
+    UnloadNet_Shared();
 } /* end Test_SBN_UDP_UnloadPeer() */
 
 /*
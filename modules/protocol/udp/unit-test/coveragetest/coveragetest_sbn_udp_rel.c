@@ -0,0 +1,222 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_udp_rel.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN UDP reliable delivery
+*/
+
+#include "sbn_udp_if_coveragetest_common.h"
+#include "sbn_udp_rel.h"
+
+/* a sender and a receiver, each with the one peer, in separate pools as on separate nodes */
+static SBN_UDP_RelPool_t TxPool, RxPool;
+static SBN_UDP_RelPeer_t Tx, Rx;
+
+static uint8 Msg[32];
+static uint8 Ack[SBN_UDP_ACK_SZ];
+
+static void Reset(void)
+{
+    memset(&Tx, 0, sizeof(Tx));
+    memset(&Rx, 0, sizeof(Rx));
+    memset(Msg, 0x5A, sizeof(Msg));
+
+    SBN_UDP_RelInit(&TxPool, 0x1234);
+    SBN_UDP_RelInit(&RxPool, 0);
+} /* end Reset() */
+
+/* queues a message to the receiver, returning the slot to "send" */
+static SBN_UDP_RelSlot_t *Queue(uint32 NowMs)
+{
+    SBN_UDP_RelSlot_t *Slot = NULL;
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_RelQueue(&TxPool, &Tx, 0, 0, 4, SBN_APP_MSG, Msg, sizeof(Msg), NowMs, &Slot),
+                        SBN_SUCCESS);
+
+    return Slot;
+} /* end Queue() */
+
+static SBN_Status_t Deliver(SBN_UDP_RelSlot_t *Slot, bool *AckNowPtr)
+{
+    return SBN_UDP_RelRecv(&RxPool, &Rx, 0, 0, Slot->Buf, Slot->Sz, 0, AckNowPtr);
+} /* end Deliver() */
+
+static void Rel_Nominal(void)
+{
+    SBN_UDP_RelSlot_t *Slot   = NULL;
+    bool               AckNow = false;
+
+    Reset();
+
+    UtAssert_True(RxPool.Epoch == 1, "epoch 0 taken as 1");
+
+    Slot = Queue(0);
+    UtAssert_True(Slot->Sz == SBN_UDP_REL_HDR_SZ + sizeof(Msg), "slot size %d", (int)Slot->Sz);
+    UtAssert_True(memcmp(Slot->Buf + SBN_UDP_REL_HDR_SZ, Msg, sizeof(Msg)) == 0, "message follows the header");
+    UtAssert_True(Slot->Buf[SBN_UDP_REL_TYPE_OFS] == SBN_APP_MSG, "type in the header");
+
+    UT_TEST_FUNCTION_RC(Deliver(Slot, &AckNow), SBN_SUCCESS);
+    UtAssert_True(!AckNow && Rx.AckOwed == 1, "ack owed, not yet sent");
+
+    UT_TEST_FUNCTION_RC(Deliver(Queue(10), &AckNow), SBN_SUCCESS);
+    UtAssert_True(AckNow, "ack every %d", SBN_UDP_REL_ACK_EVERY);
+
+    SBN_UDP_RelPutAck(&Rx, Ack);
+    SBN_UDP_RelAck(&TxPool, &Tx, 0, 0, Ack, 30);
+
+    UtAssert_True(Tx.InFlight == 0 && Tx.AckedCnt == 2 && Rx.RxCnt == 2 && Rx.AckOwed == 0, "all acked");
+    UtAssert_True(Tx.HaveRtt && Tx.SrttMs == 28 && Tx.RtoMs >= SBN_UDP_REL_MIN_RTO_MS, "srtt %d rto %d",
+                  (int)Tx.SrttMs, (int)Tx.RtoMs);
+} /* end Rel_Nominal() */
+
+static void Rel_Lost(void)
+{
+    SBN_UDP_RelSlot_t *Lost   = NULL;
+    bool               AckNow = false;
+
+    Reset();
+
+    UT_TEST_FUNCTION_RC(Deliver(Queue(0), &AckNow), SBN_SUCCESS);
+    Lost = Queue(0);
+    UT_TEST_FUNCTION_RC(Deliver(Queue(0), &AckNow), SBN_SUCCESS);
+    UtAssert_True(AckNow, "a gap is acked at once");
+
+    /* the selective ack frees the messages either side of the lost one */
+    SBN_UDP_RelPutAck(&Rx, Ack);
+    SBN_UDP_RelAck(&TxPool, &Tx, 0, 0, Ack, 0);
+    UtAssert_True(Tx.InFlight == 1 && Tx.AckedCnt == 2, "InFlight=%d", (int)Tx.InFlight);
+
+    UtAssert_True(SBN_UDP_RelDue(&TxPool, &Tx, 0, 0, SBN_UDP_REL_MIN_RTO_MS - 1) == NULL, "not yet due");
+    UtAssert_True(SBN_UDP_RelDue(&TxPool, &Tx, 0, 0, SBN_UDP_REL_MIN_RTO_MS) == Lost, "due");
+    UtAssert_True(SBN_UDP_RelDue(&TxPool, &Tx, 0, 0, SBN_UDP_REL_MIN_RTO_MS) == NULL, "resent once");
+
+    UT_TEST_FUNCTION_RC(Deliver(Lost, &AckNow), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(Deliver(Lost, &AckNow), SBN_IF_EMPTY);
+    UtAssert_True(AckNow && Rx.DupCnt == 1 && Rx.RecvNext == 3 && Rx.RecvMask == 0, "RecvNext=%d",
+                  (int)Rx.RecvNext);
+
+    SBN_UDP_RelPutAck(&Rx, Ack);
+    SBN_UDP_RelAck(&TxPool, &Tx, 0, 0, Ack, 500);
+    UtAssert_True(Tx.InFlight == 0 && Tx.RetxCnt == 1, "resend acked");
+} /* end Rel_Lost() */
+
+static void Rel_GiveUp(void)
+{
+    SBN_UDP_RelSlot_t *Slot   = NULL;
+    bool               AckNow = false;
+    uint32             NowMs  = 0;
+    int                i      = 0;
+
+    Reset();
+
+    Queue(0);
+
+    for (i = 0; i < SBN_UDP_REL_MAX_RETX; i++)
+    {
+        NowMs += SBN_UDP_REL_MAX_RTO_MS;
+        UtAssert_True(SBN_UDP_RelDue(&TxPool, &Tx, 0, 0, NowMs) != NULL, "resend %d", i);
+    } /* end for */
+
+    NowMs += SBN_UDP_REL_MAX_RTO_MS;
+    UtAssert_True(SBN_UDP_RelDue(&TxPool, &Tx, 0, 0, NowMs) == NULL, "given up");
+    UtAssert_True(Tx.GiveUpCnt == 1 && Tx.InFlight == 0, "GiveUpCnt=%d", (int)Tx.GiveUpCnt);
+
+    /* the next message's Base tells the receiver to stop waiting */
+    Slot = Queue(NowMs);
+    UT_TEST_FUNCTION_RC(Deliver(Slot, &AckNow), SBN_SUCCESS);
+    UtAssert_True(Rx.RecvNext == 2, "RecvNext=%d", (int)Rx.RecvNext);
+} /* end Rel_GiveUp() */
+
+static void Rel_Full(void)
+{
+    SBN_UDP_RelSlot_t *Slot = NULL;
+    int                i    = 0;
+
+    Reset();
+
+    for (i = 0; i < 4; i++)
+    {
+        Queue(0);
+    } /* end for */
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_RelQueue(&TxPool, &Tx, 0, 0, 4, SBN_APP_MSG, Msg, sizeof(Msg), 0, &Slot), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(
+        SBN_UDP_RelQueue(&TxPool, &Tx, 0, 0, 4, SBN_APP_MSG, Msg, SBN_UDP_REL_MAX_MSG_SZ + 1, 0, &Slot), SBN_ERROR);
+    UtAssert_True(Tx.FullCnt == 1, "FullCnt=%d", (int)Tx.FullCnt);
+
+    SBN_UDP_RelReset(&TxPool, &Tx, 0, 0);
+    UtAssert_True(Tx.InFlight == 0 && Tx.GiveUpCnt == 4, "reset gives up");
+} /* end Rel_Full() */
+
+static void Rel_Restart(void)
+{
+    bool AckNow = false;
+
+    Reset();
+
+    UT_TEST_FUNCTION_RC(Deliver(Queue(0), &AckNow), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(Deliver(Queue(0), &AckNow), SBN_SUCCESS);
+
+    /* the sender restarts, numbering from 0 in a new epoch */
+    memset(&Tx, 0, sizeof(Tx));
+    SBN_UDP_RelInit(&TxPool, 0x4321);
+
+    UT_TEST_FUNCTION_RC(Deliver(Queue(0), &AckNow), SBN_SUCCESS);
+    UtAssert_True(Rx.PeerEpoch == 0x4321 && Rx.RecvNext == 1, "RecvNext=%d", (int)Rx.RecvNext);
+
+    /* an ack for the old epoch is ignored */
+    Ack[0] = 0x12;
+    Ack[1] = 0x34;
+    memset(Ack + 2, 0xFF, sizeof(Ack) - 2);
+    SBN_UDP_RelAck(&TxPool, &Tx, 0, 0, Ack, 0);
+    UtAssert_True(Tx.InFlight == 1, "old ack ignored");
+
+    UT_TEST_FUNCTION_RC(SBN_UDP_RelRecv(&RxPool, &Rx, 0, 0, Msg, SBN_UDP_REL_HDR_SZ - 1, 0, &AckNow), SBN_ERROR);
+} /* end Rel_Restart() */
+
+void Test_SBN_UDP_Rel(void)
+{
+    Rel_Nominal();
+    Rel_Lost();
+    Rel_GiveUp();
+    Rel_Full();
+    Rel_Restart();
+} /* end Test_SBN_UDP_Rel() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_UDP_Rel);
+}
@@ -0,0 +1,23 @@
+/**
+ * @file
+ *
+ * This file contains several user-configurable parameters
+ */
+#ifndef _uds_platform_cfg_h_
+#define _uds_platform_cfg_h_
+
+#define SBN_UDS_MAX_PATH 64 /**< How long a socket path can be in a net or peer address */
+
+#define SBN_UDS_MAX_NETS 2 /**< How many UDS nets (listening sockets) this module can drive */
+
+#define SBN_UDS_MAX_CONNS SBN_MAX_PEER_CNT /**< How many incoming connections each net accepts */
+
+/**
+ * Default for the "memfd" net address option: packed messages of at least
+ * this many bytes are handed to the peer in a sealed memfd rather than copied
+ * through the socket, 0 to always send inline.
+ */
+#define SBN_UDS_DEFAULT_MEMFD_SZ 16384
+
+#define SBN_UDS_PEER_HEARTBEAT 5
+#endif
@@ -0,0 +1,12 @@
+#ifndef _sbn_uds_events_h
+#define _sbn_uds_events_h
+
+#include "sbn_types.h"
+
+extern CFE_EVS_EventID_t SBN_UDS_FIRST_EID; /* defined at module init time */
+
+#define SBN_UDS_SOCK_EID   SBN_UDS_FIRST_EID + 1 /* skip 0th */
+#define SBN_UDS_CONFIG_EID SBN_UDS_FIRST_EID + 2
+#define SBN_UDS_DEBUG_EID  SBN_UDS_FIRST_EID + 3
+
+#endif /* _sbn_uds_events_h */
@@ -0,0 +1,777 @@
+#define _GNU_SOURCE /* memfd_create(), accept4() */
+
+#include "sbn_uds_if.h"
+#include "sbn_module_util.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+CFE_EVS_EventID_t SBN_UDS_FIRST_EID;
+
+#define EXP_VERSION 6
+
+static SBN_ProtocolOutlet_t SBN;
+
+/* an accepted connection, messages from it are received by the net */
+typedef struct
+{
+    int                  FD;
+    SBN_PeerInterface_t *Peer; /* affiliated peer, if known */
+} SBN_UDS_Conn_t;
+
+/* per-net receive state, too big for the net's ModulePvt */
+typedef struct
+{
+    SBN_UDS_Conn_t Conns[SBN_UDS_MAX_CONNS];
+
+    /** @brief The connection to receive from first, so that a busy one does not starve the rest. */
+    int NextConn;
+
+    uint8 RecvBuf[SBN_MAX_PACKED_MSG_SZ];
+} SBN_UDS_NetState_t;
+
+static SBN_UDS_NetState_t NetStates[SBN_UDS_MAX_NETS];
+static uint8              NetCnt       = 0;
+static uint8              LoadedNetCnt = 0;
+
+/* per-peer counters, reported as the module status */
+typedef struct
+{
+    uint32 TxInlineCnt, TxMemFDCnt, TxErrCnt, RxInlineCnt, RxMemFDCnt;
+} SBN_UDS_Stats_t;
+
+static SBN_UDS_Stats_t Stats[SBN_UDS_MAX_NETS][SBN_MAX_PEER_CNT];
+
+#define PEER_STATS(Peer) \
+    (&Stats[((SBN_UDS_Net_t *)(Peer)->Net->ModulePvt)->BufNum][(Peer) - (Peer)->Net->Peers])
+
+static SBN_Status_t Init(int Version, CFE_EVS_EventID_t BaseEID, SBN_ProtocolOutlet_t *Outlet)
+{
+    SBN_UDS_FIRST_EID = BaseEID;
+
+    if (Version != EXP_VERSION)
+    {
+        OS_printf("SBN_UDS version mismatch: expected %d, got %d\n", EXP_VERSION, Version);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (Outlet == NULL)
+    {
+        OS_printf("SBN_UDS outlet is NULL\n");
+        return SBN_ERROR;
+    } /* end if */
+
+    /* copy outlet pointers to a local buffer for later use */
+    memcpy(&SBN, Outlet, sizeof(SBN));
+
+    OS_printf("SBN_UDS Lib Initialized.\n");
+    return SBN_SUCCESS;
+} /* end Init() */
+
+static void SetAddr(struct sockaddr_un *Addr, const char *Path)
+{
+    memset(Addr, 0, sizeof(*Addr));
+    Addr->sun_family = AF_UNIX;
+    strncpy(Addr->sun_path, Path, sizeof(Addr->sun_path) - 1);
+} /* end SetAddr() */
+
+/**
+ * Copies the socket path from an address, up to any "?" options.
+ *
+ * @return SBN_SUCCESS, or SBN_ERROR if the path is empty or too long.
+ */
+static SBN_Status_t ConfPath(char *Path, const char *Address)
+{
+    size_t PathLen = strcspn(Address, "?");
+
+    if (PathLen == 0 || PathLen >= SBN_UDS_MAX_PATH)
+    {
+        EVSSendErr(SBN_UDS_CONFIG_EID, "invalid socket path (Address=%s)", Address);
+        return SBN_ERROR;
+    } /* end if */
+
+    memset(Path, 0, SBN_UDS_MAX_PATH);
+    strncpy(Path, Address, PathLen);
+
+    return SBN_SUCCESS;
+} /* end ConfPath() */
+
+static SBN_Status_t LoadNet(SBN_NetInterface_t *Net, const char *Address)
+{
+    SBN_UDS_Net_t *NetData = (SBN_UDS_Net_t *)Net->ModulePvt;
+    const char *   Opt     = strchr(Address, '?');
+
+    EVSSendInfo(SBN_UDS_CONFIG_EID, "configuring net (Address=%s)", Address);
+
+    if (NetCnt >= SBN_UDS_MAX_NETS)
+    {
+        EVSSendErr(SBN_UDS_CONFIG_EID, "too many UDS nets (max=%d)", SBN_UDS_MAX_NETS);
+        return SBN_ERROR;
+    } /* end if */
+
+    if (ConfPath(NetData->Path, Address) != SBN_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    NetData->MemFDSz = SBN_UDS_DEFAULT_MEMFD_SZ;
+
+    while (Opt != NULL)
+    {
+        Opt++; /* skip the '?' or '&' */
+
+        const char *Eq          = strchr(Opt, '=');
+        char *      ValidatePtr = NULL;
+        size_t      Len         = Eq ? (size_t)(Eq - Opt) : 0;
+
+        unsigned long Val = Eq ? strtoul(Eq + 1, &ValidatePtr, 0) : 0;
+
+        if (!Eq || ValidatePtr == Eq + 1 || (*ValidatePtr != '\0' && *ValidatePtr != '&'))
+        {
+            EVSSendErr(SBN_UDS_CONFIG_EID, "invalid option (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        if (SBN_OPT_IS(Opt, Len, "memfd"))
+        {
+            NetData->MemFDSz = Val;
+        }
+        else
+        {
+            EVSSendErr(SBN_UDS_CONFIG_EID, "unknown option (%s)", Opt);
+            return SBN_ERROR;
+        } /* end if */
+
+        Opt = strchr(Opt, '&');
+    } /* end while */
+
+#ifndef MFD_ALLOW_SEALING
+    NetData->MemFDSz = 0; /* no memfd on this platform, always send inline */
+#endif
+
+    NetData->ListenFD = -1;
+    NetData->BufNum   = NetCnt++;
+    LoadedNetCnt++;
+
+    return SBN_SUCCESS;
+} /* end LoadNet() */
+
+static SBN_Status_t LoadPeer(SBN_PeerInterface_t *Peer, const char *Address)
+{
+    SBN_UDS_Peer_t *PeerData = (SBN_UDS_Peer_t *)Peer->ModulePvt;
+
+    EVSSendInfo(SBN_UDS_CONFIG_EID, "configuring peer (SC=%d, CPU=%d, Address=%s)", Peer->SpacecraftID,
+                Peer->ProcessorID, Address);
+
+    if (ConfPath(PeerData->Path, Address) != SBN_SUCCESS)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    PeerData->FD = -1;
+
+    return SBN_SUCCESS;
+} /* end LoadPeer() */
+
+/**
+ * Creates the net's listening socket, replacing any stale socket file.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS on success, error code otherwise
+ */
+static SBN_Status_t InitNet(SBN_NetInterface_t *Net)
+{
+    SBN_UDS_Net_t *     NetData = (SBN_UDS_Net_t *)Net->ModulePvt;
+    SBN_UDS_NetState_t *State   = &NetStates[NetData->BufNum];
+    struct sockaddr_un  Addr;
+    int                 i = 0;
+
+    for (i = 0; i < SBN_UDS_MAX_CONNS; i++)
+    {
+        State->Conns[i].FD   = -1;
+        State->Conns[i].Peer = NULL;
+    } /* end for */
+
+    State->NextConn = 0;
+
+    memset(Stats[NetData->BufNum], 0, sizeof(Stats[NetData->BufNum]));
+
+    NetData->ListenFD = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (NetData->ListenFD < 0)
+    {
+        EVSSendErr(SBN_UDS_SOCK_EID, "socket call failed (errno=%d)", errno);
+        return SBN_ERROR;
+    } /* end if */
+
+    SetAddr(&Addr, NetData->Path);
+    unlink(NetData->Path);
+
+    if (bind(NetData->ListenFD, (struct sockaddr *)&Addr, sizeof(Addr)) < 0
+        || listen(NetData->ListenFD, SBN_UDS_MAX_CONNS) < 0)
+    {
+        EVSSendErr(SBN_UDS_SOCK_EID, "bind/listen failed (Path=%s, errno=%d)", NetData->Path, errno);
+        close(NetData->ListenFD);
+        NetData->ListenFD = -1;
+        return SBN_ERROR;
+    } /* end if */
+
+    EVSSendInfo(SBN_UDS_SOCK_EID, "listening on %s (memfd=%d)", NetData->Path, (int)NetData->MemFDSz);
+
+    return SBN_SUCCESS;
+} /* end InitNet() */
+
+/**
+ * Peers are connected to when polled.
+ *
+ * @param  Interface data structure containing the file entry
+ * @return SBN_SUCCESS
+ */
+static SBN_Status_t InitPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_UDS_Peer_t *PeerData = (SBN_UDS_Peer_t *)Peer->ModulePvt;
+
+    PeerData->FD = -1;
+    memset(&PeerData->LastConnTry, 0, sizeof(PeerData->LastConnTry));
+
+    return SBN_SUCCESS;
+} /* end InitPeer() */
+
+/** closes the connection to the peer, it is reconnected when next polled */
+static void ClosePeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_UDS_Peer_t *PeerData = (SBN_UDS_Peer_t *)Peer->ModulePvt;
+
+    if (PeerData->FD >= 0)
+    {
+        close(PeerData->FD);
+        PeerData->FD = -1;
+    } /* end if */
+
+    if (Peer->Connected)
+    {
+        SBN.Disconnected(Peer);
+    } /* end if */
+} /* end ClosePeer() */
+
+static SBN_Status_t PollPeer(SBN_PeerInterface_t *Peer)
+{
+    SBN_UDS_Peer_t *   PeerData = (SBN_UDS_Peer_t *)Peer->ModulePvt;
+    struct sockaddr_un Addr;
+    OS_time_t          CurrentTime;
+
+    OS_GetLocalTime(&CurrentTime);
+
+    if (PeerData->FD < 0)
+    {
+        if (OS_TimeGetTotalSeconds(PeerData->LastConnTry) != 0
+            && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, PeerData->LastConnTry)) < SBN_UDS_CONNTRY_TIME)
+        {
+            return SBN_SUCCESS;
+        } /* end if */
+
+        PeerData->LastConnTry = CurrentTime;
+
+        PeerData->FD = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        if (PeerData->FD < 0)
+        {
+            EVSSendErr(SBN_UDS_SOCK_EID, "socket call failed (errno=%d)", errno);
+            return SBN_ERROR;
+        } /* end if */
+
+        SetAddr(&Addr, PeerData->Path);
+
+        if (connect(PeerData->FD, (struct sockaddr *)&Addr, sizeof(Addr)) < 0)
+        {
+            /* peer not up yet */
+            EVSSendDbg(SBN_UDS_DEBUG_EID, "unable to connect to %s (errno=%d)", PeerData->Path, errno);
+            close(PeerData->FD);
+            PeerData->FD = -1;
+            return SBN_SUCCESS;
+        } /* end if */
+
+        EVSSendInfo(SBN_UDS_DEBUG_EID, "connected to peer %d:%d (%s)", Peer->SpacecraftID, Peer->ProcessorID,
+                    PeerData->Path);
+
+        if (!Peer->Connected)
+        {
+            return SBN.Connected(Peer);
+        } /* end if */
+
+        return SBN_SUCCESS;
+    } /* end if */
+
+    /* a heartbeat finds a peer that has gone away, should its connection close unnoticed */
+    if (Peer->Connected && SBN_UDS_PEER_HEARTBEAT > 0
+        && OS_TimeGetTotalSeconds(OS_TimeSubtract(CurrentTime, Peer->LastSend)) > SBN_UDS_PEER_HEARTBEAT)
+    {
+        OS_GetLocalTime(&Peer->LastSend);
+        EVSSendDbg(SBN_UDS_DEBUG_EID, "sending heartbeat to peer %d:%d", Peer->SpacecraftID, Peer->ProcessorID);
+        return SBN.SendNetMsg(SBN_UDS_HEARTBEAT_MSG, 0, NULL, Peer);
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end PollPeer() */
+
+#ifdef MFD_ALLOW_SEALING
+/**
+ * Packs the message straight into a sealed memfd and passes the descriptor to
+ * the peer, so a large message is neither copied through the socket nor held
+ * in its buffer.
+ */
+static SBN_Status_t SendMemFD(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_UDS_Peer_t *PeerData = (SBN_UDS_Peer_t *)Peer->ModulePvt;
+    size_t          PackedSz = MsgSz + SBN_PACKED_HDR_SZ;
+    uint8           Notice[SBN_PACKED_HDR_SZ + 4], Size[4];
+    struct iovec    Iov;
+    struct msghdr   Msg;
+    struct cmsghdr *Cmsg  = NULL;
+    void *          Map   = NULL;
+    int             MemFD = -1;
+    ssize_t         Sent  = 0;
+    union
+    {
+        struct cmsghdr Align;
+        char           Buf[CMSG_SPACE(sizeof(int))];
+    } Ctrl;
+
+    MemFD = memfd_create("sbn_uds", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (MemFD < 0)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    if (ftruncate(MemFD, PackedSz) < 0
+        || (Map = mmap(NULL, PackedSz, PROT_READ | PROT_WRITE, MAP_SHARED, MemFD, 0)) == MAP_FAILED)
+    {
+        close(MemFD);
+        return SBN_ERROR;
+    } /* end if */
+
+    SBN.PackMsg(Map, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Payload);
+    munmap(Map, PackedSz);
+
+    /* the receiver maps it, it must not change size or content under them */
+    if (fcntl(MemFD, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+    {
+        close(MemFD);
+        return SBN_ERROR;
+    } /* end if */
+
+    Size[0] = (PackedSz >> 24) & 0xFF;
+    Size[1] = (PackedSz >> 16) & 0xFF;
+    Size[2] = (PackedSz >> 8) & 0xFF;
+    Size[3] = PackedSz & 0xFF;
+    SBN.PackMsg(Notice, sizeof(Size), SBN_UDS_MEMFD_MSG, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Size);
+
+    Iov.iov_base = Notice;
+    Iov.iov_len  = sizeof(Notice);
+
+    memset(&Msg, 0, sizeof(Msg));
+    memset(&Ctrl, 0, sizeof(Ctrl));
+    Msg.msg_iov        = &Iov;
+    Msg.msg_iovlen     = 1;
+    Msg.msg_control    = Ctrl.Buf;
+    Msg.msg_controllen = sizeof(Ctrl.Buf);
+
+    Cmsg             = CMSG_FIRSTHDR(&Msg);
+    Cmsg->cmsg_level = SOL_SOCKET;
+    Cmsg->cmsg_type  = SCM_RIGHTS;
+    Cmsg->cmsg_len   = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(Cmsg), &MemFD, sizeof(int));
+
+    Sent = sendmsg(PeerData->FD, &Msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+    /* the peer holds its own reference once sent */
+    close(MemFD);
+
+    return Sent == sizeof(Notice) ? SBN_SUCCESS : SBN_ERROR;
+} /* end SendMemFD() */
+#endif /* MFD_ALLOW_SEALING */
+
+static SBN_Status_t Send(SBN_PeerInterface_t *Peer, SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Payload)
+{
+    SBN_UDS_Peer_t * PeerData = (SBN_UDS_Peer_t *)Peer->ModulePvt;
+    SBN_UDS_Net_t *  NetData  = (SBN_UDS_Net_t *)Peer->Net->ModulePvt;
+    SBN_UDS_Stats_t *PStats   = PEER_STATS(Peer);
+    int32            BufSz    = MsgSz + SBN_PACKED_HDR_SZ;
+    SBN_Status_t     Status   = SBN_SUCCESS;
+
+    if (PeerData->FD < 0)
+    {
+        /* fail silently as the peer is not connected (yet) */
+        return SBN_SUCCESS;
+    } /* end if */
+
+#ifdef MFD_ALLOW_SEALING
+    if (NetData->MemFDSz && (uint32)BufSz >= NetData->MemFDSz)
+    {
+        Status = SendMemFD(Peer, MsgType, MsgSz, Payload);
+        if (Status == SBN_SUCCESS)
+        {
+            PStats->TxMemFDCnt++;
+        } /* end if */
+    }
+    else
+#endif /* MFD_ALLOW_SEALING */
+    {
+        uint8 Buf[BufSz];
+
+        SBN.PackMsg(Buf, MsgSz, MsgType, CFE_PSP_GetProcessorId(), CFE_PSP_GetSpacecraftId(), Payload);
+
+        /* one message per send, SOCK_SEQPACKET keeps the boundaries */
+        if (send(PeerData->FD, Buf, BufSz, MSG_NOSIGNAL | MSG_DONTWAIT) != BufSz)
+        {
+            Status = SBN_ERROR;
+        }
+        else
+        {
+            PStats->TxInlineCnt++;
+        } /* end if */
+    }     /* end if */
+
+    if (Status != SBN_SUCCESS)
+    {
+        PStats->TxErrCnt++;
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            /* the peer is not keeping up, drop this message rather than block */
+            EVSSendMsgDbg(SBN_UDS_SOCK_EID, "peer %d:%d busy, message dropped", Peer->SpacecraftID, Peer->ProcessorID);
+        }
+        else
+        {
+            EVSSendErr(SBN_UDS_SOCK_EID, "send to %s failed (errno=%d), disconnecting", PeerData->Path, errno);
+            ClosePeer(Peer);
+        } /* end if */
+    }     /* end if */
+
+    return Status;
+} /* end Send() */
+
+/** closes an accepted connection, a closed connection means the peer has gone */
+static void CloseConn(SBN_UDS_Conn_t *Conn)
+{
+    close(Conn->FD);
+    Conn->FD = -1;
+
+    if (Conn->Peer)
+    {
+        EVSSendInfo(SBN_UDS_DEBUG_EID, "peer %d:%d closed its connection", Conn->Peer->SpacecraftID,
+                    Conn->Peer->ProcessorID);
+        ClosePeer(Conn->Peer);
+        Conn->Peer = NULL;
+    } /* end if */
+} /* end CloseConn() */
+
+static void AcceptConn(SBN_UDS_Net_t *NetData, SBN_UDS_NetState_t *State)
+{
+    int FD = accept4(NetData->ListenFD, NULL, NULL, SOCK_CLOEXEC);
+    int i  = 0;
+
+    if (FD < 0)
+    {
+        return;
+    } /* end if */
+
+    for (i = 0; i < SBN_UDS_MAX_CONNS; i++)
+    {
+        if (State->Conns[i].FD < 0)
+        {
+            State->Conns[i].FD   = FD;
+            State->Conns[i].Peer = NULL;
+            return;
+        } /* end if */
+    }     /* end for */
+
+    EVSSendErr(SBN_UDS_SOCK_EID, "too many connections on %s", NetData->Path);
+    close(FD);
+} /* end AcceptConn() */
+
+/**
+ * Unpacks a message handed over in a memfd, checking that it is sealed and
+ * the size the notice says before mapping it.
+ */
+static SBN_Status_t RecvMemFD(int MemFD, uint8 *Size, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                              CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    size_t      PackedSz = ((size_t)Size[0] << 24) | (Size[1] << 16) | (Size[2] << 8) | Size[3];
+    struct stat St;
+    uint8 *     Map    = NULL;
+    bool        Status = false;
+
+    if (MemFD < 0)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+#ifdef MFD_ALLOW_SEALING
+    int Seals = fcntl(MemFD, F_GET_SEALS);
+
+    if (PackedSz >= SBN_PACKED_HDR_SZ && PackedSz <= SBN_MAX_PACKED_MSG_SZ && Seals >= 0
+        && (Seals & (F_SEAL_SHRINK | F_SEAL_WRITE)) == (F_SEAL_SHRINK | F_SEAL_WRITE) && fstat(MemFD, &St) == 0
+        && (size_t)St.st_size >= PackedSz
+        && (Map = mmap(NULL, PackedSz, PROT_READ, MAP_SHARED, MemFD, 0)) != MAP_FAILED)
+    {
+        /* the packed size must account for the whole mapping before unpacking from it */
+        if (SBN_PACKED_HDR_SZ + (size_t)((Map[0] << 8) | Map[1]) == PackedSz)
+        {
+            Status = SBN.UnpackMsg(Map, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload);
+        } /* end if */
+
+        munmap(Map, PackedSz);
+    } /* end if */
+#endif /* MFD_ALLOW_SEALING */
+
+    close(MemFD);
+
+    return Status ? SBN_SUCCESS : SBN_ERROR;
+} /* end RecvMemFD() */
+
+/** receives one message from an accepted connection */
+static SBN_Status_t RecvConn(SBN_NetInterface_t *Net, SBN_UDS_Conn_t *Conn, SBN_MsgType_t *MsgTypePtr,
+                             SBN_MsgSz_t *MsgSzPtr, CFE_ProcessorID_t *ProcessorIDPtr,
+                             CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_UDS_Net_t *      NetData = (SBN_UDS_Net_t *)Net->ModulePvt;
+    SBN_UDS_NetState_t * State   = &NetStates[NetData->BufNum];
+    SBN_PeerInterface_t *Peer    = NULL;
+    struct iovec         Iov;
+    struct msghdr        Msg;
+    struct cmsghdr *     Cmsg     = NULL;
+    int                  PassedFD = -1;
+    ssize_t              Received = 0;
+    bool                 ViaMemFD = false;
+    union
+    {
+        struct cmsghdr Align;
+        char           Buf[CMSG_SPACE(sizeof(int))];
+    } Ctrl;
+
+    Iov.iov_base = State->RecvBuf;
+    Iov.iov_len  = sizeof(State->RecvBuf);
+
+    memset(&Msg, 0, sizeof(Msg));
+    Msg.msg_iov        = &Iov;
+    Msg.msg_iovlen     = 1;
+    Msg.msg_control    = Ctrl.Buf;
+    Msg.msg_controllen = sizeof(Ctrl.Buf);
+
+    Received = recvmsg(Conn->FD, &Msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+
+    if (Received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    if (Received <= 0)
+    {
+        CloseConn(Conn);
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    for (Cmsg = CMSG_FIRSTHDR(&Msg); Cmsg != NULL; Cmsg = CMSG_NXTHDR(&Msg, Cmsg))
+    {
+        if (Cmsg->cmsg_level == SOL_SOCKET && Cmsg->cmsg_type == SCM_RIGHTS && Cmsg->cmsg_len >= CMSG_LEN(sizeof(int)))
+        {
+            memcpy(&PassedFD, CMSG_DATA(Cmsg), sizeof(int));
+        } /* end if */
+    }     /* end for */
+
+    if ((Msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) || (size_t)Received < SBN_PACKED_HDR_SZ
+        || SBN_PACKED_HDR_SZ + (size_t)((State->RecvBuf[0] << 8) | State->RecvBuf[1]) != (size_t)Received
+        || !SBN.UnpackMsg(State->RecvBuf, MsgSzPtr, MsgTypePtr, ProcessorIDPtr, SpacecraftIDPtr, Payload))
+    {
+        EVSSendErrLimited(SBN_UDS_SOCK_EID, "invalid message on %s (%d bytes)", NetData->Path, (int)Received);
+
+        if (PassedFD >= 0)
+        {
+            close(PassedFD);
+        } /* end if */
+
+        return SBN_ERROR;
+    } /* end if */
+
+    if (*MsgTypePtr == SBN_UDS_MEMFD_MSG && *MsgSzPtr == 4)
+    {
+        ViaMemFD = true;
+
+        if (RecvMemFD(PassedFD, Payload, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, SpacecraftIDPtr, Payload)
+            != SBN_SUCCESS)
+        {
+            EVSSendErrLimited(SBN_UDS_SOCK_EID, "invalid memfd message on %s", NetData->Path);
+            return SBN_ERROR;
+        } /* end if */
+    }
+    else if (PassedFD >= 0)
+    {
+        close(PassedFD);
+    } /* end if */
+
+    Peer = SBN.GetPeer(Net, *ProcessorIDPtr, *SpacecraftIDPtr);
+    if (Peer == NULL)
+    {
+        EVSSendErrLimited(SBN_UDS_DEBUG_EID, "unknown peer %d:%d", *SpacecraftIDPtr, *ProcessorIDPtr);
+        return SBN_ERROR;
+    } /* end if */
+
+    Conn->Peer = Peer;
+
+    if (ViaMemFD)
+    {
+        PEER_STATS(Peer)->RxMemFDCnt++;
+    }
+    else
+    {
+        PEER_STATS(Peer)->RxInlineCnt++;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end RecvConn() */
+
+/* Note that this Recv function is indescriminate, messages are received
+ * from all connections, each carries its sender in the packed header.
+ */
+static SBN_Status_t Recv(SBN_NetInterface_t *Net, SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr,
+                         CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Payload)
+{
+    SBN_UDS_Net_t *     NetData = (SBN_UDS_Net_t *)Net->ModulePvt;
+    SBN_UDS_NetState_t *State   = &NetStates[NetData->BufNum];
+    struct pollfd       PollFDs[1 + SBN_UDS_MAX_CONNS];
+    int                 i = 0;
+
+    if (NetData->ListenFD < 0)
+    {
+        return SBN_IF_EMPTY;
+    } /* end if */
+
+    while (1)
+    {
+        PollFDs[0].fd     = NetData->ListenFD;
+        PollFDs[0].events = POLLIN;
+
+        for (i = 0; i < SBN_UDS_MAX_CONNS; i++)
+        {
+            /* negative descriptors are ignored by poll() */
+            PollFDs[1 + i].fd      = State->Conns[i].FD;
+            PollFDs[1 + i].events  = POLLIN;
+            PollFDs[1 + i].revents = 0;
+        } /* end for */
+
+        /* polling returns at once, otherwise block for the recv task */
+        int Ready = poll(PollFDs, 1 + SBN_UDS_MAX_CONNS, (Net->TaskFlags & SBN_TASK_RECV) ? -1 : 0);
+
+        if (Ready < 0 && errno == EINTR)
+        {
+            continue;
+        } /* end if */
+
+        if (Ready <= 0)
+        {
+            return SBN_IF_EMPTY;
+        } /* end if */
+
+        if (PollFDs[0].revents & POLLIN)
+        {
+            AcceptConn(NetData, State);
+        } /* end if */
+
+        for (i = 0; i < SBN_UDS_MAX_CONNS; i++)
+        {
+            int             ConnIdx = (State->NextConn + i) % SBN_UDS_MAX_CONNS;
+            SBN_UDS_Conn_t *Conn    = &State->Conns[ConnIdx];
+
+            if (Conn->FD < 0 || !PollFDs[1 + ConnIdx].revents)
+            {
+                continue;
+            } /* end if */
+
+            if (RecvConn(Net, Conn, MsgTypePtr, MsgSzPtr, ProcessorIDPtr, SpacecraftIDPtr, Payload) == SBN_SUCCESS)
+            {
+                State->NextConn = (ConnIdx + 1) % SBN_UDS_MAX_CONNS;
+                return SBN_SUCCESS;
+            } /* end if */
+        }     /* end for */
+    }         /* end while */
+} /* end Recv() */
+
+static SBN_Status_t UnloadPeer(SBN_PeerInterface_t *Peer)
+{
+    ClosePeer(Peer);
+
+    return SBN_SUCCESS;
+} /* end UnloadPeer() */
+
+static SBN_Status_t UnloadNet(SBN_NetInterface_t *Net)
+{
+    SBN_UDS_Net_t *     NetData = (SBN_UDS_Net_t *)Net->ModulePvt;
+    SBN_UDS_NetState_t *State   = &NetStates[NetData->BufNum];
+    int                 i       = 0;
+
+    SBN_PeerIdx_t PeerIdx = 0;
+    for (PeerIdx = 0; PeerIdx < Net->PeerCnt; PeerIdx++)
+    {
+        UnloadPeer(&Net->Peers[PeerIdx]);
+    } /* end for */
+
+    if (NetData->ListenFD >= 0)
+    {
+        for (i = 0; i < SBN_UDS_MAX_CONNS; i++)
+        {
+            if (State->Conns[i].FD >= 0)
+            {
+                close(State->Conns[i].FD);
+                State->Conns[i].FD = -1;
+            } /* end if */
+        }     /* end for */
+
+        close(NetData->ListenFD);
+        NetData->ListenFD = -1;
+        unlink(NetData->Path);
+    } /* end if */
+
+    /* the other nets' tables follow this one's, so they are only reused once all are unloaded */
+    if (LoadedNetCnt && --LoadedNetCnt == 0)
+    {
+        NetCnt = 0;
+    } /* end if */
+
+    return SBN_SUCCESS;
+} /* end UnloadNet() */
+
+/**
+ * Reports, big-endian: uint8 Flags (1=connected out), uint32 memfd size
+ * threshold, then uint32 TX inline, TX memfd, TX errors, RX inline, RX memfd.
+ */
+static SBN_Status_t ReportModuleStatus(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz)
+{
+    SBN_UDS_Peer_t * PeerData = (SBN_UDS_Peer_t *)Peer->ModulePvt;
+    SBN_UDS_Net_t *  NetData  = (SBN_UDS_Net_t *)Peer->Net->ModulePvt;
+    SBN_UDS_Stats_t *PStats   = PEER_STATS(Peer);
+    uint8 *          Ptr      = StatusBuf;
+
+    if (StatusBufSz < 1 + 6 * 4)
+    {
+        return SBN_ERROR;
+    } /* end if */
+
+    *Ptr++ = PeerData->FD >= 0 ? 1 : 0;
+    Ptr    = SBN_PutUInt32(Ptr, NetData->MemFDSz);
+    Ptr    = SBN_PutUInt32(Ptr, PStats->TxInlineCnt);
+    Ptr    = SBN_PutUInt32(Ptr, PStats->TxMemFDCnt);
+    Ptr    = SBN_PutUInt32(Ptr, PStats->TxErrCnt);
+    Ptr    = SBN_PutUInt32(Ptr, PStats->RxInlineCnt);
+    Ptr    = SBN_PutUInt32(Ptr, PStats->RxMemFDCnt);
+
+    return SBN_SUCCESS;
+} /* end ReportModuleStatus() */
+
+SBN_IfOps_t SBN_UDS_Ops = {Init, InitNet, InitPeer, LoadNet,   LoadPeer,   PollPeer,
+                           Send, NULL,    Recv,     UnloadNet, UnloadPeer, ReportModuleStatus};
@@ -0,0 +1,56 @@
+#ifndef _SBN_UDS_IF_H_
+#define _SBN_UDS_IF_H_
+
+#include "sbn_uds_events.h"
+#include "sbn_platform_cfg.h"
+#include "sbn_uds_platform_cfg.h"
+#include <string.h>
+#include <errno.h>
+
+#include "sbn_interfaces.h"
+#include "cfe.h"
+
+/**
+ * UDS-specific message types.
+ */
+#define SBN_UDS_HEARTBEAT_MSG 0xA0
+
+/**
+ * The payload is a big-endian uint32 size; the packed message of that size is
+ * in the sealed memfd passed with SCM_RIGHTS alongside.
+ */
+#define SBN_UDS_MEMFD_MSG 0xA1
+
+/**
+ * If unable to connect to the peer's socket, try again in SBN_UDS_CONNTRY_TIME seconds.
+ */
+#define SBN_UDS_CONNTRY_TIME 1
+
+typedef struct
+{
+    /** @brief The peer's listening socket path. */
+    char Path[SBN_UDS_MAX_PATH];
+
+    /** @brief The connection messages are sent on, -1 until connected. */
+    int FD;
+
+    /** @brief See SBN_UDS_CONNTRY_TIME. */
+    OS_time_t LastConnTry;
+} SBN_UDS_Peer_t;
+
+typedef struct SBN_UDS_Net_s
+{
+    /** @brief The local listening socket path. */
+    char Path[SBN_UDS_MAX_PATH];
+
+    /** @brief The listening socket, -1 until initialized. */
+    int ListenFD;
+
+    /** @brief Packed messages this size or larger go through a memfd, 0 for never (the "memfd" option.) */
+    uint32 MemFDSz;
+
+    /** @brief Index into the module's connection tables and receive buffers. */
+    uint8 BufNum;
+} SBN_UDS_Net_t;
+
+#endif /* _SBN_UDS_IF_H_ */
@@ -0,0 +1,353 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2020 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_sbn_uds_if.c
+**
+** Purpose:
+** Coverage Unit Test cases for the SBN Unix domain socket protocol module
+**
+** Notes:
+** Two nets on this processor, each with the other as its one peer, talk over
+** sockets in /tmp.
+*/
+
+#define _GNU_SOURCE /* MFD_ALLOW_SEALING, as the module sees it */
+
+#include "sbn_uds_coveragetest_common.h"
+#include "sbn_uds_if.h"
+
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define SBN_PROTOCOL_VERSION 6
+
+#define PATH_A "/tmp/sbn_uds_ut_a"
+#define PATH_B "/tmp/sbn_uds_ut_b"
+
+extern SBN_IfOps_t SBN_UDS_Ops;
+
+static SBN_NetInterface_t   NetA, NetB;
+static SBN_PeerInterface_t *PeerA = &NetB.Peers[0], *PeerB = &NetA.Peers[0];
+
+static int ConnectedCnt = 0, DisconnectedCnt = 0;
+
+/* a test-local outlet packing the same header layout as SBN */
+static void PackMsg(void *SBNBuf, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType, CFE_ProcessorID_t ProcessorID,
+                    CFE_SpacecraftID_t SpacecraftID, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    memset(Buf, 0, SBN_PACKED_HDR_SZ);
+    Buf[0] = MsgSz >> 8;
+    Buf[1] = MsgSz & 0xFF;
+    Buf[2] = MsgType;
+    Buf[3] = (ProcessorID >> 24) & 0xFF;
+    Buf[4] = (ProcessorID >> 16) & 0xFF;
+    Buf[5] = (ProcessorID >> 8) & 0xFF;
+    Buf[6] = ProcessorID & 0xFF;
+    Buf[7] = (SpacecraftID >> 24) & 0xFF;
+    Buf[8] = (SpacecraftID >> 16) & 0xFF;
+    Buf[9] = (SpacecraftID >> 8) & 0xFF;
+    Buf[10] = SpacecraftID & 0xFF;
+
+    if (MsgSz)
+    {
+        memcpy(Buf + SBN_PACKED_HDR_SZ, Msg, MsgSz);
+    } /* end if */
+} /* end PackMsg() */
+
+static bool UnpackMsg(void *SBNBuf, SBN_MsgSz_t *MsgSzPtr, SBN_MsgType_t *MsgTypePtr,
+                      CFE_ProcessorID_t *ProcessorIDPtr, CFE_SpacecraftID_t *SpacecraftIDPtr, void *Msg)
+{
+    uint8 *Buf = SBNBuf;
+
+    *MsgSzPtr        = (Buf[0] << 8) | Buf[1];
+    *MsgTypePtr      = Buf[2];
+    *ProcessorIDPtr  = ((uint32)Buf[3] << 24) | (Buf[4] << 16) | (Buf[5] << 8) | Buf[6];
+    *SpacecraftIDPtr = ((uint32)Buf[7] << 24) | (Buf[8] << 16) | (Buf[9] << 8) | Buf[10];
+
+    if (*MsgSzPtr > CFE_MISSION_SB_MAX_SB_MSG_SIZE)
+    {
+        return false;
+    } /* end if */
+
+    memcpy(Msg, Buf + SBN_PACKED_HDR_SZ, *MsgSzPtr);
+
+    return true;
+} /* end UnpackMsg() */
+
+static SBN_Status_t Connected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = true;
+    ConnectedCnt++;
+    return SBN_SUCCESS;
+} /* end Connected() */
+
+static SBN_Status_t Disconnected(SBN_PeerInterface_t *Peer)
+{
+    Peer->Connected = false;
+    DisconnectedCnt++;
+    return SBN_SUCCESS;
+} /* end Disconnected() */
+
+static SBN_Status_t SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg, SBN_PeerInterface_t *Peer)
+{
+    return SBN_UDS_Ops.Send(Peer, MsgType, MsgSz, Msg);
+} /* end SendNetMsg() */
+
+/* each net has only the one peer */
+static SBN_PeerInterface_t *GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t ProcessorID,
+                                    CFE_SpacecraftID_t SpacecraftID)
+{
+    if (Net->Peers[0].ProcessorID == ProcessorID && Net->Peers[0].SpacecraftID == SpacecraftID)
+    {
+        return &Net->Peers[0];
+    } /* end if */
+
+    return NULL;
+} /* end GetPeer() */
+
+static SBN_ProtocolOutlet_t Outlet = {PackMsg, UnpackMsg, Connected, Disconnected, SendNetMsg, GetPeer};
+
+static uint8  Payload[CFE_MISSION_SB_MAX_SB_MSG_SIZE], RecvPayload[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+static uint32 Status[6];
+
+/* reads the module status of a peer, returning the flags */
+static uint8 GetStatus(SBN_PeerInterface_t *Peer)
+{
+    uint8 Buf[64], *Ptr = Buf + 1;
+    int   i             = 0;
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.ReportModuleStatus(Peer, Buf, sizeof(Buf)), SBN_SUCCESS);
+
+    for (i = 0; i < 6; i++, Ptr += 4)
+    {
+        Status[i] = ((uint32)Ptr[0] << 24) | (Ptr[1] << 16) | (Ptr[2] << 8) | Ptr[3];
+    } /* end for */
+
+    return Buf[0];
+} /* end GetStatus() */
+
+static SBN_Status_t RecvB(SBN_MsgType_t *MsgTypePtr, SBN_MsgSz_t *MsgSzPtr)
+{
+    CFE_ProcessorID_t  ProcessorID  = 0;
+    CFE_SpacecraftID_t SpacecraftID = 0;
+
+    return SBN_UDS_Ops.RecvFromNet(&NetB, MsgTypePtr, MsgSzPtr, &ProcessorID, &SpacecraftID, RecvPayload);
+} /* end RecvB() */
+
+static void InitNet(SBN_NetInterface_t *Net, const char *NetAddr, const char *PeerAddr)
+{
+    memset(Net, 0, sizeof(*Net));
+
+    Net->PeerCnt = 1;
+    Net->IfOps   = &SBN_UDS_Ops;
+
+    /* both ends are this processor */
+    Net->Peers[0].Net          = Net;
+    Net->Peers[0].ProcessorID  = CFE_PSP_GetProcessorId();
+    Net->Peers[0].SpacecraftID = CFE_PSP_GetSpacecraftId();
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.LoadNet(Net, NetAddr), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.LoadPeer(&Net->Peers[0], PeerAddr), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.InitNet(Net), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.InitPeer(&Net->Peers[0]), SBN_SUCCESS);
+} /* end InitNet() */
+
+/* loads net A, whose peer is at B, and net B, whose peer is at A */
+static void START(const char *AddrA, const char *AddrB)
+{
+    size_t i = 0;
+
+    UT_ResetState(0);
+
+    ConnectedCnt    = 0;
+    DisconnectedCnt = 0;
+
+    for (i = 0; i < sizeof(Payload); i++)
+    {
+        Payload[i] = i & 0xFF;
+    } /* end for */
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+
+    InitNet(&NetA, AddrA, PATH_B);
+    InitNet(&NetB, AddrB, PATH_A);
+} /* end START() */
+
+static void STOP(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.UnloadNet(&NetB), SBN_SUCCESS);
+
+    UtAssert_True(access(PATH_A, F_OK) != 0 && access(PATH_B, F_OK) != 0, "socket files removed");
+} /* end STOP() */
+
+void Test_SBN_UDS_Init(void)
+{
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.InitModule(-1, 0, &Outlet), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, NULL), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.InitModule(SBN_PROTOCOL_VERSION, 0, &Outlet), SBN_SUCCESS);
+} /* end Test_SBN_UDS_Init() */
+
+void Test_SBN_UDS_LoadNet(void)
+{
+    SBN_UDS_Net_t *NetData = (SBN_UDS_Net_t *)NetA.ModulePvt;
+
+    memset(&NetA, 0, sizeof(NetA));
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.LoadNet(&NetA, ""), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.LoadNet(&NetA, "/tmp/a/path/that/is/much/too/long/for/a/unix/domain/socket/address"),
+                        SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.LoadNet(&NetA, PATH_A "?memfd"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.LoadNet(&NetA, PATH_A "?memfd=x"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.LoadNet(&NetA, PATH_A "?foo=1"), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.LoadNet(&NetA, PATH_A "?memfd=1024"), SBN_SUCCESS);
+
+    UtAssert_True(strcmp(NetData->Path, PATH_A) == 0, "net path");
+    UtAssert_True(NetData->MemFDSz == 1024, "MemFDSz=%d", (int)NetData->MemFDSz);
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.LoadPeer(&NetA.Peers[0], ""), SBN_ERROR);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+} /* end Test_SBN_UDS_LoadNet() */
+
+void Test_SBN_UDS_Inline(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+
+    START(PATH_A "?memfd=0", PATH_B "?memfd=0");
+
+    /* not connected until polled, sends are dropped */
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.Send(PeerB, SBN_APP_MSG, 100, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.PollPeer(PeerB), SBN_SUCCESS);
+    UtAssert_True(ConnectedCnt == 1 && PeerB->Connected, "A connected to B");
+    UtAssert_True(GetStatus(PeerB) == 1, "A connected out");
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.Send(PeerB, SBN_APP_MSG, 100, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.Send(PeerB, SBN_APP_MSG, 4000, Payload), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_APP_MSG && MsgSz == 100, "MsgType=%d MsgSz=%d", MsgType, MsgSz);
+    UtAssert_True(memcmp(RecvPayload, Payload, 100) == 0, "payload intact");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 4000 && memcmp(RecvPayload, Payload, 4000) == 0, "larger payload intact");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+
+    GetStatus(PeerB);
+    UtAssert_True(Status[1] == 2 && Status[2] == 0 && Status[3] == 0, "A TxInlineCnt=%d", (int)Status[1]);
+    GetStatus(PeerA);
+    UtAssert_True(Status[4] == 2 && Status[5] == 0, "B RxInlineCnt=%d", (int)Status[4]);
+
+    STOP();
+    UtAssert_True(DisconnectedCnt == 1, "disconnected on unload");
+} /* end Test_SBN_UDS_Inline() */
+
+void Test_SBN_UDS_MemFD(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+
+    START(PATH_A "?memfd=1024", PATH_B);
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.PollPeer(PeerB), SBN_SUCCESS);
+
+    /* below the threshold inline, above it through a memfd */
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.Send(PeerB, SBN_APP_MSG, 100, Payload), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.Send(PeerB, SBN_APP_MSG, 4000, Payload), SBN_SUCCESS);
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgSz == 100 && memcmp(RecvPayload, Payload, 100) == 0, "inline payload intact");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_APP_MSG && MsgSz == 4000, "MsgType=%d MsgSz=%d", MsgType, MsgSz);
+    UtAssert_True(memcmp(RecvPayload, Payload, 4000) == 0, "memfd payload intact");
+
+    GetStatus(PeerB);
+    UtAssert_True(Status[0] == 1024, "MemFDSz=%d", (int)Status[0]);
+#ifdef MFD_ALLOW_SEALING
+    UtAssert_True(Status[1] == 1 && Status[2] == 1, "A TxInlineCnt=%d TxMemFDCnt=%d", (int)Status[1],
+                  (int)Status[2]);
+    GetStatus(PeerA);
+    UtAssert_True(Status[4] == 1 && Status[5] == 1, "B RxInlineCnt=%d RxMemFDCnt=%d", (int)Status[4],
+                  (int)Status[5]);
+#endif /* MFD_ALLOW_SEALING */
+
+    STOP();
+} /* end Test_SBN_UDS_MemFD() */
+
+void Test_SBN_UDS_Disconnect(void)
+{
+    SBN_MsgType_t MsgType = 0;
+    SBN_MsgSz_t   MsgSz   = 0;
+
+    START(PATH_A, PATH_B);
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.PollPeer(PeerB), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.PollPeer(PeerA), SBN_SUCCESS);
+    UtAssert_True(ConnectedCnt == 2, "connected both ways");
+
+    /* the first message tells B which peer the connection is from */
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.Send(PeerB, SBN_UDS_HEARTBEAT_MSG, 0, NULL), SBN_SUCCESS);
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_SUCCESS);
+    UtAssert_True(MsgType == SBN_UDS_HEARTBEAT_MSG && MsgSz == 0, "heartbeat");
+
+    /* A goes away, B sees its connection close */
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.UnloadNet(&NetA), SBN_SUCCESS);
+    UtAssert_True(DisconnectedCnt == 1 && !PeerB->Connected, "A disconnected");
+
+    UT_TEST_FUNCTION_RC(RecvB(&MsgType, &MsgSz), SBN_IF_EMPTY);
+    UtAssert_True(DisconnectedCnt == 2 && !PeerA->Connected, "B disconnected");
+    UtAssert_True(GetStatus(PeerA) == 0, "B not connected out");
+
+    /* and cannot reconnect until A is back */
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.PollPeer(PeerA), SBN_SUCCESS);
+    UtAssert_True(!PeerA->Connected, "B not reconnected");
+
+    UT_TEST_FUNCTION_RC(SBN_UDS_Ops.UnloadNet(&NetB), SBN_SUCCESS);
+} /* end Test_SBN_UDS_Disconnect() */
+
+/*
+ * Setup function prior to every test
+ */
+void UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void UT_TearDown(void) {}
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(SBN_UDS_Init);
+    ADD_TEST(SBN_UDS_LoadNet);
+    ADD_TEST(SBN_UDS_Inline);
+    ADD_TEST(SBN_UDS_MemFD);
+    ADD_TEST(SBN_UDS_Disconnect);
+}
@@ -1209,6 +1209,7 @@ static void ProcessNetMsg_PeerErr(void)
     UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_PROTO_MSG, ProcessorID + 1, 0, NULL), SBN_ERROR);
 
     EVENT_CNT(1);
+    UtAssert_True(NetPtr->Cnts.RecvErrCnt == 1, "net recv error counted");
 } /* ProcessNetMsg_PeerErr() */
 
 static void ProcessNetMsg_ProtoMsg_VerErr(void)
@@ -1281,6 +1282,9 @@ static void ProcessNetMsg_AppMsg_FiltOut(void)
     UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetSpacecraftId), 1, SpacecraftID);
 
     UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, ProcessorID, 0, NULL), SBN_IF_EMPTY);
+
+    /* counted by message ID as received, before the filter dropped it */
+    UtAssert_INT32_EQ(PeerPtr->RecvMids.TopMsgs[0].MsgCnt, 1);
 } /* end ProcessNetMsg_AppMsg_FiltOut() */
 
 static SBN_Status_t RecvFilter_Nominal(void *Data, SBN_Filter_Ctx_t *CtxPtr)
@@ -1297,6 +1301,10 @@ static void ProcessNetMsg_AppMsg_PassMsgErr(void)
     UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetProcessorId), 1, ProcessorID);
     UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetSpacecraftId), 1, SpacecraftID);
 
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+    SBN.Subs[0].MsgID = MsgID;
+    SBN.SubCnt        = 1;
+
     UT_SetDeferredRetcode(UT_KEY(CFE_SB_TransmitMsg), 1, -1);
 
     UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, ProcessorID, 0, NULL), SBN_ERROR);
@@ -1321,9 +1329,93 @@ static void ProcessNetMsg_AppMsg_Nominal(void)
     UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetProcessorId), 1, ProcessorID);
     UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetSpacecraftId), 1, SpacecraftID);
 
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+    SBN.Subs[0].MsgID = MsgID;
+    SBN.SubCnt        = 1;
+
     UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, ProcessorID, 0, NULL), SBN_SUCCESS);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
 } /* end ProcessNetMsg_AppMsg_Nominal() */
 
+static void ProcessNetMsg_AppMsg_NoLocalSub(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetProcessorId), 1, ProcessorID);
+    UT_SetDeferredRetcode(UT_KEY(CFE_PSP_GetSpacecraftId), 1, SpacecraftID);
+
+    /* modules with group nets drop those for other nodes' subscriptions, the core delivers what it is given */
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_APP_MSG, ProcessorID, 0, NULL), SBN_SUCCESS);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+} /* end ProcessNetMsg_AppMsg_NoLocalSub() */
+
+static void ProcessNetMsg_SeqMsg_ShortErr(void)
+{
+    START();
+
+    uint8 Buf[] = {0x00, 0x01, 0x00};
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_SEQ_APP_MSG, ProcessorID, sizeof(Buf), Buf), SBN_ERROR);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 0);
+} /* end ProcessNetMsg_SeqMsg_ShortErr() */
+
+static void ProcessNetMsg_SeqMsg_Dup(void)
+{
+    START();
+
+    /* Epoch 1, Seq 0, then an app message */
+    uint8 Buf[SBN_SEQ_HDR_SZ + 8] = {0x00, 0x01, 0x00, 0x00};
+
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+    SBN.Subs[0].MsgID = MsgID;
+    SBN.SubCnt        = 1;
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_SEQ_APP_MSG, ProcessorID, sizeof(Buf), Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_SEQ_APP_MSG, ProcessorID, sizeof(Buf), Buf), SBN_SUCCESS);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+    UtAssert_INT32_EQ(PeerPtr->RecvDupCnt, 1);
+    UtAssert_INT32_EQ(PeerPtr->RecvGapCnt, 0);
+} /* end ProcessNetMsg_SeqMsg_Dup() */
+
+static void ProcessNetMsg_SeqMsg_GapReorder(void)
+{
+    START();
+
+    uint8 Buf[SBN_SEQ_HDR_SZ + 8] = {0x00, 0x01, 0x00, 0x00};
+
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+    SBN.Subs[0].MsgID = MsgID;
+    SBN.SubCnt        = 1;
+
+    /* Seq 0, 3 (1 and 2 missing), then 1 late */
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_SEQ_APP_MSG, ProcessorID, sizeof(Buf), Buf), SBN_SUCCESS);
+    Buf[3] = 3;
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_SEQ_APP_MSG, ProcessorID, sizeof(Buf), Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(PeerPtr->RecvGapCnt, 2);
+    Buf[3] = 1;
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_SEQ_APP_MSG, ProcessorID, sizeof(Buf), Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(PeerPtr->RecvGapCnt, 1);
+    UtAssert_INT32_EQ(PeerPtr->RecvReorderCnt, 1);
+    UtAssert_INT32_EQ(PeerPtr->RecvDupCnt, 0);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 3);
+
+    /* a new Epoch, as from a restarted peer, starts over */
+    Buf[1] = 2;
+    Buf[3] = 0;
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_SEQ_APP_MSG, ProcessorID, sizeof(Buf), Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(PeerPtr->RecvGapCnt, 1);
+    UtAssert_INT32_EQ(PeerPtr->RecvDupCnt, 0);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 4);
+
+    /* and the gap count saturates */
+    PeerPtr->RecvGapCnt = 0xFFFE;
+    Buf[3]              = 0x10;
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_SEQ_APP_MSG, ProcessorID, sizeof(Buf), Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(PeerPtr->RecvGapCnt, 0xFFFF);
+} /* end ProcessNetMsg_SeqMsg_GapReorder() */
+
 static void ProcessNetMsg_SubMsg_Nominal(void)
 {
     START();
@@ -1368,6 +1460,18 @@ static void ProcessNetMsg_UnSubMsg_Nominal(void)
     UtAssert_INT32_EQ(PeerPtr->SubCnt, 0);
 } /* end ProcessNetMsg_UnSubMsg_Nominal() */
 
+static void ProcessNetMsg_Cnts(void)
+{
+    START();
+
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_NO_MSG, ProcessorID, 12, NULL), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_NO_MSG, ProcessorID, 20, NULL), SBN_SUCCESS);
+
+    UtAssert_INT32_EQ(PeerPtr->RecvCnt, 2);
+    UtAssert_True(PeerPtr->Cnts.RecvCnt == 2 && PeerPtr->Cnts.RecvBytes == 32, "peer recv counted");
+    UtAssert_True(NetPtr->Cnts.RecvCnt == 2 && NetPtr->Cnts.RecvBytes == 32, "net recv counted");
+} /* end ProcessNetMsg_Cnts() */
+
 static void ProcessNetMsg_NoMsg_Nominal(void)
 {
     START();
@@ -1383,6 +1487,65 @@ static void ProcessNetMsg_MsgErr(void)
     UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_NO_MSG + 100, ProcessorID, 0, NULL), SBN_ERROR);
 } /* end ProcessNetMsg_MsgErr() */
 
+static void ProcessNetMsg_MsgErr_Limited(void)
+{
+    int i = 0;
+
+    START();
+
+    /* a flood of bad messages is not a flood of events */
+    for (i = 0; i < SBN_EVS_LIMIT_CNT * 2; i++)
+    {
+        UtAssert_INT32_EQ(SBN_ProcessNetMsg(NetPtr, SBN_NO_MSG + 100, ProcessorID, 0, NULL), SBN_ERROR);
+    } /* end for */
+
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_EVS_SendEvent)) <= SBN_EVS_LIMIT_CNT, "events limited");
+} /* end ProcessNetMsg_MsgErr_Limited() */
+
+static void ProcessNetMsg_MsgErr_LimitedFlush(void)
+{
+    SBN_EVSLimit_t Done, Open;
+
+    START();
+
+    memset(&Done, 0, sizeof(Done));
+    Done.EID        = SBN_SB_EID;
+    Done.Type       = CFE_EVS_EventType_ERROR;
+    Done.Suppressed = 3;
+    Done.WindowSecs = -SBN_EVS_LIMIT_SECS; /* over, by the stub clock's 0 */
+    memcpy(&Open, &Done, sizeof(Open));
+    Open.WindowSecs = 0;
+
+    SBN_PendEVSLimit(&Done);
+    SBN_PendEVSLimit(&Open);
+    SBN_PendEVSLimit(&Done);
+    UtAssert_INT32_EQ(SBN.EVSLimitCnt, 2);
+
+    /* the count of a flood that has stopped is sent from the wakeup */
+    SBN_FlushEVSLimits(false);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+    UtAssert_True(Done.Suppressed == 0 && Open.Suppressed == 3 && SBN.EVSLimitCnt == 1, "window over sent");
+
+    SBN_FlushEVSLimits(true);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 2);
+    UtAssert_True(Open.Suppressed == 0 && SBN.EVSLimitCnt == 0, "all sent");
+} /* end ProcessNetMsg_MsgErr_LimitedFlush() */
+
+static void ProcessNetMsg_ModuleMsg_MsgEvents(void)
+{
+    START();
+
+    /* per-message debug events are off until commanded on */
+    UtAssert_INT32_EQ(
+        SBN_ProcessNetMsg(NetPtr, SBN_MODULE_SPECIFIC_MESSAGE_ID_MASK | 1, ProcessorID, 0, NULL), SBN_SUCCESS);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    SBN.MsgEvents = true;
+    UtAssert_INT32_EQ(
+        SBN_ProcessNetMsg(NetPtr, SBN_MODULE_SPECIFIC_MESSAGE_ID_MASK | 1, ProcessorID, 0, NULL), SBN_SUCCESS);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, SBN_MSG_EVENTS ? 1 : 0);
+} /* end ProcessNetMsg_ModuleMsg_MsgEvents() */
+
 static void Test_SBN_ProcessNetMsg(void)
 {
     ProcessNetMsg_PeerErr();
@@ -1391,12 +1554,20 @@ static void Test_SBN_ProcessNetMsg(void)
     ProcessNetMsg_AppMsg_PassMsgErr();
     ProcessNetMsg_ProtoMsg_VerErr();
     ProcessNetMsg_MsgErr();
+    ProcessNetMsg_MsgErr_Limited();
+    ProcessNetMsg_MsgErr_LimitedFlush();
+    ProcessNetMsg_SeqMsg_ShortErr();
 
     ProcessNetMsg_AppMsg_Nominal();
+    ProcessNetMsg_AppMsg_NoLocalSub();
+    ProcessNetMsg_ModuleMsg_MsgEvents();
+    ProcessNetMsg_SeqMsg_Dup();
+    ProcessNetMsg_SeqMsg_GapReorder();
     ProcessNetMsg_SubMsg_Nominal();
     ProcessNetMsg_UnSubMsg_Nominal();
     ProcessNetMsg_ProtoMsg_Nominal();
     ProcessNetMsg_NoMsg_Nominal();
+    ProcessNetMsg_Cnts();
 } /* end Test_SBN_ProcessNetMsg() */
 
 static void Connected_AlreadyErr(void)
@@ -2120,6 +2291,8 @@ void SendNetMsg_SendErr(void)
 
     UtAssert_INT32_EQ(PeerPtr->SendCnt, 1);
     UtAssert_INT32_EQ(PeerPtr->SendErrCnt, 1);
+    UtAssert_True(PeerPtr->Cnts.SendCnt == 1 && PeerPtr->Cnts.SendErrCnt == 1, "peer sends counted");
+    UtAssert_True(NetPtr->Cnts.SendCnt == 1 && NetPtr->Cnts.SendErrCnt == 1, "net sends counted");
 } /* end SendNetMsg_SendErr() */
 
 void Test_SBN_SendNetMsg(void)
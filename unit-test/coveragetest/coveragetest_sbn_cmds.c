@@ -3,6 +3,8 @@
 #include "cfe_msgids.h"
 #include "cfe_sb_events.h"
 #include "sbn_pack.h"
+#include "sbn_trace.h"
+#include "sbn_midstat.h"
 
 uint8 Buffer[1024];
 
@@ -86,6 +88,25 @@ static void HKNet_NetIdErr(void)
     EVENT_CNT(1);
 } /* end HKNet_NetIdErr() */
 
+static void HKNet_NetIdEdge(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "Invalid NetIdx (");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    Buffer[sizeof(CFE_MSG_CommandHeader_t)] = 1; /* one past the last */
+
+    MsgSz = SBN_CMD_NET_LEN;
+    FcnCode = SBN_HK_NET_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 0);
+} /* end HKNet_NetIdEdge() */
+
 static void HKNet_Nominal(void)
 {
     START();
@@ -160,6 +181,27 @@ static void HKPeer_PeerIdErr(void)
     EVENT_CNT(1);
 } /* end HKPeer_PeerIdErr() */
 
+static void HKPeer_PeerIdEdge(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "Invalid PeerIdx (");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    uint8 *Ptr = Buffer + sizeof(CFE_MSG_CommandHeader_t);
+    *Ptr++     = 0;
+    *Ptr++     = 1; /* one past the last */
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_PEER_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 0);
+} /* end HKPeer_PeerIdEdge() */
+
 static void HKPeer_Nominal(void)
 {
     START();
@@ -177,6 +219,488 @@ static void HKPeer_Nominal(void)
     EVENT_CNT(1);
 } /* end HKPeer_Nominal() */
 
+static SBN_Status_t ReportModuleStatus_Nominal(SBN_PeerInterface_t *Peer, uint8 *StatusBuf, size_t StatusBufSz)
+{
+    memset(StatusBuf, 0xA5, StatusBufSz);
+    return SBN_SUCCESS;
+} /* end ReportModuleStatus_Nominal() */
+
+static void HKModStatus_MsgLenErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "hk module status command, net=");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MsgSz = -1;
+    FcnCode = SBN_HK_MODSTATUS_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(0);
+} /* end HKModStatus_MsgLenErr() */
+
+static void HKModStatus_NetIdErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "Invalid NetIdx (");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    uint8 *Ptr = Buffer + sizeof(CFE_MSG_CommandHeader_t);
+    *Ptr++     = 1; /* == NetCnt */
+    *Ptr       = 0;
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_MODSTATUS_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+} /* end HKModStatus_NetIdErr() */
+
+static void HKModStatus_PeerIdErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "Invalid PeerIdx (");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    uint8 *Ptr = Buffer + sizeof(CFE_MSG_CommandHeader_t);
+    *Ptr++     = 0;
+    *Ptr++     = 1; /* == PeerCnt */
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_MODSTATUS_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+} /* end HKModStatus_PeerIdErr() */
+
+static void HKModStatus_NotImpl(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "module status not supported");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_MODSTATUS_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 0);
+} /* end HKModStatus_NotImpl() */
+
+static void HKModStatus_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "hk module status command, net=");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_MODSTATUS_CC;
+    MSGINIT();
+
+    IfOpsPtr->ReportModuleStatus = ReportModuleStatus_Nominal;
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    IfOpsPtr->ReportModuleStatus = NULL;
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+} /* end HKModStatus_Nominal() */
+
+static void HKLat_PeerIdErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "Invalid PeerIdx (");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    uint8 *Ptr = Buffer + sizeof(CFE_MSG_CommandHeader_t);
+    *Ptr++     = 0;
+    *Ptr++     = 1;
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_LAT_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 0);
+} /* end HKLat_PeerIdErr() */
+
+static void HKLat_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "hk latency command, net=");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_LAT_CC;
+    MSGINIT();
+
+    SBN.LatMids[1].InUse = true;
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+} /* end HKLat_Nominal() */
+
+static void LatMid_SlotErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "invalid latency slot");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    Buffer[sizeof(CFE_MSG_CommandHeader_t)] = SBN_LAT_MAX_MIDS;
+
+    MsgSz = SBN_CMD_LATMID_LEN;
+    FcnCode = SBN_LAT_MID_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_INT32_EQ(SBN.CmdErrCnt, 1);
+} /* end LatMid_SlotErr() */
+
+static void LatMid_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "latency mid command");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    Buffer[sizeof(CFE_MSG_CommandHeader_t)] = 2;
+
+    MsgSz = SBN_CMD_LATMID_LEN;
+    FcnCode = SBN_LAT_MID_CC;
+    MSGINIT();
+
+    SBN.LatMids[2].Hist.Cnt = 5;
+    UT_SetDefaultReturnValue(UT_KEY(CFE_SB_IsValidMsgId), true);
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_True(SBN.LatMids[2].InUse, "latency mid set");
+    UtAssert_INT32_EQ(SBN.LatMids[2].Hist.Cnt, 0);
+} /* end LatMid_Nominal() */
+
+static void Probe_CntErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "invalid probe count");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    Buffer[sizeof(CFE_MSG_CommandHeader_t) + 2] = SBN_PROBE_MAX_CNT + 1;
+
+    MsgSz = SBN_CMD_PROBE_LEN;
+    FcnCode = SBN_PROBE_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_INT32_EQ(SBN.CmdErrCnt, 1);
+    UtAssert_True(!SBN.Probe.Active, "probe not started");
+} /* end Probe_CntErr() */
+
+static void Probe_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "probe command, net=");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    Buffer[sizeof(CFE_MSG_CommandHeader_t) + 2] = 4;
+
+    MsgSz = SBN_CMD_PROBE_LEN;
+    FcnCode = SBN_PROBE_CC;
+    MSGINIT();
+
+    PeerPtr->Connected = true;
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_INT32_EQ(SBN.CmdCnt, 1);
+    UtAssert_True(SBN.Probe.Active, "probe started");
+    UtAssert_INT32_EQ(SBN.Probe.SentCnt, 1);
+} /* end Probe_Nominal() */
+
+static void HKPerf_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "hk perf command");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MsgSz = sizeof(CFE_MSG_CommandHeader_t);
+    FcnCode = SBN_HK_PERF_CC;
+    MSGINIT();
+
+    SBN.Stages[SBN_STAGE_FILTER].Cnt = 2;
+    SBN.Stages[SBN_STAGE_FILTER].TotalUs = 10;
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+} /* end HKPerf_Nominal() */
+
+static void HKCnts_PeerIdErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "Invalid PeerIdx (");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    uint8 *Ptr = Buffer + sizeof(CFE_MSG_CommandHeader_t);
+    *Ptr++     = 0;
+    *Ptr++     = 1; /* one past the last */
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_CNTS_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 0);
+} /* end HKCnts_PeerIdErr() */
+
+static void HKCnts_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "hk counters command, net=0, peer=0");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_CNTS_CC;
+    MSGINIT();
+
+    PeerPtr->Cnts.SendCnt   = 100000;
+    PeerPtr->Cnts.RecvBytes = 0x100000000ULL;
+    NetPtr->Cnts.SendCnt    = 100000;
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+
+    /* kept for the next report's rates */
+    UtAssert_True(PeerPtr->HKCnts.SendCnt == 100000 && PeerPtr->HKCnts.RecvBytes == 0x100000000ULL,
+                  "peer counters kept");
+    UtAssert_True(NetPtr->HKCnts.SendCnt == 100000, "net counters kept");
+
+    SBN_InitializeCounters();
+    UtAssert_True(PeerPtr->Cnts.SendCnt == 0 && PeerPtr->HKCnts.SendCnt == 0, "peer counters reset");
+    UtAssert_True(NetPtr->Cnts.SendCnt == 0 && NetPtr->HKCnts.SendCnt == 0, "net counters reset");
+} /* end HKCnts_Nominal() */
+
+static void HKMids_PeerIdErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "Invalid PeerIdx (");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    uint8 *Ptr = Buffer + sizeof(CFE_MSG_CommandHeader_t);
+    *Ptr++     = 0;
+    *Ptr++     = 1; /* one past the last */
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_MIDS_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 0);
+} /* end HKMids_PeerIdErr() */
+
+static void HKMids_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "hk mids command, net=0, peer=0");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MsgSz = SBN_CMD_PEER_LEN;
+    FcnCode = SBN_HK_MIDS_CC;
+    MSGINIT();
+
+    SBN_MidStatCount(&PeerPtr->SendMids, CFE_SB_ValueToMsgId(0x1801), 100);
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+
+    SBN_InitializeCounters();
+    UtAssert_INT32_EQ(PeerPtr->SendMids.TopBytes[0].MsgCnt, 0);
+} /* end HKMids_Nominal() */
+
+static void MidStatMid_RemoveErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "unable to remove mid stats MsgID");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MsgSz = SBN_CMD_MIDSTATMID_LEN;
+    FcnCode = SBN_MIDSTAT_MID_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_INT32_EQ(SBN.CmdErrCnt, 1);
+} /* end MidStatMid_RemoveErr() */
+
+static void MidStatMid_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "mid stats mid command");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    uint8 *Ptr = Buffer + sizeof(CFE_MSG_CommandHeader_t);
+    Ptr[2]     = 0x18;
+    Ptr[3]     = 0x01;
+    Ptr[4]     = 1;
+
+    MsgSz = SBN_CMD_MIDSTATMID_LEN;
+    FcnCode = SBN_MIDSTAT_MID_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_INT32_EQ(SBN.CmdCnt, 1);
+
+    SBN_MidStatCount(&PeerPtr->RecvMids, CFE_SB_ValueToMsgId(0x1801), 100);
+    UtAssert_INT32_EQ(PeerPtr->RecvMids.TopBytes[0].MsgCnt, 0);
+} /* end MidStatMid_Nominal() */
+
+static void HKAllPeers_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "hk all peers command");
+
+    memset(Buffer, 0, sizeof(Buffer));
+
+    MsgSz = sizeof(CFE_MSG_CommandHeader_t);
+    FcnCode = SBN_HK_ALLPEERS_CC;
+    MSGINIT();
+
+    PeerPtr->Connected = 1;
+    PeerPtr->PipeCnt   = 3;
+    PeerPtr->PipeMax   = SBN_MAX_MSG_PER_WAKEUP;
+    NetPtr->PipeMax    = 2;
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+
+    /* the most per wakeup is since the last report, the last wakeup's kept */
+    UtAssert_INT32_EQ(PeerPtr->PipeMax, 0);
+    UtAssert_INT32_EQ(NetPtr->PipeMax, 0);
+    UtAssert_INT32_EQ(PeerPtr->PipeCnt, 3);
+} /* end HKAllPeers_Nominal() */
+
+static void MsgEvents_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "per-message events on");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    Buffer[sizeof(CFE_MSG_CommandHeader_t)] = 1;
+
+    MsgSz = SBN_CMD_MSGEVENTS_LEN;
+    FcnCode = SBN_MSG_EVENTS_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_INT32_EQ(SBN.CmdCnt, 1);
+    UtAssert_True(SBN.MsgEvents, "per-message events on");
+} /* end MsgEvents_Nominal() */
+
+static void Trace_ModeErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "invalid trace mode (3)");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    Buffer[sizeof(CFE_MSG_CommandHeader_t)] = 3;
+
+    MsgSz = SBN_CMD_TRACE_LEN;
+    FcnCode = SBN_TRACE_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_INT32_EQ(SBN.CmdErrCnt, 1);
+} /* end Trace_ModeErr() */
+
+static void Trace_Nominal(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_CMD_EID, "trace dumped to " SBN_TRACE_FILENAME " (1 points)");
+
+    memset(Buffer, 0, sizeof(Buffer));
+    Buffer[sizeof(CFE_MSG_CommandHeader_t)] = SBN_TRACE_ON;
+
+    MsgSz = SBN_CMD_TRACE_LEN;
+    FcnCode = SBN_TRACE_CC;
+    MSGINIT();
+
+    SBN_HandleCommand(CmdPktPtr);
+    UtAssert_True(SBN.Trace.On, "trace on");
+
+    SBN_TraceRecord(SBN_TRACE_SB_XMIT, 0, 1, CFE_SB_ValueToMsgId(0x1818));
+
+    Buffer[sizeof(CFE_MSG_CommandHeader_t)] = SBN_TRACE_DUMP;
+    SBN_HandleCommand(CmdPktPtr);
+
+    EVENT_CNT(1);
+    UtAssert_True(!SBN.Trace.On, "trace frozen");
+    UtAssert_INT32_EQ(SBN.CmdCnt, 2);
+} /* end Trace_Nominal() */
+
 static void HKPeerSubs_MsgLenErr(void)
 {
     START();
@@ -532,11 +1056,35 @@ static void Test_SBN_Cmds(void)
     NOOP_Nominal();
     HKNet_MsgLenErr();
     HKNet_NetIdErr();
+    HKNet_NetIdEdge();
     HKNet_Nominal();
     HKPeer_MsgLenErr();
     HKPeer_NetIdErr();
     HKPeer_PeerIdErr();
+    HKPeer_PeerIdEdge();
     HKPeer_Nominal();
+    HKModStatus_MsgLenErr();
+    HKModStatus_NetIdErr();
+    HKModStatus_PeerIdErr();
+    HKModStatus_NotImpl();
+    HKModStatus_Nominal();
+    HKLat_PeerIdErr();
+    HKLat_Nominal();
+    LatMid_SlotErr();
+    LatMid_Nominal();
+    Probe_CntErr();
+    Probe_Nominal();
+    HKPerf_Nominal();
+    HKCnts_PeerIdErr();
+    HKCnts_Nominal();
+    HKMids_PeerIdErr();
+    HKMids_Nominal();
+    MidStatMid_RemoveErr();
+    MidStatMid_Nominal();
+    HKAllPeers_Nominal();
+    MsgEvents_Nominal();
+    Trace_ModeErr();
+    Trace_Nominal();
     HKPeerSubs_MsgLenErr();
     HKPeerSubs_NetIdErr();
     HKPeerSubs_PeerIdErr();
@@ -0,0 +1,177 @@
+#include "sbn_coveragetest_common.h"
+#include "sbn_lat.h"
+
+CFE_SB_MsgId_t MsgID = 0x1818;
+
+static void Test_HistPercentile(void)
+{
+    SBN_LatHist_t Hist;
+    uint32        i = 0;
+
+    START();
+
+    memset(&Hist, 0, sizeof(Hist));
+
+    UtAssert_UINT32_EQ(SBN_LatHistPercentile(&Hist, 50), 0);
+
+    /* 1 to 100 us */
+    for (i = 1; i <= 100; i++)
+    {
+        SBN_LatHistAdd(&Hist, i);
+    } /* end for */
+
+    UtAssert_UINT32_EQ(Hist.Cnt, 100);
+    UtAssert_UINT32_EQ(Hist.MaxUs, 100);
+
+    /* 50 is in [48, 55], 99 in [96, 111] (capped at the largest) */
+    UtAssert_UINT32_EQ(SBN_LatHistPercentile(&Hist, 50), 55);
+    UtAssert_UINT32_EQ(SBN_LatHistPercentile(&Hist, 99), 100);
+    UtAssert_UINT32_EQ(SBN_LatHistPercentile(&Hist, 1), 1);
+
+    /* values too small to split have a bucket each */
+    memset(&Hist, 0, sizeof(Hist));
+    SBN_LatHistAdd(&Hist, 0);
+    SBN_LatHistAdd(&Hist, 3);
+    SBN_LatHistAdd(&Hist, 0xFFFFFFFF);
+    UtAssert_UINT32_EQ(SBN_LatHistPercentile(&Hist, 1), 0);
+    UtAssert_UINT32_EQ(SBN_LatHistPercentile(&Hist, 50), 3);
+    UtAssert_UINT32_EQ(SBN_LatHistPercentile(&Hist, 100), 0xFFFFFFFF);
+} /* end Test_HistPercentile() */
+
+static void Test_SyncSample(void)
+{
+    SBN_LatSync_t Sync;
+
+    START();
+
+    memset(&Sync, 0, sizeof(Sync));
+
+    /* the peer's clock is 1000 us ahead, 100 us each way */
+    SBN_LatSyncSample(&Sync, 10000, 11100, 11150, 10250);
+    UtAssert_True(Sync.Valid, "sync valid");
+    UtAssert_INT32_EQ(Sync.OffsetUs, 1000);
+    UtAssert_INT32_EQ(Sync.DelayUs, 200);
+
+    /* a slower, lopsided exchange does not displace it */
+    SBN_LatSyncSample(&Sync, 20000, 21900, 21950, 20350);
+    UtAssert_INT32_EQ(Sync.OffsetUs, 1000);
+    UtAssert_INT32_EQ(Sync.DelayUs, 200);
+    UtAssert_INT32_EQ(Sync.SampleCnt, 2);
+} /* end Test_SyncSample() */
+
+static void Test_RecvSync(void)
+{
+    uint8  Buf[SBN_TIME_MSG_SZ];
+    Pack_t Pack;
+
+    START();
+
+    UtAssert_INT32_EQ(SBN_LatRecvSync(PeerPtr, SBN_TIME_MSG_SZ - 1, Buf), SBN_ERROR);
+
+    /* Orig of 0: the peer has nothing of mine yet, only its Xmit is kept */
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    SBN_LatPackUs(&Pack, 0);
+    SBN_LatPackUs(&Pack, 0);
+    SBN_LatPackUs(&Pack, 5000000);
+    UtAssert_INT32_EQ(SBN_LatRecvSync(PeerPtr, sizeof(Buf), Buf), SBN_SUCCESS);
+    UtAssert_True(!PeerPtr->LatSync.Valid, "sync not valid");
+    UtAssert_True(PeerPtr->LatSync.PeerXmitUs == 5000000, "peer xmit kept");
+} /* end Test_RecvSync() */
+
+static void Test_RecvStamp(void)
+{
+    uint8       Buf[SBN_STAMP_HDR_SZ + 8];
+    void *      Msg   = Buf;
+    SBN_MsgSz_t MsgSz = sizeof(Buf);
+    Pack_t      Pack;
+
+    START();
+
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    SBN_LatPackUs(&Pack, 0);
+
+    MsgSz = SBN_STAMP_HDR_SZ - 1;
+    UtAssert_INT32_EQ(SBN_LatRecvStamp(PeerPtr, &MsgSz, &Msg), SBN_ERROR);
+
+    /* the stamp is taken off, but not counted until the peer's clock is known */
+    MsgSz = sizeof(Buf);
+    UtAssert_INT32_EQ(SBN_LatRecvStamp(PeerPtr, &MsgSz, &Msg), SBN_SUCCESS);
+    UtAssert_INT32_EQ(MsgSz, 8);
+    UtAssert_True(Msg == Buf + SBN_STAMP_HDR_SZ, "stamp taken off");
+    UtAssert_UINT32_EQ(PeerPtr->LatHist.Cnt, 0);
+
+    PeerPtr->LatSync.Valid = true;
+    SBN.LatMids[0].InUse   = true;
+    SBN.LatMids[0].MsgID   = MsgID;
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+
+    Msg   = Buf;
+    MsgSz = sizeof(Buf);
+    UtAssert_INT32_EQ(SBN_LatRecvStamp(PeerPtr, &MsgSz, &Msg), SBN_SUCCESS);
+    UtAssert_UINT32_EQ(PeerPtr->LatHist.Cnt, 1);
+    UtAssert_UINT32_EQ(SBN.LatMids[0].Hist.Cnt, 1);
+} /* end Test_RecvStamp() */
+
+static void Test_ProbeRun(void)
+{
+    uint8  Buf[SBN_PROBE_MSG_SZ];
+    Pack_t Pack;
+
+    START();
+
+    UtAssert_INT32_EQ(SBN_LatProbeStart(0, 0, 2), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_LatProbeStart(0, 0, 2), SBN_ERROR);
+    UtAssert_INT32_EQ(SBN.Probe.SentCnt, 1);
+    UtAssert_True(SBN.Probe.Waiting, "probe waiting");
+
+    UtAssert_INT32_EQ(SBN_LatRecvProbeEcho(PeerPtr, SBN_PROBE_MSG_SZ - 1, Buf), SBN_ERROR);
+
+    /* an echo of another run is not counted */
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    Pack_UInt16(&Pack, SBN.Probe.Id + 1);
+    Pack_UInt16(&Pack, 0);
+    SBN_LatPackUs(&Pack, SBN.Probe.SentUs);
+    UtAssert_INT32_EQ(SBN_LatRecvProbeEcho(PeerPtr, sizeof(Buf), Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN.Probe.RecvCnt, 0);
+
+    /* the echo of the first sends the second */
+    Pack_Init(&Pack, Buf, sizeof(Buf), true);
+    Pack_UInt16(&Pack, SBN.Probe.Id);
+    Pack_UInt16(&Pack, 0);
+    SBN_LatPackUs(&Pack, SBN.Probe.SentUs);
+    UtAssert_INT32_EQ(SBN_LatRecvProbeEcho(PeerPtr, sizeof(Buf), Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN.Probe.RecvCnt, 1);
+    UtAssert_INT32_EQ(SBN.Probe.SentCnt, 2);
+
+    /* the second is not echoed in time, which ends the run */
+    SBN_LatProbePoll();
+    UtAssert_True(SBN.Probe.Active, "probe still waiting");
+    SBN.Probe.SentUs -= (int64)SBN_PROBE_TIMEOUT_MS * 1000;
+    SBN_LatProbePoll();
+    UtAssert_True(!SBN.Probe.Active, "probe done");
+    UtAssert_INT32_EQ(SBN.Probe.RecvCnt, 1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+} /* end Test_ProbeRun() */
+
+static void Test_ProbeMutexErr(void)
+{
+    START();
+
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemTake), 1, -1);
+    UtAssert_INT32_EQ(SBN_LatProbeStart(0, 0, 2), SBN_ERROR);
+    UtAssert_True(!SBN.Probe.Active, "no run started");
+} /* end Test_ProbeMutexErr() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(HistPercentile);
+    ADD_TEST(SyncSample);
+    ADD_TEST(RecvSync);
+    ADD_TEST(RecvStamp);
+    ADD_TEST(ProbeRun);
+    ADD_TEST(ProbeMutexErr);
+}
@@ -0,0 +1,123 @@
+#include "sbn_coveragetest_common.h"
+#include "sbn_midstat.h"
+
+static void Test_Exact(void)
+{
+    CFE_SB_MsgId_t MsgID = CFE_SB_ValueToMsgId(0x1801);
+    SBN_MidCnt_t   Top[SBN_MIDSTAT_TOP_CNT];
+    uint32         i = 0, FreeCnt = 0;
+
+    START();
+
+    UtAssert_INT32_EQ(SBN_MidStatSetMid(MsgID, true), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_MidStatSetMid(MsgID, true), SBN_SUCCESS);
+
+    SBN_MidStatCount(&PeerPtr->SendMids, MsgID, 10);
+    SBN_MidStatCount(&PeerPtr->SendMids, MsgID, 20);
+
+    UtAssert_INT32_EQ(SBN_MidStatTop(&PeerPtr->SendMids, true, Top, SBN_MIDSTAT_TOP_CNT), 1);
+    UtAssert_True(Top[0].Exact && Top[0].MsgCnt == 2 && Top[0].Bytes == 30, "counted exactly");
+    UtAssert_INT32_EQ(SBN_MidStatTop(&PeerPtr->RecvMids, true, Top, SBN_MIDSTAT_TOP_CNT), 0);
+
+    UtAssert_INT32_EQ(SBN_MidStatSetMid(MsgID, false), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_MidStatSetMid(MsgID, false), SBN_ERROR);
+
+    /* a slot before a free one is freed rather than left removed */
+    for (i = 0; i < SBN_MIDSTAT_MIDS; i++)
+    {
+        FreeCnt += SBN.MidStatMids[i].State == SBN_MIDSTAT_FREE;
+    } /* end for */
+    UtAssert_UINT32_EQ(FreeCnt, SBN_MIDSTAT_MIDS);
+
+    /* then estimated from the sketch */
+    SBN_MidStatCount(&PeerPtr->SendMids, MsgID, 10);
+    UtAssert_INT32_EQ(SBN_MidStatTop(&PeerPtr->SendMids, true, Top, SBN_MIDSTAT_TOP_CNT), 1);
+    UtAssert_True(!Top[0].Exact && Top[0].MsgCnt == 1 && Top[0].Bytes == 10, "estimated");
+
+    /* counting it exactly again takes it off the sketch's heaviest */
+    UtAssert_INT32_EQ(SBN_MidStatSetMid(MsgID, true), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_MidStatTop(&PeerPtr->SendMids, true, Top, SBN_MIDSTAT_TOP_CNT), 0);
+} /* end Test_Exact() */
+
+static void Test_Full(void)
+{
+    uint32 i = 0;
+
+    START();
+
+    for (i = 0; i < SBN_MIDSTAT_MIDS; i++)
+    {
+        UtAssert_INT32_EQ(SBN_MidStatSetMid(CFE_SB_ValueToMsgId(0x1800 + i), true), SBN_SUCCESS);
+    } /* end for */
+
+    UtAssert_INT32_EQ(SBN_MidStatSetMid(CFE_SB_ValueToMsgId(0x1900), true), SBN_ERROR);
+
+    UtAssert_INT32_EQ(SBN_MidStatSetMid(CFE_SB_ValueToMsgId(0x1803), false), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_MidStatSetMid(CFE_SB_ValueToMsgId(0x1900), true), SBN_SUCCESS);
+
+    /* each is still found past the others */
+    for (i = 0; i < SBN_MIDSTAT_MIDS; i++)
+    {
+        if (i != 3)
+        {
+            UtAssert_INT32_EQ(SBN_MidStatSetMid(CFE_SB_ValueToMsgId(0x1800 + i), false), SBN_SUCCESS);
+        } /* end if */
+    }     /* end for */
+} /* end Test_Full() */
+
+static void Test_Sketch(void)
+{
+    SBN_MidCnt_t Top[SBN_MIDSTAT_TOP_CNT];
+    uint32       i = 0;
+
+    START();
+
+    /* a few large messages, many small ones, and a crowd of others */
+    for (i = 0; i < 500; i++)
+    {
+        if (i % 5 == 0)
+        {
+            SBN_MidStatCount(&PeerPtr->RecvMids, CFE_SB_ValueToMsgId(0x0801), 1000);
+        } /* end if */
+
+        SBN_MidStatCount(&PeerPtr->RecvMids, CFE_SB_ValueToMsgId(0x0802), 16);
+        SBN_MidStatCount(&PeerPtr->RecvMids, CFE_SB_ValueToMsgId(0x0900 + i % 100), 20);
+    } /* end for */
+
+    UtAssert_INT32_EQ(SBN_MidStatTop(&PeerPtr->RecvMids, true, Top, SBN_MIDSTAT_TOP_CNT), SBN_MIDSTAT_TOP_CNT);
+    UtAssert_UINT32_EQ(CFE_SB_MsgIdToValue(Top[0].MsgID), 0x0801);
+    UtAssert_True(!Top[0].Exact && Top[0].Bytes >= 100000, "never estimated low");
+
+    UtAssert_INT32_EQ(SBN_MidStatTop(&PeerPtr->RecvMids, false, Top, 1), 1);
+    UtAssert_UINT32_EQ(CFE_SB_MsgIdToValue(Top[0].MsgID), 0x0802);
+    UtAssert_True(Top[0].MsgCnt >= 500, "never estimated low");
+} /* end Test_Sketch() */
+
+static void Test_Msg(void)
+{
+    CFE_SB_MsgId_t    MsgID = CFE_SB_ValueToMsgId(0x1818);
+    CFE_MSG_Message_t Msg;
+    SBN_MidCnt_t      Top[1];
+
+    START();
+
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+
+    SBN_MidStatMsg(&PeerPtr->SendMids, &Msg, 64);
+
+    UtAssert_INT32_EQ(SBN_MidStatTop(&PeerPtr->SendMids, false, Top, 1), 1);
+    UtAssert_UINT32_EQ(CFE_SB_MsgIdToValue(Top[0].MsgID), 0x1818);
+    UtAssert_True(Top[0].Bytes == 64, "bytes counted");
+} /* end Test_Msg() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(Exact);
+    ADD_TEST(Full);
+    ADD_TEST(Sketch);
+    ADD_TEST(Msg);
+}
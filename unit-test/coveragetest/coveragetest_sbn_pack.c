@@ -56,6 +56,24 @@ void Test_Pack(void)
     UtAssert_True(!Unpack_MsgID(&Pack, &MsgID), "unpack msgid");
 } /* end Test_Pack() */
 
+void Test_Pack64(void)
+{
+    uint64 u64;
+
+    UtAssert_True(Pack_Init(&Pack, Buf, 12, true), "pack init");
+    UtAssert_True(Pack_UInt64(&Pack, 0x0102030405060708ULL), "pack uint64"); // 8 bytes
+    UtAssert_True(!Pack_UInt64(&Pack, 1), "pack uint64 2");                  // should fail, out of space
+
+    /* big-endian, high word first */
+    UtAssert_UINT32_EQ(Buf[0], 0x01);
+    UtAssert_UINT32_EQ(Buf[7], 0x08);
+
+    UtAssert_True(Pack_Init(&Pack, Buf, 12, false), "pack init 2");
+    UtAssert_True(Unpack_UInt64(&Pack, &u64), "unpack uint64");
+    UtAssert_True(u64 == 0x0102030405060708ULL, "unpack uint64 value");
+    UtAssert_True(!Unpack_UInt64(&Pack, &u64), "unpack uint64 2");
+} /* end Test_Pack64() */
+
 void UT_Setup(void) {} /* end UT_Setup() */
 
 void UT_TearDown(void) {} /* end UT_TearDown() */
@@ -63,4 +81,5 @@ void UT_TearDown(void) {} /* end UT_TearDown() */
 void UtTest_Setup(void)
 {
     ADD_TEST(Pack);
+    ADD_TEST(Pack64);
 }
@@ -0,0 +1,44 @@
+#include "sbn_coveragetest_common.h"
+#include "sbn_perf.h"
+#include "sbn_lat.h"
+
+static void Test_StageTime(void)
+{
+    START();
+
+    SBN_PerfExit(SBN_STAGE_FILTER, SBN_LatNowUs() - 500);
+    SBN_PerfExit(SBN_STAGE_FILTER, SBN_LatNowUs() - 100);
+
+    UtAssert_UINT32_EQ(SBN.Stages[SBN_STAGE_FILTER].Cnt, 2);
+    UtAssert_True(SBN.Stages[SBN_STAGE_FILTER].MaxUs >= 500, "largest kept");
+    UtAssert_True(SBN.Stages[SBN_STAGE_FILTER].TotalUs >= 600, "time summed");
+    UtAssert_UINT32_EQ(SBN.Stages[SBN_STAGE_MOD_SEND].Cnt, 0);
+
+    /* a clock stepped back is not a negative time */
+    memset(&SBN.Stages[SBN_STAGE_FILTER], 0, sizeof(SBN.Stages[SBN_STAGE_FILTER]));
+    SBN_PerfExit(SBN_STAGE_FILTER, SBN_LatNowUs() + 1000000000);
+    UtAssert_UINT32_EQ(SBN.Stages[SBN_STAGE_FILTER].MaxUs, 0);
+} /* end Test_StageTime() */
+
+static void Test_WakeupOverrun(void)
+{
+    START();
+
+    SBN_PerfWakeup(SBN_LatNowUs());
+    UtAssert_UINT32_EQ(SBN.Wakeups.Cnt, 1);
+    UtAssert_UINT32_EQ(SBN.WakeupOverrunCnt, 0);
+
+    SBN_PerfWakeup(SBN_LatNowUs() - SBN_WAKEUP_SLOT_US - 1);
+    UtAssert_UINT32_EQ(SBN.Wakeups.Cnt, 2);
+    UtAssert_UINT32_EQ(SBN.WakeupOverrunCnt, 1);
+} /* end Test_WakeupOverrun() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(StageTime);
+    ADD_TEST(WakeupOverrun);
+}
@@ -702,6 +702,101 @@ void Test_SBN_RemoveAllSubsFromPeer(void)
     RASFP_Nominal();
 } /* end Test_SBN_RemoveAllSubsFromPeer() */
 
+static void PackOneSub(uint8 *Buf, CFE_SB_MsgId_t SubMsgID)
+{
+    Pack_t Pack;
+    Pack_Init(&Pack, Buf, CFE_MISSION_SB_MAX_SB_MSG_SIZE, 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, 1);
+    Pack_MsgID(&Pack, SubMsgID);
+    CFE_SB_Qos_t QoS = {0};
+    Pack_Data(&Pack, (void *)&QoS, sizeof(QoS));
+} /* end PackOneSub() */
+
+static void NetSubs_Nominal(void)
+{
+    START();
+
+    uint8                Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+    SBN_PeerInterface_t *Peer2 = &NetPtr->Peers[1];
+
+    NetPtr->NetFlags = SBN_NET_SHARED_PIPE;
+    NetPtr->PeerCnt  = 2;
+    Peer2->Net       = NetPtr;
+
+    PackOneSub(Buf, MsgID);
+    UtAssert_INT32_EQ(SBN_ProcessSubsFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+    UtAssert_INT32_EQ(SBN_ProcessSubsFromPeer(Peer2, Buf), SBN_SUCCESS);
+    PackOneSub(Buf, MsgID - 1);
+    UtAssert_INT32_EQ(SBN_ProcessSubsFromPeer(Peer2, Buf), SBN_SUCCESS);
+
+    /* the net pipe is subscribed once per MID, kept in MID order */
+    UtAssert_STUB_COUNT(CFE_SB_SubscribeLocal, 2);
+    UtAssert_INT32_EQ(NetPtr->SubCnt, 2);
+    UtAssert_True(CFE_SB_MsgId_Equal(NetPtr->Subs[0].MsgID, MsgID - 1), "net subs sorted");
+    UtAssert_INT32_EQ(SBN_GetNetSubPeers(NetPtr, MsgID), 3);
+    UtAssert_INT32_EQ(SBN_GetNetSubPeers(NetPtr, MsgID - 1), 2);
+    UtAssert_INT32_EQ(SBN_GetNetSubPeers(NetPtr, MsgID + 1), 0);
+
+    /* the pipe stays subscribed until the last peer unsubscribes */
+    PackOneSub(Buf, MsgID);
+    UtAssert_INT32_EQ(SBN_ProcessUnsubsFromPeer(PeerPtr, Buf), SBN_SUCCESS);
+    UtAssert_STUB_COUNT(CFE_SB_UnsubscribeLocal, 0);
+    UtAssert_INT32_EQ(SBN_GetNetSubPeers(NetPtr, MsgID), 2);
+
+    UtAssert_INT32_EQ(SBN_RemoveAllSubsFromPeer(Peer2), SBN_SUCCESS);
+    UtAssert_STUB_COUNT(CFE_SB_UnsubscribeLocal, 2);
+    UtAssert_INT32_EQ(NetPtr->SubCnt, 0);
+} /* end NetSubs_Nominal() */
+
+static void NetSubs_MaxSubsErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_SUB_EID, "cannot process subscription from ProcessorID ");
+
+    uint8 Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+
+    NetPtr->NetFlags = SBN_NET_SHARED_PIPE;
+    NetPtr->SubCnt   = SBN_MAX_SUBS_PER_NET;
+
+    PackOneSub(Buf, MsgID);
+    UtAssert_INT32_EQ(SBN_ProcessSubsFromPeer(PeerPtr, Buf), SBN_ERROR);
+    UtAssert_STUB_COUNT(CFE_SB_SubscribeLocal, 0);
+    UtAssert_INT32_EQ(PeerPtr->SubCnt, 0);
+
+    EVENT_CNT(1);
+} /* end NetSubs_MaxSubsErr() */
+
+static void NetSubs_MutexErr(void)
+{
+    START();
+
+    UT_CheckEvent_Setup(SBN_SUB_EID, "unable to take subs mutex");
+
+    uint8 Buf[CFE_MISSION_SB_MAX_SB_MSG_SIZE];
+
+    NetPtr->NetFlags = SBN_NET_SHARED_PIPE;
+
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemTake), 1, -1);
+    PackOneSub(Buf, MsgID);
+    UtAssert_INT32_EQ(SBN_ProcessSubsFromPeer(PeerPtr, Buf), SBN_ERROR);
+    UtAssert_STUB_COUNT(CFE_SB_SubscribeLocal, 0);
+    UtAssert_INT32_EQ(NetPtr->SubCnt, 0);
+
+    UT_SetDeferredRetcode(UT_KEY(OS_MutSemTake), 1, -1);
+    UtAssert_INT32_EQ(SBN_GetNetSubPeers(NetPtr, MsgID), 0);
+
+    EVENT_CNT(2);
+} /* end NetSubs_MutexErr() */
+
+void Test_SBN_NetSubs(void)
+{
+    NetSubs_Nominal();
+    NetSubs_MaxSubsErr();
+    NetSubs_MutexErr();
+} /* end Test_SBN_NetSubs() */
+
 void UT_Setup(void) {} /* end UT_Setup() */
 
 void UT_TearDown(void) {} /* end UT_TearDown() */
@@ -714,4 +809,5 @@ void UtTest_Setup(void)
     ADD_TEST(SBN_ProcessSubsFromPeer);
     ADD_TEST(SBN_ProcessUnsubsFromPeer);
     ADD_TEST(SBN_RemoveAllSubsFromPeer);
+    ADD_TEST(SBN_NetSubs);
 }
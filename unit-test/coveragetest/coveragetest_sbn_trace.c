@@ -0,0 +1,90 @@
+#include "sbn_coveragetest_common.h"
+#include "sbn_trace.h"
+
+CFE_SB_MsgId_t MsgID = 0x1818;
+
+static void Test_RingWrap(void)
+{
+    uint32 i = 0;
+
+    START();
+
+    SBN_TraceStart();
+    UtAssert_True(SBN.Trace.On, "trace on");
+
+    for (i = 0; i < SBN_TRACE_DEPTH + 2; i++)
+    {
+        SBN_TraceRecord(SBN_TRACE_PIPE_DEQ, i, 1, MsgID);
+    } /* end for */
+
+    /* the two oldest are overwritten */
+    UtAssert_UINT32_EQ(SBN.Trace.Next, SBN_TRACE_DEPTH + 2);
+    UtAssert_True(SBN.Trace.Entries[0].TimeUs == SBN_TRACE_DEPTH, "oldest overwritten");
+    UtAssert_True(SBN.Trace.Entries[2].TimeUs == 2, "rest kept");
+
+    SBN_TraceStart();
+    UtAssert_UINT32_EQ(SBN.Trace.Next, 0);
+} /* end Test_RingWrap() */
+
+static void Test_NetMsg(void)
+{
+    uint8 Buf[SBN_SEQ_HDR_SZ + SBN_STAMP_HDR_SZ + sizeof(CFE_MSG_Message_t)];
+
+    START();
+
+    memset(Buf, 0, sizeof(Buf));
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgID, sizeof(MsgID), false);
+
+    /* only app messages are traced */
+    SBN_TraceNetMsg(SBN_TRACE_RECV, 0, 1, SBN_SUB_MSG, sizeof(Buf), Buf);
+    UtAssert_UINT32_EQ(SBN.Trace.Next, 0);
+
+    /* too short to hold a message past its tags */
+    SBN_TraceNetMsg(SBN_TRACE_RECV, 0, 1, SBN_SEQ_STAMP_APP_MSG, sizeof(Buf) - 1, Buf);
+    UtAssert_UINT32_EQ(SBN.Trace.Next, 0);
+
+    SBN_TraceNetMsg(SBN_TRACE_RECV, 100, 1, SBN_SEQ_STAMP_APP_MSG, sizeof(Buf), Buf);
+    UtAssert_UINT32_EQ(SBN.Trace.Next, 1);
+    UtAssert_True(SBN.Trace.Entries[0].TimeUs == 100, "time kept");
+    UtAssert_UINT32_EQ(SBN.Trace.Entries[0].ProcessorID, 1);
+    UtAssert_UINT32_EQ(SBN.Trace.Entries[0].Point, SBN_TRACE_RECV);
+    UtAssert_UINT32_EQ(CFE_SB_MsgIdToValue(SBN.Trace.Entries[0].MsgID), CFE_SB_MsgIdToValue(MsgID));
+} /* end Test_NetMsg() */
+
+static void Test_Dump(void)
+{
+    uint8  Out[SBN_TRACE_HDR_SZ + SBN_TRACE_REC_SZ * 3];
+    uint32 Cnt = 0;
+
+    START();
+
+    SBN_TraceStart();
+    SBN_TraceRecord(SBN_TRACE_PIPE_DEQ, 1000001, 1, MsgID);
+    SBN_TraceRecord(SBN_TRACE_MOD_SEND, 1000002, 1, MsgID);
+    SBN.Trace.On = false;
+
+    memset(Out, 0, sizeof(Out));
+    UT_SetDataBuffer(UT_KEY(OS_write), Out, sizeof(Out), false);
+
+    UtAssert_INT32_EQ(SBN_TraceDump(SBN_TRACE_FILENAME, &Cnt), SBN_SUCCESS);
+    UtAssert_UINT32_EQ(Cnt, 2);
+
+    /* "SBNT", then the version */
+    UtAssert_True(Out[0] == 'S' && Out[1] == 'B' && Out[2] == 'N' && Out[3] == 'T', "magic");
+    UtAssert_True(Out[4] == 0 && Out[5] == SBN_TRACE_VER, "version");
+
+    UT_SetDefaultReturnValue(UT_KEY(OS_OpenCreate), OS_ERROR);
+    UtAssert_INT32_EQ(SBN_TraceDump(SBN_TRACE_FILENAME, &Cnt), SBN_ERROR);
+    UtAssert_UINT32_EQ(Cnt, 0);
+} /* end Test_Dump() */
+
+void UT_Setup(void) {} /* end UT_Setup() */
+
+void UT_TearDown(void) {} /* end UT_TearDown() */
+
+void UtTest_Setup(void)
+{
+    ADD_TEST(RingWrap);
+    ADD_TEST(NetMsg);
+    ADD_TEST(Dump);
+}
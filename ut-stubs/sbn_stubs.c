@@ -96,6 +96,12 @@ SBN_Status_t SBN_SendNetMsg(SBN_MsgType_t MsgType, SBN_MsgSz_t MsgSz, void *Msg,
     return UT_DEFAULT_IMPL(SBN_SendNetMsg);
 } /* end SBN_SendNetMsg() */
 
+bool SBN_IsLocalSub(CFE_SB_MsgId_t MsgID)
+{
+    /* subscribed, unless the test sets a return code */
+    return UT_DEFAULT_IMPL(SBN_IsLocalSub) == 0;
+} /* end SBN_IsLocalSub() */
+
 SBN_PeerInterface_t *SBN_GetPeer(SBN_NetInterface_t *Net, CFE_ProcessorID_t ProcessorID)
 {
     uint32               status = 0;